@@ -23,6 +23,16 @@ find_package(Libevent REQUIRED)
 include_directories(SYSTEM ${LIBEVENT_INCLUDE_DIRS})
 list(APPEND Peloton_LINKER_LIBS ${LIBEVENT_LIBRARIES})
 
+# ---[ LLVM
+if(USE_LLVM)
+  find_package(LLVM REQUIRED CONFIG)
+  include_directories(SYSTEM ${LLVM_INCLUDE_DIRS})
+  add_definitions(${LLVM_DEFINITIONS} -DPELOTON_USE_LLVM)
+  llvm_map_components_to_libnames(LLVM_LIBRARIES core executionengine mcjit
+                                  native passes)
+  list(APPEND Peloton_LINKER_LIBS ${LLVM_LIBRARIES})
+endif()
+
 # ---[ Doxygen
 if(BUILD_docs)
   find_package(Doxygen)
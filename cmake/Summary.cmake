@@ -110,6 +110,7 @@ function(peloton_print_configuration_summary)
   peloton_status("  Build type        :   ${CMAKE_BUILD_TYPE}")
   peloton_status("")
   peloton_status("  BUILD_docs        :   ${BUILD_docs}")
+  peloton_status("  USE_LLVM          :   ${USE_LLVM}")
   peloton_status("")
   peloton_status("Dependencies:")
   peloton_status("  Linker flags      :   ${CMAKE_EXE_LINKER_FLAGS}")
@@ -117,6 +118,9 @@ function(peloton_print_configuration_summary)
   peloton_status("  glog              :   Yes")
   peloton_status("  gflags            :   Yes")
   peloton_status("  protobuf          : " PROTOBUF_FOUND THEN "Yes (ver. ${PROTOBUF_VERSION})" ELSE "No" )
+  if(USE_LLVM)
+    peloton_status("  LLVM              :   Yes (ver. ${LLVM_PACKAGE_VERSION})")
+  endif()
   peloton_status("")
   if(BUILD_docs)
     peloton_status("Documentaion:")
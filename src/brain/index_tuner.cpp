@@ -89,44 +89,28 @@ static void AddIndex(storage::DataTable* table,
 
 void IndexTuner::BuildIndex(storage::DataTable* table,
                             std::shared_ptr<index::Index> index) {
-  auto table_schema = table->GetSchema();
   auto index_tile_group_offset = index->GetIndexedTileGroupOff();
   auto table_tile_group_count = table->GetTileGroupCount();
   oid_t tile_groups_indexed = 0;
 
-  auto index_schema = index->GetKeySchema();
-  auto indexed_columns = index_schema->GetIndexedColumns();
-  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-
-  while (index_tile_group_offset < table_tile_group_count &&
-         (tile_groups_indexed < tile_groups_indexed_per_iteration)) {
-    std::unique_ptr<storage::Tuple> tuple_ptr(
-        new storage::Tuple(table_schema, true));
-
-    auto tile_group = table->GetTileGroup(index_tile_group_offset);
-    auto tile_group_id = tile_group->GetTileGroupId();
-    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
-
-    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-      // Copy over the tuple
-      tile_group->CopyTuple(tuple_id, tuple_ptr.get());
-
-      // Set the location
-      ItemPointer location(tile_group_id, tuple_id);
+  if (index_tile_group_offset < table_tile_group_count) {
+    tile_groups_indexed = std::min<size_t>(
+        table_tile_group_count - index_tile_group_offset,
+        tile_groups_indexed_per_iteration);
+  }
 
-      // Set the key
-      key->SetFromTuple(tuple_ptr.get(), indexed_columns, index->GetPool());
+  if (tile_groups_indexed == 0) {
+    return;
+  }
 
-      // Insert in specific index
-      // TODO: Allocate itempointer ?
-      index->InsertEntry(key.get(), &location);
-    }
+  // The index is already in use by the workload
+  table->PopulateIndex(index.get(), index_tile_group_offset,
+                       index_tile_group_offset + tile_groups_indexed, false);
 
-    // Update indexed tile group offset (set of tgs indexed)
+  // Update indexed tile group offset (set of tgs indexed)
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_groups_indexed;
+       tile_group_itr++) {
     index->IncrementIndexedTileGroupOffset();
-
-    index_tile_group_offset++;
-    tile_groups_indexed++;
   }
 
   tile_groups_indexed_ += tile_groups_indexed;
@@ -10,12 +10,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
 #include "common/exception.h"
 #include "common/macros.h"
+#include "expression/expression_util.h"
 #include "expression/string_functions.h"
 #include "index/index_factory.h"
 
@@ -122,7 +124,8 @@ void Catalog::InsertDatabaseIntoCatalogDatabase(oid_t database_id,
 // Create a table in a database
 Result Catalog::CreateTable(std::string database_name, std::string table_name,
                             std::unique_ptr<catalog::Schema> schema,
-                            concurrency::Transaction *txn) {
+                            concurrency::Transaction *txn,
+                            VarlenPoolType pool_type) {
   LOG_TRACE("Creating table %s in database %s", table_name.c_str(),
             database_name.c_str());
 
@@ -140,7 +143,7 @@ Result Catalog::CreateTable(std::string database_name, std::string table_name,
       oid_t database_id = database->GetOid();
       storage::DataTable *table = storage::TableFactory::GetDataTable(
           database_id, table_id, schema.release(), table_name,
-          DEFAULT_TUPLES_PER_TILEGROUP, own_schema, adapt_table);
+          DEFAULT_TUPLES_PER_TILEGROUP, own_schema, adapt_table, pool_type);
       GetDatabaseWithOid(database_id)->AddTable(table);
 
       // Create the primary key index for that table if there's primary key
@@ -228,7 +231,10 @@ Result Catalog::CreateIndex(const std::string &database_name,
                             const std::string &table_name,
                             std::vector<std::string> index_attr,
                             std::string index_name, bool unique,
-                            IndexType index_type) {
+                            IndexType index_type,
+                            std::vector<std::string> index_include_attr,
+                            expression::AbstractExpression *index_predicate) {
+  std::unique_ptr<expression::AbstractExpression> predicate(index_predicate);
   auto database = GetDatabaseWithName(database_name);
   if (database != nullptr) {
     auto table = database->GetTableWithName(table_name);
@@ -261,6 +267,27 @@ Result Catalog::CreateIndex(const std::string &database_name,
       return Result::RESULT_FAILURE;
     }
 
+    // Included columns go after the key columns. A unique index could not
+    // tell duplicates apart if they took part in the comparison.
+    if (unique == true && index_include_attr.empty() == false) {
+      LOG_TRACE("Unique index can not have included columns");
+      return Result::RESULT_FAILURE;
+    }
+    for (auto attr : index_include_attr) {
+      for (uint i = 0; i < columns.size(); ++i) {
+        if (attr == columns[i].column_name &&
+            std::find(key_attrs.begin(), key_attrs.end(), i) ==
+                key_attrs.end()) {
+          key_attrs.push_back(i);
+        }
+      }
+    }
+
+    if (key_attrs.size() != index_attr.size() + index_include_attr.size()) {
+      LOG_TRACE("Some included columns are missing or already in the key");
+      return Result::RESULT_FAILURE;
+    }
+
     key_schema = catalog::Schema::CopySchema(schema, key_attrs);
     key_schema->SetIndexedColumns(key_attrs);
 
@@ -277,10 +304,21 @@ Result Catalog::CreateIndex(const std::string &database_name,
           key_attrs, true);
     }
 
-    // Add index to table
+    index_metadata->SetIncludedColumnCount(index_include_attr.size());
+
+    // The predicate of a partial index is evaluated on the table tuples
+    if (predicate != nullptr) {
+      expression::ExpressionUtil::TransformExpression(schema, predicate.get());
+      index_metadata->SetPredicate(predicate.release());
+    }
+
+    // Build the index on the existing tuples and add it to table
     std::shared_ptr<index::Index> key_index(
         index::IndexFactory::GetInstance(index_metadata));
-    table->AddIndex(key_index);
+    if (table->BuildIndex(key_index) == false) {
+      LOG_TRACE("Existing tuples violate the unique constraint");
+      return Result::RESULT_FAILURE;
+    }
 
     LOG_TRACE("Successfully add index for table %s", table->GetName().c_str());
     return Result::RESULT_SUCCESS;
@@ -664,13 +702,35 @@ std::unique_ptr<catalog::Schema> Catalog::InitializeIndexMetricsSchema() {
       catalog::Column(integer_type, integer_type_size, "inserts", true);
   inserts_column.AddConstraint(not_null_constraint);
 
+  // Shape of the index structure, zero for indexes that do not track it
+  oid_t decimal_type_size = type::Type::GetTypeSize(type::Type::DECIMAL);
+  type::Type::TypeId decimal_type = type::Type::DECIMAL;
+
+  auto node_count_column =
+      catalog::Column(integer_type, integer_type_size, "node_count", true);
+  node_count_column.AddConstraint(not_null_constraint);
+  auto delta_chain_column = catalog::Column(
+      decimal_type, decimal_type_size, "avg_delta_chain_length", true);
+  delta_chain_column.AddConstraint(not_null_constraint);
+  auto garbage_bytes_column =
+      catalog::Column(integer_type, integer_type_size, "garbage_bytes", true);
+  garbage_bytes_column.AddConstraint(not_null_constraint);
+  auto consolidations_column = catalog::Column(
+      decimal_type, decimal_type_size, "consolidations_per_sec", true);
+  consolidations_column.AddConstraint(not_null_constraint);
+  auto splits_column = catalog::Column(decimal_type, decimal_type_size,
+                                       "splits_per_sec", true);
+  splits_column.AddConstraint(not_null_constraint);
+
   auto timestamp_column =
       catalog::Column(integer_type, integer_type_size, "time_stamp", true);
   timestamp_column.AddConstraint(not_null_constraint);
 
   std::unique_ptr<catalog::Schema> database_schema(new catalog::Schema(
       {database_id_column, table_id_column, index_id_column, reads_column,
-       deletes_column, inserts_column, timestamp_column}));
+       deletes_column, inserts_column, node_count_column, delta_chain_column,
+       garbage_bytes_column, consolidations_column, splits_column,
+       timestamp_column}));
   return database_schema;
 }
 
@@ -163,7 +163,9 @@ std::unique_ptr<storage::Tuple> GetTableMetricsCatalogTuple(
  */
 std::unique_ptr<storage::Tuple> GetIndexMetricsCatalogTuple(
     catalog::Schema *schema, oid_t database_id, oid_t table_id, oid_t index_id,
-    int64_t reads, int64_t deletes, int64_t inserts, int64_t time_stamp) {
+    int64_t reads, int64_t deletes, int64_t inserts, int64_t node_count,
+    double avg_delta_chain_length, int64_t garbage_bytes,
+    double consolidations_per_sec, double splits_per_sec, int64_t time_stamp) {
   std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
   auto val1 = type::ValueFactory::GetIntegerValue(database_id);
   auto val2 = type::ValueFactory::GetIntegerValue(table_id);
@@ -171,7 +173,12 @@ std::unique_ptr<storage::Tuple> GetIndexMetricsCatalogTuple(
   auto val4 = type::ValueFactory::GetIntegerValue(reads);
   auto val5 = type::ValueFactory::GetIntegerValue(deletes);
   auto val6 = type::ValueFactory::GetIntegerValue(inserts);
-  auto val7 = type::ValueFactory::GetIntegerValue(time_stamp);
+  auto val7 = type::ValueFactory::GetIntegerValue(node_count);
+  auto val8 = type::ValueFactory::GetDoubleValue(avg_delta_chain_length);
+  auto val9 = type::ValueFactory::GetIntegerValue(garbage_bytes);
+  auto val10 = type::ValueFactory::GetDoubleValue(consolidations_per_sec);
+  auto val11 = type::ValueFactory::GetDoubleValue(splits_per_sec);
+  auto val12 = type::ValueFactory::GetIntegerValue(time_stamp);
 
   tuple->SetValue(0, val1, nullptr);
   tuple->SetValue(1, val2, nullptr);
@@ -180,6 +187,11 @@ std::unique_ptr<storage::Tuple> GetIndexMetricsCatalogTuple(
   tuple->SetValue(4, val5, nullptr);
   tuple->SetValue(5, val6, nullptr);
   tuple->SetValue(6, val7, nullptr);
+  tuple->SetValue(7, val8, nullptr);
+  tuple->SetValue(8, val9, nullptr);
+  tuple->SetValue(9, val10, nullptr);
+  tuple->SetValue(10, val11, nullptr);
+  tuple->SetValue(11, val12, nullptr);
   return std::move(tuple);
 }
 
@@ -50,6 +50,10 @@ const std::string Column::GetInfo() const {
      << " variable length = " << variable_length << ","
      << " inlined = " << is_inlined;
 
+  if (is_dictionary_encoded) {
+    os << ", dictionary encoded";
+  }
+
   if (constraints.empty() == false) {
     os << "\n";
   }
@@ -14,8 +14,10 @@
 #include "common/logger.h"
 #include "catalog/manager.h"
 #include "catalog/foreign_key.h"
+#include "storage/anti_cache_manager.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
+#include "storage/tile_group.h"
 #include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
@@ -39,12 +41,17 @@ void Manager::AddTileGroup(const oid_t oid,
 
   // add/update the catalog reference to the tile group
   tile_group_locator_.Update(oid, location);
+
+  // track the tile group in the anti-cache
+  storage::AntiCacheManager::GetInstance().RegisterTileGroup(location);
 }
 
 void Manager::DropTileGroup(const oid_t oid) {
   
   // drop the catalog reference to the tile group
   tile_group_locator_.Erase(oid, empty_tile_group_);
+
+  storage::AntiCacheManager::GetInstance().UnregisterTileGroup(oid);
 }
 
 std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
@@ -52,7 +59,16 @@ std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
   
   location = tile_group_locator_.Find(oid);
 
-  return location;
+  if (location == nullptr) {
+    return location;
+  }
+
+  // the reader pins the tile group before it checks whether it is evicted,
+  // so that it is either seen by the eviction or fetches it back
+  auto pinned_location = storage::TileGroup::GetPinnedReference(location);
+  storage::AntiCacheManager::GetInstance().EnsureResident(location.get());
+
+  return pinned_location;
 }
 
 // used for logging test
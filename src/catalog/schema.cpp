@@ -81,6 +81,12 @@ Schema::Schema(const std::vector<Column> &columns)
     for (auto constraint : columns[column_itr].constraints)
       AddConstraint(column_itr, constraint);
   }
+
+  // Keep the storage hints
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    this->columns[column_itr].SetDictionaryEncoded(
+        columns[column_itr].IsDictionaryEncoded());
+  }
 }
 
 // Copy schema
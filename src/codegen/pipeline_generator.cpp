@@ -0,0 +1,793 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pipeline_generator.cpp
+//
+// Identification: src/codegen/pipeline_generator.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#ifdef PELOTON_USE_LLVM
+
+#include "codegen/pipeline_generator.h"
+
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/ExecutionEngine/MCJIT.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Intrinsics.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Passes/PassBuilder.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Target/TargetMachine.h"
+
+#include "codegen/query_compiler.h"
+#include "common/logger.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace codegen {
+
+//===--------------------------------------------------------------------===//
+// Pipeline Builder
+//===--------------------------------------------------------------------===//
+
+/**
+ * Emits the IR of a pipeline function, see PipelineFunction:
+ *
+ *   for (i = 0; i < position_count; i++)
+ *     if (predicate(positions[i]))
+ *       matches[match_count++] = positions[i], fold the aggregates
+ *
+ * Integer values are widened to i64, DECIMALs are doubles and booleans are
+ * i1, each with an i1 null flag. Expressions are evaluated without branching
+ * (AND and OR evaluate both sides, like the interpreter does), the only
+ * branches leave the loop for the error exit, so that every value computed
+ * for a tuple dominates the rest of the code for it.
+ */
+class PipelineBuilder {
+ public:
+  PipelineBuilder(const PipelineSpec &spec, llvm::Module &module);
+
+  llvm::Function *Build();
+
+  const std::vector<oid_t> &GetColumnIds() const { return column_ids_; }
+
+ private:
+  struct Value {
+    llvm::Value *value;
+    llvm::Value *is_null;
+    type::Type::TypeId type;
+  };
+
+  Value GenerateExpression(const expression::AbstractExpression *expr,
+                           size_t step_count);
+
+  Value GenerateColumn(oid_t column_id, size_t step_count);
+
+  Value LoadColumn(oid_t column_id);
+
+  Value GenerateComparison(ExpressionType expr_type, const Value &left,
+                           const Value &right);
+
+  Value GenerateArithmetic(ExpressionType expr_type, const Value &left,
+                           const Value &right);
+
+  // Folds the value into the state of aggregate i
+  void GenerateAggregate(size_t aggregate_idx, const Value &value);
+
+  // Whether the integer is not a value of the type, or its null
+  llvm::Value *IsOutOfRange(llvm::Value *integer, type::Type::TypeId type);
+
+  // Leaves for the error exit if the condition holds
+  void CheckError(llvm::Value *condition);
+
+  llvm::Value *ToDouble(const Value &value);
+
+  const PipelineSpec &spec_;
+
+  llvm::Module &module_;
+
+  llvm::LLVMContext &context_;
+
+  llvm::IRBuilder<> builder_;
+
+  llvm::Function *function_ = nullptr;
+
+  llvm::BasicBlock *entry_block_ = nullptr;
+
+  llvm::BasicBlock *error_block_ = nullptr;
+
+  // Offset of the tuple being processed
+  llvm::Value *position_ = nullptr;
+
+  llvm::Value *column_bases_argument_ = nullptr;
+  llvm::Value *column_strides_argument_ = nullptr;
+
+  // Table columns the function reads, and their base and stride
+  std::vector<oid_t> column_ids_;
+  std::vector<llvm::Value *> column_bases_;
+  std::vector<llvm::Value *> column_strides_;
+
+  // Columns of the current tuple already loaded
+  std::unordered_map<oid_t, Value> column_values_;
+
+  // The aggregate state is kept in locals while the loop runs
+  std::vector<llvm::AllocaInst *> aggregate_values_;
+  std::vector<llvm::AllocaInst *> aggregate_counts_;
+};
+
+PipelineBuilder::PipelineBuilder(const PipelineSpec &spec,
+                                 llvm::Module &module)
+    : spec_(spec),
+      module_(module),
+      context_(module.getContext()),
+      builder_(module.getContext()) {}
+
+llvm::Function *PipelineBuilder::Build() {
+  auto int8_ptr_type = builder_.getInt8PtrTy();
+  auto int32_type = builder_.getInt32Ty();
+  auto int64_type = builder_.getInt64Ty();
+
+  std::vector<llvm::Type *> argument_types = {
+      int8_ptr_type->getPointerTo(), int64_type->getPointerTo(),
+      int32_type->getPointerTo(), int32_type, int32_type->getPointerTo(),
+      int64_type->getPointerTo()};
+  auto function_type =
+      llvm::FunctionType::get(int64_type, argument_types, false);
+  function_ = llvm::Function::Create(
+      function_type, llvm::Function::ExternalLinkage, "pipeline", &module_);
+
+  auto argument_itr = function_->arg_begin();
+  llvm::Value *column_bases = &*argument_itr++;
+  llvm::Value *column_strides = &*argument_itr++;
+  llvm::Value *positions = &*argument_itr++;
+  llvm::Value *position_count = &*argument_itr++;
+  llvm::Value *matches = &*argument_itr++;
+  llvm::Value *aggregate_state = &*argument_itr++;
+  for (auto &argument : function_->args()) {
+    if (argument.getType()->isPointerTy()) {
+      argument.addAttr(llvm::Attribute::NoAlias);
+    }
+  }
+
+  entry_block_ = llvm::BasicBlock::Create(context_, "entry", function_);
+  auto loop_block = llvm::BasicBlock::Create(context_, "loop", function_);
+  auto body_block = llvm::BasicBlock::Create(context_, "body", function_);
+  auto match_block = llvm::BasicBlock::Create(context_, "match", function_);
+  auto next_block = llvm::BasicBlock::Create(context_, "next", function_);
+  auto exit_block = llvm::BasicBlock::Create(context_, "exit", function_);
+  error_block_ = llvm::BasicBlock::Create(context_, "error", function_);
+
+  // Keep the aggregate state in locals
+  builder_.SetInsertPoint(entry_block_);
+  for (size_t aggregate_itr = 0; aggregate_itr < spec_.aggregate_types.size();
+       aggregate_itr++) {
+    auto value_type = (spec_.aggregate_value_types[aggregate_itr] ==
+                       type::Type::DECIMAL)
+                          ? builder_.getDoubleTy()
+                          : int64_type;
+    auto value_slot = builder_.CreateConstInBoundsGEP1_64(
+        int64_type, aggregate_state, 2 * aggregate_itr);
+    auto count_slot = builder_.CreateConstInBoundsGEP1_64(
+        int64_type, aggregate_state, 2 * aggregate_itr + 1);
+
+    auto value = builder_.CreateAlloca(value_type);
+    builder_.CreateStore(
+        builder_.CreateBitCast(builder_.CreateLoad(int64_type, value_slot),
+                               value_type),
+        value);
+    auto count = builder_.CreateAlloca(int64_type);
+    builder_.CreateStore(builder_.CreateLoad(int64_type, count_slot), count);
+
+    aggregate_values_.push_back(value);
+    aggregate_counts_.push_back(count);
+  }
+  builder_.CreateBr(loop_block);
+
+  // for (i = 0; i < position_count; i++)
+  builder_.SetInsertPoint(loop_block);
+  auto index = builder_.CreatePHI(int32_type, 2, "i");
+  auto match_count = builder_.CreatePHI(int32_type, 2, "match_count");
+  index->addIncoming(builder_.getInt32(0), entry_block_);
+  match_count->addIncoming(builder_.getInt32(0), entry_block_);
+  builder_.CreateCondBr(builder_.CreateICmpULT(index, position_count),
+                        body_block, exit_block);
+
+  // if (predicate(positions[i]))
+  builder_.SetInsertPoint(body_block);
+  position_ = builder_.CreateLoad(
+      int32_type, builder_.CreateInBoundsGEP(int32_type, positions, index));
+
+  column_bases_argument_ = column_bases;
+  column_strides_argument_ = column_strides;
+
+  if (spec_.predicate != nullptr) {
+    auto predicate = GenerateExpression(spec_.predicate, 0);
+    auto is_match = builder_.CreateAnd(predicate.value,
+                                       builder_.CreateNot(predicate.is_null));
+    builder_.CreateCondBr(is_match, match_block, next_block);
+  } else {
+    builder_.CreateBr(match_block);
+  }
+  auto body_end_block = builder_.GetInsertBlock();
+
+  // matches[match_count++] = positions[i]
+  builder_.SetInsertPoint(match_block);
+  builder_.CreateStore(position_, builder_.CreateInBoundsGEP(
+                                      int32_type, matches, match_count));
+  auto incremented_match_count =
+      builder_.CreateAdd(match_count, builder_.getInt32(1));
+
+  // The values of all aggregates first, then the updates
+  std::vector<Value> aggregate_inputs;
+  for (size_t aggregate_itr = 0; aggregate_itr < spec_.aggregate_types.size();
+       aggregate_itr++) {
+    auto expr = spec_.aggregate_expressions[aggregate_itr];
+    if (expr == nullptr) {
+      aggregate_inputs.push_back({builder_.getInt64(1), builder_.getFalse(),
+                                  type::Type::INTEGER});
+    } else {
+      aggregate_inputs.push_back(
+          GenerateExpression(expr, spec_.steps.size()));
+    }
+  }
+  for (size_t aggregate_itr = 0; aggregate_itr < aggregate_inputs.size();
+       aggregate_itr++) {
+    GenerateAggregate(aggregate_itr, aggregate_inputs[aggregate_itr]);
+  }
+  builder_.CreateBr(next_block);
+  auto match_end_block = builder_.GetInsertBlock();
+
+  builder_.SetInsertPoint(next_block);
+  auto next_match_count = builder_.CreatePHI(int32_type, 2);
+  if (spec_.predicate != nullptr) {
+    next_match_count->addIncoming(match_count, body_end_block);
+  }
+  next_match_count->addIncoming(incremented_match_count, match_end_block);
+  auto next_index = builder_.CreateAdd(index, builder_.getInt32(1));
+  index->addIncoming(next_index, next_block);
+  match_count->addIncoming(next_match_count, next_block);
+  builder_.CreateBr(loop_block);
+
+  // Write back the aggregate state, on the way out either way
+  for (auto block : {exit_block, error_block_}) {
+    builder_.SetInsertPoint(block);
+    for (size_t aggregate_itr = 0; aggregate_itr < aggregate_values_.size();
+         aggregate_itr++) {
+      auto value_slot = builder_.CreateConstInBoundsGEP1_64(
+          int64_type, aggregate_state, 2 * aggregate_itr);
+      auto count_slot = builder_.CreateConstInBoundsGEP1_64(
+          int64_type, aggregate_state, 2 * aggregate_itr + 1);
+      auto value = aggregate_values_[aggregate_itr];
+      builder_.CreateStore(
+          builder_.CreateBitCast(
+              builder_.CreateLoad(value->getAllocatedType(), value),
+              int64_type),
+          value_slot);
+      builder_.CreateStore(builder_.CreateLoad(
+                               int64_type, aggregate_counts_[aggregate_itr]),
+                           count_slot);
+    }
+  }
+
+  builder_.SetInsertPoint(exit_block);
+  builder_.CreateRet(builder_.CreateZExt(match_count, int64_type));
+  builder_.SetInsertPoint(error_block_);
+  builder_.CreateRet(builder_.getInt64(-1));
+
+  return function_;
+}
+
+//===--------------------------------------------------------------------===//
+// Expressions
+//===--------------------------------------------------------------------===//
+
+PipelineBuilder::Value PipelineBuilder::GenerateExpression(
+    const expression::AbstractExpression *expr, size_t step_count) {
+  auto expr_type = expr->GetExpressionType();
+  switch (expr_type) {
+    case EXPRESSION_TYPE_VALUE_TUPLE:
+      return GenerateColumn(
+          static_cast<const expression::TupleValueExpression *>(expr)
+              ->GetColumnId(),
+          step_count);
+
+    case EXPRESSION_TYPE_VALUE_CONSTANT: {
+      auto constant =
+          static_cast<const expression::ConstantValueExpression *>(expr)
+              ->GetValue();
+      auto constant_type = constant.GetTypeId();
+      if (constant_type == type::Type::DECIMAL) {
+        return {llvm::ConstantFP::get(builder_.getDoubleTy(),
+                                      constant.GetAs<double>()),
+                builder_.getFalse(), constant_type};
+      }
+      return {builder_.getInt64(
+                  constant.CastAs(type::Type::BIGINT).GetAs<int64_t>()),
+              builder_.getFalse(), constant_type};
+    }
+
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO: {
+      auto left = GenerateExpression(expr->GetChild(0), step_count);
+      auto right = GenerateExpression(expr->GetChild(1), step_count);
+      return GenerateComparison(expr_type, left, right);
+    }
+
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+    case EXPRESSION_TYPE_OPERATOR_MULTIPLY: {
+      auto left = GenerateExpression(expr->GetChild(0), step_count);
+      auto right = GenerateExpression(expr->GetChild(1), step_count);
+      return GenerateArithmetic(expr_type, left, right);
+    }
+
+    // Three-valued logic: AND is false if either side is false, OR is true
+    // if either side is true, and NULL if that depends on a NULL
+    case EXPRESSION_TYPE_CONJUNCTION_AND:
+    case EXPRESSION_TYPE_CONJUNCTION_OR: {
+      auto left = GenerateExpression(expr->GetChild(0), step_count);
+      auto right = GenerateExpression(expr->GetChild(1), step_count);
+      auto left_true =
+          builder_.CreateAnd(left.value, builder_.CreateNot(left.is_null));
+      auto right_true =
+          builder_.CreateAnd(right.value, builder_.CreateNot(right.is_null));
+      auto left_false = builder_.CreateNot(
+          builder_.CreateOr(left.value, left.is_null));
+      auto right_false = builder_.CreateNot(
+          builder_.CreateOr(right.value, right.is_null));
+
+      if (expr_type == EXPRESSION_TYPE_CONJUNCTION_AND) {
+        auto value = builder_.CreateAnd(left_true, right_true);
+        auto is_false = builder_.CreateOr(left_false, right_false);
+        return {value, builder_.CreateNot(builder_.CreateOr(value, is_false)),
+                type::Type::BOOLEAN};
+      }
+      auto value = builder_.CreateOr(left_true, right_true);
+      auto is_false = builder_.CreateAnd(left_false, right_false);
+      return {value, builder_.CreateNot(builder_.CreateOr(value, is_false)),
+              type::Type::BOOLEAN};
+    }
+
+    case EXPRESSION_TYPE_OPERATOR_NOT: {
+      auto child = GenerateExpression(expr->GetChild(0), step_count);
+      return {builder_.CreateNot(child.value), child.is_null,
+              type::Type::BOOLEAN};
+    }
+
+    case EXPRESSION_TYPE_COLUMN_FILTER:
+      return GenerateExpression(expr->GetChild(0), step_count);
+
+    default:
+      break;
+  }
+
+  // The query compiler only lets supported expressions through
+  PL_ASSERT(false);
+  return {builder_.getFalse(), builder_.getTrue(), type::Type::BOOLEAN};
+}
+
+PipelineBuilder::Value PipelineBuilder::GenerateColumn(oid_t column_id,
+                                                       size_t step_count) {
+  for (size_t step_itr = step_count; step_itr > 0; step_itr--) {
+    auto &step = spec_.steps[step_itr - 1];
+    if (step.expressions[column_id] != nullptr) {
+      return GenerateExpression(step.expressions[column_id], step_itr - 1);
+    }
+    column_id = step.column_ids[column_id];
+  }
+  return LoadColumn(column_id);
+}
+
+PipelineBuilder::Value PipelineBuilder::LoadColumn(oid_t column_id) {
+  auto column_value_itr = column_values_.find(column_id);
+  if (column_value_itr != column_values_.end()) {
+    return column_value_itr->second;
+  }
+
+  // The base and stride of a column are loaded once, in the entry block
+  size_t column_idx = 0;
+  while (column_idx < column_ids_.size() &&
+         column_ids_[column_idx] != column_id) {
+    column_idx++;
+  }
+  if (column_idx == column_ids_.size()) {
+    llvm::IRBuilder<> entry_builder(entry_block_->getTerminator());
+    column_ids_.push_back(column_id);
+    column_bases_.push_back(entry_builder.CreateLoad(
+        builder_.getInt8PtrTy(),
+        entry_builder.CreateConstInBoundsGEP1_64(
+            builder_.getInt8PtrTy(), column_bases_argument_, column_idx)));
+    column_strides_.push_back(entry_builder.CreateLoad(
+        builder_.getInt64Ty(),
+        entry_builder.CreateConstInBoundsGEP1_64(
+            builder_.getInt64Ty(), column_strides_argument_, column_idx)));
+  }
+
+  auto base = column_bases_[column_idx];
+  auto stride = column_strides_[column_idx];
+  auto location = builder_.CreateInBoundsGEP(
+      builder_.getInt8Ty(), base,
+      builder_.CreateMul(builder_.CreateZExt(position_, builder_.getInt64Ty()),
+                         stride));
+
+  // Tuple slots are not aligned
+  auto column_type = spec_.column_types[column_id];
+  Value value;
+  value.type = column_type;
+  if (column_type == type::Type::DECIMAL) {
+    value.value = builder_.CreateAlignedLoad(builder_.getDoubleTy(),
+                                             location, llvm::MaybeAlign(1));
+    value.is_null = builder_.CreateFCmpOEQ(
+        value.value,
+        llvm::ConstantFP::get(builder_.getDoubleTy(),
+                              type::PELOTON_DECIMAL_NULL));
+  } else {
+    llvm::Type *native_type = nullptr;
+    int64_t null_value = 0;
+    switch (column_type) {
+      case type::Type::TINYINT:
+        native_type = builder_.getInt8Ty();
+        null_value = type::PELOTON_INT8_NULL;
+        break;
+      case type::Type::SMALLINT:
+        native_type = builder_.getInt16Ty();
+        null_value = type::PELOTON_INT16_NULL;
+        break;
+      case type::Type::INTEGER:
+        native_type = builder_.getInt32Ty();
+        null_value = type::PELOTON_INT32_NULL;
+        break;
+      default:
+        PL_ASSERT(column_type == type::Type::BIGINT);
+        native_type = builder_.getInt64Ty();
+        null_value = type::PELOTON_INT64_NULL;
+        break;
+    }
+    auto native_value =
+        builder_.CreateAlignedLoad(native_type, location, llvm::MaybeAlign(1));
+    value.value = builder_.CreateSExt(native_value, builder_.getInt64Ty());
+    value.is_null =
+        builder_.CreateICmpEQ(value.value, builder_.getInt64(null_value));
+  }
+
+  column_values_[column_id] = value;
+  return value;
+}
+
+PipelineBuilder::Value PipelineBuilder::GenerateComparison(
+    ExpressionType expr_type, const Value &left, const Value &right) {
+  auto is_null = builder_.CreateOr(left.is_null, right.is_null);
+
+  // Integers are compared with a DECIMAL as doubles
+  if (left.type == type::Type::DECIMAL || right.type == type::Type::DECIMAL) {
+    auto left_value = ToDouble(left);
+    auto right_value = ToDouble(right);
+    llvm::CmpInst::Predicate predicate;
+    switch (expr_type) {
+      case EXPRESSION_TYPE_COMPARE_EQUAL:
+        predicate = llvm::CmpInst::FCMP_OEQ;
+        break;
+      case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+        predicate = llvm::CmpInst::FCMP_UNE;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        predicate = llvm::CmpInst::FCMP_OLT;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        predicate = llvm::CmpInst::FCMP_OGT;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        predicate = llvm::CmpInst::FCMP_OLE;
+        break;
+      default:
+        predicate = llvm::CmpInst::FCMP_OGE;
+        break;
+    }
+    return {builder_.CreateFCmp(predicate, left_value, right_value), is_null,
+            type::Type::BOOLEAN};
+  }
+
+  llvm::CmpInst::Predicate predicate;
+  switch (expr_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      predicate = llvm::CmpInst::ICMP_EQ;
+      break;
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      predicate = llvm::CmpInst::ICMP_NE;
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      predicate = llvm::CmpInst::ICMP_SLT;
+      break;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      predicate = llvm::CmpInst::ICMP_SGT;
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      predicate = llvm::CmpInst::ICMP_SLE;
+      break;
+    default:
+      predicate = llvm::CmpInst::ICMP_SGE;
+      break;
+  }
+  return {builder_.CreateICmp(predicate, left.value, right.value), is_null,
+          type::Type::BOOLEAN};
+}
+
+PipelineBuilder::Value PipelineBuilder::GenerateArithmetic(
+    ExpressionType expr_type, const Value &left, const Value &right) {
+  auto result_type = QueryCompiler::GetArithmeticType(left.type, right.type);
+  auto is_null = builder_.CreateOr(left.is_null, right.is_null);
+  auto is_not_null = builder_.CreateNot(is_null);
+
+  if (result_type == type::Type::DECIMAL) {
+    auto left_value = ToDouble(left);
+    auto right_value = ToDouble(right);
+    llvm::Value *result;
+    switch (expr_type) {
+      case EXPRESSION_TYPE_OPERATOR_PLUS:
+        result = builder_.CreateFAdd(left_value, right_value);
+        break;
+      case EXPRESSION_TYPE_OPERATOR_MINUS:
+        result = builder_.CreateFSub(left_value, right_value);
+        break;
+      default:
+        result = builder_.CreateFMul(left_value, right_value);
+        break;
+    }
+
+    // A result that happens to be the null of DECIMAL is left to the
+    // interpreter
+    CheckError(builder_.CreateAnd(
+        is_not_null,
+        builder_.CreateFCmpOEQ(
+            result, llvm::ConstantFP::get(builder_.getDoubleTy(),
+                                          type::PELOTON_DECIMAL_NULL))));
+    return {result, is_null, result_type};
+  }
+
+  llvm::Intrinsic::ID intrinsic;
+  switch (expr_type) {
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+      intrinsic = llvm::Intrinsic::sadd_with_overflow;
+      break;
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+      intrinsic = llvm::Intrinsic::ssub_with_overflow;
+      break;
+    default:
+      intrinsic = llvm::Intrinsic::smul_with_overflow;
+      break;
+  }
+  auto result_with_overflow =
+      builder_.CreateBinaryIntrinsic(intrinsic, left.value, right.value);
+  auto result = builder_.CreateExtractValue(result_with_overflow, 0);
+  auto overflow = builder_.CreateExtractValue(result_with_overflow, 1);
+
+  // Out of range of the result type, the interpreter raises the error
+  CheckError(builder_.CreateAnd(
+      is_not_null,
+      builder_.CreateOr(overflow, IsOutOfRange(result, result_type))));
+  return {result, is_null, result_type};
+}
+
+void PipelineBuilder::GenerateAggregate(size_t aggregate_idx,
+                                        const Value &value) {
+  auto int64_type = builder_.getInt64Ty();
+  auto value_slot = aggregate_values_[aggregate_idx];
+  auto count_slot = aggregate_counts_[aggregate_idx];
+  auto value_type = spec_.aggregate_value_types[aggregate_idx];
+  auto aggtype = spec_.aggregate_types[aggregate_idx];
+
+  auto is_not_null = builder_.CreateNot(value.is_null);
+  auto count = builder_.CreateLoad(int64_type, count_slot);
+
+  // NULLs are skipped by every aggregate but COUNT(*)
+  if (aggtype == EXPRESSION_TYPE_AGGREGATE_COUNT_STAR) {
+    builder_.CreateStore(builder_.CreateAdd(count, builder_.getInt64(1)),
+                         count_slot);
+    return;
+  }
+  builder_.CreateStore(
+      builder_.CreateAdd(count, builder_.CreateZExt(is_not_null, int64_type)),
+      count_slot);
+  if (aggtype == EXPRESSION_TYPE_AGGREGATE_COUNT) {
+    return;
+  }
+
+  auto current = builder_.CreateLoad(value_slot->getAllocatedType(),
+                                     value_slot);
+  llvm::Value *result;
+  if (aggtype == EXPRESSION_TYPE_AGGREGATE_SUM ||
+      aggtype == EXPRESSION_TYPE_AGGREGATE_AVG) {
+    // The sum starts out as 0, and is kept in the type of the values
+    if (value_type == type::Type::DECIMAL) {
+      result = builder_.CreateFAdd(current, ToDouble(value));
+      CheckError(builder_.CreateAnd(
+          is_not_null,
+          builder_.CreateFCmpOEQ(
+              result, llvm::ConstantFP::get(builder_.getDoubleTy(),
+                                            type::PELOTON_DECIMAL_NULL))));
+    } else {
+      auto result_with_overflow = builder_.CreateBinaryIntrinsic(
+          llvm::Intrinsic::sadd_with_overflow, current, value.value);
+      result = builder_.CreateExtractValue(result_with_overflow, 0);
+      auto overflow = builder_.CreateExtractValue(result_with_overflow, 1);
+      CheckError(builder_.CreateAnd(
+          is_not_null,
+          builder_.CreateOr(overflow, IsOutOfRange(result, value_type))));
+    }
+  } else {
+    // The first value is the MIN / MAX so far
+    llvm::Value *is_better;
+    bool is_min = (aggtype == EXPRESSION_TYPE_AGGREGATE_MIN);
+    if (value_type == type::Type::DECIMAL) {
+      is_better = is_min ? builder_.CreateFCmpOLT(value.value, current)
+                         : builder_.CreateFCmpOGT(value.value, current);
+    } else {
+      is_better = is_min ? builder_.CreateICmpSLT(value.value, current)
+                         : builder_.CreateICmpSGT(value.value, current);
+    }
+    is_better = builder_.CreateOr(
+        is_better, builder_.CreateICmpEQ(count, builder_.getInt64(0)));
+    result = builder_.CreateSelect(is_better, value.value, current);
+  }
+
+  builder_.CreateStore(builder_.CreateSelect(is_not_null, result, current),
+                       value_slot);
+}
+
+llvm::Value *PipelineBuilder::IsOutOfRange(llvm::Value *integer,
+                                           type::Type::TypeId type) {
+  int64_t null_value, max_value;
+  switch (type) {
+    case type::Type::TINYINT:
+      null_value = type::PELOTON_INT8_NULL;
+      max_value = std::numeric_limits<int8_t>::max();
+      break;
+    case type::Type::SMALLINT:
+      null_value = type::PELOTON_INT16_NULL;
+      max_value = std::numeric_limits<int16_t>::max();
+      break;
+    case type::Type::INTEGER:
+      null_value = type::PELOTON_INT32_NULL;
+      max_value = std::numeric_limits<int32_t>::max();
+      break;
+    default:
+      PL_ASSERT(type == type::Type::BIGINT);
+      null_value = type::PELOTON_INT64_NULL;
+      max_value = std::numeric_limits<int64_t>::max();
+      break;
+  }
+
+  // The null of an integer type is the least value of its native type
+  return builder_.CreateOr(
+      builder_.CreateICmpSLE(integer, builder_.getInt64(null_value)),
+      builder_.CreateICmpSGT(integer, builder_.getInt64(max_value)));
+}
+
+void PipelineBuilder::CheckError(llvm::Value *condition) {
+  auto continue_block =
+      llvm::BasicBlock::Create(context_, "no_error", function_);
+  llvm::MDBuilder md_builder(context_);
+  builder_.CreateCondBr(condition, error_block_, continue_block,
+                        md_builder.createBranchWeights(1, 1 << 20));
+  builder_.SetInsertPoint(continue_block);
+}
+
+llvm::Value *PipelineBuilder::ToDouble(const Value &value) {
+  if (value.type == type::Type::DECIMAL) {
+    return value.value;
+  }
+  return builder_.CreateSIToFP(value.value, builder_.getDoubleTy());
+}
+
+//===--------------------------------------------------------------------===//
+// Pipeline Generator
+//===--------------------------------------------------------------------===//
+
+// Keeps the machine code of a pipeline alive, the engine has to go before
+// the context its module lives in
+struct PipelineCode {
+  std::unique_ptr<llvm::LLVMContext> context;
+  std::unique_ptr<llvm::ExecutionEngine> engine;
+};
+
+std::shared_ptr<const CompiledPipeline> PipelineGenerator::Generate(
+    const PipelineSpec &spec) {
+  static std::once_flag initialize_flag;
+  std::call_once(initialize_flag, []() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+  });
+
+  std::shared_ptr<PipelineCode> code(new PipelineCode());
+  code->context.reset(new llvm::LLVMContext());
+  std::unique_ptr<llvm::Module> module(
+      new llvm::Module("pipeline", *code->context));
+
+  // Generate for the host
+  std::unique_ptr<llvm::TargetMachine> target_machine(
+      llvm::EngineBuilder().selectTarget());
+  if (target_machine == nullptr) {
+    LOG_ERROR("No LLVM target for the host");
+    return nullptr;
+  }
+  module->setDataLayout(target_machine->createDataLayout());
+  module->setTargetTriple(target_machine->getTargetTriple().str());
+
+  PipelineBuilder pipeline_builder(spec, *module);
+  auto function = pipeline_builder.Build();
+
+  std::string error;
+  llvm::raw_string_ostream error_stream(error);
+  if (llvm::verifyFunction(*function, &error_stream) == true) {
+    LOG_ERROR("Invalid pipeline function: %s", error_stream.str().c_str());
+    return nullptr;
+  }
+
+  // Optimize like -O2 does
+  llvm::LoopAnalysisManager loop_analyses;
+  llvm::FunctionAnalysisManager function_analyses;
+  llvm::CGSCCAnalysisManager cgscc_analyses;
+  llvm::ModuleAnalysisManager module_analyses;
+  llvm::PassBuilder pass_builder(target_machine.get());
+  pass_builder.registerModuleAnalyses(module_analyses);
+  pass_builder.registerCGSCCAnalyses(cgscc_analyses);
+  pass_builder.registerFunctionAnalyses(function_analyses);
+  pass_builder.registerLoopAnalyses(loop_analyses);
+  pass_builder.crossRegisterProxies(loop_analyses, function_analyses,
+                                    cgscc_analyses, module_analyses);
+  pass_builder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2)
+      .run(*module, module_analyses);
+
+  code->engine.reset(llvm::EngineBuilder(std::move(module))
+                         .setEngineKind(llvm::EngineKind::JIT)
+                         .setErrorStr(&error)
+                         .setOptLevel(llvm::CodeGenOpt::Aggressive)
+                         .create());
+  if (code->engine == nullptr) {
+    LOG_ERROR("Failed to create the LLVM engine: %s", error.c_str());
+    return nullptr;
+  }
+  code->engine->finalizeObject();
+
+  auto function_address = code->engine->getFunctionAddress("pipeline");
+  if (function_address == 0) {
+    LOG_ERROR("Failed to JIT-compile the pipeline");
+    return nullptr;
+  }
+
+  std::vector<CompiledPipeline::Aggregate> aggregates;
+  for (size_t aggregate_itr = 0; aggregate_itr < spec.aggregate_types.size();
+       aggregate_itr++) {
+    aggregates.push_back({spec.aggregate_types[aggregate_itr],
+                          spec.aggregate_value_types[aggregate_itr]});
+  }
+
+  return std::make_shared<const CompiledPipeline>(
+      reinterpret_cast<PipelineFunction>(function_address),
+      pipeline_builder.GetColumnIds(), aggregates, code);
+}
+
+}  // End codegen namespace
+}  // End peloton namespace
+
+#endif  // PELOTON_USE_LLVM
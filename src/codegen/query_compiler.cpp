@@ -0,0 +1,416 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_compiler.cpp
+//
+// Identification: src/codegen/query_compiler.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+
+#include <cstring>
+
+#include "catalog/schema.h"
+#include "codegen/pipeline_generator.h"
+#include "common/logger.h"
+#include "expression/abstract_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/aggregate_plan.h"
+#include "planner/projection_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace codegen {
+
+QueryCompiler &QueryCompiler::GetInstance() {
+  static QueryCompiler query_compiler;
+  return query_compiler;
+}
+
+std::shared_ptr<const CompiledPipeline> QueryCompiler::Compile(
+    const planner::AbstractPlan *plan) {
+#ifdef PELOTON_USE_LLVM
+  PipelineSpec spec;
+  std::string fingerprint;
+  if (plan == nullptr || BuildSpec(plan, spec, fingerprint) == false) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(cache_lock_);
+
+  auto cache_itr = cache_.find(fingerprint);
+  if (cache_itr != cache_.end()) {
+    return *cache_itr;
+  }
+
+  LOG_TRACE("Compiling pipeline %s", fingerprint.c_str());
+  auto pipeline = PipelineGenerator::Generate(spec);
+  if (pipeline == nullptr) {
+    LOG_ERROR("Failed to compile pipeline %s", fingerprint.c_str());
+    return nullptr;
+  }
+
+  cache_.insert(std::make_pair(fingerprint, pipeline));
+  return pipeline;
+#else
+  (void)plan;
+  return nullptr;
+#endif
+}
+
+size_t QueryCompiler::GetCacheSize() {
+  std::lock_guard<std::mutex> lock(cache_lock_);
+  return cache_.size();
+}
+
+void QueryCompiler::ClearCache() {
+  std::lock_guard<std::mutex> lock(cache_lock_);
+  cache_.clear();
+}
+
+//===--------------------------------------------------------------------===//
+// Typing rules
+//===--------------------------------------------------------------------===//
+
+bool QueryCompiler::IsNumericType(type::Type::TypeId type) {
+  return type == type::Type::TINYINT || type == type::Type::SMALLINT ||
+         type == type::Type::INTEGER || type == type::Type::BIGINT ||
+         type == type::Type::DECIMAL;
+}
+
+type::Type::TypeId QueryCompiler::GetArithmeticType(type::Type::TypeId left,
+                                                    type::Type::TypeId right) {
+  PL_ASSERT(IsNumericType(left) && IsNumericType(right));
+
+  // Integer arithmetic happens in the wider of the two types, the type ids
+  // are in the order of the widths
+  if (left == type::Type::DECIMAL || right == type::Type::DECIMAL) {
+    return type::Type::DECIMAL;
+  }
+  return (left >= right) ? left : right;
+}
+
+//===--------------------------------------------------------------------===//
+// Plan Analysis
+//===--------------------------------------------------------------------===//
+
+bool QueryCompiler::BuildSpec(const planner::AbstractPlan *plan,
+                              PipelineSpec &spec, std::string &fingerprint) {
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN: {
+      auto scan_plan = static_cast<const planner::SeqScanPlan *>(plan);
+
+      // Nothing to fuse without a predicate
+      if (scan_plan->GetPredicate() == nullptr) {
+        return false;
+      }
+      return BuildScanSpec(scan_plan, spec, fingerprint);
+    }
+
+    case PLAN_NODE_TYPE_AGGREGATE_V2:
+      return BuildAggregateSpec(
+          static_cast<const planner::AggregatePlan *>(plan), spec,
+          fingerprint);
+
+    default:
+      return false;
+  }
+}
+
+bool QueryCompiler::BuildScanSpec(const planner::SeqScanPlan *plan,
+                                  PipelineSpec &spec,
+                                  std::string &fingerprint) {
+  auto table = plan->GetTable();
+  if (table == nullptr || plan->GetChildren().empty() == false) {
+    return false;
+  }
+
+  auto schema = table->GetSchema();
+  fingerprint += "scan[";
+  for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+       column_itr++) {
+    auto column_type = schema->GetType(column_itr);
+    spec.column_types.push_back(column_type);
+    fingerprint += std::to_string(column_type) + ",";
+  }
+  fingerprint += "]";
+
+  spec.predicate = plan->GetPredicate();
+  if (spec.predicate != nullptr) {
+    fingerprint += "where:";
+    if (CheckExpression(spec.predicate, spec, 0, fingerprint) !=
+        type::Type::BOOLEAN) {
+      return false;
+    }
+  }
+
+  // The scan emits all columns if it is not given any
+  PipelineStep scan_step;
+  scan_step.column_ids = plan->GetColumnIds();
+  if (scan_step.column_ids.empty()) {
+    for (oid_t column_itr = 0; column_itr < spec.column_types.size();
+         column_itr++) {
+      scan_step.column_ids.push_back(column_itr);
+    }
+  }
+  scan_step.expressions.resize(scan_step.column_ids.size(), nullptr);
+
+  fingerprint += "out:";
+  for (auto column_id : scan_step.column_ids) {
+    if (column_id >= spec.column_types.size()) {
+      return false;
+    }
+    scan_step.types.push_back(spec.column_types[column_id]);
+    fingerprint += std::to_string(column_id) + ",";
+  }
+  spec.steps.push_back(std::move(scan_step));
+
+  return true;
+}
+
+bool QueryCompiler::BuildAggregateSpec(const planner::AggregatePlan *plan,
+                                       PipelineSpec &spec,
+                                       std::string &fingerprint) {
+  if (plan->GetAggregateStrategy() != AGGREGATE_TYPE_PLAIN ||
+      plan->GetGroupbyColIds().empty() == false ||
+      plan->GetUniqueAggTerms().empty() == true ||
+      plan->GetChildren().size() != 1) {
+    return false;
+  }
+
+  // An optional projection between the scan and the aggregation
+  auto child = plan->GetChildren()[0].get();
+  const planner::ProjectionPlan *projection_plan = nullptr;
+  if (child->GetPlanNodeType() == PLAN_NODE_TYPE_PROJECTION) {
+    projection_plan = static_cast<const planner::ProjectionPlan *>(child);
+    if (child->GetChildren().size() != 1) {
+      return false;
+    }
+    child = child->GetChildren()[0].get();
+  }
+
+  if (child->GetPlanNodeType() != PLAN_NODE_TYPE_SEQSCAN ||
+      BuildScanSpec(static_cast<const planner::SeqScanPlan *>(child), spec,
+                    fingerprint) == false) {
+    return false;
+  }
+
+  if (projection_plan != nullptr) {
+    auto project_info = projection_plan->GetProjectInfo();
+    auto column_count = projection_plan->GetSchema()->GetColumnCount();
+
+    PipelineStep projection_step;
+    projection_step.expressions.resize(column_count, nullptr);
+    projection_step.column_ids.resize(column_count, INVALID_OID);
+    projection_step.types.resize(column_count, type::Type::INVALID);
+
+    fingerprint += "project[";
+    for (auto &target : project_info->GetTargetList()) {
+      if (target.first >= column_count) {
+        return false;
+      }
+      fingerprint += std::to_string(target.first) + "=";
+      auto target_type = CheckExpression(target.second, spec,
+                                         spec.steps.size(), fingerprint);
+      if (target_type == type::Type::INVALID) {
+        return false;
+      }
+      projection_step.expressions[target.first] = target.second;
+      projection_step.types[target.first] = target_type;
+      fingerprint += ",";
+    }
+    for (auto &direct_map : project_info->GetDirectMapList()) {
+      if (direct_map.first >= column_count ||
+          direct_map.second.first != 0 ||
+          direct_map.second.second >= spec.steps.back().column_ids.size()) {
+        return false;
+      }
+      projection_step.column_ids[direct_map.first] = direct_map.second.second;
+      projection_step.types[direct_map.first] =
+          spec.steps.back().types[direct_map.second.second];
+      fingerprint += std::to_string(direct_map.first) + "=" +
+                     std::to_string(direct_map.second.second) + ",";
+    }
+    fingerprint += "]";
+
+    // Every column has to come from somewhere
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      if (projection_step.expressions[column_itr] == nullptr &&
+          projection_step.column_ids[column_itr] == INVALID_OID) {
+        return false;
+      }
+    }
+    spec.steps.push_back(std::move(projection_step));
+  }
+
+  fingerprint += "aggregate[";
+  for (auto &agg_term : plan->GetUniqueAggTerms()) {
+    if (agg_term.distinct == true) {
+      return false;
+    }
+
+    auto value_type = type::Type::INTEGER;
+    fingerprint += std::to_string(agg_term.aggtype) + ":";
+    switch (agg_term.aggtype) {
+      case EXPRESSION_TYPE_AGGREGATE_COUNT_STAR:
+        break;
+      case EXPRESSION_TYPE_AGGREGATE_COUNT:
+      case EXPRESSION_TYPE_AGGREGATE_SUM:
+      case EXPRESSION_TYPE_AGGREGATE_AVG:
+      case EXPRESSION_TYPE_AGGREGATE_MIN:
+      case EXPRESSION_TYPE_AGGREGATE_MAX:
+        if (agg_term.expression == nullptr) {
+          break;
+        }
+        value_type = CheckExpression(agg_term.expression, spec,
+                                     spec.steps.size(), fingerprint);
+        if (IsNumericType(value_type) == false) {
+          return false;
+        }
+        break;
+      default:
+        return false;
+    }
+    fingerprint += ",";
+
+    spec.aggregate_types.push_back(agg_term.aggtype);
+    spec.aggregate_value_types.push_back(value_type);
+    spec.aggregate_expressions.push_back(
+        agg_term.aggtype == EXPRESSION_TYPE_AGGREGATE_COUNT_STAR
+            ? nullptr
+            : agg_term.expression);
+  }
+  fingerprint += "]";
+
+  return true;
+}
+
+type::Type::TypeId QueryCompiler::CheckExpression(
+    const expression::AbstractExpression *expr, const PipelineSpec &spec,
+    size_t step_count, std::string &fingerprint) {
+  auto expr_type = expr->GetExpressionType();
+  fingerprint += std::to_string(expr_type) + "(";
+
+  type::Type::TypeId result_type = type::Type::INVALID;
+  switch (expr_type) {
+    case EXPRESSION_TYPE_VALUE_TUPLE: {
+      auto tuple_value =
+          static_cast<const expression::TupleValueExpression *>(expr);
+      if (tuple_value->GetTupleId() != 0 || tuple_value->GetColumnId() < 0) {
+        break;
+      }
+      oid_t column_id = tuple_value->GetColumnId();
+      fingerprint += std::to_string(column_id);
+
+      // A column of the step below, or of the table if there is no step
+      if (step_count > 0) {
+        auto &step = spec.steps[step_count - 1];
+        if (column_id < step.types.size()) {
+          result_type = step.types[column_id];
+        }
+      } else if (column_id < spec.column_types.size()) {
+        result_type = spec.column_types[column_id];
+      }
+      if (IsNumericType(result_type) == false) {
+        result_type = type::Type::INVALID;
+      }
+    } break;
+
+    case EXPRESSION_TYPE_VALUE_CONSTANT: {
+      auto value = static_cast<const expression::ConstantValueExpression *>(
+                       expr)->GetValue();
+      if (value.IsNull() == true || IsNumericType(value.GetTypeId()) == false) {
+        break;
+      }
+      result_type = value.GetTypeId();
+
+      // The constant is part of the code
+      fingerprint += std::to_string(result_type) + ":";
+      if (result_type == type::Type::DECIMAL) {
+        double decimal = value.GetAs<double>();
+        uint64_t bits;
+        std::memcpy(&bits, &decimal, sizeof(bits));
+        fingerprint += std::to_string(bits);
+      } else {
+        fingerprint += std::to_string(
+            value.CastAs(type::Type::BIGINT).GetAs<int64_t>());
+      }
+    } break;
+
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+    case EXPRESSION_TYPE_OPERATOR_MULTIPLY: {
+      if (expr->GetChildrenSize() != 2 || expr->GetChild(0) == nullptr ||
+          expr->GetChild(1) == nullptr) {
+        break;
+      }
+      auto left_type =
+          CheckExpression(expr->GetChild(0), spec, step_count, fingerprint);
+      auto right_type =
+          CheckExpression(expr->GetChild(1), spec, step_count, fingerprint);
+      if (IsNumericType(left_type) == false ||
+          IsNumericType(right_type) == false) {
+        break;
+      }
+
+      if (expr_type == EXPRESSION_TYPE_OPERATOR_PLUS ||
+          expr_type == EXPRESSION_TYPE_OPERATOR_MINUS ||
+          expr_type == EXPRESSION_TYPE_OPERATOR_MULTIPLY) {
+        result_type = GetArithmeticType(left_type, right_type);
+      } else {
+        result_type = type::Type::BOOLEAN;
+      }
+    } break;
+
+    case EXPRESSION_TYPE_CONJUNCTION_AND:
+    case EXPRESSION_TYPE_CONJUNCTION_OR: {
+      if (expr->GetChildrenSize() != 2 || expr->GetChild(0) == nullptr ||
+          expr->GetChild(1) == nullptr) {
+        break;
+      }
+      auto left_type =
+          CheckExpression(expr->GetChild(0), spec, step_count, fingerprint);
+      auto right_type =
+          CheckExpression(expr->GetChild(1), spec, step_count, fingerprint);
+      if (left_type == type::Type::BOOLEAN &&
+          right_type == type::Type::BOOLEAN) {
+        result_type = type::Type::BOOLEAN;
+      }
+    } break;
+
+    case EXPRESSION_TYPE_OPERATOR_NOT:
+      if (expr->GetChildrenSize() == 1 && expr->GetChild(0) != nullptr &&
+          CheckExpression(expr->GetChild(0), spec, step_count, fingerprint) ==
+              type::Type::BOOLEAN) {
+        result_type = type::Type::BOOLEAN;
+      }
+      break;
+
+    // A column filter is compiled from the predicate it took over
+    case EXPRESSION_TYPE_COLUMN_FILTER:
+      result_type =
+          CheckExpression(expr->GetChild(0), spec, step_count, fingerprint);
+      break;
+
+    default:
+      break;
+  }
+
+  fingerprint += ")";
+  return result_type;
+}
+
+}  // End codegen namespace
+}  // End peloton namespace
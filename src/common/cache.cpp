@@ -13,6 +13,7 @@
 
 #include "common/cache.h"
 
+#include "codegen/compiled_pipeline.h"
 #include "common/statement.h"
 #include "common/macros.h"
 #include "planner/abstract_plan.h"
@@ -128,4 +129,5 @@ template class Cache<std::string,
                      const planner::AbstractPlan>; /* Actual in use */
 
 template class Cache<std::string, Statement >;
+template class Cache<std::string, const codegen::CompiledPipeline>;
 }
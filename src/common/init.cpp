@@ -18,6 +18,7 @@
 
 #include "concurrency/epoch_manager_factory.h"
 #include "gc/gc_manager_factory.h"
+#include "storage/anti_cache_manager.h"
 #include "storage/data_table.h"
 
 #include "libcds/cds/init.h"
@@ -40,7 +41,7 @@ void PelotonInit::Initialize() {
   EPOCH_THREAD_COUNT = 1;
 
   // set max thread number.
-  thread_pool.Initialize(0, std::thread::hardware_concurrency() + 3);
+  thread_pool.Initialize(0, std::thread::hardware_concurrency() + 4);
 
   int parallelism = (std::thread::hardware_concurrency() + 1) / 2;
   storage::DataTable::SetActiveTileGroupCount(parallelism);
@@ -50,12 +51,16 @@ void PelotonInit::Initialize() {
   concurrency::EpochManagerFactory::GetInstance().StartEpoch();
   // start GC.
   gc::GCManagerFactory::GetInstance().StartGC();
+  // start evicting cold tile groups.
+  storage::AntiCacheManager::GetInstance().StartEviction();
   // initialize the catalog and add the default database, so we don't do this on
   // the first query
   catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
 }
 
 void PelotonInit::Shutdown() {
+  // stop evicting cold tile groups.
+  storage::AntiCacheManager::GetInstance().StopEviction();
   // shut down GC.
   gc::GCManagerFactory::GetInstance().StopGC();
   // shut down epoch.
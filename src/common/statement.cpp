@@ -63,4 +63,10 @@ const std::shared_ptr<planner::AbstractPlan>& Statement::GetPlanTree() const {
   return plan_tree;
 }
 
+void Statement::SetExplainType(ExplainType explain_type_) {
+  explain_type = explain_type_;
+}
+
+ExplainType Statement::GetExplainType() const { return explain_type; }
+
 }  // namespace peloton
@@ -0,0 +1,237 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// task_scheduler.cpp
+//
+// Identification: src/common/task_scheduler.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/task_scheduler.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <exception>
+
+#include "common/logger.h"
+
+namespace peloton {
+
+// Scheduler and index of the worker the current thread is, if any
+static thread_local const TaskScheduler *current_scheduler = nullptr;
+static thread_local size_t current_worker_id = 0;
+
+// How long a thread that waits for a group sleeps before it looks for
+// queued tasks again
+static const std::chrono::microseconds wait_timeout(100);
+
+// Initial size of the queue of tasks from other threads
+static const size_t shared_task_queue_size = 1024;
+
+//===--------------------------------------------------------------------===//
+// Task Group
+//===--------------------------------------------------------------------===//
+
+void TaskGroup::FinishTask() {
+  std::lock_guard<std::mutex> lock(latch_);
+  if (--pending_task_count_ == 0) {
+    done_.notify_all();
+  }
+}
+
+void TaskGroup::WaitFor(std::chrono::microseconds timeout) {
+  std::unique_lock<std::mutex> lock(latch_);
+  done_.wait_for(lock, timeout, [this] { return pending_task_count_ == 0; });
+}
+
+//===--------------------------------------------------------------------===//
+// Task Scheduler
+//===--------------------------------------------------------------------===//
+
+TaskScheduler::TaskScheduler(size_t worker_count, bool pin_workers)
+    : shared_tasks_(shared_task_queue_size) {
+  size_t core_count = std::max(std::thread::hardware_concurrency(), 1u);
+  if (worker_count == 0) {
+    worker_count = core_count;
+  }
+
+  for (size_t worker_id = 0; worker_id < worker_count; worker_id++) {
+    workers_.emplace_back(new Worker());
+  }
+  for (size_t worker_id = 0; worker_id < worker_count; worker_id++) {
+    threads_.emplace_back(&TaskScheduler::WorkerMain, this, worker_id);
+    if (pin_workers && PinThread(threads_.back(), worker_id % core_count) == false) {
+      LOG_ERROR("Could not pin worker %lu to a core", worker_id);
+    }
+  }
+}
+
+TaskScheduler::~TaskScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_latch_);
+    shutdown_ = true;
+  }
+  wakeup_.notify_all();
+
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+TaskScheduler &TaskScheduler::GetInstance() {
+  static TaskScheduler task_scheduler;
+  return task_scheduler;
+}
+
+void TaskScheduler::Submit(TaskGroup &group, Task task) {
+  group.AddTask();
+
+  // Counted before it is queued, so that the count never drops below zero
+  {
+    std::lock_guard<std::mutex> lock(sleep_latch_);
+    queued_task_count_++;
+  }
+
+  // A worker keeps the tasks it spawns, they likely touch the same data
+  auto scheduled_task = new ScheduledTask{std::move(task), &group};
+  size_t worker_id = GetCurrentWorkerId();
+  if (worker_id < workers_.size()) {
+    workers_[worker_id]->tasks.Push(scheduled_task);
+  } else {
+    shared_tasks_.Enqueue(scheduled_task);
+  }
+
+  wakeup_.notify_one();
+}
+
+void TaskScheduler::Wait(TaskGroup &group) {
+  while (group.IsDone() == false) {
+    if (RunPendingTask() == false) {
+      group.WaitFor(wait_timeout);
+    }
+  }
+}
+
+bool TaskScheduler::RunPendingTask() {
+  size_t worker_id = GetCurrentWorkerId();
+  auto scheduled_task = GetTask(worker_id);
+  if (scheduled_task == nullptr) {
+    return false;
+  }
+
+  RunTask(worker_id, scheduled_task);
+  return true;
+}
+
+TaskScheduler::WorkerStats TaskScheduler::GetWorkerStats(
+    size_t worker_id) const {
+  PL_ASSERT(worker_id < workers_.size());
+  auto &worker = *workers_[worker_id];
+
+  WorkerStats stats;
+  stats.executed_task_count = worker.executed_task_count;
+  stats.stolen_task_count = worker.stolen_task_count;
+  stats.cancelled_task_count = worker.cancelled_task_count;
+  stats.sleep_count = worker.sleep_count;
+  return stats;
+}
+
+bool TaskScheduler::PinThread(std::thread &thread, size_t core_id) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(core_id, &cpu_set);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t),
+                                &cpu_set) == 0;
+#else
+  (void)thread;
+  (void)core_id;
+  return false;
+#endif
+}
+
+void TaskScheduler::WorkerMain(size_t worker_id) {
+  current_scheduler = this;
+  current_worker_id = worker_id;
+
+  while (true) {
+    auto scheduled_task = GetTask(worker_id);
+    if (scheduled_task != nullptr) {
+      RunTask(worker_id, scheduled_task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_latch_);
+    if (shutdown_ == false && queued_task_count_ == 0) {
+      workers_[worker_id]->sleep_count++;
+      wakeup_.wait(lock,
+                   [this] { return shutdown_ || queued_task_count_ > 0; });
+    }
+    if (shutdown_ && queued_task_count_ == 0) {
+      return;
+    }
+  }
+}
+
+size_t TaskScheduler::GetCurrentWorkerId() const {
+  return (current_scheduler == this) ? current_worker_id : workers_.size();
+}
+
+TaskScheduler::ScheduledTask *TaskScheduler::GetTask(size_t worker_id) {
+  if (queued_task_count_ == 0) {
+    return nullptr;
+  }
+
+  // Newest task of our own first
+  ScheduledTask *scheduled_task = nullptr;
+  if (worker_id < workers_.size() &&
+      workers_[worker_id]->tasks.Pop(scheduled_task)) {
+    queued_task_count_--;
+    return scheduled_task;
+  }
+
+  // Then the ones from outside
+  if (shared_tasks_.Dequeue(scheduled_task)) {
+    queued_task_count_--;
+    return scheduled_task;
+  }
+
+  // Then the oldest task of someone else
+  for (size_t offset = 1; offset <= workers_.size(); offset++) {
+    size_t victim_id = (worker_id + offset) % workers_.size();
+    if (victim_id != worker_id &&
+        workers_[victim_id]->tasks.Steal(scheduled_task)) {
+      queued_task_count_--;
+      if (worker_id < workers_.size()) {
+        workers_[worker_id]->stolen_task_count++;
+      }
+      return scheduled_task;
+    }
+  }
+
+  return nullptr;
+}
+
+void TaskScheduler::RunTask(size_t worker_id, ScheduledTask *scheduled_task) {
+  std::unique_ptr<ScheduledTask> task_ptr(scheduled_task);
+  bool is_worker = (worker_id < workers_.size());
+
+  if (scheduled_task->group->IsCancelled()) {
+    if (is_worker) workers_[worker_id]->cancelled_task_count++;
+  } else {
+    try {
+      scheduled_task->task();
+    } catch (std::exception &e) {
+      LOG_ERROR("Task failed: %s", e.what());
+    }
+    if (is_worker) workers_[worker_id]->executed_task_count++;
+  }
+
+  scheduled_task->group->FinishTask();
+}
+
+}  // End peloton namespace
@@ -473,8 +473,10 @@ void TimestampOrderingTransactionManager::PerformInsert(
   auto transaction_id = current_txn->GetTransactionId();
 
   // check MVCC info
-  // the tuple slot must be empty.
-  PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID);
+  // the tuple slot must be empty, or claimed by this transaction when the
+  // data table inserted the tuple.
+  PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID ||
+            tile_group_header->GetTransactionId(tuple_id) == transaction_id);
   PL_ASSERT(tile_group_header->GetBeginCommitId(tuple_id) == MAX_CID);
   PL_ASSERT(tile_group_header->GetEndCommitId(tuple_id) == MAX_CID);
 
@@ -487,8 +489,11 @@ void TimestampOrderingTransactionManager::PerformInsert(
 
   InitTupleReserved(tile_group_header, tuple_id);
 
-  // Write down the head pointer's address in tile group header
-  tile_group_header->SetIndirection(tuple_id, index_entry_ptr);
+  // Write down the head pointer's address in tile group header. Without
+  // one, keep the pointer that an index build may have set up meanwhile.
+  if (index_entry_ptr != nullptr) {
+    tile_group_header->SetIndirection(tuple_id, index_entry_ptr);
+  }
 
   // Increment table insert op stats
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
@@ -497,6 +502,38 @@ void TimestampOrderingTransactionManager::PerformInsert(
   }
 }
 
+void TimestampOrderingTransactionManager::PerformBulkInsert(
+    Transaction *const current_txn, const oid_t &tile_group_id) {
+  PL_ASSERT(current_txn->IsDeclaredReadOnly() == false);
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto transaction_id = current_txn->GetTransactionId();
+  auto tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    // the tuple slots must be empty.
+    PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID);
+    PL_ASSERT(tile_group_header->GetBeginCommitId(tuple_id) == MAX_CID);
+    PL_ASSERT(tile_group_header->GetEndCommitId(tuple_id) == MAX_CID);
+
+    tile_group_header->SetTransactionId(tuple_id, transaction_id);
+
+    InitTupleReserved(tile_group_header, tuple_id);
+  }
+
+  // The whole tile group goes into the bulk insert set
+  current_txn->RecordBulkInsert(tile_group_id);
+
+  // Increment table insert op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      stats::BackendStatsContext::GetInstance()->IncrementTableInserts(
+          tile_group_id);
+    }
+  }
+}
+
 void TimestampOrderingTransactionManager::PerformUpdate(
     Transaction *const current_txn, const ItemPointer &old_location,
     const ItemPointer &new_location) {
@@ -527,6 +564,11 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   PL_ASSERT(new_tile_group_header->GetEndCommitId(new_location.offset) ==
             MAX_CID);
 
+  // the old version goes to GC once the update commits, and the index
+  // entries that lead to the new one may hold the old key
+  tile_group_header->SetModified();
+  new_tile_group_header->SetModified();
+
   // if the executor doesn't call PerformUpdate after AcquireOwnership,
   // no one will possibly release the write lock acquired by this txn.
   // Set double linked list
@@ -609,6 +651,10 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   PL_ASSERT(tile_group_header->GetBeginCommitId(tuple_id) == MAX_CID);
   PL_ASSERT(tile_group_header->GetEndCommitId(tuple_id) == MAX_CID);
 
+  // the version is overwritten in place, its index entries may hold the
+  // old key
+  tile_group_header->SetModified();
+
   // Add the old tuple into the update set
   auto old_location = tile_group_header->GetNextItemPointer(tuple_id);
   if (old_location.IsNull() == false) {
@@ -651,6 +697,9 @@ void TimestampOrderingTransactionManager::PerformDelete(
   PL_ASSERT(new_tile_group_header->GetEndCommitId(new_location.offset) ==
             MAX_CID);
 
+  tile_group_header->SetModified();
+  new_tile_group_header->SetModified();
+
   // Set up double linked list
 
   auto old_prev = tile_group_header->GetPrevItemPointer(old_location.offset);
@@ -729,6 +778,8 @@ void TimestampOrderingTransactionManager::PerformDelete(
             current_txn->GetTransactionId());
   PL_ASSERT(tile_group_header->GetBeginCommitId(tuple_id) == MAX_CID);
 
+  tile_group_header->SetModified();
+
   tile_group_header->SetEndCommitId(tuple_id, INVALID_CID);
 
   // Add the old tuple into the delete set
@@ -779,7 +830,8 @@ Result TimestampOrderingTransactionManager::CommitTransaction(
   // install everything.
   // 1. install a new version for update operations;
   // 2. install an empty version for delete operations;
-  // 3. install a new tuple for insert operations.
+  // 3. install a new tuple for insert operations;
+  // 4. install all the tuples of bulk loaded tile groups.
   for (auto &tile_group_entry : rw_set) {
     oid_t tile_group_id = tile_group_entry.first;
     auto tile_group = manager.GetTileGroup(tile_group_id);
@@ -890,6 +942,27 @@ Result TimestampOrderingTransactionManager::CommitTransaction(
     }
   }
 
+  for (auto tile_group_id : current_txn->GetBulkInsertSet()) {
+    auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+    auto tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+    // all the tuples share the same commit id
+    for (oid_t tuple_slot = 0; tuple_slot < tuple_count; tuple_slot++) {
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    }
+
+    // we should set the version before releasing the lock.
+    COMPILER_MEMORY_FENCE;
+
+    for (oid_t tuple_slot = 0; tuple_slot < tuple_count; tuple_slot++) {
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+    }
+
+    // add to log manager
+    log_manager.LogInsertTileGroup(end_commit_id, tile_group_id);
+  }
+
   Result result = current_txn->GetResult();
 
   EndTransaction(current_txn);
@@ -1047,6 +1120,9 @@ Result TimestampOrderingTransactionManager::AbortTransaction(
         gc_set->operator[](new_version.block)[new_version.offset] = RW_TYPE_DELETE;
 
       } else if (tuple_entry.second == RW_TYPE_INSERT) {
+        // the slot is going to be reused by GC
+        tile_group_header->SetModified();
+
         tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
@@ -1073,6 +1149,28 @@ Result TimestampOrderingTransactionManager::AbortTransaction(
     }
   }
 
+  for (auto tile_group_id : current_txn->GetBulkInsertSet()) {
+    auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+    auto tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+    tile_group_header->SetModified();
+
+    for (oid_t tuple_slot = 0; tuple_slot < tuple_count; tuple_slot++) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    }
+
+    // we should set the version before releasing the lock.
+    COMPILER_MEMORY_FENCE;
+
+    for (oid_t tuple_slot = 0; tuple_slot < tuple_count; tuple_slot++) {
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+
+      // add to gc set.
+      gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INSERT;
+    }
+  }
+
   current_txn->SetResult(RESULT_ABORTED);
   EndTransaction(current_txn);
 
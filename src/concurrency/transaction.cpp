@@ -140,6 +140,11 @@ void Transaction::RecordInsert(const ItemPointer &location) {
   }
 }
 
+void Transaction::RecordBulkInsert(const oid_t &tile_group_id) {
+  bulk_insert_set_.push_back(tile_group_id);
+  ++insert_count_;
+}
+
 bool Transaction::RecordDelete(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
@@ -37,6 +37,11 @@ void PrintConfiguration(){
   LOG_INFO("%30s: %10s","Socket Family", FLAGS_socket_family.c_str());
   LOG_INFO("%30s: %10lu","Statistics", FLAGS_stats_mode);
   LOG_INFO("%30s: %10lu","Max Connections", FLAGS_max_connections);
+  LOG_INFO("%30s: %10lu","Query Memory Limit", FLAGS_query_memory_limit);
+  LOG_INFO("%30s: %10lu","Total Query Memory Limit",
+           FLAGS_total_query_memory_limit);
+  LOG_INFO("%30s: %10lu","Anti-Cache Memory Limit",
+           FLAGS_anti_cache_memory_limit);
 
   LOG_INFO(" ");
   LOG_INFO("%30s", "//===---------------------------------------------------===//");
@@ -70,6 +75,22 @@ DEFINE_string(socket_family,
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+DEFINE_uint64(query_memory_limit,
+              0,
+              "Most bytes the executors of a query may hold, 0 for no limit "
+              "(default: 0)");
+
+DEFINE_uint64(total_query_memory_limit,
+              0,
+              "Most bytes the executors of all queries may hold together, 0 "
+              "for no limit (default: 0)");
+
+DEFINE_uint64(anti_cache_memory_limit,
+              0,
+              "Most bytes resident tile groups may hold before the coldest "
+              "ones are evicted to disk, 0 disables anti-caching "
+              "(default: 0)");
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
@@ -17,6 +17,7 @@
 #include "container/cuckoo_map.h"
 #include "common/logger.h"
 #include "common/macros.h"
+#include "index/index_key.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -60,6 +61,30 @@ bool CUCKOO_MAP_TYPE::Erase(const KeyType &key){
   return status;
 }
 
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+bool CUCKOO_MAP_TYPE::UpdateFn(const KeyType &key,
+                               std::function<void(ValueType &)> fn) {
+  auto status = cuckoo_map.update_fn(key, fn);
+  LOG_TRACE("update fn status : %d", status);
+  return status;
+}
+
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+void CUCKOO_MAP_TYPE::Upsert(const KeyType &key,
+                             std::function<void(ValueType &)> fn,
+                             ValueType value) {
+  cuckoo_map.upsert(key, fn, value);
+}
+
+CUCKOO_MAP_TEMPLATE_ARGUMENTS
+void CUCKOO_MAP_TYPE::ForEach(
+    std::function<void(const KeyType &, const ValueType &)> fn) {
+  auto locked_map = cuckoo_map.lock_table();
+  for (const auto &item : locked_map) {
+    fn(item.first, item.second);
+  }
+}
+
 CUCKOO_MAP_TEMPLATE_ARGUMENTS
 bool CUCKOO_MAP_TYPE::Find(const KeyType &key, ValueType &value) const {
 
@@ -100,4 +125,23 @@ template class CuckooMap<std::thread::id,
 
 template class CuckooMap<oid_t, std::shared_ptr<stats::IndexMetric>>;
 
+// Hash index
+template class CuckooMap<index::GenericKey<4>, std::vector<ItemPointer *>,
+                         index::GenericHasher<4>,
+                         index::GenericEqualityChecker<4>>;
+template class CuckooMap<index::GenericKey<8>, std::vector<ItemPointer *>,
+                         index::GenericHasher<8>,
+                         index::GenericEqualityChecker<8>>;
+template class CuckooMap<index::GenericKey<16>, std::vector<ItemPointer *>,
+                         index::GenericHasher<16>,
+                         index::GenericEqualityChecker<16>>;
+template class CuckooMap<index::GenericKey<64>, std::vector<ItemPointer *>,
+                         index::GenericHasher<64>,
+                         index::GenericEqualityChecker<64>>;
+template class CuckooMap<index::GenericKey<256>, std::vector<ItemPointer *>,
+                         index::GenericHasher<256>,
+                         index::GenericEqualityChecker<256>>;
+template class CuckooMap<index::TupleKey, std::vector<ItemPointer *>,
+                         index::TupleKeyHasher, index::TupleKeyEqualityChecker>;
+
 }  // End peloton namespace
@@ -13,6 +13,8 @@
 
 #include "type/value.h"
 #include "common/logger.h"
+#include "common/macros.h"
+#include "common/timer.h"
 #include "executor/abstract_executor.h"
 #include "executor/executor_context.h"
 #include "planner/abstract_plan.h"
@@ -28,8 +30,51 @@ AbstractExecutor::AbstractExecutor(const planner::AbstractPlan *node,
                                    ExecutorContext *executor_context)
     : node_(node), executor_context_(executor_context) {}
 
+AbstractExecutor::~AbstractExecutor() {
+  if (charged_memory_ != 0) {
+    memory_tracker_->Release(charged_memory_);
+  }
+}
+
 void AbstractExecutor::SetOutput(LogicalTile *table) { output.reset(table); }
 
+void AbstractExecutor::ChargeMemory(size_t bytes) {
+  if (TryChargeMemory(bytes) == false) {
+    // Throws with the usage and the limits
+    memory_tracker_->Charge(bytes);
+    charged_memory_ += bytes;
+  }
+}
+
+bool AbstractExecutor::TryChargeMemory(size_t bytes) {
+  // Executors without a context, in tests, are not accounted
+  if (executor_context_ == nullptr) {
+    return true;
+  }
+  if (memory_tracker_ == nullptr) {
+    memory_tracker_ = executor_context_->GetMemoryTracker();
+  }
+
+  if (memory_tracker_->TryCharge(bytes) == false) {
+    return false;
+  }
+  charged_memory_ += bytes;
+  if (operator_stats_ != nullptr &&
+      charged_memory_ > operator_stats_->peak_memory) {
+    operator_stats_->peak_memory = charged_memory_;
+  }
+  return true;
+}
+
+void AbstractExecutor::ReleaseMemory(size_t bytes) {
+  if (executor_context_ == nullptr) {
+    return;
+  }
+  PL_ASSERT(bytes <= charged_memory_);
+  memory_tracker_->Release(bytes);
+  charged_memory_ -= bytes;
+}
+
 // Transfers ownership
 LogicalTile *AbstractExecutor::GetOutput() {
   // PL_ASSERT(output.get() != nullptr);
@@ -48,6 +93,16 @@ const std::vector<AbstractExecutor *> &AbstractExecutor::GetChildren() const {
   return children_;
 }
 
+/**
+ * @brief Enables the statistics of EXPLAIN ANALYZE for this executor.
+ * @param depth Depth of the executor in the executor tree.
+ */
+void AbstractExecutor::EnableInstrumentation(int depth) {
+  operator_stats_.reset(new stats::OperatorStats());
+  operator_stats_->plan_node_type = node_->GetPlanNodeType();
+  operator_stats_->depth = depth;
+}
+
 /**
  * @brief Initializes the executor.
  *
@@ -91,7 +146,21 @@ bool AbstractExecutor::Execute() {
   // TODO In the future, we might want to pass some kind of executor state to
   // GetNextTile. e.g. params for prepared plans.
 
+  if (likely_branch(operator_stats_ == nullptr)) {
+    return DExecute();
+  }
+
+  // EXPLAIN ANALYZE, the time of the children is included
+  Timer<std::milli> timer;
+  timer.Start();
   bool status = DExecute();
+  timer.Stop();
+
+  operator_stats_->time_ms += timer.GetDuration();
+  if (status == true && output != nullptr) {
+    operator_stats_->tile_count++;
+    operator_stats_->tuple_count += output->GetTupleCount();
+  }
 
   return status;
 }
@@ -41,7 +41,7 @@ AbstractJoinExecutor::AbstractJoinExecutor(const planner::AbstractPlan *node,
  * @return true on success, false otherwise.
  */
 bool AbstractJoinExecutor::DInit() {
-  PL_ASSERT(children_.size() == 2);
+  PL_ASSERT(children_.size() >= 2);
 
   // Grab data from plan node.
   const planner::AbstractJoinPlan &node =
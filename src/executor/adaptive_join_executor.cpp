@@ -0,0 +1,433 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// adaptive_join_executor.cpp
+//
+// Identification: src/executor/adaptive_join_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "executor/adaptive_join_executor.h"
+#include "executor/executor_context.h"
+#include "expression/abstract_expression.h"
+#include "planner/adaptive_join_plan.h"
+#include "statistics/backend_stats_context.h"
+#include "statistics/stats_aggregator.h"
+#include "type/types.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace executor {
+
+// Hash of the key to the positions of the left rows with it
+typedef std::unordered_map<size_t, std::vector<std::pair<size_t, oid_t>>>
+    HashTable;
+
+// Bytes of the hash table per left row, with a bucket and a node
+static const size_t hash_entry_size = sizeof(HashTable::value_type) +
+                                      sizeof(std::pair<size_t, oid_t>) +
+                                      2 * sizeof(void *);
+
+/**
+ * @brief Constructor for adaptive join executor.
+ * @param node Adaptive join node corresponding to this executor.
+ */
+AdaptiveJoinExecutor::AdaptiveJoinExecutor(const planner::AbstractPlan *node,
+                                           ExecutorContext *executor_context)
+    : AbstractJoinExecutor(node, executor_context) {}
+
+bool AdaptiveJoinExecutor::DInit() {
+  PL_ASSERT(children_.size() == 3);
+
+  auto status = AbstractJoinExecutor::DInit();
+  if (status == false) {
+    return status;
+  }
+
+  if (join_type_ != JOIN_TYPE_INNER && join_type_ != JOIN_TYPE_LEFT) {
+    LOG_ERROR("Adaptive join does not support %s", GetJoinTypeString());
+    return false;
+  }
+
+  join_strategy_ = JOIN_STRATEGY_TYPE_INVALID;
+  partition_count_ = 0;
+  hash_table_size_ = 0;
+  left_row_count_ = 0;
+  left_tile_itr_ = 0;
+  buffered_output_tiles_.clear();
+
+  left_result_tiles_.clear();
+  right_result_tiles_.clear();
+  no_matching_left_row_sets_.clear();
+  no_matching_right_row_sets_.clear();
+  left_matching_idx = 0;
+  right_matching_idx = 0;
+  left_child_done_ = false;
+  right_child_done_ = false;
+
+  return true;
+}
+
+/**
+ * @brief Picks the join strategy on the first call, then returns the joined
+ * tiles one by one, and the left rows without a match last for a left join.
+ * @return true on success, false otherwise.
+ */
+bool AdaptiveJoinExecutor::DExecute() {
+  LOG_TRACE("********** Adaptive %s Join executor :: 3 children ",
+            GetJoinTypeString());
+
+  if (join_strategy_ == JOIN_STRATEGY_TYPE_INVALID) {
+    ChooseJoinStrategy();
+    if (join_strategy_ != JOIN_STRATEGY_TYPE_NESTED_LOOP) {
+      JoinByHashing();
+      ReleaseMemory(hash_table_size_);
+      hash_table_size_ = 0;
+    }
+  }
+
+  for (;;) {
+    if (buffered_output_tiles_.empty() == false) {
+      SetOutput(buffered_output_tiles_.front().release());
+      buffered_output_tiles_.pop_front();
+      return true;
+    }
+
+    // Only the nested loop join produces its output lazily
+    if (join_strategy_ != JOIN_STRATEGY_TYPE_NESTED_LOOP ||
+        left_tile_itr_ >= left_result_tiles_.size()) {
+      break;
+    }
+    JoinByLookups(left_tile_itr_++);
+  }
+
+  return BuildOuterJoinOutput();
+}
+
+/**
+ * @brief Buffers the left side until it has more rows than the nested loop
+ * limit of the plan or is exhausted. Past the limit all of the left side is
+ * buffered, to size the hash table.
+ */
+void AdaptiveJoinExecutor::ChooseJoinStrategy() {
+  const planner::AdaptiveJoinPlan &node =
+      GetPlanNode<planner::AdaptiveJoinPlan>();
+
+  while (left_row_count_ <= node.GetNestedLoopRowLimit() &&
+         children_[0]->Execute() == true) {
+    std::unique_ptr<LogicalTile> left_tile(children_[0]->GetOutput());
+    if (left_tile == nullptr || left_tile->GetTupleCount() == 0) {
+      continue;
+    }
+    left_row_count_ += left_tile->GetTupleCount();
+    BufferLeftTile(left_tile.release());
+  }
+
+  if (left_row_count_ <= node.GetNestedLoopRowLimit()) {
+    join_strategy_ = JOIN_STRATEGY_TYPE_NESTED_LOOP;
+    partition_count_ = 1;
+  } else {
+    while (children_[0]->Execute() == true) {
+      std::unique_ptr<LogicalTile> left_tile(children_[0]->GetOutput());
+      if (left_tile == nullptr || left_tile->GetTupleCount() == 0) {
+        continue;
+      }
+      left_row_count_ += left_tile->GetTupleCount();
+      BufferLeftTile(left_tile.release());
+    }
+
+    auto in_memory_row_limit = std::max<size_t>(node.GetInMemoryRowLimit(), 1);
+    partition_count_ =
+        (left_row_count_ + in_memory_row_limit - 1) / in_memory_row_limit;
+
+    // Spills to more partitions while the hash table of one does not fit in
+    // the memory the query has left
+    auto get_hash_table_size = [this]() {
+      return (left_row_count_ + partition_count_ - 1) / partition_count_ *
+             hash_entry_size;
+    };
+    bool charged = TryChargeMemory(get_hash_table_size());
+    while (charged == false && partition_count_ < left_row_count_) {
+      partition_count_ = std::min(2 * partition_count_, left_row_count_);
+      charged = TryChargeMemory(get_hash_table_size());
+    }
+    if (charged == false) {
+      ChargeMemory(get_hash_table_size());
+    }
+    hash_table_size_ = get_hash_table_size();
+
+    join_strategy_ = (partition_count_ > 1) ? JOIN_STRATEGY_TYPE_GRACE_HASH
+                                            : JOIN_STRATEGY_TYPE_HASH;
+  }
+  left_child_done_ = true;
+
+  LOG_TRACE("Adaptive join picked strategy %d for %lu left rows in %lu "
+            "partitions",
+            join_strategy_, left_row_count_, partition_count_);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->RecordJoinStrategy(
+        join_strategy_);
+  }
+}
+
+/**
+ * @brief Passes the key of every row of the left tile to the second child,
+ * and joins the row with the tuples it finds.
+ */
+void AdaptiveJoinExecutor::JoinByLookups(size_t left_tile_itr) {
+  const planner::AdaptiveJoinPlan &node =
+      GetPlanNode<planner::AdaptiveJoinPlan>();
+  auto &join_column_ids_left = node.GetJoinColumnsLeft();
+  auto &join_column_ids_right = node.GetJoinColumnsRight();
+
+  LogicalTile *left_tile = left_result_tiles_[left_tile_itr].get();
+
+  for (auto left_tile_row_itr : *left_tile) {
+    expression::ContainerTuple<LogicalTile> left_tuple(left_tile,
+                                                       left_tile_row_itr);
+
+    std::vector<type::Value> join_values;
+    for (auto column_id : join_column_ids_left) {
+      join_values.push_back(left_tuple.GetValue(column_id));
+    }
+    children_[1]->UpdatePredicate(join_column_ids_right, join_values);
+
+    while (children_[1]->Execute() == true) {
+      std::unique_ptr<LogicalTile> right_tile(children_[1]->GetOutput());
+      if (right_tile == nullptr) {
+        continue;
+      }
+
+      auto output_tile = BuildOutputLogicalTile(left_tile, right_tile.get());
+      LogicalTile::PositionListsBuilder pos_lists_builder(left_tile,
+                                                          right_tile.get());
+      for (auto right_tile_row_itr : *right_tile) {
+        if (MatchRows(left_tile, left_tile_row_itr, right_tile.get(),
+                      right_tile_row_itr)) {
+          RecordMatchedLeftRow(left_tile_itr, left_tile_row_itr);
+          pos_lists_builder.AddRow(left_tile_row_itr, right_tile_row_itr);
+        }
+      }
+
+      if (pos_lists_builder.Size() > 0) {
+        output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+        buffered_output_tiles_.push_back(std::move(output_tile));
+      }
+
+      // The output tiles keep what they need of the right tile, one is kept
+      // for the schema of the left rows without a match
+      if (right_result_tiles_.empty()) {
+        BufferRightTile(right_tile.release());
+      }
+    }
+    children_[1]->ResetState();
+  }
+}
+
+// Numbers that compare equal have to hash the same to match, integers of
+// any width and integral decimals hash as BIGINT
+static size_t HashKey(const std::vector<type::Value> &key) {
+  size_t hash = 0;
+  for (auto &value : key) {
+    switch (value.GetTypeId()) {
+      case type::Type::TINYINT:
+      case type::Type::SMALLINT:
+      case type::Type::INTEGER:
+        value.CastAs(type::Type::BIGINT).HashCombine(hash);
+        break;
+      case type::Type::DECIMAL: {
+        auto decimal = value.GetAs<double>();
+        if (decimal == std::trunc(decimal) &&
+            decimal >= static_cast<double>(type::PELOTON_INT64_MIN) &&
+            decimal < static_cast<double>(type::PELOTON_INT64_MAX)) {
+          type::ValueFactory::GetBigIntValue(static_cast<int64_t>(decimal))
+              .HashCombine(hash);
+        } else {
+          value.HashCombine(hash);
+        }
+      } break;
+      default:
+        value.HashCombine(hash);
+        break;
+    }
+  }
+  return hash;
+}
+
+static bool GetKey(LogicalTile *tile, oid_t row_itr,
+                   const std::vector<oid_t> &column_ids,
+                   std::vector<type::Value> &key) {
+  key.clear();
+  for (auto column_id : column_ids) {
+    key.push_back(tile->GetValue(row_itr, column_id));
+    if (key.back().IsNull()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Scans the right side once through the third child and probes a hash
+ * table over the left rows with it. With more than one partition, the hash
+ * table only holds the left rows of one partition of the keys at a time and
+ * the buffered right tiles are probed once per partition.
+ */
+void AdaptiveJoinExecutor::JoinByHashing() {
+  const planner::AdaptiveJoinPlan &node =
+      GetPlanNode<planner::AdaptiveJoinPlan>();
+  auto &join_column_ids_left = node.GetJoinColumnsLeft();
+  auto &join_column_ids_right = node.GetJoinOutputColumnsRight();
+
+  while (children_[2]->Execute() == true) {
+    std::unique_ptr<LogicalTile> right_tile(children_[2]->GetOutput());
+    if (right_tile == nullptr || right_tile->GetTupleCount() == 0) {
+      continue;
+    }
+    BufferRightTile(right_tile.release());
+  }
+  right_child_done_ = true;
+
+  if (right_result_tiles_.empty()) {
+    return;
+  }
+
+  // Hashes of the keys of the right rows, computed once for all partitions
+  std::vector<std::vector<std::pair<oid_t, size_t>>> right_hashes(
+      right_result_tiles_.size());
+  std::vector<type::Value> key;
+  for (size_t right_tile_itr = 0; right_tile_itr < right_result_tiles_.size();
+       right_tile_itr++) {
+    auto right_tile = right_result_tiles_[right_tile_itr].get();
+    for (auto right_tile_row_itr : *right_tile) {
+      if (GetKey(right_tile, right_tile_row_itr, join_column_ids_right, key)) {
+        right_hashes[right_tile_itr].emplace_back(right_tile_row_itr,
+                                                  HashKey(key));
+      }
+    }
+  }
+
+  for (size_t partition_itr = 0; partition_itr < partition_count_;
+       partition_itr++) {
+    // Build side, the left rows of the partition
+    HashTable hash_table;
+    for (size_t left_tile_itr = 0; left_tile_itr < left_result_tiles_.size();
+         left_tile_itr++) {
+      auto left_tile = left_result_tiles_[left_tile_itr].get();
+      for (auto left_tile_row_itr : *left_tile) {
+        if (GetKey(left_tile, left_tile_row_itr, join_column_ids_left, key) ==
+            false) {
+          continue;
+        }
+        auto hash = HashKey(key);
+        if (hash % partition_count_ == partition_itr) {
+          hash_table[hash].emplace_back(left_tile_itr, left_tile_row_itr);
+        }
+      }
+    }
+    if (hash_table.empty()) {
+      continue;
+    }
+
+    // Probe side
+    for (size_t right_tile_itr = 0; right_tile_itr < right_result_tiles_.size();
+         right_tile_itr++) {
+      auto right_tile = right_result_tiles_[right_tile_itr].get();
+      BuilderMap builders;
+
+      for (auto &right_hash : right_hashes[right_tile_itr]) {
+        if (right_hash.second % partition_count_ != partition_itr) {
+          continue;
+        }
+        auto bucket = hash_table.find(right_hash.second);
+        if (bucket == hash_table.end()) {
+          continue;
+        }
+
+        for (auto &left_row : bucket->second) {
+          auto left_tile = left_result_tiles_[left_row.first].get();
+          if (MatchRows(left_tile, left_row.second, right_tile,
+                        right_hash.first) == false) {
+            continue;
+          }
+          RecordMatchedLeftRow(left_row.first, left_row.second);
+
+          auto builder = builders.find(left_row.first);
+          if (builder == builders.end()) {
+            builder = builders.emplace(left_row.first,
+                                       LogicalTile::PositionListsBuilder(
+                                           left_tile, right_tile)).first;
+          }
+          builder->second.AddRow(left_row.second, right_hash.first);
+        }
+      }
+
+      FlushOutput(right_tile_itr, builders);
+    }
+  }
+}
+
+/**
+ * @brief Whether the keys of the rows are equal and the join predicate holds
+ * for them.
+ */
+bool AdaptiveJoinExecutor::MatchRows(LogicalTile *left_tile,
+                                     oid_t left_row_itr,
+                                     LogicalTile *right_tile,
+                                     oid_t right_row_itr) {
+  const planner::AdaptiveJoinPlan &node =
+      GetPlanNode<planner::AdaptiveJoinPlan>();
+  auto &join_column_ids_left = node.GetJoinColumnsLeft();
+  auto &join_column_ids_right = node.GetJoinOutputColumnsRight();
+
+  for (size_t column_itr = 0; column_itr < join_column_ids_left.size();
+       column_itr++) {
+    auto left_value =
+        left_tile->GetValue(left_row_itr, join_column_ids_left[column_itr]);
+    auto right_value =
+        right_tile->GetValue(right_row_itr, join_column_ids_right[column_itr]);
+    if (left_value.CompareEquals(right_value).IsTrue() == false) {
+      return false;
+    }
+  }
+
+  if (predicate_ != nullptr) {
+    expression::ContainerTuple<LogicalTile> left_tuple(left_tile,
+                                                       left_row_itr);
+    expression::ContainerTuple<LogicalTile> right_tuple(right_tile,
+                                                        right_row_itr);
+    auto eval =
+        predicate_->Evaluate(&left_tuple, &right_tuple, executor_context_);
+    if (eval.IsTrue() == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void AdaptiveJoinExecutor::FlushOutput(size_t right_tile_itr,
+                                       BuilderMap &builders) {
+  auto right_tile = right_result_tiles_[right_tile_itr].get();
+  for (auto &builder : builders) {
+    auto left_tile = left_result_tiles_[builder.first].get();
+    auto output_tile = BuildOutputLogicalTile(left_tile, right_tile);
+    output_tile->SetPositionListsAndVisibility(builder.second.Release());
+    buffered_output_tiles_.push_back(std::move(output_tile));
+  }
+  builders.clear();
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -108,8 +108,9 @@ bool AggregateExecutor::DExecute() {
       switch (node.GetAggregateStrategy()) {
         case AGGREGATE_TYPE_HASH:
           LOG_TRACE("Use HashAggregator");
-          aggregator.reset(new HashAggregator(
-              &node, output_table, executor_context_, tile->GetColumnCount()));
+          aggregator.reset(new HashAggregator(&node, output_table,
+                                              executor_context_,
+                                              tile->GetColumnCount(), this));
           break;
         case AGGREGATE_TYPE_SORTED:
           LOG_TRACE("Use SortedAggregator");
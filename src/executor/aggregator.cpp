@@ -153,9 +153,11 @@ bool Helper(const planner::AggregatePlan *node, Agg **aggregates,
 HashAggregator::HashAggregator(const planner::AggregatePlan *node,
                                storage::DataTable *output_table,
                                executor::ExecutorContext *econtext,
-                               size_t num_input_columns)
+                               size_t num_input_columns,
+                               AbstractExecutor *executor)
     : AbstractAggregator(node, output_table, econtext),
-      num_input_columns(num_input_columns) {}
+      num_input_columns(num_input_columns),
+      executor_(executor) {}
 //  group_by_key_values.resize(node->GetGroupbyColIds().size(),
 //      type::ValueFactory::GetNullValueByType(type::Type::INTEGER));
 //}
@@ -169,6 +171,10 @@ HashAggregator::~HashAggregator() {
     delete[] entry.second->aggregates;
     delete entry.second;
   }
+
+  if (charged_memory_ != 0) {
+    executor_->ReleaseMemory(charged_memory_);
+  }
 }
 
 bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
@@ -188,6 +194,16 @@ bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
   // Group not found. Make a new entry in the hash for this new group.
   if (map_itr == aggregates_map.end()) {
     LOG_TRACE("Group-by key not found. Start a new group.");
+    if (executor_ != nullptr) {
+      // Rough size of the group, with the states of its aggregates
+      size_t group_size =
+          sizeof(HashAggregateMapType::value_type) + sizeof(AggregateList) +
+          (group_by_key_values.size() + num_input_columns) *
+              sizeof(type::Value) +
+          node->GetUniqueAggTerms().size() * (sizeof(Agg *) + sizeof(Agg));
+      executor_->ChargeMemory(group_size);
+      charged_memory_ += group_size;
+    }
     // Allocate new aggregate list
     aggregate_list = new AggregateList();
     aggregate_list->aggregates = new Agg *[node->GetUniqueAggTerms().size()];
@@ -0,0 +1,413 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_pipeline_executor.cpp
+//
+// Identification: src/executor/compiled_pipeline_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/compiled_pipeline_executor.h"
+
+#include <cstring>
+#include <numeric>
+#include <utility>
+
+#include "catalog/manager.h"
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/abstract_expression.h"
+#include "planner/aggregate_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/column_accessor.h"
+#include "storage/data_table.h"
+#include "storage/table_factory.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Constructor for the compiled pipeline executor.
+ * @param node Root plan of the pipeline.
+ * @param pipeline Code the query compiler generated for the plans.
+ */
+CompiledPipelineExecutor::CompiledPipelineExecutor(
+    const planner::AbstractPlan *node, ExecutorContext *executor_context,
+    std::shared_ptr<const codegen::CompiledPipeline> pipeline)
+    : AbstractExecutor(node, executor_context), pipeline_(pipeline) {}
+
+CompiledPipelineExecutor::~CompiledPipelineExecutor() {
+  // clean up temporary aggregation table
+  delete output_table_;
+}
+
+/**
+ * @brief Finds the scan of the pipeline and sets up the output table of an
+ * aggregation.
+ * @return true on success, false otherwise.
+ */
+bool CompiledPipelineExecutor::DInit() {
+  auto scan_node = GetRawNode();
+  while (scan_node->GetPlanNodeType() != PLAN_NODE_TYPE_SEQSCAN) {
+    PL_ASSERT(scan_node->GetChildren().size() == 1);
+    scan_node = scan_node->GetChildren()[0].get();
+  }
+  scan_node_ = static_cast<const planner::SeqScanPlan *>(scan_node);
+
+  target_table_ = scan_node_->GetTable();
+  PL_ASSERT(target_table_ != nullptr);
+
+  current_tile_group_offset_ = START_OID;
+  table_tile_group_count_ = target_table_->GetTileGroupCount();
+
+  table_column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
+  std::iota(table_column_ids_.begin(), table_column_ids_.end(), 0);
+
+  column_ids_ = scan_node_->GetColumnIds();
+  if (column_ids_.empty()) {
+    column_ids_ = table_column_ids_;
+  }
+
+  use_interpreter_ = false;
+  done_ = false;
+  result_itr_ = START_OID;
+  result_.clear();
+
+  if (pipeline_->IsAggregation()) {
+    PL_ASSERT(children_.size() == 1);
+
+    delete output_table_;
+
+    auto &node = GetPlanNode<planner::AggregatePlan>();
+    bool own_schema = false;
+    bool adapt_table = false;
+    output_table_ = storage::TableFactory::GetDataTable(
+        INVALID_OID, INVALID_OID,
+        const_cast<catalog::Schema *>(node.GetOutputSchema()),
+        "aggregate_temp_table", DEFAULT_TUPLES_PER_TILEGROUP, own_schema,
+        adapt_table);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Emits the matches of the next tile group, or the result of the
+ * aggregation.
+ * @return true on success, false otherwise.
+ */
+bool CompiledPipelineExecutor::DExecute() {
+  if (pipeline_->IsAggregation()) {
+    return ExecuteAggregation();
+  }
+  return ExecuteScan();
+}
+
+bool CompiledPipelineExecutor::ExecuteScan() {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  bool acquire_owner = scan_node_->IsForUpdate();
+  auto current_txn = executor_context_->GetTransaction();
+
+  std::vector<int64_t> no_aggregate_state;
+  while (current_tile_group_offset_ < table_tile_group_count_) {
+    auto tile_group = target_table_->GetTileGroup(current_tile_group_offset_++);
+
+    auto position_list = GetVisibleTuples(tile_group);
+    if (position_list.empty()) {
+      continue;
+    }
+
+    std::vector<oid_t> matches;
+    auto match_count =
+        RunPipeline(tile_group, position_list, matches, no_aggregate_state);
+    if (match_count < 0) {
+      LOG_TRACE("Compiled scan gave up on tile group %u",
+                tile_group->GetTileGroupId());
+      matches = InterpretPredicate(tile_group, position_list);
+    }
+
+    for (auto tuple_id : matches) {
+      ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+      auto res = transaction_manager.PerformRead(current_txn, location,
+                                                 acquire_owner);
+      if (!res) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return res;
+      }
+    }
+
+    // Don't return empty tiles
+    if (matches.empty()) {
+      continue;
+    }
+
+    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+    logical_tile->AddColumns(tile_group, column_ids_);
+    logical_tile->AddPositionList(std::move(matches));
+
+    SetOutput(logical_tile.release());
+    return true;
+  }
+
+  return false;
+}
+
+bool CompiledPipelineExecutor::ExecuteAggregation() {
+  if (use_interpreter_ == true) {
+    if (children_[0]->Execute() == false) {
+      return false;
+    }
+    SetOutput(children_[0]->GetOutput());
+    return true;
+  }
+
+  if (done_ == false) {
+    std::vector<int64_t> aggregate_state(2 * pipeline_->GetAggregates().size(),
+                                         0);
+
+    // Reads are only performed once the compiled code went through all tile
+    // groups, the interpreter performs them again if it takes over
+    std::vector<std::pair<oid_t, std::vector<oid_t>>> reads;
+    size_t match_count = 0;
+    while (current_tile_group_offset_ < table_tile_group_count_) {
+      auto tile_group =
+          target_table_->GetTileGroup(current_tile_group_offset_++);
+
+      auto position_list = GetVisibleTuples(tile_group);
+      if (position_list.empty()) {
+        continue;
+      }
+
+      std::vector<oid_t> matches;
+      if (RunPipeline(tile_group, position_list, matches, aggregate_state) <
+          0) {
+        LOG_TRACE("Compiled aggregation gave up on tile group %u",
+                  tile_group->GetTileGroupId());
+        use_interpreter_ = true;
+        return ExecuteAggregation();
+      }
+
+      match_count += matches.size();
+      reads.emplace_back(tile_group->GetTileGroupId(), std::move(matches));
+    }
+
+    concurrency::TransactionManager &transaction_manager =
+        concurrency::TransactionManagerFactory::GetInstance();
+    bool acquire_owner = scan_node_->IsForUpdate();
+    auto current_txn = executor_context_->GetTransaction();
+    for (auto &read : reads) {
+      for (auto tuple_id : read.second) {
+        ItemPointer location(read.first, tuple_id);
+        auto res = transaction_manager.PerformRead(current_txn, location,
+                                                   acquire_owner);
+        if (!res) {
+          transaction_manager.SetTransactionResult(current_txn,
+                                                   RESULT_FAILURE);
+          return res;
+        }
+      }
+    }
+
+    FinalizeAggregation(aggregate_state, match_count);
+    done_ = true;
+
+    for (oid_t tile_group_itr = 0;
+         tile_group_itr < output_table_->GetTileGroupCount();
+         tile_group_itr++) {
+      result_.push_back(LogicalTileFactory::WrapTileGroup(
+          output_table_->GetTileGroup(tile_group_itr)));
+    }
+  }
+
+  if (result_itr_ == INVALID_OID || result_itr_ == result_.size()) {
+    return false;
+  }
+
+  SetOutput(result_[result_itr_]);
+  result_itr_++;
+  return true;
+}
+
+std::vector<oid_t> CompiledPipelineExecutor::GetVisibleTuples(
+    const std::shared_ptr<storage::TileGroup> &tile_group) {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto tile_group_header = tile_group->GetHeader();
+
+  std::vector<oid_t> position_list;
+  oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_id);
+    if (visibility == VISIBILITY_OK) {
+      position_list.push_back(tuple_id);
+    }
+  }
+  return position_list;
+}
+
+int64_t CompiledPipelineExecutor::RunPipeline(
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    const std::vector<oid_t> &position_list, std::vector<oid_t> &matches,
+    std::vector<int64_t> &aggregate_state) {
+  auto accessors = tile_group->GetColumnAccessors();
+
+  std::vector<const char *> column_bases;
+  std::vector<uint64_t> column_strides;
+  for (auto column_id : pipeline_->GetColumnIds()) {
+    auto &accessor = accessors[column_id];
+
+    // The code was compiled for the columns stored inline
+    if (accessor.is_inlined == false || accessor.dictionary != nullptr) {
+      return -1;
+    }
+    column_bases.push_back(accessor.base + accessor.offset);
+    column_strides.push_back(accessor.stride);
+  }
+
+  matches.resize(position_list.size());
+  auto match_count = pipeline_->GetFunction()(
+      column_bases.data(), column_strides.data(), position_list.data(),
+      position_list.size(), matches.data(), aggregate_state.data());
+  matches.resize(match_count < 0 ? 0 : match_count);
+  return match_count;
+}
+
+std::vector<oid_t> CompiledPipelineExecutor::InterpretPredicate(
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    const std::vector<oid_t> &position_list) {
+  // Same as the sequential scan, the predicate sees the tuples as a logical
+  // tile over all columns of the table
+  std::unique_ptr<LogicalTile> tile(LogicalTileFactory::GetTile());
+  tile->AddColumns(tile_group, table_column_ids_);
+  tile->AddPositionList(std::vector<oid_t>(position_list));
+
+  expression::SelectionVector selection(position_list.size());
+  std::iota(selection.begin(), selection.end(), 0);
+  scan_node_->GetPredicate()->EvaluateBatch(*tile, selection,
+                                            executor_context_);
+
+  std::vector<oid_t> matches;
+  for (auto tuple_id : selection) {
+    matches.push_back(position_list[tuple_id]);
+  }
+  return matches;
+}
+
+/**
+ * @brief Writes the tuple the aggregate executor would for the aggregates.
+ */
+void CompiledPipelineExecutor::FinalizeAggregation(
+    const std::vector<int64_t> &aggregate_state, size_t match_count) {
+  auto &node = GetPlanNode<planner::AggregatePlan>();
+  auto &aggregates = pipeline_->GetAggregates();
+
+  std::unique_ptr<storage::Tuple> tuple(
+      new storage::Tuple(output_table_->GetSchema(), true));
+
+  if (match_count == 0) {
+    // Without any input, counts are 0 and everything else is NULL
+    bool all_count_aggs = true;
+    for (auto &aggregate : aggregates) {
+      if (aggregate.aggtype != EXPRESSION_TYPE_AGGREGATE_COUNT &&
+          aggregate.aggtype != EXPRESSION_TYPE_AGGREGATE_COUNT_STAR)
+        all_count_aggs = false;
+    }
+    if (all_count_aggs == true) {
+      tuple->SetAllZeros();
+    } else {
+      tuple->SetAllNulls();
+    }
+  } else {
+    std::vector<type::Value> aggregate_values;
+    for (size_t aggregate_itr = 0; aggregate_itr < aggregates.size();
+         aggregate_itr++) {
+      aggregate_values.push_back(GetAggregateValue(
+          aggregates[aggregate_itr], aggregate_state[2 * aggregate_itr],
+          aggregate_state[2 * aggregate_itr + 1]));
+    }
+
+    expression::ContainerTuple<std::vector<type::Value>> aggref_tuple(
+        &aggregate_values);
+
+    auto predicate = node.GetPredicate();
+    if (predicate != nullptr &&
+        predicate->Evaluate(nullptr, &aggref_tuple, executor_context_)
+            .IsFalse()) {
+      return;
+    }
+
+    node.GetProjectInfo()->Evaluate(tuple.get(), nullptr, &aggref_tuple,
+                                    executor_context_);
+  }
+
+  auto location = output_table_->InsertTuple(tuple.get());
+  PL_ASSERT(location.block != INVALID_OID);
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroup(location.block)->GetHeader();
+  tile_group_header->SetTransactionId(location.offset, INITIAL_TXN_ID);
+}
+
+/**
+ * @brief The value the interpreted aggregate would finalize to, from its
+ * state in the compiled code.
+ */
+type::Value CompiledPipelineExecutor::GetAggregateValue(
+    const codegen::CompiledPipeline::Aggregate &aggregate, int64_t value,
+    int64_t count) const {
+  if (aggregate.aggtype == EXPRESSION_TYPE_AGGREGATE_COUNT ||
+      aggregate.aggtype == EXPRESSION_TYPE_AGGREGATE_COUNT_STAR) {
+    return type::ValueFactory::GetBigIntValue(count);
+  }
+
+  if (count == 0) {
+    return type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+  }
+
+  type::Value result;
+  switch (aggregate.value_type) {
+    case type::Type::TINYINT:
+      result = type::ValueFactory::GetTinyIntValue(static_cast<int8_t>(value));
+      break;
+    case type::Type::SMALLINT:
+      result =
+          type::ValueFactory::GetSmallIntValue(static_cast<int16_t>(value));
+      break;
+    case type::Type::INTEGER:
+      result =
+          type::ValueFactory::GetIntegerValue(static_cast<int32_t>(value));
+      break;
+    case type::Type::BIGINT:
+      result = type::ValueFactory::GetBigIntValue(value);
+      break;
+    default: {
+      PL_ASSERT(aggregate.value_type == type::Type::DECIMAL);
+      double decimal;
+      std::memcpy(&decimal, &value, sizeof(decimal));
+      result = type::ValueFactory::GetDoubleValue(decimal);
+    } break;
+  }
+
+  if (aggregate.aggtype == EXPRESSION_TYPE_AGGREGATE_AVG) {
+    return result.Divide(
+        type::ValueFactory::GetDoubleValue(static_cast<double>(count)));
+  }
+  return result;
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include <concurrency/transaction_manager_factory.h>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -20,7 +21,10 @@
 #include "executor/executor_context.h"
 #include "executor/logical_tile_factory.h"
 #include "planner/copy_plan.h"
+#include "storage/data_table.h"
 #include "storage/table_factory.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
 #include "logging/logging_util.h"
 #include "common/exception.h"
 #include "common/macros.h"
@@ -45,11 +49,27 @@ CopyExecutor::~CopyExecutor() {}
  * @return true on success, false otherwise.
  */
 bool CopyExecutor::DInit() {
-  PL_ASSERT(children_.size() == 1);
-
   // Grab info from plan node and check it
   const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
 
+  if (node.copy_type == COPY_TYPE_IMPORT_CSV) {
+    PL_ASSERT(children_.size() == 0);
+    PL_ASSERT(node.target_table != nullptr);
+
+    if (logging::LoggingUtil::InitFileHandle(node.file_path.c_str(),
+                                             file_handle_, "r") == false) {
+      throw ExecutorException("Failed to open file " + node.file_path +
+                              ". Try absolute path and make sure you have the "
+                              "permission to access this file.");
+    }
+    LOG_DEBUG("Opened source copy input file: %s", node.file_path.c_str());
+
+    delimiter = node.delimiter;
+    return true;
+  }
+
+  PL_ASSERT(children_.size() == 1);
+
   bool success = logging::LoggingUtil::InitFileHandle(node.file_path.c_str(),
                                                       file_handle_, "w");
 
@@ -145,6 +165,127 @@ void CopyExecutor::Copy(const char *data, int len, bool end_of_line) {
   PL_ASSERT(buff_size <= COPY_BUFFER_SIZE);
 }
 
+bool CopyExecutor::ReadLine(std::vector<std::string> &fields) {
+  fields.clear();
+
+  std::string field;
+  bool escaped = false;
+  bool has_data = false;
+
+  while (true) {
+    // Refill the buffer from the file
+    if (buff_ptr == buff_size) {
+      buff_size = fread(buff, sizeof(char), COPY_BUFFER_SIZE, file_handle_.file);
+      buff_ptr = 0;
+
+      // The last line may not end with a new line
+      if (buff_size == 0) {
+        if (has_data) {
+          fields.push_back(std::move(field));
+        }
+        return has_data;
+      }
+    }
+
+    char ch = buff[buff_ptr++];
+    has_data = true;
+
+    if (escaped) {
+      field.push_back(ch);
+      escaped = false;
+    } else if (ch == '\\') {
+      escaped = true;
+    } else if (ch == delimiter) {
+      fields.push_back(std::move(field));
+      field.clear();
+    } else if (ch == new_line) {
+      fields.push_back(std::move(field));
+      return true;
+    } else {
+      field.push_back(ch);
+    }
+  }
+}
+
+/**
+ * Parse the file into tuples and hand them to the table's bulk loader in
+ * batches. The loaded tile groups are committed with the transaction.
+ */
+bool CopyExecutor::Import() {
+  const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
+  auto target_table = node.target_table;
+  auto schema = target_table->GetSchema();
+  auto column_count = schema->GetColumnCount();
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  // Closes the input file however the import ends
+  std::unique_ptr<FILE, int (*)(FILE *)> input_file(file_handle_.file, fclose);
+
+  std::vector<std::string> fields;
+  std::vector<std::unique_ptr<storage::Tuple>> tuples;
+  std::vector<const storage::Tuple *> batch;
+  std::unique_ptr<type::VarlenPool> pool(new type::VarlenPool(BACKEND_TYPE_MM));
+  bool end_of_file = false;
+
+  while (end_of_file == false) {
+    end_of_file = (ReadLine(fields) == false);
+
+    if (end_of_file == false) {
+      // Skip empty lines
+      if (fields.size() == 1 && fields[0].empty() && column_count != 1) {
+        continue;
+      }
+      if (fields.size() != column_count) {
+        throw ExecutorException(
+            "Expected " + std::to_string(column_count) + " fields but got " +
+            std::to_string(fields.size()) + " when copying to " +
+            target_table->GetName());
+      }
+
+      std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
+      for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+        auto column_type = schema->GetType(column_itr);
+        // Empty fields are nulls
+        if (fields[column_itr].empty() && column_type != type::Type::VARCHAR) {
+          tuple->SetValue(column_itr,
+                          type::ValueFactory::GetNullValueByType(column_type),
+                          pool.get());
+        } else {
+          tuple->SetValue(
+              column_itr,
+              type::ValueFactory::GetVarcharValue(fields[column_itr]),
+              pool.get());
+        }
+      }
+      batch.push_back(tuple.get());
+      tuples.push_back(std::move(tuple));
+    }
+
+    if (batch.size() == COPY_BULK_LOAD_SIZE ||
+        (end_of_file == true && batch.empty() == false)) {
+      if (target_table->BulkLoad(batch, current_txn) == false) {
+        LOG_TRACE("Failed to bulk load. Set txn failure.");
+        transaction_manager.SetTransactionResult(current_txn,
+                                                 Result::RESULT_FAILURE);
+        return false;
+      }
+      executor_context_->num_processed += batch.size();
+
+      // The tile groups hold their own copies of the values
+      batch.clear();
+      tuples.clear();
+      pool.reset(new type::VarlenPool(BACKEND_TYPE_MM));
+    }
+  }
+
+  LOG_DEBUG("Loaded %u tuples into %s", executor_context_->num_processed,
+            target_table->GetName().c_str());
+  return true;
+}
+
 /**
  * @return true on success, false otherwise.
  */
@@ -154,6 +295,12 @@ bool CopyExecutor::DExecute() {
     return false;
   }
 
+  const planner::CopyPlan &node = GetPlanNode<planner::CopyPlan>();
+  if (node.copy_type == COPY_TYPE_IMPORT_CSV) {
+    done = true;
+    return Import();
+  }
+
   while (children_[0]->Execute() == true) {
     // Get input a tile
     std::unique_ptr<LogicalTile> logical_tile(children_[0]->GetOutput());
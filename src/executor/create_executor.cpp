@@ -14,6 +14,7 @@
 #include "executor/executor_context.h"
 #include "common/logger.h"
 #include "catalog/catalog.h"
+#include "expression/abstract_expression.h"
 
 #include <vector>
 
@@ -67,10 +68,13 @@ bool CreateExecutor::DExecute() {
     IndexType index_type = node.GetIndexType();
 
     auto index_attrs = node.GetIndexAttributes();
+    auto index_include_attrs = node.GetIndexIncludeAttributes();
+    auto index_predicate = node.GetIndexPredicate();
 
     Result result = catalog::Catalog::GetInstance()->CreateIndex(
         DEFAULT_DB_NAME, table_name, index_attrs, index_name, unique_flag,
-        index_type);
+        index_type, index_include_attrs,
+        index_predicate == nullptr ? nullptr : index_predicate->Copy());
     current_txn->SetResult(result);
 
     if (current_txn->GetResult() == Result::RESULT_SUCCESS) {
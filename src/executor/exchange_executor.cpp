@@ -0,0 +1,298 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_executor.cpp
+//
+// Identification: src/executor/exchange_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/exchange_executor.h"
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "executor/plan_executor.h"
+#include "planner/exchange_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace executor {
+
+// How long the executor sleeps before it looks for queued tasks to help with
+static const std::chrono::microseconds output_timeout(100);
+
+/**
+ * @brief Constructor for exchange executor.
+ * @param node Exchange node corresponding to this executor.
+ */
+ExchangeExecutor::ExchangeExecutor(const planner::AbstractPlan *node,
+                                   ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context) {}
+
+ExchangeExecutor::~ExchangeExecutor() { Clear(); }
+
+/**
+ * @brief Checks the subtree and builds the executors of its instances.
+ * @return true on success, false otherwise.
+ */
+bool ExchangeExecutor::DInit() {
+  const planner::ExchangePlan &node = GetPlanNode<planner::ExchangePlan>();
+
+  Clear();
+  returned_tuple_count_ = 0;
+
+  std::vector<storage::DataTable *> scanned_tables;
+  if (node.GetChildren().size() != 1 || node.GetPartitionCount() == 0 ||
+      IsPartitionable(node.GetChildren()[0].get(), node.GetPartitionType(),
+                      scanned_tables) == false ||
+      scanned_tables.size() != 1) {
+    LOG_ERROR("Exchange over a subtree that cannot be partitioned");
+    return false;
+  }
+
+  // Counted once, the instances start at different times and must split the
+  // same tile groups
+  uint64_t tile_group_count = scanned_tables[0]->GetTileGroupCount();
+
+  for (size_t partition_id = 0; partition_id < node.GetPartitionCount();
+       partition_id++) {
+    std::unique_ptr<Instance> instance(new Instance());
+    instance->partition.partition_type = node.GetPartitionType();
+    instance->partition.partition_id = partition_id;
+    instance->partition.partition_count = node.GetPartitionCount();
+    instance->partition.hash_column_ids = node.GetHashColumnIds();
+
+    // Every instance of a hash partitioned subtree reads the whole table
+    if (node.GetPartitionType() == PARTITION_TYPE_TILE_GROUP_RANGE) {
+      instance->partition.start_tile_group_offset = static_cast<oid_t>(
+          tile_group_count * partition_id / node.GetPartitionCount());
+      instance->partition.end_tile_group_offset = static_cast<oid_t>(
+          tile_group_count * (partition_id + 1) / node.GetPartitionCount());
+    } else {
+      instance->partition.start_tile_group_offset = START_OID;
+      instance->partition.end_tile_group_offset =
+          static_cast<oid_t>(tile_group_count);
+    }
+
+    instance->executor_context.reset(new ExecutorContext(
+        executor_context_->GetTransaction(), executor_context_->GetParams()));
+    instance->executor_context->SetPartition(&instance->partition,
+                                             &transaction_latch_);
+    instance->executor_context->SetMemoryTracker(
+        executor_context_->GetMemoryTracker());
+
+    // Compiled pipelines do not know about partitions
+    instance->executor_tree.reset(bridge::BuildExecutorTree(
+        nullptr, node.GetChildren()[0].get(), instance->executor_context.get(),
+        false));
+    if (tuple_budget_ != 0) {
+      instance->executor_tree->SetTupleBudget(tuple_budget_);
+    }
+
+    instances_.push_back(std::move(instance));
+  }
+
+  return true;
+}
+
+/**
+ * @brief Returns the next logical tile any of the instances produced.
+ * Once an instance failed, the rest of the output is dropped and the failure
+ * is thrown, so that the parent never sees a partial result as the whole.
+ * @return true on success, false if all instances are done.
+ */
+bool ExchangeExecutor::DExecute() {
+  if (task_group_ == nullptr) {
+    StartInstances();
+  }
+
+  auto &task_scheduler = TaskScheduler::GetInstance();
+  while (true) {
+    {
+      std::lock_guard<std::mutex> lock(latch_);
+      if (exception_ != nullptr) {
+        break;
+      }
+      if (output_.empty() == false) {
+        auto tile = output_.front();
+        output_.pop_front();
+
+        // The parent has what it needs, the rest of the table is not read
+        returned_tuple_count_ += tile->GetTupleCount();
+        if (tuple_budget_ != 0 && returned_tuple_count_ >= tuple_budget_) {
+          CancelInstances();
+        }
+
+        SetOutput(tile);
+        return true;
+      }
+      if (running_instance_count_ == 0) {
+        break;
+      }
+    }
+
+    // The instances may wait behind tasks of other queries, help out rather
+    // than just block
+    if (task_scheduler.RunPendingTask() == false) {
+      std::unique_lock<std::mutex> lock(latch_);
+      output_ready_.wait_for(lock, output_timeout, [this] {
+        return output_.empty() == false || running_instance_count_ == 0 ||
+               exception_ != nullptr;
+      });
+    }
+  }
+
+  if (exception_ != nullptr) {
+    std::rethrow_exception(exception_);
+  }
+  return false;
+}
+
+bool ExchangeExecutor::IsPartitionable(
+    const planner::AbstractPlan *plan, PartitionType partition_type,
+    std::vector<storage::DataTable *> &scanned_tables) {
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN: {
+      auto table = static_cast<const planner::SeqScanPlan *>(plan)->GetTable();
+      if (table != nullptr) {
+        scanned_tables.push_back(table);
+      }
+      break;
+    }
+
+    case PLAN_NODE_TYPE_PROJECTION:
+    case PLAN_NODE_TYPE_MATERIALIZE:
+      break;
+
+    // Groups must not span partitions, which only hash partitions of the
+    // group by columns guarantee
+    case PLAN_NODE_TYPE_AGGREGATE_V2:
+      if (partition_type != PARTITION_TYPE_HASH) {
+        return false;
+      }
+      break;
+
+    // Anything else would see more than its partition, or see tuples of
+    // other partitions
+    default:
+      return false;
+  }
+
+  for (auto &child : plan->GetChildren()) {
+    if (IsPartitionable(child.get(), partition_type, scanned_tables) ==
+        false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ExchangeExecutor::StartInstances() {
+  task_group_.reset(new TaskGroup());
+
+  {
+    std::lock_guard<std::mutex> lock(latch_);
+    running_instance_count_ = instances_.size();
+  }
+
+  auto &task_scheduler = TaskScheduler::GetInstance();
+  for (auto &instance : instances_) {
+    auto instance_ptr = instance.get();
+    task_scheduler.Submit(*task_group_,
+                          [this, instance_ptr] { RunInstance(*instance_ptr); });
+  }
+}
+
+void ExchangeExecutor::RunInstance(Instance &instance) {
+  auto executor_tree = instance.executor_tree.get();
+  auto task_group = task_group_.get();
+  bool status = true;
+
+  try {
+    status = executor_tree->Init();
+    while (status && task_group->IsCancelled() == false &&
+           executor_tree->Execute()) {
+      std::unique_ptr<LogicalTile> tile(executor_tree->GetOutput());
+      if (tile == nullptr) {
+        continue;
+      }
+
+      std::lock_guard<std::mutex> lock(latch_);
+      output_.push_back(tile.release());
+      output_ready_.notify_one();
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(latch_);
+    if (exception_ == nullptr) {
+      exception_ = std::current_exception();
+    }
+  }
+
+  if (status == false) {
+    LOG_ERROR("Instance %u of the exchange failed to initialize",
+              instance.partition.partition_id);
+    std::lock_guard<std::mutex> lock(latch_);
+    if (exception_ == nullptr) {
+      exception_ = std::make_exception_ptr(ExecutorException(
+          "Instance " + std::to_string(instance.partition.partition_id) +
+          " of the exchange failed to initialize"));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(latch_);
+  running_instance_count_--;
+
+  // The result is lost anyway, the other instances can stop
+  if (exception_ != nullptr) {
+    CancelInstances();
+  }
+  output_ready_.notify_all();
+}
+
+void ExchangeExecutor::SetTupleBudget(size_t tuple_budget) {
+  tuple_budget_ = tuple_budget;
+  for (auto &instance : instances_) {
+    instance->executor_tree->SetTupleBudget(tuple_budget);
+  }
+}
+
+// Unlike cancelling the task group, the tasks still run, so that every
+// instance counts itself out of the running ones
+void ExchangeExecutor::CancelInstances() {
+  for (auto &instance : instances_) {
+    instance->executor_context->Cancel();
+  }
+}
+
+void ExchangeExecutor::StopInstances() {
+  if (task_group_ == nullptr) {
+    return;
+  }
+
+  task_group_->Cancel();
+  TaskScheduler::GetInstance().Wait(*task_group_);
+  task_group_.reset();
+}
+
+void ExchangeExecutor::Clear() {
+  StopInstances();
+
+  for (auto tile : output_) {
+    delete tile;
+  }
+  output_.clear();
+
+  for (auto &instance : instances_) {
+    bridge::CleanExecutorTree(instance->executor_tree.get());
+  }
+  instances_.clear();
+
+  exception_ = nullptr;
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -14,17 +14,20 @@
 #include "type/value.h"
 #include "executor/executor_context.h"
 #include "concurrency/transaction.h"
+#include "configuration/configuration.h"
 
 namespace peloton {
 namespace executor {
 
 ExecutorContext::ExecutorContext(concurrency::Transaction *transaction)
-    : transaction_(transaction) {}
+    : transaction_(transaction),
+      memory_tracker_(new MemoryTracker(FLAGS_query_memory_limit)) {}
 
 ExecutorContext::ExecutorContext(concurrency::Transaction *transaction,
                                  const std::vector<type::Value> &params)
     : transaction_(transaction),
-      params_(params) {}
+      params_(params),
+      memory_tracker_(new MemoryTracker(FLAGS_query_memory_limit)) {}
 
 ExecutorContext::~ExecutorContext() {
   // params will be freed automatically
@@ -48,11 +51,33 @@ void ExecutorContext::ClearParams() {
 
 type::VarlenPool *ExecutorContext::GetExecutorContextPool() {
   // construct pool if needed
-  if (pool_.get() == nullptr) pool_.reset(new type::VarlenPool(BACKEND_TYPE_MM));
+  if (pool_.get() == nullptr)
+    pool_.reset(new TrackedVarlenPool(BACKEND_TYPE_MM, memory_tracker_));
 
   // return pool
   return pool_.get();
 }
 
+void ExecutorContext::SetPartition(const ExecutorPartition *partition,
+                                   std::shared_timed_mutex *transaction_latch) {
+  partition_ = partition;
+  transaction_latch_ = transaction_latch;
+}
+
+std::shared_lock<std::shared_timed_mutex>
+ExecutorContext::LatchTransactionShared() {
+  if (transaction_latch_ == nullptr) {
+    return std::shared_lock<std::shared_timed_mutex>();
+  }
+  return std::shared_lock<std::shared_timed_mutex>(*transaction_latch_);
+}
+
+std::unique_lock<std::shared_timed_mutex> ExecutorContext::LatchTransaction() {
+  if (transaction_latch_ == nullptr) {
+    return std::unique_lock<std::shared_timed_mutex>();
+  }
+  return std::unique_lock<std::shared_timed_mutex>(*transaction_latch_);
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -24,6 +24,12 @@
 namespace peloton {
 namespace executor {
 
+// Bytes of the hash table per tuple, with a bucket and a node for the key
+// and for its position
+static const size_t hash_entry_size =
+    sizeof(HashExecutor::HashMapType::value_type) +
+    sizeof(std::pair<size_t, oid_t>) + 4 * sizeof(void *);
+
 /**
  * @brief Constructor
  */
@@ -78,8 +84,16 @@ bool HashExecutor::DExecute() {
       column_ids_.push_back(tuple_value->GetColumnId());
     }
 
+    size_t tuple_count = 0;
+    for (auto &child_tile : child_tiles_) {
+      tuple_count += child_tile->GetTupleCount();
+    }
+    ChargeMemory(tuple_count * hash_entry_size);
+    join_filter_.reset(new RuntimeJoinFilter(tuple_count));
+
     // Construct the hash table by going over each child logical tile and
     // hashing
+    std::vector<type::Value> key;
     for (size_t child_tile_itr = 0; child_tile_itr < child_tiles_.size();
          child_tile_itr++) {
       auto tile = child_tiles_[child_tile_itr].get();
@@ -90,6 +104,15 @@ bool HashExecutor::DExecute() {
         // Value : < child_tile offset, tuple offset >
         hash_table_[HashMapType::key_type(tile, tuple_id, &column_ids_)].insert(
             std::make_pair(child_tile_itr, tuple_id));
+
+        // Same hash as the one of the container tuple
+        size_t hash = 0;
+        key.clear();
+        for (auto column_id : column_ids_) {
+          key.push_back(tile->GetValue(tuple_id, column_id));
+          key.back().HashCombine(hash);
+        }
+        join_filter_->Insert(hash, key);
       }
     }
 
@@ -17,6 +17,7 @@
 #include "common/logger.h"
 #include "executor/logical_tile_factory.h"
 #include "executor/hash_join_executor.h"
+#include "executor/seq_scan_executor.h"
 #include "expression/abstract_expression.h"
 #include "common/container_tuple.h"
 
@@ -78,6 +79,8 @@ bool HashJoinExecutor::DExecute() {
         BufferRightTile(children_[1]->GetOutput());
       }
       right_child_done_ = true;
+
+      PushDownJoinFilter();
     }
 
     // Get next tile from LEFT child
@@ -178,5 +181,31 @@ bool HashJoinExecutor::DExecute() {
   }
 }
 
+/**
+ * @brief Hands the filter over the keys of the hash table to the scan on
+ * the left side, so that it drops the tuples without a match early. Only
+ * joins that drop those tuples anyway can do that.
+ */
+void HashJoinExecutor::PushDownJoinFilter() {
+  auto join_filter = hash_executor_->GetJoinFilter();
+  if (join_filter == nullptr ||
+      (join_type_ != JOIN_TYPE_INNER && join_type_ != JOIN_TYPE_RIGHT)) {
+    return;
+  }
+
+  // A compiled pipeline may stand in for the scan
+  auto scan_executor = dynamic_cast<SeqScanExecutor *>(children_[0]);
+  if (scan_executor == nullptr) {
+    return;
+  }
+
+  // The left tuples are probed with the column ids of the hash keys
+  if (scan_executor->SetJoinFilter(join_filter,
+                                   hash_executor_->GetHashKeyIds())) {
+    LOG_TRACE("Pushed a join filter over %lu keys into the left scan",
+              join_filter->GetKeyCount());
+  }
+}
+
 }  // namespace executor
 }  // namespace peloton
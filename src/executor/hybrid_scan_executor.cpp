@@ -196,6 +196,12 @@ bool HybridScanExecutor::SeqScanUtil() {
 
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
+    // Resolve the column locations once for the whole tile group
+    std::vector<storage::ColumnAccessor> accessors;
+    if (predicate_ != nullptr) {
+      accessors = tile_group->GetColumnAccessors();
+    }
+
     // Construct position list by looping through tile group
     // and applying the predicate.
     oid_t upper_bound_block = 0;
@@ -221,8 +227,8 @@ bool HybridScanExecutor::SeqScanUtil() {
           position_list.push_back(tuple_id);
         }
         else {
-          expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                               tuple_id);
+          expression::ContainerTuple<storage::TileGroup> tuple(
+              tile_group.get(), tuple_id, &accessors);
           auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
           if (eval == true) {
             position_list.push_back(tuple_id);
@@ -230,8 +236,8 @@ bool HybridScanExecutor::SeqScanUtil() {
         }
       }
       else {
-        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                             tuple_id);
+        expression::ContainerTuple<storage::TileGroup> tuple(
+            tile_group.get(), tuple_id, &accessors);
         auto eval =
             predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
         if (eval == true) {
@@ -0,0 +1,291 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_executor.cpp
+//
+// Identification: src/executor/index_nested_loop_join_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "type/types.h"
+#include "common/logger.h"
+#include "common/container_tuple.h"
+#include "catalog/manager.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/index_nested_loop_join_executor.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/abstract_expression.h"
+#include "index/index.h"
+#include "planner/index_nested_loop_join_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * @brief Constructor for index nested loop join executor.
+ * @param node Index nested loop join node corresponding to this executor.
+ */
+IndexNestedLoopJoinExecutor::IndexNestedLoopJoinExecutor(
+    const planner::AbstractPlan *node, ExecutorContext *executor_context)
+    : AbstractJoinExecutor(node, executor_context) {}
+
+IndexNestedLoopJoinExecutor::~IndexNestedLoopJoinExecutor() {
+  for (auto output_tile : buffered_output_tiles_) {
+    delete output_tile;
+  }
+}
+
+/**
+ * @brief Grab the inner table and the index from the plan node.
+ * @return true on success, false otherwise.
+ */
+bool IndexNestedLoopJoinExecutor::DInit() {
+  // The inner side is read from the index, there is only the outer child
+  PL_ASSERT(children_.size() == 1);
+
+  const planner::IndexNestedLoopJoinPlan &node =
+      GetPlanNode<planner::IndexNestedLoopJoinPlan>();
+
+  predicate_ = node.GetPredicate();
+  proj_info_ = node.GetProjInfo();
+  join_type_ = node.GetJoinType();
+  proj_schema_ = node.GetSchema();
+
+  if (join_type_ != JOIN_TYPE_INNER && join_type_ != JOIN_TYPE_LEFT) {
+    throw Exception("Unsupported index nested loop join type : " +
+                    std::string(GetJoinTypeString()));
+  }
+
+  inner_table_ = node.GetInnerTable();
+  index_ = node.GetIndex().get();
+  join_column_ids_outer_ = node.GetJoinColumnsOuter();
+  PL_ASSERT(inner_table_ != nullptr && index_ != nullptr);
+  PL_ASSERT(join_column_ids_outer_.size() ==
+            index_->GetKeySchema()->GetColumnCount());
+
+  inner_column_ids_ = node.GetInnerColumnIds();
+  if (inner_column_ids_.empty() == true) {
+    inner_column_ids_.resize(inner_table_->GetSchema()->GetColumnCount());
+    std::iota(inner_column_ids_.begin(), inner_column_ids_.end(), 0);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Joins the next outer tile with the matching inner tuples.
+ * @return true on success, false otherwise.
+ */
+bool IndexNestedLoopJoinExecutor::DExecute() {
+  LOG_TRACE("********** Index Nested Loop %s Join executor :: 1 child ",
+            GetJoinTypeString());
+
+  // Loop until we have non-empty result tile or exit
+  for (;;) {
+    // Check if we have any buffered output tiles
+    if (buffered_output_tiles_.empty() == false) {
+      SetOutput(buffered_output_tiles_.front());
+      buffered_output_tiles_.pop_front();
+      return true;
+    }
+
+    // Build outer join output when done
+    if (left_child_done_ == true) {
+      return BuildOuterJoinOutput();
+    }
+
+    if (children_[0]->Execute() == false) {
+      LOG_TRACE("Left child is exhausted.");
+      left_child_done_ = true;
+      continue;
+    }
+
+    BufferLeftTile(children_[0]->GetOutput());
+    if (ProbeIndex(left_result_tiles_.back().get()) == false) {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief Looks up the join keys of every tuple of the outer tile and buffers
+ * one output tile per inner tile group with matches.
+ * @return false if the transaction has to abort.
+ */
+bool IndexNestedLoopJoinExecutor::ProbeIndex(LogicalTile *outer_tile) {
+  auto pool = executor_context_->GetExecutorContextPool();
+  auto key_schema = index_->GetKeySchema();
+
+  // Build the keys. NULL does not join with anything.
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<const storage::Tuple *> key_ptrs;
+  std::vector<oid_t> outer_rows;
+  for (oid_t outer_row : *outer_tile) {
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+    bool has_null = false;
+    for (oid_t key_column_itr = 0;
+         key_column_itr < join_column_ids_outer_.size(); key_column_itr++) {
+      auto value = outer_tile->GetValue(
+          outer_row, join_column_ids_outer_[key_column_itr]);
+      if (value.IsNull() == true) {
+        has_null = true;
+        break;
+      }
+      key->SetValue(key_column_itr, value, pool);
+    }
+    if (has_null == true) {
+      continue;
+    }
+
+    key_ptrs.push_back(key.get());
+    keys.push_back(std::move(key));
+    outer_rows.push_back(outer_row);
+  }
+
+  std::vector<std::vector<ItemPointer *>> location_ptrs;
+  index_->ScanBatch(key_ptrs, location_ptrs);
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+
+  // (outer row, inner offset) pairs of every inner tile group
+  std::map<oid_t, std::vector<std::pair<oid_t, oid_t>>> matches;
+  for (size_t key_itr = 0; key_itr < location_ptrs.size(); key_itr++) {
+    for (auto location_ptr : location_ptrs[key_itr]) {
+      ItemPointer tuple_location = *location_ptr;
+      auto visibility = GetVisibleVersion(tuple_location);
+      if (visibility == VISIBILITY_DELETED) {
+        continue;
+      } else if (visibility == VISIBILITY_INVISIBLE) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return false;
+      }
+
+      if (transaction_manager.PerformRead(current_txn, tuple_location,
+                                          false) == false) {
+        transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+        return false;
+      }
+      oid_t tuple_offset = tuple_location.offset;
+      matches[tuple_location.block].emplace_back(outer_rows[key_itr],
+                                                 tuple_offset);
+    }
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto &tile_group_matches : matches) {
+    auto tile_group = manager.GetTileGroup(tile_group_matches.first);
+
+    // The inner tuples of this tile group, one row per match
+    std::vector<oid_t> inner_positions;
+    for (auto &match : tile_group_matches.second) {
+      inner_positions.push_back(match.second);
+    }
+    std::unique_ptr<LogicalTile> inner_tile(LogicalTileFactory::GetTile());
+    inner_tile->AddColumns(tile_group, inner_column_ids_);
+    inner_tile->AddPositionList(std::move(inner_positions));
+
+    auto output_tile = BuildOutputLogicalTile(outer_tile, inner_tile.get());
+    LogicalTile::PositionListsBuilder pos_lists_builder(outer_tile,
+                                                        inner_tile.get());
+
+    for (oid_t inner_row = 0; inner_row < tile_group_matches.second.size();
+         inner_row++) {
+      oid_t outer_row = tile_group_matches.second[inner_row].first;
+
+      if (predicate_ != nullptr) {
+        expression::ContainerTuple<executor::LogicalTile> outer_tuple(
+            outer_tile, outer_row);
+        expression::ContainerTuple<executor::LogicalTile> inner_tuple(
+            inner_tile.get(), inner_row);
+        auto eval =
+            predicate_->Evaluate(&outer_tuple, &inner_tuple, executor_context_);
+        if (eval.IsFalse()) {
+          continue;
+        }
+      }
+
+      RecordMatchedLeftRow(left_result_tiles_.size() - 1, outer_row);
+      pos_lists_builder.AddRow(outer_row, inner_row);
+    }
+
+    if (pos_lists_builder.Size() > 0) {
+      output_tile->SetPositionListsAndVisibility(pos_lists_builder.Release());
+      buffered_output_tiles_.push_back(output_tile.release());
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Walks the version chain from the index entry to the version the
+ * transaction can see.
+ * @return VISIBILITY_OK with tuple_location pointing at the visible version,
+ * VISIBILITY_DELETED if there is none, and VISIBILITY_INVISIBLE if the chain
+ * was changed under us and the transaction has to abort.
+ */
+VisibilityType IndexNestedLoopJoinExecutor::GetVisibleVersion(
+    ItemPointer &tuple_location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto current_txn = executor_context_->GetTransaction();
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto tile_group_header =
+      manager.GetTileGroup(tuple_location.block)->GetHeader();
+  size_t chain_length = 0;
+
+  while (true) {
+    ++chain_length;
+
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_location.offset);
+    if (visibility != VISIBILITY_INVISIBLE) {
+      return visibility;
+    }
+
+    bool is_acquired = (tile_group_header->GetTransactionId(
+                            tuple_location.offset) == INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(tuple_location.offset) <=
+                     current_txn->GetBeginCommitId());
+    if (is_acquired && is_alive) {
+      // The version expired while we were looking, start over from the
+      // newest version
+      tuple_location =
+          *(tile_group_header->GetIndirection(tuple_location.offset));
+      tile_group_header =
+          manager.GetTileGroup(tuple_location.block)->GetHeader();
+      chain_length = 0;
+      continue;
+    }
+
+    tuple_location = tile_group_header->GetNextItemPointer(
+        tuple_location.offset);
+    if (tuple_location.IsNull()) {
+      // Nothing committed yet, the same as a deleted tuple. A chain without
+      // a visible version has been changed under us.
+      return (chain_length == 1) ? VISIBILITY_DELETED : VISIBILITY_INVISIBLE;
+    }
+
+    tile_group_header = manager.GetTileGroup(tuple_location.block)->GetHeader();
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
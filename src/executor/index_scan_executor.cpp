@@ -12,7 +12,9 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
+#include <set>
 #include <utility>
 #include <vector>
 #include <numeric>
@@ -23,9 +25,11 @@
 #include "executor/logical_tile_factory.h"
 #include "executor/executor_context.h"
 #include "expression/abstract_expression.h"
+#include "expression/expression_util.h"
 #include "common/container_tuple.h"
 #include "index/index.h"
 #include "storage/data_table.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -77,6 +81,12 @@ bool IndexScanExecutor::DInit() {
   runtime_keys_ = node.GetRunTimeKeys();
   predicate_ = node.GetPredicate();
 
+  ordered_ = node.IsOrdered();
+  scan_direction_ = node.GetScanDirection();
+  limit_ = node.GetLimit();
+  scan_limit_ = limit_;
+  ApplyTupleBudget();
+
   if (runtime_keys_.size() != 0) {
     PL_ASSERT(runtime_keys_.size() == values_.size());
 
@@ -100,6 +110,8 @@ bool IndexScanExecutor::DInit() {
     std::iota(full_column_ids_.begin(), full_column_ids_.end(), 0);
   }
 
+  InitIndexOnlyScan();
+
   return true;
 }
 
@@ -110,7 +122,11 @@ bool IndexScanExecutor::DInit() {
 bool IndexScanExecutor::DExecute() {
   LOG_TRACE("Index Scan executor :: 0 child");
 
-  if (!done_) {
+  if (executor_context_->IsCancelled()) {
+    return false;
+  }
+
+  while (!done_) {
     if (index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
       auto status = ExecPrimaryIndexLookup();
       if (status == false) return false;
@@ -118,6 +134,17 @@ bool IndexScanExecutor::DExecute() {
       auto status = ExecSecondaryIndexLookup();
       if (status == false) return false;
     }
+
+    // Some of the entries found were not visible, so scan again for more
+    if (NeedMoreEntries() == true) {
+      for (auto tile : result_) {
+        delete tile;
+      }
+      result_.clear();
+
+      scan_limit_ *= 2;
+      done_ = false;
+    }
   }
   // Already performed the index lookup
   PL_ASSERT(done_);
@@ -145,18 +172,14 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   std::vector<ItemPointer *> tuple_location_ptrs;
 
   // Grab info from plan node
-  const planner::IndexScanPlan &node = GetPlanNode<planner::IndexScanPlan>();
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
   PL_ASSERT(index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    index_->Scan(values_, key_column_ids_, expr_types_,
-                 SCAN_DIRECTION_TYPE_FORWARD, tuple_location_ptrs,
-                 &node.GetIndexPredicate().GetConjunctionList()[0]);
-  }
+  // the values of the index-only columns of every entry, if the index
+  // could return them
+  std::vector<type::Value> key_values;
+  bool index_only = ScanIndex(tuple_location_ptrs, key_values);
 
   if (tuple_location_ptrs.size() == 0) {
     LOG_TRACE("no tuple is retrieved from index.");
@@ -168,17 +191,43 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
   auto current_txn = executor_context_->GetTransaction();
 
-  std::map<oid_t, std::vector<oid_t>> visible_tuples;
+  std::vector<ItemPointer> visible_tuples;
+  std::vector<const type::Value *> index_only_entries;
 
-  // for every tuple that is found in the index.
-  for (auto tuple_location_ptr : tuple_location_ptrs) {
+  // the entries past the budget are neither read nor returned
+  size_t tuple_limit =
+      (tuple_budget_ == 0) ? tuple_location_ptrs.size() : tuple_budget_;
 
-    ItemPointer tuple_location = *tuple_location_ptr;
+  // for every tuple that is found in the index.
+  for (size_t location_itr = 0;
+       location_itr < tuple_location_ptrs.size() &&
+       visible_tuples.size() + index_only_entries.size() < tuple_limit;
+       location_itr++) {
+    ItemPointer tuple_location = *tuple_location_ptrs[location_itr];
 
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(tuple_location.block);
     auto tile_group_header = tile_group.get()->GetHeader();
 
+    // the index entry holds the values of tuples in all-visible tile groups
+    if (index_only == true &&
+        tile_group_header->IsAllVisible(tuple_location.offset,
+                                        current_txn->GetBeginCommitId())) {
+      auto entry_values =
+          &key_values[location_itr * index_only_key_columns_.size()];
+      if (EvaluateIndexEntry(entry_values) == true) {
+        auto res = transaction_manager.PerformRead(current_txn, tuple_location,
+                                                   acquire_owner);
+        if (!res) {
+          transaction_manager.SetTransactionResult(current_txn,
+                                                   RESULT_FAILURE);
+          return res;
+        }
+        index_only_entries.push_back(entry_values);
+      }
+      continue;
+    }
+
     size_t chain_length = 0;
 
     // the following code traverses the version chain until a certain visible
@@ -219,7 +268,9 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
             return res;
           }
           // if perform read is successful, then add to visible tuple vector.
-          visible_tuples[tuple_location.block].push_back(tuple_location.offset);
+          visible_tuples.push_back(tuple_location);
+        } else {
+          CountFilteredTuples(1);
         }
 
         break;
@@ -277,21 +328,9 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
   }
 
-  // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuples.first);
+  AddResultTiles(visible_tuples);
 
-    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-    // Add relevant columns to logical tile
-    logical_tile->AddColumns(tile_group, full_column_ids_);
-    logical_tile->AddPositionList(std::move(tuples.second));
-    if (column_ids_.size() != 0) {
-      logical_tile->ProjectColumns(full_column_ids_, column_ids_);
-    }
-
-    result_.push_back(logical_tile.release());
-  }
+  AddIndexOnlyTile(index_only_entries);
 
   done_ = true;
 
@@ -307,18 +346,14 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   std::vector<ItemPointer *> tuple_location_ptrs;
 
   // Grab info from plan node
-  const planner::IndexScanPlan &node = GetPlanNode<planner::IndexScanPlan>();
   bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
 
   PL_ASSERT(index_->GetIndexType() != INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
 
-  if (0 == key_column_ids_.size()) {
-    index_->ScanAllKeys(tuple_location_ptrs);
-  } else {
-    index_->Scan(values_, key_column_ids_, expr_types_,
-                 SCAN_DIRECTION_TYPE_FORWARD, tuple_location_ptrs,
-                 &node.GetIndexPredicate().GetConjunctionList()[0]);
-  }
+  // the values of the index-only columns of every entry, if the index
+  // could return them
+  std::vector<type::Value> key_values;
+  bool index_only = ScanIndex(tuple_location_ptrs, key_values);
 
   if (tuple_location_ptrs.size() == 0) {
     LOG_TRACE("no tuple is retrieved from index.");
@@ -330,16 +365,42 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
   auto current_txn = executor_context_->GetTransaction();
 
-  std::map<oid_t, std::vector<oid_t>> visible_tuples;
+  std::vector<ItemPointer> visible_tuples;
+  std::vector<const type::Value *> index_only_entries;
 
-  for (auto tuple_location_ptr : tuple_location_ptrs) {
+  // the entries past the budget are neither read nor returned
+  size_t tuple_limit =
+      (tuple_budget_ == 0) ? tuple_location_ptrs.size() : tuple_budget_;
 
-    ItemPointer tuple_location = *tuple_location_ptr;
+  for (size_t location_itr = 0;
+       location_itr < tuple_location_ptrs.size() &&
+       visible_tuples.size() + index_only_entries.size() < tuple_limit;
+       location_itr++) {
+    ItemPointer tuple_location = *tuple_location_ptrs[location_itr];
 
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(tuple_location.block);
     auto tile_group_header = tile_group.get()->GetHeader();
 
+    // the index entry holds the values of tuples in all-visible tile groups
+    if (index_only == true &&
+        tile_group_header->IsAllVisible(tuple_location.offset,
+                                        current_txn->GetBeginCommitId())) {
+      auto entry_values =
+          &key_values[location_itr * index_only_key_columns_.size()];
+      if (EvaluateIndexEntry(entry_values) == true) {
+        auto res = transaction_manager.PerformRead(current_txn, tuple_location,
+                                                   acquire_owner);
+        if (!res) {
+          transaction_manager.SetTransactionResult(current_txn,
+                                                   RESULT_FAILURE);
+          return res;
+        }
+        index_only_entries.push_back(entry_values);
+      }
+      continue;
+    }
+
     size_t chain_length = 0;
 
     // the following code traverses the version chain until a certain visible
@@ -387,6 +448,18 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           break;
         }
 
+        // An entry left behind by an older key of the tuple leads to the
+        // same version chain. An ordered scan would return the tuple at the
+        // position of the old key, and twice if the new key is in range too.
+        size_t entry_key_offset = location_itr * key_tuple.GetColumnCount();
+        if (ordered_ == true && key_values.empty() == false &&
+            MatchesEntryKey(key_tuple, &key_values[entry_key_offset]) ==
+                false) {
+          LOG_TRACE("Stale entry: %u, %u\n", tuple_location.block,
+                    tuple_location.offset);
+          break;
+        }
+
         bool eval = true;
         // if having predicate, then perform evaluation.
         if (predicate_ != nullptr) {
@@ -405,7 +478,9 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
             return res;
           }
           // if perform read is successful, then add to visible tuple vector.
-          visible_tuples[tuple_location.block].push_back(tuple_location.offset);
+          visible_tuples.push_back(tuple_location);
+        } else {
+          CountFilteredTuples(1);
         }
 
         break;
@@ -466,8 +541,173 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
   }
 
+  AddResultTiles(visible_tuples);
+
+  AddIndexOnlyTile(index_only_entries);
+
+  done_ = true;
+
+  LOG_TRACE("Result tiles : %lu", result_.size());
+
+  return true;
+}
+
+/**
+ * @brief Decides whether tuples can be read from their index entries. Every
+ * output column and every column of the predicate has to be in the key.
+ * Varlen values live outside the key, so those columns have to be inlined.
+ * Scans for update always read the table.
+ */
+void IndexScanExecutor::InitIndexOnlyScan() {
+  index_only_ = false;
+  index_only_columns_.clear();
+  index_only_key_columns_.clear();
+  index_only_schema_.reset();
+
+  // The index-only tile comes after the others, which would break the order
+  if (table_ == nullptr || ordered_ == true ||
+      GetPlanNode<planner::AbstractScan>().IsForUpdate() == true) {
+    return;
+  }
+
+  // The output columns come first, then those only the predicate reads
+  std::vector<oid_t> columns =
+      (column_ids_.size() != 0) ? column_ids_ : full_column_ids_;
+  auto output_column_count = columns.size();
+
+  if (predicate_ != nullptr) {
+    std::set<oid_t> predicate_columns;
+    expression::ExpressionUtil::GetTupleValueColumnIds(predicate_,
+                                                       predicate_columns);
+    for (auto column : predicate_columns) {
+      if (std::find(columns.begin(), columns.end(), column) == columns.end()) {
+        columns.push_back(column);
+      }
+    }
+  }
+
+  auto &tuple_to_index = index_->GetMetadata()->GetTupleToIndexMapping();
+  auto key_schema = index_->GetKeySchema();
+  std::vector<oid_t> key_columns;
+  for (auto column : columns) {
+    if (column >= tuple_to_index.size() ||
+        tuple_to_index[column] == INVALID_OID ||
+        key_schema->IsInlined(tuple_to_index[column]) == false) {
+      return;
+    }
+    key_columns.push_back(tuple_to_index[column]);
+  }
+
+  std::vector<oid_t> output_columns(columns.begin(),
+                                    columns.begin() + output_column_count);
+  index_only_schema_.reset(
+      catalog::Schema::CopySchema(table_->GetSchema(), output_columns));
+  index_only_row_.resize(table_->GetSchema()->GetColumnCount());
+  index_only_columns_ = columns;
+  index_only_key_columns_ = key_columns;
+  index_only_ = true;
+}
+
+/**
+ * @brief Looks up the index. The values of the index-only columns of the
+ * entries found come along if the index can return its keys. Ordered scans
+ * of secondary indexes get the whole key of every entry instead.
+ * @return true if key_values got filled for an index-only scan.
+ */
+bool IndexScanExecutor::ScanIndex(
+    std::vector<ItemPointer *> &tuple_location_ptrs,
+    std::vector<type::Value> &key_values) {
+  const planner::IndexScanPlan &node = GetPlanNode<planner::IndexScanPlan>();
+
+  if (ordered_ == true) {
+    // Without key columns every entry is scanned
+    auto csp_p = (key_column_ids_.size() == 0)
+                     ? nullptr
+                     : &node.GetIndexPredicate().GetConjunctionList()[0];
+    // Updating the key of a primary index moves the tuple to a new version
+    // chain, only secondary entries can be stale
+    bool secondary =
+        (index_->GetIndexType() != INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
+    if (index_->ScanLimit(values_, key_column_ids_, expr_types_,
+                          scan_direction_, tuple_location_ptrs, csp_p,
+                          scan_limit_,
+                          secondary ? &key_values : nullptr) == false) {
+      throw Exception("Index " + index_->GetName() +
+                      " can not scan in key order");
+    }
+    scan_entry_count_ = tuple_location_ptrs.size();
+    return false;
+  }
+
+  if (0 == key_column_ids_.size()) {
+    index_->ScanAllKeys(tuple_location_ptrs);
+    return false;
+  }
+
+  auto csp_p = &node.GetIndexPredicate().GetConjunctionList()[0];
+  if (index_only_ == true &&
+      index_->ScanKeyColumns(values_, key_column_ids_, expr_types_,
+                             SCAN_DIRECTION_TYPE_FORWARD, csp_p,
+                             index_only_key_columns_, tuple_location_ptrs,
+                             key_values) == true) {
+    return true;
+  }
+
+  index_->Scan(values_, key_column_ids_, expr_types_,
+               SCAN_DIRECTION_TYPE_FORWARD, tuple_location_ptrs, csp_p);
+  return false;
+}
+
+/**
+ * @brief Checks whether the key of a visible version is the key of the index
+ * entry it was found through.
+ */
+bool IndexScanExecutor::MatchesEntryKey(const storage::Tuple &key_tuple,
+                                        const type::Value *entry_key) const {
+  for (oid_t column_itr = 0; column_itr < key_tuple.GetColumnCount();
+       column_itr++) {
+    auto value = key_tuple.GetValue(column_itr);
+    auto &entry_value = entry_key[column_itr];
+    if (value.IsNull() == true || entry_value.IsNull() == true) {
+      if (value.IsNull() != entry_value.IsNull()) {
+        return false;
+      }
+      continue;
+    }
+    if (value.CompareEquals(entry_value).IsTrue() == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Builds a logical tile for each block the visible tuples are in. For
+ * ordered scans a new tile starts whenever the block changes, so that the
+ * tuples stay in the order of the index.
+ */
+void IndexScanExecutor::AddResultTiles(
+    const std::vector<ItemPointer> &visible_tuples) {
+  std::vector<std::pair<oid_t, std::vector<oid_t>>> block_tuples;
+
+  if (ordered_ == true) {
+    for (auto &tuple_location : visible_tuples) {
+      if (block_tuples.empty() == true ||
+          block_tuples.back().first != tuple_location.block) {
+        block_tuples.emplace_back(tuple_location.block, std::vector<oid_t>());
+      }
+      block_tuples.back().second.push_back(tuple_location.offset);
+    }
+  } else {
+    std::map<oid_t, std::vector<oid_t>> tuples_by_block;
+    for (auto &tuple_location : visible_tuples) {
+      tuples_by_block[tuple_location.block].push_back(tuple_location.offset);
+    }
+    block_tuples.assign(tuples_by_block.begin(), tuples_by_block.end());
+  }
+
   // Construct a logical tile for each block
-  for (auto tuples : visible_tuples) {
+  for (auto &tuples : block_tuples) {
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(tuples.first);
 
@@ -481,12 +721,83 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
     result_.push_back(logical_tile.release());
   }
+}
 
-  done_ = true;
+/**
+ * @brief Checks whether a limited scan has to go on. That is the case if it
+ * found as many entries as it asked for, but too few of them were visible.
+ */
+bool IndexScanExecutor::NeedMoreEntries() const {
+  if (ordered_ == false || limit_ == 0 || scan_entry_count_ < scan_limit_) {
+    return false;
+  }
 
-  LOG_TRACE("Result tiles : %lu", result_.size());
+  size_t tuple_count = 0;
+  for (auto tile : result_) {
+    tuple_count += tile->GetTupleCount();
+  }
+  return tuple_count < limit_;
+}
 
-  return true;
+void IndexScanExecutor::SetTupleBudget(size_t tuple_budget) {
+  tuple_budget_ = tuple_budget;
+  ApplyTupleBudget();
+}
+
+/**
+ * @brief Lowers the limit of an ordered scan to the budget, so that it asks
+ * the index for fewer entries.
+ */
+void IndexScanExecutor::ApplyTupleBudget() {
+  if (ordered_ == true && tuple_budget_ != 0 &&
+      (limit_ == 0 || tuple_budget_ < limit_)) {
+    limit_ = tuple_budget_;
+    scan_limit_ = limit_;
+  }
+}
+
+/**
+ * @brief Evaluates the predicate on the values of an index entry.
+ */
+bool IndexScanExecutor::EvaluateIndexEntry(const type::Value *entry_values) {
+  if (predicate_ == nullptr) {
+    return true;
+  }
+
+  for (oid_t column_itr = 0; column_itr < index_only_columns_.size();
+       column_itr++) {
+    index_only_row_[index_only_columns_[column_itr]] = entry_values[column_itr];
+  }
+
+  expression::ContainerTuple<std::vector<type::Value>> tuple(&index_only_row_);
+  if (predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue()) {
+    return true;
+  }
+  CountFilteredTuples(1);
+  return false;
+}
+
+/**
+ * @brief Copies the output columns of the index entries read into a new
+ * tile.
+ */
+void IndexScanExecutor::AddIndexOnlyTile(
+    const std::vector<const type::Value *> &entries) {
+  if (entries.size() == 0) {
+    return;
+  }
+
+  std::shared_ptr<storage::Tile> dest_tile(
+      storage::TileFactory::GetTempTile(*index_only_schema_, entries.size()));
+  auto column_count = index_only_schema_->GetColumnCount();
+  for (oid_t tuple_itr = 0; tuple_itr < entries.size(); tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      dest_tile->SetValue(entries[tuple_itr][column_itr], tuple_itr,
+                          column_itr);
+    }
+  }
+
+  result_.push_back(LogicalTileFactory::WrapTiles({dest_tile}));
 }
 
 void IndexScanExecutor::UpdatePredicate(const std::vector<oid_t> &key_column_ids
@@ -39,6 +39,14 @@ bool LimitExecutor::DInit() {
   num_skipped_ = 0;
   num_returned_ = 0;
 
+  // The child can stop once it produced the tuples skipped and returned.
+  // LIMIT 0 never runs the child, and a budget of 0 would mean no budget.
+  const planner::LimitPlan &node = GetPlanNode<planner::LimitPlan>();
+  const size_t tuple_budget = node.GetOffset() + node.GetLimit();
+  if (node.GetLimit() != 0 && tuple_budget >= node.GetLimit()) {
+    children_[0]->SetTupleBudget(tuple_budget);
+  }
+
   return true;
 }
 
@@ -55,6 +63,11 @@ bool LimitExecutor::DExecute() {
 
   LOG_TRACE("Limit executor ");
 
+  // Nothing to return, the child is not even started
+  if (limit == 0) {
+    return false;
+  }
+
   while (num_returned_ < limit && children_[0]->Execute()) {
     std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
 
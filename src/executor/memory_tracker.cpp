@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// memory_tracker.cpp
+//
+// Identification: src/executor/memory_tracker.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/memory_tracker.h"
+
+#include "common/exception.h"
+#include "common/logger.h"
+#include "common/macros.h"
+#include "configuration/configuration.h"
+
+namespace peloton {
+namespace executor {
+
+std::atomic<size_t> MemoryTracker::global_usage_(0);
+
+MemoryTracker::MemoryTracker(size_t limit)
+    : usage_(0), peak_usage_(0), limit_(limit) {}
+
+MemoryTracker::~MemoryTracker() {
+  if (usage_ != 0) {
+    LOG_TRACE("Releasing %lu bytes the executors still held", usage_.load());
+    global_usage_ -= usage_;
+  }
+}
+
+bool MemoryTracker::TryCharge(size_t bytes) {
+  auto usage = usage_.fetch_add(bytes) + bytes;
+  if (limit_ != 0 && usage > limit_) {
+    usage_ -= bytes;
+    return false;
+  }
+
+  auto global_limit = FLAGS_total_query_memory_limit;
+  auto global_usage = global_usage_.fetch_add(bytes) + bytes;
+  if (global_limit != 0 && global_usage > global_limit) {
+    global_usage_ -= bytes;
+    usage_ -= bytes;
+    return false;
+  }
+
+  auto peak_usage = peak_usage_.load();
+  while (usage > peak_usage &&
+         peak_usage_.compare_exchange_weak(peak_usage, usage) == false) {
+  }
+  return true;
+}
+
+void MemoryTracker::Charge(size_t bytes) {
+  if (TryCharge(bytes) == false) {
+    throw OutOfMemoryException(
+        "Query needs " + std::to_string(usage_ + bytes) +
+        " bytes, over its limit of " + std::to_string(limit_) +
+        " bytes or over the limit of all queries of " +
+        std::to_string(FLAGS_total_query_memory_limit) + " bytes");
+  }
+}
+
+void MemoryTracker::Release(size_t bytes) {
+  PL_ASSERT(bytes <= usage_);
+  usage_ -= bytes;
+  global_usage_ -= bytes;
+}
+
+TrackedVarlenPool::TrackedVarlenPool(
+    BackendType backend_type, std::shared_ptr<MemoryTracker> memory_tracker)
+    : type::VarlenPool(backend_type),
+      memory_tracker_(memory_tracker),
+      charged_size_(0) {}
+
+TrackedVarlenPool::~TrackedVarlenPool() {
+  memory_tracker_->Release(charged_size_);
+}
+
+void *TrackedVarlenPool::Allocate(size_t size) {
+  auto addr = type::VarlenPool::Allocate(size);
+
+  // Charge the buffers the pool grew by, the pool never shrinks
+  auto pool_size = GetPoolSize();
+  auto charged_size = charged_size_.load();
+  while (pool_size > charged_size) {
+    if (charged_size_.compare_exchange_weak(charged_size, pool_size) ==
+        false) {
+      continue;
+    }
+    if (memory_tracker_->TryCharge(pool_size - charged_size) == false) {
+      charged_size_ -= pool_size - charged_size;
+      if (addr != nullptr) {
+        Free(addr);
+      }
+      throw OutOfMemoryException("Varlen pool of the query grew to " +
+                                 std::to_string(pool_size) +
+                                 " bytes, over the memory limit");
+    }
+    break;
+  }
+  return addr;
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -125,6 +125,10 @@ bool OrderByExecutor::DoSort() {
   sort_key_tuple_schema_.reset(new catalog::Schema(sort_key_columns));
   auto executor_pool = executor_context_->GetExecutorContextPool();
 
+  // The sort key tuples, their varlen values are charged by the pool
+  ChargeMemory(count * (sizeof(sort_buffer_entry_t) + sizeof(storage::Tuple) +
+                        sort_key_tuple_schema_->GetLength()));
+
   // Extract all valid tuples into a single std::vector (the sort buffer)
   sort_buffer_.reserve(count);
   for (oid_t tile_id = 0; tile_id < input_tiles_.size(); tile_id++) {
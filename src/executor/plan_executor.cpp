@@ -12,12 +12,15 @@
 
 #include <vector>
 
+#include "codegen/query_compiler.h"
 #include "common/logger.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/executor_context.h"
 #include "executor/executors.h"
 #include "executor/plan_executor.h"
 #include "optimizer/util.h"
+#include "statistics/backend_stats_context.h"
+#include "statistics/stats_aggregator.h"
 #include "storage/tuple_iterator.h"
 
 namespace peloton {
@@ -29,11 +32,20 @@ namespace bridge {
 executor::ExecutorContext *BuildExecutorContext(
     const std::vector<type::Value> &params, concurrency::Transaction *txn);
 
-executor::AbstractExecutor *BuildExecutorTree(
-    executor::AbstractExecutor *root, const planner::AbstractPlan *plan,
-    executor::ExecutorContext *executor_context);
+/*
+ * Enables the statistics of EXPLAIN ANALYZE on the executors of the tree
+ */
+static void EnableInstrumentation(executor::AbstractExecutor *executor,
+                                  int depth);
 
-void CleanExecutorTree(executor::AbstractExecutor *root);
+/*
+ * Collects the statistics of the executors in the pre-order of the tree
+ */
+static void CollectOperatorStats(
+    const executor::AbstractExecutor *executor,
+    std::vector<stats::OperatorStats> &operator_stats);
+
+const std::string PlanExecutor::explain_column_name = "QUERY PLAN";
 
 /**
  * @brief Build a executor tree and execute it.
@@ -45,7 +57,8 @@ void CleanExecutorTree(executor::AbstractExecutor *root);
  */
 peloton_status PlanExecutor::ExecutePlan(
     const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
-    std::vector<ResultType> &result, const std::vector<int> &result_format) {
+    std::vector<ResultType> &result, const std::vector<int> &result_format,
+    bool analyze) {
   peloton_status p_status;
 
   if (plan == nullptr) return p_status;
@@ -73,9 +86,14 @@ peloton_status PlanExecutor::ExecutePlan(
   std::unique_ptr<executor::ExecutorContext> executor_context(
       BuildExecutorContext(params, txn));
 
-  // Build the executor tree
+  // Build the executor tree, a compiled pipeline fuses the executors of its
+  // plans, so EXPLAIN ANALYZE runs the interpreted ones to tell them apart
   std::unique_ptr<executor::AbstractExecutor> executor_tree(
-      BuildExecutorTree(nullptr, plan, executor_context.get()));
+      BuildExecutorTree(nullptr, plan, executor_context.get(), !analyze));
+
+  if (analyze == true) {
+    EnableInstrumentation(executor_tree.get(), 0);
+  }
 
   LOG_TRACE("Initializing the executor tree");
 
@@ -93,38 +111,46 @@ peloton_status PlanExecutor::ExecutePlan(
   result.clear();
 
   // Execute the tree until we get result tiles from root node
-  while (status == true) {
-    status = executor_tree->Execute();
-
-    std::unique_ptr<executor::LogicalTile> logical_tile(
-        executor_tree->GetOutput());
-    // Some executors don't return logical tiles (e.g., Update).
-    if (logical_tile.get() != nullptr) {
-      LOG_TRACE("Final Answer: %s",
-                logical_tile->GetInfo().c_str());  // Printing the answers
-      std::unique_ptr<catalog::Schema> output_schema(
-          logical_tile->GetPhysicalSchema());  // Physical schema of the tile
-      std::vector<std::vector<std::string>> answer_tuples;
-      answer_tuples =
-          std::move(logical_tile->GetAllValuesAsStrings(result_format));
-
-      // Construct the returned results
-      for (auto &tuple : answer_tuples) {
-        unsigned int col_index = 0;
-        auto &schema_columns = output_schema->GetColumns();
-        for (auto &column : schema_columns) {
-          auto column_name = column.GetName();
-          auto res = ResultType();
-          PlanExecutor::copyFromTo(column_name, res.first);
-          LOG_TRACE("column name: %s", column_name.c_str());
-          PlanExecutor::copyFromTo(tuple[col_index++], res.second);
-          if (tuple[col_index - 1].c_str() != nullptr) {
-            LOG_TRACE("column content: %s", tuple[col_index - 1].c_str());
+  try {
+    while (status == true) {
+      status = executor_tree->Execute();
+
+      std::unique_ptr<executor::LogicalTile> logical_tile(
+          executor_tree->GetOutput());
+      // Some executors don't return logical tiles (e.g., Update).
+      // EXPLAIN ANALYZE only runs the plan, its tuples are not returned.
+      if (logical_tile.get() != nullptr && analyze == false) {
+        LOG_TRACE("Final Answer: %s",
+                  logical_tile->GetInfo().c_str());  // Printing the answers
+        std::unique_ptr<catalog::Schema> output_schema(
+            logical_tile->GetPhysicalSchema());  // Physical schema of the tile
+        std::vector<std::vector<std::string>> answer_tuples;
+        answer_tuples =
+            std::move(logical_tile->GetAllValuesAsStrings(result_format));
+
+        // Construct the returned results
+        for (auto &tuple : answer_tuples) {
+          unsigned int col_index = 0;
+          auto &schema_columns = output_schema->GetColumns();
+          for (auto &column : schema_columns) {
+            auto column_name = column.GetName();
+            auto res = ResultType();
+            PlanExecutor::copyFromTo(column_name, res.first);
+            LOG_TRACE("column name: %s", column_name.c_str());
+            PlanExecutor::copyFromTo(tuple[col_index++], res.second);
+            if (tuple[col_index - 1].c_str() != nullptr) {
+              LOG_TRACE("column content: %s", tuple[col_index - 1].c_str());
+            }
+            result.push_back(res);
           }
-          result.push_back(res);
         }
       }
     }
+  } catch (OutOfMemoryException &e) {
+    // The query held too much memory, abort it rather than the process
+    LOG_ERROR("%s", e.what());
+    result.clear();
+    txn->SetResult(Result::RESULT_FAILURE);
   }
 
   // Set the result
@@ -134,6 +160,29 @@ peloton_status PlanExecutor::ExecutePlan(
 // final cleanup
 cleanup:
 
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->RecordPeakMemoryUsage(
+        executor_context->GetMemoryTracker()->GetPeakUsage());
+  }
+
+  if (analyze == true) {
+    std::vector<stats::OperatorStats> operator_stats;
+    CollectOperatorStats(executor_tree.get(), operator_stats);
+
+    result.clear();
+    for (auto &stats : operator_stats) {
+      auto res = ResultType();
+      PlanExecutor::copyFromTo(explain_column_name, res.first);
+      PlanExecutor::copyFromTo(stats.GetInfo(), res.second);
+      result.push_back(res);
+    }
+
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->RecordOperatorStats(
+          operator_stats);
+    }
+  }
+
   LOG_TRACE("About to commit: single stmt: %d, init_failure: %d, status: %d",
             single_statement_txn, init_failure, txn->GetResult());
 
@@ -290,6 +339,48 @@ void PlanExecutor::PrintPlan(const planner::AbstractPlan *plan,
   }
 }
 
+/**
+ * @brief Returns the plan tree one node per line for EXPLAIN.
+ * @param The plan tree
+ * @param The result, a line per plan node
+ * @param Depth of the plan node in the plan tree
+ */
+void PlanExecutor::ExplainPlan(const planner::AbstractPlan *plan,
+                               std::vector<ResultType> &result, int depth) {
+  if (plan == nullptr) {
+    return;
+  }
+
+  auto res = ResultType();
+  PlanExecutor::copyFromTo(explain_column_name, res.first);
+  PlanExecutor::copyFromTo(std::string(depth * 2, ' ') + "-> " +
+                               PlanNodeTypeToString(plan->GetPlanNodeType()),
+                           res.second);
+  result.push_back(res);
+
+  for (auto &child : plan->GetChildren()) {
+    ExplainPlan(child.get(), result, depth + 1);
+  }
+}
+
+static void EnableInstrumentation(executor::AbstractExecutor *executor,
+                                  int depth) {
+  executor->EnableInstrumentation(depth);
+  for (auto child : executor->GetChildren()) {
+    EnableInstrumentation(child, depth + 1);
+  }
+}
+
+static void CollectOperatorStats(
+    const executor::AbstractExecutor *executor,
+    std::vector<stats::OperatorStats> &operator_stats) {
+  PL_ASSERT(executor->GetOperatorStats() != nullptr);
+  operator_stats.push_back(*executor->GetOperatorStats());
+  for (auto child : executor->GetChildren()) {
+    CollectOperatorStats(child, operator_stats);
+  }
+}
+
 /**
  * @brief Build Executor Context
  */
@@ -303,16 +394,36 @@ executor::ExecutorContext *BuildExecutorContext(
  * @param The current executor tree
  * @param The plan tree
  * @param Transation context
+ * @param Whether to look for pipelines the query compiler supports
  * @return The updated executor tree.
  */
 executor::AbstractExecutor *BuildExecutorTree(
     executor::AbstractExecutor *root, const planner::AbstractPlan *plan,
-    executor::ExecutorContext *executor_context) {
+    executor::ExecutorContext *executor_context, bool compile) {
   // Base case
   if (plan == nullptr) return root;
 
   executor::AbstractExecutor *child_executor = nullptr;
 
+  // A compiled pipeline replaces the executors of all of its plans, the
+  // interpreted ones of an aggregation stay below it as the fallback
+  auto pipeline =
+      compile ? codegen::QueryCompiler::GetInstance().Compile(plan) : nullptr;
+  if (pipeline != nullptr) {
+    LOG_TRACE("Adding Compiled Pipeline Executer");
+    child_executor = new executor::CompiledPipelineExecutor(
+        plan, executor_context, pipeline);
+    if (pipeline->IsAggregation()) {
+      BuildExecutorTree(child_executor, plan, executor_context, false);
+    }
+
+    if (root != nullptr)
+      root->AddChild(child_executor);
+    else
+      root = child_executor;
+    return root;
+  }
+
   auto plan_node_type = plan->GetPlanNodeType();
   switch (plan_node_type) {
     case PLAN_NODE_TYPE_INVALID:
@@ -355,6 +466,12 @@ executor::AbstractExecutor *BuildExecutorTree(
           new executor::NestedLoopJoinExecutor(plan, executor_context);
       break;
 
+    case PLAN_NODE_TYPE_NESTLOOPINDEX:
+      LOG_TRACE("Adding Index Nested Loop Join Executer");
+      child_executor =
+          new executor::IndexNestedLoopJoinExecutor(plan, executor_context);
+      break;
+
     case PLAN_NODE_TYPE_MERGEJOIN:
       LOG_TRACE("Adding Merge Join Executer");
       child_executor = new executor::MergeJoinExecutor(plan, executor_context);
@@ -370,6 +487,12 @@ executor::AbstractExecutor *BuildExecutorTree(
       child_executor = new executor::HashJoinExecutor(plan, executor_context);
       break;
 
+    case PLAN_NODE_TYPE_ADAPTIVEJOIN:
+      LOG_TRACE("Adding Adaptive Join Executer");
+      child_executor =
+          new executor::AdaptiveJoinExecutor(plan, executor_context);
+      break;
+
     case PLAN_NODE_TYPE_PROJECTION:
       LOG_TRACE("Adding Projection Executer");
       child_executor = new executor::ProjectionExecutor(plan, executor_context);
@@ -405,6 +528,16 @@ executor::AbstractExecutor *BuildExecutorTree(
       child_executor = new executor::CopyExecutor(plan, executor_context);
       break;
 
+    case PLAN_NODE_TYPE_EXCHANGE:
+      // The exchange builds the executors of the instances of its subtree
+      LOG_TRACE("Adding Exchange Executer");
+      child_executor = new executor::ExchangeExecutor(plan, executor_context);
+      if (root != nullptr)
+        root->AddChild(child_executor);
+      else
+        root = child_executor;
+      return root;
+
     default:
       LOG_ERROR("Unsupported plan node type : %d ", plan_node_type);
       break;
@@ -421,8 +554,8 @@ executor::AbstractExecutor *BuildExecutorTree(
   // Recurse
   auto &children = plan->GetChildren();
   for (auto &child : children) {
-    child_executor =
-        BuildExecutorTree(child_executor, child.get(), executor_context);
+    child_executor = BuildExecutorTree(child_executor, child.get(),
+                                       executor_context, compile);
   }
 
   return root;
@@ -75,20 +75,9 @@ bool ProjectionExecutor::DExecute() {
     std::shared_ptr<storage::Tile> dest_tile(
         storage::TileFactory::GetTempTile(*schema_, num_tuples));
 
-    // Create projections tuple-at-a-time from original tile
-    oid_t new_tuple_id = 0;
-    for (oid_t old_tuple_id : *source_tile) {
-      storage::Tuple *buffer = new storage::Tuple(schema_, true);
-      expression::ContainerTuple<LogicalTile> tuple(source_tile.get(),
-                                                    old_tuple_id);
-      project_info_->Evaluate(buffer, &tuple, nullptr, executor_context_);
-
-      // Insert projected tuple into the new tile
-      dest_tile.get()->InsertTuple(new_tuple_id, buffer);
-
-      delete buffer;
-      new_tuple_id++;
-    }
+    // Create projections a column at a time from original tile
+    project_info_->Evaluate(dest_tile.get(), source_tile.get(),
+                            executor_context_);
 
     // Wrap physical tile in logical tile and return it
     SetOutput(LogicalTileFactory::WrapTiles({dest_tile}));
@@ -0,0 +1,102 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// runtime_join_filter.cpp
+//
+// Identification: src/executor/runtime_join_filter.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/runtime_join_filter.h"
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace executor {
+
+// Bits of the filter per key, with the bits that every key sets that gives
+// about 1% false positives
+static const size_t bits_per_key = 10;
+
+// Mixes the bits of the hash, HashCombine leaves the low bits of small
+// integers too regular to index the words with
+static inline uint64_t MixHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// The low bits pick the word, three groups of six high bits the bits in it
+static inline uint64_t GetWordBits(uint64_t hash) {
+  return (1ULL << ((hash >> 46) & 63)) | (1ULL << ((hash >> 52) & 63)) |
+         (1ULL << ((hash >> 58) & 63));
+}
+
+RuntimeJoinFilter::RuntimeJoinFilter(size_t expected_key_count) {
+  size_t word_count = 1;
+  while (word_count * 64 < expected_key_count * bits_per_key) {
+    word_count *= 2;
+  }
+  words_.resize(word_count, 0);
+  word_mask_ = word_count - 1;
+}
+
+void RuntimeJoinFilter::Insert(size_t hash, const std::vector<type::Value> &key) {
+  uint64_t mixed_hash = MixHash(hash);
+  words_[mixed_hash & word_mask_] |= GetWordBits(mixed_hash);
+
+  if (key_count_ == 0) {
+    for (auto &value : key) {
+      key_types_.push_back(value.GetTypeId());
+    }
+    has_range_ = (key.size() == 1);
+  }
+  PL_ASSERT(key.size() == key_types_.size());
+  key_count_++;
+
+  if (has_range_ == false) {
+    return;
+  }
+
+  auto &value = key[0];
+  if (value.IsNull()) {
+    has_range_ = false;
+  } else if (key_count_ == 1) {
+    min_key_ = value.Copy();
+    max_key_ = value.Copy();
+  } else if (value.CompareLessThan(min_key_).IsTrue()) {
+    min_key_ = value.Copy();
+  } else if (value.CompareGreaterThan(max_key_).IsTrue()) {
+    max_key_ = value.Copy();
+  }
+}
+
+bool RuntimeJoinFilter::MayContain(size_t hash) const {
+  uint64_t mixed_hash = MixHash(hash);
+  uint64_t bits = GetWordBits(mixed_hash);
+  return (words_[mixed_hash & word_mask_] & bits) == bits;
+}
+
+bool RuntimeJoinFilter::InRange(const type::Value &value) const {
+  if (has_range_ == false) {
+    return true;
+  }
+  if (key_count_ == 0) {
+    return false;
+  }
+  if (value.IsNull()) {
+    return true;
+  }
+
+  return value.CompareLessThan(min_key_).IsTrue() == false &&
+         value.CompareGreaterThan(max_key_).IsTrue() == false;
+}
+
+}  // namespace executor
+}  // namespace peloton
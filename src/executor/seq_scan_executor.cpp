@@ -12,6 +12,8 @@
 
 #include "executor/seq_scan_executor.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -22,8 +24,12 @@
 #include "executor/logical_tile_factory.h"
 #include "executor/executor_context.h"
 #include "expression/abstract_expression.h"
+#include "expression/column_vector.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
 #include "common/container_tuple.h"
 #include "storage/data_table.h"
+#include "storage/string_dictionary.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
 #include "concurrency/transaction_manager_factory.h"
@@ -55,20 +61,233 @@ bool SeqScanExecutor::DInit() {
 
   target_table_ = node.GetTable();
   
-  current_tile_group_offset_ = START_OID;
+  start_tile_group_offset_ = START_OID;
 
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
 
+    // An instance of a parallel scan only reads the range of the table the
+    // exchange gave it
+    auto partition = executor_context_->GetPartition();
+    if (partition != nullptr) {
+      start_tile_group_offset_ = partition->start_tile_group_offset;
+      table_tile_group_count_ = partition->end_tile_group_offset;
+    }
+
+    table_column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
+    std::iota(table_column_ids_.begin(), table_column_ids_.end(), 0);
+
     if (column_ids_.empty()) {
-      column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
-      std::iota(column_ids_.begin(), column_ids_.end(), 0);
+      column_ids_ = table_column_ids_;
+    }
+  }
+
+  current_tile_group_offset_ = start_tile_group_offset_;
+  returned_tuple_count_ = 0;
+
+  // A join over the scan pushes its filter again once it is rebuilt
+  join_filter_ = nullptr;
+  join_filter_column_ids_.clear();
+
+  // An equality predicate between a varlen column and a constant can be
+  // answered from the dictionaries of that column
+  dictionary_column_id_ = INVALID_OID;
+  if (target_table_ != nullptr && predicate_ != nullptr &&
+      predicate_->GetExpressionType() == EXPRESSION_TYPE_COMPARE_EQUAL &&
+      predicate_->GetChildrenSize() == 2) {
+    auto left = predicate_->GetChild(0);
+    auto right = predicate_->GetChild(1);
+    if (left->GetExpressionType() == EXPRESSION_TYPE_VALUE_CONSTANT) {
+      std::swap(left, right);
+    }
+
+    if (left->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE &&
+        right->GetExpressionType() == EXPRESSION_TYPE_VALUE_CONSTANT) {
+      auto tuple_value =
+          static_cast<const expression::TupleValueExpression *>(left);
+      auto constant =
+          static_cast<const expression::ConstantValueExpression *>(right)
+              ->GetValue();
+      oid_t column_id = tuple_value->GetColumnId();
+      auto schema = target_table_->GetSchema();
+
+      if (tuple_value->GetTupleId() == 0 &&
+          column_id < schema->GetColumnCount() &&
+          schema->IsDictionaryEncoded(column_id) &&
+          schema->GetType(column_id) == constant.GetTypeId() &&
+          constant.IsNull() == false) {
+        dictionary_column_id_ = column_id;
+        dictionary_constant_ = constant;
+      }
     }
   }
 
   return true;
 }
 
+/**
+ * @brief Evaluates the scan predicate over tuples of a tile group.
+ * @param tile_group Tile group the tuples are in.
+ * @param position_list Offsets of the tuples in the tile group.
+ * @return Offsets of the tuples the predicate is true for.
+ */
+std::vector<oid_t> SeqScanExecutor::ApplyPredicate(
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    std::vector<oid_t> position_list) {
+  PL_ASSERT(predicate_ != nullptr);
+
+  // Encoded values match iff they share the entry of the constant, this
+  // is cheaper than any kernel
+  if (dictionary_column_id_ != INVALID_OID) {
+    std::vector<storage::ColumnAccessor> accessors =
+        tile_group->GetColumnAccessors();
+    auto &dictionary_accessor = accessors[dictionary_column_id_];
+    if (dictionary_accessor.dictionary != nullptr) {
+      auto dictionary_entry = dictionary_accessor.dictionary->Lookup(
+          dictionary_constant_.GetData(), dictionary_constant_.GetLength());
+
+      size_t match_count = 0;
+      for (auto tuple_id : position_list) {
+        auto entry = dictionary_accessor.GetDictionaryEntry(tuple_id);
+
+        bool is_match;
+        if (entry != nullptr) {
+          is_match = (entry == dictionary_entry);
+        } else {
+          expression::ContainerTuple<storage::TileGroup> tuple(
+              tile_group.get(), tuple_id, &accessors);
+          is_match = predicate_->Evaluate(&tuple, nullptr, executor_context_)
+                         .IsTrue();
+        }
+
+        if (is_match) {
+          position_list[match_count++] = tuple_id;
+        }
+      }
+      position_list.resize(match_count);
+      return position_list;
+    }
+  }
+
+  // Otherwise the predicate sees the tuples as a logical tile over all
+  // columns of the table, tuple i of which is position_list[i]
+  std::unique_ptr<LogicalTile> tile(LogicalTileFactory::GetTile());
+  tile->AddColumns(tile_group, table_column_ids_);
+  tile->AddPositionList(std::vector<oid_t>(position_list));
+
+  expression::SelectionVector selection(position_list.size());
+  std::iota(selection.begin(), selection.end(), 0);
+  predicate_->EvaluateBatch(*tile, selection, executor_context_);
+
+  for (size_t match_itr = 0; match_itr < selection.size(); match_itr++) {
+    position_list[match_itr] = position_list[selection[match_itr]];
+  }
+  position_list.resize(selection.size());
+  return position_list;
+}
+
+/**
+ * @brief Keeps the tuples of the hash partition of this instance of a
+ * parallel scan.
+ * @param tile_group Tile group the tuples are in.
+ * @param position_list Offsets of the tuples in the tile group.
+ */
+void SeqScanExecutor::ApplyHashPartition(
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    std::vector<oid_t> &position_list) const {
+  auto partition = executor_context_->GetPartition();
+  PL_ASSERT(partition != nullptr &&
+            partition->partition_type == PARTITION_TYPE_HASH);
+
+  size_t match_count = 0;
+  for (auto tuple_id : position_list) {
+    size_t hash = 0;
+    for (auto column_id : partition->hash_column_ids) {
+      tile_group->GetValue(tuple_id, column_id).HashCombine(hash);
+    }
+
+    if (hash % partition->partition_count == partition->partition_id) {
+      position_list[match_count++] = tuple_id;
+    }
+  }
+  position_list.resize(match_count);
+}
+
+/**
+ * @brief Pushes the filter of the build side of a hash join into the scan.
+ * @param join_filter Filter over the join keys of the build side.
+ * @param key_column_ids Output columns of the scan that form the join key.
+ * @return false if the scan cannot apply the filter, e.g. because the types
+ * of the keys differ and so would their hashes.
+ */
+bool SeqScanExecutor::SetJoinFilter(const RuntimeJoinFilter *join_filter,
+                                    const std::vector<oid_t> &key_column_ids) {
+  PL_ASSERT(join_filter != nullptr);
+  if (target_table_ == nullptr) {
+    return false;
+  }
+
+  std::vector<oid_t> table_column_ids;
+  for (auto column_id : key_column_ids) {
+    if (column_id >= column_ids_.size()) {
+      return false;
+    }
+    table_column_ids.push_back(column_ids_[column_id]);
+  }
+
+  // Without keys there is nothing to compare the types with, and nothing
+  // can match anyway
+  auto &key_types = join_filter->GetKeyTypes();
+  if (join_filter->GetKeyCount() > 0) {
+    auto schema = target_table_->GetSchema();
+    if (key_types.size() != table_column_ids.size()) {
+      return false;
+    }
+    for (size_t key_itr = 0; key_itr < key_types.size(); key_itr++) {
+      if (schema->GetType(table_column_ids[key_itr]) != key_types[key_itr]) {
+        return false;
+      }
+    }
+  }
+
+  join_filter_ = join_filter;
+  join_filter_column_ids_ = std::move(table_column_ids);
+  return true;
+}
+
+/**
+ * @brief Keeps the tuples whose join key may be on the build side of the
+ * hash join over this scan.
+ * @param tile_group Tile group the tuples are in.
+ * @param position_list Offsets of the tuples in the tile group.
+ */
+void SeqScanExecutor::ApplyJoinFilter(
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    std::vector<oid_t> &position_list) const {
+  PL_ASSERT(join_filter_ != nullptr);
+
+  size_t match_count = 0;
+  for (auto tuple_id : position_list) {
+    size_t hash = 0;
+    bool in_range = true;
+    for (auto column_id : join_filter_column_ids_) {
+      auto value = tile_group->GetValue(tuple_id, column_id);
+      if (join_filter_->HasRange()) {
+        in_range = join_filter_->InRange(value);
+      }
+      value.HashCombine(hash);
+    }
+
+    if (in_range && join_filter_->MayContain(hash)) {
+      position_list[match_count++] = tuple_id;
+    }
+  }
+
+  LOG_TRACE("Join filter kept %lu of %lu tuples", match_count,
+            position_list.size());
+  position_list.resize(match_count);
+}
+
 /**
  * @brief Creates logical tile from tile group and applies scan predicate.
  * @return true on success, false otherwise.
@@ -82,20 +301,28 @@ bool SeqScanExecutor::DExecute() {
     PL_ASSERT(target_table_ == nullptr);
     PL_ASSERT(column_ids_.size() == 0);
 
-    while (children_[0]->Execute()) {
+    while (GetRemainingTupleBudget() > 0 && children_[0]->Execute()) {
       std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
 
       if (predicate_ != nullptr) {
         // Invalidate tuples that don't satisfy the predicate.
+        expression::SelectionVector tuple_ids;
         for (oid_t tuple_id : *tile) {
-          expression::ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
-          auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
-          if (eval.IsFalse()) {
-          //if (predicate_->Evaluate(&tuple, nullptr, executor_context_)
-          //        .IsFalse()) {
+          tuple_ids.push_back(tuple_id);
+        }
+
+        expression::SelectionVector selection(tuple_ids);
+        predicate_->EvaluateBatch(*tile, selection, executor_context_);
+
+        auto selection_itr = selection.begin();
+        for (oid_t tuple_id : tuple_ids) {
+          if (selection_itr != selection.end() && *selection_itr == tuple_id) {
+            selection_itr++;
+          } else {
             tile->RemoveVisibility(tuple_id);
           }
         }
+        CountFilteredTuples(tuple_ids.size() - selection.size());
       }
 
       if (0 == tile->GetTupleCount()) {  // Avoid returning empty tiles
@@ -103,6 +330,7 @@ bool SeqScanExecutor::DExecute() {
       }
 
       /* Hopefully we needn't do projections here */
+      returned_tuple_count_ += tile->GetTupleCount();
       SetOutput(tile.release());
       return true;
     }
@@ -122,49 +350,80 @@ bool SeqScanExecutor::DExecute() {
     bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
     auto current_txn = executor_context_->GetTransaction();
 
+    auto partition = executor_context_->GetPartition();
+    bool hash_partitioned = (partition != nullptr &&
+                             partition->partition_type == PARTITION_TYPE_HASH);
+
     // Retrieve next tile group.
     while (current_tile_group_offset_ < table_tile_group_count_) {
+      // Stop once the parent has all the tuples it needs
+      auto remaining_tuple_budget = GetRemainingTupleBudget();
+      if (remaining_tuple_budget == 0 || executor_context_->IsCancelled()) {
+        return false;
+      }
+
       auto tile_group =
           target_table_->GetTileGroup(current_tile_group_offset_++);
       auto tile_group_header = tile_group->GetHeader();
 
       oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
-      // Construct position list by looping through tile group
-      // and applying the predicate.
+      // Without anything to filter them, every visible tuple is returned, so
+      // collecting them can stop at the budget
+      size_t visible_tuple_limit = active_tuple_count;
+      if (predicate_ == nullptr && join_filter_ == nullptr &&
+          hash_partitioned == false) {
+        visible_tuple_limit =
+            std::min(visible_tuple_limit, remaining_tuple_budget);
+      }
+
+      // Collect the visible tuples first, so that the predicate can be
+      // evaluated over all of them at once
       std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+      {
+        auto transaction_latch = executor_context_->LatchTransactionShared();
+        for (oid_t tuple_id = 0; tuple_id < active_tuple_count &&
+                                 position_list.size() < visible_tuple_limit;
+             tuple_id++) {
+          auto visibility = transaction_manager.IsVisible(
+              current_txn, tile_group_header, tuple_id);
+          if (visibility == VISIBILITY_OK) {
+            position_list.push_back(tuple_id);
+          }
+        }
+      }
 
+      if (hash_partitioned) {
+        ApplyHashPartition(tile_group, position_list);
+      }
 
-        auto visibility = transaction_manager.IsVisible(current_txn, tile_group_header, tuple_id);
+      auto candidate_count = position_list.size();
 
-        // check transaction visibility
-        if (visibility == VISIBILITY_OK) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
-            if (!res) {
-              transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(current_txn, location, acquire_owner);
-              if (!res) {
-                transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
-                return res;
-              } else {
-                LOG_TRACE("Sequential Scan Predicate Satisfied");
-              }
-            }
+      if (predicate_ != nullptr && position_list.empty() == false) {
+        position_list = ApplyPredicate(tile_group, std::move(position_list));
+      }
+
+      if (join_filter_ != nullptr && position_list.empty() == false) {
+        ApplyJoinFilter(tile_group, position_list);
+      }
+
+      CountFilteredTuples(candidate_count - position_list.size());
+
+      // The tuples past the budget are neither read nor returned
+      if (position_list.size() > remaining_tuple_budget) {
+        position_list.resize(remaining_tuple_budget);
+      }
+
+      {
+        auto transaction_latch = executor_context_->LatchTransaction();
+        for (auto tuple_id : position_list) {
+          ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+          auto res = transaction_manager.PerformRead(current_txn, location,
+                                                     acquire_owner);
+          if (!res) {
+            transaction_manager.SetTransactionResult(current_txn,
+                                                     RESULT_FAILURE);
+            return res;
           }
         }
       }
@@ -175,6 +434,7 @@ bool SeqScanExecutor::DExecute() {
       }
 
       // Construct logical tile.
+      returned_tuple_count_ += position_list.size();
       std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
       logical_tile->AddColumns(tile_group, column_ids_);
       logical_tile->AddPositionList(std::move(position_list));
@@ -188,5 +448,14 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+size_t SeqScanExecutor::GetRemainingTupleBudget() const {
+  if (tuple_budget_ == 0) {
+    return std::numeric_limits<size_t>::max();
+  }
+  return tuple_budget_ > returned_tuple_count_
+             ? tuple_budget_ - returned_tuple_count_
+             : 0;
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -269,7 +269,8 @@ bool UpdateExecutor::DExecute() {
           // finally install new version into the table
           ret = target_table_->InstallVersion(&new_tuple,
                                               &(project_info_->GetTargetList()),
-                                              current_txn, indirection);
+                                              current_txn, indirection,
+                                              &old_tuple);
 
           // PerformUpdate() will not be executed if the insertion failed.
           // There is a write lock acquired, but since it is not in the write
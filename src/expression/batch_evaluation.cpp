@@ -0,0 +1,358 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// batch_evaluation.cpp
+//
+// Identification: src/expression/batch_evaluation.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+#include "common/container_tuple.h"
+#include "executor/logical_tile.h"
+#include "expression/column_vector.h"
+#include "expression/comparison_expression.h"
+#include "expression/conjunction_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/operator_expression.h"
+#include "expression/parameter_value_expression.h"
+#include "expression/tuple_value_expression.h"
+
+namespace peloton {
+namespace expression {
+
+//===--------------------------------------------------------------------===//
+// Tuple at a time fallback
+//===--------------------------------------------------------------------===//
+
+void AbstractExpression::EvaluateBatch(
+    executor::LogicalTile &tile, SelectionVector &selection,
+    executor::ExecutorContext *context) const {
+  ColumnVector result;
+  EvaluateColumn(tile, selection, result, context);
+
+  size_t match_count = 0;
+  for (auto tuple_id : selection) {
+    if (result.GetValue(tuple_id).IsTrue()) {
+      selection[match_count++] = tuple_id;
+    }
+  }
+  selection.resize(match_count);
+}
+
+void AbstractExpression::EvaluateColumn(
+    executor::LogicalTile &tile, const SelectionVector &selection,
+    ColumnVector &result, executor::ExecutorContext *context) const {
+  // The values of an expression without a kernel can be of any type
+  result.Reset(type::Type::INVALID, selection);
+
+  for (auto tuple_id : selection) {
+    ContainerTuple<executor::LogicalTile> tuple(&tile, tuple_id);
+    result.SetValue(tuple_id, Evaluate(&tuple, nullptr, context));
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Leaves
+//===--------------------------------------------------------------------===//
+
+void TupleValueExpression::EvaluateColumn(
+    executor::LogicalTile &tile, const SelectionVector &selection,
+    ColumnVector &result,
+    UNUSED_ATTRIBUTE executor::ExecutorContext *context) const {
+  PL_ASSERT(tuple_idx_ == 0);
+  result.LoadColumn(tile, value_idx_, selection);
+}
+
+void ConstantValueExpression::EvaluateColumn(
+    UNUSED_ATTRIBUTE executor::LogicalTile &tile,
+    UNUSED_ATTRIBUTE const SelectionVector &selection, ColumnVector &result,
+    UNUSED_ATTRIBUTE executor::ExecutorContext *context) const {
+  result.SetConstant(value_);
+}
+
+void ParameterValueExpression::EvaluateColumn(
+    UNUSED_ATTRIBUTE executor::LogicalTile &tile,
+    UNUSED_ATTRIBUTE const SelectionVector &selection, ColumnVector &result,
+    executor::ExecutorContext *context) const {
+  result.SetConstant(Evaluate(nullptr, nullptr, context));
+}
+
+//===--------------------------------------------------------------------===//
+// Comparisons
+//===--------------------------------------------------------------------===//
+
+/*
+ * FilterCompare() - Keeps the tuples the comparison of two unboxed vectors
+ *                   is true for, comparisons with a null are never true
+ */
+template <typename NativeType, typename Getter, typename Compare>
+static void FilterCompare(const ColumnVector &left, const ColumnVector &right,
+                          SelectionVector &selection, Getter get,
+                          Compare compare) {
+  size_t match_count = 0;
+  for (auto tuple_id : selection) {
+    if (left.IsNull(tuple_id) || right.IsNull(tuple_id)) {
+      continue;
+    }
+
+    if (compare(get(left, tuple_id), get(right, tuple_id))) {
+      selection[match_count++] = tuple_id;
+    }
+  }
+  selection.resize(match_count);
+}
+
+template <typename NativeType, typename Getter>
+static void FilterCompare(ExpressionType compare_type,
+                          const ColumnVector &left, const ColumnVector &right,
+                          SelectionVector &selection, Getter get) {
+  switch (compare_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      FilterCompare<NativeType>(left, right, selection, get,
+                                std::equal_to<NativeType>());
+      break;
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      FilterCompare<NativeType>(left, right, selection, get,
+                                std::not_equal_to<NativeType>());
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      FilterCompare<NativeType>(left, right, selection, get,
+                                std::less<NativeType>());
+      break;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      FilterCompare<NativeType>(left, right, selection, get,
+                                std::greater<NativeType>());
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      FilterCompare<NativeType>(left, right, selection, get,
+                                std::less_equal<NativeType>());
+      break;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      FilterCompare<NativeType>(left, right, selection, get,
+                                std::greater_equal<NativeType>());
+      break;
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+}
+
+/*
+ * EvaluateBatch() - Compares integers as integers, and as doubles if either
+ *                   side is a DECIMAL, the way the value types do
+ */
+void ComparisonExpression::EvaluateBatch(
+    executor::LogicalTile &tile, SelectionVector &selection,
+    executor::ExecutorContext *context) const {
+  PL_ASSERT(children_.size() == 2);
+  ColumnVector left;
+  ColumnVector right;
+  children_[0]->EvaluateColumn(tile, selection, left, context);
+  children_[1]->EvaluateColumn(tile, selection, right, context);
+
+  if (left.IsInteger() && right.IsInteger()) {
+    FilterCompare<int64_t>(exp_type_, left, right, selection,
+                           [](const ColumnVector &column, oid_t tuple_id) {
+                             return column.GetInteger(tuple_id);
+                           });
+  } else if (left.IsUnboxed() && right.IsUnboxed()) {
+    FilterCompare<double>(exp_type_, left, right, selection,
+                          [](const ColumnVector &column, oid_t tuple_id) {
+                            return column.GetDecimal(tuple_id);
+                          });
+  } else {
+    size_t match_count = 0;
+    for (auto tuple_id : selection) {
+      if (Compare(left.GetValue(tuple_id), right.GetValue(tuple_id))
+              .IsTrue()) {
+        selection[match_count++] = tuple_id;
+      }
+    }
+    selection.resize(match_count);
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Conjunctions
+//===--------------------------------------------------------------------===//
+
+/*
+ * EvaluateBatch() - The right side only sees the tuples the left side did
+ *                   not decide already
+ */
+void ConjunctionExpression::EvaluateBatch(
+    executor::LogicalTile &tile, SelectionVector &selection,
+    executor::ExecutorContext *context) const {
+  PL_ASSERT(children_.size() == 2);
+
+  switch (exp_type_) {
+    case EXPRESSION_TYPE_CONJUNCTION_AND: {
+      children_[0]->EvaluateBatch(tile, selection, context);
+      if (selection.empty() == false) {
+        children_[1]->EvaluateBatch(tile, selection, context);
+      }
+      break;
+    }
+    case EXPRESSION_TYPE_CONJUNCTION_OR: {
+      SelectionVector left_selection(selection);
+      children_[0]->EvaluateBatch(tile, left_selection, context);
+
+      SelectionVector right_selection;
+      std::set_difference(selection.begin(), selection.end(),
+                          left_selection.begin(), left_selection.end(),
+                          std::back_inserter(right_selection));
+      if (right_selection.empty() == false) {
+        children_[1]->EvaluateBatch(tile, right_selection, context);
+      }
+
+      selection.clear();
+      std::merge(left_selection.begin(), left_selection.end(),
+                 right_selection.begin(), right_selection.end(),
+                 std::back_inserter(selection));
+      break;
+    }
+    default:
+      throw Exception("Invalid conjunction expression type.");
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Arithmetic
+//===--------------------------------------------------------------------===//
+
+/*
+ * IsInRange() - Whether an integer is a non-null value of the type
+ */
+static bool IsInRange(type::Type::TypeId type, int64_t value) {
+  switch (type) {
+    case type::Type::TINYINT:
+      return value >= type::PELOTON_INT8_MIN && value <= type::PELOTON_INT8_MAX;
+    case type::Type::SMALLINT:
+      return value >= type::PELOTON_INT16_MIN &&
+             value <= type::PELOTON_INT16_MAX;
+    case type::Type::INTEGER:
+      return value >= type::PELOTON_INT32_MIN &&
+             value <= type::PELOTON_INT32_MAX;
+    default:
+      return value >= type::PELOTON_INT64_MIN;
+  }
+}
+
+/*
+ * ComputeArithmetic() - Applies an operator to two unboxed vectors
+ *
+ * Results the kernel can not represent (overflows and values that would
+ * read as null) are left to the value types through fallback(), so that
+ * they fail or wrap exactly like the tuple at a time path does.
+ */
+template <typename IntegerOp, typename DecimalOp, typename Fallback>
+static void ComputeArithmetic(const ColumnVector &left,
+                              const ColumnVector &right,
+                              const SelectionVector &selection,
+                              ColumnVector &result, IntegerOp integer_op,
+                              DecimalOp decimal_op, Fallback fallback) {
+  if (left.IsDecimal() || right.IsDecimal()) {
+    result.Reset(type::Type::DECIMAL, selection);
+    for (auto tuple_id : selection) {
+      if (left.IsNull(tuple_id) || right.IsNull(tuple_id)) {
+        result.SetNull(tuple_id);
+        continue;
+      }
+
+      double value =
+          decimal_op(left.GetDecimal(tuple_id), right.GetDecimal(tuple_id));
+      if (value == type::PELOTON_DECIMAL_NULL) {
+        fallback(tuple_id);
+      } else {
+        result.SetDecimal(tuple_id, value);
+      }
+    }
+    return;
+  }
+
+  // The wider of the two types, this relies on the order in types.h
+  auto result_type = std::max(left.GetType(), right.GetType());
+  result.Reset(result_type, selection);
+  for (auto tuple_id : selection) {
+    if (left.IsNull(tuple_id) || right.IsNull(tuple_id)) {
+      result.SetNull(tuple_id);
+      continue;
+    }
+
+    int64_t value;
+    bool overflow =
+        integer_op(left.GetInteger(tuple_id), right.GetInteger(tuple_id), &value);
+    if (overflow || IsInRange(result_type, value) == false) {
+      fallback(tuple_id);
+    } else {
+      result.SetInteger(tuple_id, value);
+    }
+  }
+}
+
+void OperatorExpression::EvaluateColumn(
+    executor::LogicalTile &tile, const SelectionVector &selection,
+    ColumnVector &result, executor::ExecutorContext *context) const {
+  if (exp_type_ != EXPRESSION_TYPE_OPERATOR_PLUS &&
+      exp_type_ != EXPRESSION_TYPE_OPERATOR_MINUS &&
+      exp_type_ != EXPRESSION_TYPE_OPERATOR_MULTIPLY) {
+    AbstractExpression::EvaluateColumn(tile, selection, result, context);
+    return;
+  }
+
+  PL_ASSERT(children_.size() == 2);
+  ColumnVector left;
+  ColumnVector right;
+  children_[0]->EvaluateColumn(tile, selection, left, context);
+  children_[1]->EvaluateColumn(tile, selection, right, context);
+
+  if (left.IsUnboxed() == false || right.IsUnboxed() == false) {
+    result.Reset(type::Type::INVALID, selection);
+    for (auto tuple_id : selection) {
+      result.SetValue(tuple_id,
+                      Apply(left.GetValue(tuple_id), right.GetValue(tuple_id)));
+    }
+    return;
+  }
+
+  auto fallback = [&](oid_t tuple_id) {
+    result.SetValue(tuple_id,
+                    Apply(left.GetValue(tuple_id), right.GetValue(tuple_id)));
+  };
+
+  switch (exp_type_) {
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+      ComputeArithmetic(
+          left, right, selection, result,
+          [](int64_t l, int64_t r, int64_t *value) {
+            return __builtin_add_overflow(l, r, value);
+          },
+          [](double l, double r) { return l + r; }, fallback);
+      break;
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+      ComputeArithmetic(
+          left, right, selection, result,
+          [](int64_t l, int64_t r, int64_t *value) {
+            return __builtin_sub_overflow(l, r, value);
+          },
+          [](double l, double r) { return l - r; }, fallback);
+      break;
+    default:
+      ComputeArithmetic(
+          left, right, selection, result,
+          [](int64_t l, int64_t r, int64_t *value) {
+            return __builtin_mul_overflow(l, r, value);
+          },
+          [](double l, double r) { return l * r; }, fallback);
+      break;
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
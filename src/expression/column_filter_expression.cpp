@@ -0,0 +1,298 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_filter_expression.cpp
+//
+// Identification: src/expression/column_filter_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/column_filter_expression.h"
+
+#include "common/exception.h"
+#include "executor/logical_tile.h"
+#include "storage/column_accessor.h"
+#include "storage/tile.h"
+
+namespace peloton {
+namespace expression {
+
+//===--------------------------------------------------------------------===//
+// Predicates the kernels are specialized for
+//===--------------------------------------------------------------------===//
+
+struct FilterEqual {
+  template <typename T>
+  static inline bool Apply(T value, T constant, T) {
+    return value == constant;
+  }
+};
+
+struct FilterNotEqual {
+  template <typename T>
+  static inline bool Apply(T value, T constant, T) {
+    return value != constant;
+  }
+};
+
+struct FilterLessThan {
+  template <typename T>
+  static inline bool Apply(T value, T constant, T) {
+    return value < constant;
+  }
+};
+
+struct FilterLessThanOrEqualTo {
+  template <typename T>
+  static inline bool Apply(T value, T constant, T) {
+    return value <= constant;
+  }
+};
+
+struct FilterGreaterThan {
+  template <typename T>
+  static inline bool Apply(T value, T constant, T) {
+    return value > constant;
+  }
+};
+
+struct FilterGreaterThanOrEqualTo {
+  template <typename T>
+  static inline bool Apply(T value, T constant, T) {
+    return value >= constant;
+  }
+};
+
+template <bool lower_inclusive, bool upper_inclusive>
+struct FilterInRange {
+  template <typename T>
+  static inline bool Apply(T value, T lower, T upper) {
+    return (lower_inclusive ? (value >= lower) : (value > lower)) &
+           (upper_inclusive ? (value <= upper) : (value < upper));
+  }
+};
+
+// The value a NULL of the column is stored as
+template <typename NativeType>
+struct FilterNull;
+
+template <>
+struct FilterNull<int32_t> {
+  static inline int32_t Get() { return type::PELOTON_INT32_NULL; }
+};
+
+template <>
+struct FilterNull<int64_t> {
+  static inline int64_t Get() { return type::PELOTON_INT64_NULL; }
+};
+
+template <>
+struct FilterNull<uint64_t> {
+  static inline uint64_t Get() { return type::PELOTON_TIMESTAMP_NULL; }
+};
+
+template <>
+struct FilterNull<double> {
+  static inline double Get() { return type::PELOTON_DECIMAL_NULL; }
+};
+
+//===--------------------------------------------------------------------===//
+// Kernels
+//===--------------------------------------------------------------------===//
+
+template <typename NativeType, typename CompareType, class Predicate>
+void ColumnFilterExpression::Filter(const storage::ColumnAccessor &accessor,
+                                    const std::vector<oid_t> &position_list,
+                                    SelectionVector &selection,
+                                    const Bound *bounds) {
+  CompareType lower, upper;
+  bounds[0].Get(lower);
+  bounds[1].Get(upper);
+
+  const NativeType null_value = FilterNull<NativeType>::Get();
+  const char *column_base = accessor.base + accessor.offset;
+  const size_t stride = accessor.stride;
+
+  // The tuple id is written whether it matches or not, and only kept if it
+  // does, so that the loop does not branch on the data
+  size_t match_count = 0;
+  for (auto tuple_id : selection) {
+    oid_t base_tuple_id = position_list[tuple_id];
+    if (base_tuple_id == NULL_OID) {
+      continue;
+    }
+
+    NativeType value = *reinterpret_cast<const NativeType *>(
+        column_base + base_tuple_id * stride);
+    selection[match_count] = tuple_id;
+    match_count += (value != null_value) &
+                   Predicate::Apply(static_cast<CompareType>(value), lower,
+                                    upper);
+  }
+  selection.resize(match_count);
+}
+
+template <typename NativeType, typename CompareType>
+ColumnFilterExpression::Kernel ColumnFilterExpression::GetKernel(
+    ExpressionType lower_type, ExpressionType upper_type) {
+  bool lower_inclusive =
+      (lower_type == EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO);
+
+  switch (upper_type) {
+    case EXPRESSION_TYPE_INVALID:
+      switch (lower_type) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+          return &Filter<NativeType, CompareType, FilterEqual>;
+        case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+          return &Filter<NativeType, CompareType, FilterNotEqual>;
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+          return &Filter<NativeType, CompareType, FilterLessThan>;
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+          return &Filter<NativeType, CompareType, FilterLessThanOrEqualTo>;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+          return &Filter<NativeType, CompareType, FilterGreaterThan>;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+          return &Filter<NativeType, CompareType,
+                         FilterGreaterThanOrEqualTo>;
+        default:
+          break;
+      }
+      break;
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return lower_inclusive
+                 ? &Filter<NativeType, CompareType, FilterInRange<true, false>>
+                 : &Filter<NativeType, CompareType,
+                           FilterInRange<false, false>>;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return lower_inclusive
+                 ? &Filter<NativeType, CompareType, FilterInRange<true, true>>
+                 : &Filter<NativeType, CompareType, FilterInRange<false, true>>;
+    default:
+      break;
+  }
+
+  throw Exception("Invalid column filter type.");
+}
+
+//===--------------------------------------------------------------------===//
+// ColumnFilterExpression
+//===--------------------------------------------------------------------===//
+
+ColumnFilterExpression::ColumnFilterExpression(AbstractExpression *predicate,
+                                               oid_t column_id,
+                                               type::Type::TypeId column_type,
+                                               ExpressionType compare_type,
+                                               const type::Value &constant)
+    : ColumnFilterExpression(predicate, column_id, column_type, compare_type,
+                             constant, EXPRESSION_TYPE_INVALID, constant) {}
+
+ColumnFilterExpression::ColumnFilterExpression(
+    AbstractExpression *predicate, oid_t column_id,
+    type::Type::TypeId column_type, ExpressionType lower_type,
+    const type::Value &lower, ExpressionType upper_type,
+    const type::Value &upper)
+    : AbstractExpression(EXPRESSION_TYPE_COLUMN_FILTER, type::Type::BOOLEAN,
+                         predicate, nullptr),
+      column_id_(column_id),
+      column_type_(column_type) {
+  PL_ASSERT(IsSupported(column_type, lower, upper));
+  SetBound(0, lower);
+  SetBound(1, upper);
+
+  bool is_decimal = IsDecimalComparison(column_type, lower);
+  switch (column_type) {
+    case type::Type::INTEGER:
+      kernel_ = is_decimal ? GetKernel<int32_t, double>(lower_type, upper_type)
+                           : GetKernel<int32_t, int64_t>(lower_type,
+                                                         upper_type);
+      break;
+    case type::Type::BIGINT:
+      kernel_ = is_decimal ? GetKernel<int64_t, double>(lower_type, upper_type)
+                           : GetKernel<int64_t, int64_t>(lower_type,
+                                                         upper_type);
+      break;
+    case type::Type::DECIMAL:
+      kernel_ = GetKernel<double, double>(lower_type, upper_type);
+      break;
+    case type::Type::TIMESTAMP:
+      kernel_ = GetKernel<uint64_t, uint64_t>(lower_type, upper_type);
+      break;
+    default:
+      throw Exception("Invalid column filter type.");
+  }
+}
+
+bool ColumnFilterExpression::IsSupported(type::Type::TypeId column_type,
+                                         const type::Value &constant) {
+  if (constant.IsNull() == true) {
+    return false;
+  }
+
+  switch (constant.GetTypeId()) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+    case type::Type::DECIMAL:
+      return column_type == type::Type::INTEGER ||
+             column_type == type::Type::BIGINT ||
+             column_type == type::Type::DECIMAL;
+    case type::Type::TIMESTAMP:
+      return column_type == type::Type::TIMESTAMP;
+    default:
+      return false;
+  }
+}
+
+bool ColumnFilterExpression::IsSupported(type::Type::TypeId column_type,
+                                         const type::Value &lower,
+                                         const type::Value &upper) {
+  // Both bounds have to be compared in the same type
+  return IsSupported(column_type, lower) && IsSupported(column_type, upper) &&
+         IsDecimalComparison(column_type, lower) ==
+             IsDecimalComparison(column_type, upper);
+}
+
+bool ColumnFilterExpression::IsDecimalComparison(
+    type::Type::TypeId column_type, const type::Value &constant) {
+  return column_type == type::Type::DECIMAL ||
+         constant.GetTypeId() == type::Type::DECIMAL;
+}
+
+void ColumnFilterExpression::SetBound(int bound_idx,
+                                      const type::Value &constant) {
+  if (column_type_ == type::Type::TIMESTAMP) {
+    bounds_[bound_idx].timestamp = constant.GetAs<uint64_t>();
+  } else if (IsDecimalComparison(column_type_, constant)) {
+    bounds_[bound_idx].decimal =
+        constant.CastAs(type::Type::DECIMAL).GetAs<double>();
+  } else {
+    bounds_[bound_idx].integer =
+        constant.CastAs(type::Type::BIGINT).GetAs<int64_t>();
+  }
+}
+
+void ColumnFilterExpression::EvaluateBatch(
+    executor::LogicalTile &tile, SelectionVector &selection,
+    executor::ExecutorContext *context) const {
+  if (column_id_ < tile.GetColumnCount()) {
+    const auto &column_info = tile.GetColumnInfo(column_id_);
+    auto accessor = column_info.base_tile->GetColumnAccessor(
+        column_info.origin_column_id);
+
+    if (accessor.type == column_type_) {
+      kernel_(accessor, tile.GetPositionList(column_info.position_list_idx),
+              selection, bounds_);
+      return;
+    }
+  }
+
+  // Not the tile the kernel was compiled for
+  children_[0]->EvaluateBatch(tile, selection, context);
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -0,0 +1,225 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_vector.cpp
+//
+// Identification: src/expression/column_vector.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/column_vector.h"
+
+#include "common/exception.h"
+#include "executor/logical_tile.h"
+#include "storage/column_accessor.h"
+#include "storage/tile.h"
+
+namespace peloton {
+namespace expression {
+
+/*
+ * GetIntegerOf() - The native value of an integer value, widened
+ */
+static int64_t GetIntegerOf(const type::Value &value) {
+  switch (value.GetTypeId()) {
+    case type::Type::TINYINT:
+      return value.GetAs<int8_t>();
+    case type::Type::SMALLINT:
+      return value.GetAs<int16_t>();
+    case type::Type::INTEGER:
+      return value.GetAs<int32_t>();
+    case type::Type::BIGINT:
+      return value.GetAs<int64_t>();
+    default:
+      throw Exception("Not an integer value.");
+  }
+}
+
+/*
+ * LoadFixedWidth() - Reads a fixed width column of a base tile through a
+ *                    position list, the null value of the type becomes a
+ *                    null entry
+ */
+template <typename NativeType, typename EntryType>
+static void LoadFixedWidth(const storage::ColumnAccessor &accessor,
+                           const std::vector<oid_t> &position_list,
+                           const SelectionVector &selection,
+                           NativeType null_value, EntryType *entries,
+                           uint8_t *nulls) {
+  for (auto tuple_id : selection) {
+    oid_t base_tuple_id = position_list[tuple_id];
+    if (base_tuple_id == NULL_OID) {
+      nulls[tuple_id] = 1;
+      continue;
+    }
+
+    NativeType value = *reinterpret_cast<const NativeType *>(
+        accessor.GetFieldLocation(base_tuple_id));
+    entries[tuple_id] = value;
+    nulls[tuple_id] = (value == null_value);
+  }
+}
+
+void ColumnVector::Reset(type::Type::TypeId type,
+                         const SelectionVector &selection) {
+  type_ = type;
+  is_constant_ = false;
+
+  size_t tuple_count = selection.empty() ? 0 : selection.back() + 1;
+  if (IsInteger()) {
+    integers_.resize(tuple_count);
+    nulls_.resize(tuple_count);
+  } else if (IsDecimal()) {
+    decimals_.resize(tuple_count);
+    nulls_.resize(tuple_count);
+  } else {
+    values_.resize(tuple_count);
+  }
+}
+
+void ColumnVector::SetConstant(const type::Value &value) {
+  type_ = value.GetTypeId();
+  is_constant_ = true;
+
+  if (IsInteger()) {
+    integers_.assign(1, GetIntegerOf(value));
+    nulls_.assign(1, value.IsNull());
+  } else if (IsDecimal()) {
+    decimals_.assign(1, value.GetAs<double>());
+    nulls_.assign(1, value.IsNull());
+  } else {
+    values_.assign(1, value);
+  }
+}
+
+void ColumnVector::LoadColumn(executor::LogicalTile &tile, oid_t column_id,
+                              const SelectionVector &selection) {
+  const auto &column_info = tile.GetColumnInfo(column_id);
+  const auto &position_list =
+      tile.GetPositionList(column_info.position_list_idx);
+  storage::Tile *base_tile = column_info.base_tile.get();
+  auto accessor = base_tile->GetColumnAccessor(column_info.origin_column_id);
+
+  Reset(accessor.type, selection);
+
+  switch (accessor.type) {
+    case type::Type::TINYINT:
+      LoadFixedWidth<int8_t>(accessor, position_list, selection,
+                             type::PELOTON_INT8_NULL, integers_.data(),
+                             nulls_.data());
+      break;
+    case type::Type::SMALLINT:
+      LoadFixedWidth<int16_t>(accessor, position_list, selection,
+                              type::PELOTON_INT16_NULL, integers_.data(),
+                              nulls_.data());
+      break;
+    case type::Type::INTEGER:
+      LoadFixedWidth<int32_t>(accessor, position_list, selection,
+                              type::PELOTON_INT32_NULL, integers_.data(),
+                              nulls_.data());
+      break;
+    case type::Type::BIGINT:
+      LoadFixedWidth<int64_t>(accessor, position_list, selection,
+                              type::PELOTON_INT64_NULL, integers_.data(),
+                              nulls_.data());
+      break;
+    case type::Type::DECIMAL:
+      LoadFixedWidth<double>(accessor, position_list, selection,
+                             type::PELOTON_DECIMAL_NULL, decimals_.data(),
+                             nulls_.data());
+      break;
+    default: {
+      // Everything else, dictionary encoded columns included, is read the
+      // way LogicalTile::GetValue() does
+      for (auto tuple_id : selection) {
+        oid_t base_tuple_id = position_list[tuple_id];
+        if (base_tuple_id == NULL_OID) {
+          values_[tuple_id] = type::ValueFactory::GetNullValueByType(type_);
+        } else {
+          values_[tuple_id] =
+              base_tile->GetValue(base_tuple_id, column_info.origin_column_id);
+        }
+      }
+      break;
+    }
+  }
+}
+
+type::Value ColumnVector::GetValue(oid_t tuple_id) const {
+  if (IsUnboxed() == false) {
+    return values_[Index(tuple_id)];
+  }
+
+  if (IsNull(tuple_id) == true) {
+    return type::ValueFactory::GetNullValueByType(type_);
+  }
+
+  switch (type_) {
+    case type::Type::TINYINT:
+      return type::ValueFactory::GetTinyIntValue(
+          static_cast<int8_t>(GetInteger(tuple_id)));
+    case type::Type::SMALLINT:
+      return type::ValueFactory::GetSmallIntValue(
+          static_cast<int16_t>(GetInteger(tuple_id)));
+    case type::Type::INTEGER:
+      return type::ValueFactory::GetIntegerValue(
+          static_cast<int32_t>(GetInteger(tuple_id)));
+    case type::Type::BIGINT:
+      return type::ValueFactory::GetBigIntValue(GetInteger(tuple_id));
+    default:
+      return type::ValueFactory::GetDoubleValue(GetDecimal(tuple_id));
+  }
+}
+
+void ColumnVector::SetValue(oid_t tuple_id, const type::Value &value) {
+  PL_ASSERT(is_constant_ == false);
+
+  if (IsUnboxed() == false) {
+    values_[tuple_id] = value;
+  } else if (value.IsNull() == true) {
+    SetNull(tuple_id);
+  } else if (value.GetTypeId() != type_) {
+    SetValue(tuple_id, value.CastAs(type_));
+  } else if (IsInteger() == true) {
+    SetInteger(tuple_id, GetIntegerOf(value));
+  } else {
+    SetDecimal(tuple_id, value.GetAs<double>());
+  }
+}
+
+void ColumnVector::SerializeTo(oid_t tuple_id, char *location) const {
+  PL_ASSERT(IsUnboxed());
+  bool is_null = IsNull(tuple_id);
+
+  switch (type_) {
+    case type::Type::TINYINT:
+      *reinterpret_cast<int8_t *>(location) =
+          is_null ? type::PELOTON_INT8_NULL
+                  : static_cast<int8_t>(GetInteger(tuple_id));
+      break;
+    case type::Type::SMALLINT:
+      *reinterpret_cast<int16_t *>(location) =
+          is_null ? type::PELOTON_INT16_NULL
+                  : static_cast<int16_t>(GetInteger(tuple_id));
+      break;
+    case type::Type::INTEGER:
+      *reinterpret_cast<int32_t *>(location) =
+          is_null ? type::PELOTON_INT32_NULL
+                  : static_cast<int32_t>(GetInteger(tuple_id));
+      break;
+    case type::Type::BIGINT:
+      *reinterpret_cast<int64_t *>(location) =
+          is_null ? type::PELOTON_INT64_NULL : GetInteger(tuple_id);
+      break;
+    default:
+      *reinterpret_cast<double *>(location) =
+          is_null ? type::PELOTON_DECIMAL_NULL : GetDecimal(tuple_id);
+      break;
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -34,27 +34,26 @@ void TransactionLevelGCManager::StopGC(int thread_id) {
   ClearGarbage(thread_id);
 }
 
-bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
-  auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(location.block).get();
-
+bool TransactionLevelGCManager::ResetTuple(storage::TileGroup *tile_group,
+                                           const oid_t tuple_id) {
   auto tile_group_header = tile_group->GetHeader();
 
   // Reset the header
-  tile_group_header->SetTransactionId(location.offset, INVALID_TXN_ID);
-  tile_group_header->SetBeginCommitId(location.offset, MAX_CID);
-  tile_group_header->SetEndCommitId(location.offset, MAX_CID);
-  tile_group_header->SetPrevItemPointer(location.offset, INVALID_ITEMPOINTER);
-  tile_group_header->SetNextItemPointer(location.offset, INVALID_ITEMPOINTER);
+  tile_group_header->SetTransactionId(tuple_id, INVALID_TXN_ID);
+  tile_group_header->SetBeginCommitId(tuple_id, MAX_CID);
+  tile_group_header->SetEndCommitId(tuple_id, MAX_CID);
+  tile_group_header->SetPrevItemPointer(tuple_id, INVALID_ITEMPOINTER);
+  tile_group_header->SetNextItemPointer(tuple_id, INVALID_ITEMPOINTER);
 
   // Reclaim the varlen pool
-  CheckAndReclaimVarlenColumns(tile_group, location.offset);
+  CheckAndReclaimVarlenColumns(tile_group, tuple_id);
 
   PL_MEMSET(
-    tile_group_header->GetReservedFieldRef(location.offset), 0,
+    tile_group_header->GetReservedFieldRef(tuple_id), 0,
     storage::TileGroupHeader::GetReservedSize());
 
-  LOG_TRACE("Garbage tuple(%u, %u) is reset", location.block, location.offset);
+  LOG_TRACE("Garbage tuple(%u, %u) is reset", tile_group->GetTileGroupId(),
+            tuple_id);
   return true;
 }
 
@@ -184,13 +183,17 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
 
     oid_t table_id = table->GetOid();
 
+    // The pinned tile group is resident and stays so, the lock keeps the
+    // eviction from releasing the varlen pool while the tuples are reset
+    PelotonReadLock anti_cache_lock(tile_group->GetAntiCacheLock());
+
     for (auto &element : entry.second) {
 
       // as this transaction has been committed, we should reclaim older versions.
       ItemPointer location(entry.first, element.first); 
       
       // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
+      if (ResetTuple(tile_group.get(), element.first) == false) {
         continue;
       }
       // if the entry for table_id exists.
@@ -287,12 +290,20 @@ void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection)
     dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
   PL_ASSERT(table != nullptr);
 
+  PelotonReadLock anti_cache_lock(tile_group->GetAntiCacheLock());
+
   // construct the expired version.
   expression::ContainerTuple<storage::TileGroup> expired_tuple(tile_group.get(), location.offset);
 
   // unlink the version from all the indexes.
   for (size_t idx = 0; idx < table->GetIndexCount(); ++idx) {
     auto index = table->GetIndex(idx);
+
+    // a partial index has no entry for a version outside its predicate
+    if (index->GetMetadata()->CoversTuple(&expired_tuple) == false) {
+      continue;
+    }
+
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
 
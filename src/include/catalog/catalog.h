@@ -46,6 +46,10 @@ namespace storage {
 class DataTable;
 }
 
+namespace expression {
+class AbstractExpression;
+}
+
 namespace catalog {
 
 //===--------------------------------------------------------------------===//
@@ -84,19 +88,27 @@ class Catalog {
   // Add a database
   void AddDatabase(storage::Database *database);
 
-  // Create a table in a database
+  // Create a table in a database, pool_type picks the varlen pool of its
+  // uninlined values
   Result CreateTable(std::string database_name, std::string table_name,
                      std::unique_ptr<catalog::Schema>,
-                     concurrency::Transaction *txn);
+                     concurrency::Transaction *txn,
+                     VarlenPoolType pool_type = DEFAULT_VARLEN_POOL_TYPE);
 
   // Create the primary key index for a table
   Result CreatePrimaryIndex(const std::string &database_name,
                             const std::string &table_name);
 
+  // Create a secondary index, index_include_attr are the included (non-key)
+  // columns stored with each entry for index-only scans. A partial index only
+  // covers the tuples satisfying index_predicate, which the catalog owns.
   Result CreateIndex(const std::string &database_name,
                      const std::string &table_name,
                      std::vector<std::string> index_attr,
-                     std::string index_name, bool unique, IndexType index_type);
+                     std::string index_name, bool unique, IndexType index_type,
+                     std::vector<std::string> index_include_attr =
+                         std::vector<std::string>(),
+                     expression::AbstractExpression *index_predicate = nullptr);
 
   // Get a index with the oids of index, table, and database.
   index::Index *GetIndexWithOid(const oid_t database_oid, const oid_t table_oid,
@@ -61,7 +61,9 @@ std::unique_ptr<storage::Tuple> GetTableMetricsCatalogTuple(
 
 std::unique_ptr<storage::Tuple> GetIndexMetricsCatalogTuple(
     catalog::Schema *schema, oid_t database_id, oid_t table_id, oid_t index_id,
-    int64_t reads, int64_t deletes, int64_t inserts, int64_t time);
+    int64_t reads, int64_t deletes, int64_t inserts, int64_t node_count,
+    double avg_delta_chain_length, int64_t garbage_bytes,
+    double consolidations_per_sec, double splits_per_sec, int64_t time);
 
 std::unique_ptr<storage::Tuple> GetQueryMetricsCatalogTuple(
     catalog::Schema *schema, std::string query_name, oid_t database_id,
@@ -78,6 +78,14 @@ class Column : public Printable {
 
   bool IsPrimary() const { return is_primary_; }
 
+  // Store the distinct values of an uninlined varlen column in a per-tile
+  // dictionary (see storage::StringDictionary)
+  void SetDictionaryEncoded(bool dictionary_encoded) {
+    is_dictionary_encoded = dictionary_encoded;
+  }
+
+  bool IsDictionaryEncoded() const { return is_dictionary_encoded; }
+
   // Add a constraint to the column
   void AddConstraint(const catalog::Constraint &constraint) {
     constraints.push_back(constraint);
@@ -125,6 +133,9 @@ class Column : public Printable {
   // is the column contained the primary key?
   bool is_primary_ = false;
 
+  // are the values kept in a per-tile dictionary ?
+  bool is_dictionary_encoded = false;
+
   // offset of column in tuple
   oid_t column_offset = INVALID_OID;
 
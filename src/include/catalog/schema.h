@@ -121,6 +121,10 @@ class Schema : public Printable {
     return columns[column_id].is_inlined;
   }
 
+  inline bool IsDictionaryEncoded(const oid_t column_id) const {
+    return columns[column_id].is_dictionary_encoded;
+  }
+
   inline const Column GetColumn(const oid_t column_id) const {
     return columns[column_id];
   }
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_pipeline.h
+//
+// Identification: src/include/codegen/compiled_pipeline.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace codegen {
+
+/**
+ * Signature of the machine code of a pipeline.
+ *
+ * Runs the pipeline over the tuples at the given offsets of a tile group.
+ * Column i of the pipeline starts at column_bases[i], its values are
+ * column_strides[i] bytes apart. The offsets of the tuples that pass the
+ * scan predicate are written to matches, and the aggregates are folded into
+ * aggregate_state, two slots per aggregate: the value, then the number of
+ * values folded into it.
+ *
+ * Returns the number of matches, or -1 if the generated code came across a
+ * value it does not handle (say, an arithmetic overflow), in which case the
+ * caller has to redo the work in the interpreter.
+ */
+typedef int64_t (*PipelineFunction)(const char *const *column_bases,
+                                    const uint64_t *column_strides,
+                                    const oid_t *positions,
+                                    uint32_t position_count, oid_t *matches,
+                                    int64_t *aggregate_state);
+
+//===--------------------------------------------------------------------===//
+// Compiled Pipeline
+//===--------------------------------------------------------------------===//
+
+class CompiledPipeline {
+ public:
+  CompiledPipeline(const CompiledPipeline &) = delete;
+  CompiledPipeline &operator=(const CompiledPipeline &) = delete;
+
+  // An aggregate computed by the pipeline
+  struct Aggregate {
+    ExpressionType aggtype;
+
+    // Type of the aggregated values
+    type::Type::TypeId value_type;
+  };
+
+  // The code keeps the memory of the function alive
+  CompiledPipeline(PipelineFunction function,
+                   const std::vector<oid_t> &column_ids,
+                   const std::vector<Aggregate> &aggregates,
+                   std::shared_ptr<void> code)
+      : function_(function),
+        column_ids_(column_ids),
+        aggregates_(aggregates),
+        code_(code) {}
+
+  inline PipelineFunction GetFunction() const { return function_; }
+
+  // Table column read through each of the column bases
+  inline const std::vector<oid_t> &GetColumnIds() const { return column_ids_; }
+
+  // Whether the pipeline ends in an aggregation, or emits the matches
+  inline bool IsAggregation() const { return aggregates_.empty() == false; }
+
+  inline const std::vector<Aggregate> &GetAggregates() const {
+    return aggregates_;
+  }
+
+ private:
+  PipelineFunction function_;
+
+  std::vector<oid_t> column_ids_;
+
+  std::vector<Aggregate> aggregates_;
+
+  std::shared_ptr<void> code_;
+};
+
+}  // End codegen namespace
+}  // End peloton namespace
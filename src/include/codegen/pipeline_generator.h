@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pipeline_generator.h
+//
+// Identification: src/include/codegen/pipeline_generator.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "codegen/compiled_pipeline.h"
+#include "type/types.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace codegen {
+
+//===--------------------------------------------------------------------===//
+// Pipeline Spec
+//===--------------------------------------------------------------------===//
+
+/**
+ * The tuples at one step of a pipeline, each column of which is either a
+ * column of the tuples of the step below (the table, for the first step) or
+ * an expression over them.
+ */
+struct PipelineStep {
+  // Expression computing each column, nullptr for a column taken as is
+  std::vector<const expression::AbstractExpression *> expressions;
+
+  // Column of the step below a column is taken from
+  std::vector<oid_t> column_ids;
+
+  // Type of each column
+  std::vector<type::Type::TypeId> types;
+};
+
+/**
+ * What a pipeline computes, as checked by the query compiler. The
+ * expressions are borrowed from the plan, and only have to outlive the
+ * generation of the code.
+ */
+struct PipelineSpec {
+  // Type of each column of the table
+  std::vector<type::Type::TypeId> column_types;
+
+  // Scan predicate over the table, nullptr if there is none
+  const expression::AbstractExpression *predicate = nullptr;
+
+  // Steps between the table and the input of the aggregates
+  std::vector<PipelineStep> steps;
+
+  // Aggregates over the last step, a nullptr expression counts tuples
+  std::vector<ExpressionType> aggregate_types;
+  std::vector<const expression::AbstractExpression *> aggregate_expressions;
+  std::vector<type::Type::TypeId> aggregate_value_types;
+};
+
+//===--------------------------------------------------------------------===//
+// Pipeline Generator
+//===--------------------------------------------------------------------===//
+
+/**
+ * Generates the LLVM IR of a pipeline spec, optimizes it and JIT-compiles
+ * it to machine code. Only built with USE_LLVM.
+ */
+class PipelineGenerator {
+ public:
+  // Returns nullptr if LLVM failed to compile the function
+  static std::shared_ptr<const CompiledPipeline> Generate(
+      const PipelineSpec &spec);
+};
+
+}  // End codegen namespace
+}  // End peloton namespace
@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_compiler.h
+//
+// Identification: src/include/codegen/query_compiler.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "codegen/compiled_pipeline.h"
+#include "common/cache.h"
+#include "type/types.h"
+
+namespace peloton {
+
+namespace expression {
+class AbstractExpression;
+}
+
+namespace planner {
+class AbstractPlan;
+class AggregatePlan;
+class SeqScanPlan;
+}
+
+namespace codegen {
+
+struct PipelineSpec;
+struct PipelineStep;
+
+//===--------------------------------------------------------------------===//
+// Query Compiler
+//===--------------------------------------------------------------------===//
+
+/**
+ * Fuses a sequential scan, its predicate, and optionally a projection and a
+ * plain aggregation on top of it into one function, generated with LLVM:
+ *
+ *   SeqScanPlan (with a predicate)
+ *   AggregatePlan (plain) <- [ProjectionPlan] <- SeqScanPlan
+ *
+ * The expressions have to be arithmetic (+, -, *), comparisons and boolean
+ * logic over integer and DECIMAL columns and constants. Any other plan is
+ * left to the interpreter.
+ *
+ * Compiled pipelines are cached by the fingerprint of the plan, which covers
+ * everything the generated code depends on, so that another instance of the
+ * same query does not go through LLVM again. Constants are compiled into the
+ * code, so the cache only keeps the DEFAULT_CACHE_SIZE most recently used
+ * pipelines.
+ *
+ * Without USE_LLVM nothing is ever compiled.
+ */
+class QueryCompiler {
+ public:
+  QueryCompiler(const QueryCompiler &) = delete;
+  QueryCompiler &operator=(const QueryCompiler &) = delete;
+
+  static QueryCompiler &GetInstance();
+
+  // The pipeline for the plan tree rooted at the plan, nullptr if it is not
+  // a pipeline the compiler supports
+  std::shared_ptr<const CompiledPipeline> Compile(
+      const planner::AbstractPlan *plan);
+
+  size_t GetCacheSize();
+
+  void ClearCache();
+
+  //===--------------------------------------------------------------------===//
+  // Typing rules of the generated code, those of type::Value
+  //===--------------------------------------------------------------------===//
+
+  static bool IsNumericType(type::Type::TypeId type);
+
+  // Type of the result of +, - or *
+  static type::Type::TypeId GetArithmeticType(type::Type::TypeId left,
+                                              type::Type::TypeId right);
+
+ private:
+  QueryCompiler() {}
+
+  // Fills the spec and its fingerprint, returns false if the plan is not
+  // supported
+  static bool BuildSpec(const planner::AbstractPlan *plan, PipelineSpec &spec,
+                        std::string &fingerprint);
+
+  static bool BuildScanSpec(const planner::SeqScanPlan *plan,
+                            PipelineSpec &spec, std::string &fingerprint);
+
+  static bool BuildAggregateSpec(const planner::AggregatePlan *plan,
+                                 PipelineSpec &spec, std::string &fingerprint);
+
+  // Type of an expression over a step of the spec (over the table if there
+  // is no step), INVALID if the generated code does not support it
+  static type::Type::TypeId CheckExpression(
+      const expression::AbstractExpression *expr, const PipelineSpec &spec,
+      size_t step_count, std::string &fingerprint);
+
+  std::mutex cache_lock_;
+
+  // LRU cache of the compiled pipelines by fingerprint
+  Cache<std::string, const CompiledPipeline> cache_;
+};
+
+}  // End codegen namespace
+}  // End peloton namespace
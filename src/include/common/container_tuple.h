@@ -243,6 +243,12 @@ class ContainerTuple<storage::TileGroup> : public AbstractTuple {
                  const std::vector<oid_t> *column_ids)
       : container_(container), tuple_id_(tuple_id), column_ids_(column_ids) {}
 
+  /** @brief Read values through column accessors resolved by
+   *  TileGroup::GetColumnAccessors() (indexed by column id). */
+  ContainerTuple(storage::TileGroup *container, oid_t tuple_id,
+                 const std::vector<storage::ColumnAccessor> *accessors)
+      : container_(container), tuple_id_(tuple_id), accessors_(accessors) {}
+
   /* Accessors */
   storage::TileGroup *GetContainer() const { return container_; }
 
@@ -252,6 +258,11 @@ class ContainerTuple<storage::TileGroup> : public AbstractTuple {
   type::Value GetValue(oid_t column_id) const override {
     PL_ASSERT(container_ != nullptr);
 
+    if (accessors_ != nullptr) {
+      PL_ASSERT(column_id < accessors_->size());
+      return (*accessors_)[column_id].GetValue(tuple_id_);
+    }
+
     return container_->GetValue(tuple_id_, column_id);
   }
 
@@ -289,6 +300,9 @@ class ContainerTuple<storage::TileGroup> : public AbstractTuple {
    *  This enables this class only looks at a subset of a tuple
    * */
   const std::vector<oid_t> *column_ids_ = nullptr;
+
+  /** @brief Resolved column locations in the tile group (optional) */
+  const std::vector<storage::ColumnAccessor> *accessors_ = nullptr;
 };
 
 }  // End expression namespace
@@ -54,6 +54,7 @@ enum ExceptionType {
   EXCEPTION_TYPE_INDEX = 19,             // index related
   EXCEPTION_TYPE_STAT = 20,              // stat related
   EXCEPTION_TYPE_CONNECTION = 21,        // connection related
+  EXCEPTION_TYPE_OUT_OF_MEMORY = 22,     // memory limit exceeded
 };
 
 class Exception : public std::runtime_error {
@@ -118,6 +119,8 @@ class Exception : public std::runtime_error {
         return "Stat";
       case EXCEPTION_TYPE_CONNECTION:
         return "Connection";
+      case EXCEPTION_TYPE_OUT_OF_MEMORY:
+        return "Out of Memory";
       default:
         return "Unknown";
     }
@@ -411,4 +414,12 @@ class ConnectionException : public Exception {
       : Exception(EXCEPTION_TYPE_CONNECTION, msg) {}
 };
 
+class OutOfMemoryException : public Exception {
+  OutOfMemoryException() = delete;
+
+ public:
+  OutOfMemoryException(std::string msg)
+      : Exception(EXCEPTION_TYPE_OUT_OF_MEMORY, msg) {}
+};
+
 }  // End peloton namespace
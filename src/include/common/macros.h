@@ -33,6 +33,12 @@ namespace peloton {
 #define ALWAYS_INLINE __attribute__((always_inline))
 #define UNUSED_ATTRIBUTE __attribute__((unused))
 
+//===--------------------------------------------------------------------===//
+// prefetch
+//===--------------------------------------------------------------------===//
+
+#define PL_PREFETCH(addr) __builtin_prefetch((addr))
+
 //===--------------------------------------------------------------------===//
 // memfuncs
 //===--------------------------------------------------------------------===//
@@ -66,6 +66,10 @@ class Statement {
 
   const std::shared_ptr<planner::AbstractPlan>& GetPlanTree() const;
 
+  void SetExplainType(ExplainType explain_type);
+
+  ExplainType GetExplainType() const;
+
  private:
   // logical name of statement
   std::string statement_name;
@@ -84,6 +88,9 @@ class Statement {
 
   // cached plan tree
   std::shared_ptr<planner::AbstractPlan> plan_tree;
+
+  // whether the statement was prefixed with EXPLAIN [ANALYZE]
+  ExplainType explain_type = EXPLAIN_TYPE_INVALID;
 };
 
 }  // namespace peloton
@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// task_scheduler.h
+//
+// Identification: src/include/common/task_scheduler.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/macros.h"
+#include "container/lock_free_queue.h"
+#include "container/work_stealing_deque.h"
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// Task Group
+//===--------------------------------------------------------------------===//
+
+/**
+ * Tasks submitted together, that can be waited for and cancelled together.
+ * A group must outlive its tasks.
+ */
+class TaskGroup {
+  friend class TaskScheduler;
+
+ public:
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  TaskGroup() {}
+
+  ~TaskGroup() { PL_ASSERT(pending_task_count_ == 0); }
+
+  // Takes the latch, so that a group that is done can be destroyed
+  bool IsDone() const {
+    std::lock_guard<std::mutex> lock(latch_);
+    return pending_task_count_ == 0;
+  }
+
+  // Tasks of the group that did not start yet are skipped, the ones that
+  // run may check IsCancelled() to stop early
+  void Cancel() { cancelled_ = true; }
+
+  bool IsCancelled() const { return cancelled_; }
+
+ private:
+  void AddTask() { pending_task_count_++; }
+
+  void FinishTask();
+
+  // Blocks until the group is done or the timeout expires
+  void WaitFor(std::chrono::microseconds timeout);
+
+  std::atomic<size_t> pending_task_count_ = ATOMIC_VAR_INIT(0);
+
+  std::atomic<bool> cancelled_ = ATOMIC_VAR_INIT(false);
+
+  mutable std::mutex latch_;
+
+  std::condition_variable done_;
+};
+
+//===--------------------------------------------------------------------===//
+// Task Scheduler
+//===--------------------------------------------------------------------===//
+
+/**
+ * A pool of worker threads that balance the load by work stealing. Every
+ * worker has a Chase-Lev deque: it pushes and pops the tasks it submits
+ * itself at the bottom, without synchronization in the common case, and
+ * idle workers steal from the top of the deques of the others. Tasks
+ * submitted from other threads go through a shared lock-free queue.
+ *
+ * Threads that wait for a group run queued tasks in the meantime, so that
+ * tasks can submit and wait for tasks of their own without starving the
+ * pool.
+ */
+class TaskScheduler {
+ public:
+  typedef std::function<void()> Task;
+
+  // Counters of a worker, since the scheduler started
+  struct WorkerStats {
+    // Tasks the worker ran
+    uint64_t executed_task_count = 0;
+
+    // Tasks it took from the deques of other workers
+    uint64_t stolen_task_count = 0;
+
+    // Tasks of cancelled groups it skipped
+    uint64_t cancelled_task_count = 0;
+
+    // Times it went to sleep for lack of tasks
+    uint64_t sleep_count = 0;
+  };
+
+  TaskScheduler(const TaskScheduler &) = delete;
+  TaskScheduler &operator=(const TaskScheduler &) = delete;
+
+  // Starts one worker per hardware thread unless told otherwise, pinning
+  // worker i to core i modulo the number of cores if asked to
+  explicit TaskScheduler(size_t worker_count = 0, bool pin_workers = false);
+
+  ~TaskScheduler();
+
+  // Scheduler shared by all queries
+  static TaskScheduler &GetInstance();
+
+  size_t GetWorkerCount() const { return workers_.size(); }
+
+  void Submit(TaskGroup &group, Task task);
+
+  // Blocks until all tasks of the group have run or were skipped
+  void Wait(TaskGroup &group);
+
+  // Runs one queued task on the calling thread, if there is any
+  bool RunPendingTask();
+
+  WorkerStats GetWorkerStats(size_t worker_id) const;
+
+  // Pins the thread to a core, returns false if the platform cannot
+  static bool PinThread(std::thread &thread, size_t core_id);
+
+ private:
+  struct ScheduledTask {
+    Task task;
+    TaskGroup *group;
+  };
+
+  struct Worker {
+    WorkStealingDeque<ScheduledTask *> tasks;
+
+    std::atomic<uint64_t> executed_task_count = ATOMIC_VAR_INIT(0);
+    std::atomic<uint64_t> stolen_task_count = ATOMIC_VAR_INIT(0);
+    std::atomic<uint64_t> cancelled_task_count = ATOMIC_VAR_INIT(0);
+    std::atomic<uint64_t> sleep_count = ATOMIC_VAR_INIT(0);
+  };
+
+  void WorkerMain(size_t worker_id);
+
+  // Index of the worker the calling thread is, or the worker count if it is
+  // not one of ours
+  size_t GetCurrentWorkerId() const;
+
+  // Pops a task from the deque of the worker, or takes one from the shared
+  // queue, or steals one from another worker
+  ScheduledTask *GetTask(size_t worker_id);
+
+  void RunTask(size_t worker_id, ScheduledTask *scheduled_task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::vector<std::thread> threads_;
+
+  // Tasks submitted by threads that are not workers
+  LockFreeQueue<ScheduledTask *> shared_tasks_;
+
+  std::atomic<size_t> queued_task_count_ = ATOMIC_VAR_INIT(0);
+
+  std::mutex sleep_latch_;
+
+  std::condition_variable wakeup_;
+
+  bool shutdown_ = false;
+};
+
+}  // End peloton namespace
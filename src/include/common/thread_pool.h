@@ -13,37 +13,34 @@
 
 #pragma once
 
-#include <vector>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <thread>
-
-#include <boost/asio/io_service.hpp>
-#include <boost/thread/thread.hpp>
-#include <boost/bind.hpp>
-#include <boost/function.hpp>
+#include <vector>
 
 #include "common/macros.h"
+#include "common/task_scheduler.h"
 
 namespace peloton {
-// a wrapper for boost worker thread pool.
+// Runs short tasks on a work-stealing TaskScheduler and long-running ones,
+// like the epoch and networking loops, on dedicated threads.
 class ThreadPool {
  public:
-  ThreadPool() : pool_size_(0), 
-                 dedicated_thread_count_(0),
-                 work_(io_service_) { }
+  ThreadPool() : pool_size_(0), dedicated_thread_count_(0) { }
 
   ~ThreadPool() { }
 
+  // A pool size of zero shares the scheduler of the process
   void Initialize(const size_t &pool_size, const size_t &dedicated_thread_count) {
     pool_size_ = pool_size;
-    // PL_ASSERT(pool_size_ != 0);
 
     dedicated_thread_count_ = dedicated_thread_count;
 
-    for (size_t i = 0; i < pool_size_; ++i) {
-      // add thread to thread pool.
-      thread_pool_.create_thread(
-          boost::bind(&boost::asio::io_service::run, &io_service_));
+    if (pool_size_ != 0) {
+      task_scheduler_.reset(new TaskScheduler(pool_size_));
     }
+    task_group_.reset(new TaskGroup());
 
     dedicated_threads_.resize(dedicated_thread_count_);
   }
@@ -53,16 +50,18 @@ class ThreadPool {
     for (size_t i = 0; i < current_thread_count_; ++i) {
       dedicated_threads_[(current_thread_count_ - 1 - i)]->join();
     }
-    io_service_.stop();
-    thread_pool_.join_all();
+    if (task_group_ != nullptr) {
+      GetTaskScheduler().Wait(*task_group_);
+    }
+    task_scheduler_.reset();
   }
 
   // submit task to thread pool.
   // it accepts a function and a set of function parameters as parameters.
   template <typename FunctionType, typename... ParamTypes>
   void SubmitTask(FunctionType &&func, const ParamTypes &&... params) {
-    // add task to thread pool.
-    io_service_.post(std::bind(func, params...));
+    PL_ASSERT(task_group_ != nullptr);
+    GetTaskScheduler().Submit(*task_group_, std::bind(func, params...));
   }
 
   // submit task to a dedicated thread.
@@ -79,6 +78,11 @@ class ThreadPool {
   ThreadPool(const ThreadPool &);
   ThreadPool &operator=(const ThreadPool &);
 
+  TaskScheduler &GetTaskScheduler() {
+    return (task_scheduler_ != nullptr) ? *task_scheduler_
+                                        : TaskScheduler::GetInstance();
+  }
+
  private:
   // number of threads in the thread pool.
   size_t pool_size_;
@@ -87,13 +91,10 @@ class ThreadPool {
   // current number of dedicated threads.
   std::atomic<size_t> current_thread_count_ = ATOMIC_VAR_INIT(0);
 
-  // real thread pool that holds a set of threads.
-  boost::thread_group thread_pool_;
-  // io_service provides IO functionality of asynchronize services.
-  boost::asio::io_service io_service_;
-  // io_service::work is responsible for starting the io_service processing
-  // loop.
-  boost::asio::io_service::work work_;
+  // workers of the pool, if it does not share the global scheduler.
+  std::unique_ptr<TaskScheduler> task_scheduler_;
+  // every task submitted to the pool, waited for on shutdown.
+  std::unique_ptr<TaskGroup> task_group_;
 
   std::vector<std::unique_ptr<std::thread>> dedicated_threads_;
 };
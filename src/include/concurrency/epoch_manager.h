@@ -131,6 +131,16 @@ public:
     return max_cid_ro_;
   }
 
+  size_t GetCurrentEpoch() { return current_epoch_.load(); }
+
+  // no txn that entered an epoch older than the returned one is still running,
+  // so memory retired in those epochs is not visible to anybody anymore.
+  size_t GetReclaimableEpoch() {
+    IncreaseQueueTail();
+    IncreaseReclaimTail();
+    return reclaim_tail_.load();
+  }
+
 private:
   void Start() {
     while (!finish_) {
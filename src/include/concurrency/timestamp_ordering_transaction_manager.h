@@ -78,6 +78,9 @@ class TimestampOrderingTransactionManager : public TransactionManager {
                              const ItemPointer &location,
                              ItemPointer *index_entry_ptr = nullptr);
 
+  virtual void PerformBulkInsert(Transaction *const current_txn,
+                                 const oid_t &tile_group_id);
+
   virtual bool PerformRead(Transaction *const current_txn,
                            const ItemPointer &location,
                            bool acquire_ownership = false);
@@ -89,6 +89,10 @@ class Transaction : public Printable {
 
   void RecordInsert(const ItemPointer &);
 
+  // Record a tile group filled by a bulk load. All of its tuples are
+  // committed or aborted together.
+  void RecordBulkInsert(const oid_t &tile_group_id);
+
   // Return true if we detect INS_DEL
   bool RecordDelete(const ItemPointer &);
 
@@ -98,6 +102,10 @@ class Transaction : public Printable {
     return rw_set_;
   }
 
+  inline const std::vector<oid_t> &GetBulkInsertSet() {
+    return bulk_insert_set_;
+  }
+
   inline std::shared_ptr<ReadWriteSet> GetGCSetPtr() {
     return gc_set_;
   }
@@ -138,6 +146,9 @@ class Transaction : public Printable {
 
   ReadWriteSet rw_set_;
 
+  // tile groups filled by bulk loads in the transaction.
+  std::vector<oid_t> bulk_insert_set_;
+
   // this set contains data location that needs to be gc'd in the transaction.
   std::shared_ptr<ReadWriteSet> gc_set_;
 
@@ -109,6 +109,12 @@ class TransactionManager {
                              const ItemPointer &location, 
                              ItemPointer *index_entry_ptr = nullptr) = 0;
 
+  // Take ownership of all the filled slots of a tile group that was bulk
+  // loaded by the transaction. The slots are stamped with the commit id
+  // of the transaction at once when it commits.
+  virtual void PerformBulkInsert(Transaction *const current_txn,
+                                 const oid_t &tile_group_id) = 0;
+
   virtual bool PerformRead(Transaction *const current_txn, 
                            const ItemPointer &location,
                            bool acquire_ownership = false) = 0;
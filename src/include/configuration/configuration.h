@@ -35,6 +35,15 @@ DECLARE_string(socket_family);
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
 
+// Most bytes the executors of a query may hold
+DECLARE_uint64(query_memory_limit);
+
+// Most bytes the executors of all queries may hold together
+DECLARE_uint64(total_query_memory_limit);
+
+// Most bytes resident tile groups may hold before cold ones are evicted
+DECLARE_uint64(anti_cache_memory_limit);
+
 //===----------------------------------------------------------------------===//
 // WRITE AHEAD LOG
 //===----------------------------------------------------------------------===//
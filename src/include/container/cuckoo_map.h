@@ -16,6 +16,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <cstdio>
+#include <functional>
 
 #include "libcuckoo/cuckoohash_map.hh"
 
@@ -23,12 +24,14 @@ namespace peloton {
 
 // CUCKOO_MAP_TEMPLATE_ARGUMENTS
 #define CUCKOO_MAP_TEMPLATE_ARGUMENTS template <typename KeyType, \
-    typename ValueType>
+    typename ValueType, typename HashType, typename PredType>
 
 // CUCKOO_MAP_TYPE
-#define CUCKOO_MAP_TYPE CuckooMap<KeyType, ValueType>
+#define CUCKOO_MAP_TYPE CuckooMap<KeyType, ValueType, HashType, PredType>
 
-CUCKOO_MAP_TEMPLATE_ARGUMENTS
+template <typename KeyType, typename ValueType,
+          typename HashType = DefaultHasher<KeyType>,
+          typename PredType = std::equal_to<KeyType>>
 class CuckooMap {
  public:
 
@@ -47,6 +50,19 @@ class CuckooMap {
   // Delete key from the cuckoo_map
   bool Erase(const KeyType &key);
 
+  // Runs fn on the value of key while holding the lock of its bucket.
+  // Returns false if key is not in the cuckoo_map.
+  bool UpdateFn(const KeyType &key, std::function<void(ValueType &)> fn);
+
+  // Runs fn on the value of key while holding the lock of its bucket,
+  // inserts value instead if key is not in the cuckoo_map
+  void Upsert(const KeyType &key, std::function<void(ValueType &)> fn,
+              ValueType value);
+
+  // Runs fn on every item while holding the locks of all the buckets
+  // (blocks all the writers, not meant for hot paths)
+  void ForEach(std::function<void(const KeyType &, const ValueType &)> fn);
+
   // Checks whether the cuckoo_map contains key
   bool Contains(const KeyType &key);
 
@@ -62,7 +78,8 @@ class CuckooMap {
  private:
 
   // cuckoo map
-  typedef cuckoohash_map<KeyType, ValueType> cuckoo_map_t;
+  typedef cuckoohash_map<KeyType, ValueType, HashType, PredType>
+      cuckoo_map_t;
 
   cuckoo_map_t cuckoo_map;
 };
@@ -0,0 +1,157 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// work_stealing_deque.h
+//
+// Identification: src/include/container/work_stealing_deque.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// Work-stealing Deque -- Chase-Lev deque, one owner and many thieves.
+//===--------------------------------------------------------------------===//
+
+/**
+ * The owner pushes and pops items at the bottom, other threads steal them
+ * from the top. Only a steal and a pop of the last item synchronize, with a
+ * CAS on the top index. T has to be trivially copyable, e.g. a pointer.
+ *
+ * The circular array grows when it is full. Thieves may still read the old
+ * one, so old arrays are only freed with the deque.
+ */
+template <typename T>
+class WorkStealingDeque {
+ public:
+  WorkStealingDeque(const WorkStealingDeque &) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &) = delete;
+
+  // The capacity has to be a power of two
+  explicit WorkStealingDeque(size_t capacity = 256)
+      : top_(0), bottom_(0), array_(new Array(capacity)) {
+    PL_ASSERT((capacity & (capacity - 1)) == 0);
+    arrays_.emplace_back(array_.load(std::memory_order_relaxed));
+  }
+
+  // Owner only
+  void Push(T item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_acquire);
+    Array *array = array_.load(std::memory_order_relaxed);
+
+    if (bottom - top > static_cast<int64_t>(array->mask)) {
+      array = array->Grow(top, bottom);
+      arrays_.emplace_back(array);
+      array_.store(array, std::memory_order_release);
+    }
+
+    // Publishes the item to thieves that acquire the bottom index
+    array->Put(bottom, item);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Owner only, takes the item pushed last
+  bool Pop(T &item) {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array *array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      // Empty
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    item = array->Get(bottom);
+    if (top < bottom) {
+      return true;
+    }
+
+    // The last item, race the thieves for it
+    bool won = top_.compare_exchange_strong(top, top + 1,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  // Any thread, takes the item pushed first. May fail if it loses a race
+  // even though the deque is not empty.
+  bool Steal(T &item) {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+      return false;
+    }
+
+    Array *array = array_.load(std::memory_order_acquire);
+    item = array->Get(top);
+    return top_.compare_exchange_strong(top, top + 1,
+                                        std::memory_order_seq_cst,
+                                        std::memory_order_relaxed);
+  }
+
+  // Approximate, other threads may change it meanwhile
+  size_t GetSize() const {
+    int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    int64_t top = top_.load(std::memory_order_relaxed);
+    return (bottom > top) ? static_cast<size_t>(bottom - top) : 0;
+  }
+
+  bool IsEmpty() const { return GetSize() == 0; }
+
+ private:
+  struct Array {
+    explicit Array(size_t capacity)
+        : mask(capacity - 1), items(new std::atomic<T>[capacity]) {}
+
+    T Get(int64_t index) const {
+      return items[index & mask].load(std::memory_order_relaxed);
+    }
+
+    void Put(int64_t index, T item) {
+      items[index & mask].store(item, std::memory_order_relaxed);
+    }
+
+    // Copies the live items into an array twice as large
+    Array *Grow(int64_t top, int64_t bottom) const {
+      Array *array = new Array(2 * (mask + 1));
+      for (int64_t index = top; index < bottom; index++) {
+        array->Put(index, Get(index));
+      }
+      return array;
+    }
+
+    const size_t mask;
+
+    std::unique_ptr<std::atomic<T>[]> items;
+  };
+
+  std::atomic<int64_t> top_;
+
+  std::atomic<int64_t> bottom_;
+
+  std::atomic<Array *> array_;
+
+  // Every array the deque ever had, owned by the owner
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+}  // namespace peloton
@@ -17,6 +17,7 @@
 #include <type/value.h>
 
 #include "executor/logical_tile.h"
+#include "statistics/operator_stats.h"
 
 namespace peloton {
 
@@ -26,6 +27,7 @@ class AbstractPlan;
 
 namespace executor {
 class ExecutorContext;
+class MemoryTracker;
 }
 
 namespace executor {
@@ -37,7 +39,7 @@ class AbstractExecutor {
   AbstractExecutor(AbstractExecutor &&) = delete;
   AbstractExecutor &operator=(AbstractExecutor &&) = delete;
 
-  virtual ~AbstractExecutor() {}
+  virtual ~AbstractExecutor();
 
   bool Init();
 
@@ -61,6 +63,32 @@ class AbstractExecutor {
 
   const planner::AbstractPlan *GetRawNode() const { return node_; }
 
+  //===--------------------------------------------------------------------===//
+  // Memory accounting
+  //===--------------------------------------------------------------------===//
+
+  // Memory the executor holds on to, see ChargeMemory()
+  size_t GetChargedMemory() const { return charged_memory_; }
+
+  // Charges memory the executor holds on to, like a hash table, against the
+  // query. Throws an OutOfMemoryException past the limits. Helpers like the
+  // aggregators charge what they hold to their executor.
+  void ChargeMemory(size_t bytes);
+
+  // Charges it only if it fits, for executors that can spill instead
+  bool TryChargeMemory(size_t bytes);
+
+  void ReleaseMemory(size_t bytes);
+
+  // Collects the time, tiles and tuples of the executor for EXPLAIN ANALYZE,
+  // only executors it was enabled on pay for it
+  void EnableInstrumentation(int depth);
+
+  // nullptr unless instrumentation is enabled
+  const stats::OperatorStats *GetOperatorStats() const {
+    return operator_stats_.get();
+  }
+
   // set the context
   void SetContext(type::Value &value);
 
@@ -77,6 +105,12 @@ class AbstractExecutor {
   // Used to reset the state. For now it's overloaded by index scan executor
   virtual void ResetState() {}
 
+  // The parent needs at most tuple_budget tuples from this executor, like a
+  // limit does. Scans stop early, executors that neither drop nor add tuples
+  // pass it on to their child. Since some executors do not need this
+  // function, we set it to empty function.
+  virtual void SetTupleBudget(size_t tuple_budget UNUSED_ATTRIBUTE) {}
+
  protected:
   // NOTE: The reason why we keep the plan node separate from the executor
   // context is because we might want to reuse the plan multiple times
@@ -92,6 +126,13 @@ class AbstractExecutor {
 
   void SetOutput(LogicalTile *val);
 
+  // Counts tuples the predicate of the executor rejected
+  inline void CountFilteredTuples(size_t count) {
+    if (operator_stats_ != nullptr) {
+      operator_stats_->filtered_tuple_count += count;
+    }
+  }
+
   /**
    * @brief Convenience method to return plan node corresponding to this
    *        executor, appropriately type-casted.
@@ -116,6 +157,15 @@ class AbstractExecutor {
   /** @brief Plan node corresponding to this executor. */
   const planner::AbstractPlan *node_ = nullptr;
 
+  /** @brief Tracker charged_memory_ was charged to, it outlives the context */
+  std::shared_ptr<MemoryTracker> memory_tracker_;
+
+  /** @brief Released when the executor is destroyed */
+  size_t charged_memory_ = 0;
+
+  /** @brief Statistics of EXPLAIN ANALYZE, nullptr when it is disabled */
+  std::unique_ptr<stats::OperatorStats> operator_stats_;
+
  protected:
   // Executor context
   ExecutorContext *executor_context_ = nullptr;
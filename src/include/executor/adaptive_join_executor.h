@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// adaptive_join_executor.h
+//
+// Identification: src/include/executor/adaptive_join_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "executor/abstract_join_executor.h"
+#include "executor/logical_tile.h"
+#include "planner/adaptive_join_plan.h"
+
+namespace peloton {
+namespace executor {
+
+/**
+ * Buffers the left side until it has seen more rows than the nested loop
+ * limit of the plan, or all of them. A small left side is joined by looking
+ * up the matches of every row through the second child, a large one by
+ * hashing it and scanning the right side once through the third child,
+ * in more partitions if the hash table does not fit in the memory limit of
+ * the query. The strategy it picks is recorded in the metric of the query.
+ */
+class AdaptiveJoinExecutor : public AbstractJoinExecutor {
+  AdaptiveJoinExecutor(const AdaptiveJoinExecutor &) = delete;
+  AdaptiveJoinExecutor &operator=(const AdaptiveJoinExecutor &) = delete;
+
+ public:
+  explicit AdaptiveJoinExecutor(const planner::AbstractPlan *node,
+                                ExecutorContext *executor_context);
+
+  // INVALID until the first call to Execute()
+  JoinStrategyType GetJoinStrategy() const { return join_strategy_; }
+
+  // Number of partitions of a grace hash join, 1 for an in-memory one
+  size_t GetPartitionCount() const { return partition_count_; }
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  typedef std::map<size_t, LogicalTile::PositionListsBuilder> BuilderMap;
+
+  // Buffers left tiles until the strategy is clear and picks it
+  void ChooseJoinStrategy();
+
+  // Joins the rows of a left tile with the matches the second child finds
+  void JoinByLookups(size_t left_tile_itr);
+
+  // Joins all left rows with the output of the third child
+  void JoinByHashing();
+
+  bool MatchRows(LogicalTile *left_tile, oid_t left_row_itr,
+                 LogicalTile *right_tile, oid_t right_row_itr);
+
+  // Turns the pairs of rows of a right tile and of left tiles into output
+  // tiles, one per left tile
+  void FlushOutput(size_t right_tile_itr, BuilderMap &builders);
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  JoinStrategyType join_strategy_ = JOIN_STRATEGY_TYPE_INVALID;
+
+  size_t partition_count_ = 0;
+
+  /** @brief Memory charged for the hash table of a partition */
+  size_t hash_table_size_ = 0;
+
+  size_t left_row_count_ = 0;
+
+  /** @brief Next left tile to look up the matches of */
+  size_t left_tile_itr_ = 0;
+
+  std::deque<std::unique_ptr<LogicalTile>> buffered_output_tiles_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -276,9 +277,11 @@ class AbstractAggregator {
  */
 class HashAggregator : public AbstractAggregator {
  public:
+  // The groups are charged to the memory of the executor, which may be null
   HashAggregator(const planner::AggregatePlan *node,
                  storage::DataTable *output_table,
-                 executor::ExecutorContext *econtext, size_t num_input_columns);
+                 executor::ExecutorContext *econtext, size_t num_input_columns,
+                 AbstractExecutor *executor);
 
   bool Advance(AbstractTuple *next_tuple) override;
 
@@ -334,6 +337,11 @@ class HashAggregator : public AbstractAggregator {
 
   /** @brief Hash table */
   HashAggregateMapType aggregates_map;
+
+  /** @brief Executor the groups are charged to */
+  AbstractExecutor *executor_;
+
+  size_t charged_memory_ = 0;
 };
 
 /**
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compiled_pipeline_executor.h
+//
+// Identification: src/include/executor/compiled_pipeline_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "codegen/compiled_pipeline.h"
+#include "executor/abstract_executor.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace planner {
+class SeqScanPlan;
+}
+
+namespace storage {
+class DataTable;
+class TileGroup;
+}
+
+namespace executor {
+
+/**
+ * Runs a pipeline compiled by the query compiler in place of the executors
+ * of its plans. The node is the root of the pipeline: the sequential scan,
+ * or the aggregation on top of it.
+ *
+ * A scan emits the same logical tiles a SeqScanExecutor would. Whenever the
+ * compiled code gives up on a tile group, the tile group is filtered with
+ * the interpreted predicate instead.
+ *
+ * An aggregation only emits its result once all tile groups went through
+ * the compiled code. If the compiled code gives up on any of them, the
+ * executor returns the output of its only child, the interpreted executors
+ * of the same plans, which it is built with for that purpose.
+ */
+class CompiledPipelineExecutor : public AbstractExecutor {
+ public:
+  CompiledPipelineExecutor(const CompiledPipelineExecutor &) = delete;
+  CompiledPipelineExecutor &operator=(const CompiledPipelineExecutor &) =
+      delete;
+  CompiledPipelineExecutor(CompiledPipelineExecutor &&) = delete;
+  CompiledPipelineExecutor &operator=(CompiledPipelineExecutor &&) = delete;
+
+  CompiledPipelineExecutor(
+      const planner::AbstractPlan *node, ExecutorContext *executor_context,
+      std::shared_ptr<const codegen::CompiledPipeline> pipeline);
+
+  ~CompiledPipelineExecutor();
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  bool ExecuteScan();
+
+  bool ExecuteAggregation();
+
+  // Offsets of the tuples of the tile group visible to the transaction
+  std::vector<oid_t> GetVisibleTuples(
+      const std::shared_ptr<storage::TileGroup> &tile_group);
+
+  // Runs the compiled code over the tuples, returns the number of matches or
+  // -1 if it gave up
+  int64_t RunPipeline(const std::shared_ptr<storage::TileGroup> &tile_group,
+                      const std::vector<oid_t> &position_list,
+                      std::vector<oid_t> &matches,
+                      std::vector<int64_t> &aggregate_state);
+
+  // Filters the tuples with the predicate of the scan, in the interpreter
+  std::vector<oid_t> InterpretPredicate(
+      const std::shared_ptr<storage::TileGroup> &tile_group,
+      const std::vector<oid_t> &position_list);
+
+  // Writes the result of the aggregation to the output table
+  void FinalizeAggregation(const std::vector<int64_t> &aggregate_state,
+                           size_t match_count);
+
+  type::Value GetAggregateValue(
+      const codegen::CompiledPipeline::Aggregate &aggregate, int64_t value,
+      int64_t count) const;
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  std::shared_ptr<const codegen::CompiledPipeline> pipeline_;
+
+  /** @brief Scan at the bottom of the pipeline */
+  const planner::SeqScanPlan *scan_node_ = nullptr;
+
+  storage::DataTable *target_table_ = nullptr;
+
+  /** @brief Columns the scan emits */
+  std::vector<oid_t> column_ids_;
+
+  /** @brief All columns of the table */
+  std::vector<oid_t> table_column_ids_;
+
+  oid_t current_tile_group_offset_ = INVALID_OID;
+
+  oid_t table_tile_group_count_ = INVALID_OID;
+
+  /** @brief The compiled aggregation gave up, pass the child through */
+  bool use_interpreter_ = false;
+
+  /** @brief Result of the aggregation */
+  std::vector<LogicalTile *> result_;
+
+  oid_t result_itr_ = INVALID_OID;
+
+  bool done_ = false;
+
+  storage::DataTable *output_table_ = nullptr;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -14,10 +14,13 @@
 
 #include "executor/abstract_executor.h"
 
+#include <string>
 #include <vector>
 #include "wire/wire.h"
 
 #define COPY_BUFFER_SIZE 65536
+// Number of tuples handed to the bulk loader at a time
+#define COPY_BULK_LOAD_SIZE 100000
 #define INVALID_COL_ID -1
 
 namespace peloton {
@@ -51,6 +54,13 @@ class CopyExecutor : public AbstractExecutor {
   // Copy and escape the content of column to local buffer
   void Copy(const char *data, int len, bool end_of_line);
 
+  // Load the file into the target table (COPY FROM)
+  bool Import();
+
+  // Read and unescape the fields of the next line of the file
+  // Returns false at the end of the file
+  bool ReadLine(std::vector<std::string> &fields);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -61,13 +71,13 @@ class CopyExecutor : public AbstractExecutor {
   // Internal copy buffer
   char buff[COPY_BUFFER_SIZE];
 
-  // The size of data to flush
+  // The size of data to flush (when importing, the size of data read)
   size_t buff_size = 0;
 
   // Pointer in the buffer
   size_t buff_ptr = 0;
 
-  // The handler for the output file
+  // The handler for the output file (when importing, the input file)
   FileHandle file_handle_ = INVALID_FILE_HANDLE;
 
   // Field delimiter between columns
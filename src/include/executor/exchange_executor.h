@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_executor.h
+//
+// Identification: src/include/executor/exchange_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "common/task_scheduler.h"
+#include "executor/abstract_executor.h"
+#include "executor/executor_context.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace executor {
+
+/**
+ * Runs one instance of the subtree of an exchange plan per partition, as
+ * tasks of the task scheduler, and returns their logical tiles as they come.
+ *
+ * Every instance has an executor tree and a context of its own. The
+ * contexts share the transaction, the instances latch it whenever they
+ * check visibility or record reads. The executors of the subtree are built
+ * by the exchange itself, it does not have children.
+ */
+class ExchangeExecutor : public AbstractExecutor {
+ public:
+  ExchangeExecutor(const ExchangeExecutor &) = delete;
+  ExchangeExecutor &operator=(const ExchangeExecutor &) = delete;
+  ExchangeExecutor(ExchangeExecutor &&) = delete;
+  ExchangeExecutor &operator=(ExchangeExecutor &&) = delete;
+
+  explicit ExchangeExecutor(const planner::AbstractPlan *node,
+                            ExecutorContext *executor_context);
+
+  ~ExchangeExecutor();
+
+  // Every instance may stop at the budget, the instances are cancelled once
+  // the exchange returned the budget
+  void SetTupleBudget(size_t tuple_budget);
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  struct Instance {
+    ExecutorPartition partition;
+
+    std::unique_ptr<ExecutorContext> executor_context;
+
+    std::unique_ptr<AbstractExecutor> executor_tree;
+  };
+
+  // Whether instances of the subtree over partitions of its table give the
+  // result of the subtree over the whole table, collecting its scanned tables
+  static bool IsPartitionable(
+      const planner::AbstractPlan *plan, PartitionType partition_type,
+      std::vector<storage::DataTable *> &scanned_tables);
+
+  void StartInstances();
+
+  // Body of the task of an instance
+  void RunInstance(Instance &instance);
+
+  // Cancels the instances and waits for them to finish
+  void StopInstances();
+
+  // Tells the instances to stop at their next tile group, without waiting
+  void CancelInstances();
+
+  void Clear();
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  std::vector<std::unique_ptr<Instance>> instances_;
+
+  /** @brief Number of tuples the parent needs at most, 0 for all of them */
+  size_t tuple_budget_ = 0;
+
+  size_t returned_tuple_count_ = 0;
+
+  /** @brief Tasks of the instances, cancelled to stop them early */
+  std::unique_ptr<TaskGroup> task_group_;
+
+  /** @brief Shared by the contexts of the instances */
+  std::shared_timed_mutex transaction_latch_;
+
+  /** @brief Protects everything below */
+  std::mutex latch_;
+
+  std::condition_variable output_ready_;
+
+  /** @brief Output of the instances that was not returned yet */
+  std::deque<LogicalTile *> output_;
+
+  size_t running_instance_count_ = 0;
+
+  /** @brief First exception or initialization failure of an instance */
+  std::exception_ptr exception_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -13,6 +13,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "executor/memory_tracker.h"
+#include "type/types.h"
 #include "type/varlen_pool.h"
 #include "type/value.h"
 
@@ -26,6 +34,32 @@ class Transaction;
 
 namespace executor {
 
+//===--------------------------------------------------------------------===//
+// Executor Partition
+//===--------------------------------------------------------------------===//
+
+/**
+ * Share of the table that the sequential scan of an instance of a parallel
+ * subtree works on, see ExchangeExecutor.
+ */
+struct ExecutorPartition {
+  PartitionType partition_type;
+
+  oid_t partition_id;
+
+  oid_t partition_count;
+
+  // Columns of the table the tuples are hashed on, for hash partitions
+  std::vector<oid_t> hash_column_ids;
+
+  // Tile groups the scan reads, [start, end). The exchange counts the tile
+  // groups of the table once for all instances, so that their ranges neither
+  // overlap nor leave gaps while tile groups are being added.
+  oid_t start_tile_group_offset;
+
+  oid_t end_tile_group_offset;
+};
+
 //===--------------------------------------------------------------------===//
 // Executor Context
 //===--------------------------------------------------------------------===//
@@ -55,6 +89,36 @@ class ExecutorContext {
   // Get a varlen pool (will construct the pool only if needed)
   type::VarlenPool *GetExecutorContextPool();
 
+  // Restricts the executors to a partition of their input, the contexts of
+  // the instances of a parallel subtree share the latch of the transaction
+  void SetPartition(const ExecutorPartition *partition,
+                    std::shared_timed_mutex *transaction_latch);
+
+  const ExecutorPartition *GetPartition() const { return partition_; }
+
+  // Latch the transaction to read its read/write set, or to modify it.
+  // These do not lock anything unless the context belongs to a partition.
+  std::shared_lock<std::shared_timed_mutex> LatchTransactionShared();
+
+  std::unique_lock<std::shared_timed_mutex> LatchTransaction();
+
+  // Tracker of the memory the executors of the query hold, limited by the
+  // query_memory_limit flag unless another one is set
+  const std::shared_ptr<MemoryTracker> &GetMemoryTracker() const {
+    return memory_tracker_;
+  }
+
+  // The instances of a parallel subtree share the tracker of the query
+  void SetMemoryTracker(std::shared_ptr<MemoryTracker> memory_tracker) {
+    memory_tracker_ = memory_tracker;
+  }
+
+  // Tells the scans of the context that no more tuples are needed, they stop
+  // at the next tile group. Safe to call from another thread.
+  void Cancel() { cancelled_ = true; }
+
+  bool IsCancelled() const { return cancelled_; }
+
   // num of tuple processed
   uint32_t num_processed = 0;
 
@@ -72,6 +136,14 @@ class ExecutorContext {
   // pool
   std::unique_ptr<type::VarlenPool> pool_;
 
+  // partition of the input, null if the executors see all of it
+  const ExecutorPartition *partition_ = nullptr;
+
+  std::shared_timed_mutex *transaction_latch_ = nullptr;
+
+  std::shared_ptr<MemoryTracker> memory_tracker_;
+
+  std::atomic<bool> cancelled_{false};
 };
 
 }  // namespace executor
@@ -25,11 +25,15 @@
 #include "executor/delete_executor.h"
 #include "executor/update_executor.h"
 #include "executor/nested_loop_join_executor.h"
+#include "executor/index_nested_loop_join_executor.h"
 #include "executor/merge_join_executor.h"
 #include "executor/hash_join_executor.h"
+#include "executor/adaptive_join_executor.h"
 #include "executor/hash_executor.h"
 #include "executor/order_by_executor.h"
 #include "executor/hash_set_op_executor.h"
 #include "executor/append_executor.h"
 #include "executor/projection_executor.h"
 #include "executor/copy_executor.h"
+#include "executor/compiled_pipeline_executor.h"
+#include "executor/exchange_executor.h"
@@ -19,6 +19,7 @@
 #include "type/types.h"
 #include "executor/abstract_executor.h"
 #include "executor/logical_tile.h"
+#include "executor/runtime_join_filter.h"
 #include "common/container_tuple.h"
 
 #include <boost/functional/hash.hpp>
@@ -54,6 +55,11 @@ class HashExecutor : public AbstractExecutor {
     return this->column_ids_;
   }
 
+  /** @brief Filter over the keys of the hash table, null until it is built */
+  inline const RuntimeJoinFilter *GetJoinFilter() const {
+    return this->join_filter_.get();
+  }
+
  protected:
   bool DInit();
 
@@ -68,6 +74,9 @@ class HashExecutor : public AbstractExecutor {
 
   std::vector<oid_t> column_ids_;
 
+  /** @brief Pushed down to the scan on the probe side of the join */
+  std::unique_ptr<RuntimeJoinFilter> join_filter_;
+
   bool done_ = false;
 
   size_t result_itr = 0;
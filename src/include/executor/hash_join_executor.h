@@ -37,6 +37,8 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  void PushDownJoinFilter();
+
   HashExecutor *hash_executor_ = nullptr;
 
   bool hashed_ = false;
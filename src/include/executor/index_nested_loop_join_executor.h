@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_executor.h
+//
+// Identification: src/include/executor/index_nested_loop_join_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "executor/abstract_join_executor.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace peloton {
+
+namespace index {
+class Index;
+}
+
+namespace storage {
+class DataTable;
+}
+
+namespace executor {
+
+/**
+ * Index nested loop join. Every outer tile is joined in one go: the join
+ * keys of all of its tuples are looked up with a single Index::ScanBatch()
+ * call, and the visible inner versions are grouped by tile group.
+ *
+ * Only inner and left outer joins are supported.
+ */
+class IndexNestedLoopJoinExecutor : public AbstractJoinExecutor {
+  IndexNestedLoopJoinExecutor(const IndexNestedLoopJoinExecutor &) = delete;
+  IndexNestedLoopJoinExecutor &operator=(const IndexNestedLoopJoinExecutor &) =
+      delete;
+
+ public:
+  explicit IndexNestedLoopJoinExecutor(const planner::AbstractPlan *node,
+                                       ExecutorContext *executor_context);
+
+  ~IndexNestedLoopJoinExecutor();
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  bool ProbeIndex(LogicalTile *outer_tile);
+
+  VisibilityType GetVisibleVersion(ItemPointer &tuple_location);
+
+  //===--------------------------------------------------------------------===//
+  // Plan Info
+  //===--------------------------------------------------------------------===//
+
+  storage::DataTable *inner_table_ = nullptr;
+
+  index::Index *index_ = nullptr;
+
+  std::vector<oid_t> join_column_ids_outer_;
+
+  std::vector<oid_t> inner_column_ids_;
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  std::deque<LogicalTile *> buffered_output_tiles_;
+};
+
+}  // namespace executor
+}  // namespace peloton
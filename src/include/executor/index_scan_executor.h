@@ -21,6 +21,8 @@ namespace peloton {
 
 namespace storage {
 class AbstractTable;
+class TileGroupHeader;
+class Tuple;
 }
 
 namespace executor {
@@ -46,8 +48,14 @@ class IndexScanExecutor : public AbstractScanExecutor {
     result_itr_ = START_OID;
 
     done_ = false;
+
+    scan_limit_ = limit_;
   }
 
+  // The lookup stops reading entries once the budget is spent, an ordered
+  // scan asks the index for no more entries than the budget
+  void SetTupleBudget(size_t tuple_budget);
+
  protected:
   bool DInit();
 
@@ -60,6 +68,24 @@ class IndexScanExecutor : public AbstractScanExecutor {
   bool ExecPrimaryIndexLookup();
   bool ExecSecondaryIndexLookup();
 
+  void InitIndexOnlyScan();
+
+  bool ScanIndex(std::vector<ItemPointer *> &tuple_location_ptrs,
+                 std::vector<type::Value> &key_values);
+
+  bool EvaluateIndexEntry(const type::Value *entry_values);
+
+  bool MatchesEntryKey(const storage::Tuple &key_tuple,
+                       const type::Value *entry_key) const;
+
+  void AddIndexOnlyTile(const std::vector<const type::Value *> &entries);
+
+  void AddResultTiles(const std::vector<ItemPointer> &visible_tuples);
+
+  bool NeedMoreEntries() const;
+
+  void ApplyTupleBudget();
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -100,6 +126,47 @@ class IndexScanExecutor : public AbstractScanExecutor {
   std::vector<expression::AbstractExpression *> runtime_keys_;
 
   bool key_ready_ = false;
+
+  //===--------------------------------------------------------------------===//
+  // Ordered Scan
+  //===--------------------------------------------------------------------===//
+
+  // whether the tuples have to come out in key order
+  bool ordered_ = false;
+
+  ScanDirectionType scan_direction_ = SCAN_DIRECTION_TYPE_FORWARD;
+
+  // number of tuples needed at most, 0 for all of them
+  uint64_t limit_ = 0;
+
+  // number of index entries asked for by the last scan, which grows when
+  // too many of them turn out to be invisible
+  uint64_t scan_limit_ = 0;
+
+  // number of index entries the last scan found
+  size_t scan_entry_count_ = 0;
+
+  // number of tuples the parent needs at most, 0 for all of them
+  size_t tuple_budget_ = 0;
+
+  //===--------------------------------------------------------------------===//
+  // Index-only Scan
+  //===--------------------------------------------------------------------===//
+
+  // whether the index holds all the columns the scan needs
+  bool index_only_ = false;
+
+  // table columns read from the index, the output columns first
+  std::vector<oid_t> index_only_columns_;
+
+  // the key column holding each of them
+  std::vector<oid_t> index_only_key_columns_;
+
+  // schema of the tiles built from index entries
+  std::unique_ptr<catalog::Schema> index_only_schema_;
+
+  // scratch row for evaluating the predicate on index entries
+  std::vector<type::Value> index_only_row_;
 };
 
 }  // namespace executor
@@ -44,6 +44,11 @@ class MaterializationExecutor : public AbstractExecutor {
   explicit MaterializationExecutor(const planner::AbstractPlan *node,
                                    ExecutorContext *executor_context);
 
+  // A tuple out for every tuple in
+  void SetTupleBudget(size_t tuple_budget) {
+    children_[0]->SetTupleBudget(tuple_budget);
+  }
+
  protected:
   bool DInit();
 
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// memory_tracker.h
+//
+// Identification: src/include/executor/memory_tracker.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "type/varlen_pool.h"
+
+namespace peloton {
+namespace executor {
+
+//===--------------------------------------------------------------------===//
+// Memory Tracker
+//===--------------------------------------------------------------------===//
+
+/**
+ * Memory the executors of a query hold on to, like hash tables, sort buffers
+ * and aggregation groups. Every query has its own limit, and all of them
+ * share a global one, a limit of 0 means there is none.
+ *
+ * Executors that cannot do with less memory call Charge(), which throws an
+ * OutOfMemoryException past a limit. Executors that can spill call
+ * TryCharge() and spill when it refuses.
+ *
+ * The instances of a parallel subtree charge the tracker of the query, so it
+ * is thread safe.
+ */
+class MemoryTracker {
+ public:
+  MemoryTracker(const MemoryTracker &) = delete;
+  MemoryTracker &operator=(const MemoryTracker &) = delete;
+
+  explicit MemoryTracker(size_t limit);
+
+  // Releases what the executors did not
+  ~MemoryTracker();
+
+  // Returns false and charges nothing if it does not fit in the limits
+  bool TryCharge(size_t bytes);
+
+  void Charge(size_t bytes);
+
+  void Release(size_t bytes);
+
+  size_t GetUsage() const { return usage_; }
+
+  size_t GetPeakUsage() const { return peak_usage_; }
+
+  size_t GetLimit() const { return limit_; }
+
+  // Memory all queries hold
+  static size_t GetGlobalUsage() { return global_usage_; }
+
+ private:
+  std::atomic<size_t> usage_;
+
+  std::atomic<size_t> peak_usage_;
+
+  const size_t limit_;
+
+  // Bounded by the total_query_memory_limit flag
+  static std::atomic<size_t> global_usage_;
+};
+
+/**
+ * Varlen pool of an executor context, charges the buffers it grows by to the
+ * tracker of the query.
+ */
+class TrackedVarlenPool : public type::VarlenPool {
+ public:
+  TrackedVarlenPool(BackendType backend_type,
+                    std::shared_ptr<MemoryTracker> memory_tracker);
+
+  ~TrackedVarlenPool();
+
+  void *Allocate(size_t size) override;
+
+ private:
+  std::shared_ptr<MemoryTracker> memory_tracker_;
+
+  std::atomic<size_t> charged_size_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -44,6 +44,19 @@ typedef struct peloton_status {
 
 } peloton_status;
 
+/*
+ * Builds the executors of the plan tree below the root executor, the
+ * executors of the plan become the root if there is none
+ */
+executor::AbstractExecutor *BuildExecutorTree(
+    executor::AbstractExecutor *root, const planner::AbstractPlan *plan,
+    executor::ExecutorContext *executor_context, bool compile = true);
+
+/*
+ * Deletes the executors below the root
+ */
+void CleanExecutorTree(executor::AbstractExecutor *root);
+
 class PlanExecutor {
  public:
   PlanExecutor(const PlanExecutor &) = delete;
@@ -56,6 +69,15 @@ class PlanExecutor {
   static void PrintPlan(const planner::AbstractPlan *plan,
                         std::string prefix = "");
 
+  // Name of the column EXPLAIN returns its lines in
+  static const std::string explain_column_name;
+
+  /*
+   * @brief Returns the plan tree one node per line for EXPLAIN
+   */
+  static void ExplainPlan(const planner::AbstractPlan *plan,
+                          std::vector<ResultType> &result, int depth = 0);
+
   // Copy From
   static inline void copyFromTo(const std::string &src,
                                 std::vector<unsigned char> &dst) {
@@ -81,11 +103,15 @@ class PlanExecutor {
    *        Before ExecutePlan, a node first receives value list, so we should
    * pass
    *        value list directly rather than passing Postgres's ParamListInfo
+   *
+   *        With analyze the tuples of the plan are dropped, the result is
+   *        what each executor did instead, for EXPLAIN ANALYZE
    */
   static peloton_status ExecutePlan(const planner::AbstractPlan *plan,
                                     const std::vector<type::Value> &params,
                                     std::vector<ResultType> &result,
-                                    const std::vector<int> &result_format);
+                                    const std::vector<int> &result_format,
+                                    bool analyze = false);
 
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
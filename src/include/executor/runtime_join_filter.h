@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// runtime_join_filter.h
+//
+// Identification: src/include/executor/runtime_join_filter.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace executor {
+
+//===--------------------------------------------------------------------===//
+// Runtime Join Filter
+//===--------------------------------------------------------------------===//
+
+/**
+ * Summary of the join keys on the build side of a hash join, that the scan
+ * on the probe side uses to drop tuples that cannot have a match before
+ * they are materialized.
+ *
+ * It is a blocked Bloom filter over the hashes of the keys, every key sets
+ * a few bits of a single 64-bit word, plus the range of the keys when they
+ * are a single column. Both may answer true for a key that is not there,
+ * but never false for one that is.
+ */
+class RuntimeJoinFilter {
+ public:
+  RuntimeJoinFilter(const RuntimeJoinFilter &) = delete;
+  RuntimeJoinFilter &operator=(const RuntimeJoinFilter &) = delete;
+
+  // Sized for about 1% false positives with that many keys
+  explicit RuntimeJoinFilter(size_t expected_key_count);
+
+  // Hash is the one HashCombine gives for the values of the key, in order
+  void Insert(size_t hash, const std::vector<type::Value> &key);
+
+  bool MayContain(size_t hash) const;
+
+  // Whether the single key column value may be in the range of the keys,
+  // true if there is no range to check
+  bool InRange(const type::Value &value) const;
+
+  bool HasRange() const { return has_range_; }
+
+  size_t GetKeyCount() const { return key_count_; }
+
+  // Types of the key columns, INVALID if no key was inserted yet
+  const std::vector<type::Type::TypeId> &GetKeyTypes() const {
+    return key_types_;
+  }
+
+ private:
+  std::vector<uint64_t> words_;
+
+  uint64_t word_mask_;
+
+  size_t key_count_ = 0;
+
+  std::vector<type::Type::TypeId> key_types_;
+
+  // Range of the keys, kept as long as there is one key column and no key
+  // is null
+  bool has_range_ = true;
+
+  type::Value min_key_;
+
+  type::Value max_key_;
+};
+
+}  // namespace executor
+}  // namespace peloton
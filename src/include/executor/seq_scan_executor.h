@@ -14,6 +14,7 @@
 
 #include "planner/seq_scan_plan.h"
 #include "executor/abstract_scan_executor.h"
+#include "executor/runtime_join_filter.h"
 
 namespace peloton {
 namespace executor {
@@ -28,7 +29,21 @@ class SeqScanExecutor : public AbstractScanExecutor {
   explicit SeqScanExecutor(const planner::AbstractPlan *node,
                            ExecutorContext *executor_context);
 
-  void ResetState() { current_tile_group_offset_ = START_OID; }
+  void ResetState() {
+    current_tile_group_offset_ = start_tile_group_offset_;
+    returned_tuple_count_ = 0;
+  }
+
+  // Stops once the budget is spent. A scan of a table does not collect more
+  // visible tuples of a tile group than the budget has left, unless it has a
+  // predicate or a filter to apply to them.
+  void SetTupleBudget(size_t tuple_budget) { tuple_budget_ = tuple_budget; }
+
+  // Drops the tuples whose key is not in the filter from now on, the key
+  // columns being columns of the output of the scan. Returns false if the
+  // filter cannot be applied to this scan.
+  bool SetJoinFilter(const RuntimeJoinFilter *join_filter,
+                     const std::vector<oid_t> &key_column_ids);
 
  protected:
   bool DInit();
@@ -36,6 +51,21 @@ class SeqScanExecutor : public AbstractScanExecutor {
   bool DExecute();
 
  private:
+  std::vector<oid_t> ApplyPredicate(
+      const std::shared_ptr<storage::TileGroup> &tile_group,
+      std::vector<oid_t> position_list);
+
+  // Drops the tuples that belong to other hash partitions
+  void ApplyHashPartition(const std::shared_ptr<storage::TileGroup> &tile_group,
+                          std::vector<oid_t> &position_list) const;
+
+  // Drops the tuples that cannot match the build side of the join
+  void ApplyJoinFilter(const std::shared_ptr<storage::TileGroup> &tile_group,
+                       std::vector<oid_t> &position_list) const;
+
+  // Number of tuples the budget has left, the largest size_t without one
+  size_t GetRemainingTupleBudget() const;
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -43,15 +73,44 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of current tile group id being scanned. */
   oid_t current_tile_group_offset_ = INVALID_OID;
 
+  /** @brief First tile group to scan, the whole table is scanned from the
+   * start unless the scan is an instance of a parallel one. */
+  oid_t start_tile_group_offset_ = START_OID;
+
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Tuples the parent needs at most, 0 if it needs all of them. It
+   * is kept across DInit() since the parent may set it first. */
+  size_t tuple_budget_ = 0;
+
+  /** @brief Tuples returned since the scan was initialized. */
+  size_t returned_tuple_count_ = 0;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
 
   /** @brief Pointer to table to scan from. */
   storage::DataTable *target_table_ = nullptr;
+
+  /** @brief All columns of the table, the predicate is evaluated over a
+   * logical tile of them. */
+  std::vector<oid_t> table_column_ids_;
+
+  /** @brief Column that the predicate compares with a constant for
+   * equality, INVALID_OID if the predicate does not have that shape or the
+   * column is not dictionary encoded. */
+  oid_t dictionary_column_id_ = INVALID_OID;
+
+  /** @brief Constant of the dictionary predicate. */
+  type::Value dictionary_constant_;
+
+  /** @brief Filter pushed down by a hash join over this scan, if any. */
+  const RuntimeJoinFilter *join_filter_ = nullptr;
+
+  /** @brief Table columns of the join key, in the order of the filter. */
+  std::vector<oid_t> join_filter_column_ids_;
 };
 
 }  // namespace executor
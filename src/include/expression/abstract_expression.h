@@ -13,6 +13,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "common/logger.h"
 #include "common/macros.h"
@@ -28,10 +29,16 @@ class AbstractTuple;
 
 namespace executor {
 class ExecutorContext;
+class LogicalTile;
 }
 
 namespace expression {
 
+class ColumnVector;
+
+// Ids of the tuples of a logical tile a batch is evaluated for, ascending
+typedef std::vector<oid_t> SelectionVector;
+
 //===----------------------------------------------------------------------===//
 // AbstractExpression
 //
@@ -52,6 +59,26 @@ class AbstractExpression : public Printable {
                          const AbstractTuple *tuple2,
                          executor::ExecutorContext *context) const = 0;
 
+  //===--------------------------------------------------------------------===//
+  // Batch Evaluation
+  //
+  // Both evaluate the expression for the tuples of a logical tile in the
+  // selection at once, with the tile as the only input tuple. The expressions
+  // with a kernel over typed columns override them, the defaults go through
+  // Evaluate() tuple at a time.
+  //===--------------------------------------------------------------------===//
+
+  // Narrows the selection down to the tuples the expression is true for
+  virtual void EvaluateBatch(executor::LogicalTile &tile,
+                             SelectionVector &selection,
+                             executor::ExecutorContext *context) const;
+
+  // Computes the value of the expression for every tuple in the selection
+  virtual void EvaluateColumn(executor::LogicalTile &tile,
+                              const SelectionVector &selection,
+                              ColumnVector &result,
+                              executor::ExecutorContext *context) const;
+
   /**
    * Return true if this expression or any descendent has a value that should be
    * substituted with a parameter.
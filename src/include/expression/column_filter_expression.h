@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_filter_expression.h
+//
+// Identification: src/include/expression/column_filter_expression.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "expression/abstract_expression.h"
+
+namespace peloton {
+
+namespace storage {
+struct ColumnAccessor;
+}
+
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// ColumnFilterExpression
+//
+// A scan predicate on a single column of the input tuple that the optimizer
+// compiled ahead of execution: either "column <op> constant" or a range
+// "column >(=) lower AND column <(=) upper". The kernel, specialized for the
+// column type and the comparison at compile time, reads the column straight
+// from the memory of the base tile. The original predicate is kept as the
+// only child, evaluating a single tuple goes through it.
+//===----------------------------------------------------------------------===//
+
+class ColumnFilterExpression : public AbstractExpression {
+ public:
+  // Takes over the predicate "column compare_type constant"
+  ColumnFilterExpression(AbstractExpression *predicate, oid_t column_id,
+                         type::Type::TypeId column_type,
+                         ExpressionType compare_type,
+                         const type::Value &constant);
+
+  // Takes over the predicate "column lower_type lower AND column upper_type
+  // upper", with a GREATERTHAN(OREQUALTO) lower_type and a
+  // LESSTHAN(OREQUALTO) upper_type
+  ColumnFilterExpression(AbstractExpression *predicate, oid_t column_id,
+                         type::Type::TypeId column_type,
+                         ExpressionType lower_type, const type::Value &lower,
+                         ExpressionType upper_type, const type::Value &upper);
+
+  // Whether there is a kernel comparing a column of the type with the
+  // constant
+  static bool IsSupported(type::Type::TypeId column_type,
+                          const type::Value &constant);
+
+  // Whether there is a kernel for a range between the constants
+  static bool IsSupported(type::Type::TypeId column_type,
+                          const type::Value &lower, const type::Value &upper);
+
+  type::Value Evaluate(const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+                       executor::ExecutorContext *context) const override {
+    return children_[0]->Evaluate(tuple1, tuple2, context);
+  }
+
+  void EvaluateBatch(executor::LogicalTile &tile, SelectionVector &selection,
+                     executor::ExecutorContext *context) const override;
+
+  AbstractExpression *Copy() const override {
+    return new ColumnFilterExpression(*this);
+  }
+
+  oid_t GetColumnId() const { return column_id_; }
+
+ protected:
+  ColumnFilterExpression(const ColumnFilterExpression &other)
+      : AbstractExpression(other),
+        column_id_(other.column_id_),
+        column_type_(other.column_type_),
+        kernel_(other.kernel_) {
+    bounds_[0] = other.bounds_[0];
+    bounds_[1] = other.bounds_[1];
+  }
+
+ private:
+  // A constant in the type the kernel compares in
+  union Bound {
+    int64_t integer;
+    uint64_t timestamp;
+    double decimal;
+
+    inline void Get(int64_t &value) const { value = integer; }
+    inline void Get(uint64_t &value) const { value = timestamp; }
+    inline void Get(double &value) const { value = decimal; }
+  };
+
+  typedef void (*Kernel)(const storage::ColumnAccessor &accessor,
+                         const std::vector<oid_t> &position_list,
+                         SelectionVector &selection, const Bound *bounds);
+
+  // Keeps the tuples in the selection whose NativeType column value, taken
+  // as a CompareType, satisfies the Predicate with the bounds
+  template <typename NativeType, typename CompareType, class Predicate>
+  static void Filter(const storage::ColumnAccessor &accessor,
+                     const std::vector<oid_t> &position_list,
+                     SelectionVector &selection, const Bound *bounds);
+
+  // The kernel for a comparison, or for a range if there is an upper_type
+  template <typename NativeType, typename CompareType>
+  static Kernel GetKernel(ExpressionType lower_type,
+                          ExpressionType upper_type);
+
+  // Whether the constant is compared with the column as a double
+  static bool IsDecimalComparison(type::Type::TypeId column_type,
+                                  const type::Value &constant);
+
+  void SetBound(int bound_idx, const type::Value &constant);
+
+  // Column id in the input tuple
+  oid_t column_id_;
+
+  // Type of the column the kernel was compiled for
+  type::Type::TypeId column_type_;
+
+  Kernel kernel_ = nullptr;
+
+  Bound bounds_[2];
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -0,0 +1,144 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_vector.h
+//
+// Identification: src/include/expression/column_vector.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "expression/abstract_expression.h"
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace executor {
+class LogicalTile;
+}
+
+namespace expression {
+
+//===----------------------------------------------------------------------===//
+// ColumnVector
+//
+// The values of an expression for a batch of tuples of a logical tile,
+// indexed by tuple id. Only the entries of the tuples in the selection the
+// vector was computed for are valid.
+//
+// Integer types and DECIMAL are kept unboxed, so that the kernels of the
+// expressions over them are plain loops over arrays. Nulls of those types
+// are kept in a separate array. Every other type is kept as values.
+//===----------------------------------------------------------------------===//
+
+class ColumnVector {
+ public:
+  ColumnVector() {}
+
+  ColumnVector(const ColumnVector &) = delete;
+  ColumnVector &operator=(const ColumnVector &) = delete;
+
+  // Makes room for the tuples in the selection, which has to be in the
+  // ascending order of the logical tile iterator. A vector of type INVALID
+  // holds values of any type
+  void Reset(type::Type::TypeId type, const SelectionVector &selection);
+
+  // Makes this one value for every tuple
+  void SetConstant(const type::Value &value);
+
+  // Reads a column of the logical tile for the tuples in the selection
+  void LoadColumn(executor::LogicalTile &tile, oid_t column_id,
+                  const SelectionVector &selection);
+
+  //===--------------------------------------------------------------------===//
+  // Accessors
+  //===--------------------------------------------------------------------===//
+
+  static inline bool IsIntegerType(type::Type::TypeId type) {
+    return type == type::Type::TINYINT || type == type::Type::SMALLINT ||
+           type == type::Type::INTEGER || type == type::Type::BIGINT;
+  }
+
+  inline type::Type::TypeId GetType() const { return type_; }
+
+  inline bool IsConstant() const { return is_constant_; }
+
+  inline bool IsInteger() const { return IsIntegerType(type_); }
+
+  inline bool IsDecimal() const { return type_ == type::Type::DECIMAL; }
+
+  inline bool IsUnboxed() const { return IsInteger() || IsDecimal(); }
+
+  inline bool IsNull(oid_t tuple_id) const {
+    return IsUnboxed() ? (nulls_[Index(tuple_id)] != 0)
+                       : values_[Index(tuple_id)].IsNull();
+  }
+
+  inline int64_t GetInteger(oid_t tuple_id) const {
+    PL_ASSERT(IsInteger());
+    return integers_[Index(tuple_id)];
+  }
+
+  // Integers are converted, like the comparisons with a DECIMAL do
+  inline double GetDecimal(oid_t tuple_id) const {
+    PL_ASSERT(IsUnboxed());
+    return IsDecimal() ? decimals_[Index(tuple_id)]
+                       : static_cast<double>(integers_[Index(tuple_id)]);
+  }
+
+  type::Value GetValue(oid_t tuple_id) const;
+
+  inline void SetNull(oid_t tuple_id) {
+    PL_ASSERT(is_constant_ == false);
+    if (IsUnboxed()) {
+      nulls_[tuple_id] = 1;
+    } else {
+      values_[tuple_id] = type::ValueFactory::GetNullValueByType(type_);
+    }
+  }
+
+  inline void SetInteger(oid_t tuple_id, int64_t value) {
+    PL_ASSERT(IsInteger() && is_constant_ == false);
+    integers_[tuple_id] = value;
+    nulls_[tuple_id] = 0;
+  }
+
+  inline void SetDecimal(oid_t tuple_id, double value) {
+    PL_ASSERT(IsDecimal() && is_constant_ == false);
+    decimals_[tuple_id] = value;
+    nulls_[tuple_id] = 0;
+  }
+
+  // Values of another type are cast to the type of an unboxed vector
+  void SetValue(oid_t tuple_id, const type::Value &value);
+
+  // Writes the entry in the storage format of the type of the vector
+  void SerializeTo(oid_t tuple_id, char *location) const;
+
+ private:
+  inline size_t Index(oid_t tuple_id) const {
+    return is_constant_ ? 0 : tuple_id;
+  }
+
+  type::Type::TypeId type_ = type::Type::INVALID;
+
+  bool is_constant_ = false;
+
+  std::vector<int64_t> integers_;
+
+  std::vector<double> decimals_;
+
+  std::vector<uint8_t> nulls_;
+
+  std::vector<type::Value> values_;
+};
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -40,6 +40,21 @@ class ComparisonExpression : public AbstractExpression {
     PL_ASSERT(children_.size() == 2);
     auto vl = children_[0]->Evaluate(tuple1, tuple2, context);
     auto vr = children_[1]->Evaluate(tuple1, tuple2, context);
+    return Compare(vl, vr);
+  }
+
+  void EvaluateBatch(executor::LogicalTile &tile, SelectionVector &selection,
+                     executor::ExecutorContext *context) const override;
+
+  AbstractExpression *Copy() const override {
+    return new ComparisonExpression(*this);
+  }
+
+ protected:
+  ComparisonExpression(const ComparisonExpression &other)
+      : AbstractExpression(other) {}
+
+  type::Value Compare(const type::Value &vl, const type::Value &vr) const {
     switch (exp_type_) {
       case(EXPRESSION_TYPE_COMPARE_EQUAL) :
         return vl.CompareEquals(vr);
@@ -57,14 +72,6 @@ class ComparisonExpression : public AbstractExpression {
         throw Exception("Invalid comparison expression type.");
     }
   }
-
-  AbstractExpression *Copy() const override {
-    return new ComparisonExpression(*this);
-  }
-
- protected:
-  ComparisonExpression(const ComparisonExpression &other)
-      : AbstractExpression(other) {}
 };
 
 }  // End expression namespace
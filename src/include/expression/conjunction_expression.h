@@ -56,6 +56,9 @@ class ConjunctionExpression : public AbstractExpression {
     }
   }
 
+  void EvaluateBatch(executor::LogicalTile &tile, SelectionVector &selection,
+                     executor::ExecutorContext *context) const override;
+
   AbstractExpression *Copy() const override {
     return new ConjunctionExpression(*this);
   }
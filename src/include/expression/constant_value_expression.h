@@ -35,6 +35,10 @@ class ConstantValueExpression : public AbstractExpression {
     return value_;
   }
 
+  void EvaluateColumn(executor::LogicalTile &tile,
+                      const SelectionVector &selection, ColumnVector &result,
+                      executor::ExecutorContext *context) const override;
+
   type::Value GetValue() const { return value_;}
 
   bool HasParameter() const override { return false; }
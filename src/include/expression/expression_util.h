@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <set>
 #include <string>
 #include <vector>
 
@@ -273,6 +274,26 @@ class ExpressionUtil {
   //
   //    }
 
+ public:
+  /**
+   * Collects the ids of the columns read by the TupleValueExpressions in
+   * the given expression tree
+   */
+  static void GetTupleValueColumnIds(const AbstractExpression *expr,
+                                     std::set<oid_t> &column_ids) {
+    if (expr == nullptr) {
+      return;
+    }
+    if (expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE) {
+      auto tuple_value_expr = static_cast<const TupleValueExpression *>(expr);
+      column_ids.insert(tuple_value_expr->GetColumnId());
+    }
+    for (size_t child_itr = 0; child_itr < expr->GetChildrenSize();
+         child_itr++) {
+      GetTupleValueColumnIds(expr->GetChild(child_itr), column_ids);
+    }
+  }
+
  public:
   /**
    * Walks an expression tree and fills in information about
@@ -47,7 +47,14 @@ class OperatorExpression : public AbstractExpression {
     PL_ASSERT(children_.size() == 2);
     type::Value vl = children_[0]->Evaluate(tuple1, tuple2, context);
     type::Value vr = children_[1]->Evaluate(tuple1, tuple2, context);
+    return Apply(vl, vr);
+  }
+
+  void EvaluateColumn(executor::LogicalTile &tile,
+                      const SelectionVector &selection, ColumnVector &result,
+                      executor::ExecutorContext *context) const override;
 
+  type::Value Apply(const type::Value &vl, const type::Value &vr) const {
     switch (exp_type_) {
       case (EXPRESSION_TYPE_OPERATOR_PLUS):
         return (vl.Add(vr));
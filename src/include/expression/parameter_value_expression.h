@@ -37,6 +37,10 @@ class ParameterValueExpression : public AbstractExpression {
     return context->GetParams().at(value_idx_);
   }
 
+  void EvaluateColumn(executor::LogicalTile &tile,
+                      const SelectionVector &selection, ColumnVector &result,
+                      executor::ExecutorContext *context) const override;
+
   AbstractExpression *Copy() const override {
     return new ParameterValueExpression(value_idx_);
   }
@@ -59,6 +59,10 @@ class TupleValueExpression : public AbstractExpression {
     }
   }
 
+  void EvaluateColumn(executor::LogicalTile &tile,
+                      const SelectionVector &selection, ColumnVector &result,
+                      executor::ExecutorContext *context) const override;
+
   void SetTupleValueExpressionParams(type::Type::TypeId type_id, int value_idx,
                                      int tuple_idx) {
     return_value_type_ = type_id;
@@ -115,7 +115,8 @@ private:
 
   void AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx);
 
-  bool ResetTuple(const ItemPointer &);
+  // The caller pins the tile group and holds its anti-cache lock shared
+  bool ResetTuple(storage::TileGroup *tile_group, const oid_t tuple_id);
 
   void DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx);
 
@@ -0,0 +1,172 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art.h
+//
+// Identification: src/include/index/art.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "type/types.h"
+
+// Number of prefix bytes kept in an inner node, longer prefixes are read
+// from any leaf below the node
+#define ART_MAX_PREFIX_LENGTH ((uint32_t)8)
+
+// Number of retired nodes after which writers try to free them
+#define ART_GC_THRESHOLD ((size_t)1024)
+
+namespace peloton {
+namespace index {
+
+/*
+ * class ArtTree - Adaptive radix tree with optimistic lock coupling
+ *
+ * Keys are byte strings of which no one is a prefix of another (see
+ * ArtKey), and map to the list of values that share them. Inner nodes grow
+ * from 4 to 16, 48 and 256 children as keys are added, and compress the
+ * bytes all their keys share into a prefix.
+ *
+ * Every inner node has a version. Readers never lock, they read the version
+ * before looking at a node and check that it did not change afterwards, and
+ * restart from the root if it did. Writers upgrade the version of the nodes
+ * they change to a lock (parent before child), and bump it when they are
+ * done.
+ *
+ * Leaves are immutable, adding or removing a value of a key swaps in a new
+ * leaf. Unlinked nodes and leaves are freed once every thread that could
+ * have seen them is gone, which is tracked by two alternating epochs.
+ */
+class ArtTree {
+ public:
+  using ValueType = ItemPointer *;
+  using ScanCallback = std::function<void(
+      const std::string &key, const std::vector<ValueType> &values)>;
+
+  ArtTree();
+
+  ~ArtTree();
+
+  // Adds value to the values of key. Returns false if the key already has
+  // the same value, or if predicate is set and holds for one of its values
+  bool Insert(const std::string &key, ValueType value,
+              const std::function<bool(const void *)> &predicate);
+
+  // Removes value from the values of key, and the key with its last value.
+  // Returns false if the key does not have the value
+  bool Delete(const std::string &key, ValueType value);
+
+  // Appends the values of key to result
+  void Lookup(const std::string &key, std::vector<ValueType> &result);
+
+  // Calls callback on the keys between low_key and *high_key (both
+  // included) in key order, high_key == nullptr scans to the end
+  void Scan(const std::string &low_key, const std::string *high_key,
+            const ScanCallback &callback);
+
+  size_t GetMemoryFootprint() const { return memory_footprint_.load(); }
+
+  bool NeedGC() const { return garbage_count_.load() != 0; }
+
+  // Frees the retired nodes no thread can see any more, and moves on to the
+  // next epoch
+  void PerformGC();
+
+ private:
+  struct Node;
+  struct Node4;
+  struct Node16;
+  struct Node48;
+  struct Node256;
+  struct Leaf;
+
+  using ChildList = std::vector<std::pair<uint8_t, Node *>>;
+
+  // Keeps the calling thread in the current epoch while it is in the tree
+  class EpochGuard {
+   public:
+    EpochGuard(ArtTree *tree);
+    ~EpochGuard();
+
+   private:
+    ArtTree *tree_;
+    uint64_t slot_;
+  };
+
+  // The Try*() functions return false if they ran into a concurrent change
+  // and have to start over
+  bool TryInsert(const std::string &key, ValueType value,
+                 const std::function<bool(const void *)> &predicate,
+                 bool &inserted);
+
+  bool TryDelete(const std::string &key, ValueType value, bool &deleted);
+
+  bool TryLookup(const std::string &key, std::vector<ValueType> &result);
+
+  bool ScanNode(Node *node, uint64_t version, size_t depth,
+                const std::string &low_key, const std::string *high_key,
+                bool check_low, bool check_high,
+                std::vector<const Leaf *> &leaves);
+
+  // Optimistic lock coupling
+  static bool ReadLockOrRestart(Node *node, uint64_t &version);
+  static bool CheckOrRestart(Node *node, uint64_t version);
+  static bool UpgradeToWriteLockOrRestart(Node *node, uint64_t version);
+  static bool WriteLockOrRestart(Node *node);
+  static void WriteUnlock(Node *node);
+  static void WriteUnlockObsolete(Node *node);
+
+  // Node operations, the ones that change a node need its write lock
+  static Node *FindChild(Node *node, uint8_t key_byte);
+  static bool IsFull(Node *node);
+  static void AddChild(Node *node, uint8_t key_byte, Node *child);
+  static void ChangeChild(Node *node, uint8_t key_byte, Node *child);
+  static void RemoveChild(Node *node, uint8_t key_byte);
+  static void GetChildren(Node *node, ChildList &children);
+  static Node *GetSecondChild(Node *node, uint8_t key_byte,
+                              uint8_t &second_key_byte);
+  static const Leaf *GetAnyLeaf(Node *node);
+  static bool PrefixMatches(Node *node, uint32_t prefix_length,
+                            const std::string &key, size_t depth);
+  static void AddPrefixBefore(Node *node, Node *parent, uint8_t key_byte);
+
+  Node *Grow(Node *node);
+  Node *NewLeaf(const std::string &key, std::vector<ValueType> &&values);
+  void FreeNode(Node *node);
+  void FreeSubtree(Node *node);
+
+  // Epoch-based reclamation
+  uint64_t JoinEpoch();
+  void LeaveEpoch(uint64_t slot);
+  void Retire(Node *node);
+  void CollectGarbageIfNeeded();
+
+  // The root never changes, and has room for every key byte
+  Node256 *root_;
+
+  std::atomic<size_t> memory_footprint_;
+
+  std::atomic<uint64_t> epoch_;
+  // Threads in the tree, by the parity of the epoch they joined
+  std::atomic<uint64_t> active_count_[2];
+
+  std::mutex garbage_mutex_;
+  // Retired nodes with the epoch they were retired in
+  std::vector<std::pair<uint64_t, Node *>> garbage_;
+  std::atomic<size_t> garbage_count_;
+};
+
+}  // End index namespace
+}  // End peloton namespace
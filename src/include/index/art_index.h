@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art_index.h
+//
+// Identification: src/include/index/art_index.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "index/art.h"
+#include "index/index.h"
+
+namespace peloton {
+namespace index {
+
+/**
+ * Adaptive radix tree index implementation.
+ *
+ * Keys of any length and column types are encoded into binary-comparable
+ * byte strings (see ArtKey), so long string and composite keys do not need
+ * the TupleKey fallback of the other ordered indexes, and the key can be
+ * decoded again for predicates and index-only scans.
+ *
+ * Readers do not take any locks (see ArtTree).
+ *
+ * @see Index
+ */
+class ArtIndex : public Index {
+  friend class IndexFactory;
+
+ public:
+  ArtIndex(IndexMetadata *metadata);
+
+  ~ArtIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate);
+
+  void Scan(const std::vector<type::Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            const ScanDirectionType &scan_direction,
+            std::vector<ItemPointer *> &result,
+            const ConjunctionScanPredicate *csp_p);
+
+  bool ScanKeyColumns(const std::vector<type::Value> &value_list,
+                      const std::vector<oid_t> &tuple_column_id_list,
+                      const std::vector<ExpressionType> &expr_list,
+                      const ScanDirectionType &scan_direction,
+                      const ConjunctionScanPredicate *csp_p,
+                      const std::vector<oid_t> &key_columns,
+                      std::vector<ItemPointer *> &result,
+                      std::vector<type::Value> &key_values);
+
+  void ScanAllKeys(std::vector<ItemPointer *> &result);
+
+  void ScanKey(const storage::Tuple *key, std::vector<ItemPointer *> &result);
+
+  std::string GetTypeName() const;
+
+  bool Cleanup() { return true; }
+
+  size_t GetMemoryFootprint() { return container.GetMemoryFootprint(); }
+
+  // Unlinked nodes wait for the threads that could still see them
+  bool NeedGC() { return container.NeedGC(); }
+
+  void PerformGC() { container.PerformGC(); }
+
+ protected:
+  // Scan() with a callback that gets the decoded key and the number of
+  // values it added to result for every key found
+  template <typename KeyCallback>
+  void ScanEntries(const std::vector<type::Value> &value_list,
+                   const std::vector<oid_t> &tuple_column_id_list,
+                   const std::vector<ExpressionType> &expr_list,
+                   const ScanDirectionType &scan_direction,
+                   std::vector<ItemPointer *> &result,
+                   const ConjunctionScanPredicate *csp_p,
+                   KeyCallback key_callback);
+
+  // container
+  ArtTree container;
+};
+
+}  // End index namespace
+}  // End peloton namespace
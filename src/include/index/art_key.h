@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art_key.h
+//
+// Identification: src/include/index/art_key.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+
+#include "storage/tuple.h"
+#include "type/varlen_pool.h"
+
+namespace peloton {
+namespace index {
+
+/*
+ * class ArtKey - Binary-comparable encoding of a key tuple
+ *
+ * The columns of the key schema are encoded one after another, such that
+ * comparing two encoded keys byte by byte (memcmp order) gives the same
+ * result as comparing the key tuples column by column:
+ *
+ *   - Integers and booleans are stored big-endian with the sign bit flipped
+ *   - Timestamps are stored big-endian
+ *   - Doubles get the sign bit flipped if they are positive and all bits
+ *     flipped if they are negative, then are stored big-endian
+ *   - Varchars and varbinaries are a 0x00 byte if they are NULL, otherwise a
+ *     0x01 byte followed by their bytes with every 0x00 escaped as 0x00 0xFF,
+ *     terminated by 0x00 0x00
+ *
+ * Every column is self-delimiting, so no encoded key is a prefix of another,
+ * which the radix tree relies on.
+ */
+class ArtKey {
+ public:
+  // Encodes the key tuple
+  void SetFromKey(const storage::Tuple *tuple);
+
+  // Encodes the high key of a range scan. The scan optimizer fills the
+  // columns without an upper bound with the max value of their type, which
+  // is the NULL value for varchars. Such a column is encoded as a single
+  // 0xFF byte that sorts after every key, and ends the encoding.
+  void SetFromHighKey(const storage::Tuple *tuple);
+
+  // Decodes an encoded key into the columns of tuple, which has the key
+  // schema. Varlen values that do not fit the tuple go into pool
+  static void GetTuple(const std::string &key_data, storage::Tuple &tuple,
+                       type::VarlenPool *pool);
+
+  const std::string &GetData() const { return key_data; }
+
+ private:
+  void Encode(const storage::Tuple *tuple, const bool high_key);
+
+  std::string key_data;
+};
+
+}  // End index namespace
+}  // End peloton namespace
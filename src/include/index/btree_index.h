@@ -60,10 +60,22 @@ class BTreeIndex : public Index {
             std::vector<ValueType> &result,
             const ConjunctionScanPredicate *csp_p);
 
+  bool ScanKeyColumns(const std::vector<type::Value> &value_list,
+                      const std::vector<oid_t> &tuple_column_id_list,
+                      const std::vector<ExpressionType> &expr_list,
+                      const ScanDirectionType &scan_direction,
+                      const ConjunctionScanPredicate *csp_p,
+                      const std::vector<oid_t> &key_columns,
+                      std::vector<ValueType> &result,
+                      std::vector<type::Value> &key_values);
+
   void ScanAllKeys(std::vector<ValueType> &result);
 
   void ScanKey(const storage::Tuple *key, std::vector<ValueType> &result);
 
+  void ScanBatch(const std::vector<const storage::Tuple *> &keys,
+                 std::vector<std::vector<ValueType>> &results);
+
   std::string GetTypeName() const;
 
   bool Cleanup() { return true; }
@@ -79,6 +91,17 @@ class BTreeIndex : public Index {
   }
 
  protected:
+  // Scan() that also calls key_callback(key, value_count) with the key of
+  // the last value_count values it appended to result
+  template <typename KeyCallback>
+  void ScanEntries(const std::vector<type::Value> &value_list,
+                   const std::vector<oid_t> &tuple_column_id_list,
+                   const std::vector<ExpressionType> &expr_list,
+                   const ScanDirectionType &scan_direction,
+                   std::vector<ValueType> &result,
+                   const ConjunctionScanPredicate *csp_p,
+                   KeyCallback key_callback);
+
   MapType container;
 
   // equality checker and comparator
@@ -133,16 +133,23 @@ static void dummy(const char*, ...) {}
 #define MAPPING_TABLE_SIZE ((size_t)(1 << 20))
 
 // If the length of delta chain exceeds ( >= ) this then we consolidate the node
+// These are the defaults, see SetConsolidationThreshold()
 #define INNER_DELTA_CHAIN_LENGTH_THRESHOLD ((int)8)
 #define LEAF_DELTA_CHAIN_LENGTH_THRESHOLD ((int)8)
 
 // If node size goes above this then we split it
+// The upper thresholds are the defaults, see SetSplitThreshold()
 #define INNER_NODE_SIZE_UPPER_THRESHOLD ((int)128)
 #define INNER_NODE_SIZE_LOWER_THRESHOLD ((int)32)
 
 #define LEAF_NODE_SIZE_UPPER_THRESHOLD ((int)128)
 #define LEAF_NODE_SIZE_LOWER_THRESHOLD ((int)32)
 
+// Bulk loaded nodes are filled up to this size, which leaves some room
+// for inserts before they have to split
+#define INNER_NODE_BULK_LOAD_SIZE ((int)96)
+#define LEAF_NODE_BULK_LOAD_SIZE ((int)96)
+
 /*
  * class BwTree - Lock-free BwTree index implementation
  *
@@ -1744,6 +1751,15 @@ class BwTree {
       update_op_count{0},
       update_abort_count{0},
 
+      // Tuning knobs start with the compiled in values
+      leaf_delta_chain_length_threshold{LEAF_DELTA_CHAIN_LENGTH_THRESHOLD},
+      inner_delta_chain_length_threshold{INNER_DELTA_CHAIN_LENGTH_THRESHOLD},
+      leaf_node_size_upper_threshold{LEAF_NODE_SIZE_UPPER_THRESHOLD},
+      inner_node_size_upper_threshold{INNER_NODE_SIZE_UPPER_THRESHOLD},
+
+      consolidation_count{0},
+      split_count{0},
+
       // Epoch Manager that does garbage collection
       epoch_manager{this} {
     bwt_printf("Bw-Tree Constructor called. "
@@ -4993,6 +5009,7 @@ before_switch:
 
     if(ret == true) {
       epoch_manager.AddGarbageNode(snapshot_p->node_p);
+      consolidation_count.fetch_add(1, std::memory_order_relaxed);
 
       snapshot_p->node_p = leaf_node_p;
     } else {
@@ -5018,6 +5035,7 @@ before_switch:
 
     if(ret == true) {
       epoch_manager.AddGarbageNode(snapshot_p->node_p);
+      consolidation_count.fetch_add(1, std::memory_order_relaxed);
 
       snapshot_p->node_p = inner_node_p;
     } else {
@@ -5090,11 +5108,13 @@ before_switch:
     int depth = node_p->GetDepth();
 
     if(snapshot_p->IsLeaf() == true) {
-      if(depth < LEAF_DELTA_CHAIN_LENGTH_THRESHOLD) {
+      if(depth < leaf_delta_chain_length_threshold.load(
+                   std::memory_order_relaxed)) {
         return;
       }
     } else {
-      if(depth < INNER_DELTA_CHAIN_LENGTH_THRESHOLD) {
+      if(depth < inner_delta_chain_length_threshold.load(
+                   std::memory_order_relaxed)) {
         return;
       }
     }
@@ -5148,7 +5168,8 @@ before_switch:
       size_t node_size = leaf_node_p->GetItemCount();
 
       // Perform corresponding action based on node size
-      if(node_size >= LEAF_NODE_SIZE_UPPER_THRESHOLD) {
+      if(static_cast<int>(node_size) >= leaf_node_size_upper_threshold.load(
+                                          std::memory_order_relaxed)) {
         bwt_printf("Node size >= leaf upper threshold. Split\n");
 
         // Note: This function takes this as argument since it will
@@ -5202,6 +5223,8 @@ before_switch:
                      node_id,
                      new_node_id);
 
+          split_count.fetch_add(1, std::memory_order_relaxed);
+
           // TODO: WE ABORT HERE TO AVOID THIS THREAD POSTING ANYTHING
           // ON TOP OF IT WITHOUT HELPING ALONG AND ALSO BLOCKING OTHER
           // THREAD TO HELP ALONG
@@ -5298,7 +5321,8 @@ before_switch:
 
       size_t node_size = inner_node_p->sep_list.size();
 
-      if(node_size >= INNER_NODE_SIZE_UPPER_THRESHOLD) {
+      if(static_cast<int>(node_size) >= inner_node_size_upper_threshold.load(
+                                          std::memory_order_relaxed)) {
         bwt_printf("Node size >= inner upper threshold. Split\n");
 
         const InnerNode *new_inner_node_p = inner_node_p->GetSplitSibling();
@@ -5354,6 +5378,8 @@ before_switch:
           bwt_printf("Inner split delta (from %lu to %lu) CAS succeeds."
                      " ABORT\n", node_id, new_node_id);
 
+          split_count.fetch_add(1, std::memory_order_relaxed);
+
           // Same reason as in leaf node
           context_p->abort_flag = true;
 
@@ -6383,6 +6409,157 @@ before_switch:
     return value_set;
   }
   
+  ///////////////////////////////////////////////////////////////////
+  // Bulk Load Interface
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * IsEmpty() - Whether the tree still has its initial layout, i.e. a
+   *             single root with an empty first leaf below it
+   */
+  bool IsEmpty() {
+    const BaseNode *root_node_p = GetNode(root_id.load());
+    const BaseNode *leaf_node_p = GetNode(first_leaf_id);
+
+    return (root_node_p->GetType() == NodeType::InnerType) &&
+           (root_node_p->GetItemCount() == 1) &&
+           (leaf_node_p->GetType() == NodeType::LeafType) &&
+           (leaf_node_p->GetItemCount() == 0) &&
+           (leaf_node_p->GetNextNodeID() == INVALID_NODE_ID);
+  }
+
+  /*
+   * BulkLoad() - Build the tree bottom up from key-value pairs
+   *
+   * The items must be sorted by key and must not contain the same
+   * key-value pair twice. Leaf nodes are filled with
+   * LEAF_NODE_BULK_LOAD_SIZE items (more if the last key goes on, since
+   * a key never spreads over two leaves) and inner nodes with at most
+   * INNER_NODE_BULK_LOAD_SIZE separators, level by level, and installed
+   * without any delta record.
+   *
+   * This only works on an empty tree, otherwise false is returned. The
+   * caller must make sure no other thread uses the tree meanwhile, since
+   * the initial nodes are freed without going through the epoch manager.
+   */
+  bool BulkLoad(const std::vector<KeyValuePair> &sorted_items) {
+    if(IsEmpty() == false) {
+      return false;
+    }
+
+    if(sorted_items.size() == 0) {
+      return true;
+    }
+
+    // The first leaf keeps its NodeID since iterators start from there,
+    // and the root NodeID goes to the new root
+    NodeID old_root_id = root_id.load();
+    FreeNodeByNodeID(old_root_id);
+
+    // Leaf i holds the items in [leaf_start_list[i], leaf_start_list[i + 1])
+    std::vector<size_t> leaf_start_list{};
+    size_t item_index = 0;
+    while(item_index < sorted_items.size()) {
+      leaf_start_list.push_back(item_index);
+
+      item_index = std::min(item_index + LEAF_NODE_BULK_LOAD_SIZE,
+                            sorted_items.size());
+      while((item_index < sorted_items.size()) && \
+            (KeyCmpEqual(sorted_items[item_index - 1].first,
+                         sorted_items[item_index].first) == true)) {
+        item_index++;
+      }
+    }
+    leaf_start_list.push_back(sorted_items.size());
+
+    size_t leaf_count = leaf_start_list.size() - 1;
+    std::vector<NodeID> leaf_id_list{first_leaf_id};
+    for(size_t leaf_index = 1; leaf_index < leaf_count; leaf_index++) {
+      leaf_id_list.push_back(GetNextNodeID());
+    }
+
+    // Low key - NodeID pairs of the nodes on the level built last
+    // The first one stands for -Inf and its key is never looked at
+    std::vector<KeyNodeIDPair> level_list{};
+    level_list.reserve(leaf_count);
+
+    for(size_t leaf_index = 0; leaf_index < leaf_count; leaf_index++) {
+      auto copy_start_it = sorted_items.begin() + leaf_start_list[leaf_index];
+      auto copy_end_it = sorted_items.begin() + leaf_start_list[leaf_index + 1];
+
+      KeyNodeIDPair low_key_pair = \
+        std::make_pair(leaf_index == 0 ? KeyType() : copy_start_it->first,
+                       INVALID_NODE_ID);
+      KeyNodeIDPair high_key_pair = \
+        (leaf_index + 1 == leaf_count) ? \
+          std::make_pair(KeyType(), INVALID_NODE_ID) : \
+          std::make_pair(copy_end_it->first, leaf_id_list[leaf_index + 1]);
+
+      LeafNode *leaf_node_p = \
+        new LeafNode{low_key_pair,
+                     high_key_pair,
+                     static_cast<int>(std::distance(copy_start_it,
+                                                    copy_end_it))};
+      leaf_node_p->data_list.assign(copy_start_it, copy_end_it);
+
+      InstallNewNode(leaf_id_list[leaf_index], leaf_node_p);
+      level_list.push_back(std::make_pair(low_key_pair.first,
+                                          leaf_id_list[leaf_index]));
+    }
+
+    // There is always at least one inner level, just like the initial layout
+    size_t height = 1;
+    do {
+      // Spread the separators evenly instead of leaving a tiny last node
+      size_t node_count = (level_list.size() + INNER_NODE_BULK_LOAD_SIZE - 1) / \
+                          INNER_NODE_BULK_LOAD_SIZE;
+
+      std::vector<NodeID> node_id_list{};
+      for(size_t node_index = 0; node_index < node_count; node_index++) {
+        node_id_list.push_back(node_count == 1 ? old_root_id : GetNextNodeID());
+      }
+
+      std::vector<KeyNodeIDPair> parent_level_list{};
+      parent_level_list.reserve(node_count);
+
+      for(size_t node_index = 0; node_index < node_count; node_index++) {
+        auto copy_start_it = level_list.begin() + \
+                             node_index * level_list.size() / node_count;
+        auto copy_end_it = level_list.begin() + \
+                           (node_index + 1) * level_list.size() / node_count;
+
+        KeyNodeIDPair high_key_pair = \
+          (node_index + 1 == node_count) ? \
+            std::make_pair(KeyType(), INVALID_NODE_ID) : \
+            std::make_pair(copy_end_it->first, node_id_list[node_index + 1]);
+
+        // Storage is reserved in the constructor, so assign() does not
+        // reallocate and the low key pointer stays valid
+        InnerNode *inner_node_p = \
+          new InnerNode{high_key_pair,
+                        static_cast<int>(std::distance(copy_start_it,
+                                                       copy_end_it))};
+        inner_node_p->sep_list.assign(copy_start_it, copy_end_it);
+
+        InstallNewNode(node_id_list[node_index], inner_node_p);
+        parent_level_list.push_back(std::make_pair(copy_start_it->first,
+                                                   node_id_list[node_index]));
+      }
+
+      level_list.swap(parent_level_list);
+      height++;
+    } while(level_list.size() > 1);
+
+    tree_height = height;
+
+    bwt_printf("Bulk loaded %lu items into %lu leaves. Height = %lu\n",
+               sorted_items.size(),
+               leaf_count,
+               height);
+
+    return true;
+  }
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection Interface
   ///////////////////////////////////////////////////////////////////
@@ -6419,6 +6596,118 @@ before_switch:
     return;
   }
 
+  ///////////////////////////////////////////////////////////////////
+  // Structure Statistics and Tuning Interface
+  ///////////////////////////////////////////////////////////////////
+
+  /*
+   * struct StructureStats - The shape of the tree at some point of time
+   *
+   * Consolidations and splits are counted since the tree was built, so
+   * that callers could compute rates from two snapshots
+   */
+  struct StructureStats {
+    // Number of logical nodes (NodeIDs in use)
+    size_t node_count;
+
+    // Sum of the delta chain lengths of all nodes
+    size_t delta_record_count;
+
+    // Estimated size of the garbage waiting for the epoch to pass
+    size_t garbage_byte_count;
+
+    uint64_t consolidation_count;
+    uint64_t split_count;
+  };
+
+  /*
+   * GetStructureStats() - Walks the mapping table and collects statistics
+   *
+   * This runs concurrently with modifications, so the numbers are only a
+   * close approximation. The thread joins an epoch to keep the delta
+   * chains it reads from being freed
+   */
+  void GetStructureStats(StructureStats *stats_p) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    stats_p->node_count = 0UL;
+    stats_p->delta_record_count = 0UL;
+
+    NodeID end_node_id = next_unused_node_id.load();
+    for(NodeID node_id = 1; node_id < end_node_id; node_id++) {
+      const BaseNode *node_p = mapping_table[node_id].load();
+
+      // Removed nodes are on their way to be recycled
+      if((node_p == nullptr) || (node_p->IsRemoveNode() == true)) {
+        continue;
+      }
+
+      stats_p->node_count++;
+      stats_p->delta_record_count += node_p->GetDepth();
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    stats_p->garbage_byte_count = epoch_manager.GetGarbageByteCount();
+    stats_p->consolidation_count = consolidation_count.load();
+    stats_p->split_count = split_count.load();
+
+    return;
+  }
+
+  /*
+   * SetConsolidationThreshold() - Set the delta chain length at which
+   *                               leaf and inner nodes are consolidated
+   *
+   * Longer chains make writes cheaper and reads slower. Returns false
+   * without changing anything if a threshold is not positive
+   */
+  bool SetConsolidationThreshold(int leaf_threshold, int inner_threshold) {
+    if((leaf_threshold < 1) || (inner_threshold < 1)) {
+      return false;
+    }
+
+    leaf_delta_chain_length_threshold.store(leaf_threshold);
+    inner_delta_chain_length_threshold.store(inner_threshold);
+
+    return true;
+  }
+
+  /*
+   * SetSplitThreshold() - Set the size at which leaf and inner nodes split
+   *
+   * Both halves of a split node must be above the merge threshold, since
+   * they would be merged back right away otherwise. Returns false without
+   * changing anything if a threshold is too small for that
+   */
+  bool SetSplitThreshold(int leaf_threshold, int inner_threshold) {
+    if((leaf_threshold < 2 * (LEAF_NODE_SIZE_LOWER_THRESHOLD + 1)) ||
+       (inner_threshold < 2 * (INNER_NODE_SIZE_LOWER_THRESHOLD + 1))) {
+      return false;
+    }
+
+    leaf_node_size_upper_threshold.store(leaf_threshold);
+    inner_node_size_upper_threshold.store(inner_threshold);
+
+    return true;
+  }
+
+  inline int GetLeafConsolidationThreshold() const {
+    return leaf_delta_chain_length_threshold.load();
+  }
+
+  inline int GetInnerConsolidationThreshold() const {
+    return inner_delta_chain_length_threshold.load();
+  }
+
+  inline int GetLeafSplitThreshold() const {
+    return leaf_node_size_upper_threshold.load();
+  }
+
+  inline int GetInnerSplitThreshold() const {
+    return inner_node_size_upper_threshold.load();
+  }
+
  /*
   * Private Method Implementation
   */
@@ -6487,6 +6776,18 @@ before_switch:
   std::atomic<uint64_t> update_op_count;
   std::atomic<uint64_t> update_abort_count;
 
+  // Delta chain lengths that trigger consolidation
+  std::atomic<int> leaf_delta_chain_length_threshold;
+  std::atomic<int> inner_delta_chain_length_threshold;
+
+  // Node sizes that trigger a split
+  std::atomic<int> leaf_node_size_upper_threshold;
+  std::atomic<int> inner_node_size_upper_threshold;
+
+  // Successfully installed structure modifications
+  std::atomic<uint64_t> consolidation_count;
+  std::atomic<uint64_t> split_count;
+
   //InteractiveDebugger idb;
 
   EpochManager epoch_manager;
@@ -6512,6 +6813,9 @@ before_switch:
     struct GarbageNode {
       const BaseNode *node_p;
 
+      // Estimated size of the delta chain, see GetDeltaChainByteCount()
+      size_t byte_count;
+
       // This does not have to be atomic, since we only
       // insert at the head of garbage list
       GarbageNode *next_p;
@@ -6558,6 +6862,9 @@ before_switch:
     // Otherwise it points to a thread created by EpochManager internally
     std::thread *thread_p;
 
+    // Estimated size of the garbage not freed yet in all epochs
+    std::atomic<size_t> garbage_byte_count;
+
     // The counter that counts how many free is called
     // inside the epoch manager
     // NOTE: We cannot precisely count the size of memory freed
@@ -6604,6 +6911,8 @@ before_switch:
       // This is used to notify the cleaner thread that it has ended
       exited_flag.store(false);
 
+      garbage_byte_count.store(0UL);
+
       // Initialize atomic counter to record how many
       // freed has been called inside epoch manager
       #ifdef BWTREE_DEBUG
@@ -6758,6 +7067,10 @@ before_switch:
       // These two could be predetermined
       GarbageNode *garbage_node_p = new GarbageNode;
       garbage_node_p->node_p = node_p;
+      garbage_node_p->byte_count = GetDeltaChainByteCount(node_p);
+
+      garbage_byte_count.fetch_add(garbage_node_p->byte_count,
+                                   std::memory_order_relaxed);
 
       garbage_node_p->next_p = epoch_p->garbage_list_p.load();
 
@@ -7014,6 +7327,84 @@ try_join_again:
       return;
     }
 
+    /*
+     * GetDeltaChainByteCount() - Estimate the memory FreeEpochDeltaChain()
+     *                            frees for a delta chain
+     *
+     * This follows the same nodes as FreeEpochDeltaChain(). Base nodes are
+     * counted with the capacity of their arrays, but memory owned by the
+     * keys themselves is not
+     */
+    size_t GetDeltaChainByteCount(const BaseNode *node_p) const {
+      size_t byte_count = 0UL;
+
+      while(1) {
+        assert(node_p != nullptr);
+
+        switch(node_p->GetType()) {
+          case NodeType::LeafInsertType:
+            byte_count += sizeof(LeafInsertNode);
+            node_p = ((const LeafInsertNode *)node_p)->child_node_p;
+            break;
+          case NodeType::LeafDeleteType:
+            byte_count += sizeof(LeafDeleteNode);
+            node_p = ((const LeafDeleteNode *)node_p)->child_node_p;
+            break;
+          case NodeType::LeafSplitType:
+            byte_count += sizeof(LeafSplitNode);
+            node_p = ((const LeafSplitNode *)node_p)->child_node_p;
+            break;
+          case NodeType::LeafMergeType:
+            return byte_count + sizeof(LeafMergeNode) + \
+                   GetDeltaChainByteCount(
+                     ((const LeafMergeNode *)node_p)->child_node_p) + \
+                   GetDeltaChainByteCount(
+                     ((const LeafMergeNode *)node_p)->right_merge_p);
+          case NodeType::LeafRemoveType:
+            return byte_count + sizeof(LeafRemoveNode);
+          case NodeType::LeafType:
+            return byte_count + sizeof(LeafNode) + \
+                   ((const LeafNode *)node_p)->data_list.capacity() * \
+                     sizeof(KeyValuePair);
+          case NodeType::InnerInsertType:
+            byte_count += sizeof(InnerInsertNode);
+            node_p = ((const InnerInsertNode *)node_p)->child_node_p;
+            break;
+          case NodeType::InnerDeleteType:
+            byte_count += sizeof(InnerDeleteNode);
+            node_p = ((const InnerDeleteNode *)node_p)->child_node_p;
+            break;
+          case NodeType::InnerSplitType:
+            byte_count += sizeof(InnerSplitNode);
+            node_p = ((const InnerSplitNode *)node_p)->child_node_p;
+            break;
+          case NodeType::InnerMergeType:
+            return byte_count + sizeof(InnerMergeNode) + \
+                   GetDeltaChainByteCount(
+                     ((const InnerMergeNode *)node_p)->child_node_p) + \
+                   GetDeltaChainByteCount(
+                     ((const InnerMergeNode *)node_p)->right_merge_p);
+          case NodeType::InnerRemoveType:
+            return byte_count + sizeof(InnerRemoveNode);
+          case NodeType::InnerType:
+            return byte_count + sizeof(InnerNode) + \
+                   ((const InnerNode *)node_p)->sep_list.capacity() * \
+                     sizeof(KeyNodeIDPair);
+          case NodeType::InnerAbortType:
+            return byte_count + sizeof(InnerAbortNode);
+          default:
+            assert(false);
+            return byte_count;
+        } // switch
+      } // while 1
+
+      return byte_count;
+    }
+
+    inline size_t GetGarbageByteCount() const {
+      return garbage_byte_count.load();
+    }
+
     /*
      * ClearEpoch() - Sweep the chain of epoch and free memory
      *
@@ -7078,6 +7469,9 @@ try_join_again:
             garbage_node_p = next_garbage_node_p) {
           FreeEpochDeltaChain(garbage_node_p->node_p);
 
+          garbage_byte_count.fetch_sub(garbage_node_p->byte_count,
+                                       std::memory_order_relaxed);
+
           // Save the next pointer so that we could
           // delete current node directly
           next_garbage_node_p = garbage_node_p->next_p;
@@ -7158,6 +7552,121 @@ try_join_again:
 
   }; // Epoch manager
 
+  /*
+   * LocateLeafBackward() - Find the leaf node that holds the keys right
+   *                        before a given key
+   *
+   * If inclusive is true this goes to the leaf whose range contains *key_p,
+   * just like Traverse(). Otherwise it goes to the leaf whose range contains
+   * the keys just smaller than *key_p, i.e. low key < *key_p <= high key.
+   * If key_p is nullptr then the last leaf of the tree is returned. The
+   * NodeID of the leaf is stored into *node_id_p.
+   *
+   * This is used by the iterator to move backward, since leaf nodes only
+   * know their right sibling. Inner nodes with a delta chain are consolidated
+   * on the way and the consolidated node goes to the garbage list at once,
+   * since no other thread could see it.
+   *
+   * Like the read optimized traversal, we do not help along SMOs. If a remove
+   * delta is observed, or the leaf does not start before the key because
+   * of a concurrent SMO, nullptr is returned and the caller should retry
+   *
+   * NOTE: The caller must have joined the epoch
+   */
+  const BaseNode *LocateLeafBackward(const KeyType *key_p,
+                                     bool inclusive,
+                                     NodeID *node_id_p) {
+    NodeID node_id = root_id.load();
+
+    while(1) {
+      const BaseNode *node_p = GetNode(node_id);
+
+      // Abort node does not change the content of the node
+      while(node_p->GetType() == NodeType::InnerAbortType) {
+        node_p = static_cast<const DeltaNode *>(node_p)->child_node_p;
+      }
+
+      NodeType type = node_p->GetType();
+      if((type == NodeType::LeafRemoveType) || \
+         (type == NodeType::InnerRemoveType)) {
+        bwt_printf("Observed remove node (backward); retry\n");
+
+        return nullptr;
+      }
+
+      // If the keys we are looking for have been split to the right
+      // sibling then go right
+      if(node_p->GetNextNodeID() != INVALID_NODE_ID) {
+        bool go_right = true;
+
+        if(key_p != nullptr) {
+          go_right = inclusive ? \
+            (KeyCmpLess(*key_p, node_p->GetHighKey()) == false) : \
+            KeyCmpLess(node_p->GetHighKey(), *key_p);
+        }
+
+        if(go_right == true) {
+          node_id = node_p->GetNextNodeID();
+
+          continue;
+        }
+      }
+
+      if(node_p->IsOnLeafDeltaChain() == true) {
+        // The first leaf is always the left most one and starts at -Inf
+        if((node_id != first_leaf_id) && (key_p != nullptr)) {
+          bool before_key = inclusive ? \
+            (KeyCmpLess(*key_p, node_p->GetLowKey()) == false) : \
+            KeyCmpLess(node_p->GetLowKey(), *key_p);
+
+          if(before_key == false) {
+            bwt_printf("Leaf does not start before the key; retry\n");
+
+            return nullptr;
+          }
+        }
+
+        *node_id_p = node_id;
+
+        return node_p;
+      }
+
+      const InnerNode *inner_node_p = static_cast<const InnerNode *>(node_p);
+
+      if(type != NodeType::InnerType) {
+        NodeSnapshot snapshot{node_id, node_p};
+
+        InnerNode *consolidated_node_p = \
+          CollectAllSepsOnInner(&snapshot, node_p->GetDepth() + 1);
+
+        epoch_manager.AddGarbageNode(consolidated_node_p);
+
+        inner_node_p = consolidated_node_p;
+      }
+
+      if(key_p == nullptr) {
+        node_id = inner_node_p->sep_list.back().second;
+      } else {
+        // The low key of the node is not compared since it might be -Inf,
+        // and the first element is chosen if all separators are after the key
+        auto sep_it = inclusive ? \
+          std::upper_bound(inner_node_p->sep_list.begin() + 1,
+                           inner_node_p->sep_list.end(),
+                           std::make_pair(*key_p, INVALID_NODE_ID),
+                           key_node_id_pair_cmp_obj) : \
+          std::lower_bound(inner_node_p->sep_list.begin() + 1,
+                           inner_node_p->sep_list.end(),
+                           std::make_pair(*key_p, INVALID_NODE_ID),
+                           key_node_id_pair_cmp_obj);
+
+        node_id = (sep_it - 1)->second;
+      }
+    }
+
+    assert(false);
+    return nullptr;
+  }
+
   /*
    * Iterator Interface
    */
@@ -7185,6 +7694,26 @@ try_join_again:
     return ForwardIterator{this, start_key};
   }
 
+  /*
+   * RBegin() - Return an iterator pointing to the last element in the tree
+   *
+   * The iterator is meant to be moved backward with operator--. If the tree
+   * is empty then the iterator is an end iterator
+   */
+  ForwardIterator RBegin() {
+    return ForwardIterator{this, nullptr};
+  }
+
+  /*
+   * RBegin() - Return an iterator pointing to the last element whose key is
+   *            less than or equal to the given end key
+   *
+   * If there is no such key then the iterator is an end iterator
+   */
+  ForwardIterator RBegin(const KeyType &end_key) {
+    return ForwardIterator{this, &end_key};
+  }
+
   /*
    * NullIterator() - Returns an empty iterator that cannot do anything
    *
@@ -7246,6 +7775,9 @@ try_join_again:
       // Use the high key of current node as the next key locking
       next_key_pair = node_p->GetHighKeyPair();
 
+      // There is nothing before the first leaf
+      prev_key_pair = std::make_pair(node_p->GetLowKey(), INVALID_NODE_ID);
+
       NodeSnapshot snapshot{FIRST_LEAF_NODE_ID, node_p};
 
       // Consolidate the current node (this does not change high key)
@@ -7286,6 +7818,25 @@ try_join_again:
       return;
     }
 
+    /*
+     * Constructor - Construct an iterator for backward iteration
+     *
+     * The iterator is located on the last data item whose key is <= the
+     * given end key, or on the last data item of the tree if end_key_p is
+     * nullptr. This is useful for descending range query
+     */
+    ForwardIterator(BwTree *p_tree_p,
+                    const KeyType *end_key_p) :
+      tree_p{p_tree_p},
+      leaf_node_p{nullptr}, // This is used to singal UpperBound() that
+                            // no memory should be freed
+      is_end{false} {
+
+      UpperBound(end_key_p, true);
+
+      return;
+    }
+
     /*
      * Copy Constructor - Constructs a new iterator instance from existing one
      *
@@ -7298,6 +7849,7 @@ try_join_again:
       // This copy constructs all members recursively by default
       leaf_node_p{new LeafNode{*other.leaf_node_p}},
       next_key_pair{other.next_key_pair},
+      prev_key_pair{other.prev_key_pair},
       is_end{other.is_end} {
 
       // Move the iterator ahead
@@ -7336,6 +7888,7 @@ try_join_again:
       // Copy everything that could be copied
       tree_p = other.tree_p;
       next_key_pair = other.next_key_pair;
+      prev_key_pair = other.prev_key_pair;
 
       is_end = other.is_end;
 
@@ -7372,6 +7925,7 @@ try_join_again:
 
       tree_p = other.tree_p;
       next_key_pair = other.next_key_pair;
+      prev_key_pair = other.prev_key_pair;
 
       is_end = other.is_end;
 
@@ -7506,6 +8060,42 @@ try_join_again:
       return temp;
     }
 
+    /*
+     * Prefix operator-- - Move the iterator backward and return the new
+     *                     iterator
+     *
+     * If the iterator moves before the first element then it becomes an
+     * end() iterator, since that is where a backward iteration ends. If the
+     * iterator is end() iterator then we do nothing
+     */
+    inline ForwardIterator &operator--() {
+      if(is_end == true) {
+        return *this;
+      }
+
+      MoveBackByOne();
+
+      return *this;
+    }
+
+    /*
+     * Postfix operator-- - Move the iterator backward, and return the old one
+     *
+     * For end() iterator we do not do anything but return the same iterator
+     */
+    inline ForwardIterator operator--(int) {
+      if(is_end == true) {
+        return *this;
+      }
+
+      // Make a copy of the current one before moving
+      ForwardIterator temp = *this;
+
+      MoveBackByOne();
+
+      return temp;
+    }
+
     /*
      * IsEnd() - Returns true if we have reached the end of iteration
      *
@@ -7539,6 +8129,11 @@ try_join_again:
     // node into the iterator
     KeyNodeIDPair next_key_pair;
 
+    // The low key of current logical leaf node, used to access the previous
+    // leaf node in the same way as next_key_pair. The NodeID is
+    // INVALID_NODE_ID if this is the first leaf node
+    KeyNodeIDPair prev_key_pair;
+
     // This is the actual iterator
     typename std::vector<KeyValuePair>::const_iterator it;
 
@@ -7610,6 +8205,13 @@ try_join_again:
         // Set high key pair for next call of this function
         next_key_pair = node_p->GetHighKeyPair();
 
+        // The first leaf never goes away, since merge always removes
+        // the right one of two nodes
+        prev_key_pair = \
+          std::make_pair(node_p->GetLowKey(),
+                         snapshot_p->node_id == tree_p->first_leaf_id ? \
+                           INVALID_NODE_ID : snapshot_p->node_id);
+
         // If this is nullptr then we are calling it from the constructor
         if(leaf_node_p != nullptr) {
           // Only we call it from the constructor will the start key pointer
@@ -7673,6 +8275,114 @@ try_join_again:
 
       return;
     }
+
+    /*
+     * UpperBound() - Load leaf page that has the last key <= end key (or
+     *                < end key if inclusive is false)
+     *
+     * This is the counterpart of LowerBound() for backward iteration. The
+     * iterator is left on that key. If all keys in the leaf page are after
+     * the end key then we go on with the keys before the low key of the
+     * page, until the first leaf page is reached and is_end is set.
+     *
+     * If end_key_p is nullptr then the last key in the tree is loaded
+     */
+    void UpperBound(const KeyType *end_key_p, bool inclusive) {
+      assert(is_end == false);
+
+      while(1) {
+        EpochNode *epoch_node_p = tree_p->epoch_manager.JoinEpoch();
+
+        NodeID node_id = INVALID_NODE_ID;
+        const BaseNode *node_p = \
+          tree_p->LocateLeafBackward(end_key_p, inclusive, &node_id);
+
+        // The tree is going through an SMO, retry
+        if(node_p == nullptr) {
+          tree_p->epoch_manager.LeaveEpoch(epoch_node_p);
+
+          continue;
+        }
+
+        if(leaf_node_p != nullptr) {
+          delete leaf_node_p;
+        }
+
+        NodeSnapshot snapshot{node_id, node_p};
+        leaf_node_p = tree_p->CollectAllValuesOnLeaf(&snapshot);
+
+        tree_p->epoch_manager.LeaveEpoch(epoch_node_p);
+
+        if(end_key_p == nullptr) {
+          it = leaf_node_p->data_list.end();
+        } else if(inclusive == true) {
+          it = std::upper_bound(leaf_node_p->data_list.begin(),
+                                leaf_node_p->data_list.end(),
+                                std::make_pair(*end_key_p, ValueType{}),
+                                this->tree_p->key_value_pair_cmp_obj);
+        } else {
+          it = std::lower_bound(leaf_node_p->data_list.begin(),
+                                leaf_node_p->data_list.end(),
+                                std::make_pair(*end_key_p, ValueType{}),
+                                this->tree_p->key_value_pair_cmp_obj);
+        }
+
+        // end_key_p might point to prev_key_pair, so only change it after
+        // we are done with the end key
+        next_key_pair = leaf_node_p->GetHighKeyPair();
+        prev_key_pair = \
+          std::make_pair(leaf_node_p->GetLowKey(),
+                         node_id == tree_p->first_leaf_id ? \
+                           INVALID_NODE_ID : node_id);
+
+        if(it != leaf_node_p->data_list.begin()) {
+          it--;
+
+          return;
+        }
+
+        // All keys in the leaf page are after the end key. Go on with the
+        // keys before the low key of the page
+        if(prev_key_pair.second == INVALID_NODE_ID) {
+          is_end = true;
+
+          return;
+        }
+
+        end_key_p = &prev_key_pair.first;
+        inclusive = false;
+      } // while(1)
+
+      assert(false);
+      return;
+    }
+
+    /*
+     * MoveBackByOne() - Move the iterator backward by one
+     *
+     * If the iterator is on the first element of the current leaf page then
+     * the page before the low key is loaded, which might set is_end
+     */
+    inline void MoveBackByOne() {
+      // Could not do this on an empty iterator
+      assert(leaf_node_p != nullptr);
+
+      if(it != leaf_node_p->data_list.begin()) {
+        it--;
+
+        return;
+      }
+
+      if(prev_key_pair.second == INVALID_NODE_ID) {
+        is_end = true;
+
+        return;
+      }
+
+      UpperBound(&prev_key_pair.first, false);
+
+      return;
+    }
   }; // ForwardIterator
 
 }; // class BwTree
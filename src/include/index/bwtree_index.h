@@ -23,6 +23,9 @@
 
 #include "index/bwtree.h"
 
+// Bulk loads sort this many entries per thread at least
+#define BULK_LOAD_CHUNK_SIZE ((size_t)4096)
+
 #define BWTREE_INDEX_TYPE BWTreeIndex <KeyType, \
                                        ValueType, \
                                        KeyComparator, \
@@ -95,6 +98,11 @@ class BWTreeIndex : public Index {
                        ItemPointer *value,
                        std::function<bool(const void *)> predicate);
 
+  size_t BulkInsertEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+          entries,
+      const bool exclusive_access);
+
   void Scan(const std::vector<type::Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -102,11 +110,31 @@ class BWTreeIndex : public Index {
             std::vector<ValueType> &result,
             const ConjunctionScanPredicate *csp_p);
 
+  bool ScanKeyColumns(const std::vector<type::Value> &value_list,
+                      const std::vector<oid_t> &tuple_column_id_list,
+                      const std::vector<ExpressionType> &expr_list,
+                      const ScanDirectionType &scan_direction,
+                      const ConjunctionScanPredicate *csp_p,
+                      const std::vector<oid_t> &key_columns,
+                      std::vector<ValueType> &result,
+                      std::vector<type::Value> &key_values);
+
+  bool ScanLimit(const std::vector<type::Value> &value_list,
+                 const std::vector<oid_t> &tuple_column_id_list,
+                 const std::vector<ExpressionType> &expr_list,
+                 const ScanDirectionType &scan_direction,
+                 std::vector<ValueType> &result,
+                 const ConjunctionScanPredicate *csp_p, const uint64_t limit,
+                 std::vector<type::Value> *key_values);
+
   void ScanAllKeys(std::vector<ValueType> &result);
 
   void ScanKey(const storage::Tuple *key,
                std::vector<ValueType> &result);
 
+  void ScanBatch(const std::vector<const storage::Tuple *> &keys,
+                 std::vector<std::vector<ValueType>> &results);
+
   std::string GetTypeName() const;
 
   // TODO: Implement this
@@ -125,7 +153,26 @@ class BWTreeIndex : public Index {
     return;
   }
 
+  bool GetStructureStats(IndexStructureStats &stats);
+
+  bool SetConsolidationThreshold(const size_t leaf_threshold,
+                                 const size_t inner_threshold);
+
+  bool SetSplitThreshold(const size_t leaf_threshold,
+                         const size_t inner_threshold);
+
  protected:
+  // ScanLimit() that also calls key_callback(key, value_count) with the key
+  // of the last value_count values it appended to result
+  template <typename KeyCallback>
+  void ScanEntries(const std::vector<type::Value> &value_list,
+                   const std::vector<oid_t> &tuple_column_id_list,
+                   const std::vector<ExpressionType> &expr_list,
+                   const ScanDirectionType &scan_direction,
+                   std::vector<ValueType> &result,
+                   const ConjunctionScanPredicate *csp_p, const uint64_t limit,
+                   KeyCallback key_callback);
+
   // equality checker and comparator
   KeyComparator comparator;
   KeyEqualityChecker equals;
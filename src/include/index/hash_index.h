@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.h
+//
+// Identification: src/include/index/hash_index.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "container/cuckoo_map.h"
+#include "common/platform.h"
+#include "type/types.h"
+#include "index/index.h"
+
+#define HASH_INDEX_TEMPLATE_ARGUMENTS                                 \
+  template <typename KeyType, typename ValueType, typename KeyHashFunc, \
+            typename KeyEqualityChecker>
+
+#define HASH_INDEX_TYPE \
+  HashIndex<KeyType, ValueType, KeyHashFunc, KeyEqualityChecker>
+
+namespace peloton {
+namespace index {
+
+/**
+ * Cuckoo hash-based index implementation.
+ *
+ * Every key maps to the list of values that share it, and the list is
+ * only ever read or modified while holding the locks of its cuckoo bucket.
+ * Readers copy the values out under the lock, so an entry removed by the
+ * garbage collector (which only deletes the entries of versions no running
+ * transaction can see) is never referenced after it is gone.
+ *
+ * The index only answers equality lookups on the full key efficiently,
+ * any other predicate has to look at every key.
+ *
+ * @see Index
+ */
+template <typename KeyType, typename ValueType, typename KeyHashFunc,
+          typename KeyEqualityChecker>
+class HashIndex : public Index {
+  friend class IndexFactory;
+
+  using MapType = CuckooMap<KeyType, std::vector<ValueType>, KeyHashFunc,
+                            KeyEqualityChecker>;
+
+ public:
+  HashIndex(IndexMetadata *metadata);
+
+  ~HashIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate);
+
+  void Scan(const std::vector<type::Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            const ScanDirectionType &scan_direction,
+            std::vector<ValueType> &result,
+            const ConjunctionScanPredicate *csp_p);
+
+  void ScanAllKeys(std::vector<ValueType> &result);
+
+  void ScanKey(const storage::Tuple *key, std::vector<ValueType> &result);
+
+  std::string GetTypeName() const;
+
+  bool Cleanup() { return true; }
+
+  size_t GetMemoryFootprint();
+
+  // Emptied keys are removed right away, there is nothing to collect
+  bool NeedGC() { return false; }
+
+  void PerformGC() {}
+
+ protected:
+  // Appends the values of the key to result, returns false if the
+  // key is not in the index
+  bool GetValues(const KeyType &index_key, std::vector<ValueType> &result);
+
+  // container
+  MapType container;
+};
+
+}  // End index namespace
+}  // End peloton namespace
@@ -25,6 +25,10 @@
 #include "type/varlen_pool.h"
 #include "type/value.h"
 
+// Batched lookups step forward over at most this many entries to reach the
+// next key before they search the tree for it again
+#define BATCH_SCAN_MAX_STEPS ((size_t)32)
+
 namespace peloton {
 
 class AbstractTuple;
@@ -37,6 +41,10 @@ namespace storage {
 class Tuple;
 }
 
+namespace expression {
+class AbstractExpression;
+}
+
 namespace index {
 
 class ConjunctionScanPredicate;
@@ -93,6 +101,39 @@ class IndexMetadata : public Printable {
 
   bool HasUniqueKeys() const { return unique_keys; }
 
+  /*
+   * GetIncludedColumnCount() - Returns the number of included columns
+   *
+   * Included columns are the last columns of the key. They are stored in
+   * the index entries so that index-only scans can return them, but the
+   * index is not meant to be searched on them
+   */
+  oid_t GetIncludedColumnCount() const { return included_column_count; }
+
+  void SetIncludedColumnCount(const oid_t p_included_column_count);
+
+  /*
+   * GetPredicate() - Returns the predicate of a partial index, nullptr if
+   *                  the index has an entry for every tuple
+   *
+   * The column references of the predicate are resolved against the tuple
+   * schema, so that it can be evaluated on the base table tuples
+   */
+  inline const expression::AbstractExpression *GetPredicate() const {
+    return predicate;
+  }
+
+  inline bool IsPartial() const { return predicate != nullptr; }
+
+  // Takes the ownership of the predicate
+  void SetPredicate(expression::AbstractExpression *p_predicate);
+
+  /*
+   * CoversTuple() - Returns whether the index has an entry for the tuple,
+   *                 i.e. the tuple satisfies the predicate of the index
+   */
+  bool CoversTuple(const AbstractTuple *tuple) const;
+
   /*
    * GetKeyAttrs() - Returns the mapping relation between indexed columns
    *                 and base table columns
@@ -155,10 +196,40 @@ class IndexMetadata : public Printable {
   // Whether keys are unique (e.g. primary key)
   bool unique_keys;
 
+  // Number of included (non-key) columns at the end of the key
+  oid_t included_column_count = 0;
+
+  // Only the tuples satisfying it are indexed (partial index)
+  expression::AbstractExpression *predicate = nullptr;
+
   // utility of an index
   double utility_ratio = INVALID_RATIO;
 };
 
+/////////////////////////////////////////////////////////////////////
+// IndexStructureStats definition
+/////////////////////////////////////////////////////////////////////
+
+/*
+ * struct IndexStructureStats - The shape of an index structure
+ *
+ * Consolidations and splits are counted since the index was built, the
+ * stats aggregator turns them into rates
+ */
+struct IndexStructureStats {
+  // Number of nodes in the index
+  size_t node_count = 0;
+
+  // Average number of delta records on top of a node
+  double avg_delta_chain_length = 0.0;
+
+  // Estimated size of the unlinked nodes that are not freed yet
+  size_t garbage_byte_count = 0;
+
+  uint64_t consolidation_count = 0;
+  uint64_t split_count = 0;
+};
+
 /////////////////////////////////////////////////////////////////////
 // Index class definition
 /////////////////////////////////////////////////////////////////////
@@ -215,6 +286,21 @@ class Index : public Printable {
       const storage::Tuple *key, ItemPointer *location,
       std::function<bool(const void *)> predicate) = 0;
 
+  ///////////////////////////////////////////////////////////////////
+  // Bulk Modification
+  ///////////////////////////////////////////////////////////////////
+
+  // Inserts a batch of key-location pairs, e.g. all tuples of a table when
+  // the index is built. The default just inserts them one by one, indexes
+  // that can do better with the whole batch at hand override it.
+  // exclusive_access tells that no other thread uses the index meanwhile,
+  // e.g. before it is added to its table or during recovery.
+  // Returns the number of entries that got in
+  virtual size_t BulkInsertEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+          entries,
+      const bool exclusive_access);
+
   ///////////////////////////////////////////////////////////////////
   // Index Scan
   ///////////////////////////////////////////////////////////////////
@@ -235,11 +321,46 @@ class Index : public Printable {
                         const ScanDirectionType &scan_direction,
                         std::vector<ItemPointer *> &result);
 
+  // Same as Scan(), but also returns the values of columns key_columns of
+  // the key of every entry found, which lets index-only scans skip the
+  // table. The values of result[i] start at key_values[i * key_columns.size()]
+  // Returns false without scanning if the index can not return its keys
+  virtual bool ScanKeyColumns(const std::vector<type::Value> &value_list,
+                              const std::vector<oid_t> &tuple_column_id_list,
+                              const std::vector<ExpressionType> &expr_list,
+                              const ScanDirectionType &scan_direction,
+                              const ConjunctionScanPredicate *csp_p,
+                              const std::vector<oid_t> &key_columns,
+                              std::vector<ItemPointer *> &result,
+                              std::vector<type::Value> &key_values);
+
+  // Same as Scan(), but the entries come in key order, backward if
+  // scan_direction says so, and the scan stops once limit entries are found
+  // (0 means no limit). A null csp_p scans every entry of the index.
+  // Unless key_values is null, the values of all the key columns of every
+  // entry found are appended to it like in ScanKeyColumns(); indexes that
+  // can not return their keys leave it empty.
+  // Returns false without scanning if the index can not scan in key order
+  virtual bool ScanLimit(const std::vector<type::Value> &value_list,
+                         const std::vector<oid_t> &tuple_column_id_list,
+                         const std::vector<ExpressionType> &expr_list,
+                         const ScanDirectionType &scan_direction,
+                         std::vector<ItemPointer *> &result,
+                         const ConjunctionScanPredicate *csp_p,
+                         const uint64_t limit,
+                         std::vector<type::Value> *key_values);
+
   virtual void ScanAllKeys(std::vector<ItemPointer *> &result) = 0;
 
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  // Looks up a batch of full keys at once, the values of keys[i] end up in
+  // results[i]. Ordered indexes probe the keys in key order and share the
+  // tree traversal between neighbouring keys.
+  virtual void ScanBatch(const std::vector<const storage::Tuple *> &keys,
+                         std::vector<std::vector<ItemPointer *>> &results);
+
   ///////////////////////////////////////////////////////////////////
   // Garbage Collection
   ///////////////////////////////////////////////////////////////////
@@ -260,6 +381,26 @@ class Index : public Printable {
   // virtual void *JoinEpoch() = 0;
   // virtual void LeaveEpoch(void *) = 0;
 
+  ///////////////////////////////////////////////////////////////////
+  // Structure Tuning
+  ///////////////////////////////////////////////////////////////////
+
+  // Fills in the shape of the index structure
+  // Returns false if the index does not keep track of it
+  virtual bool GetStructureStats(IndexStructureStats &stats);
+
+  // Sets the delta chain length at which leaf and inner nodes are
+  // consolidated. Returns false if the index has no delta chains or a
+  // threshold is out of range, in which case nothing changes
+  virtual bool SetConsolidationThreshold(const size_t leaf_threshold,
+                                         const size_t inner_threshold);
+
+  // Sets the size at which leaf and inner nodes are split. Returns false if
+  // the index can not change it or a threshold is out of range, in which
+  // case nothing changes
+  virtual bool SetSplitThreshold(const size_t leaf_threshold,
+                                 const size_t inner_threshold);
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -331,6 +472,12 @@ class Index : public Printable {
     return;
   }
 
+  // Whether the index has the entries of all the tuples in its table, an
+  // index that is still being built is not used for scans yet
+  bool IsReady() const { return ready.load(); }
+
+  void SetReady(const bool ready_) { ready = ready_; }
+
  protected:
   Index(IndexMetadata *schema);
 
@@ -365,6 +512,9 @@ class Index : public Printable {
 
   // This is used by index tuner
   std::atomic<size_t> indexed_tile_group_offset;
+
+  // False while the index is being built
+  std::atomic<bool> ready;
 };
 
 }  // End index namespace
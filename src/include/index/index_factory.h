@@ -26,6 +26,11 @@ class IndexFactory {
  public:
   // Get an index with required attributes
   static Index *GetInstance(IndexMetadata *metadata);
+
+ private:
+  // Number of uint64_ts an IntsKey needs for the key schema,
+  // 0 if the schema does not fit one
+  static size_t GetIntsKeySize(const catalog::Schema *key_schema);
 };
 
 }  // End index namespace
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <sstream>
 
+#include "type/value_factory.h"
 #include "type/value_peeker.h"
 #include "common/logger.h"
 #include "common/macros.h"
@@ -170,9 +171,64 @@ class IntsKey {
     return retval;
   }
 
-  const storage::Tuple GetTupleForComparison(
-      UNUSED_ATTRIBUTE const catalog::Schema *key_schema) const {
-    throw IndexException("Tuple conversion not supported");
+  /*
+   * Unpacks the key into a key-schema tuple over tuple_data, which must hold
+   * key_schema->GetLength() bytes and outlive the tuple.
+   */
+  const storage::Tuple GetTupleForComparison(const catalog::Schema *key_schema,
+                                             char *tuple_data) const {
+    PL_ASSERT(key_schema->GetLength() <= KeySize * sizeof(uint64_t));
+
+    storage::Tuple tuple(key_schema, tuple_data);
+    int key_offset = 0;
+    int intra_key_offset = sizeof(uint64_t) - 1;
+    const int GetColumnCount = key_schema->GetColumnCount();
+    for (int ii = 0; ii < GetColumnCount; ii++) {
+      switch (key_schema->GetColumn(ii).column_type) {
+        case type::Type::BIGINT: {
+          const uint64_t key_value =
+              ExtractKeyValue<uint64_t>(key_offset, intra_key_offset);
+          tuple.SetValue(ii, type::ValueFactory::GetBigIntValue(
+                                 ConvertUnsignedValueToSignedValue<
+                                     int64_t, INT64_MAX>(key_value)),
+                         nullptr);
+          break;
+        }
+        case type::Type::INTEGER: {
+          const uint64_t key_value =
+              ExtractKeyValue<uint32_t>(key_offset, intra_key_offset);
+          tuple.SetValue(ii, type::ValueFactory::GetIntegerValue(
+                                 ConvertUnsignedValueToSignedValue<
+                                     int32_t, INT32_MAX>(key_value)),
+                         nullptr);
+          break;
+        }
+        case type::Type::SMALLINT: {
+          const uint64_t key_value =
+              ExtractKeyValue<uint16_t>(key_offset, intra_key_offset);
+          tuple.SetValue(ii, type::ValueFactory::GetSmallIntValue(
+                                 ConvertUnsignedValueToSignedValue<
+                                     int16_t, INT16_MAX>(key_value)),
+                         nullptr);
+          break;
+        }
+        case type::Type::TINYINT: {
+          const uint64_t key_value =
+              ExtractKeyValue<uint8_t>(key_offset, intra_key_offset);
+          tuple.SetValue(ii, type::ValueFactory::GetTinyIntValue(
+                                 ConvertUnsignedValueToSignedValue<
+                                     int8_t, INT8_MAX>(key_value)),
+                         nullptr);
+          break;
+        }
+        default:
+          throw IndexException(
+              "We currently only support a specific set of "
+              "column index sizes...");
+          break;
+      }
+    }
+    return tuple;
   }
 
   std::string Debug(const catalog::Schema *key_schema) const {
@@ -455,6 +511,12 @@ class GenericKey {
     return storage::Tuple(key_schema, data);
   }
 
+  // The key already is a tuple, the buffer is not needed
+  const storage::Tuple GetTupleForComparison(
+      const catalog::Schema *key_schema, UNUSED_ATTRIBUTE char *tuple_data) {
+    return storage::Tuple(key_schema, data);
+  }
+
   inline const type::Value ToValueFast(const catalog::Schema *schema,
                                  int column_id) const {
     const type::Type::TypeId column_type = schema->GetType(column_id);
@@ -640,6 +702,13 @@ class TupleKey {
     return storage::Tuple(key_tuple_schema, key_tuple);
   }
 
+  // The key already points to a tuple, the buffer is not needed
+  const storage::Tuple GetTupleForComparison(
+      const catalog::Schema *key_tuple_schema,
+      UNUSED_ATTRIBUTE char *tuple_data) const {
+    return storage::Tuple(key_tuple_schema, key_tuple);
+  }
+
   // Return the indexColumn'th key-schema column.
   int ColumnForIndexColumn(int indexColumn) const {
     if (IsKeySchema())
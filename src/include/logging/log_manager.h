@@ -182,6 +182,9 @@ class LogManager {
   // log an insert
   void LogInsert(cid_t commit_id, const ItemPointer &new_location);
 
+  // log all the tuples of a bulk loaded tile group
+  void LogInsertTileGroup(cid_t commit_id, oid_t tile_group_id);
+
   // log a delete
   void LogDelete(cid_t commit_id, const ItemPointer &delete_location);
 
@@ -18,6 +18,7 @@
 #include "parser/statements.h"
 
 #include <memory>
+#include <set>
 #include <vector>
 
 namespace peloton {
@@ -83,11 +84,43 @@ class SimpleOptimizer : public AbstractOptimizer {
                                    std::vector<type::Value> &values,
                                    oid_t &index_id);
 
+  // check whether every tuple satisfying the predicate satisfies the
+  // predicate of a partial index as well, so that the index can serve it
+  static bool ImpliesIndexPredicate(
+      const expression::AbstractExpression *predicate,
+      const expression::AbstractExpression *index_predicate);
+
+  static bool IsFullKeyEquality(
+      const std::set<oid_t> &index_columns,
+      const std::vector<oid_t> &predicate_column_ids,
+      const std::vector<ExpressionType> &predicate_expr_types);
+
+  // replace the simple terms of a sequential scan predicate by precompiled
+  // column filters
+  static expression::AbstractExpression *CompileScanPredicate(
+      const catalog::Schema *schema,
+      expression::AbstractExpression *predicate);
+
   // create a scan plan for a select statement
   static std::unique_ptr<planner::AbstractScan> CreateScanPlan(
       storage::DataTable *target_table, std::vector<oid_t> &column_ids,
       expression::AbstractExpression *predicate, bool for_update);
 
+  // create an index scan that returns the tuples in the ORDER BY order, or
+  // nullptr if no index can
+  static std::unique_ptr<planner::AbstractScan> CreateOrderedScanPlan(
+      storage::DataTable *target_table, std::vector<oid_t> &column_ids,
+      expression::AbstractExpression *predicate, bool for_update,
+      const parser::OrderDescription *order,
+      const parser::LimitDescription *limit);
+
+  // put an exchange on top of a subtree over a large table, so that it runs
+  // in parallel
+  static std::unique_ptr<planner::AbstractPlan> CreateExchangePlan(
+      std::unique_ptr<planner::AbstractPlan> subtree,
+      storage::DataTable *target_table,
+      const std::vector<oid_t> &hash_column_ids);
+
   // create a copy plan for a copy statement
   static std::unique_ptr<planner::AbstractPlan> CreateCopyPlan(
       parser::CopyStatement *copy_stmt);
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "type/types.h"
+#include "expression/abstract_expression.h"
 #include "optimizer/query_node_visitor.h"
 #include "parser/sql_statement.h"
 
@@ -172,6 +173,13 @@ struct CreateStatement : TableRefStatement {
       delete index_attrs;
     }
 
+    if (index_include_attrs) {
+      for (auto attr : *index_include_attrs) free(attr);
+      delete index_include_attrs;
+    }
+
+    delete index_predicate;
+
     free(index_name);
     free(database_name);
   }
@@ -185,6 +193,10 @@ struct CreateStatement : TableRefStatement {
 
   std::vector<ColumnDefinition*>* columns;
   std::vector<char*>* index_attrs = nullptr;
+  std::vector<char*>* index_include_attrs = nullptr;
+
+  // WHERE clause of a partial index
+  expression::AbstractExpression* index_predicate = nullptr;
 
   IndexType index_type;
 
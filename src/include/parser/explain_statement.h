@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// explain_statement.h
+//
+// Identification: src/include/parser/explain_statement.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "parser/sql_statement.h"
+#include "optimizer/query_node_visitor.h"
+
+namespace peloton {
+namespace parser {
+
+/**
+ * @struct ExplainStatement
+ * @brief Represents "EXPLAIN [ANALYZE] SELECT * FROM foo;"
+ */
+struct ExplainStatement : SQLStatement {
+  ExplainStatement()
+      : SQLStatement(STATEMENT_TYPE_EXPLAIN),
+        analyze(false),
+        statement(nullptr) {}
+
+  virtual ~ExplainStatement() { delete statement; }
+
+  // The plan is the one of the explained statement
+  virtual void Accept(optimizer::QueryNodeVisitor* v) const override {
+    statement->Accept(v);
+  }
+
+  // Whether to run the statement and report what its executors did
+  bool analyze;
+
+  SQLStatement* statement;
+};
+
+}  // End parser namespace
+}  // End peloton namespace
@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// adaptive_join_plan.h
+//
+// Identification: src/include/planner/adaptive_join_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "planner/abstract_join_plan.h"
+
+namespace peloton {
+namespace planner {
+
+/**
+ * @brief Equi-join that picks its algorithm once it has seen how many rows
+ * the left side has.
+ *
+ * It has three children: the left side, the right side as a scan that the
+ * join can pass the key of a left row to (see
+ * AbstractExecutor::UpdatePredicate), and the whole right side as a plain
+ * scan. Both right children must output the same columns.
+ *
+ * With at most nested_loop_row_limit left rows, every left row looks up its
+ * matches through the second child. With more, the join builds a hash table
+ * over the left rows and probes it with the output of the third child, one
+ * partition of the keys at a time if there are more than
+ * in_memory_row_limit left rows. Only inner and left joins are supported.
+ */
+class AdaptiveJoinPlan : public AbstractJoinPlan {
+ public:
+  AdaptiveJoinPlan(const AdaptiveJoinPlan &) = delete;
+  AdaptiveJoinPlan &operator=(const AdaptiveJoinPlan &) = delete;
+  AdaptiveJoinPlan(AdaptiveJoinPlan &&) = delete;
+  AdaptiveJoinPlan &operator=(AdaptiveJoinPlan &&) = delete;
+
+  static const size_t default_nested_loop_row_limit = 64;
+
+  static const size_t default_in_memory_row_limit = 1 << 20;
+
+  AdaptiveJoinPlan(
+      PelotonJoinType join_type,
+      std::unique_ptr<const expression::AbstractExpression> &&predicate,
+      std::unique_ptr<const ProjectInfo> &&proj_info,
+      std::shared_ptr<const catalog::Schema> &proj_schema,
+      const std::vector<oid_t> &join_column_ids_left,
+      const std::vector<oid_t> &join_column_ids_right,
+      const std::vector<oid_t> &join_output_column_ids_right,
+      size_t nested_loop_row_limit = default_nested_loop_row_limit,
+      size_t in_memory_row_limit = default_in_memory_row_limit)
+      : AbstractJoinPlan(join_type, std::move(predicate), std::move(proj_info),
+                         proj_schema),
+        join_column_ids_left_(join_column_ids_left),
+        join_column_ids_right_(join_column_ids_right),
+        join_output_column_ids_right_(join_output_column_ids_right),
+        nested_loop_row_limit_(nested_loop_row_limit),
+        in_memory_row_limit_(in_memory_row_limit) {}
+
+  inline PlanNodeType GetPlanNodeType() const {
+    return PLAN_NODE_TYPE_ADAPTIVEJOIN;
+  }
+
+  const std::string GetInfo() const { return "AdaptiveJoin"; }
+
+  std::unique_ptr<AbstractPlan> Copy() const {
+    std::unique_ptr<const expression::AbstractExpression> predicate_copy(
+        GetPredicate() != nullptr ? GetPredicate()->Copy() : nullptr);
+    std::shared_ptr<const catalog::Schema> schema_copy(
+        catalog::Schema::CopySchema(GetSchema()));
+
+    return std::unique_ptr<AbstractPlan>(new AdaptiveJoinPlan(
+        GetJoinType(), std::move(predicate_copy),
+        std::move(GetProjInfo()->Copy()), schema_copy, join_column_ids_left_,
+        join_column_ids_right_, join_output_column_ids_right_,
+        nested_loop_row_limit_, in_memory_row_limit_));
+  }
+
+  // Columns of the key in the output of the left child
+  const std::vector<oid_t> &GetJoinColumnsLeft() const {
+    return join_column_ids_left_;
+  }
+
+  // Columns of the key in the table of the right side, as the second child
+  // expects them
+  const std::vector<oid_t> &GetJoinColumnsRight() const {
+    return join_column_ids_right_;
+  }
+
+  // Columns of the key in the output of the right children
+  const std::vector<oid_t> &GetJoinOutputColumnsRight() const {
+    return join_output_column_ids_right_;
+  }
+
+  size_t GetNestedLoopRowLimit() const { return nested_loop_row_limit_; }
+
+  size_t GetInMemoryRowLimit() const { return in_memory_row_limit_; }
+
+ private:
+  const std::vector<oid_t> join_column_ids_left_;
+
+  const std::vector<oid_t> join_column_ids_right_;
+
+  const std::vector<oid_t> join_output_column_ids_right_;
+
+  // Most left rows the join still looks up one by one
+  const size_t nested_loop_row_limit_;
+
+  // Most left rows the join hashes at once
+  const size_t in_memory_row_limit_;
+};
+
+}  // namespace planner
+}  // namespace peloton
@@ -40,6 +40,16 @@ class CopyPlan : public AbstractPlan {
     LOG_DEBUG("Creating a Copy Plan");
   }
 
+  // Plan for loading the file into the table
+  explicit CopyPlan(char *file_path, storage::DataTable *target_table,
+                    char delimiter)
+      : file_path(file_path),
+        copy_type(COPY_TYPE_IMPORT_CSV),
+        target_table(target_table),
+        delimiter(delimiter) {
+    LOG_DEBUG("Creating a Copy From Plan");
+  }
+
   inline PlanNodeType GetPlanNodeType() const { return PLAN_NODE_TYPE_COPY; }
 
   const std::string GetInfo() const { return "CopyPlan"; }
@@ -52,6 +62,15 @@ class CopyPlan : public AbstractPlan {
 
   // Whether the copying requires deserialization of parameters
   bool deserialize_parameters = false;
+
+  // Whether we export the output of the child or import the file
+  CopyType copy_type = COPY_TYPE_EXPORT_OTHER;
+
+  // The table to load the file into
+  storage::DataTable *target_table = nullptr;
+
+  // Field delimiter of the imported file
+  char delimiter = ',';
 };
 
 }  // namespace planner
@@ -24,6 +24,9 @@ class DataTable;
 namespace parser {
 class CreateStatement;
 }
+namespace expression {
+class AbstractExpression;
+}
 
 namespace planner {
 class CreatePlan : public AbstractPlan {
@@ -66,6 +69,14 @@ class CreatePlan : public AbstractPlan {
 
   std::vector<std::string> GetIndexAttributes() const { return index_attrs; }
 
+  std::vector<std::string> GetIndexIncludeAttributes() const {
+    return index_include_attrs;
+  }
+
+  const expression::AbstractExpression *GetIndexPredicate() const {
+    return index_predicate.get();
+  }
+
  private:
   // Target Table
   storage::DataTable *target_table_ = nullptr;
@@ -82,6 +93,12 @@ class CreatePlan : public AbstractPlan {
   // Index attributes
   std::vector<std::string> index_attrs;
 
+  // Included (non-key) index attributes
+  std::vector<std::string> index_include_attrs;
+
+  // Predicate of a partial index
+  std::unique_ptr<expression::AbstractExpression> index_predicate;
+
   // Check to either Create Table or INDEX
   CreateType create_type;
 
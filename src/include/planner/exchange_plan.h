@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_plan.h
+//
+// Identification: src/include/planner/exchange_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_plan.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace planner {
+
+/**
+ * @brief Runs several instances of its only child in parallel and gathers
+ * their output.
+ *
+ * The subtree must read one table, with a sequential scan. Every instance
+ * scans a partition of it: a range of its tile groups, or the tuples whose
+ * hash of the given columns falls into the partition. The subtree must give
+ * the same result over the union of the partitions as over the whole table,
+ * e.g. an aggregation is only correct over hash partitions of columns it
+ * groups by. The output of the instances comes in no particular order.
+ */
+class ExchangePlan : public AbstractPlan {
+ public:
+  ExchangePlan(const ExchangePlan &) = delete;
+  ExchangePlan &operator=(const ExchangePlan &) = delete;
+  ExchangePlan(ExchangePlan &&) = delete;
+  ExchangePlan &operator=(ExchangePlan &&) = delete;
+
+  ExchangePlan(PartitionType partition_type, size_t partition_count,
+               const std::vector<oid_t> &hash_column_ids = {})
+      : partition_type_(partition_type),
+        partition_count_(partition_count),
+        hash_column_ids_(hash_column_ids) {}
+
+  // Accessors
+  PartitionType GetPartitionType() const { return partition_type_; }
+
+  size_t GetPartitionCount() const { return partition_count_; }
+
+  const std::vector<oid_t> &GetHashColumnIds() const {
+    return hash_column_ids_;
+  }
+
+  inline PlanNodeType GetPlanNodeType() const {
+    return PLAN_NODE_TYPE_EXCHANGE;
+  }
+
+  const std::string GetInfo() const {
+    return "Exchange (" + std::to_string(partition_count_) +
+           (partition_type_ == PARTITION_TYPE_HASH ? " hash" : " range") +
+           " partitions)";
+  }
+
+  std::unique_ptr<AbstractPlan> Copy() const {
+    return std::unique_ptr<AbstractPlan>(
+        new ExchangePlan(partition_type_, partition_count_, hash_column_ids_));
+  }
+
+ private:
+  const PartitionType partition_type_;
+
+  // Number of instances of the subtree
+  const size_t partition_count_;
+
+  // Columns of the scanned table the tuples are hashed on
+  const std::vector<oid_t> hash_column_ids_;
+};
+
+}  // namespace planner
+}  // namespace peloton
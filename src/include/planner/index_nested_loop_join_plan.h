@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_plan.h
+//
+// Identification: src/include/planner/index_nested_loop_join_plan.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "planner/abstract_join_plan.h"
+
+namespace peloton {
+namespace expression {
+class AbstractExpression;
+}
+namespace index {
+class Index;
+}
+namespace storage {
+class DataTable;
+}
+namespace planner {
+
+class ProjectInfo;
+
+/**
+ * Joins the tuples of its only child with the tuples of the inner table
+ * whose index key equals the join columns of the outer tuple.
+ *
+ * The inner side is not a child plan, the join looks the keys up in the
+ * index itself so that the keys of a whole outer tile can be probed at once.
+ * The right side of the output (and of the predicate) has the inner columns
+ * in the order of GetInnerColumnIds().
+ *
+ * Neither optimizer plans this node yet, callers have to build it by hand.
+ */
+class IndexNestedLoopJoinPlan : public AbstractJoinPlan {
+ public:
+  IndexNestedLoopJoinPlan(const IndexNestedLoopJoinPlan &) = delete;
+  IndexNestedLoopJoinPlan &operator=(const IndexNestedLoopJoinPlan &) = delete;
+  IndexNestedLoopJoinPlan(IndexNestedLoopJoinPlan &&) = delete;
+  IndexNestedLoopJoinPlan &operator=(IndexNestedLoopJoinPlan &&) = delete;
+
+  // join_column_ids_outer holds one outer column per column of the index key
+  IndexNestedLoopJoinPlan(
+      PelotonJoinType join_type,
+      std::unique_ptr<const expression::AbstractExpression> &&predicate,
+      std::unique_ptr<const ProjectInfo> &&proj_info,
+      std::shared_ptr<const catalog::Schema> &proj_schema,
+      storage::DataTable *inner_table, std::shared_ptr<index::Index> index,
+      const std::vector<oid_t> &join_column_ids_outer,
+      const std::vector<oid_t> &inner_column_ids);
+
+  inline PlanNodeType GetPlanNodeType() const {
+    return PLAN_NODE_TYPE_NESTLOOPINDEX;
+  }
+
+  const std::string GetInfo() const { return "IndexNestedLoopJoin"; }
+
+  storage::DataTable *GetInnerTable() const { return inner_table_; }
+
+  const std::shared_ptr<index::Index> &GetIndex() const { return index_; }
+
+  const std::vector<oid_t> &GetJoinColumnsOuter() const {
+    return join_column_ids_outer_;
+  }
+
+  const std::vector<oid_t> &GetInnerColumnIds() const {
+    return inner_column_ids_;
+  }
+
+  std::unique_ptr<AbstractPlan> Copy() const;
+
+ private:
+  // table whose tuples are looked up in the index
+  storage::DataTable *inner_table_;
+
+  std::shared_ptr<index::Index> index_;
+
+  // columns of the outer tile that make up the index key, in key order
+  std::vector<oid_t> join_column_ids_outer_;
+
+  // columns of the inner table that are part of the output
+  std::vector<oid_t> inner_column_ids_;
+};
+
+}  // namespace planner
+}  // namespace peloton
@@ -139,6 +139,21 @@ class IndexScanPlan : public AbstractScan {
     return runtime_keys_;
   }
 
+  // Makes the scan return its tuples in the key order of the index, backward
+  // if scan_direction says so. limit is the number of tuples the plans above
+  // need at most (0 if they need all of them), which lets the scan stop early
+  void SetOrderedScan(ScanDirectionType scan_direction, uint64_t limit) {
+    ordered_ = true;
+    scan_direction_ = scan_direction;
+    limit_ = limit;
+  }
+
+  bool IsOrdered() const { return ordered_; }
+
+  ScanDirectionType GetScanDirection() const { return scan_direction_; }
+
+  uint64_t GetLimit() const { return limit_; }
+
   inline PlanNodeType GetPlanNodeType() const {
     return PLAN_NODE_TYPE_INDEXSCAN;
   }
@@ -157,6 +172,9 @@ class IndexScanPlan : public AbstractScan {
                        new_runtime_keys);
     IndexScanPlan *new_plan = new IndexScanPlan(
         GetTable(), GetPredicate()->Copy(), GetColumnIds(), desc, false);
+    if (ordered_ == true) {
+      new_plan->SetOrderedScan(scan_direction_, limit_);
+    }
     return std::unique_ptr<AbstractPlan>(new_plan);
   }
 
@@ -195,6 +213,15 @@ class IndexScanPlan : public AbstractScan {
   // In the future this might be extended into an array of conjunctive
   // predicates connected by disjunction
   index::IndexScanPredicate index_predicate_;
+
+  // Whether the tuples have to come in key order, e.g. when the plan replaces
+  // a sort on the key
+  bool ordered_ = false;
+
+  ScanDirectionType scan_direction_ = SCAN_DIRECTION_TYPE_FORWARD;
+
+  // Number of tuples needed at most, 0 for all of them
+  uint64_t limit_ = 0;
 };
 
 }  // namespace planner
@@ -21,9 +21,14 @@
 namespace peloton {
 
 namespace storage {
+  class Tile;
   class TileGroup;
 }
 
+namespace executor {
+  class LogicalTile;
+}
+
 namespace expression {
   template <class T> class ContainerTuple;
 }
@@ -70,6 +75,11 @@ class ProjectInfo {
                 const AbstractTuple *tuple2,
                 executor::ExecutorContext *econtext) const;
 
+  // Projects the visible tuples of a logical tile a column at a time, tuple
+  // i of the tile goes to slot i of dest
+  bool Evaluate(storage::Tile *dest, executor::LogicalTile *tile,
+                executor::ExecutorContext *econtext) const;
+
   // Used by the update executor
   bool Evaluate(expression::ContainerTuple<storage::TileGroup> *dest,
                 expression::ContainerTuple<storage::TileGroup> *src,
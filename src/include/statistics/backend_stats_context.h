@@ -98,6 +98,10 @@ class BackendStatsContext {
   // Increment the insert stat for index
   void IncrementIndexInserts(index::IndexMetadata* metadata);
 
+  // Increment the insert stat for index by insert_count
+  void IncrementIndexInserts(size_t insert_count,
+                             index::IndexMetadata* metadata);
+
   // Increment the update stat for index
   void IncrementIndexUpdates(index::IndexMetadata* metadata);
 
@@ -111,6 +115,15 @@ class BackendStatsContext {
   // Increment the abortion stat for given database
   void IncrementTxnAborted(oid_t database_id);
 
+  // Record the algorithm an adaptive join of the on going query picked
+  void RecordJoinStrategy(JoinStrategyType join_strategy);
+
+  // Record the most memory the executors of the on going query held
+  void RecordPeakMemoryUsage(size_t peak_memory_usage);
+
+  // Record the per executor statistics of the on going query
+  void RecordOperatorStats(const std::vector<OperatorStats> &operator_stats);
+
   // Initialize the query stat
   void InitQueryMetric(const std::shared_ptr<Statement> statement,
                        const std::shared_ptr<QueryMetric::QueryParams> params);
@@ -49,11 +49,34 @@ class IndexMetric : public AbstractMetric {
 
   inline oid_t GetIndexId() { return index_id_; }
 
+  // The shape of the index structure is a snapshot taken by the stats
+  // aggregator, not something the backends count
+  inline size_t GetNodeCount() const { return node_count_; }
+
+  inline double GetAvgDeltaChainLength() const {
+    return avg_delta_chain_length_;
+  }
+
+  inline size_t GetGarbageBytes() const { return garbage_bytes_; }
+
+  inline double GetConsolidationsPerSec() const {
+    return consolidations_per_sec_;
+  }
+
+  inline double GetSplitsPerSec() const { return splits_per_sec_; }
+
+  void SetStructure(size_t node_count, double avg_delta_chain_length,
+                    size_t garbage_bytes, double consolidations_per_sec,
+                    double splits_per_sec);
+
   //===--------------------------------------------------------------------===//
   // HELPER METHODS
   //===--------------------------------------------------------------------===//
 
-  inline void Reset() { index_access_.Reset(); }
+  inline void Reset() {
+    index_access_.Reset();
+    SetStructure(0, 0.0, 0, 0.0, 0.0);
+  }
 
   inline bool operator==(const IndexMetric &other) {
     return database_id_ == other.database_id_ && table_id_ == other.table_id_ &&
@@ -70,6 +93,11 @@ class IndexMetric : public AbstractMetric {
     ss << "INDEXES: " << std::endl;
     ss << index_name_ << "(OID=" << index_id_ << "): ";
     ss << index_access_.GetInfo() << std::endl;
+    ss << "[structure] nodes: " << node_count_
+       << ", avg delta chain: " << avg_delta_chain_length_
+       << ", garbage bytes: " << garbage_bytes_
+       << ", consolidations/s: " << consolidations_per_sec_
+       << ", splits/s: " << splits_per_sec_ << std::endl;
     return ss.str();
   }
 
@@ -92,6 +120,19 @@ class IndexMetric : public AbstractMetric {
 
   // Counts the number of index entries accessed
   AccessMetric index_access_{ACCESS_METRIC};
+
+  // Number of nodes in the index structure
+  size_t node_count_ = 0;
+
+  // Average number of delta records on top of a node
+  double avg_delta_chain_length_ = 0.0;
+
+  // Estimated size of the nodes waiting to be garbage collected
+  size_t garbage_bytes_ = 0;
+
+  // Node consolidations and splits per second since the last snapshot
+  double consolidations_per_sec_ = 0.0;
+  double splits_per_sec_ = 0.0;
 };
 
 }  // namespace stats
@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// operator_stats.h
+//
+// Identification: src/include/statistics/operator_stats.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * What an executor of a query did, collected only when the query runs with
+ * EXPLAIN ANALYZE
+ */
+struct OperatorStats {
+  PlanNodeType plan_node_type = PLAN_NODE_TYPE_INVALID;
+
+  // Depth of the executor in the executor tree, 0 for the root
+  int depth = 0;
+
+  // Wall time spent in the executor, the executors below it included
+  double time_ms = 0;
+
+  // Tiles and tuples the executor produced
+  size_t tile_count = 0;
+  size_t tuple_count = 0;
+
+  // Tuples the predicate of the executor rejected
+  size_t filtered_tuple_count = 0;
+
+  // Most memory the executor held at once in bytes
+  size_t peak_memory = 0;
+
+  inline const std::string GetInfo() const {
+    std::stringstream ss;
+    ss << std::string(depth * 2, ' ') << "-> "
+       << PlanNodeTypeToString(plan_node_type) << " (time=" << std::fixed
+       << std::setprecision(3) << time_ms << " ms tiles=" << tile_count
+       << " rows=" << tuple_count << " filtered=" << filtered_tuple_count
+       << " memory=" << peak_memory << " bytes)";
+    return ss.str();
+  }
+};
+
+}  // namespace stats
+}  // namespace peloton
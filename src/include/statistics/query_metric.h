@@ -19,6 +19,7 @@
 #include "statistics/abstract_metric.h"
 #include "statistics/access_metric.h"
 #include "statistics/latency_metric.h"
+#include "statistics/operator_stats.h"
 #include "statistics/processor_metric.h"
 
 namespace peloton {
@@ -84,6 +85,34 @@ class QueryMetric : public AbstractMetric {
     return query_params_;
   }
 
+  // Algorithms the adaptive joins of the query picked, in the order they
+  // picked them
+  inline const std::vector<JoinStrategyType> &GetJoinStrategies() const {
+    return join_strategies_;
+  }
+
+  inline void AddJoinStrategy(JoinStrategyType join_strategy) {
+    join_strategies_.push_back(join_strategy);
+  }
+
+  // Most memory the executors of the query held at once
+  inline size_t GetPeakMemoryUsage() const { return peak_memory_usage_; }
+
+  inline void SetPeakMemoryUsage(size_t peak_memory_usage) {
+    peak_memory_usage_ = peak_memory_usage;
+  }
+
+  // What the executors of the query did, in the pre-order of the executor
+  // tree, empty unless it ran with EXPLAIN ANALYZE
+  inline const std::vector<OperatorStats> &GetOperatorStats() const {
+    return operator_stats_;
+  }
+
+  inline void SetOperatorStats(
+      const std::vector<OperatorStats> &operator_stats) {
+    operator_stats_ = operator_stats;
+  }
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
@@ -123,6 +152,15 @@ class QueryMetric : public AbstractMetric {
 
   // Processor metric
   ProcessorMetric processor_metric_{PROCESSOR_METRIC};
+
+  // Join strategy decisions
+  std::vector<JoinStrategyType> join_strategies_;
+
+  // Peak memory usage of the executors in bytes
+  size_t peak_memory_usage_ = 0;
+
+  // Per executor statistics of EXPLAIN ANALYZE
+  std::vector<OperatorStats> operator_stats_;
 };
 
 }  // namespace stats
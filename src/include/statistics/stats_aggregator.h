@@ -27,6 +27,7 @@
 #include "storage/database.h"
 #include "storage/data_table.h"
 #include "concurrency/transaction.h"
+#include "index/index.h"
 
 //===--------------------------------------------------------------------===//
 // GUC Variables
@@ -146,6 +147,10 @@ class StatsAggregator {
   // Varlen Pool to hold query strings
   std::unique_ptr<type::VarlenPool> pool_;
 
+  // Structure stats of every index at the last aggregation, to turn the
+  // consolidation and split counts into rates
+  std::unordered_map<oid_t, index::IndexStructureStats> index_structure_stats_;
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
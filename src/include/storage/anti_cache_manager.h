@@ -0,0 +1,162 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// anti_cache_manager.h
+//
+// Identification: src/include/storage/anti_cache_manager.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "configuration/configuration.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace storage {
+
+class TileGroup;
+
+//===--------------------------------------------------------------------===//
+// Anti-Cache Manager
+//===--------------------------------------------------------------------===//
+
+/**
+ * Larger-than-memory support for tile groups.
+ *
+ * Every tile group registered with the catalog manager is tracked here along
+ * with an (approximate) access epoch. When the memory held by resident tile
+ * groups exceeds the configured limit, the coldest tile groups are serialized
+ * into a local block file and their tile memory is released. The tile group
+ * object and its header stay in memory, so MVCC metadata is always available.
+ *
+ * catalog::Manager::GetTileGroup() pins the tile group and calls
+ * EnsureResident() so that an evicted tile group is transparently fetched
+ * back before anybody touches its tiles. Eviction runs in the background,
+ * every ANTI_CACHE_EVICTION_INTERVAL milliseconds.
+ *
+ * A tile group is only evicted when:
+ * - it lives on the main memory backend,
+ * - all of its tuple slots have been handed out,
+ * - none of its tuples is owned by an in-flight transaction, and
+ * - nobody holds a pinned reference to it or to its tiles.
+ */
+class AntiCacheManager {
+ public:
+  // global singleton
+  static AntiCacheManager &GetInstance(void);
+
+  AntiCacheManager();
+  ~AntiCacheManager();
+
+  //===--------------------------------------------------------------------===//
+  // Configuration
+  //===--------------------------------------------------------------------===//
+
+  // Memory limit for resident tile groups in bytes (0 disables anti-caching),
+  // the anti_cache_memory_limit flag
+  void SetMemoryLimit(size_t memory_limit) {
+    FLAGS_anti_cache_memory_limit = memory_limit;
+  }
+
+  size_t GetMemoryLimit() const { return FLAGS_anti_cache_memory_limit; }
+
+  bool IsEnabled() const { return FLAGS_anti_cache_memory_limit != 0; }
+
+  //===--------------------------------------------------------------------===//
+  // Tracking
+  //===--------------------------------------------------------------------===//
+
+  void RegisterTileGroup(const std::shared_ptr<TileGroup> &tile_group);
+
+  void UnregisterTileGroup(const oid_t tile_group_id);
+
+  // Record an access and fetch the tile group back if it is evicted
+  void EnsureResident(TileGroup *tile_group);
+
+  //===--------------------------------------------------------------------===//
+  // Eviction
+  //===--------------------------------------------------------------------===//
+
+  // Evict the coldest tile groups until the resident size fits the limit.
+  // Returns the number of evicted tile groups.
+  size_t EvictColdTileGroups();
+
+  // Evict a single tile group, returns false if it is not evictable right now
+  bool EvictTileGroup(const oid_t tile_group_id);
+
+  // Memory held by all resident tile groups
+  size_t GetResidentSize();
+
+  // Start and stop the background eviction thread
+  void StartEviction();
+
+  void StopEviction() { eviction_finish_ = true; }
+
+  //===--------------------------------------------------------------------===//
+  // Stats
+  //===--------------------------------------------------------------------===//
+
+  size_t GetEvictionCount() const { return eviction_count_; }
+
+  size_t GetFetchCount() const { return fetch_count_; }
+
+  size_t GetEvictedTileGroupCount();
+
+ private:
+  bool EvictTileGroup(const std::shared_ptr<TileGroup> &tile_group);
+
+  void FetchTileGroup(TileGroup *tile_group);
+
+  bool IsEvictable(const std::shared_ptr<TileGroup> &tile_group) const;
+
+  // Body of the background eviction thread
+  void RunEviction();
+
+  // Block file management (caller must hold block_file_mutex_)
+  void OpenBlockFile();
+
+  size_t AllocateBlock(size_t length);
+
+  void ReleaseBlock(size_t offset, size_t length);
+
+ private:
+  // coarse access clock, advanced whenever a new tile group is registered
+  std::atomic<uint64_t> access_epoch_;
+
+  // registered tile groups
+  std::mutex registry_mutex_;
+  std::unordered_map<oid_t, std::weak_ptr<TileGroup>> tile_groups_;
+
+  // block file
+  std::mutex block_file_mutex_;
+  std::string block_file_name_;
+  int block_file_fd_;
+  size_t block_file_len_;
+
+  // tile group id -> <offset, length> within the block file
+  std::unordered_map<oid_t, std::pair<size_t, size_t>> blocks_;
+
+  // free extents in the block file : <length, offset>
+  std::multimap<size_t, size_t> free_blocks_;
+
+  // tells the background eviction thread to stop
+  std::atomic<bool> eviction_finish_;
+
+  // stats
+  std::atomic<size_t> eviction_count_;
+  std::atomic<size_t> fetch_count_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
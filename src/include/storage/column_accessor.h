@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_accessor.h
+//
+// Identification: src/include/storage/column_accessor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "type/types.h"
+#include "type/value.h"
+#include "type/varlen_type.h"
+
+namespace peloton {
+namespace storage {
+
+class StringDictionary;
+
+//===--------------------------------------------------------------------===//
+// Column Accessor
+//===--------------------------------------------------------------------===//
+
+/**
+ * Resolved location of a tile group column.
+ *
+ * TileGroup::GetValue() has to map the column id to a tile and a tile column
+ * and then consult the tile schema for every single value. A column accessor
+ * does all of that once per tile group, so that reading a value only takes
+ * a multiply-add and a deserialization.
+ *
+ * Accessors are only valid while the caller holds a reference to the tile
+ * group they were resolved from (see TileGroup::GetColumnAccessors()).
+ */
+struct ColumnAccessor {
+  // location of the first tuple slot in the tile
+  const char *base;
+
+  // offset of the column within a tuple slot
+  size_t offset;
+
+  // length of a tuple slot in the tile
+  size_t stride;
+
+  // column type
+  type::Type::TypeId type;
+
+  // is the column stored inline ?
+  bool is_inlined;
+
+  // dictionary of the column, nullptr if it is not dictionary encoded
+  StringDictionary *dictionary;
+
+  inline const char *GetFieldLocation(const oid_t tuple_id) const {
+    return base + tuple_id * stride + offset;
+  }
+
+  inline type::Value GetValue(const oid_t tuple_id) const {
+    return type::Value::DeserializeFrom(GetFieldLocation(tuple_id), type,
+                                        is_inlined);
+  }
+
+  // Get the dictionary entry of the value, nullptr if it is not encoded
+  inline const type::VarlenDictionaryEntry *GetDictionaryEntry(
+      const oid_t tuple_id) const {
+    if (dictionary == nullptr) return nullptr;
+    return type::VarlenType::GetSlotDictionaryEntry(
+        GetFieldLocation(tuple_id));
+  }
+};
+
+}  // End storage namespace
+}  // End peloton namespace
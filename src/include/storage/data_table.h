@@ -93,7 +93,8 @@ class DataTable : public AbstractTable {
   DataTable(catalog::Schema *schema, const std::string &table_name,
             const oid_t &database_oid, const oid_t &table_oid,
             const size_t &tuples_per_tilegroup, const bool own_schema,
-            const bool adapt_table);
+            const bool adapt_table,
+            VarlenPoolType pool_type = DEFAULT_VARLEN_POOL_TYPE);
 
   ~DataTable();
 
@@ -113,10 +114,12 @@ class DataTable : public AbstractTable {
   ItemPointer AcquireVersion();
   // install an version in table. designed for update operation.
   // as we implement logical-pointer indexing mechanism, targets_ptr is
-  // required.
+  // required. old_tuple is the version the new one replaces, which tells
+  // whether a partial index already has an entry for the tuple.
   bool InstallVersion(const AbstractTuple *tuple, const TargetList *targets_ptr,
                       concurrency::Transaction *transaction,
-                      ItemPointer *index_entry_ptr);
+                      ItemPointer *index_entry_ptr,
+                      const AbstractTuple *old_tuple = nullptr);
 
   // insert tuple in table. the pointer to the index entry is returned as
   // index_entry_ptr.
@@ -127,6 +130,14 @@ class DataTable : public AbstractTable {
   // aggregate_executor.
   ItemPointer InsertTuple(const Tuple *tuple);
 
+  // bulk load tuples into fresh tile groups. the tile groups are owned by
+  // the transaction as a whole and their tuples get the commit id of the
+  // transaction at once. the index entries are inserted in sorted batches.
+  // returns false if an index constraint is violated, in which case the
+  // transaction must be aborted.
+  bool BulkLoad(const std::vector<const Tuple *> &tuples,
+                concurrency::Transaction *transaction);
+
   //===--------------------------------------------------------------------===//
   // TILE GROUP
   //===--------------------------------------------------------------------===//
@@ -146,6 +157,9 @@ class DataTable : public AbstractTable {
 
   size_t GetTileGroupCount() const;
 
+  // Pool type of the uninlined data of the tile groups of the table
+  VarlenPoolType GetVarlenPoolType() const { return pool_type_; }
+
   // Get a tile group with given layout
   TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
 
@@ -166,6 +180,18 @@ class DataTable : public AbstractTable {
 
   std::set<oid_t> GetIndexAttrs(const oid_t &index_offset) const;
 
+  // build a new index on the tuples already in the table and add it to the
+  // table. other transactions may use the table meanwhile. returns false
+  // if the tuples violate the unique constraint of the index.
+  bool BuildIndex(std::shared_ptr<index::Index> index);
+
+  // insert the tuples of the tile groups in [begin_offset, end_offset) into
+  // the index. the tile groups are scanned by several threads and the keys
+  // are handed over to the index in one batch. exclusive_access tells that
+  // nobody else uses the index yet. returns the number of entries inserted.
+  size_t PopulateIndex(index::Index *index, const oid_t &begin_offset,
+                       const oid_t &end_offset, const bool exclusive_access);
+
   oid_t GetIndexCount() const;
 
   oid_t GetValidIndexCount() const;
@@ -294,10 +320,25 @@ class DataTable : public AbstractTable {
   // INDEX HELPERS
   //===--------------------------------------------------------------------===//
 
+  // allocate the head pointer of the version chain of a new tuple
+  ItemPointer *AllocateIndirection(const ItemPointer &location);
+
+  // insert the keys of bulk loaded tuples into an index in key order
+  bool BulkInsertInIndex(index::Index *index,
+                         const std::vector<const Tuple *> &tuples,
+                         const std::vector<ItemPointer *> &index_entry_ptrs,
+                         concurrency::Transaction *transaction);
+
+  // check that no live tuple in [begin_offset, end_offset) shares a key of a
+  // populated index with another live tuple
+  bool CheckIndexUniqueness(index::Index *index, const oid_t &begin_offset,
+                            const oid_t &end_offset);
+
   bool InsertInSecondaryIndexes(const AbstractTuple *tuple,
                                 const TargetList *targets_ptr,
                                 concurrency::Transaction *transaction,
-                                ItemPointer *index_entry_ptr);
+                                ItemPointer *index_entry_ptr,
+                                const AbstractTuple *old_tuple);
 
   // check the foreign key constraints
   bool CheckForeignKeyConstraints(const storage::Tuple *tuple);
@@ -315,6 +356,9 @@ class DataTable : public AbstractTable {
   // number of tuples allocated per tilegroup
   size_t tuples_per_tilegroup_;
 
+  // varlen pool type of the tile groups
+  VarlenPoolType pool_type_;
+
   // TILE GROUPS
   LockFreeArray<oid_t> tile_groups_;
 
@@ -329,6 +373,10 @@ class DataTable : public AbstractTable {
   // data table mutex
   std::mutex data_table_mutex_;
 
+  // writers hold it shared, an index build holds it exclusively while it
+  // catches up on the tuples inserted during the build and adds the index
+  RWLock index_build_lock_;
+
   // INDEXES
   LockFreeArray<std::shared_ptr<index::Index>> indexes_;
 
@@ -0,0 +1,81 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_dictionary.h
+//
+// Identification: src/include/storage/string_dictionary.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "type/varlen_type.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// String Dictionary
+//===--------------------------------------------------------------------===//
+
+/**
+ * Dictionary of the distinct values of a low-cardinality varlen column
+ * within one tile.
+ *
+ * Every distinct value is stored once, and the tuple slots point to its
+ * entry instead of a varlen pool block (see type::VarlenType). Two slots of
+ * the same tile column hold equal values iff they point to the same entry,
+ * so comparisons against a constant only need a single lookup per tile.
+ *
+ * Entries are never removed, the dictionary stops taking new values once it
+ * holds max_size of them. Values that do not make it into the dictionary
+ * are stored the regular way.
+ */
+class StringDictionary {
+ public:
+  StringDictionary(const StringDictionary &) = delete;
+  StringDictionary &operator=(const StringDictionary &) = delete;
+
+  static const size_t DEFAULT_MAX_SIZE = 256;
+
+  StringDictionary(size_t max_size = DEFAULT_MAX_SIZE);
+
+  ~StringDictionary();
+
+  // Get the entry of the value, adding it if needed.
+  // Returns nullptr if the value is new and the dictionary is full.
+  const type::VarlenDictionaryEntry *GetOrInsert(const char *data,
+                                                 uint32_t length);
+
+  // Get the entry of the value, nullptr if it is not in the dictionary
+  const type::VarlenDictionaryEntry *Lookup(const char *data, uint32_t length);
+
+  // Get the entry with the given code
+  const type::VarlenDictionaryEntry *GetEntry(uint32_t code);
+
+  size_t GetSize();
+
+  size_t GetMaxSize() const { return max_size_; }
+
+ private:
+  size_t max_size_;
+
+  std::mutex dictionary_mutex_;
+
+  // value -> entry
+  std::unordered_map<std::string, type::VarlenDictionaryEntry *> entries_;
+
+  // code -> entry
+  std::vector<type::VarlenDictionaryEntry *> codes_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -36,7 +36,9 @@ class TableFactory {
                                  catalog::Schema *schema,
                                  std::string table_name,
                                  size_t tuples_per_tile_group_count,
-                                 bool own_schema, bool adapt_table);
+                                 bool own_schema, bool adapt_table,
+                                 VarlenPoolType pool_type =
+                                     DEFAULT_VARLEN_POOL_TYPE);
 
   /**
    * For a given table name, drop the table from database
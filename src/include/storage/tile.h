@@ -19,7 +19,9 @@
 #include "type/serializeio.h"
 #include "type/varlen_pool.h"
 #include "common/printable.h"
+#include "storage/column_accessor.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace peloton {
@@ -38,6 +40,7 @@ class Tuple;
 class TileGroup;
 class TileGroupHeader;
 class TupleIterator;
+class StringDictionary;
 
 /**
  * Represents a Tile.
@@ -59,7 +62,8 @@ class Tile : public Printable {
   // Tile creator
   Tile(BackendType backend_type, TileGroupHeader *tile_header,
        const catalog::Schema &tuple_schema, TileGroup *tile_group,
-       int tuple_count);
+       int tuple_count,
+       VarlenPoolType pool_type = DEFAULT_VARLEN_POOL_TYPE);
 
   virtual ~Tile();
 
@@ -96,12 +100,28 @@ class Tile : public Printable {
                      const type::Type::TypeId column_type,
                      const bool is_inlined);
 
+  // Resolve the location of a column for repeated reads
+  ColumnAccessor GetColumnAccessor(const oid_t column_id) const;
+
   /**
    * Sets value at tuple slot.
    */
   void SetValue(const type::Value &value, const oid_t tuple_offset,
                 const oid_t column_id);
 
+  /**
+   * Sets value at tuple slot through the dictionary of the column.
+   * Returns false if the value has to be stored the regular way.
+   */
+  bool SetDictionaryValue(const type::Value &value, const oid_t tuple_offset,
+                          const oid_t column_id);
+
+  // Get the dictionary of the column, nullptr if it is not dictionary encoded
+  StringDictionary *GetDictionary(const oid_t column_id) const {
+    if (dictionaries.empty()) return nullptr;
+    return dictionaries[column_id].get();
+  }
+
   // Copy a column from this tile to a destination tile.
   // Note that we do shallow copy for varlen field
   void CopyColumnValueTo(Tile *dest_tile, oid_t dest_tuple_offset, oid_t dest_col_id,
@@ -177,11 +197,34 @@ class Tile : public Printable {
 
   type::VarlenPool *GetPool() { return (pool); }
 
+  VarlenPoolType GetPoolType() const { return pool_type; }
+
   char *GetTupleLocation(const oid_t tuple_offset) const;
 
   // Sync the contents
   void Sync();
 
+  //===--------------------------------------------------------------------===//
+  // Anti-Caching
+  //===--------------------------------------------------------------------===//
+
+  // Write the first num_tuples slots along with the uninlined data they
+  // reference, so that the tile can be rebuilt by DeserializeDataFrom
+  void SerializeDataTo(SerializeOutput &output, oid_t num_tuples);
+
+  // Release the tuple slots and uninlined data (tile must be serialized first)
+  void ReleaseData();
+
+  // Reallocate the tuple slots and fill them from a SerializeDataTo image
+  void DeserializeDataFrom(SerializeInput &input);
+
+  // References handed out by TileGroup::GetTileReference pin the tile
+  void Pin() { pin_count++; }
+
+  void Unpin() { pin_count--; }
+
+  uint32_t GetPinCount() const { return pin_count; }
+
  protected:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -208,6 +251,15 @@ class Tile : public Printable {
   // storage pool for uninlined data
   type::VarlenPool *pool;
 
+  // type of the storage pool
+  VarlenPoolType pool_type;
+
+  // number of pinned references to the tile
+  std::atomic<uint32_t> pin_count;
+
+  // dictionaries of the dictionary encoded columns (empty if there are none)
+  std::vector<std::unique_ptr<StringDictionary>> dictionaries;
+
   // number of tuple slots allocated
   oid_t num_tuple_slots;
 
@@ -287,9 +339,10 @@ class TileFactory {
                        oid_t table_id, oid_t tile_group_id, oid_t tile_id,
                        TileGroupHeader *tile_header,
                        const catalog::Schema &schema, TileGroup *tile_group,
-                       int tuple_count) {
-    Tile *tile =
-        new Tile(backend_type, tile_header, schema, tile_group, tuple_count);
+                       int tuple_count,
+                       VarlenPoolType pool_type = DEFAULT_VARLEN_POOL_TYPE) {
+    Tile *tile = new Tile(backend_type, tile_header, schema, tile_group,
+                          tuple_count, pool_type);
 
     TileFactory::InitCommon(tile, database_id, table_id, tile_group_id, tile_id,
                             schema);
@@ -21,12 +21,17 @@
 
 #include "type/types.h"
 #include "type/value.h"
+#include "common/platform.h"
 #include "common/printable.h"
 #include "type/varlen_pool.h"
 #include "planner/project_info.h"
+#include "storage/column_accessor.h"
 
 namespace peloton {
 
+class SerializeInput;
+class SerializeOutput;
+
 namespace gc {
   class GCManager;
 }
@@ -76,7 +81,8 @@ class TileGroup : public Printable {
   // Tile group constructor
   TileGroup(BackendType backend_type, TileGroupHeader *tile_group_header,
             AbstractTable *table, const std::vector<catalog::Schema> &schemas,
-            const column_map_type &column_map, int tuple_count);
+            const column_map_type &column_map, int tuple_count,
+            VarlenPoolType pool_type = DEFAULT_VARLEN_POOL_TYPE);
 
   ~TileGroup();
 
@@ -134,7 +140,8 @@ class TileGroup : public Printable {
   // Get the tile at given offset in the tile group
   Tile *GetTile(const oid_t tile_itr) const;
 
-  // Get a reference to the tile at the given offset in the tile group
+  // Get a reference to the tile at the given offset in the tile group, the
+  // tile stays pinned until the last copy of the reference is gone
   std::shared_ptr<Tile> GetTileReference(const oid_t tile_offset) const;
 
   oid_t GetTileId(const oid_t tile_id) const;
@@ -168,6 +175,20 @@ class TileGroup : public Printable {
 
   type::Value GetValue(oid_t tuple_id, oid_t column_id);
 
+  // Resolve the location of a column once, so that values can be read
+  // without going through the column map
+  ColumnAccessor GetColumnAccessor(oid_t column_id) const;
+
+  // Resolve the given columns (in the given order)
+  std::vector<ColumnAccessor> GetColumnAccessors(
+      const std::vector<oid_t> &column_ids) const;
+
+  // Resolve all columns, indexed by column id
+  std::vector<ColumnAccessor> GetColumnAccessors() const;
+
+  // Get the dictionary of a column, nullptr if it is not dictionary encoded
+  StringDictionary *GetDictionary(oid_t column_id) const;
+
   void SetValue(type::Value &value, oid_t tuple_id, oid_t column_id);
 
   // Copy a column from this tile group to a destination tile group.
@@ -180,6 +201,59 @@ class TileGroup : public Printable {
   // Sync the contents
   void Sync();
 
+  //===--------------------------------------------------------------------===//
+  // Anti-Caching
+  //===--------------------------------------------------------------------===//
+
+  BackendType GetBackendType() const { return backend_type; }
+
+  // Pool type of the uninlined data of the tiles
+  VarlenPoolType GetVarlenPoolType() const { return pool_type; }
+
+  bool IsEvicted() const { return evicted; }
+
+  void SetEvicted(bool evicted_) { evicted = evicted_; }
+
+  uint64_t GetLastAccess() const { return last_access; }
+
+  void SetLastAccess(uint64_t access_epoch) {
+    if (last_access.load(std::memory_order_relaxed) != access_epoch) {
+      last_access.store(access_epoch, std::memory_order_relaxed);
+    }
+  }
+
+  // Bytes held in memory by the tiles (inlined and uninlined data)
+  size_t GetResidentSize() const;
+
+  // Write the contents of all tiles to the output
+  void SerializeTilesTo(SerializeOutput &output);
+
+  // Whether anybody holds a reference to one of its tiles, like a logical
+  // tile that wraps it
+  bool IsTileReferenced() const;
+
+  // Release the memory of all tiles (they must be serialized first)
+  void ReleaseTiles();
+
+  // Rebuild the tiles from an image written by SerializeTilesTo
+  void DeserializeTilesFrom(SerializeInput &input);
+
+  // Eviction and fetching take it exclusively, the GC takes it shared while
+  // it releases the uninlined values of garbage tuples
+  RWLock &GetAntiCacheLock() { return anti_cache_lock; }
+
+  // Readers pin the tile group while they hold it, pinned tile groups are
+  // not evicted
+  void Pin() { pin_count++; }
+
+  void Unpin() { pin_count--; }
+
+  uint32_t GetPinCount() const { return pin_count; }
+
+  // Reference that keeps the tile group pinned until its last copy is gone
+  static std::shared_ptr<TileGroup> GetPinnedReference(
+      const std::shared_ptr<TileGroup> &tile_group);
+
  protected:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -193,6 +267,9 @@ class TileGroup : public Printable {
   // Backend type
   BackendType backend_type;
 
+  // varlen pool type of the tiles
+  VarlenPoolType pool_type;
+
   // mapping to tile schemas
   std::vector<catalog::Schema> tile_schemas;
 
@@ -216,6 +293,20 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // dense copy of the column map indexed by column offset
+  std::vector<std::pair<oid_t, oid_t>> column_locations;
+
+  // is the tile data currently evicted to the anti-cache block file ?
+  std::atomic<bool> evicted;
+
+  // access epoch of the most recent lookup (used to pick eviction victims)
+  std::atomic<uint64_t> last_access;
+
+  // number of pinned references handed out to readers
+  std::atomic<uint32_t> pin_count;
+
+  RWLock anti_cache_lock;
 };
 
 }  // End storage namespace
@@ -34,7 +34,9 @@ class TileGroupFactory {
                                  oid_t tile_group_id, AbstractTable *table,
                                  const std::vector<catalog::Schema> &schemas,
                                  const column_map_type &column_map,
-                                 int tuple_count);
+                                 int tuple_count,
+                                 VarlenPoolType pool_type =
+                                     DEFAULT_VARLEN_POOL_TYPE);
 };
 
 }  // End storage namespace
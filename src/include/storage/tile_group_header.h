@@ -223,6 +223,24 @@ class TileGroupHeader : public Printable {
 
   void PrintVisibility(txn_id_t txn_id, cid_t at_cid);
 
+  //===--------------------------------------------------------------------===//
+  // All-visible check
+  //===--------------------------------------------------------------------===//
+
+  // Some tuple of the tile group got updated or deleted, or its insert
+  // aborted. Its index entries may not match it anymore and its slot can be
+  // reused, so index-only scans have to go to the table from now on.
+  // This is never reset.
+  void SetModified() { modified = true; }
+
+  bool IsModified() const { return modified.load(); }
+
+  // Whether the tuple in the slot is visible at read_cid and still matches
+  // the key of every index entry leading to it. True for the committed
+  // inserts at the beginning of a tile group that has never been modified.
+  // This is cheap and may give false negatives, but never false positives.
+  bool IsAllVisible(const oid_t &tuple_slot_id, const cid_t &read_cid);
+
   // Getter for spin lock
 
   Spinlock &GetHeaderLock() { return tile_header_lock; }
@@ -276,6 +294,17 @@ class TileGroupHeader : public Printable {
   std::atomic<oid_t> next_tuple_slot;
 
   Spinlock tile_header_lock;
+
+  // whether any tuple has been updated, deleted or its insert aborted
+  std::atomic<bool> modified;
+
+  // the first visible_tuple_count slots hold committed inserts, none of
+  // which committed after visible_commit_id
+  std::atomic<oid_t> visible_tuple_count;
+  std::atomic<cid_t> visible_commit_id;
+
+  // held while extending the committed prefix
+  Spinlock visibility_lock;
 };
 
 }  // End storage namespace
@@ -0,0 +1,181 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// slab_varlen_pool.h
+//
+// Identification: src/include/type/slab_varlen_pool.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "type/varlen_pool.h"
+
+namespace peloton {
+namespace type {
+
+//===--------------------------------------------------------------------===//
+// Slab Varlen Pool
+//===--------------------------------------------------------------------===//
+
+/**
+ * Varlen pool built from per-size-class slabs.
+ *
+ * Blocks are power-of-two sized, from SLAB_MIN_BLOCK_SIZE up to
+ * SLAB_MAX_BLOCK_SIZE, and are carved out of SLAB_SIZE slabs that are only
+ * returned when the pool is destroyed. Every block starts with an 8 byte
+ * header holding the reference count and the size class, so that Free() does
+ * not have to search for the owning buffer. Larger requests are served by
+ * the heap.
+ *
+ * Freed blocks go to lock-free free lists. Each size class has
+ * SLAB_FREE_LIST_NUM of them and every thread sticks to one, so concurrent
+ * inserts and updates rarely touch the same list head.
+ *
+ * A block whose reference count drops to zero may still be read by a
+ * transaction looking at an older version, so it is first retired with the
+ * current epoch and only handed out again once the epoch manager reports
+ * that every transaction of that epoch is gone. Retired blocks are tracked
+ * outside of the block, which stays untouched until it is reclaimed.
+ */
+class SlabVarlenPool : public VarlenPool {
+ public:
+  static const size_t SLAB_SIZE = (1 << 18);  // Bytes
+  static const size_t SLAB_MIN_BLOCK_SIZE = 16;
+  static const size_t SLAB_SIZE_CLASS_NUM = 13;
+  static const size_t SLAB_MAX_BLOCK_SIZE =
+      SLAB_MIN_BLOCK_SIZE << (SLAB_SIZE_CLASS_NUM - 1);
+  static const size_t SLAB_LARGE_SIZE_CLASS = SLAB_SIZE_CLASS_NUM;
+  static const size_t SLAB_FREE_LIST_NUM = 8;
+
+  SlabVarlenPool(BackendType backend_type);
+
+  // Destroy this pool, and all memory it owns.
+  ~SlabVarlenPool();
+
+  // Memory allocated block layout:
+  //  +------------------------------------+---------+
+  //  | 4 byte ref count | 4 byte size class | payload |
+  //  +------------------------------------+---------+
+  //                                       ^
+  //                                       Returned pointer
+  void *Allocate(size_t size) override;
+
+  void AddRefCount(void *ptr) override;
+
+  int64_t GetRefCount(void *ptr) override;
+
+  // Retire the block once the reference count becomes 0
+  void Free(void *ptr) override;
+
+  // Get the total number of bytes handed out by this pool.
+  uint64_t GetTotalAllocatedSpace() override;
+
+  // Get the number of bytes held in slabs and large blocks
+  uint64_t GetReservedSpace() const { return reserved_size_; }
+
+  // Get the number of freed blocks waiting for their epoch to pass
+  size_t GetRetiredCount() const { return retired_count_; }
+
+  // Only pools that are never read by concurrent transactions may turn this
+  // off, freed blocks are then reused right away
+  void SetDeferredFree(bool deferred_free) { deferred_free_ = deferred_free; }
+
+  bool IsDeferredFree() const { return deferred_free_; }
+
+  // Size class of a block that holds the given number of bytes
+  static size_t GetSizeClass(size_t block_size);
+
+  static size_t GetBlockSize(size_t size_class) {
+    return SLAB_MIN_BLOCK_SIZE << size_class;
+  }
+
+ private:
+  struct BlockHeader {
+    std::atomic<int32_t> ref_count;
+    uint32_t size_class;
+  };
+
+  // Layout of a block sitting on a free list
+  struct FreeBlock {
+    FreeBlock *next;
+  };
+
+  // Tagged list head, swapped with a 16 byte compare-and-swap so that a
+  // block that is popped and pushed again in between cannot corrupt the list
+  struct alignas(16) FreeListHead {
+    FreeBlock *top;
+    uint64_t tag;
+  };
+
+  // Large blocks carry their length in front of the block header
+  struct LargeBlockHeader {
+    size_t length;
+    size_t retire_epoch;
+  };
+
+  inline BlockHeader *GetHeader(void *ptr) {
+    return reinterpret_cast<BlockHeader *>(reinterpret_cast<char *>(ptr) -
+                                           sizeof(BlockHeader));
+  }
+
+  // Lock-free list operations
+  static void PushBlocks(FreeListHead *head, FreeBlock *first,
+                         FreeBlock *last);
+
+  static FreeBlock *PopBlock(FreeListHead *head);
+
+  // Move the retired blocks whose epoch has passed to the given free list
+  void ReclaimRetiredBlocks(size_t size_class, size_t free_list_id);
+
+  // Cut a new block out of the current slab of the size class
+  FreeBlock *CarveBlock(size_t size_class);
+
+  void *AllocateLarge(size_t size);
+
+  void FreeLarge(BlockHeader *header);
+
+  // Release the retired large blocks whose epoch has passed
+  // (caller must hold large_lock_)
+  void ReclaimLargeBlocks();
+
+ private:
+  // free lists
+  FreeListHead free_lists_[SLAB_SIZE_CLASS_NUM][SLAB_FREE_LIST_NUM];
+
+  // blocks waiting for their epoch to pass : <block, retire epoch>
+  Spinlock retired_lock_[SLAB_SIZE_CLASS_NUM];
+  std::vector<std::pair<FreeBlock *, size_t>>
+      retired_blocks_[SLAB_SIZE_CLASS_NUM];
+
+  // last reclaimable epoch that the retired lists were checked against
+  std::atomic<size_t> reclaimed_epoch_[SLAB_SIZE_CLASS_NUM];
+
+  // slabs of each size class, the last one is being carved
+  Spinlock slab_lock_[SLAB_SIZE_CLASS_NUM];
+  std::vector<char *> slabs_[SLAB_SIZE_CLASS_NUM];
+  size_t slab_offset_[SLAB_SIZE_CLASS_NUM];
+
+  // blocks larger than SLAB_MAX_BLOCK_SIZE
+  Spinlock large_lock_;
+  std::unordered_set<char *> large_blocks_;
+  std::vector<char *> retired_large_blocks_;
+
+  std::atomic<bool> deferred_free_;
+
+  // stats
+  std::atomic<uint64_t> allocated_size_;
+  std::atomic<uint64_t> reserved_size_;
+  std::atomic<size_t> retired_count_;
+};
+
+}  // namespace type
+}  // namespace peloton
@@ -260,6 +260,11 @@ enum ExpressionType {
   EXPRESSION_TYPE_FUNCTION_REF = 703,
   EXPRESSION_TYPE_TABLE_REF = 704,
 
+  //===--------------------------------------------------------------------===//
+  // Optimizer
+  //===--------------------------------------------------------------------===//
+  EXPRESSION_TYPE_COLUMN_FILTER = 800,
+
   //===--------------------------------------------------------------------===//
   // Misc
   //===--------------------------------------------------------------------===//
@@ -338,6 +343,19 @@ enum BackendType {
   BACKEND_TYPE_HDD = 4       // on hdd
 };
 
+//===--------------------------------------------------------------------===//
+// Varlen Pool Types
+//===--------------------------------------------------------------------===//
+
+enum VarlenPoolType {
+  VARLEN_POOL_TYPE_INVALID = 0,  // invalid varlen pool type
+  VARLEN_POOL_TYPE_BUFFER = 1,   // bitmap buffers (type::VarlenPool)
+  VARLEN_POOL_TYPE_SLAB = 2      // size-class slabs (type::SlabVarlenPool)
+};
+
+// Pool used for the uninlined data of tables that do not pick one
+extern VarlenPoolType DEFAULT_VARLEN_POOL_TYPE;
+
 //===--------------------------------------------------------------------===//
 // Index Types
 //===--------------------------------------------------------------------===//
@@ -346,7 +364,8 @@ enum IndexType {
   INDEX_TYPE_INVALID = 0,  // invalid index type
   INDEX_TYPE_BTREE = 1,    // btree
   INDEX_TYPE_BWTREE = 2,   // bwtree
-  INDEX_TYPE_HASH = 3      // hash
+  INDEX_TYPE_HASH = 3,     // hash
+  INDEX_TYPE_ART = 4       // adaptive radix tree
 };
 
 enum IndexConstraintType {
@@ -418,6 +437,7 @@ enum PlanNodeType {
   PLAN_NODE_TYPE_NESTLOOPINDEX = 21,
   PLAN_NODE_TYPE_MERGEJOIN = 22,
   PLAN_NODE_TYPE_HASHJOIN = 23,
+  PLAN_NODE_TYPE_ADAPTIVEJOIN = 24,
 
   // Mutator Nodes
   PLAN_NODE_TYPE_UPDATE = 30,
@@ -432,6 +452,7 @@ enum PlanNodeType {
   PLAN_NODE_TYPE_SEND = 40,
   PLAN_NODE_TYPE_RECEIVE = 41,
   PLAN_NODE_TYPE_PRINT = 42,
+  PLAN_NODE_TYPE_EXCHANGE = 43,
 
   // Algebra Nodes
   PLAN_NODE_TYPE_AGGREGATE = 50,
@@ -483,7 +504,18 @@ enum StatementType {
   STATEMENT_TYPE_RENAME = 11,       // rename statement type
   STATEMENT_TYPE_ALTER = 12,        // alter statement type
   STATEMENT_TYPE_TRANSACTION = 13,  // transaction statement type,
-  STATEMENT_TYPE_COPY = 14          // copy type
+  STATEMENT_TYPE_COPY = 14,         // copy type
+  STATEMENT_TYPE_EXPLAIN = 15       // explain statement type
+};
+
+//===--------------------------------------------------------------------===//
+// Explain Types
+//===--------------------------------------------------------------------===//
+
+enum ExplainType {
+  EXPLAIN_TYPE_INVALID = 0,  // not explained, runs the statement
+  EXPLAIN_TYPE_PLAN = 1,     // returns the plan of the statement
+  EXPLAIN_TYPE_ANALYZE = 2   // runs it and returns what each executor did
 };
 
 //===--------------------------------------------------------------------===//
@@ -519,6 +551,25 @@ enum PelotonAggType {
   AGGREGATE_TYPE_PLAIN = 3  // no group-by
 };
 
+//===--------------------------------------------------------------------===//
+// Partition Types
+//===--------------------------------------------------------------------===//
+enum PartitionType {
+  PARTITION_TYPE_INVALID = 0,
+  PARTITION_TYPE_TILE_GROUP_RANGE = 1,  // contiguous ranges of tile groups
+  PARTITION_TYPE_HASH = 2               // hash of columns of the tuples
+};
+
+//===--------------------------------------------------------------------===//
+// Join Strategy Types
+//===--------------------------------------------------------------------===//
+enum JoinStrategyType {
+  JOIN_STRATEGY_TYPE_INVALID = 0,
+  JOIN_STRATEGY_TYPE_NESTED_LOOP = 1,  // lookups into the inner side per row
+  JOIN_STRATEGY_TYPE_HASH = 2,         // in-memory hash join
+  JOIN_STRATEGY_TYPE_GRACE_HASH = 3    // hash join one partition at a time
+};
+
 // ------------------------------------------------------------------
 // Expression Quantifier Types
 // ------------------------------------------------------------------
@@ -966,6 +1017,9 @@ bool AtomicUpdateItemPointer(ItemPointer *src_ptr, const ItemPointer &value);
 std::string BackendTypeToString(BackendType type);
 BackendType StringToBackendType(const std::string &str);
 
+std::string VarlenPoolTypeToString(VarlenPoolType type);
+VarlenPoolType StringToVarlenPoolType(const std::string &str);
+
 std::string TypeIdToString(type::Type::TypeId type);
 type::Type::TypeId StringToTypeId(const std::string &str);
 
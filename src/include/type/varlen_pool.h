@@ -60,7 +60,11 @@ public:
   VarlenPool();
 
   // Destroy this pool, and all memory it owns.
-  ~VarlenPool();
+  virtual ~VarlenPool();
+
+  // Create a pool of the given type
+  static VarlenPool *CreatePool(VarlenPoolType pool_type,
+                                BackendType backend_type);
 
   // Initialize this pool.
   void Init();
@@ -78,24 +82,28 @@ public:
   //                     ^
   //                     Returned pointer pointed to the payload
   // TODO: Provide good error codes for failure cases.
-  void *Allocate(size_t size);
+  virtual void *Allocate(size_t size);
 
   // Add one to the reference count of a block of memory allocated by the pool
-  void AddRefCount(void *ptr);
+  virtual void AddRefCount(void *ptr);
 
   // Get the reference count of a block of memory allocated by the pool
-  int64_t GetRefCount(void *ptr);
+  virtual int64_t GetRefCount(void *ptr);
 
   // Minus one to the reference count of a block of memory allocated by the pool
   // Returns the provided chunk of memory back into the pool if the reference count becomes 0
-  void Free(void *ptr);
+  virtual void Free(void *ptr);
 
   // Get the total number of bytes that have been allocated by this pool.
-  uint64_t GetTotalAllocatedSpace();
+  virtual uint64_t GetTotalAllocatedSpace();
 
   // Get the maximum size of this pool.
   uint64_t GetMaximumPoolSize() const;
 
+  // Get the number of bytes of the buffers this pool grew to. It does not
+  // shrink when they are returned.
+  size_t GetPoolSize() const { return pool_size_; }
+
   // Get the empty buffer count for a given empty buffer list id
   // Return -1 if list_id is out of bound
   int GetEmptyCountByListId(size_t list_id) const;
@@ -17,6 +17,20 @@
 namespace peloton {
 namespace type {
 
+// Entry of a string dictionary (see storage::StringDictionary). The payload
+// follows the entry, entries are immutable and live as long as their tile.
+struct VarlenDictionaryEntry {
+  // code of the value within its dictionary
+  uint32_t code;
+
+  // length of the payload
+  uint32_t length;
+
+  inline const char *GetData() const {
+    return reinterpret_cast<const char *>(this + 1);
+  }
+};
+
 // A varlen value is an abstract class representing all objects that have
 // variable length.
 class VarlenType : public Type {
@@ -69,6 +83,48 @@ class VarlenType : public Type {
 
   // Create a copy of this value
   Value Copy(const Value& val) const override;
+
+  //===--------------------------------------------------------------------===//
+  // Varlen slots
+  //===--------------------------------------------------------------------===//
+
+  // A varlen slot in the tuple storage holds one of
+  // - nullptr (null value),
+  // - a pointer to a [4 byte length | payload] block in the varlen pool,
+  // - the value itself, if it fits the slot (tag bit 0 in the first byte), or
+  // - a pointer to a string dictionary entry (tag bit 1 in the first byte).
+  // Pool blocks and dictionary entries are at least 8 byte aligned, so the
+  // tag bits are always clear in their (little-endian) pointers.
+  static const uint32_t SLOT_INLINED_MAX_LEN = sizeof(char *) - 1;
+
+  static inline bool IsSlotInlined(const char *storage) {
+    return (storage[0] & SLOT_TAG_MASK) == SLOT_INLINED_TAG;
+  }
+
+  static inline bool IsSlotDictionaryEncoded(const char *storage) {
+    return (storage[0] & SLOT_TAG_MASK) == SLOT_DICTIONARY_TAG;
+  }
+
+  // Get the dictionary entry of the slot, nullptr if it is not encoded
+  static inline const VarlenDictionaryEntry *GetSlotDictionaryEntry(
+      const char *storage) {
+    if (IsSlotDictionaryEncoded(storage) == false) return nullptr;
+    uintptr_t word = *reinterpret_cast<const uintptr_t *>(storage);
+    return reinterpret_cast<const VarlenDictionaryEntry *>(word &
+                                                           ~SLOT_TAG_MASK);
+  }
+
+  static inline void SetSlotDictionaryEntry(
+      char *storage, const VarlenDictionaryEntry *entry) {
+    uintptr_t word = reinterpret_cast<uintptr_t>(entry);
+    PL_ASSERT((word & SLOT_TAG_MASK) == 0);
+    *reinterpret_cast<uintptr_t *>(storage) = word | SLOT_DICTIONARY_TAG;
+  }
+
+ private:
+  static const uintptr_t SLOT_TAG_MASK = 0x3;
+  static const uintptr_t SLOT_INLINED_TAG = 0x1;
+  static const uintptr_t SLOT_DICTIONARY_TAG = 0x2;
 };
 
 }  // namespace type
@@ -0,0 +1,1186 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art.cpp
+//
+// Identification: src/index/art.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "index/art.h"
+
+namespace peloton {
+namespace index {
+
+//===--------------------------------------------------------------------===//
+// Nodes
+//===--------------------------------------------------------------------===//
+
+enum ArtNodeType : uint8_t {
+  ART_NODE_4 = 0,
+  ART_NODE_16 = 1,
+  ART_NODE_48 = 2,
+  ART_NODE_256 = 3
+};
+
+// The version of an inner node: bit 0 is set once the node is unlinked,
+// bit 1 while it is locked, the rest counts the changes
+static const uint64_t ART_VERSION_OBSOLETE = 1;
+static const uint64_t ART_VERSION_LOCKED = 2;
+
+// Empty slot of Node48::child_index
+static const uint8_t ART_NODE48_EMPTY = 48;
+
+struct ArtTree::Node {
+  Node(ArtNodeType type) : version{0}, type{type} {}
+
+  std::atomic<uint64_t> version;
+  const ArtNodeType type;
+  uint16_t count = 0;
+  uint32_t prefix_length = 0;
+  uint8_t prefix[ART_MAX_PREFIX_LENGTH];
+};
+
+// Node4 and Node16 keep their key bytes sorted
+struct ArtTree::Node4 : public ArtTree::Node {
+  Node4() : Node(ART_NODE_4) {
+    for (auto &child : children) child.store(nullptr);
+  }
+
+  uint8_t keys[4];
+  std::atomic<Node *> children[4];
+};
+
+struct ArtTree::Node16 : public ArtTree::Node {
+  Node16() : Node(ART_NODE_16) {
+    for (auto &child : children) child.store(nullptr);
+  }
+
+  uint8_t keys[16];
+  std::atomic<Node *> children[16];
+};
+
+struct ArtTree::Node48 : public ArtTree::Node {
+  Node48() : Node(ART_NODE_48) {
+    PL_MEMSET(child_index, ART_NODE48_EMPTY, sizeof(child_index));
+    for (auto &child : children) child.store(nullptr);
+  }
+
+  uint8_t child_index[256];
+  std::atomic<Node *> children[48];
+};
+
+struct ArtTree::Node256 : public ArtTree::Node {
+  Node256() : Node(ART_NODE_256) {
+    for (auto &child : children) child.store(nullptr);
+  }
+
+  std::atomic<Node *> children[256];
+};
+
+struct ArtTree::Leaf {
+  Leaf(const std::string &key, std::vector<ValueType> &&values)
+      : key{key}, values{std::move(values)} {}
+
+  size_t GetFootprint() const {
+    return sizeof(Leaf) + key.capacity() +
+           values.capacity() * sizeof(ValueType);
+  }
+
+  const std::string key;
+  const std::vector<ValueType> values;
+};
+
+// Leaves hang off the inner nodes with the low pointer bit set
+static inline bool IsLeaf(const void *node) {
+  return (reinterpret_cast<uintptr_t>(node) & 1) == 1;
+}
+
+static inline uint8_t KeyByte(const std::string &key, size_t position) {
+  return static_cast<uint8_t>(key[position]);
+}
+
+//===--------------------------------------------------------------------===//
+// Optimistic lock coupling
+//===--------------------------------------------------------------------===//
+
+/*
+ * ReadLockOrRestart() - Waits until the node is not locked and returns its
+ *                       version, fails if the node is unlinked
+ */
+bool ArtTree::ReadLockOrRestart(Node *node, uint64_t &version) {
+  version = node->version.load();
+  while ((version & ART_VERSION_LOCKED) != 0) {
+    std::this_thread::yield();
+    version = node->version.load();
+  }
+  return (version & ART_VERSION_OBSOLETE) == 0;
+}
+
+/*
+ * CheckOrRestart() - Whether the node is still the way it was when
+ *                    version was read
+ */
+bool ArtTree::CheckOrRestart(Node *node, uint64_t version) {
+  return node->version.load() == version;
+}
+
+bool ArtTree::UpgradeToWriteLockOrRestart(Node *node, uint64_t version) {
+  return node->version.compare_exchange_strong(version,
+                                               version + ART_VERSION_LOCKED);
+}
+
+bool ArtTree::WriteLockOrRestart(Node *node) {
+  uint64_t version;
+  do {
+    if (ReadLockOrRestart(node, version) == false) {
+      return false;
+    }
+  } while (UpgradeToWriteLockOrRestart(node, version) == false);
+  return true;
+}
+
+void ArtTree::WriteUnlock(Node *node) {
+  node->version.fetch_add(ART_VERSION_LOCKED);
+}
+
+void ArtTree::WriteUnlockObsolete(Node *node) {
+  node->version.fetch_add(ART_VERSION_LOCKED + ART_VERSION_OBSOLETE);
+}
+
+//===--------------------------------------------------------------------===//
+// Node operations
+//===--------------------------------------------------------------------===//
+
+/*
+ * FindChild() - Returns the child of the key byte, or nullptr
+ *
+ * Readers call this without a lock, so the result is only good if the
+ * version of the node did not change meanwhile
+ */
+ArtTree::Node *ArtTree::FindChild(Node *node, uint8_t key_byte) {
+  switch (node->type) {
+    case ART_NODE_4: {
+      auto node4 = static_cast<Node4 *>(node);
+      const uint16_t count = std::min<uint16_t>(node4->count, 4);
+      for (uint16_t child_itr = 0; child_itr < count; child_itr++) {
+        if (node4->keys[child_itr] == key_byte) {
+          return node4->children[child_itr].load();
+        }
+      }
+      return nullptr;
+    }
+    case ART_NODE_16: {
+      auto node16 = static_cast<Node16 *>(node);
+      const uint16_t count = std::min<uint16_t>(node16->count, 16);
+      for (uint16_t child_itr = 0; child_itr < count; child_itr++) {
+        if (node16->keys[child_itr] == key_byte) {
+          return node16->children[child_itr].load();
+        }
+      }
+      return nullptr;
+    }
+    case ART_NODE_48: {
+      auto node48 = static_cast<Node48 *>(node);
+      const uint8_t child_index = node48->child_index[key_byte];
+      if (child_index == ART_NODE48_EMPTY) {
+        return nullptr;
+      }
+      return node48->children[child_index].load();
+    }
+    case ART_NODE_256:
+      return static_cast<Node256 *>(node)->children[key_byte].load();
+  }
+  return nullptr;
+}
+
+bool ArtTree::IsFull(Node *node) {
+  switch (node->type) {
+    case ART_NODE_4:
+      return node->count == 4;
+    case ART_NODE_16:
+      return node->count == 16;
+    case ART_NODE_48:
+      return node->count == 48;
+    case ART_NODE_256:
+      return false;
+  }
+  return false;
+}
+
+/*
+ * InsertSorted() - Adds a child to the sorted key bytes of Node4 or Node16
+ */
+template <typename NodeType, typename ChildType>
+static void InsertSorted(NodeType *node, uint8_t key_byte, ChildType child) {
+  uint16_t position = 0;
+  while (position < node->count && node->keys[position] < key_byte) {
+    position++;
+  }
+  for (uint16_t child_itr = node->count; child_itr > position; child_itr--) {
+    node->keys[child_itr] = node->keys[child_itr - 1];
+    node->children[child_itr].store(node->children[child_itr - 1].load());
+  }
+  node->keys[position] = key_byte;
+  node->children[position].store(child);
+  node->count++;
+}
+
+template <typename NodeType>
+static void RemoveSorted(NodeType *node, uint8_t key_byte) {
+  uint16_t position = 0;
+  while (position < node->count && node->keys[position] != key_byte) {
+    position++;
+  }
+  PL_ASSERT(position < node->count);
+  for (uint16_t child_itr = position; child_itr + 1 < node->count;
+       child_itr++) {
+    node->keys[child_itr] = node->keys[child_itr + 1];
+    node->children[child_itr].store(node->children[child_itr + 1].load());
+  }
+  node->count--;
+  node->children[node->count].store(nullptr);
+}
+
+void ArtTree::AddChild(Node *node, uint8_t key_byte, Node *child) {
+  PL_ASSERT(IsFull(node) == false);
+  switch (node->type) {
+    case ART_NODE_4:
+      InsertSorted(static_cast<Node4 *>(node), key_byte, child);
+      break;
+    case ART_NODE_16:
+      InsertSorted(static_cast<Node16 *>(node), key_byte, child);
+      break;
+    case ART_NODE_48: {
+      auto node48 = static_cast<Node48 *>(node);
+      uint8_t slot = 0;
+      while (node48->children[slot].load() != nullptr) {
+        slot++;
+      }
+      node48->children[slot].store(child);
+      node48->child_index[key_byte] = slot;
+      node48->count++;
+      break;
+    }
+    case ART_NODE_256:
+      static_cast<Node256 *>(node)->children[key_byte].store(child);
+      node->count++;
+      break;
+  }
+}
+
+void ArtTree::ChangeChild(Node *node, uint8_t key_byte, Node *child) {
+  switch (node->type) {
+    case ART_NODE_4: {
+      auto node4 = static_cast<Node4 *>(node);
+      for (uint16_t child_itr = 0; child_itr < node4->count; child_itr++) {
+        if (node4->keys[child_itr] == key_byte) {
+          node4->children[child_itr].store(child);
+          return;
+        }
+      }
+      break;
+    }
+    case ART_NODE_16: {
+      auto node16 = static_cast<Node16 *>(node);
+      for (uint16_t child_itr = 0; child_itr < node16->count; child_itr++) {
+        if (node16->keys[child_itr] == key_byte) {
+          node16->children[child_itr].store(child);
+          return;
+        }
+      }
+      break;
+    }
+    case ART_NODE_48: {
+      auto node48 = static_cast<Node48 *>(node);
+      PL_ASSERT(node48->child_index[key_byte] != ART_NODE48_EMPTY);
+      node48->children[node48->child_index[key_byte]].store(child);
+      return;
+    }
+    case ART_NODE_256:
+      static_cast<Node256 *>(node)->children[key_byte].store(child);
+      return;
+  }
+  PL_ASSERT(false);
+}
+
+void ArtTree::RemoveChild(Node *node, uint8_t key_byte) {
+  switch (node->type) {
+    case ART_NODE_4:
+      RemoveSorted(static_cast<Node4 *>(node), key_byte);
+      break;
+    case ART_NODE_16:
+      RemoveSorted(static_cast<Node16 *>(node), key_byte);
+      break;
+    case ART_NODE_48: {
+      auto node48 = static_cast<Node48 *>(node);
+      const uint8_t child_index = node48->child_index[key_byte];
+      PL_ASSERT(child_index != ART_NODE48_EMPTY);
+      node48->child_index[key_byte] = ART_NODE48_EMPTY;
+      node48->children[child_index].store(nullptr);
+      node48->count--;
+      break;
+    }
+    case ART_NODE_256:
+      static_cast<Node256 *>(node)->children[key_byte].store(nullptr);
+      node->count--;
+      break;
+  }
+}
+
+/*
+ * GetChildren() - Collects the children of the node in key byte order
+ */
+void ArtTree::GetChildren(Node *node, ChildList &children) {
+  children.clear();
+  switch (node->type) {
+    case ART_NODE_4: {
+      auto node4 = static_cast<Node4 *>(node);
+      const uint16_t count = std::min<uint16_t>(node4->count, 4);
+      for (uint16_t child_itr = 0; child_itr < count; child_itr++) {
+        Node *child = node4->children[child_itr].load();
+        if (child != nullptr) {
+          children.emplace_back(node4->keys[child_itr], child);
+        }
+      }
+      break;
+    }
+    case ART_NODE_16: {
+      auto node16 = static_cast<Node16 *>(node);
+      const uint16_t count = std::min<uint16_t>(node16->count, 16);
+      for (uint16_t child_itr = 0; child_itr < count; child_itr++) {
+        Node *child = node16->children[child_itr].load();
+        if (child != nullptr) {
+          children.emplace_back(node16->keys[child_itr], child);
+        }
+      }
+      break;
+    }
+    case ART_NODE_48: {
+      auto node48 = static_cast<Node48 *>(node);
+      for (uint16_t key_byte = 0; key_byte < 256; key_byte++) {
+        const uint8_t child_index = node48->child_index[key_byte];
+        if (child_index == ART_NODE48_EMPTY) {
+          continue;
+        }
+        Node *child = node48->children[child_index].load();
+        if (child != nullptr) {
+          children.emplace_back(key_byte, child);
+        }
+      }
+      break;
+    }
+    case ART_NODE_256: {
+      auto node256 = static_cast<Node256 *>(node);
+      for (uint16_t key_byte = 0; key_byte < 256; key_byte++) {
+        Node *child = node256->children[key_byte].load();
+        if (child != nullptr) {
+          children.emplace_back(key_byte, child);
+        }
+      }
+      break;
+    }
+  }
+}
+
+/*
+ * GetSecondChild() - Returns the child other than the one of key_byte in a
+ *                    node with two children
+ */
+ArtTree::Node *ArtTree::GetSecondChild(Node *node, uint8_t key_byte,
+                                       uint8_t &second_key_byte) {
+  ChildList children;
+  GetChildren(node, children);
+  for (auto &child : children) {
+    if (child.first != key_byte) {
+      second_key_byte = child.first;
+      return child.second;
+    }
+  }
+  return nullptr;
+}
+
+/*
+ * GetAnyLeaf() - Returns a leaf below the node, all of which share the
+ *                full prefix of the node
+ */
+const ArtTree::Leaf *ArtTree::GetAnyLeaf(Node *node) {
+  ChildList children;
+  while (true) {
+    GetChildren(node, children);
+    if (children.empty() == true) {
+      return nullptr;
+    }
+    node = children.front().second;
+    if (IsLeaf(node) == true) {
+      return reinterpret_cast<const Leaf *>(
+          reinterpret_cast<uintptr_t>(node) & ~static_cast<uintptr_t>(1));
+    }
+  }
+}
+
+/*
+ * PrefixMatches() - Compares the prefix bytes kept in the node with the key
+ *
+ * The bytes past ART_MAX_PREFIX_LENGTH are not compared, the caller checks
+ * the full key at the leaf
+ */
+bool ArtTree::PrefixMatches(Node *node, uint32_t prefix_length,
+                            const std::string &key, size_t depth) {
+  const uint32_t stored_length =
+      std::min<uint32_t>(prefix_length, ART_MAX_PREFIX_LENGTH);
+  if (depth + prefix_length >= key.size()) {
+    return false;
+  }
+  for (uint32_t byte_itr = 0; byte_itr < stored_length; byte_itr++) {
+    if (node->prefix[byte_itr] != KeyByte(key, depth + byte_itr)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*
+ * AddPrefixBefore() - Puts the prefix of parent and the key byte of node in
+ *                     parent in front of the prefix of node, when node
+ *                     takes the place of parent
+ */
+void ArtTree::AddPrefixBefore(Node *node, Node *parent, uint8_t key_byte) {
+  uint8_t prefix[ART_MAX_PREFIX_LENGTH];
+  uint32_t stored_length = 0;
+
+  const uint32_t parent_stored_length =
+      std::min<uint32_t>(parent->prefix_length, ART_MAX_PREFIX_LENGTH);
+  for (uint32_t byte_itr = 0; byte_itr < parent_stored_length; byte_itr++) {
+    prefix[stored_length++] = parent->prefix[byte_itr];
+  }
+  if (stored_length < ART_MAX_PREFIX_LENGTH) {
+    prefix[stored_length++] = key_byte;
+  }
+  for (uint32_t byte_itr = 0; byte_itr < node->prefix_length &&
+                                  stored_length < ART_MAX_PREFIX_LENGTH;
+       byte_itr++) {
+    prefix[stored_length++] = node->prefix[byte_itr];
+  }
+
+  PL_MEMCPY(node->prefix, prefix, stored_length);
+  node->prefix_length = parent->prefix_length + 1 + node->prefix_length;
+}
+
+/*
+ * Grow() - Copies the node into a node of the next larger type
+ */
+ArtTree::Node *ArtTree::Grow(Node *node) {
+  Node *bigger_node = nullptr;
+  switch (node->type) {
+    case ART_NODE_4:
+      bigger_node = new Node16();
+      memory_footprint_ += sizeof(Node16);
+      break;
+    case ART_NODE_16:
+      bigger_node = new Node48();
+      memory_footprint_ += sizeof(Node48);
+      break;
+    case ART_NODE_48:
+      bigger_node = new Node256();
+      memory_footprint_ += sizeof(Node256);
+      break;
+    case ART_NODE_256:
+      PL_ASSERT(false);
+      return nullptr;
+  }
+
+  bigger_node->prefix_length = node->prefix_length;
+  PL_MEMCPY(bigger_node->prefix, node->prefix, ART_MAX_PREFIX_LENGTH);
+
+  ChildList children;
+  GetChildren(node, children);
+  for (auto &child : children) {
+    AddChild(bigger_node, child.first, child.second);
+  }
+  return bigger_node;
+}
+
+ArtTree::Node *ArtTree::NewLeaf(const std::string &key,
+                                std::vector<ValueType> &&values) {
+  Leaf *leaf = new Leaf(key, std::move(values));
+  memory_footprint_ += leaf->GetFootprint();
+  return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(leaf) | 1);
+}
+
+void ArtTree::FreeNode(Node *node) {
+  if (IsLeaf(node) == true) {
+    auto leaf = reinterpret_cast<Leaf *>(reinterpret_cast<uintptr_t>(node) &
+                                         ~static_cast<uintptr_t>(1));
+    memory_footprint_ -= leaf->GetFootprint();
+    delete leaf;
+    return;
+  }
+
+  switch (node->type) {
+    case ART_NODE_4:
+      memory_footprint_ -= sizeof(Node4);
+      delete static_cast<Node4 *>(node);
+      break;
+    case ART_NODE_16:
+      memory_footprint_ -= sizeof(Node16);
+      delete static_cast<Node16 *>(node);
+      break;
+    case ART_NODE_48:
+      memory_footprint_ -= sizeof(Node48);
+      delete static_cast<Node48 *>(node);
+      break;
+    case ART_NODE_256:
+      memory_footprint_ -= sizeof(Node256);
+      delete static_cast<Node256 *>(node);
+      break;
+  }
+}
+
+void ArtTree::FreeSubtree(Node *node) {
+  if (IsLeaf(node) == false) {
+    ChildList children;
+    GetChildren(node, children);
+    for (auto &child : children) {
+      FreeSubtree(child.second);
+    }
+  }
+  FreeNode(node);
+}
+
+//===--------------------------------------------------------------------===//
+// Epoch-based reclamation
+//===--------------------------------------------------------------------===//
+
+ArtTree::EpochGuard::EpochGuard(ArtTree *tree)
+    : tree_{tree}, slot_{tree->JoinEpoch()} {}
+
+ArtTree::EpochGuard::~EpochGuard() { tree_->LeaveEpoch(slot_); }
+
+/*
+ * JoinEpoch() - Registers the thread in the current epoch
+ *
+ * The epoch may move on between reading and registering, in which case
+ * the thread registers again
+ */
+uint64_t ArtTree::JoinEpoch() {
+  while (true) {
+    const uint64_t epoch = epoch_.load();
+    active_count_[epoch & 1].fetch_add(1);
+    if (epoch_.load() == epoch) {
+      return epoch & 1;
+    }
+    active_count_[epoch & 1].fetch_sub(1);
+  }
+}
+
+void ArtTree::LeaveEpoch(uint64_t slot) { active_count_[slot].fetch_sub(1); }
+
+/*
+ * Retire() - Hands an unlinked node over to the garbage collector
+ */
+void ArtTree::Retire(Node *node) {
+  std::lock_guard<std::mutex> lock(garbage_mutex_);
+  garbage_.emplace_back(epoch_.load(), node);
+  garbage_count_++;
+}
+
+/*
+ * PerformGC() - Frees the nodes retired before the current epoch, and
+ *               moves on to the next epoch
+ *
+ * The epoch only moves on once every thread of the previous epoch is gone,
+ * so every thread still in the tree joined after those nodes were unlinked
+ */
+void ArtTree::PerformGC() {
+  std::vector<Node *> free_list;
+  {
+    std::unique_lock<std::mutex> lock(garbage_mutex_, std::try_to_lock);
+    if (lock.owns_lock() == false) {
+      return;
+    }
+
+    const uint64_t epoch = epoch_.load();
+    if (active_count_[(epoch - 1) & 1].load() != 0) {
+      return;
+    }
+
+    size_t kept_count = 0;
+    for (auto &garbage : garbage_) {
+      if (garbage.first < epoch) {
+        free_list.push_back(garbage.second);
+      } else {
+        garbage_[kept_count++] = garbage;
+      }
+    }
+    garbage_.resize(kept_count);
+    garbage_count_ = kept_count;
+
+    epoch_.store(epoch + 1);
+  }
+
+  for (auto node : free_list) {
+    FreeNode(node);
+  }
+}
+
+void ArtTree::CollectGarbageIfNeeded() {
+  if (garbage_count_.load() >= ART_GC_THRESHOLD) {
+    PerformGC();
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Tree
+//===--------------------------------------------------------------------===//
+
+ArtTree::ArtTree()
+    : root_{new Node256()},
+      memory_footprint_{sizeof(Node256)},
+      epoch_{1},
+      garbage_count_{0} {
+  active_count_[0].store(0);
+  active_count_[1].store(0);
+}
+
+ArtTree::~ArtTree() {
+  FreeSubtree(root_);
+  for (auto &garbage : garbage_) {
+    FreeNode(garbage.second);
+  }
+}
+
+bool ArtTree::Insert(const std::string &key, ValueType value,
+                     const std::function<bool(const void *)> &predicate) {
+  bool inserted = false;
+  {
+    EpochGuard guard(this);
+    while (TryInsert(key, value, predicate, inserted) == false) {
+    }
+  }
+  CollectGarbageIfNeeded();
+  return inserted;
+}
+
+bool ArtTree::TryInsert(const std::string &key, ValueType value,
+                        const std::function<bool(const void *)> &predicate,
+                        bool &inserted) {
+  Node *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_key_byte = 0;
+  Node *node = root_;
+  uint64_t version;
+  size_t depth = 0;
+
+  if (ReadLockOrRestart(node, version) == false) {
+    return false;
+  }
+
+  while (true) {
+    const uint32_t prefix_length = node->prefix_length;
+
+    // Bytes past the ones kept in the node come from any of its leaves
+    const Leaf *any_leaf = nullptr;
+    if (prefix_length > ART_MAX_PREFIX_LENGTH) {
+      any_leaf = GetAnyLeaf(node);
+      if (any_leaf == nullptr ||
+          any_leaf->key.size() <= depth + prefix_length ||
+          CheckOrRestart(node, version) == false) {
+        return false;
+      }
+    }
+    auto prefix_byte = [&](uint32_t byte_itr) {
+      return byte_itr < ART_MAX_PREFIX_LENGTH
+                 ? node->prefix[byte_itr]
+                 : KeyByte(any_leaf->key, depth + byte_itr);
+    };
+
+    uint32_t match_length = 0;
+    while (match_length < prefix_length &&
+           depth + match_length < key.size() &&
+           prefix_byte(match_length) == KeyByte(key, depth + match_length)) {
+      match_length++;
+    }
+
+    if (match_length < prefix_length) {
+      // The key leaves the prefix of the node, which gets a new parent
+      // that branches at the first byte that differs
+      if (UpgradeToWriteLockOrRestart(parent, parent_version) == false) {
+        return false;
+      }
+      if (UpgradeToWriteLockOrRestart(node, version) == false) {
+        WriteUnlock(parent);
+        return false;
+      }
+      if (depth + match_length >= key.size()) {
+        WriteUnlock(node);
+        WriteUnlock(parent);
+        throw IndexException("ART key is a prefix of another key");
+      }
+
+      Node4 *branch_node = new Node4();
+      memory_footprint_ += sizeof(Node4);
+      branch_node->prefix_length = match_length;
+      for (uint32_t byte_itr = 0;
+           byte_itr < std::min(match_length, ART_MAX_PREFIX_LENGTH);
+           byte_itr++) {
+        branch_node->prefix[byte_itr] = KeyByte(key, depth + byte_itr);
+      }
+      AddChild(branch_node, KeyByte(key, depth + match_length),
+               NewLeaf(key, std::vector<ValueType>{value}));
+      AddChild(branch_node, prefix_byte(match_length), node);
+
+      // Cut what went into the new parent from the prefix of the node
+      uint8_t new_prefix[ART_MAX_PREFIX_LENGTH];
+      const uint32_t new_prefix_length = prefix_length - match_length - 1;
+      for (uint32_t byte_itr = 0;
+           byte_itr < std::min(new_prefix_length, ART_MAX_PREFIX_LENGTH);
+           byte_itr++) {
+        new_prefix[byte_itr] = prefix_byte(match_length + 1 + byte_itr);
+      }
+      PL_MEMCPY(node->prefix, new_prefix, ART_MAX_PREFIX_LENGTH);
+      node->prefix_length = new_prefix_length;
+
+      ChangeChild(parent, parent_key_byte, branch_node);
+      WriteUnlock(node);
+      WriteUnlock(parent);
+      inserted = true;
+      return true;
+    }
+
+    depth += prefix_length;
+    if (depth >= key.size()) {
+      if (CheckOrRestart(node, version) == false) {
+        return false;
+      }
+      throw IndexException("ART key is a prefix of another key");
+    }
+
+    const uint8_t key_byte = KeyByte(key, depth);
+    Node *next_node = FindChild(node, key_byte);
+    if (CheckOrRestart(node, version) == false) {
+      return false;
+    }
+
+    if (next_node == nullptr) {
+      if (IsFull(node) == true) {
+        // The root never fills up, so there is a parent to relink
+        if (UpgradeToWriteLockOrRestart(parent, parent_version) == false) {
+          return false;
+        }
+        if (UpgradeToWriteLockOrRestart(node, version) == false) {
+          WriteUnlock(parent);
+          return false;
+        }
+
+        Node *bigger_node = Grow(node);
+        AddChild(bigger_node, key_byte,
+                 NewLeaf(key, std::vector<ValueType>{value}));
+        ChangeChild(parent, parent_key_byte, bigger_node);
+
+        WriteUnlockObsolete(node);
+        WriteUnlock(parent);
+        Retire(node);
+      } else {
+        if (UpgradeToWriteLockOrRestart(node, version) == false) {
+          return false;
+        }
+        AddChild(node, key_byte, NewLeaf(key, std::vector<ValueType>{value}));
+        WriteUnlock(node);
+      }
+      inserted = true;
+      return true;
+    }
+
+    if (IsLeaf(next_node) == true) {
+      const Leaf *leaf = reinterpret_cast<const Leaf *>(
+          reinterpret_cast<uintptr_t>(next_node) &
+          ~static_cast<uintptr_t>(1));
+
+      if (UpgradeToWriteLockOrRestart(node, version) == false) {
+        return false;
+      }
+
+      if (leaf->key == key) {
+        // The predicate is checked under the lock of the node the leaf
+        // hangs off, so two inserts of a unique key can not both pass it
+        for (auto existing_value : leaf->values) {
+          if ((predicate && predicate(existing_value) == true) ||
+              (existing_value->block == value->block &&
+               existing_value->offset == value->offset)) {
+            WriteUnlock(node);
+            inserted = false;
+            return true;
+          }
+        }
+
+        std::vector<ValueType> values;
+        values.reserve(leaf->values.size() + 1);
+        values.insert(values.end(), leaf->values.begin(), leaf->values.end());
+        values.push_back(value);
+        ChangeChild(node, key_byte, NewLeaf(key, std::move(values)));
+        WriteUnlock(node);
+        Retire(next_node);
+      } else {
+        // Two keys now share the path to the leaf, they get a new node
+        // that branches at the first byte that differs
+        const size_t prefix_start = depth + 1;
+        uint32_t common_length = 0;
+        while (prefix_start + common_length < key.size() &&
+               prefix_start + common_length < leaf->key.size() &&
+               key[prefix_start + common_length] ==
+                   leaf->key[prefix_start + common_length]) {
+          common_length++;
+        }
+        if (prefix_start + common_length >= key.size() ||
+            prefix_start + common_length >= leaf->key.size()) {
+          WriteUnlock(node);
+          throw IndexException("ART key is a prefix of another key");
+        }
+
+        Node4 *branch_node = new Node4();
+        memory_footprint_ += sizeof(Node4);
+        branch_node->prefix_length = common_length;
+        for (uint32_t byte_itr = 0;
+             byte_itr < std::min(common_length, ART_MAX_PREFIX_LENGTH);
+             byte_itr++) {
+          branch_node->prefix[byte_itr] = KeyByte(key, prefix_start + byte_itr);
+        }
+        AddChild(branch_node, KeyByte(key, prefix_start + common_length),
+                 NewLeaf(key, std::vector<ValueType>{value}));
+        AddChild(branch_node, KeyByte(leaf->key, prefix_start + common_length),
+                 next_node);
+
+        ChangeChild(node, key_byte, branch_node);
+        WriteUnlock(node);
+      }
+      inserted = true;
+      return true;
+    }
+
+    depth++;
+    parent = node;
+    parent_version = version;
+    parent_key_byte = key_byte;
+    node = next_node;
+    if (ReadLockOrRestart(node, version) == false) {
+      return false;
+    }
+  }
+}
+
+bool ArtTree::Delete(const std::string &key, ValueType value) {
+  bool deleted = false;
+  {
+    EpochGuard guard(this);
+    while (TryDelete(key, value, deleted) == false) {
+    }
+  }
+  CollectGarbageIfNeeded();
+  return deleted;
+}
+
+bool ArtTree::TryDelete(const std::string &key, ValueType value,
+                        bool &deleted) {
+  Node *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_key_byte = 0;
+  Node *node = root_;
+  uint64_t version;
+  size_t depth = 0;
+
+  if (ReadLockOrRestart(node, version) == false) {
+    return false;
+  }
+
+  while (true) {
+    const uint32_t prefix_length = node->prefix_length;
+    if (PrefixMatches(node, prefix_length, key, depth) == false) {
+      deleted = false;
+      return CheckOrRestart(node, version);
+    }
+    depth += prefix_length;
+
+    const uint8_t key_byte = KeyByte(key, depth);
+    Node *next_node = FindChild(node, key_byte);
+    if (CheckOrRestart(node, version) == false) {
+      return false;
+    }
+
+    if (next_node == nullptr) {
+      deleted = false;
+      return true;
+    }
+
+    if (IsLeaf(next_node) == true) {
+      const Leaf *leaf = reinterpret_cast<const Leaf *>(
+          reinterpret_cast<uintptr_t>(next_node) &
+          ~static_cast<uintptr_t>(1));
+
+      auto value_itr = std::find_if(
+          leaf->values.begin(), leaf->values.end(),
+          [&](ValueType existing_value) {
+            return existing_value->block == value->block &&
+                   existing_value->offset == value->offset;
+          });
+      if (leaf->key != key || value_itr == leaf->values.end()) {
+        deleted = false;
+        return true;
+      }
+
+      if (leaf->values.size() > 1) {
+        if (UpgradeToWriteLockOrRestart(node, version) == false) {
+          return false;
+        }
+        std::vector<ValueType> values;
+        values.reserve(leaf->values.size() - 1);
+        values.insert(values.end(), leaf->values.begin(), value_itr);
+        values.insert(values.end(), value_itr + 1, leaf->values.end());
+        ChangeChild(node, key_byte, NewLeaf(key, std::move(values)));
+        WriteUnlock(node);
+      } else if (node->count == 2 && parent != nullptr) {
+        // The node would be left with a single child, which takes its
+        // place in the parent instead
+        if (UpgradeToWriteLockOrRestart(parent, parent_version) == false) {
+          return false;
+        }
+        if (UpgradeToWriteLockOrRestart(node, version) == false) {
+          WriteUnlock(parent);
+          return false;
+        }
+
+        uint8_t second_key_byte = 0;
+        Node *second_node = GetSecondChild(node, key_byte, second_key_byte);
+        PL_ASSERT(second_node != nullptr);
+        if (IsLeaf(second_node) == true) {
+          ChangeChild(parent, parent_key_byte, second_node);
+          WriteUnlock(parent);
+          WriteUnlockObsolete(node);
+        } else {
+          if (WriteLockOrRestart(second_node) == false) {
+            WriteUnlock(node);
+            WriteUnlock(parent);
+            return false;
+          }
+          ChangeChild(parent, parent_key_byte, second_node);
+          AddPrefixBefore(second_node, node, second_key_byte);
+          WriteUnlock(parent);
+          WriteUnlockObsolete(node);
+          WriteUnlock(second_node);
+        }
+        Retire(node);
+      } else {
+        if (UpgradeToWriteLockOrRestart(node, version) == false) {
+          return false;
+        }
+        RemoveChild(node, key_byte);
+        WriteUnlock(node);
+      }
+
+      Retire(next_node);
+      deleted = true;
+      return true;
+    }
+
+    depth++;
+    parent = node;
+    parent_version = version;
+    parent_key_byte = key_byte;
+    node = next_node;
+    if (ReadLockOrRestart(node, version) == false) {
+      return false;
+    }
+  }
+}
+
+void ArtTree::Lookup(const std::string &key, std::vector<ValueType> &result) {
+  EpochGuard guard(this);
+  const size_t result_size = result.size();
+  while (TryLookup(key, result) == false) {
+    result.resize(result_size);
+  }
+}
+
+bool ArtTree::TryLookup(const std::string &key,
+                        std::vector<ValueType> &result) {
+  Node *node = root_;
+  uint64_t version;
+  size_t depth = 0;
+
+  if (ReadLockOrRestart(node, version) == false) {
+    return false;
+  }
+
+  while (true) {
+    const uint32_t prefix_length = node->prefix_length;
+    if (PrefixMatches(node, prefix_length, key, depth) == false) {
+      return CheckOrRestart(node, version);
+    }
+    depth += prefix_length;
+
+    Node *next_node = FindChild(node, KeyByte(key, depth));
+    if (CheckOrRestart(node, version) == false) {
+      return false;
+    }
+
+    if (next_node == nullptr) {
+      return true;
+    }
+
+    if (IsLeaf(next_node) == true) {
+      const Leaf *leaf = reinterpret_cast<const Leaf *>(
+          reinterpret_cast<uintptr_t>(next_node) &
+          ~static_cast<uintptr_t>(1));
+      if (leaf->key == key) {
+        result.insert(result.end(), leaf->values.begin(), leaf->values.end());
+      }
+      return true;
+    }
+
+    depth++;
+    node = next_node;
+    if (ReadLockOrRestart(node, version) == false) {
+      return false;
+    }
+  }
+}
+
+void ArtTree::Scan(const std::string &low_key, const std::string *high_key,
+                   const ScanCallback &callback) {
+  EpochGuard guard(this);
+
+  // The leaves are collected first, and only handed out once the whole
+  // range was read without running into a concurrent change
+  std::vector<const Leaf *> leaves;
+  while (true) {
+    leaves.clear();
+    uint64_t version;
+    if (ReadLockOrRestart(root_, version) == true &&
+        ScanNode(root_, version, 0, low_key, high_key, true,
+                 high_key != nullptr, leaves) == true) {
+      break;
+    }
+  }
+
+  for (auto leaf : leaves) {
+    callback(leaf->key, leaf->values);
+  }
+}
+
+/*
+ * ScanNode() - Collects the leaves below the node that are in the range
+ *
+ * check_low (check_high) tells that the path to the node is the same as
+ * the low (high) key so far, and the bytes below still have to be compared
+ * with it. Subtrees that are out of range are skipped, the leaves are
+ * compared with the full keys.
+ */
+bool ArtTree::ScanNode(Node *node, uint64_t version, size_t depth,
+                       const std::string &low_key, const std::string *high_key,
+                       bool check_low, bool check_high,
+                       std::vector<const Leaf *> &leaves) {
+  const uint32_t prefix_length = node->prefix_length;
+
+  if ((check_low == true || check_high == true) && prefix_length > 0) {
+    const Leaf *any_leaf = nullptr;
+    if (prefix_length > ART_MAX_PREFIX_LENGTH) {
+      any_leaf = GetAnyLeaf(node);
+      if (any_leaf == nullptr ||
+          any_leaf->key.size() <= depth + prefix_length) {
+        return false;
+      }
+    }
+
+    for (uint32_t byte_itr = 0;
+         byte_itr < prefix_length && (check_low == true || check_high == true);
+         byte_itr++) {
+      const size_t position = depth + byte_itr;
+      const uint8_t prefix_byte = byte_itr < ART_MAX_PREFIX_LENGTH
+                                      ? node->prefix[byte_itr]
+                                      : KeyByte(any_leaf->key, position);
+
+      if (check_low == true) {
+        if (position >= low_key.size() ||
+            prefix_byte > KeyByte(low_key, position)) {
+          check_low = false;
+        } else if (prefix_byte < KeyByte(low_key, position)) {
+          return CheckOrRestart(node, version);
+        }
+      }
+
+      if (check_high == true) {
+        // Every key below is longer than the high key, and the same so far
+        if (position >= high_key->size() ||
+            prefix_byte > KeyByte(*high_key, position)) {
+          return CheckOrRestart(node, version);
+        } else if (prefix_byte < KeyByte(*high_key, position)) {
+          check_high = false;
+        }
+      }
+    }
+  }
+  depth += prefix_length;
+
+  ChildList children;
+  GetChildren(node, children);
+  if (CheckOrRestart(node, version) == false) {
+    return false;
+  }
+
+  for (auto &child : children) {
+    const uint8_t key_byte = child.first;
+    bool child_check_low = check_low;
+    bool child_check_high = check_high;
+
+    if (check_low == true) {
+      if (depth >= low_key.size() || key_byte > KeyByte(low_key, depth)) {
+        child_check_low = false;
+      } else if (key_byte < KeyByte(low_key, depth)) {
+        continue;
+      }
+    }
+
+    if (check_high == true) {
+      if (depth >= high_key->size() || key_byte > KeyByte(*high_key, depth)) {
+        break;
+      } else if (key_byte < KeyByte(*high_key, depth)) {
+        child_check_high = false;
+      }
+    }
+
+    if (IsLeaf(child.second) == true) {
+      const Leaf *leaf = reinterpret_cast<const Leaf *>(
+          reinterpret_cast<uintptr_t>(child.second) &
+          ~static_cast<uintptr_t>(1));
+      if ((child_check_low == false || leaf->key >= low_key) &&
+          (child_check_high == false || leaf->key <= *high_key)) {
+        leaves.push_back(leaf);
+      }
+      continue;
+    }
+
+    uint64_t child_version;
+    if (ReadLockOrRestart(child.second, child_version) == false ||
+        CheckOrRestart(node, version) == false) {
+      return false;
+    }
+    if (ScanNode(child.second, child_version, depth + 1, low_key, high_key,
+                 child_check_low, child_check_high, leaves) == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // End index namespace
+}  // End peloton namespace
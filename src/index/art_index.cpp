@@ -0,0 +1,229 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art_index.cpp
+//
+// Identification: src/index/art_index.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/logger.h"
+#include "index/art_index.h"
+#include "index/art_key.h"
+#include "storage/tuple.h"
+
+#include "index/scan_optimizer.h"
+#include "statistics/stats_aggregator.h"
+
+namespace peloton {
+namespace index {
+
+ArtIndex::ArtIndex(IndexMetadata *metadata) : Index{metadata}, container{} {}
+
+ArtIndex::~ArtIndex() {}
+
+/*
+ * InsertEntry() - insert a key-value pair into the tree
+ *
+ * If the key value pair already exists in the tree, just return false
+ */
+bool ArtIndex::InsertEntry(const storage::Tuple *key, ItemPointer *value) {
+  ArtKey index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = container.Insert(index_key.GetData(), value, nullptr);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * DeleteEntry() - Removes a key-value pair
+ *
+ * If the key-value pair does not exists yet in the tree return false
+ */
+bool ArtIndex::DeleteEntry(const storage::Tuple *key, ItemPointer *value) {
+  ArtKey index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = container.Delete(index_key.GetData(), value);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        ret == true ? 1 : 0, metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * CondInsertEntry() - insert the value unless the predicate holds for an
+ *                     existing value of the key
+ *
+ * The predicate is evaluated under the lock of the node the leaf of the key
+ * hangs off, so two transactions can not both pass it for the same unique
+ * key.
+ */
+bool ArtIndex::CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                               std::function<bool(const void *)> predicate) {
+  ArtKey index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = container.Insert(index_key.GetData(), value, predicate);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+template <typename KeyCallback>
+void ArtIndex::ScanEntries(const std::vector<type::Value> &value_list,
+                           const std::vector<oid_t> &tuple_column_id_list,
+                           const std::vector<ExpressionType> &expr_list,
+                           const ScanDirectionType &scan_direction,
+                           std::vector<ItemPointer *> &result,
+                           const ConjunctionScanPredicate *csp_p,
+                           KeyCallback key_callback) {
+  PL_ASSERT(tuple_column_id_list.size() == expr_list.size());
+  PL_ASSERT(tuple_column_id_list.size() == value_list.size());
+
+  if (scan_direction == SCAN_DIRECTION_TYPE_INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  LOG_TRACE("Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  if (csp_p->IsPointQuery() == true) {
+    const storage::Tuple *point_query_key_p = csp_p->GetPointQueryKey();
+
+    ArtKey point_query_key;
+    point_query_key.SetFromKey(point_query_key_p);
+
+    size_t value_count = result.size();
+    container.Lookup(point_query_key.GetData(), result);
+    key_callback(*point_query_key_p, result.size() - value_count);
+  } else {
+    // Keys are decoded into the same tuple one after another, the varlen
+    // values too long for the tuple go into a pool of the scan
+    type::VarlenPool pool(BACKEND_TYPE_MM);
+    storage::Tuple tuple(metadata->GetKeySchema(), true);
+    auto scan_callback = [&](const std::string &key,
+                             const std::vector<ItemPointer *> &values) {
+      ArtKey::GetTuple(key, tuple, &pool);
+
+      // The range of the scan is only narrowed down by the low and high
+      // keys, so the predicate has to be checked on every key in it
+      if (Compare(tuple, tuple_column_id_list, expr_list, value_list) ==
+          true) {
+        result.insert(result.end(), values.begin(), values.end());
+        key_callback(tuple, values.size());
+      }
+    };
+
+    if (csp_p->IsFullIndexScan() == true) {
+      container.Scan(std::string(), nullptr, scan_callback);
+    } else {
+      const storage::Tuple *low_key_p = csp_p->GetLowKey();
+      const storage::Tuple *high_key_p = csp_p->GetHighKey();
+
+      LOG_TRACE("Partial scan low key: %s\n high key: %s",
+                low_key_p->GetInfo().c_str(), high_key_p->GetInfo().c_str());
+
+      ArtKey index_low_key;
+      ArtKey index_high_key;
+      index_low_key.SetFromKey(low_key_p);
+      index_high_key.SetFromHighKey(high_key_p);
+
+      container.Scan(index_low_key.GetData(), &index_high_key.GetData(),
+                     scan_callback);
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(result.size(),
+                                                                  metadata);
+  }
+  return;
+}
+
+void ArtIndex::Scan(const std::vector<type::Value> &value_list,
+                    const std::vector<oid_t> &tuple_column_id_list,
+                    const std::vector<ExpressionType> &expr_list,
+                    const ScanDirectionType &scan_direction,
+                    std::vector<ItemPointer *> &result,
+                    const ConjunctionScanPredicate *csp_p) {
+  ScanEntries(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p,
+              [](UNUSED_ATTRIBUTE const storage::Tuple &key,
+                 UNUSED_ATTRIBUTE size_t value_count) {});
+}
+
+/*
+ * ScanKeyColumns() - Scan() that also returns the values of key_columns of
+ *                    the key of every entry found
+ *
+ * Every key decodes back into its values, whatever its columns are
+ */
+bool ArtIndex::ScanKeyColumns(const std::vector<type::Value> &value_list,
+                              const std::vector<oid_t> &tuple_column_id_list,
+                              const std::vector<ExpressionType> &expr_list,
+                              const ScanDirectionType &scan_direction,
+                              const ConjunctionScanPredicate *csp_p,
+                              const std::vector<oid_t> &key_columns,
+                              std::vector<ItemPointer *> &result,
+                              std::vector<type::Value> &key_values) {
+  ScanEntries(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p,
+              [&](const storage::Tuple &key, size_t value_count) {
+                for (size_t value_itr = 0; value_itr < value_count;
+                     value_itr++) {
+                  for (auto key_column : key_columns) {
+                    key_values.push_back(key.GetValue(key_column));
+                  }
+                }
+              });
+  return true;
+}
+
+void ArtIndex::ScanAllKeys(std::vector<ItemPointer *> &result) {
+  container.Scan(std::string(), nullptr,
+                 [&](UNUSED_ATTRIBUTE const std::string &key,
+                     const std::vector<ItemPointer *> &values) {
+                   result.insert(result.end(), values.begin(), values.end());
+                 });
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(result.size(),
+                                                                  metadata);
+  }
+  return;
+}
+
+void ArtIndex::ScanKey(const storage::Tuple *key,
+                       std::vector<ItemPointer *> &result) {
+  ArtKey index_key;
+  index_key.SetFromKey(key);
+
+  container.Lookup(index_key.GetData(), result);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(result.size(),
+                                                                  metadata);
+  }
+
+  return;
+}
+
+std::string ArtIndex::GetTypeName() const { return "ART"; }
+
+}  // End index namespace
+}  // End peloton namespace
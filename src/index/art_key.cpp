@@ -0,0 +1,265 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art_key.cpp
+//
+// Identification: src/index/art_key.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+
+#include "common/exception.h"
+#include "common/macros.h"
+#include "index/art_key.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace index {
+
+static const uint64_t SIGN_BIT_64 = 0x8000000000000000ULL;
+
+/*
+ * AppendBigEndian() - Appends the low byte_count bytes of value, most
+ *                     significant byte first
+ */
+static void AppendBigEndian(std::string &key_data, uint64_t value,
+                            const size_t byte_count) {
+  for (size_t byte_itr = byte_count; byte_itr > 0; byte_itr--) {
+    key_data.push_back(
+        static_cast<char>((value >> ((byte_itr - 1) * 8)) & 0xFF));
+  }
+}
+
+/*
+ * ReadBigEndian() - Reads byte_count bytes written by AppendBigEndian()
+ */
+static uint64_t ReadBigEndian(const std::string &key_data, size_t &offset,
+                              const size_t byte_count) {
+  if (offset + byte_count > key_data.size()) {
+    throw IndexException("Truncated ART key");
+  }
+
+  uint64_t value = 0;
+  for (size_t byte_itr = 0; byte_itr < byte_count; byte_itr++) {
+    value = (value << 8) | static_cast<uint8_t>(key_data[offset++]);
+  }
+  return value;
+}
+
+/*
+ * AppendSigned() - Flips the sign bit, which puts negative numbers before
+ *                  positive ones in unsigned order
+ */
+static void AppendSigned(std::string &key_data, const int64_t value,
+                         const size_t byte_count) {
+  const uint64_t sign_bit = 1ULL << (byte_count * 8 - 1);
+  AppendBigEndian(key_data, static_cast<uint64_t>(value) ^ sign_bit,
+                  byte_count);
+}
+
+static int64_t ReadSigned(const std::string &key_data, size_t &offset,
+                          const size_t byte_count) {
+  const uint64_t sign_bit = 1ULL << (byte_count * 8 - 1);
+  uint64_t value = ReadBigEndian(key_data, offset, byte_count) ^ sign_bit;
+
+  // Sign-extend to 64 bits
+  if (byte_count < sizeof(uint64_t) && (value & sign_bit) != 0) {
+    value |= ~((sign_bit << 1) - 1);
+  }
+  return static_cast<int64_t>(value);
+}
+
+void ArtKey::SetFromKey(const storage::Tuple *tuple) { Encode(tuple, false); }
+
+void ArtKey::SetFromHighKey(const storage::Tuple *tuple) {
+  Encode(tuple, true);
+}
+
+void ArtKey::Encode(const storage::Tuple *tuple, const bool high_key) {
+  PL_ASSERT(tuple != nullptr);
+  const catalog::Schema *key_schema = tuple->GetSchema();
+  const oid_t column_count = key_schema->GetColumnCount();
+
+  key_data.clear();
+  key_data.reserve(key_schema->GetLength() + column_count);
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    const type::Value value = tuple->GetValue(column_itr);
+
+    switch (key_schema->GetType(column_itr)) {
+      case type::Type::BOOLEAN:
+      case type::Type::TINYINT:
+        AppendSigned(key_data, value.GetAs<int8_t>(), sizeof(int8_t));
+        break;
+      case type::Type::SMALLINT:
+        AppendSigned(key_data, value.GetAs<int16_t>(), sizeof(int16_t));
+        break;
+      case type::Type::INTEGER:
+        AppendSigned(key_data, value.GetAs<int32_t>(), sizeof(int32_t));
+        break;
+      case type::Type::BIGINT:
+        AppendSigned(key_data, value.GetAs<int64_t>(), sizeof(int64_t));
+        break;
+      case type::Type::TIMESTAMP:
+        AppendBigEndian(key_data, value.GetAs<uint64_t>(), sizeof(uint64_t));
+        break;
+      case type::Type::DECIMAL: {
+        double double_value = value.GetAs<double>();
+        // -0.0 compares equal to 0.0, so both have to give the same key
+        if (double_value == 0.0) {
+          double_value = 0.0;
+        }
+        uint64_t bits;
+        PL_MEMCPY(&bits, &double_value, sizeof(bits));
+        bits = ((bits & SIGN_BIT_64) != 0) ? ~bits : (bits | SIGN_BIT_64);
+        AppendBigEndian(key_data, bits, sizeof(uint64_t));
+        break;
+      }
+      case type::Type::VARCHAR:
+      case type::Type::VARBINARY: {
+        if (value.IsNull() == true) {
+          if (high_key == true) {
+            // Nothing after this column can narrow the scan any more
+            key_data.push_back(static_cast<char>(0xFF));
+            return;
+          }
+          key_data.push_back(0x00);
+          break;
+        }
+
+        key_data.push_back(0x01);
+        const char *data = value.GetData();
+        const uint32_t length = value.GetLength();
+        for (uint32_t byte_itr = 0; byte_itr < length; byte_itr++) {
+          key_data.push_back(data[byte_itr]);
+          if (data[byte_itr] == 0x00) {
+            key_data.push_back(static_cast<char>(0xFF));
+          }
+        }
+        key_data.push_back(0x00);
+        key_data.push_back(0x00);
+        break;
+      }
+      default:
+        throw IndexException("ART index does not support key type " +
+                             TypeIdToString(key_schema->GetType(column_itr)));
+    }
+  }
+}
+
+void ArtKey::GetTuple(const std::string &key_data, storage::Tuple &tuple,
+                      type::VarlenPool *pool) {
+  const catalog::Schema *key_schema = tuple.GetSchema();
+  const oid_t column_count = key_schema->GetColumnCount();
+  size_t offset = 0;
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    const auto column_type = key_schema->GetType(column_itr);
+
+    switch (column_type) {
+      case type::Type::BOOLEAN:
+        tuple.SetValue(column_itr,
+                       type::ValueFactory::GetBooleanValue(static_cast<int8_t>(
+                           ReadSigned(key_data, offset, sizeof(int8_t)))),
+                       pool);
+        break;
+      case type::Type::TINYINT:
+        tuple.SetValue(column_itr,
+                       type::ValueFactory::GetTinyIntValue(static_cast<int8_t>(
+                           ReadSigned(key_data, offset, sizeof(int8_t)))),
+                       pool);
+        break;
+      case type::Type::SMALLINT:
+        tuple.SetValue(
+            column_itr,
+            type::ValueFactory::GetSmallIntValue(static_cast<int16_t>(
+                ReadSigned(key_data, offset, sizeof(int16_t)))),
+            pool);
+        break;
+      case type::Type::INTEGER:
+        tuple.SetValue(
+            column_itr,
+            type::ValueFactory::GetIntegerValue(static_cast<int32_t>(
+                ReadSigned(key_data, offset, sizeof(int32_t)))),
+            pool);
+        break;
+      case type::Type::BIGINT:
+        tuple.SetValue(column_itr,
+                       type::ValueFactory::GetBigIntValue(
+                           ReadSigned(key_data, offset, sizeof(int64_t))),
+                       pool);
+        break;
+      case type::Type::TIMESTAMP:
+        tuple.SetValue(column_itr,
+                       type::ValueFactory::GetTimestampValue(
+                           static_cast<int64_t>(ReadBigEndian(
+                               key_data, offset, sizeof(uint64_t)))),
+                       pool);
+        break;
+      case type::Type::DECIMAL: {
+        uint64_t bits = ReadBigEndian(key_data, offset, sizeof(uint64_t));
+        bits = ((bits & SIGN_BIT_64) != 0) ? (bits & ~SIGN_BIT_64) : ~bits;
+        double double_value;
+        PL_MEMCPY(&double_value, &bits, sizeof(bits));
+        tuple.SetValue(column_itr,
+                       type::ValueFactory::GetDoubleValue(double_value), pool);
+        break;
+      }
+      case type::Type::VARCHAR:
+      case type::Type::VARBINARY: {
+        if (offset >= key_data.size()) {
+          throw IndexException("Truncated ART key");
+        }
+        if (key_data[offset++] == 0x00) {
+          tuple.SetValue(column_itr,
+                         type::ValueFactory::GetNullValueByType(column_type),
+                         pool);
+          break;
+        }
+
+        std::string bytes;
+        while (true) {
+          if (offset + 1 >= key_data.size()) {
+            throw IndexException("Truncated ART key");
+          }
+          if (key_data[offset] != 0x00) {
+            bytes.push_back(key_data[offset++]);
+          } else if (key_data[offset + 1] == 0x00) {
+            offset += 2;
+            break;
+          } else {
+            bytes.push_back(0x00);
+            offset += 2;
+          }
+        }
+        if (column_type == type::Type::VARBINARY) {
+          tuple.SetValue(column_itr,
+                         type::ValueFactory::GetVarbinaryValue(
+                             reinterpret_cast<const unsigned char *>(
+                                 bytes.data()),
+                             bytes.size()),
+                         pool);
+        } else {
+          // Varchars are stored with their terminating \0, which the
+          // factory adds back
+          if (bytes.empty() == false && bytes.back() == '\0') {
+            bytes.pop_back();
+          }
+          tuple.SetValue(column_itr,
+                         type::ValueFactory::GetVarcharValue(bytes), pool);
+        }
+        break;
+      }
+      default:
+        throw IndexException("ART index does not support key type " +
+                             TypeIdToString(column_type));
+    }
+  }
+}
+
+}  // End index namespace
+}  // End peloton namespace
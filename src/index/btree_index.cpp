@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <type_traits>
+
 #include "index/btree_index.h"
 #include "index/index_key.h"
 #include "index/index_util.h"
@@ -46,7 +49,15 @@ bool BTREE_TEMPLATE_TYPE::InsertEntry(const storage::Tuple *key,
 
   index_key.SetFromKey(key);
 
-  std::pair<KeyType, ValueType> entry(index_key, value);
+  {
+    index_lock.WriteLock();
+
+    // Insert the key, val pair
+    container.insert(std::pair<KeyType, ValueType>(index_key, value));
+
+    index_lock.Unlock();
+  }
+
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
   }
@@ -141,12 +152,13 @@ bool BTREE_TEMPLATE_TYPE::CondInsertEntry(const storage::Tuple *key,
 /////////////////////////////////////////////////////////////////////
 
 BTREE_TEMPLATE_ARGUMENT
-void BTREE_TEMPLATE_TYPE::Scan(const std::vector<type::Value> &value_list,
-                               const std::vector<oid_t> &tuple_column_id_list,
-                               const std::vector<ExpressionType> &expr_list,
-                               const ScanDirectionType &scan_direction,
-                               std::vector<ValueType> &result,
-                               const ConjunctionScanPredicate *csp_p) {
+template <typename KeyCallback>
+void BTREE_TEMPLATE_TYPE::ScanEntries(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    const ScanDirectionType &scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p, KeyCallback key_callback) {
 
   // First make sure all three components of the scan predicate are
   // of the same length
@@ -159,6 +171,9 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<type::Value> &value_list,
     throw Exception("Invalid scan direction \n");
   }
 
+  // Scratch space the keys are unpacked into for the comparisons
+  std::vector<char> key_data(metadata->GetKeySchema()->GetLength());
+
   LOG_TRACE("Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
             csp_p->IsFullIndexScan());
 
@@ -181,10 +196,12 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<type::Value> &value_list,
     for (auto scan_itr = scan_begin_itr; scan_itr != scan_end_itr; scan_itr++) {
       auto scan_current_key = scan_itr->first;
       auto tuple =
-          scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+          scan_current_key.GetTupleForComparison(metadata->GetKeySchema(),
+                                                key_data.data());
 
       if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
         result.push_back(scan_itr->second);
+        key_callback(tuple, 1);
       }
     }
   } else if (csp_p->IsFullIndexScan() == true) {
@@ -195,7 +212,8 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<type::Value> &value_list,
       // Unpack the key as a standard tuple for comparison
       auto scan_current_key = scan_itr->first;
       auto tuple =
-          scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+          scan_current_key.GetTupleForComparison(metadata->GetKeySchema(),
+                                                key_data.data());
 
       // Compare whether the current key satisfies the predicate
       // since we just narrowed down search range using low key and
@@ -203,6 +221,7 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<type::Value> &value_list,
       // for which the predicate is not true
       if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
         result.push_back(scan_itr->second);
+        key_callback(tuple, 1);
       }
     }  // for it from begin() to end()
   } else {
@@ -223,10 +242,12 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<type::Value> &value_list,
     for (auto scan_itr = scan_begin_itr; scan_itr != scan_end_itr; scan_itr++) {
       auto scan_current_key = scan_itr->first;
       auto tuple =
-          scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+          scan_current_key.GetTupleForComparison(metadata->GetKeySchema(),
+                                                key_data.data());
 
       if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
         result.push_back(scan_itr->second);
+        key_callback(tuple, 1);
       }
     }
   }  // if is full scan
@@ -240,6 +261,52 @@ void BTREE_TEMPLATE_TYPE::Scan(const std::vector<type::Value> &value_list,
   return;
 }
 
+BTREE_TEMPLATE_ARGUMENT
+void BTREE_TEMPLATE_TYPE::Scan(const std::vector<type::Value> &value_list,
+                               const std::vector<oid_t> &tuple_column_id_list,
+                               const std::vector<ExpressionType> &expr_list,
+                               const ScanDirectionType &scan_direction,
+                               std::vector<ValueType> &result,
+                               const ConjunctionScanPredicate *csp_p) {
+  ScanEntries(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p,
+              [](UNUSED_ATTRIBUTE const storage::Tuple &key,
+                 UNUSED_ATTRIBUTE size_t value_count) {});
+}
+
+/*
+ * ScanKeyColumns() - Scan() that also returns the values of key_columns of
+ *                    the key of every entry found
+ *
+ * TupleKey only points to the tuple it was built from, which is long gone
+ * by now, so it does not have any keys to return
+ */
+BTREE_TEMPLATE_ARGUMENT
+bool BTREE_TEMPLATE_TYPE::ScanKeyColumns(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    const ScanDirectionType &scan_direction,
+    const ConjunctionScanPredicate *csp_p,
+    const std::vector<oid_t> &key_columns, std::vector<ValueType> &result,
+    std::vector<type::Value> &key_values) {
+  if (std::is_same<KeyType, TupleKey>::value == true) {
+    return false;
+  }
+
+  ScanEntries(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p,
+              [&](const storage::Tuple &key, size_t value_count) {
+                for (size_t value_itr = 0; value_itr < value_count;
+                     value_itr++) {
+                  for (auto key_column : key_columns) {
+                    key_values.push_back(key.GetValue(key_column));
+                  }
+                }
+              });
+  return true;
+}
+
 BTREE_TEMPLATE_ARGUMENT
 void BTREE_TEMPLATE_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
   {
@@ -289,6 +356,77 @@ void BTREE_TEMPLATE_TYPE::ScanKey(const storage::Tuple *key,
   }
 }
 
+/*
+ * ScanBatch() - Looks up the keys in key order under one read lock
+ *
+ * Keys close to the previous one are reached by stepping along the leaves
+ * instead of searching the tree again
+ */
+BTREE_TEMPLATE_ARGUMENT
+void BTREE_TEMPLATE_TYPE::ScanBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<std::vector<ValueType>> &results) {
+  results.resize(keys.size());
+  if (keys.empty() == true) {
+    return;
+  }
+
+  std::vector<KeyType> index_keys(keys.size());
+  std::vector<size_t> probe_order(keys.size());
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    index_keys[key_itr].SetFromKey(keys[key_itr]);
+    probe_order[key_itr] = key_itr;
+  }
+  std::sort(probe_order.begin(), probe_order.end(),
+            [&](const size_t &lhs, const size_t &rhs) {
+              return comparator(index_keys[lhs], index_keys[rhs]);
+            });
+
+  size_t value_count = 0;
+  {
+    index_lock.ReadLock();
+
+    size_t prev_key_itr = probe_order[0];
+    auto itr = container.lower_bound(index_keys[prev_key_itr]);
+    for (size_t probe_itr = 0; probe_itr < probe_order.size(); probe_itr++) {
+      size_t key_itr = probe_order[probe_itr];
+      const KeyType &probe_key = index_keys[key_itr];
+
+      // The same key again
+      if (probe_itr != 0 && equals(index_keys[prev_key_itr], probe_key)) {
+        results[key_itr] = results[prev_key_itr];
+        value_count += results[key_itr].size();
+        continue;
+      }
+      prev_key_itr = key_itr;
+
+      size_t step_count = 0;
+      while (itr != container.end() && comparator(itr->first, probe_key)) {
+        if (step_count == BATCH_SCAN_MAX_STEPS) {
+          itr = container.lower_bound(probe_key);
+          break;
+        }
+        ++itr;
+        step_count++;
+      }
+
+      while (itr != container.end() && equals(itr->first, probe_key)) {
+        PL_PREFETCH(itr->second);
+        results[key_itr].push_back(itr->second);
+        ++itr;
+      }
+      value_count += results[key_itr].size();
+    }
+
+    index_lock.Unlock();
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(value_count,
+                                                                  metadata);
+  }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 
 BTREE_TEMPLATE_ARGUMENT
@@ -296,6 +434,15 @@ std::string BTREE_TEMPLATE_TYPE::GetTypeName() const { return "Btree"; }
 
 // Explicit template instantiation
 
+template class BTreeIndex<IntsKey<1>, ItemPointer *, IntsComparator<1>,
+                          IntsEqualityChecker<1>>;
+template class BTreeIndex<IntsKey<2>, ItemPointer *, IntsComparator<2>,
+                          IntsEqualityChecker<2>>;
+template class BTreeIndex<IntsKey<3>, ItemPointer *, IntsComparator<3>,
+                          IntsEqualityChecker<3>>;
+template class BTreeIndex<IntsKey<4>, ItemPointer *, IntsComparator<4>,
+                          IntsEqualityChecker<4>>;
+
 template class BTreeIndex<GenericKey<4>, ItemPointer *, GenericComparator<4>,
                           GenericEqualityChecker<4>>;
 template class BTreeIndex<GenericKey<8>, ItemPointer *, GenericComparator<8>,
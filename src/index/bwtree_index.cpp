@@ -10,7 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <climits>
+#include <thread>
+#include <type_traits>
+
 #include "common/logger.h"
+#include "common/task_scheduler.h"
 #include "index/bwtree_index.h"
 #include "index/index_key.h"
 #include "storage/tuple.h"
@@ -118,28 +124,145 @@ bool BWTREE_INDEX_TYPE::CondInsertEntry(
   return ret;
 }
 
+/*
+ * BulkInsertEntries() - Inserts a batch of entries in key order
+ *
+ * The keys are converted and sorted by a few threads, each working on its
+ * own chunk of the batch. The sorted chunks are then merged pairwise in
+ * parallel. With exclusive access to an empty tree, the tree is built
+ * bottom up from the sorted run. Otherwise the entries are inserted one by
+ * one, which still benefits from the order since consecutive inserts go to
+ * the same leaf.
+ */
 BWTREE_TEMPLATE_ARGUMENTS
-void BWTREE_INDEX_TYPE::Scan(const std::vector<type::Value> &value_list,
-                             const std::vector<oid_t> &tuple_column_id_list,
-                             const std::vector<ExpressionType> &expr_list,
-                             const ScanDirectionType &scan_direction,
-                             std::vector<ValueType> &result,
-                             const ConjunctionScanPredicate *csp_p) {
+size_t BWTREE_INDEX_TYPE::BulkInsertEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+        entries,
+    const bool exclusive_access) {
+  using KeyValuePair = std::pair<KeyType, ValueType>;
+
+  // Sort by key, and then by location so that duplicates are adjacent
+  auto kvp_less = [this](const KeyValuePair &kvp1, const KeyValuePair &kvp2) {
+    if (comparator(kvp1.first, kvp2.first) == true) {
+      return true;
+    } else if (comparator(kvp2.first, kvp1.first) == true) {
+      return false;
+    }
+
+    return (kvp1.second->block < kvp2.second->block) ||
+           ((kvp1.second->block == kvp2.second->block) &&
+            (kvp1.second->offset < kvp2.second->offset));
+  };
+  auto kvp_equal = [this](const KeyValuePair &kvp1, const KeyValuePair &kvp2) {
+    return (equals(kvp1.first, kvp2.first) == true) &&
+           (kvp1.second->block == kvp2.second->block) &&
+           (kvp1.second->offset == kvp2.second->offset);
+  };
+
+  size_t entry_count = entries.size();
+  size_t thread_count = std::max(1U, std::thread::hardware_concurrency());
+  thread_count = std::max(
+      (size_t)1, std::min(thread_count, entry_count / BULK_LOAD_CHUNK_SIZE));
+
+  // Chunk i covers [chunk_begin[i], chunk_begin[i + 1])
+  std::vector<size_t> chunk_begin;
+  for (size_t chunk_itr = 0; chunk_itr <= thread_count; chunk_itr++) {
+    chunk_begin.push_back(chunk_itr * entry_count / thread_count);
+  }
+
+  std::vector<KeyValuePair> items(entry_count);
+  auto sort_chunk = [&](size_t chunk_itr) {
+    for (size_t entry_itr = chunk_begin[chunk_itr];
+         entry_itr < chunk_begin[chunk_itr + 1]; entry_itr++) {
+      items[entry_itr].first.SetFromKey(entries[entry_itr].first);
+      items[entry_itr].second = entries[entry_itr].second;
+    }
+    std::sort(items.begin() + chunk_begin[chunk_itr],
+              items.begin() + chunk_begin[chunk_itr + 1], kvp_less);
+  };
+
+  auto &task_scheduler = TaskScheduler::GetInstance();
+  TaskGroup sort_task_group;
+  for (size_t chunk_itr = 1; chunk_itr < thread_count; chunk_itr++) {
+    task_scheduler.Submit(sort_task_group,
+                          [&sort_chunk, chunk_itr] { sort_chunk(chunk_itr); });
+  }
+  sort_chunk(0);
+  task_scheduler.Wait(sort_task_group);
+
+  // Every round merges neighbouring pairs of sorted runs, which halves
+  // the number of runs
+  for (size_t run_size = 1; run_size < thread_count; run_size *= 2) {
+    TaskGroup merge_task_group;
+    for (size_t chunk_itr = 0; chunk_itr + run_size < thread_count;
+         chunk_itr += 2 * run_size) {
+      auto first = items.begin() + chunk_begin[chunk_itr];
+      auto middle = items.begin() + chunk_begin[chunk_itr + run_size];
+      auto last = items.begin() +
+                  chunk_begin[std::min(chunk_itr + 2 * run_size, thread_count)];
+      task_scheduler.Submit(merge_task_group, [first, middle, last, &kvp_less]() {
+        std::inplace_merge(first, middle, last, kvp_less);
+      });
+    }
+    task_scheduler.Wait(merge_task_group);
+  }
+
+  items.erase(std::unique(items.begin(), items.end(), kvp_equal), items.end());
+
+  size_t insert_count = 0;
+  if (exclusive_access == true && container.IsEmpty() == true) {
+    bool ret = container.BulkLoad(items);
+    PL_ASSERT(ret == true);
+    (void)ret;
+
+    insert_count = items.size();
+  } else {
+    for (auto &item : items) {
+      if (container.Insert(item.first, item.second) == true) {
+        insert_count++;
+      }
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(
+        insert_count, metadata);
+  }
+
+  return insert_count;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+template <typename KeyCallback>
+void BWTREE_INDEX_TYPE::ScanEntries(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    const ScanDirectionType &scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p, const uint64_t limit,
+    KeyCallback key_callback) {
   // First make sure all three components of the scan predicate are
   // of the same length
   // Since there is a 1-to-1 correspondense between these three vectors
   PL_ASSERT(tuple_column_id_list.size() == expr_list.size());
   PL_ASSERT(tuple_column_id_list.size() == value_list.size());
 
-  // This is a hack - we do not support backward scan
   if (scan_direction == SCAN_DIRECTION_TYPE_INVALID) {
     throw Exception("Invalid scan direction \n");
   }
 
-  LOG_TRACE("Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
-            csp_p->IsFullIndexScan());
+  // Scratch space the keys are unpacked into for the comparisons
+  std::vector<char> key_data(metadata->GetKeySchema()->GetLength());
 
-  if (csp_p->IsPointQuery() == true) {
+  // Without a predicate every entry is scanned
+  bool full_scan = (csp_p == nullptr) || (csp_p->IsFullIndexScan() == true);
+  bool backward = (scan_direction == SCAN_DIRECTION_TYPE_BACKWARD);
+  size_t result_begin = result.size();
+
+  LOG_TRACE("Full Scan = %d; Backward = %d; Limit = %lu", full_scan, backward,
+            limit);
+
+  if (full_scan == false && csp_p->IsPointQuery() == true) {
     // For point query we construct the key and use equal_range
 
     const storage::Tuple *point_query_key_p = csp_p->GetPointQueryKey();
@@ -152,17 +275,50 @@ void BWTREE_INDEX_TYPE::Scan(const std::vector<type::Value> &value_list,
     // this would induce an overhead for point query, which must be highly
     // optimized and super fast
     container.GetValue(point_query_key, result);
-  } else if (csp_p->IsFullIndexScan() == true) {
 
-    // If it is a full index scan, then just do the scan
-    // until we have reached the end of the index by the same
-    // we take the snapshot of the last leaf node
-    for (auto scan_itr = container.Begin(); (scan_itr.IsEnd() == false);
-         scan_itr++) {
+    // All the values share the key, so any of them could be returned
+    if (limit != 0 && result.size() - result_begin > limit) {
+      result.resize(result_begin + limit);
+    }
+    key_callback(*point_query_key_p, result.size() - result_begin);
+  } else {
+    // Construct low key and high key in KeyType form, rather than
+    // the standard in-memory tuple
+    KeyType index_low_key;
+    KeyType index_high_key;
+
+    if (full_scan == false) {
+      const storage::Tuple *low_key_p = csp_p->GetLowKey();
+      const storage::Tuple *high_key_p = csp_p->GetHighKey();
+
+      LOG_TRACE("Partial scan low key: %s\n high key: %s",
+                low_key_p->GetInfo().c_str(), high_key_p->GetInfo().c_str());
+
+      index_low_key.SetFromKey(low_key_p);
+      index_high_key.SetFromKey(high_key_p);
+    }
+
+    // We use bwtree Begin() to first reach the lower bound of the search
+    // key (or RBegin() to reach the upper bound if we go backward), and keep
+    // scanning until we have reached the end of the index or we have seen
+    // a key on the other side of the range
+    auto scan_itr =
+        backward ? (full_scan ? container.RBegin()
+                              : container.RBegin(index_high_key))
+                 : (full_scan ? container.Begin()
+                              : container.Begin(index_low_key));
+    while (scan_itr.IsEnd() == false) {
+      if (full_scan == false &&
+          (backward ? container.KeyCmpLess(scan_itr->first, index_low_key)
+                    : container.KeyCmpLess(index_high_key, scan_itr->first))) {
+        break;
+      }
+
       // Unpack the key as a standard tuple for comparison
       auto scan_current_key = scan_itr->first;
       auto tuple =
-          scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+          scan_current_key.GetTupleForComparison(metadata->GetKeySchema(),
+                                                key_data.data());
 
       // Compare whether the current key satisfies the predicate
       // since we just narrowed down search range using low key and
@@ -170,39 +326,20 @@ void BWTREE_INDEX_TYPE::Scan(const std::vector<type::Value> &value_list,
       // for which the predicate is not true
       if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
         result.push_back(scan_itr->second);
-      }
-    }  // for it from begin() to end()
-  } else {
-    const storage::Tuple *low_key_p = csp_p->GetLowKey();
-    const storage::Tuple *high_key_p = csp_p->GetHighKey();
-
-    LOG_TRACE("Partial scan low key: %s\n high key: %s",
-              low_key_p->GetInfo().c_str(), high_key_p->GetInfo().c_str());
+        key_callback(tuple, 1);
 
-    // Construct low key and high key in KeyType form, rather than
-    // the standard in-memory tuple
-    KeyType index_low_key;
-    KeyType index_high_key;
-    index_low_key.SetFromKey(low_key_p);
-    index_high_key.SetFromKey(high_key_p);
-
-    // We use bwtree Begin() to first reach the lower bound
-    // of the search key
-    // Also we keep scanning until we have reached the end of the index
-    // or we have seen a key higher than the high key
-    for (auto scan_itr = container.Begin(index_low_key);
-         (scan_itr.IsEnd() == false) &&
-             (container.KeyCmpLessEqual(scan_itr->first, index_high_key));
-         scan_itr++) {
-      auto scan_current_key = scan_itr->first;
-      auto tuple =
-          scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+        if (limit != 0 && result.size() - result_begin >= limit) {
+          break;
+        }
+      }
 
-      if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
-        result.push_back(scan_itr->second);
+      if (backward == true) {
+        --scan_itr;
+      } else {
+        ++scan_itr;
       }
     }
-  }  // if is full scan
+  }
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->IncrementIndexReads(result.size(),
@@ -211,6 +348,90 @@ void BWTREE_INDEX_TYPE::Scan(const std::vector<type::Value> &value_list,
   return;
 }
 
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::Scan(const std::vector<type::Value> &value_list,
+                             const std::vector<oid_t> &tuple_column_id_list,
+                             const std::vector<ExpressionType> &expr_list,
+                             const ScanDirectionType &scan_direction,
+                             std::vector<ValueType> &result,
+                             const ConjunctionScanPredicate *csp_p) {
+  ScanEntries(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p, 0,
+              [](UNUSED_ATTRIBUTE const storage::Tuple &key,
+                 UNUSED_ATTRIBUTE size_t value_count) {});
+}
+
+/*
+ * ScanLimit() - Scan() in key order that stops after limit entries
+ *
+ * BwTree iterates both ways, so the entries found are already in the order
+ * asked for, and the scan stops right after the last one of them. Like in
+ * ScanKeyColumns(), TupleKey has no keys to return.
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ScanLimit(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    const ScanDirectionType &scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p, const uint64_t limit,
+    std::vector<type::Value> *key_values) {
+  if (key_values == nullptr || std::is_same<KeyType, TupleKey>::value == true) {
+    ScanEntries(value_list, tuple_column_id_list, expr_list, scan_direction,
+                result, csp_p, limit,
+                [](UNUSED_ATTRIBUTE const storage::Tuple &key,
+                   UNUSED_ATTRIBUTE size_t value_count) {});
+    return true;
+  }
+
+  const oid_t key_column_count = metadata->GetKeySchema()->GetColumnCount();
+  ScanEntries(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p, limit,
+              [&](const storage::Tuple &key, size_t value_count) {
+                for (size_t value_itr = 0; value_itr < value_count;
+                     value_itr++) {
+                  for (oid_t key_column = 0; key_column < key_column_count;
+                       key_column++) {
+                    key_values->push_back(key.GetValue(key_column));
+                  }
+                }
+              });
+  return true;
+}
+
+/*
+ * ScanKeyColumns() - Scan() that also returns the values of key_columns of
+ *                    the key of every entry found
+ *
+ * TupleKey only points to the tuple it was built from, which is long gone
+ * by now, so it does not have any keys to return
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::ScanKeyColumns(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    const ScanDirectionType &scan_direction,
+    const ConjunctionScanPredicate *csp_p,
+    const std::vector<oid_t> &key_columns, std::vector<ValueType> &result,
+    std::vector<type::Value> &key_values) {
+  if (std::is_same<KeyType, TupleKey>::value == true) {
+    return false;
+  }
+
+  ScanEntries(value_list, tuple_column_id_list, expr_list, scan_direction,
+              result, csp_p, 0,
+              [&](const storage::Tuple &key, size_t value_count) {
+                for (size_t value_itr = 0; value_itr < value_count;
+                     value_itr++) {
+                  for (auto key_column : key_columns) {
+                    key_values.push_back(key.GetValue(key_column));
+                  }
+                }
+              });
+  return true;
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 void BWTREE_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
   auto it = container.Begin();
@@ -245,43 +466,137 @@ void BWTREE_INDEX_TYPE::ScanKey(const storage::Tuple *key,
   return;
 }
 
+/*
+ * ScanBatch() - Looks up the keys in key order with a single iterator
+ *
+ * The iterator steps forward to the next key if it is close by, and only
+ * goes through the tree again if it is not. The locations found are
+ * prefetched, since the caller dereferences all of them next.
+ */
 BWTREE_TEMPLATE_ARGUMENTS
-std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
+void BWTREE_INDEX_TYPE::ScanBatch(
+    const std::vector<const storage::Tuple *> &keys,
+    std::vector<std::vector<ValueType>> &results) {
+  results.resize(keys.size());
+  if (keys.empty() == true) {
+    return;
+  }
+
+  std::vector<KeyType> index_keys(keys.size());
+  std::vector<size_t> probe_order(keys.size());
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    index_keys[key_itr].SetFromKey(keys[key_itr]);
+    probe_order[key_itr] = key_itr;
+  }
+  std::sort(probe_order.begin(), probe_order.end(),
+            [&](const size_t &lhs, const size_t &rhs) {
+              return container.KeyCmpLess(index_keys[lhs], index_keys[rhs]);
+            });
+
+  size_t value_count = 0;
+  size_t prev_key_itr = probe_order[0];
+  auto scan_itr = container.Begin(index_keys[prev_key_itr]);
+  for (size_t probe_itr = 0; probe_itr < probe_order.size(); probe_itr++) {
+    size_t key_itr = probe_order[probe_itr];
+    const KeyType &probe_key = index_keys[key_itr];
+
+    // The same key again
+    if (probe_itr != 0 &&
+        container.KeyCmpEqual(index_keys[prev_key_itr], probe_key) == true) {
+      results[key_itr] = results[prev_key_itr];
+      value_count += results[key_itr].size();
+      continue;
+    }
+    prev_key_itr = key_itr;
+
+    size_t step_count = 0;
+    while (scan_itr.IsEnd() == false &&
+           container.KeyCmpLess(scan_itr->first, probe_key) == true) {
+      if (step_count == BATCH_SCAN_MAX_STEPS) {
+        scan_itr = container.Begin(probe_key);
+        break;
+      }
+      scan_itr++;
+      step_count++;
+    }
+
+    while (scan_itr.IsEnd() == false &&
+           container.KeyCmpEqual(scan_itr->first, probe_key) == true) {
+      PL_PREFETCH(scan_itr->second);
+      results[key_itr].push_back(scan_itr->second);
+      scan_itr++;
+    }
+    value_count += results[key_itr].size();
+  }
 
-// NOTE: If ints key is used as an optimization just uncommend
-// the following in order to instanciation the template before it is
-// linked in linking stage
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(value_count,
+                                                                  metadata);
+  }
+}
 
 /*
-template class BWTreeIndex<IntsKey<1>,
-                           ItemPointer *,
-                           IntsComparator<1>,
-                           IntsEqualityChecker<1>,
-                           IntsHasher<1>,
-                           ItemPointerComparator,
-                           ItemPointerHashFunc>;
-template class BWTreeIndex<IntsKey<2>,
-                           ItemPointer *,
-                           IntsComparator<2>,
-                           IntsEqualityChecker<2>,
-                           IntsHasher<2>,
-                           ItemPointerComparator,
-                           ItemPointerHashFunc>;
-template class BWTreeIndex<IntsKey<3>,
-                           ItemPointer *,
-                           IntsComparator<3>,
-                           IntsEqualityChecker<3>,
-                           IntsHasher<3>,
-                           ItemPointerComparator,
-                           ItemPointerHashFunc>;
-template class BWTreeIndex<IntsKey<4>,
-                           ItemPointer *,
-                           IntsComparator<4>,
-                           IntsEqualityChecker<4>,
-                           IntsHasher<4>,
-                           ItemPointerComparator,
-                           ItemPointerHashFunc>;
-*/
+ * GetStructureStats() - Counts the nodes and delta records of the tree
+ *
+ * This walks the whole mapping table, so it is meant for the stats
+ * aggregator and not for the query path
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::GetStructureStats(IndexStructureStats &stats) {
+  typename MapType::StructureStats tree_stats;
+  container.GetStructureStats(&tree_stats);
+
+  stats.node_count = tree_stats.node_count;
+  stats.avg_delta_chain_length =
+      tree_stats.node_count == 0
+          ? 0.0
+          : static_cast<double>(tree_stats.delta_record_count) /
+                tree_stats.node_count;
+  stats.garbage_byte_count = tree_stats.garbage_byte_count;
+  stats.consolidation_count = tree_stats.consolidation_count;
+  stats.split_count = tree_stats.split_count;
+
+  return true;
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::SetConsolidationThreshold(
+    const size_t leaf_threshold, const size_t inner_threshold) {
+  if (leaf_threshold > INT_MAX || inner_threshold > INT_MAX) {
+    return false;
+  }
+
+  return container.SetConsolidationThreshold(
+      static_cast<int>(leaf_threshold), static_cast<int>(inner_threshold));
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+bool BWTREE_INDEX_TYPE::SetSplitThreshold(const size_t leaf_threshold,
+                                          const size_t inner_threshold) {
+  if (leaf_threshold > INT_MAX || inner_threshold > INT_MAX) {
+    return false;
+  }
+
+  return container.SetSplitThreshold(static_cast<int>(leaf_threshold),
+                                     static_cast<int>(inner_threshold));
+}
+
+BWTREE_TEMPLATE_ARGUMENTS
+std::string BWTREE_INDEX_TYPE::GetTypeName() const { return "BWTree"; }
+
+// Ints key
+template class BWTreeIndex<IntsKey<1>, ItemPointer *, IntsComparator<1>,
+                           IntsEqualityChecker<1>, IntsHasher<1>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
+template class BWTreeIndex<IntsKey<2>, ItemPointer *, IntsComparator<2>,
+                           IntsEqualityChecker<2>, IntsHasher<2>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
+template class BWTreeIndex<IntsKey<3>, ItemPointer *, IntsComparator<3>,
+                           IntsEqualityChecker<3>, IntsHasher<3>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
+template class BWTreeIndex<IntsKey<4>, ItemPointer *, IntsComparator<4>,
+                           IntsEqualityChecker<4>, IntsHasher<4>,
+                           ItemPointerComparator, ItemPointerHashFunc>;
 
 // Generic key
 template class BWTreeIndex<GenericKey<4>, ItemPointer *, GenericComparator<4>,
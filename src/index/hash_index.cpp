@@ -0,0 +1,289 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.cpp
+//
+// Identification: src/index/hash_index.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>
+
+#include "common/logger.h"
+#include "index/hash_index.h"
+#include "index/index_key.h"
+#include "storage/tuple.h"
+
+#include "index/scan_optimizer.h"
+#include "statistics/stats_aggregator.h"
+
+namespace peloton {
+namespace index {
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::HashIndex(IndexMetadata *metadata)
+    : Index{metadata}, container{} {}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::~HashIndex() {}
+
+/*
+ * InsertEntry() - insert a key-value pair into the map
+ *
+ * If the key value pair already exists in the map, just return false
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret;
+  bool key_erased;
+  do {
+    ret = true;
+    key_erased = false;
+
+    container.Upsert(index_key, [&](std::vector<ValueType> &values) {
+      // The last value of the key is gone, and the deleter is about to
+      // erase the key. Wait for it instead of losing our value.
+      if (values.empty()) {
+        key_erased = true;
+        return;
+      }
+
+      for (auto existing_value : values) {
+        if (existing_value->block == value->block &&
+            existing_value->offset == value->offset) {
+          ret = false;
+          return;
+        }
+      }
+      values.push_back(value);
+    }, std::vector<ValueType>{value});
+
+    if (key_erased == true) {
+      std::this_thread::yield();
+    }
+  } while (key_erased == true);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * DeleteEntry() - Removes a key-value pair
+ *
+ * If the key-value pair does not exists yet in the map return false
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+  size_t delete_count = 0;
+  bool key_emptied = false;
+
+  container.UpdateFn(index_key, [&](std::vector<ValueType> &values) {
+    for (size_t value_itr = 0; value_itr < values.size(); value_itr++) {
+      if (values[value_itr]->block == value->block &&
+          values[value_itr]->offset == value->offset) {
+        values[value_itr] = values.back();
+        values.pop_back();
+        delete_count++;
+        break;
+      }
+    }
+    key_emptied = (delete_count != 0 && values.empty());
+  });
+
+  // Only the deleter that emptied the key erases it, inserters of the same
+  // key spin until it is gone
+  if (key_emptied == true) {
+    container.Erase(index_key);
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        delete_count, metadata);
+  }
+  return delete_count != 0;
+}
+
+/*
+ * CondInsertEntry() - insert the value unless the predicate holds for an
+ *                     existing value of the key
+ *
+ * The predicate is evaluated under the bucket lock of the key, so two
+ * transactions can not both pass it for the same unique key.
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::CondInsertEntry(
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool predicate_satisfied;
+  bool key_erased;
+  do {
+    predicate_satisfied = false;
+    key_erased = false;
+
+    container.Upsert(index_key, [&](std::vector<ValueType> &values) {
+      if (values.empty()) {
+        key_erased = true;
+        return;
+      }
+
+      for (auto existing_value : values) {
+        if (predicate(existing_value) == true) {
+          predicate_satisfied = true;
+          return;
+        }
+      }
+      values.push_back(value);
+    }, std::vector<ValueType>{value});
+
+    if (key_erased == true) {
+      std::this_thread::yield();
+    }
+  } while (key_erased == true);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return predicate_satisfied == false;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::Scan(const std::vector<type::Value> &value_list,
+                           const std::vector<oid_t> &tuple_column_id_list,
+                           const std::vector<ExpressionType> &expr_list,
+                           const ScanDirectionType &scan_direction,
+                           std::vector<ValueType> &result,
+                           const ConjunctionScanPredicate *csp_p) {
+  PL_ASSERT(tuple_column_id_list.size() == expr_list.size());
+  PL_ASSERT(tuple_column_id_list.size() == value_list.size());
+
+  if (scan_direction == SCAN_DIRECTION_TYPE_INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  // Scratch space the keys are unpacked into for the comparisons
+  std::vector<char> key_data(metadata->GetKeySchema()->GetLength());
+
+  LOG_TRACE("Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  if (csp_p->IsPointQuery() == true) {
+    KeyType point_query_key;
+    point_query_key.SetFromKey(csp_p->GetPointQueryKey());
+
+    GetValues(point_query_key, result);
+  } else {
+    // Hashing does not keep any order, so everything else has to look
+    // at all the keys
+    container.ForEach([&](const KeyType &key,
+                          const std::vector<ValueType> &values) {
+      // Unpack the key as a standard tuple for comparison
+      auto scan_current_key = key;
+      auto tuple =
+          scan_current_key.GetTupleForComparison(metadata->GetKeySchema(),
+                                                key_data.data());
+
+      if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
+        result.insert(result.end(), values.begin(), values.end());
+      }
+    });
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(result.size(),
+                                                                  metadata);
+  }
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
+  container.ForEach([&](UNUSED_ATTRIBUTE const KeyType &key,
+                        const std::vector<ValueType> &values) {
+    result.insert(result.end(), values.begin(), values.end());
+  });
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(result.size(),
+                                                                  metadata);
+  }
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanKey(const storage::Tuple *key,
+                              std::vector<ValueType> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  GetValues(index_key, result);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(result.size(),
+                                                                  metadata);
+  }
+
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::GetValues(const KeyType &index_key,
+                                std::vector<ValueType> &result) {
+  // Find() copies the values while holding the bucket lock
+  std::vector<ValueType> values;
+  if (container.Find(index_key, values) == false) {
+    return false;
+  }
+
+  result.insert(result.end(), values.begin(), values.end());
+  return true;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+size_t HASH_INDEX_TYPE::GetMemoryFootprint() {
+  size_t footprint = 0;
+  container.ForEach([&](UNUSED_ATTRIBUTE const KeyType &key,
+                        const std::vector<ValueType> &values) {
+    footprint += sizeof(KeyType) + sizeof(std::vector<ValueType>) +
+                 values.capacity() * sizeof(ValueType);
+  });
+  return footprint;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+std::string HASH_INDEX_TYPE::GetTypeName() const { return "Hash"; }
+
+// Generic key
+template class HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                         GenericEqualityChecker<4>>;
+template class HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                         GenericEqualityChecker<8>>;
+template class HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                         GenericEqualityChecker<16>>;
+template class HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                         GenericEqualityChecker<64>>;
+template class HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                         GenericEqualityChecker<256>>;
+
+// Tuple key
+template class HashIndex<TupleKey, ItemPointer *, TupleKeyHasher,
+                         TupleKeyEqualityChecker>;
+
+}  // End index namespace
+}  // End peloton namespace
@@ -15,6 +15,7 @@
 #include "catalog/schema.h"
 #include "common/exception.h"
 #include "common/logger.h"
+#include "expression/abstract_expression.h"
 #include "type/varlen_pool.h"
 #include "storage/tuple.h"
 
@@ -81,10 +82,60 @@ IndexMetadata::IndexMetadata(
   return;
 }
 
+/*
+ * SetIncludedColumnCount() - Marks the last columns of the key as included
+ *
+ * The key of a unique index has to be unique on its own, so it can not
+ * carry included columns which would take part in the comparison
+ */
+void IndexMetadata::SetIncludedColumnCount(
+    const oid_t p_included_column_count) {
+  if (p_included_column_count >= key_attrs.size()) {
+    throw Exception("Index " + index_name + " needs at least one key column");
+  }
+  if (p_included_column_count != 0 &&
+      (index_type == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY ||
+       index_type == INDEX_CONSTRAINT_TYPE_UNIQUE)) {
+    throw Exception("Unique index " + index_name +
+                    " can not have included columns");
+  }
+
+  included_column_count = p_included_column_count;
+}
+
+/*
+ * SetPredicate() - Makes the index a partial index
+ *
+ * A primary key has to find every tuple of the table, so it can not be
+ * partial. A unique partial index only enforces uniqueness among the
+ * tuples it covers
+ */
+void IndexMetadata::SetPredicate(expression::AbstractExpression *p_predicate) {
+  if (p_predicate != nullptr &&
+      index_type == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+    delete p_predicate;
+    throw Exception("Primary key index " + index_name + " can not be partial");
+  }
+
+  delete predicate;
+  predicate = p_predicate;
+}
+
+bool IndexMetadata::CoversTuple(const AbstractTuple *tuple) const {
+  if (predicate == nullptr) {
+    return true;
+  }
+
+  return predicate->Evaluate(tuple, nullptr, nullptr).IsTrue();
+}
+
 IndexMetadata::~IndexMetadata() {
   // clean up key schema
   delete key_schema;
 
+  // the predicate of a partial index
+  delete predicate;
+
   // no need to clean the tuple schema
   return;
 }
@@ -102,6 +153,10 @@ const std::string IndexMetadata::GetInfo() const {
 
   os << utility_ratio;
 
+  if (predicate != nullptr) {
+    os << " :: PARTIAL";
+  }
+
   return os.str();
 }
 
@@ -117,7 +172,7 @@ const std::string IndexMetadata::GetInfo() const {
  * for destructing the metadata object on its own destruction
  */
 Index::Index(IndexMetadata *metadata)
-    : metadata(metadata), indexed_tile_group_offset(0) {
+    : metadata(metadata), indexed_tile_group_offset(0), ready(true) {
   // This is redundant
   index_oid = metadata->GetOid();
 
@@ -145,6 +200,23 @@ Index::~Index() {
   return;
 }
 
+/*
+ * BulkInsertEntries() - Inserts the entries one after another
+ */
+size_t Index::BulkInsertEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+        entries,
+    UNUSED_ATTRIBUTE const bool exclusive_access) {
+  size_t insert_count = 0;
+  for (auto &entry : entries) {
+    if (InsertEntry(entry.first, entry.second) == true) {
+      insert_count++;
+    }
+  }
+
+  return insert_count;
+}
+
 void Index::ScanTest(const std::vector<type::Value> &value_list,
                      const std::vector<oid_t> &tuple_column_id_list,
                      const std::vector<ExpressionType> &expr_list,
@@ -161,6 +233,65 @@ void Index::ScanTest(const std::vector<type::Value> &value_list,
   return;
 }
 
+/*
+ * ScanKeyColumns() - Indexes do not return their keys unless they say so
+ */
+bool Index::ScanKeyColumns(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    UNUSED_ATTRIBUTE const ScanDirectionType &scan_direction,
+    UNUSED_ATTRIBUTE const ConjunctionScanPredicate *csp_p,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &key_columns,
+    UNUSED_ATTRIBUTE std::vector<ItemPointer *> &result,
+    UNUSED_ATTRIBUTE std::vector<type::Value> &key_values) {
+  return false;
+}
+
+/*
+ * ScanLimit() - Only ordered indexes that say so scan in key order
+ */
+bool Index::ScanLimit(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    UNUSED_ATTRIBUTE const ScanDirectionType &scan_direction,
+    UNUSED_ATTRIBUTE std::vector<ItemPointer *> &result,
+    UNUSED_ATTRIBUTE const ConjunctionScanPredicate *csp_p,
+    UNUSED_ATTRIBUTE const uint64_t limit,
+    UNUSED_ATTRIBUTE std::vector<type::Value> *key_values) {
+  return false;
+}
+
+/*
+ * ScanBatch() - Looks up the keys one by one unless the index knows better
+ */
+void Index::ScanBatch(const std::vector<const storage::Tuple *> &keys,
+                      std::vector<std::vector<ItemPointer *>> &results) {
+  results.resize(keys.size());
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    ScanKey(keys[key_itr], results[key_itr]);
+  }
+}
+
+/*
+ * GetStructureStats() - Only indexes built of delta chains keep these
+ */
+bool Index::GetStructureStats(UNUSED_ATTRIBUTE IndexStructureStats &stats) {
+  return false;
+}
+
+bool Index::SetConsolidationThreshold(
+    UNUSED_ATTRIBUTE const size_t leaf_threshold,
+    UNUSED_ATTRIBUTE const size_t inner_threshold) {
+  return false;
+}
+
+bool Index::SetSplitThreshold(UNUSED_ATTRIBUTE const size_t leaf_threshold,
+                              UNUSED_ATTRIBUTE const size_t inner_threshold) {
+  return false;
+}
+
 /*
  * Compare() - Check whether a given index key satisfies a predicate
  *
@@ -17,8 +17,10 @@
 #include "common/macros.h"
 #include "index/index_factory.h"
 #include "index/index_key.h"
+#include "index/art_index.h"
 #include "index/btree_index.h"
 #include "index/bwtree_index.h"
+#include "index/hash_index.h"
 
 namespace peloton {
 namespace index {
@@ -34,8 +36,25 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
   auto index_type = metadata->GetIndexMethodType();
   LOG_TRACE("Index type : %d", index_type);
 
+  // Integer-only keys are packed into a few uint64_ts, which are compared
+  // directly instead of going through type::Value
+  const auto ints_key_size = GetIntsKeySize(metadata->key_schema);
+  LOG_TRACE("Ints key size : %lu", ints_key_size);
+
   if (index_type == INDEX_TYPE_BTREE) {
-    if (key_size <= 4) {
+    if (ints_key_size == 1) {
+      return new BTreeIndex<IntsKey<1>, ItemPointer *, IntsComparator<1>,
+                            IntsEqualityChecker<1>>(metadata);
+    } else if (ints_key_size == 2) {
+      return new BTreeIndex<IntsKey<2>, ItemPointer *, IntsComparator<2>,
+                            IntsEqualityChecker<2>>(metadata);
+    } else if (ints_key_size == 3) {
+      return new BTreeIndex<IntsKey<3>, ItemPointer *, IntsComparator<3>,
+                            IntsEqualityChecker<3>>(metadata);
+    } else if (ints_key_size == 4) {
+      return new BTreeIndex<IntsKey<4>, ItemPointer *, IntsComparator<4>,
+                            IntsEqualityChecker<4>>(metadata);
+    } else if (key_size <= 4) {
       return new BTreeIndex<GenericKey<4>, ItemPointer *, GenericComparator<4>,
                             GenericEqualityChecker<4>>(metadata);
     } else if (key_size <= 8) {
@@ -58,7 +77,27 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
                             TupleKeyEqualityChecker>(metadata);
     }
   } else if (index_type == INDEX_TYPE_BWTREE) {
-    if (key_size <= 4) {
+    if (ints_key_size == 1) {
+      return new BWTreeIndex<IntsKey<1>, ItemPointer *, IntsComparator<1>,
+                             IntsEqualityChecker<1>, IntsHasher<1>,
+                             ItemPointerComparator, ItemPointerHashFunc>(
+          metadata);
+    } else if (ints_key_size == 2) {
+      return new BWTreeIndex<IntsKey<2>, ItemPointer *, IntsComparator<2>,
+                             IntsEqualityChecker<2>, IntsHasher<2>,
+                             ItemPointerComparator, ItemPointerHashFunc>(
+          metadata);
+    } else if (ints_key_size == 3) {
+      return new BWTreeIndex<IntsKey<3>, ItemPointer *, IntsComparator<3>,
+                             IntsEqualityChecker<3>, IntsHasher<3>,
+                             ItemPointerComparator, ItemPointerHashFunc>(
+          metadata);
+    } else if (ints_key_size == 4) {
+      return new BWTreeIndex<IntsKey<4>, ItemPointer *, IntsComparator<4>,
+                             IntsEqualityChecker<4>, IntsHasher<4>,
+                             ItemPointerComparator, ItemPointerHashFunc>(
+          metadata);
+    } else if (key_size <= 4) {
       return new BWTreeIndex<GenericKey<4>, ItemPointer *, GenericComparator<4>,
                              GenericEqualityChecker<4>, GenericHasher<4>,
                              ItemPointerComparator, ItemPointerHashFunc>(
@@ -89,6 +128,29 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
           TupleKey, ItemPointer *, TupleKeyComparator, TupleKeyEqualityChecker,
           TupleKeyHasher, ItemPointerComparator, ItemPointerHashFunc>(metadata);
     }
+  } else if (index_type == INDEX_TYPE_HASH) {
+    if (key_size <= 4) {
+      return new HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                           GenericEqualityChecker<4>>(metadata);
+    } else if (key_size <= 8) {
+      return new HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                           GenericEqualityChecker<8>>(metadata);
+    } else if (key_size <= 16) {
+      return new HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                           GenericEqualityChecker<16>>(metadata);
+    } else if (key_size <= 64) {
+      return new HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                           GenericEqualityChecker<64>>(metadata);
+    } else if (key_size <= 256) {
+      return new HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                           GenericEqualityChecker<256>>(metadata);
+    } else {
+      return new HashIndex<TupleKey, ItemPointer *, TupleKeyHasher,
+                           TupleKeyEqualityChecker>(metadata);
+    }
+  } else if (index_type == INDEX_TYPE_ART) {
+    // Keys of any size are encoded into byte strings
+    return new ArtIndex(metadata);
   } else {
     throw IndexException("Unsupported index scheme.");
   }
@@ -96,5 +158,28 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
   return NULL;
 }
 
+size_t IndexFactory::GetIntsKeySize(const catalog::Schema *key_schema) {
+  size_t key_length = 0;
+  for (auto &column : key_schema->GetColumns()) {
+    switch (column.GetType()) {
+      case type::Type::TINYINT:
+      case type::Type::SMALLINT:
+      case type::Type::INTEGER:
+      case type::Type::BIGINT:
+        key_length += type::Type::GetTypeSize(column.GetType());
+        break;
+      default:
+        return 0;
+    }
+  }
+
+  // IntsKey is instantiated for up to four uint64_ts
+  size_t ints_key_size = (key_length + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  if (ints_key_size > 4) {
+    return 0;
+  }
+  return ints_key_size;
+}
+
 }  // End index namespace
 }  // End peloton namespace
@@ -255,6 +255,35 @@ void LogManager::LogInsert(cid_t commit_id, const ItemPointer &new_location) {
   }
 }
 
+/**
+ * @brief Log a tile group filled by a bulk load.
+ * Write behind logging only syncs the tile group, so a single record covers
+ * all of its tuples. Write ahead logging still needs the image of every tuple
+ * to replay the load.
+ */
+void LogManager::LogInsertTileGroup(cid_t commit_id, oid_t tile_group_id) {
+  if (this->IsInLoggingMode()) {
+    auto &manager = catalog::Manager::GetInstance();
+    auto tile_group = manager.GetTileGroup(tile_group_id);
+    auto tuple_count = tile_group->GetNextTupleSlot();
+
+    if (LoggingUtil::IsBasedOnWriteAheadLogging(logging_type_) ||
+        replicating_) {
+      for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+        LogInsert(commit_id, ItemPointer(tile_group_id, tuple_id));
+      }
+      return;
+    }
+
+    auto logger = this->GetBackendLogger();
+    std::unique_ptr<LogRecord> record(logger->GetTupleRecord(
+        LOGRECORD_TYPE_TUPLE_INSERT, commit_id, tile_group->GetTableId(),
+        tile_group->GetDatabaseId(), ItemPointer(tile_group_id, 0),
+        INVALID_ITEMPOINTER));
+    logger->Log(record.get());
+  }
+}
+
 void LogManager::LogDelete(cid_t commit_id,
                            const ItemPointer &delete_location) {
   if (this->IsInLoggingMode()) {
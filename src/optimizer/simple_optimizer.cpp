@@ -16,24 +16,27 @@
 
 #include "catalog/catalog.h"
 #include "catalog/schema.h"
+#include "common/task_scheduler.h"
 #include "expression/aggregate_expression.h"
+#include "expression/column_filter_expression.h"
 #include "expression/expression_util.h"
 #include "expression/function_expression.h"
 #include "expression/star_expression.h"
 #include "parser/sql_statement.h"
 #include "planner/abstract_plan.h"
 #include "planner/abstract_scan_plan.h"
+#include "planner/adaptive_join_plan.h"
 #include "planner/aggregate_plan.h"
 #include "planner/copy_plan.h"
 #include "planner/create_plan.h"
 #include "planner/delete_plan.h"
 #include "planner/drop_plan.h"
+#include "planner/exchange_plan.h"
 #include "planner/hash_join_plan.h"
 #include "planner/hash_plan.h"
 #include "planner/index_scan_plan.h"
 #include "planner/insert_plan.h"
 #include "planner/limit_plan.h"
-#include "planner/nested_loop_join_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
@@ -43,6 +46,7 @@
 #include "common/logger.h"
 #include "type/value_factory.h"
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 
@@ -52,6 +56,9 @@ class AbstractPlan;
 }
 namespace optimizer {
 
+// Smallest table, in tile groups, that is worth scanning in parallel
+static const oid_t parallel_scan_tile_group_threshold = 8;
+
 SimpleOptimizer::SimpleOptimizer() {};
 
 SimpleOptimizer::~SimpleOptimizer() {};
@@ -163,9 +170,21 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
       // If there is no aggregate functions, just do a sequential scan
       if (!agg_flag && group_by_columns.size() == 0) {
         LOG_TRACE("No aggregate functions found.");
-        std::unique_ptr<planner::AbstractPlan> child_SelectPlan =
-            CreateScanPlan(target_table, column_ids, predicate,
-                           select_stmt->is_for_update);
+        std::unique_ptr<planner::AbstractPlan> child_SelectPlan;
+
+        // If an index returns the tuples in the order asked for, they do
+        // not have to be sorted, and the scan can stop after the limit
+        bool sorted = false;
+        if (select_stmt->order != NULL) {
+          child_SelectPlan = CreateOrderedScanPlan(
+              target_table, column_ids, predicate, select_stmt->is_for_update,
+              select_stmt->order, select_stmt->limit);
+          sorted = (child_SelectPlan != nullptr);
+        }
+        if (sorted == false) {
+          child_SelectPlan = CreateScanPlan(target_table, column_ids, predicate,
+                                            select_stmt->is_for_update);
+        }
 
         // if we have expressions which are not just columns, we need to add a
         // projection plan node
@@ -210,7 +229,14 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
           child_SelectPlan = std::move(child_ProjectPlan);
         }
 
-        if (select_stmt->order != NULL && select_stmt->limit != NULL) {
+        // The order comes from the order by plan or from an index scan,
+        // which stays on this thread, so it does not matter in what order
+        // the partitions return the tuples
+        child_SelectPlan = CreateExchangePlan(std::move(child_SelectPlan),
+                                              target_table, {});
+
+        if (select_stmt->order != NULL && select_stmt->limit != NULL &&
+            sorted == false) {
           std::vector<oid_t> keys;
           // Add all selected columns to the output
           // We already generated the "real" physical output schema in the scan
@@ -254,7 +280,7 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
               new planner::LimitPlan(select_stmt->limit->limit, offset));
           limit_plan->AddChild(std::move(order_by_plan));
           child_plan = std::move(limit_plan);
-        } else if (select_stmt->order != NULL) {
+        } else if (select_stmt->order != NULL && sorted == false) {
           std::vector<oid_t> keys;
           for (size_t column_ctr = 0;
                column_ctr < select_stmt->select_list->size(); column_ctr++) {
@@ -457,6 +483,13 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
         LOG_TRACE("Output Schema Info: %s",
                   output_table_schema.get()->GetInfo().c_str());
 
+        // The groups of hash partitions of the group by columns are
+        // disjoint, so each partition can be aggregated on its own
+        std::vector<oid_t> hash_column_ids;
+        if (agg_type == AGGREGATE_TYPE_HASH) {
+          hash_column_ids = group_by_columns;
+        }
+
         std::unique_ptr<planner::AggregatePlan> child_agg_plan(
             new planner::AggregatePlan(
                 std::move(proj_info), std::move(predicate),
@@ -465,6 +498,11 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
 
         child_agg_plan->AddChild(std::move(scan_node));
         child_plan = std::move(child_agg_plan);
+
+        if (hash_column_ids.empty() == false) {
+          child_plan = CreateExchangePlan(std::move(child_plan), target_table,
+                                          hash_column_ids);
+        }
       }
 
     } break;
@@ -608,11 +646,65 @@ std::shared_ptr<planner::AbstractPlan> SimpleOptimizer::BuildPelotonPlanTree(
   return plan_tree;
 }
 
+/**
+ * This function runs a subtree that reads a large table with a sequential
+ * scan in parallel, putting an exchange on top of it. The instances scan
+ * ranges of tile groups, or hash partitions of the given columns. Returns
+ * the subtree itself if it is not worth it.
+ */
+std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateExchangePlan(
+    std::unique_ptr<planner::AbstractPlan> subtree,
+    storage::DataTable* target_table,
+    const std::vector<oid_t>& hash_column_ids) {
+  const planner::AbstractPlan* leaf = subtree.get();
+  while (leaf->GetChildren().size() == 1) {
+    leaf = leaf->GetChildren()[0].get();
+  }
+
+  // Scans that lock the tuples stay on this thread
+  if (leaf->GetPlanNodeType() != PLAN_NODE_TYPE_SEQSCAN ||
+      leaf->GetChildren().empty() == false ||
+      static_cast<const planner::SeqScanPlan*>(leaf)->IsForUpdate()) {
+    return subtree;
+  }
+
+  oid_t tile_group_count = target_table->GetTileGroupCount();
+  size_t partition_count = std::min<size_t>(
+      TaskScheduler::GetInstance().GetWorkerCount(), tile_group_count);
+  if (tile_group_count < parallel_scan_tile_group_threshold ||
+      partition_count < 2) {
+    return subtree;
+  }
+
+  LOG_TRACE("Scanning %u tile groups in %lu partitions", tile_group_count,
+            partition_count);
+  auto partition_type = hash_column_ids.empty()
+                            ? PARTITION_TYPE_TILE_GROUP_RANGE
+                            : PARTITION_TYPE_HASH;
+  std::unique_ptr<planner::AbstractPlan> exchange_plan(
+      new planner::ExchangePlan(partition_type, partition_count,
+                                hash_column_ids));
+  exchange_plan->AddChild(std::move(subtree));
+  return exchange_plan;
+}
+
 std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateCopyPlan(
     parser::CopyStatement* copy_stmt) {
   std::string table_name(copy_stmt->cpy_table->GetTableName());
   bool deserialize_parameters = false;
 
+  // COPY FROM loads the file straight into the table
+  if (copy_stmt->type == COPY_TYPE_IMPORT_CSV) {
+    auto target_table = catalog::Catalog::GetInstance()->GetTableWithName(
+        copy_stmt->cpy_table->GetDatabaseName(), table_name);
+    if (target_table == nullptr) {
+      throw CatalogException("Table '" + table_name + "' does not exist");
+    }
+    std::unique_ptr<planner::AbstractPlan> copy_plan(new planner::CopyPlan(
+        copy_stmt->file_path, target_table, copy_stmt->delimiter));
+    return std::move(copy_plan);
+  }
+
   // If we're copying the query metric table, then we need to handle the
   // deserialization of prepared stmt parameters
   if (table_name == QUERY_METRIC_NAME) {
@@ -641,6 +733,9 @@ std::unique_ptr<planner::AbstractPlan> SimpleOptimizer::CreateCopyPlan(
 
   auto target_table = catalog::Catalog::GetInstance()->GetTableWithName(
       select_stmt->from_table->GetDatabaseName(), table_name);
+  if (target_table == nullptr) {
+    throw CatalogException("Table '" + table_name + "' does not exist");
+  }
 
   std::unordered_map<oid_t, oid_t> column_mapping;
   std::vector<oid_t> column_ids;
@@ -697,9 +792,36 @@ bool SimpleOptimizer::CheckIndexSearchable(
         int matched_columns = 0;
         for (auto column_id : predicate_column_ids)
           if (column_set.find(column_id) != column_set.end()) matched_columns++;
-        if (matched_columns > max_columns) {
+
+        auto index = target_table->GetIndex(index_index);
+        if (index->IsReady() == false) {
+          // Still being built, some tuples may be missing
+          index_index++;
+          continue;
+        }
+
+        if (ImpliesIndexPredicate(expression,
+                                  index->GetMetadata()->GetPredicate()) ==
+            false) {
+          // Partial index without some of the tuples the query asks for
+          index_index++;
+          continue;
+        }
+
+        if (index->GetIndexMethodType() == INDEX_TYPE_HASH) {
+          // A hash index only serves equality on all of its key columns,
+          // but then it beats an ordered index matching as many columns
+          if (IsFullKeyEquality(column_set, predicate_column_ids,
+                                predicate_expr_types) &&
+              matched_columns >= max_columns) {
+            index_searchable = true;
+            index_id = index_index;
+            max_columns = matched_columns;
+          }
+        } else if (matched_columns > max_columns) {
           index_searchable = true;
           index_id = index_index;
+          max_columns = matched_columns;
         }
         index_index++;
       }
@@ -712,10 +834,17 @@ bool SimpleOptimizer::CheckIndexSearchable(
 
   // Prepares arguments for the index scan plan
   auto index = target_table->GetIndex(index_id);
+  bool equality_only = (index->GetIndexMethodType() == INDEX_TYPE_HASH);
 
   auto index_columns = target_table->GetIndexColumns()[index_id];
   int column_idx = 0;
   for (auto column_id : predicate_column_ids) {
+    // The remaining predicates are still checked on the scanned tuples
+    if (equality_only &&
+        predicate_expr_types[column_idx] != EXPRESSION_TYPE_COMPARE_EQUAL) {
+      column_idx++;
+      continue;
+    }
     if (index_columns.find(column_id) != index_columns.end()) {
       key_column_ids.push_back(column_id);
       expr_types.push_back(predicate_expr_types[column_idx]);
@@ -730,6 +859,321 @@ bool SimpleOptimizer::CheckIndexSearchable(
   return true;
 }
 
+// Splits a predicate into its AND-ed terms
+static void GetConjuncts(
+    const expression::AbstractExpression* expression,
+    std::vector<const expression::AbstractExpression*>& conjuncts) {
+  if (expression->GetExpressionType() == EXPRESSION_TYPE_CONJUNCTION_AND) {
+    GetConjuncts(expression->GetChild(0), conjuncts);
+    GetConjuncts(expression->GetChild(1), conjuncts);
+  } else {
+    conjuncts.push_back(expression);
+  }
+}
+
+// Reads a comparison between a column and a constant, with the column on
+// the left hand side. Returns false for any other expression.
+static bool GetColumnComparison(
+    const expression::AbstractExpression* expression,
+    const expression::TupleValueExpression*& column, ExpressionType& expr_type,
+    type::Value& value) {
+  expr_type = expression->GetExpressionType();
+  switch (expr_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      break;
+    default:
+      return false;
+  }
+
+  auto left = expression->GetChild(0);
+  auto right = expression->GetChild(1);
+  if (left->GetExpressionType() == EXPRESSION_TYPE_VALUE_CONSTANT &&
+      right->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE) {
+    std::swap(left, right);
+    switch (expr_type) {
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        expr_type = EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        expr_type = EXPRESSION_TYPE_COMPARE_LESSTHAN;
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        expr_type = EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        expr_type = EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+        break;
+      default:
+        break;
+    }
+  }
+  if (left->GetExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE ||
+      right->GetExpressionType() != EXPRESSION_TYPE_VALUE_CONSTANT) {
+    return false;
+  }
+
+  column = (const expression::TupleValueExpression*)left;
+  value = ((const expression::ConstantValueExpression*)right)->GetValue();
+  return value.IsNull() == false;
+}
+
+// Checks whether "column expr_type value" implies
+// "column index_expr_type index_value"
+static bool ImpliesComparison(ExpressionType expr_type,
+                              const type::Value& value,
+                              ExpressionType index_expr_type,
+                              const type::Value& index_value) {
+  try {
+    value.CheckComparable(index_value);
+  } catch (Exception& e) {
+    return false;
+  }
+
+  bool equal = value.CompareEquals(index_value).IsTrue();
+  bool less = value.CompareLessThan(index_value).IsTrue();
+  bool greater = value.CompareGreaterThan(index_value).IsTrue();
+
+  switch (index_expr_type) {
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+      return expr_type == EXPRESSION_TYPE_COMPARE_EQUAL && equal;
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+      switch (expr_type) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+          return !equal;
+        case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+          return equal;
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+          return !greater;
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+          return less;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+          return !less;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+          return greater;
+        default:
+          return false;
+      }
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      switch (expr_type) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+          return less;
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+          return !greater;
+        default:
+          return false;
+      }
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      switch (expr_type) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+          return !greater;
+        default:
+          return false;
+      }
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      switch (expr_type) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+        case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+          return greater;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+          return !less;
+        default:
+          return false;
+      }
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      switch (expr_type) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+          return !less;
+        default:
+          return false;
+      }
+    default:
+      return false;
+  }
+}
+
+/**
+ * This function checks whether the predicate of a query implies the
+ * predicate of a partial index. The check is conservative: every AND-ed
+ * term of the index predicate has to be a comparison between a column and a
+ * constant, which follows from a comparison on the same column in the query
+ * predicate, e.g. "a = 5" or "a > 7" implies "a > 3". Parameters never
+ * imply anything, since the plan is reused for other values.
+ */
+bool SimpleOptimizer::ImpliesIndexPredicate(
+    const expression::AbstractExpression* predicate,
+    const expression::AbstractExpression* index_predicate) {
+  if (index_predicate == nullptr) {
+    return true;
+  }
+  if (predicate == nullptr) {
+    return false;
+  }
+
+  std::vector<const expression::AbstractExpression*> conjuncts;
+  std::vector<const expression::AbstractExpression*> index_conjuncts;
+  GetConjuncts(predicate, conjuncts);
+  GetConjuncts(index_predicate, index_conjuncts);
+
+  for (auto index_conjunct : index_conjuncts) {
+    const expression::TupleValueExpression* index_column;
+    ExpressionType index_expr_type;
+    type::Value index_value;
+    if (GetColumnComparison(index_conjunct, index_column, index_expr_type,
+                            index_value) == false) {
+      return false;
+    }
+
+    bool implied = false;
+    for (auto conjunct : conjuncts) {
+      const expression::TupleValueExpression* column;
+      ExpressionType expr_type;
+      type::Value value;
+      if (GetColumnComparison(conjunct, column, expr_type, value) == true &&
+          column->GetColumnName() == index_column->GetColumnName() &&
+          ImpliesComparison(expr_type, value, index_expr_type, index_value) ==
+              true) {
+        implied = true;
+        break;
+      }
+    }
+    if (implied == false) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * This function checks whether every column of the index key has an
+ * equality predicate, which is the only kind of lookup a hash index serves.
+ */
+bool SimpleOptimizer::IsFullKeyEquality(
+    const std::set<oid_t>& index_columns,
+    const std::vector<oid_t>& predicate_column_ids,
+    const std::vector<ExpressionType>& predicate_expr_types) {
+  for (auto index_column : index_columns) {
+    bool has_equality = false;
+    for (size_t column_idx = 0; column_idx < predicate_column_ids.size();
+         column_idx++) {
+      if (predicate_column_ids[column_idx] == index_column &&
+          predicate_expr_types[column_idx] == EXPRESSION_TYPE_COMPARE_EQUAL) {
+        has_equality = true;
+        break;
+      }
+    }
+    if (has_equality == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Builds the column filter for a comparison between a column of the scanned
+// table and a constant, or for the AND of a lower and an upper bound on the
+// same column. Returns nullptr for any other expression.
+static expression::AbstractExpression* GetColumnFilter(
+    const catalog::Schema* schema,
+    const expression::AbstractExpression* expression) {
+  const expression::TupleValueExpression* column;
+  ExpressionType expr_type;
+  type::Value value;
+
+  if (expression->GetExpressionType() != EXPRESSION_TYPE_CONJUNCTION_AND) {
+    if (GetColumnComparison(expression, column, expr_type, value) == false ||
+        column->GetTupleId() != 0 || column->GetColumnId() < 0 ||
+        (oid_t)column->GetColumnId() >= schema->GetColumnCount()) {
+      return nullptr;
+    }
+
+    oid_t column_id = column->GetColumnId();
+    auto column_type = schema->GetType(column_id);
+    if (expression::ColumnFilterExpression::IsSupported(column_type, value) ==
+        false) {
+      return nullptr;
+    }
+    return new expression::ColumnFilterExpression(
+        expression->Copy(), column_id, column_type, expr_type, value);
+  }
+
+  const expression::TupleValueExpression* upper_column;
+  ExpressionType upper_type;
+  type::Value upper;
+  if (GetColumnComparison(expression->GetChild(0), column, expr_type, value) ==
+          false ||
+      GetColumnComparison(expression->GetChild(1), upper_column, upper_type,
+                          upper) == false) {
+    return nullptr;
+  }
+  if (expr_type == EXPRESSION_TYPE_COMPARE_LESSTHAN ||
+      expr_type == EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO) {
+    std::swap(column, upper_column);
+    std::swap(expr_type, upper_type);
+    std::swap(value, upper);
+  }
+
+  if ((expr_type != EXPRESSION_TYPE_COMPARE_GREATERTHAN &&
+       expr_type != EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO) ||
+      (upper_type != EXPRESSION_TYPE_COMPARE_LESSTHAN &&
+       upper_type != EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO) ||
+      column->GetTupleId() != 0 || upper_column->GetTupleId() != 0 ||
+      column->GetColumnId() != upper_column->GetColumnId() ||
+      column->GetColumnId() < 0 ||
+      (oid_t)column->GetColumnId() >= schema->GetColumnCount()) {
+    return nullptr;
+  }
+
+  oid_t column_id = column->GetColumnId();
+  auto column_type = schema->GetType(column_id);
+  if (expression::ColumnFilterExpression::IsSupported(column_type, value,
+                                                      upper) == false) {
+    return nullptr;
+  }
+  return new expression::ColumnFilterExpression(expression->Copy(), column_id,
+                                                column_type, expr_type, value,
+                                                upper_type, upper);
+}
+
+/**
+ * This function compiles the terms of a sequential scan predicate of the
+ * shape "column <op> constant" or "column >(=) lower AND column <(=) upper"
+ * on an INTEGER, BIGINT, DECIMAL or TIMESTAMP column into filters whose
+ * kernel reads the column out of the tiles, in place of evaluating the
+ * expression tree for them. Terms under AND and OR are compiled too, the
+ * rest of the predicate is evaluated as before. Returns the filter the
+ * whole predicate is replaced by, or nullptr if it is only changed in place.
+ */
+expression::AbstractExpression* SimpleOptimizer::CompileScanPredicate(
+    const catalog::Schema* schema, expression::AbstractExpression* predicate) {
+  auto column_filter = GetColumnFilter(schema, predicate);
+  if (column_filter != nullptr) {
+    return column_filter;
+  }
+
+  if (predicate->GetExpressionType() == EXPRESSION_TYPE_CONJUNCTION_AND ||
+      predicate->GetExpressionType() == EXPRESSION_TYPE_CONJUNCTION_OR) {
+    for (int child_idx = 0; child_idx < (int)predicate->GetChildrenSize();
+         child_idx++) {
+      auto compiled_child = CompileScanPredicate(
+          schema, predicate->GetModifiableChild(child_idx));
+      if (compiled_child != nullptr) {
+        predicate->SetChild(child_idx, compiled_child);
+      }
+    }
+  }
+  return nullptr;
+}
+
 std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
     storage::DataTable* target_table, std::vector<oid_t>& column_ids,
     expression::AbstractExpression* predicate, bool for_update) {
@@ -745,6 +1189,14 @@ std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
     // Create sequential scan plan
     LOG_TRACE("Creating a sequential scan plan");
     auto predicate_cpy = predicate == nullptr ? nullptr : predicate->Copy();
+    if (predicate_cpy != nullptr) {
+      auto compiled_predicate =
+          CompileScanPredicate(target_table->GetSchema(), predicate_cpy);
+      if (compiled_predicate != nullptr) {
+        delete predicate_cpy;
+        predicate_cpy = compiled_predicate;
+      }
+    }
     std::unique_ptr<planner::SeqScanPlan> child_SelectPlan(
         new planner::SeqScanPlan(target_table, predicate_cpy, column_ids,
                                  for_update));
@@ -769,6 +1221,89 @@ std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateScanPlan(
   return std::move(node);
 }
 
+/**
+ * This function creates an index scan that returns the tuples in the order
+ * of the ORDER BY column, which takes an ordered index whose key starts with
+ * that column. The index the predicate would use is taken if it qualifies.
+ * Otherwise another index is only worth it for a limited query whose
+ * predicate does not use any index, since the scan stops at the limit.
+ * Returns nullptr if the tuples have to be sorted.
+ */
+std::unique_ptr<planner::AbstractScan> SimpleOptimizer::CreateOrderedScanPlan(
+    storage::DataTable* target_table, std::vector<oid_t>& column_ids,
+    expression::AbstractExpression* predicate, bool for_update,
+    const parser::OrderDescription* order,
+    const parser::LimitDescription* limit) {
+  if (order->expr->GetExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE) {
+    return nullptr;
+  }
+  std::string sort_col_name(
+      ((expression::TupleValueExpression*)order->expr)->GetColumnName());
+  oid_t sort_column_id = target_table->GetSchema()->GetColumnID(sort_col_name);
+
+  // Only BwTree scans in key order both ways
+  auto key_starts_with_sort_column = [sort_column_id,
+                                      predicate](index::Index* index) {
+    return index->IsReady() == true &&
+           index->GetIndexMethodType() == INDEX_TYPE_BWTREE &&
+           index->GetMetadata()->GetKeyAttrs()[0] == sort_column_id &&
+           ImpliesIndexPredicate(predicate,
+                                 index->GetMetadata()->GetPredicate());
+  };
+
+  oid_t index_id = 0;
+  std::vector<oid_t> key_column_ids;
+  std::vector<ExpressionType> expr_types;
+  std::vector<type::Value> values;
+
+  if (CheckIndexSearchable(target_table, predicate, key_column_ids, expr_types,
+                           values, index_id)) {
+    if (key_starts_with_sort_column(target_table->GetIndex(index_id).get()) ==
+        false) {
+      return nullptr;
+    }
+  } else {
+    if (limit == NULL || limit->limit < 0) {
+      return nullptr;
+    }
+
+    bool found = false;
+    for (oid_t index_itr = 0; index_itr < target_table->GetIndexCount();
+         index_itr++) {
+      if (key_starts_with_sort_column(
+              target_table->GetIndex(index_itr).get()) == true) {
+        index_id = index_itr;
+        found = true;
+        break;
+      }
+    }
+    if (found == false) {
+      return nullptr;
+    }
+  }
+
+  // The limit plan on top skips the offset, so the scan has to return it too
+  uint64_t scan_limit = 0;
+  if (limit != NULL && limit->limit >= 0) {
+    scan_limit = limit->limit + std::max(limit->offset, (int64_t)0);
+  }
+
+  LOG_TRACE("Creating an ordered index scan plan");
+  auto index = target_table->GetIndex(index_id);
+  std::vector<expression::AbstractExpression*> runtime_keys;
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+
+  std::unique_ptr<planner::IndexScanPlan> node(new planner::IndexScanPlan(
+      target_table, predicate, column_ids, index_scan_desc, for_update));
+  node->SetOrderedScan(order->type == parser::kOrderDesc
+                           ? SCAN_DIRECTION_TYPE_BACKWARD
+                           : SCAN_DIRECTION_TYPE_FORWARD,
+                       scan_limit);
+
+  return std::move(node);
+}
+
 /**
  * This function replaces all COLUMN_REF expressions with TupleValue
  * expressions
@@ -1134,6 +1669,30 @@ SimpleOptimizer::CreateHackingNestedLoopJoinPlan(
                                  index_scan_desc2, false));
   LOG_DEBUG("Index scan plan for STOCK created");
 
+  // Plain scan of STOCK, in case order_line has too many rows to look each
+  // of them up
+  char s_w_id_name[] = "s_w_id";
+  char s_quantity_2_name[] = "s_quantity";
+  auto s_w_id = new expression::TupleValueExpression(s_w_id_name);
+  auto s_quantity_2 = new expression::TupleValueExpression(s_quantity_2_name);
+
+  auto predicate13 = new expression::ComparisonExpression(
+      EXPRESSION_TYPE_COMPARE_EQUAL, s_w_id,
+      new expression::ConstantValueExpression(
+          type::ValueFactory::GetIntegerValue(0)));
+  auto predicate14 = new expression::ComparisonExpression(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN, s_quantity_2,
+      new expression::ParameterValueExpression(4));
+  expression::AbstractExpression* predicate15 =
+      new expression::ConjunctionExpression(EXPRESSION_TYPE_CONJUNCTION_AND,
+                                            predicate13, predicate14);
+  expression::ExpressionUtil::TransformExpression(stock_table->GetSchema(),
+                                                  predicate15);
+
+  std::unique_ptr<planner::SeqScanPlan> stock_full_scan_node(
+      new planner::SeqScanPlan(stock_table, predicate15, column_ids));
+  LOG_DEBUG("Sequential scan plan for STOCK created");
+
   auto projection = CreateHackProjection();
   auto schema = CreateHackJoinSchema();
 
@@ -1151,16 +1710,20 @@ SimpleOptimizer::CreateHackingNestedLoopJoinPlan(
 
   std::vector<oid_t> join_column_ids_left = {0};   // I_I_ID in the result
   std::vector<oid_t> join_column_ids_right = {1};  // S_I_ID in the table
+  std::vector<oid_t> join_output_column_ids_right = {0};  // S_I_ID in the scan
 
-  // Create hash join plan node.
-  std::unique_ptr<planner::NestedLoopJoinPlan> nested_join_plan_node(
-      new planner::NestedLoopJoinPlan(
+  // Create adaptive join plan node. It looks up the stock of a few order
+  // lines through the index, and hashes them if there are many.
+  std::unique_ptr<planner::AdaptiveJoinPlan> nested_join_plan_node(
+      new planner::AdaptiveJoinPlan(
           JOIN_TYPE_INNER, std::move(join_predicate), std::move(projection),
-          schema, join_column_ids_left, join_column_ids_right));
+          schema, join_column_ids_left, join_column_ids_right,
+          join_output_column_ids_right));
 
-  // Add left and right
+  // Add left and both right
   nested_join_plan_node->AddChild(std::move(orderline_scan_node));
   nested_join_plan_node->AddChild(std::move(stock_scan_node));
+  nested_join_plan_node->AddChild(std::move(stock_full_scan_node));
 
   expression::TupleValueExpression* left_table_attr_1 =
       new expression::TupleValueExpression(type::Type::INTEGER, 0, 0);
@@ -157,6 +157,7 @@ struct PARSER_CUST_LTYPE {
 	peloton::parser::ExecuteStatement*     exec_stmt;
 	peloton::parser::TransactionStatement* txn_stmt;
 	peloton::parser::CopyStatement* 	   copy_stmt;
+	peloton::parser::ExplainStatement*     explain_stmt;
 
 	peloton::parser::TableRef* table;
 	peloton::parser::TableInfo* table_info;
@@ -200,11 +201,11 @@ struct PARSER_CUST_LTYPE {
 %token COMMIT TABLES UNIQUE UNLOAD UPDATE VALUES AFTER ALTER CROSS
 %token FLOAT BEGIN DELTA GROUP INDEX INNER LIMIT LOCAL MERGE MINUS ORDER COUNT
 %token OUTER RIGHT TABLE UNION USING WHERE CHAR CALL DATE DESC
-%token DROP FILE FROM FULL HASH HINT INTO JOIN LEFT LIKE BTREE BWTREE SKIPLIST
+%token DROP FILE FROM FULL HASH HINT INTO JOIN LEFT LIKE BTREE BWTREE SKIPLIST ART
 %token LOAD NULL PART PLAN SHOW TEXT TIME VIEW WITH ADD ALL
 %token AND ASC CSV FOR INT KEY NOT OFF SET TOP SUM MIN MAX AVG AS BY IF
 %token IN IS OF ON OR TO
-%token COPY DELIMITER
+%token COPY DELIMITER INCLUDE
 
 /*********************************
  ** Non-Terminal types (http://www.gnu.org/software/bison/manual/html_node/Type-Decl.html)
@@ -221,6 +222,7 @@ struct PARSER_CUST_LTYPE {
 %type <drop_stmt>	drop_statement
 %type <txn_stmt>    transaction_statement
 %type <copy_stmt>   copy_statement
+%type <explain_stmt> explain_statement
 %type <sval> 		opt_alias alias
 %type <bval> 		opt_not_exists opt_exists opt_distinct opt_notnull opt_primary opt_unique opt_update
 %type <uval>		opt_join_type column_type opt_column_width opt_index_type
@@ -237,7 +239,7 @@ struct PARSER_CUST_LTYPE {
 %type <update_t>	update_clause
 %type <group_t>		opt_group
 
-%type <str_vec>				ident_commalist opt_column_list
+%type <str_vec>				ident_commalist opt_column_list opt_include_columns
 %type <expr_vec>			expr_list select_list literal_list
 %type <table_vec>			table_ref_commalist
 %type <update_vec>			update_clause_commalist
@@ -292,6 +294,7 @@ statement:
 			$$ = $1;
 		}
 	|	preparable_statement
+	|	explain_statement { $$ = $1; }
 	;
 
 
@@ -309,6 +312,24 @@ preparable_statement:
 	;
 
 
+/******************************
+ * Explain Statement
+ * EXPLAIN SELECT * FROM foo;
+ * EXPLAIN ANALYZE SELECT * FROM foo;
+ ******************************/
+explain_statement:
+		EXPLAIN preparable_statement {
+			$$ = new ExplainStatement();
+			$$->statement = $2;
+		}
+	|	EXPLAIN ANALYZE preparable_statement {
+			$$ = new ExplainStatement();
+			$$->analyze = true;
+			$$->statement = $3;
+		}
+	;
+
+
 /******************************
  * Prepared Statement
  ******************************/
@@ -342,6 +363,8 @@ execute_statement:
  * Create Statement
  * CREATE TABLE students (name TEXT, student_number INTEGER, city TEXT, grade DOUBLE)
  * CREATE INDEX i_security ON security (s_co_id, s_issue)
+ * CREATE INDEX i_security ON security (s_co_id) INCLUDE (s_issue)
+ * CREATE INDEX i_security ON security (s_co_id) WHERE s_issue > 10
  * CREATE DATABASE my_db
  ******************************/
 create_statement:
@@ -356,22 +379,26 @@ create_statement:
 			$$->if_not_exists = $3;
 			$$->database_name = $4;
 		}
-		|	CREATE opt_unique INDEX IDENTIFIER ON table_name '(' ident_commalist ')' {
+		|	CREATE opt_unique INDEX IDENTIFIER ON table_name '(' ident_commalist ')' opt_include_columns opt_where {
 			$$ = new CreateStatement(CreateStatement::kIndex);
 			$$->unique = $2;
 			$$->index_name = $4;
 			$$->table_info_ = $6;
 			$$->index_attrs = $8;
+			$$->index_include_attrs = $10;
+			$$->index_predicate = $11;
 			$$->index_type = peloton::INDEX_TYPE_BWTREE;
 		}
 
-		|	CREATE opt_unique INDEX IDENTIFIER ON table_name '(' ident_commalist ')' USING opt_index_type {
+		|	CREATE opt_unique INDEX IDENTIFIER ON table_name '(' ident_commalist ')' opt_include_columns USING opt_index_type opt_where {
 			$$ = new CreateStatement(CreateStatement::kIndex);
 			$$->unique = $2;
 			$$->index_name = $4;
 			$$->table_info_ = $6;
 			$$->index_attrs = $8;
-			$$->index_type = $11;
+			$$->index_include_attrs = $10;
+			$$->index_type = $12;
+			$$->index_predicate = $13;
 		}
 	;
 
@@ -450,9 +477,15 @@ column_type:
     |   VARBINARY { $$ = ColumnDefinition::VARBINARY; }
 	;
 
+opt_include_columns:
+		INCLUDE '(' ident_commalist ')' { $$ = $3; }
+	|	/* empty */ { $$ = nullptr; }
+	;
+
 opt_index_type:
 		HASH { $$ = peloton::INDEX_TYPE_HASH; }
 	|	BWTREE { $$ = peloton::INDEX_TYPE_BWTREE; }
+	|	ART { $$ = peloton::INDEX_TYPE_ART; }
 	|	BTREE { $$ = peloton::INDEX_TYPE_BTREE; }
 	;
 
@@ -944,6 +977,7 @@ join_condition:
 /******************************
  * Copy Statement
  * COPY catalog_db.query_metric TO '/home/user/query_metric.csv' DELIMITER ','
+ * COPY foo FROM '/home/user/foo.csv' DELIMITER ','
  * TODO: Nested query like below is not supported yet
  * COPY (SELECT id FROM A WHERE val = 1) TO '/path/file.csv' DELIMITER ';'
  ******************************/
@@ -958,6 +992,13 @@ copy_statement:
 			$$->delimiter = *($6);
 			delete $6;
 		}
+	|	COPY table_ref_name FROM STRING DELIMITER STRING {
+			$$ = new CopyStatement(peloton::COPY_TYPE_IMPORT_CSV);
+			$$->cpy_table = $2;
+			$$->file_path = $4;
+			$$->delimiter = *($6);
+			delete $6;
+		}
 	;
 
 
@@ -16,6 +16,7 @@
 #include "storage/data_table.h"
 #include "catalog/schema.h"
 #include "catalog/column.h"
+#include "expression/abstract_expression.h"
 
 namespace peloton {
 namespace planner {
@@ -88,6 +89,16 @@ CreatePlan::CreatePlan(parser::CreateStatement *parse_tree) {
 
     index_attrs = index_attrs_holder;
 
+    if (parse_tree->index_include_attrs != nullptr) {
+      for (auto attr : *parse_tree->index_include_attrs) {
+        index_include_attrs.push_back(attr);
+      }
+    }
+
+    if (parse_tree->index_predicate != nullptr) {
+      index_predicate.reset(parse_tree->index_predicate->Copy());
+    }
+
     index_type = parse_tree->index_type;
 
     unique = parse_tree->unique;
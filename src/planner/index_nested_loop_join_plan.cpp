@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_nested_loop_join_plan.cpp
+//
+// Identification: src/planner/index_nested_loop_join_plan.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "planner/index_nested_loop_join_plan.h"
+
+#include "type/types.h"
+#include "expression/abstract_expression.h"
+#include "index/index.h"
+#include "planner/project_info.h"
+
+namespace peloton {
+namespace planner {
+
+IndexNestedLoopJoinPlan::IndexNestedLoopJoinPlan(
+    PelotonJoinType join_type,
+    std::unique_ptr<const expression::AbstractExpression> &&predicate,
+    std::unique_ptr<const ProjectInfo> &&proj_info,
+    std::shared_ptr<const catalog::Schema> &proj_schema,
+    storage::DataTable *inner_table, std::shared_ptr<index::Index> index,
+    const std::vector<oid_t> &join_column_ids_outer,
+    const std::vector<oid_t> &inner_column_ids)
+    : AbstractJoinPlan(join_type, std::move(predicate), std::move(proj_info),
+                       proj_schema),
+      inner_table_(inner_table),
+      index_(index),
+      join_column_ids_outer_(join_column_ids_outer),
+      inner_column_ids_(inner_column_ids) {}
+
+std::unique_ptr<AbstractPlan> IndexNestedLoopJoinPlan::Copy() const {
+  std::unique_ptr<const expression::AbstractExpression> predicate_copy;
+  if (GetPredicate() != nullptr) {
+    predicate_copy.reset(GetPredicate()->Copy());
+  }
+
+  std::unique_ptr<const ProjectInfo> proj_info_copy;
+  if (GetProjInfo() != nullptr) {
+    proj_info_copy = GetProjInfo()->Copy();
+  }
+
+  std::shared_ptr<const catalog::Schema> schema_copy;
+  if (GetSchema() != nullptr) {
+    schema_copy.reset(catalog::Schema::CopySchema(GetSchema()));
+  }
+
+  IndexNestedLoopJoinPlan *new_plan = new IndexNestedLoopJoinPlan(
+      GetJoinType(), std::move(predicate_copy), std::move(proj_info_copy),
+      schema_copy, inner_table_, index_, join_column_ids_outer_,
+      inner_column_ids_);
+  return std::unique_ptr<AbstractPlan>(new_plan);
+}
+
+}  // namespace planner
+}  // namespace peloton
@@ -14,9 +14,12 @@
 
 #include "common/container_tuple.h"
 #include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "expression/column_vector.h"
 #include "expression/constant_value_expression.h"
 #include "expression/expression_util.h"
 #include "expression/parameter_value_expression.h"
+#include "storage/tile.h"
 
 namespace peloton {
 namespace planner {
@@ -82,6 +85,76 @@ bool ProjectInfo::Evaluate(storage::Tuple *dest, const AbstractTuple *tuple1,
   return true;
 }
 
+/*
+ * WriteColumn() - Writes a column of values into slots 0.. of a tile column
+ *
+ * Unboxed values of the type of the column are stored directly, everything
+ * else is cast the way storage::Tuple::SetValue() does.
+ */
+static void WriteColumn(storage::Tile *dest, oid_t col_id,
+                        const expression::ColumnVector &values,
+                        const expression::SelectionVector &selection) {
+  auto schema = dest->GetSchema();
+  auto column_type = schema->GetType(col_id);
+
+  if (values.IsUnboxed() && values.GetType() == column_type) {
+    auto column_offset = schema->GetOffset(col_id);
+    for (oid_t tuple_offset = 0; tuple_offset < selection.size();
+         tuple_offset++) {
+      values.SerializeTo(selection[tuple_offset],
+                         dest->GetTupleLocation(tuple_offset) + column_offset);
+    }
+    return;
+  }
+
+  for (oid_t tuple_offset = 0; tuple_offset < selection.size();
+       tuple_offset++) {
+    auto value = values.GetValue(selection[tuple_offset]);
+    if (value.GetTypeId() != column_type) {
+      value = value.CastAs(column_type);
+    }
+    dest->SetValue(value, tuple_offset, col_id);
+  }
+}
+
+/**
+ * @brief Evaluate projections for all visible tuples of a logical tile and
+ * put the results in the first slots of the destination tile.
+ * The destination should have a slot for every visible tuple.
+ *
+ * Every expression of the target list is evaluated for the whole tile at
+ * once, see AbstractExpression::EvaluateColumn().
+ *
+ * @param dest    Destination tile.
+ * @param tile    Source tile.
+ * @param econtext  ExecutorContext for expression evaluation.
+ */
+bool ProjectInfo::Evaluate(storage::Tile *dest, executor::LogicalTile *tile,
+                           executor::ExecutorContext *econtext) const {
+  expression::SelectionVector selection;
+  for (oid_t tuple_id : *tile) {
+    selection.push_back(tuple_id);
+  }
+
+  expression::ColumnVector values;
+
+  // (A) Execute target list
+  for (auto target : target_list_) {
+    target.second->EvaluateColumn(*tile, selection, values, econtext);
+    WriteColumn(dest, target.first, values, selection);
+  }
+
+  // (B) Execute direct map
+  for (auto dm : direct_map_list_) {
+    // There is only one source tile
+    PL_ASSERT(dm.second.first == 0);
+    values.LoadColumn(*tile, dm.second.second, selection);
+    WriteColumn(dest, dm.first, values, selection);
+  }
+
+  return true;
+}
+
 bool ProjectInfo::Evaluate(expression::ContainerTuple<storage::TileGroup> *dest,
                            expression::ContainerTuple<storage::TileGroup> *src,
                            executor::ExecutorContext *econtext, bool inplace) const {
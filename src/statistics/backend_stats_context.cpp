@@ -183,6 +183,16 @@ void BackendStatsContext::IncrementIndexInserts(
   index_metric->GetIndexAccess().IncrementInserts();
 }
 
+void BackendStatsContext::IncrementIndexInserts(
+    size_t insert_count, index::IndexMetadata* metadata) {
+  oid_t index_id = metadata->GetOid();
+  oid_t table_id = metadata->GetTableOid();
+  oid_t database_id = metadata->GetDatabaseOid();
+  auto index_metric = GetIndexMetric(database_id, table_id, index_id);
+  PL_ASSERT(index_metric != nullptr);
+  index_metric->GetIndexAccess().IncrementInserts(insert_count);
+}
+
 void BackendStatsContext::IncrementIndexUpdates(
     index::IndexMetadata* metadata) {
   oid_t index_id = metadata->GetOid();
@@ -217,6 +227,25 @@ void BackendStatsContext::IncrementTxnAborted(oid_t database_id) {
   CompleteQueryMetric();
 }
 
+void BackendStatsContext::RecordJoinStrategy(JoinStrategyType join_strategy) {
+  if (ongoing_query_metric_ != nullptr) {
+    ongoing_query_metric_->AddJoinStrategy(join_strategy);
+  }
+}
+
+void BackendStatsContext::RecordPeakMemoryUsage(size_t peak_memory_usage) {
+  if (ongoing_query_metric_ != nullptr) {
+    ongoing_query_metric_->SetPeakMemoryUsage(peak_memory_usage);
+  }
+}
+
+void BackendStatsContext::RecordOperatorStats(
+    const std::vector<OperatorStats> &operator_stats) {
+  if (ongoing_query_metric_ != nullptr) {
+    ongoing_query_metric_->SetOperatorStats(operator_stats);
+  }
+}
+
 void BackendStatsContext::InitQueryMetric(
     const std::shared_ptr<Statement> statement,
     const std::shared_ptr<QueryMetric::QueryParams> params) {
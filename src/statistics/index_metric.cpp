@@ -43,5 +43,16 @@ void IndexMetric::Aggregate(AbstractMetric& source) {
   index_access_.Aggregate(index_metric.GetIndexAccess());
 }
 
+void IndexMetric::SetStructure(size_t node_count, double avg_delta_chain_length,
+                               size_t garbage_bytes,
+                               double consolidations_per_sec,
+                               double splits_per_sec) {
+  node_count_ = node_count;
+  avg_delta_chain_length_ = avg_delta_chain_length;
+  garbage_bytes_ = garbage_bytes;
+  consolidations_per_sec_ = consolidations_per_sec;
+  splits_per_sec_ = splits_per_sec;
+}
+
 }  // namespace stats
 }  // namespace peloton
@@ -252,10 +252,38 @@ void StatsAggregator::UpdateIndexMetrics(storage::Database *database, storage::D
     auto deletes = index_access.GetDeletes();
     auto inserts = index_access.GetInserts();
 
+    // The counters of the index structure only go up, the rates are taken
+    // against the previous aggregation
+    index::IndexStructureStats structure_stats;
+    if (index->GetStructureStats(structure_stats) == true) {
+      double consolidations_per_sec = 0.0;
+      double splits_per_sec = 0.0;
+      auto prev_stats_itr = index_structure_stats_.find(index_oid);
+      if (prev_stats_itr != index_structure_stats_.end() &&
+          aggregation_interval_ms_ > 0) {
+        double interval_sec = aggregation_interval_ms_ / 1000.0;
+        consolidations_per_sec = (structure_stats.consolidation_count -
+                                  prev_stats_itr->second.consolidation_count) /
+                                 interval_sec;
+        splits_per_sec =
+            (structure_stats.split_count - prev_stats_itr->second.split_count) /
+            interval_sec;
+      }
+      index_structure_stats_[index_oid] = structure_stats;
+
+      index_metric->SetStructure(structure_stats.node_count,
+                                 structure_stats.avg_delta_chain_length,
+                                 structure_stats.garbage_byte_count,
+                                 consolidations_per_sec, splits_per_sec);
+    }
+
     // Generate and insert the tuple
-    auto index_tuple = catalog::GetIndexMetricsCatalogTuple(index_metrics_table->GetSchema(),
-                                                            database_oid, table_oid, index_oid,
-                                                            reads, deletes, inserts, time_stamp);
+    auto index_tuple = catalog::GetIndexMetricsCatalogTuple(
+        index_metrics_table->GetSchema(), database_oid, table_oid, index_oid,
+        reads, deletes, inserts, index_metric->GetNodeCount(),
+        index_metric->GetAvgDeltaChainLength(), index_metric->GetGarbageBytes(),
+        index_metric->GetConsolidationsPerSec(), index_metric->GetSplitsPerSec(),
+        time_stamp);
 
     catalog::InsertTuple(index_metrics_table, std::move(index_tuple), txn);
   }
@@ -0,0 +1,374 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// anti_cache_manager.cpp
+//
+// Identification: src/storage/anti_cache_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "common/exception.h"
+#include "common/init.h"
+#include "common/logger.h"
+#include "common/thread_pool.h"
+#include "configuration/configuration.h"
+#include "type/serializeio.h"
+#include "storage/anti_cache_manager.h"
+#include "storage/storage_manager.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace storage {
+
+#define ANTI_CACHE_FILE_NAME "peloton.anticache"
+
+// Milliseconds between two background eviction passes
+#define ANTI_CACHE_EVICTION_INTERVAL 100
+
+// global singleton
+AntiCacheManager &AntiCacheManager::GetInstance(void) {
+  static AntiCacheManager anti_cache_manager;
+  return anti_cache_manager;
+}
+
+AntiCacheManager::AntiCacheManager()
+    : access_epoch_(0),
+      block_file_fd_(-1),
+      block_file_len_(0),
+      eviction_finish_(false),
+      eviction_count_(0),
+      fetch_count_(0) {}
+
+AntiCacheManager::~AntiCacheManager() {
+  if (block_file_fd_ < 0) return;
+
+  close(block_file_fd_);
+  unlink(block_file_name_.c_str());
+}
+
+//===--------------------------------------------------------------------===//
+// Tracking
+//===--------------------------------------------------------------------===//
+
+void AntiCacheManager::RegisterTileGroup(
+    const std::shared_ptr<TileGroup> &tile_group) {
+  // New tile groups start out as the hottest ones
+  auto access_epoch = ++access_epoch_;
+  tile_group->SetLastAccess(access_epoch);
+
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  tile_groups_[tile_group->GetTileGroupId()] = tile_group;
+}
+
+void AntiCacheManager::UnregisterTileGroup(const oid_t tile_group_id) {
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    tile_groups_.erase(tile_group_id);
+  }
+
+  // Reclaim the block of a tile group that is dropped while evicted
+  std::lock_guard<std::mutex> lock(block_file_mutex_);
+  auto block_itr = blocks_.find(tile_group_id);
+  if (block_itr != blocks_.end()) {
+    ReleaseBlock(block_itr->second.first, block_itr->second.second);
+    blocks_.erase(block_itr);
+  }
+}
+
+void AntiCacheManager::EnsureResident(TileGroup *tile_group) {
+  if (IsEnabled() == true) {
+    tile_group->SetLastAccess(access_epoch_.load(std::memory_order_relaxed));
+  }
+
+  if (tile_group->IsEvicted() == false) return;
+
+  FetchTileGroup(tile_group);
+}
+
+//===--------------------------------------------------------------------===//
+// Eviction
+//===--------------------------------------------------------------------===//
+
+size_t AntiCacheManager::GetResidentSize() {
+  size_t resident_size = 0;
+
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+  for (auto &entry : tile_groups_) {
+    auto tile_group = entry.second.lock();
+    if (tile_group != nullptr) {
+      resident_size += tile_group->GetResidentSize();
+    }
+  }
+
+  return resident_size;
+}
+
+size_t AntiCacheManager::GetEvictedTileGroupCount() {
+  std::lock_guard<std::mutex> lock(block_file_mutex_);
+  return blocks_.size();
+}
+
+size_t AntiCacheManager::EvictColdTileGroups() {
+  if (IsEnabled() == false) return 0;
+
+  // Take a snapshot of the resident tile groups
+  std::vector<std::shared_ptr<TileGroup>> resident_tile_groups;
+  size_t resident_size = 0;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    for (auto entry_itr = tile_groups_.begin();
+         entry_itr != tile_groups_.end();) {
+      auto tile_group = entry_itr->second.lock();
+      if (tile_group == nullptr) {
+        entry_itr = tile_groups_.erase(entry_itr);
+        continue;
+      }
+      entry_itr++;
+
+      if (tile_group->IsEvicted() == true) continue;
+      resident_size += tile_group->GetResidentSize();
+      resident_tile_groups.push_back(tile_group);
+    }
+  }
+
+  auto memory_limit = GetMemoryLimit();
+  if (resident_size <= memory_limit) return 0;
+
+  // Coldest tile groups first
+  std::sort(resident_tile_groups.begin(), resident_tile_groups.end(),
+            [](const std::shared_ptr<TileGroup> &lhs,
+               const std::shared_ptr<TileGroup> &rhs) {
+              return lhs->GetLastAccess() < rhs->GetLastAccess();
+            });
+
+  size_t evicted_count = 0;
+  for (auto &tile_group : resident_tile_groups) {
+    if (resident_size <= memory_limit) break;
+
+    auto tile_group_size = tile_group->GetResidentSize();
+    if (EvictTileGroup(tile_group) == true) {
+      resident_size -= tile_group_size;
+      evicted_count++;
+    }
+  }
+
+  LOG_TRACE("Evicted %lu tile groups, resident size : %lu", evicted_count,
+            resident_size);
+
+  return evicted_count;
+}
+
+void AntiCacheManager::StartEviction() {
+  eviction_finish_ = false;
+  thread_pool.SubmitDedicatedTask(&AntiCacheManager::RunEviction, this);
+}
+
+void AntiCacheManager::RunEviction() {
+  while (eviction_finish_ == false) {
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(ANTI_CACHE_EVICTION_INTERVAL));
+    EvictColdTileGroups();
+  }
+}
+
+bool AntiCacheManager::EvictTileGroup(const oid_t tile_group_id) {
+  std::shared_ptr<TileGroup> tile_group;
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    auto entry_itr = tile_groups_.find(tile_group_id);
+    if (entry_itr == tile_groups_.end()) return false;
+    tile_group = entry_itr->second.lock();
+  }
+
+  if (tile_group == nullptr) return false;
+
+  return EvictTileGroup(tile_group);
+}
+
+bool AntiCacheManager::IsEvictable(
+    const std::shared_ptr<TileGroup> &tile_group) const {
+  // Only main memory tiles release their memory on eviction
+  if (tile_group->GetBackendType() != BACKEND_TYPE_MM) return false;
+
+  // Skip tile groups that still take inserts
+  auto tile_group_header = tile_group->GetHeader();
+  auto num_tuples = tile_group_header->GetCurrentNextTupleSlot();
+  if (num_tuples < tile_group->GetAllocatedTupleCount()) return false;
+
+  // Skip tile groups with tuples owned by in-flight transactions
+  for (oid_t tuple_itr = 0; tuple_itr < num_tuples; tuple_itr++) {
+    auto txn_id = tile_group_header->GetTransactionId(tuple_itr);
+    if (txn_id != INITIAL_TXN_ID && txn_id != INVALID_TXN_ID) return false;
+  }
+
+  return true;
+}
+
+bool AntiCacheManager::EvictTileGroup(
+    const std::shared_ptr<TileGroup> &tile_group) {
+  PelotonWriteLock tile_group_lock(tile_group->GetAntiCacheLock());
+
+  if (tile_group->IsEvicted() == true) return false;
+
+  if (IsEvictable(tile_group) == false) return false;
+
+  // Announce the eviction before checking for readers. A concurrent
+  // GetTileGroup() either shows up in the pin count, or it sees the flag and
+  // waits for us on the anti-cache lock before fetching. Readers take
+  // references to the tiles while they hold the tile group, so the ones
+  // that let go of the tile group since show up on the tiles.
+  tile_group->SetEvicted(true);
+  if (tile_group->GetPinCount() > 0 ||
+      tile_group->IsTileReferenced() == true) {
+    tile_group->SetEvicted(false);
+    return false;
+  }
+
+  CopySerializeOutput output;
+  tile_group->SerializeTilesTo(output);
+
+  {
+    std::lock_guard<std::mutex> block_file_lock(block_file_mutex_);
+    OpenBlockFile();
+
+    size_t length = output.Size();
+    size_t offset = AllocateBlock(length);
+
+    size_t written = 0;
+    while (written < length) {
+      auto status = pwrite(block_file_fd_, output.Data() + written,
+                           length - written, offset + written);
+      if (status < 0) {
+        ReleaseBlock(offset, length);
+        tile_group->SetEvicted(false);
+        throw Exception("could not write anti-cache block : " +
+                        std::string(strerror(errno)));
+      }
+      written += status;
+    }
+
+    blocks_[tile_group->GetTileGroupId()] = std::make_pair(offset, length);
+  }
+
+  tile_group->ReleaseTiles();
+  eviction_count_++;
+
+  LOG_TRACE("Evicted tile group : %u", tile_group->GetTileGroupId());
+
+  return true;
+}
+
+void AntiCacheManager::FetchTileGroup(TileGroup *tile_group) {
+  PelotonWriteLock tile_group_lock(tile_group->GetAntiCacheLock());
+
+  // Somebody else fetched it, or the eviction was called off
+  if (tile_group->IsEvicted() == false) return;
+
+  auto tile_group_id = tile_group->GetTileGroupId();
+  std::pair<size_t, size_t> block;
+  {
+    std::lock_guard<std::mutex> block_file_lock(block_file_mutex_);
+    auto block_itr = blocks_.find(tile_group_id);
+    if (block_itr == blocks_.end()) {
+      throw Exception("missing anti-cache block for tile group : " +
+                      std::to_string(tile_group_id));
+    }
+    block = block_itr->second;
+  }
+
+  size_t offset = block.first;
+  size_t length = block.second;
+  std::unique_ptr<char[]> buffer(new char[length]);
+
+  size_t read = 0;
+  while (read < length) {
+    auto status =
+        pread(block_file_fd_, buffer.get() + read, length - read, offset + read);
+    if (status <= 0) {
+      throw Exception("could not read anti-cache block : " +
+                      std::string(strerror(errno)));
+    }
+    read += status;
+  }
+
+  ReferenceSerializeInput input(buffer.get(), length);
+  tile_group->DeserializeTilesFrom(input);
+
+  {
+    std::lock_guard<std::mutex> block_file_lock(block_file_mutex_);
+    blocks_.erase(tile_group_id);
+    ReleaseBlock(offset, length);
+  }
+
+  tile_group->SetEvicted(false);
+  fetch_count_++;
+
+  LOG_TRACE("Fetched tile group : %u", tile_group_id);
+}
+
+//===--------------------------------------------------------------------===//
+// Block File
+//===--------------------------------------------------------------------===//
+
+void AntiCacheManager::OpenBlockFile() {
+  if (block_file_fd_ >= 0) return;
+
+  // One block file per process
+  block_file_name_ = std::string(TMP_DIR) + std::string(ANTI_CACHE_FILE_NAME) +
+                     "." + std::to_string(getpid());
+
+  block_file_fd_ = open(block_file_name_.c_str(), O_CREAT | O_TRUNC | O_RDWR,
+                        S_IRUSR | S_IWUSR);
+  if (block_file_fd_ < 0) {
+    throw Exception("could not open anti-cache block file : " +
+                    block_file_name_);
+  }
+
+  LOG_TRACE("Anti-cache block file :: %s ", block_file_name_.c_str());
+}
+
+size_t AntiCacheManager::AllocateBlock(size_t length) {
+  // First fit among the released blocks
+  auto free_itr = free_blocks_.lower_bound(length);
+  if (free_itr != free_blocks_.end()) {
+    size_t free_length = free_itr->first;
+    size_t offset = free_itr->second;
+    free_blocks_.erase(free_itr);
+
+    if (free_length > length) {
+      free_blocks_.emplace(free_length - length, offset + length);
+    }
+
+    return offset;
+  }
+
+  // Otherwise grow the file
+  size_t offset = block_file_len_;
+  block_file_len_ += length;
+  return offset;
+}
+
+void AntiCacheManager::ReleaseBlock(size_t offset, size_t length) {
+  if (length == 0) return;
+
+  free_blocks_.emplace(length, offset);
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -10,17 +10,21 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <mutex>
+#include <thread>
 #include <utility>
 
 #include "brain/clusterer.h"
 #include "brain/sample.h"
 #include "catalog/catalog.h"
 #include "catalog/foreign_key.h"
+#include "common/container_tuple.h"
 #include "common/exception.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "common/task_scheduler.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
@@ -57,9 +61,10 @@ size_t DataTable::active_indirection_array_count_ = 1;
 DataTable::DataTable(catalog::Schema *schema, const std::string &table_name,
                      const oid_t &database_oid, const oid_t &table_oid,
                      const size_t &tuples_per_tilegroup, const bool own_schema,
-                     const bool adapt_table)
+                     const bool adapt_table, VarlenPoolType pool_type)
     : AbstractTable(database_oid, table_oid, table_name, schema, own_schema),
       tuples_per_tilegroup_(tuples_per_tilegroup),
+      pool_type_(pool_type),
       adapt_table_(adapt_table) {
   // Init default partition
   auto col_count = schema->GetColumnCount();
@@ -244,10 +249,13 @@ ItemPointer DataTable::AcquireVersion() {
 bool DataTable::InstallVersion(const AbstractTuple *tuple,
                                const TargetList *targets_ptr,
                                concurrency::Transaction *transaction,
-                               ItemPointer *index_entry_ptr) {
+                               ItemPointer *index_entry_ptr,
+                               const AbstractTuple *old_tuple) {
+  PelotonReadLock index_build_lock(index_build_lock_);
+
   // Index checks and updates
   if (InsertInSecondaryIndexes(tuple, targets_ptr, transaction,
-                               index_entry_ptr) == false) {
+                               index_entry_ptr, old_tuple) == false) {
     LOG_TRACE("Index constraint violated");
     return false;
   }
@@ -266,6 +274,10 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple,
     index_entry_ptr = &temp_ptr;
   }
 
+  // an index build must not add its index between the slot and the index
+  // entries of the tuple
+  PelotonReadLock index_build_lock(index_build_lock_);
+
   ItemPointer location = GetEmptyTupleSlot(tuple);
   if (location.block == INVALID_OID) {
     LOG_TRACE("Failed to get tuple slot.");
@@ -274,8 +286,19 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple,
 
   LOG_TRACE("Location: %u, %u", location.block, location.offset);
 
+  // Claim the slot for the transaction right away, so that an index build
+  // that runs before PerformInsert() does not take it for an empty slot
+  auto tile_group_header = catalog::Manager::GetInstance()
+                               .GetTileGroup(location.block)
+                               ->GetHeader();
+  if (transaction != nullptr) {
+    tile_group_header->SetTransactionId(location.offset,
+                                        transaction->GetTransactionId());
+  }
+
   auto index_count = GetIndexCount();
   if (index_count == 0) {
+    tile_group_header->SetIndirection(location.offset, nullptr);
     // Increase the table's number of tuples by 1
     IncreaseTupleCount(1);
     return location;
@@ -283,17 +306,20 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple,
   // Index checks and updates
   if (InsertInIndexes(tuple, location, transaction, index_entry_ptr) == false) {
     LOG_TRACE("Index constraint violated");
+    tile_group_header->SetTransactionId(location.offset, INVALID_TXN_ID);
     return INVALID_ITEMPOINTER;
   }
 
   // ForeignKey checks
   if (CheckForeignKeyConstraints(tuple) == false) {
     LOG_TRACE("ForeignKey constraint violated");
+    tile_group_header->SetTransactionId(location.offset, INVALID_TXN_ID);
     return INVALID_ITEMPOINTER;
   }
 
   PL_ASSERT((*index_entry_ptr)->block == location.block &&
             (*index_entry_ptr)->offset == location.offset);
+  tile_group_header->SetIndirection(location.offset, *index_entry_ptr);
 
   // Increase the table's number of tuples by 1
   IncreaseTupleCount(1);
@@ -318,6 +344,439 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
   return location;
 }
 
+/**
+ * @brief Bulk load tuples into fresh tile groups.
+ * The tuples skip the active tile groups and the per tuple bookkeeping of
+ * the transaction. Each new tile group is handed to the transaction as a
+ * whole, so all of its tuples are stamped with the same commit id and
+ * logged together on commit. The index entries are built once the tile
+ * groups are filled and inserted in key order, one batch per index.
+ *
+ * @returns True on success, false if a primary/unique constraint is
+ * violated. The tuples already loaded stay invisible until the transaction
+ * is aborted.
+ */
+bool DataTable::BulkLoad(const std::vector<const storage::Tuple *> &tuples,
+                         concurrency::Transaction *transaction) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  PelotonReadLock index_build_lock(index_build_lock_);
+  auto index_count = GetIndexCount();
+
+  for (auto tuple : tuples) {
+    if (CheckConstraints(tuple) == false ||
+        CheckForeignKeyConstraints(tuple) == false) {
+      LOG_TRACE("Constraint violated");
+      return false;
+    }
+  }
+
+  // head pointers of the new tuples, only needed if there are indexes
+  std::vector<ItemPointer *> index_entry_ptrs;
+  if (index_count > 0) {
+    index_entry_ptrs.resize(tuples.size(), nullptr);
+  }
+
+  auto column_map = GetTileGroupLayout((LayoutType)peloton_layout_mode);
+  size_t tuple_itr = 0;
+
+  while (tuple_itr < tuples.size()) {
+    // nobody else inserts into the tile group as it is never made active
+    std::shared_ptr<TileGroup> tile_group(GetTileGroupWithLayout(column_map));
+    PL_ASSERT(tile_group.get());
+
+    oid_t tile_group_id = tile_group->GetTileGroupId();
+    auto tile_group_header = tile_group->GetHeader();
+
+    for (; tuple_itr < tuples.size(); tuple_itr++) {
+      oid_t tuple_slot = tile_group->InsertTuple(tuples[tuple_itr]);
+      if (tuple_slot == INVALID_OID) {
+        break;
+      }
+
+      if (index_count > 0) {
+        index_entry_ptrs[tuple_itr] =
+            AllocateIndirection(ItemPointer(tile_group_id, tuple_slot));
+        tile_group_header->SetIndirection(tuple_slot,
+                                          index_entry_ptrs[tuple_itr]);
+      }
+    }
+
+    tile_groups_.Append(tile_group_id);
+
+    // add tile group metadata in locator
+    manager.AddTileGroup(tile_group_id, tile_group);
+
+    // we must guarantee that the compiler always add tile group before adding
+    // tile_group_count_.
+    COMPILER_MEMORY_FENCE;
+
+    tile_group_count_++;
+
+    // the tuples are not visible to anybody else until the commit
+    transaction_manager.PerformBulkInsert(transaction, tile_group_id);
+
+    LOG_TRACE("Bulk loaded tile group : %u ", tile_group_id);
+  }
+
+  for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+    auto index = GetIndex(index_itr);
+    if (BulkInsertInIndex(index.get(), tuples, index_entry_ptrs,
+                          transaction) == false) {
+      LOG_TRACE("Index constraint violated");
+      return false;
+    }
+  }
+
+  IncreaseTupleCount(tuples.size());
+
+  return true;
+}
+
+bool DataTable::BulkInsertInIndex(
+    index::Index *index, const std::vector<const storage::Tuple *> &tuples,
+    const std::vector<ItemPointer *> &index_entry_ptrs,
+    concurrency::Transaction *transaction) {
+  auto index_schema = index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+
+  std::vector<std::pair<std::unique_ptr<storage::Tuple>, ItemPointer *>>
+      entries;
+  entries.reserve(tuples.size());
+  for (size_t tuple_itr = 0; tuple_itr < tuples.size(); tuple_itr++) {
+    if (index->GetMetadata()->CoversTuple(tuples[tuple_itr]) == false) {
+      continue;
+    }
+
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    key->SetFromTuple(tuples[tuple_itr], indexed_columns, index->GetPool());
+    entries.emplace_back(std::move(key), index_entry_ptrs[tuple_itr]);
+  }
+
+  // sorted, the duplicates within the batch are neighbours
+  std::sort(entries.begin(), entries.end(),
+            [](const std::pair<std::unique_ptr<storage::Tuple>,
+                               ItemPointer *> &lhs,
+               const std::pair<std::unique_ptr<storage::Tuple>,
+                               ItemPointer *> &rhs) {
+              return lhs.first->Compare(*rhs.first) < 0;
+            });
+
+  bool unique = (index->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY ||
+                 index->GetIndexType() == INDEX_CONSTRAINT_TYPE_UNIQUE);
+  if (unique == true) {
+    for (size_t entry_itr = 1; entry_itr < entries.size(); entry_itr++) {
+      if (entries[entry_itr - 1].first->Compare(*entries[entry_itr].first) ==
+          0) {
+        return false;
+      }
+    }
+  }
+
+  // indexes without a bulk path of their own insert the entries one by one
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> batch;
+  std::vector<const storage::Tuple *> keys;
+  batch.reserve(entries.size());
+  keys.reserve(entries.size());
+  for (auto &entry : entries) {
+    batch.emplace_back(entry.first.get(), entry.second);
+    keys.push_back(entry.first.get());
+  }
+  index->BulkInsertEntries(batch, false);
+
+  if (unique == false) {
+    LOG_TRACE("Bulk inserted %lu entries in %s.", entries.size(),
+              index->GetName().c_str());
+    return true;
+  }
+
+  // The batch is in, so a concurrent insert of one of its keys either fails
+  // on our entry or shows up here next to it, along with the live tuples
+  // that had the key before
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  std::vector<std::vector<ItemPointer *>> results;
+  index->ScanBatch(keys, results);
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    for (auto location : results[key_itr]) {
+      if (location != batch[key_itr].second &&
+          transaction_manager.IsOccupied(transaction, location) == true) {
+        return false;
+      }
+    }
+  }
+
+  LOG_TRACE("Bulk inserted %lu entries in %s.", entries.size(),
+            index->GetName().c_str());
+
+  return true;
+}
+
+/**
+ * @brief Build the index entries of the tuples that are already in the
+ * given range of tile groups.
+ * Every thread takes every n-th tile group and builds the keys of all
+ * versions in it, each pointing to the head pointer of its version chain.
+ * Tuples inserted while the table had no index have no head pointer yet,
+ * the latest version gets one here.
+ *
+ * @returns The number of entries inserted in the index.
+ */
+size_t DataTable::PopulateIndex(index::Index *index, const oid_t &begin_offset,
+                                const oid_t &end_offset,
+                                const bool exclusive_access) {
+  auto index_schema = index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+
+  size_t tile_group_count = 0;
+  if (end_offset > begin_offset) {
+    tile_group_count = end_offset - begin_offset;
+  }
+
+  size_t thread_count = std::max(1U, std::thread::hardware_concurrency());
+  thread_count = std::max((size_t)1, std::min(thread_count, tile_group_count));
+
+  std::vector<std::vector<std::unique_ptr<storage::Tuple>>> thread_keys(
+      thread_count);
+  std::vector<std::vector<ItemPointer *>> thread_entry_ptrs(thread_count);
+
+  auto scan_tile_groups = [&](size_t thread_itr) {
+    for (oid_t tile_group_offset = begin_offset + thread_itr;
+         tile_group_offset < end_offset; tile_group_offset += thread_count) {
+      auto tile_group = GetTileGroup(tile_group_offset);
+      auto tile_group_header = tile_group->GetHeader();
+      oid_t active_tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+      for (oid_t tuple_slot = 0; tuple_slot < active_tuple_count;
+           tuple_slot++) {
+        if (tile_group_header->GetTransactionId(tuple_slot) ==
+            INVALID_TXN_ID) {
+          continue;
+        }
+
+        // the empty version left by a committed delete has no key
+        auto begin_cid = tile_group_header->GetBeginCommitId(tuple_slot);
+        if (begin_cid != MAX_CID &&
+            begin_cid == tile_group_header->GetEndCommitId(tuple_slot)) {
+          continue;
+        }
+
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        if (index_entry_ptr == nullptr) {
+          // older versions are reached through the latest one
+          if (tile_group_header->GetPrevItemPointer(tuple_slot).IsNull() ==
+              false) {
+            continue;
+          }
+          index_entry_ptr = AllocateIndirection(
+              ItemPointer(tile_group->GetTileGroupId(), tuple_slot));
+          tile_group_header->SetIndirection(tuple_slot, index_entry_ptr);
+        }
+
+        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                             tuple_slot);
+        if (index->GetMetadata()->CoversTuple(&tuple) == false) {
+          continue;
+        }
+
+        std::unique_ptr<storage::Tuple> key(
+            new storage::Tuple(index_schema, true));
+        key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+
+        thread_keys[thread_itr].push_back(std::move(key));
+        thread_entry_ptrs[thread_itr].push_back(index_entry_ptr);
+      }
+    }
+  };
+
+  auto &task_scheduler = TaskScheduler::GetInstance();
+  TaskGroup task_group;
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    task_scheduler.Submit(task_group,
+                          [&scan_tile_groups, thread_itr] {
+                            scan_tile_groups(thread_itr);
+                          });
+  }
+  scan_tile_groups(0);
+  task_scheduler.Wait(task_group);
+
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entries;
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    for (size_t entry_itr = 0; entry_itr < thread_keys[thread_itr].size();
+         entry_itr++) {
+      entries.emplace_back(thread_keys[thread_itr][entry_itr].get(),
+                           thread_entry_ptrs[thread_itr][entry_itr]);
+    }
+  }
+
+  size_t insert_count = index->BulkInsertEntries(entries, exclusive_access);
+
+  LOG_TRACE("Populated %s with %lu entries.", index->GetName().c_str(),
+            insert_count);
+
+  return insert_count;
+}
+
+/**
+ * @brief Build a new index on a table that may already have tuples, while
+ * other transactions keep using the table.
+ * The tuples already there are bulk loaded while writers go on. Writers are
+ * then held off while the tile groups that could have got new tuples
+ * meanwhile are scanned once more and the index is added to the table, so
+ * that every tuple is either checked here or checked by its writer against
+ * the complete index. The indexed tile group offset of the index is the
+ * watermark below which the tile groups are completely indexed. The
+ * optimizer only picks the index once the build is done.
+ *
+ * @returns False if the tuples violate the unique constraint of the index,
+ * in which case the index is not added to the table.
+ */
+bool DataTable::BuildIndex(std::shared_ptr<index::Index> index) {
+  index->SetReady(false);
+
+  // Tile groups that are full while no writer is in the middle of an insert
+  // do not get new tuples any more. Tile groups added from here on, or still
+  // filling up, are scanned again below.
+  oid_t tile_group_count;
+  oid_t full_tile_group_count = 0;
+  {
+    PelotonWriteLock index_build_lock(index_build_lock_);
+    tile_group_count = GetTileGroupCount();
+    while (full_tile_group_count < tile_group_count) {
+      auto tile_group = GetTileGroup(full_tile_group_count);
+      if (tile_group->GetNextTupleSlot() <
+          tile_group->GetAllocatedTupleCount()) {
+        break;
+      }
+      full_tile_group_count++;
+    }
+  }
+
+  PopulateIndex(index.get(), 0, tile_group_count, true);
+
+  auto index_type = index->GetIndexType();
+  bool unique = (index_type == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY ||
+                 index_type == INDEX_CONSTRAINT_TYPE_UNIQUE);
+  if (unique == true &&
+      CheckIndexUniqueness(index.get(), 0, tile_group_count) == false) {
+    LOG_TRACE("Unique constraint of %s violated", index->GetName().c_str());
+    return false;
+  }
+
+  while (index->GetIndexedTileGroupOff() < full_tile_group_count) {
+    index->IncrementIndexedTileGroupOffset();
+  }
+
+  {
+    PelotonWriteLock index_build_lock(index_build_lock_);
+
+    // catch up on the tuples inserted since the first pass, their writers
+    // did not see the index
+    oid_t catch_up_offset = index->GetIndexedTileGroupOff();
+    tile_group_count = GetTileGroupCount();
+    PopulateIndex(index.get(), catch_up_offset, tile_group_count, true);
+
+    if (unique == true &&
+        CheckIndexUniqueness(index.get(), catch_up_offset, tile_group_count) ==
+            false) {
+      LOG_TRACE("Unique constraint of %s violated", index->GetName().c_str());
+      return false;
+    }
+
+    while (index->GetIndexedTileGroupOff() < tile_group_count) {
+      index->IncrementIndexedTileGroupOffset();
+    }
+
+    AddIndex(index);
+  }
+
+  index->SetReady(true);
+
+  LOG_TRACE("Built index %s on %lu tuples", index->GetName().c_str(),
+            GetTupleCount());
+
+  return true;
+}
+
+/**
+ * @brief Check that no live tuple in the given range of tile groups shares
+ * a key of the index with another live tuple.
+ */
+bool DataTable::CheckIndexUniqueness(index::Index *index,
+                                     const oid_t &begin_offset,
+                                     const oid_t &end_offset) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto index_schema = index->GetKeySchema();
+  auto indexed_columns = index_schema->GetIndexedColumns();
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+  std::unique_ptr<storage::Tuple> other_key(
+      new storage::Tuple(index_schema, true));
+  std::vector<ItemPointer *> index_entries;
+
+  // the latest version of a tuple that is not deleted
+  auto is_live = [](const TileGroupHeader *tile_group_header,
+                    const oid_t &tuple_slot) {
+    return tile_group_header->GetTransactionId(tuple_slot) != INVALID_TXN_ID &&
+           tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID &&
+           tile_group_header->GetIndirection(tuple_slot) != nullptr;
+  };
+
+  for (oid_t tile_group_offset = begin_offset; tile_group_offset < end_offset;
+       tile_group_offset++) {
+    auto tile_group = GetTileGroup(tile_group_offset);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+    for (oid_t tuple_slot = 0; tuple_slot < active_tuple_count; tuple_slot++) {
+      if (is_live(tile_group_header, tuple_slot) == false) {
+        continue;
+      }
+
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                           tuple_slot);
+      if (index->GetMetadata()->CoversTuple(&tuple) == false) {
+        continue;
+      }
+      key->SetFromTuple(&tuple, indexed_columns, index->GetPool());
+
+      auto index_entry_ptr = tile_group_header->GetIndirection(tuple_slot);
+      index_entries.clear();
+      index->ScanKey(key.get(), index_entries);
+
+      for (auto other_entry_ptr : index_entries) {
+        if (other_entry_ptr == index_entry_ptr) {
+          continue;
+        }
+
+        // the entry may come from an older version with the same key
+        ItemPointer other_location = *other_entry_ptr;
+        auto other_tile_group = manager.GetTileGroup(other_location.block);
+        if (is_live(other_tile_group->GetHeader(), other_location.offset) ==
+            false) {
+          continue;
+        }
+
+        expression::ContainerTuple<storage::TileGroup> other_tuple(
+            other_tile_group.get(), other_location.offset);
+        if (index->GetMetadata()->CoversTuple(&other_tuple) == false) {
+          continue;
+        }
+        other_key->SetFromTuple(&other_tuple, indexed_columns,
+                                index->GetPool());
+        if (key->EqualsNoSchemaCheck(*other_key) == true) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
 /**
  * @brief Insert a tuple into all indexes. If index is primary/unique,
  * check visibility of existing
@@ -333,29 +792,7 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
                                 ItemPointer **index_entry_ptr) {
   int index_count = GetIndexCount();
 
-  size_t active_indirection_array_id =
-      number_of_tuples_ % active_indirection_array_count_;
-
-  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
-
-  while (true) {
-    auto active_indirection_array =
-        active_indirection_arrays_[active_indirection_array_id];
-    indirection_offset = active_indirection_array->AllocateIndirection();
-
-    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
-      *index_entry_ptr =
-          active_indirection_array->GetIndirectionByOffset(indirection_offset);
-      break;
-    }
-  }
-
-  (*index_entry_ptr)->block = location.block;
-  (*index_entry_ptr)->offset = location.offset;
-
-  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
-    AddDefaultIndirectionArray(active_indirection_array_id);
-  }
+  *index_entry_ptr = AllocateIndirection(location);
 
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
@@ -370,6 +807,12 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
 
   for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
     auto index = GetIndex(index_itr);
+
+    // A partial index has no entries for the tuples outside its predicate
+    if (index->GetMetadata()->CoversTuple(tuple) == false) {
+      continue;
+    }
+
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
     std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
@@ -409,7 +852,8 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
 bool DataTable::InsertInSecondaryIndexes(const AbstractTuple *tuple,
                                          const TargetList *targets_ptr,
                                          concurrency::Transaction *transaction,
-                                         ItemPointer *index_entry_ptr) {
+                                         ItemPointer *index_entry_ptr,
+                                         const AbstractTuple *old_tuple) {
   int index_count = GetIndexCount();
   // Transaform the target list into a hash set
   // when attempting to perform insertion to a secondary index,
@@ -449,6 +893,20 @@ bool DataTable::InsertInSecondaryIndexes(const AbstractTuple *tuple,
       }
     }
 
+    // A partial index only gets an entry for a version inside its
+    // predicate. If the key stays the same, the entry is only missing when
+    // the old version was outside the predicate.
+    auto index_metadata = index->GetMetadata();
+    if (index_metadata->IsPartial() == true) {
+      if (index_metadata->CoversTuple(tuple) == false) {
+        continue;
+      }
+      if (updated == false && old_tuple != nullptr &&
+          index_metadata->CoversTuple(old_tuple) == false) {
+        updated = true;
+      }
+    }
+
     // If attributes on key are not updated, skip the index update
     if (updated == false) {
       continue;
@@ -608,7 +1066,7 @@ TileGroup *DataTable::GetTileGroupWithLayout(
 
   TileGroup *tile_group = TileGroupFactory::GetTileGroup(
       database_oid, table_oid, tile_group_id, this, schemas, partitioning,
-      tuples_per_tilegroup_);
+      tuples_per_tilegroup_, pool_type_);
 
   return tile_group;
 }
@@ -643,6 +1101,35 @@ column_map_type DataTable::GetTileGroupLayout(LayoutType layout_type) {
   return column_map;
 }
 
+ItemPointer *DataTable::AllocateIndirection(const ItemPointer &location) {
+  size_t active_indirection_array_id =
+      number_of_tuples_ % active_indirection_array_count_;
+
+  size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
+  ItemPointer *index_entry_ptr = nullptr;
+
+  while (true) {
+    auto active_indirection_array =
+        active_indirection_arrays_[active_indirection_array_id];
+    indirection_offset = active_indirection_array->AllocateIndirection();
+
+    if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
+      index_entry_ptr =
+          active_indirection_array->GetIndirectionByOffset(indirection_offset);
+      break;
+    }
+  }
+
+  index_entry_ptr->block = location.block;
+  index_entry_ptr->offset = location.offset;
+
+  if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
+    AddDefaultIndirectionArray(active_indirection_array_id);
+  }
+
+  return index_entry_ptr;
+}
+
 oid_t DataTable::AddDefaultIndirectionArray(
     const size_t &active_indirection_array_id) {
   auto &manager = catalog::Manager::GetInstance();
@@ -714,7 +1201,7 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
 
   std::shared_ptr<TileGroup> tile_group(TileGroupFactory::GetTileGroup(
       database_oid, table_oid, tile_group_id, this, schemas, column_map,
-      tuples_per_tilegroup_));
+      tuples_per_tilegroup_, pool_type_));
 
   auto tile_groups_exists = tile_groups_.Contains(tile_group_id);
 
@@ -1080,7 +1567,8 @@ storage::TileGroup *DataTable::TransformTileGroup(
           tile_group->GetDatabaseId(), tile_group->GetTableId(),
           tile_group->GetTileGroupId(), tile_group->GetAbstractTable(),
           new_schema, default_partition_,
-          tile_group->GetAllocatedTupleCount()));
+          tile_group->GetAllocatedTupleCount(),
+          tile_group->GetVarlenPoolType()));
 
   // Set the transformed tile group column-at-a-time
   SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
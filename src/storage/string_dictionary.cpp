@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_dictionary.cpp
+//
+// Identification: src/storage/string_dictionary.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/string_dictionary.h"
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace storage {
+
+const size_t StringDictionary::DEFAULT_MAX_SIZE;
+
+StringDictionary::StringDictionary(size_t max_size) : max_size_(max_size) {}
+
+StringDictionary::~StringDictionary() {
+  for (auto entry : codes_) {
+    delete[] reinterpret_cast<char *>(entry);
+  }
+}
+
+const type::VarlenDictionaryEntry *StringDictionary::GetOrInsert(
+    const char *data, uint32_t length) {
+  std::string value(data, length);
+
+  std::lock_guard<std::mutex> lock(dictionary_mutex_);
+
+  auto entry_itr = entries_.find(value);
+  if (entry_itr != entries_.end()) {
+    return entry_itr->second;
+  }
+
+  if (codes_.size() >= max_size_) {
+    return nullptr;
+  }
+
+  // Entry header followed by the payload
+  char *location = new char[sizeof(type::VarlenDictionaryEntry) + length];
+  auto entry = reinterpret_cast<type::VarlenDictionaryEntry *>(location);
+  entry->code = codes_.size();
+  entry->length = length;
+  PL_MEMCPY(location + sizeof(type::VarlenDictionaryEntry), data, length);
+
+  codes_.push_back(entry);
+  entries_.emplace(std::move(value), entry);
+
+  return entry;
+}
+
+const type::VarlenDictionaryEntry *StringDictionary::Lookup(const char *data,
+                                                            uint32_t length) {
+  std::string value(data, length);
+
+  std::lock_guard<std::mutex> lock(dictionary_mutex_);
+
+  auto entry_itr = entries_.find(value);
+  if (entry_itr == entries_.end()) {
+    return nullptr;
+  }
+
+  return entry_itr->second;
+}
+
+const type::VarlenDictionaryEntry *StringDictionary::GetEntry(uint32_t code) {
+  std::lock_guard<std::mutex> lock(dictionary_mutex_);
+
+  PL_ASSERT(code < codes_.size());
+  return codes_[code];
+}
+
+size_t StringDictionary::GetSize() {
+  std::lock_guard<std::mutex> lock(dictionary_mutex_);
+  return codes_.size();
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -27,10 +27,11 @@ DataTable *TableFactory::GetDataTable(oid_t database_id, oid_t relation_id,
                                       catalog::Schema *schema,
                                       std::string table_name,
                                       size_t tuples_per_tilegroup_count,
-                                      bool own_schema, bool adapt_table) {
-  DataTable *table =
-      new DataTable(schema, table_name, database_id, relation_id,
-                    tuples_per_tilegroup_count, own_schema, adapt_table);
+                                      bool own_schema, bool adapt_table,
+                                      VarlenPoolType pool_type) {
+  DataTable *table = new DataTable(schema, table_name, database_id,
+                                   relation_id, tuples_per_tilegroup_count,
+                                   own_schema, adapt_table, pool_type);
 
   return table;
 }
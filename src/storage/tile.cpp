@@ -19,8 +19,10 @@
 #include "type/serializer.h"
 #include "type/types.h"
 #include "type/varlen_pool.h"
+#include "type/varlen_type.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "storage/storage_manager.h"
+#include "storage/string_dictionary.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
 #include "storage/tuple.h"
@@ -31,7 +33,7 @@ namespace storage {
 
 Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
            const catalog::Schema &tuple_schema, TileGroup *tile_group,
-           int tuple_count)
+           int tuple_count, VarlenPoolType pool_type)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
@@ -41,6 +43,8 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
       data(NULL),
       tile_group(tile_group),
       pool(NULL),
+      pool_type(pool_type),
+      pin_count(0),
       num_tuple_slots(tuple_count),
       column_count(tuple_schema.GetColumnCount()),
       tuple_length(tuple_schema.GetLength()),
@@ -63,8 +67,19 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
 
   // allocate pool for blob storage if schema not inlined
   // if (schema.IsInlined() == false) {
-  pool = new type::VarlenPool(backend_type);
+  pool = type::VarlenPool::CreatePool(pool_type, backend_type);
   //}
+
+  // set up the dictionaries of the dictionary encoded columns
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    if (schema.IsDictionaryEncoded(column_itr) == false ||
+        schema.IsInlined(column_itr) == true) {
+      continue;
+    }
+
+    if (dictionaries.empty()) dictionaries.resize(column_count);
+    dictionaries[column_itr].reset(new StringDictionary());
+  }
 }
 
 Tile::~Tile() {
@@ -139,6 +154,19 @@ type::Value Tile::GetValueFast(const oid_t tuple_offset,
                                         is_inlined);
 }
 
+ColumnAccessor Tile::GetColumnAccessor(const oid_t column_id) const {
+  PL_ASSERT(column_id < schema.GetColumnCount());
+
+  ColumnAccessor accessor;
+  accessor.base = data;
+  accessor.offset = schema.GetOffset(column_id);
+  accessor.stride = tuple_length;
+  accessor.type = schema.GetType(column_id);
+  accessor.is_inlined = schema.IsInlined(column_id);
+  accessor.dictionary = GetDictionary(column_id);
+  return accessor;
+}
+
 /**
  * Sets value at tuple slot.
  */
@@ -155,9 +183,30 @@ void Tile::SetValue(const type::Value &value, const oid_t tuple_offset,
 
   // const bool is_in_bytes = false;
   PL_ASSERT(pool != nullptr);
+  if (SetDictionaryValue(value, tuple_offset, column_id) == true) return;
   value.SerializeTo(field_location, is_inlined, pool);
 }
 
+bool Tile::SetDictionaryValue(const type::Value &value,
+                              const oid_t tuple_offset,
+                              const oid_t column_id) {
+  auto dictionary = GetDictionary(column_id);
+  if (dictionary == nullptr) return false;
+
+  // Nulls and values that need a cast take the regular path
+  if (value.GetTypeId() != schema.GetType(column_id) || value.IsNull()) {
+    return false;
+  }
+
+  auto entry = dictionary->GetOrInsert(value.GetData(), value.GetLength());
+  if (entry == nullptr) return false;
+
+  char *field_location =
+      GetTupleLocation(tuple_offset) + schema.GetOffset(column_id);
+  type::VarlenType::SetSlotDictionaryEntry(field_location, entry);
+  return true;
+}
+
 // Copy a column from this tile to a destination tile.
 // Note that we do shallow copy for varlen field
 void Tile::CopyColumnValueTo(Tile *dest_tile, oid_t dest_tuple_offset, oid_t dest_col_id, oid_t src_tuple_offset,
@@ -178,6 +227,14 @@ void Tile::CopyColumnValueTo(Tile *dest_tile, oid_t dest_tuple_offset, oid_t des
       char *dest_field_location = dest_tuple_location + dest_tile->schema.GetOffset(dest_col_id);
       bool is_inlined = this->schema.IsInlined();
       PL_ASSERT(dest_tile->schema.IsInlined() == is_inlined);
+
+      // Dictionary entries belong to this tile
+      if (dest_tile != this &&
+          type::VarlenType::IsSlotDictionaryEncoded(src_filed_location)) {
+        dest_tile->SetValue(GetValue(src_tuple_offset, src_col_id),
+                            dest_tuple_offset, dest_col_id);
+        break;
+      }
       type::Value::ShallowCopyTo(dest_field_location, src_filed_location, src_type_id, is_inlined, this->pool);
       break;
     }
@@ -225,7 +282,7 @@ Tile *Tile::CopyTile(BackendType backend_type) {
   TileGroupHeader *new_header = GetHeader();
   Tile *new_tile = TileFactory::GetTile(
       backend_type, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
-      new_header, *schema, tile_group, allocated_tuple_count);
+      new_header, *schema, tile_group, allocated_tuple_count, pool_type);
 
   PL_MEMCPY(static_cast<void *>(new_tile->data), static_cast<void *>(data),
             tile_size);
@@ -514,6 +571,113 @@ void Tile::Sync() {
   storage_manager.Sync(backend_type, data, tile_size);
 }
 
+//===--------------------------------------------------------------------===//
+// Anti-Caching
+//===--------------------------------------------------------------------===//
+
+void Tile::SerializeDataTo(SerializeOutput &output, oid_t num_tuples) {
+  /**
+   * The tile data is serialized as:
+   *
+   * [(int) num tuples] [inlined tuple slots]
+   * [uninlined column 0 : ((int) length, bytes) * num tuples] ...
+   *
+   * A length of -1 denotes a null pointer, -2 a value that is kept in the
+   * slot itself or in the dictionary of the column.
+   */
+  PL_ASSERT(data != nullptr);
+  PL_ASSERT(num_tuples <= num_tuple_slots);
+
+  output.WriteInt(static_cast<int32_t>(num_tuples));
+  output.WriteBytes(data, num_tuples * tuple_length);
+
+  auto uninlined_col_cnt = schema.GetUninlinedColumnCount();
+  for (oid_t col_itr = 0; col_itr < uninlined_col_cnt; col_itr++) {
+    auto column_id = schema.GetUninlinedColumn(col_itr);
+    auto column_offset = schema.GetOffset(column_id);
+
+    for (oid_t tuple_itr = 0; tuple_itr < num_tuples; tuple_itr++) {
+      // Recycled slots may still hold pointers that the GC already released
+      if (tile_group_header != nullptr &&
+          tile_group_header->GetTransactionId(tuple_itr) == INVALID_TXN_ID &&
+          tile_group_header->GetBeginCommitId(tuple_itr) == MAX_CID) {
+        output.WriteInt(-1);
+        continue;
+      }
+
+      const char *field_location = GetTupleLocation(tuple_itr) + column_offset;
+      if (type::VarlenType::IsSlotInlined(field_location) ||
+          type::VarlenType::IsSlotDictionaryEncoded(field_location)) {
+        output.WriteInt(-2);
+        continue;
+      }
+
+      const char *varlen_ptr =
+          *reinterpret_cast<const char *const *>(field_location);
+      if (varlen_ptr == nullptr) {
+        output.WriteInt(-1);
+        continue;
+      }
+
+      uint32_t length = *reinterpret_cast<const uint32_t *>(varlen_ptr);
+      output.WriteInt(static_cast<int32_t>(length));
+      output.WriteBytes(varlen_ptr + sizeof(uint32_t), length);
+    }
+  }
+}
+
+void Tile::ReleaseData() {
+  PL_ASSERT(data != nullptr);
+
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  storage_manager.Release(backend_type, data);
+  data = nullptr;
+
+  // Every uninlined value lives in this pool, so start over with an empty one.
+  // The dictionaries stay, slots restored later still point to their entries.
+  delete pool;
+  pool = type::VarlenPool::CreatePool(pool_type, backend_type);
+  uninlined_data_size = 0;
+}
+
+void Tile::DeserializeDataFrom(SerializeInput &input) {
+  PL_ASSERT(data == nullptr);
+
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  data = reinterpret_cast<char *>(
+      storage_manager.Allocate(backend_type, tile_size));
+  PL_ASSERT(data != NULL);
+  PL_MEMSET(data, 0, tile_size);
+
+  oid_t num_tuples = input.ReadInt();
+  PL_ASSERT(num_tuples <= num_tuple_slots);
+  input.ReadBytes(data, num_tuples * tuple_length);
+
+  auto uninlined_col_cnt = schema.GetUninlinedColumnCount();
+  for (oid_t col_itr = 0; col_itr < uninlined_col_cnt; col_itr++) {
+    auto column_id = schema.GetUninlinedColumn(col_itr);
+    auto column_offset = schema.GetOffset(column_id);
+
+    for (oid_t tuple_itr = 0; tuple_itr < num_tuples; tuple_itr++) {
+      char *field_location = GetTupleLocation(tuple_itr) + column_offset;
+      int32_t length = input.ReadInt();
+      if (length == -2) continue;
+      if (length < 0) {
+        *reinterpret_cast<char **>(field_location) = nullptr;
+        continue;
+      }
+
+      // Rebuild the [length | payload] block inside the new pool
+      char *varlen_ptr =
+          reinterpret_cast<char *>(pool->Allocate(length + sizeof(uint32_t)));
+      uint32_t varlen_length = length;
+      PL_MEMCPY(varlen_ptr, &varlen_length, sizeof(uint32_t));
+      input.ReadBytes(varlen_ptr + sizeof(uint32_t), length);
+      *reinterpret_cast<char **>(field_location) = varlen_ptr;
+    }
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -30,25 +30,38 @@ namespace storage {
 TileGroup::TileGroup(BackendType backend_type,
                      TileGroupHeader *tile_group_header, AbstractTable *table,
                      const std::vector<catalog::Schema> &schemas,
-                     const column_map_type &column_map, int tuple_count)
+                     const column_map_type &column_map, int tuple_count,
+                     VarlenPoolType pool_type)
     : database_id(INVALID_OID),
       table_id(INVALID_OID),
       tile_group_id(INVALID_OID),
       backend_type(backend_type),
+      pool_type(pool_type),
       tile_schemas(schemas),
       tile_group_header(tile_group_header),
       table(table),
       num_tuple_slots(tuple_count),
-      column_map(column_map) {
+      column_map(column_map),
+      evicted(false),
+      last_access(0),
+      pin_count(0) {
   tile_count = tile_schemas.size();
 
+  // the column map is looked up for every value, so flatten it
+  column_locations.resize(column_map.size());
+  for (auto &entry : column_map) {
+    PL_ASSERT(entry.first < column_locations.size());
+    column_locations[entry.first] = entry.second;
+  }
+
   for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
     auto &manager = catalog::Manager::GetInstance();
     oid_t tile_id = manager.GetNextTileId();
 
     std::shared_ptr<Tile> tile(storage::TileFactory::GetTile(
         backend_type, database_id, table_id, tile_group_id, tile_id,
-        tile_group_header, tile_schemas[tile_itr], this, tuple_count));
+        tile_group_header, tile_schemas[tile_itr], this, tuple_count,
+        pool_type));
 
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
@@ -117,7 +130,10 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
     for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
-      tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      if (tile->SetDictionaryValue(val, tuple_slot_id, tile_column_itr) ==
+          false) {
+        tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      }
       column_itr++;
     }
   }
@@ -214,7 +230,10 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
     for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
-      tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      if (tile->SetDictionaryValue(val, tuple_slot_id, tile_column_itr) ==
+          false) {
+        tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      }
       column_itr++;
     }
   }
@@ -314,7 +333,10 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
     for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
          tile_column_itr++) {
       type::Value val = (tuple->GetValue(column_itr));
-      tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      if (tile->SetDictionaryValue(val, tuple_slot_id, tile_column_itr) ==
+          false) {
+        tile_tuple.SetValue(tile_column_itr, val, tile->GetPool());
+      }
       column_itr++;
     }
   }
@@ -332,10 +354,10 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
 // the specified tile group column id.
 void TileGroup::LocateTileAndColumn(oid_t column_offset, oid_t &tile_offset,
                                     oid_t &tile_column_offset) {
-  PL_ASSERT(column_map.count(column_offset) != 0);
+  PL_ASSERT(column_offset < column_locations.size());
 
   // get the entry in the column map
-  auto entry = column_map.at(column_offset);
+  auto &entry = column_locations[column_offset];
   tile_offset = entry.first;
   tile_column_offset = entry.second;
 }
@@ -359,6 +381,39 @@ type::Value TileGroup::GetValue(oid_t tuple_id, oid_t column_id) {
   return GetTile(tile_offset)->GetValue(tuple_id, tile_column_id);
 }
 
+ColumnAccessor TileGroup::GetColumnAccessor(oid_t column_id) const {
+  PL_ASSERT(column_id < column_locations.size());
+  auto &entry = column_locations[column_id];
+
+  return GetTile(entry.first)->GetColumnAccessor(entry.second);
+}
+
+StringDictionary *TileGroup::GetDictionary(oid_t column_id) const {
+  PL_ASSERT(column_id < column_locations.size());
+  auto &entry = column_locations[column_id];
+
+  return GetTile(entry.first)->GetDictionary(entry.second);
+}
+
+std::vector<ColumnAccessor> TileGroup::GetColumnAccessors(
+    const std::vector<oid_t> &column_ids) const {
+  std::vector<ColumnAccessor> accessors;
+  accessors.reserve(column_ids.size());
+  for (auto column_id : column_ids) {
+    accessors.push_back(GetColumnAccessor(column_id));
+  }
+  return accessors;
+}
+
+std::vector<ColumnAccessor> TileGroup::GetColumnAccessors() const {
+  std::vector<ColumnAccessor> accessors;
+  accessors.reserve(column_locations.size());
+  for (oid_t column_id = 0; column_id < column_locations.size(); column_id++) {
+    accessors.push_back(GetColumnAccessor(column_id));
+  }
+  return accessors;
+}
+
 void TileGroup::SetValue(type::Value &value, oid_t tuple_id,
                          oid_t column_id) {
   PL_ASSERT(tuple_id < GetNextTupleSlot());
@@ -389,7 +444,9 @@ Tile *TileGroup::GetTile(const oid_t tile_offset) const {
 std::shared_ptr<Tile> TileGroup::GetTileReference(
     const oid_t tile_offset) const {
   PL_ASSERT(tile_offset < tile_count);
-  return tiles[tile_offset];
+  auto tile = tiles[tile_offset];
+  tile->Pin();
+  return std::shared_ptr<Tile>(tile.get(), [tile](Tile *) { tile->Unpin(); });
 }
 
 double TileGroup::GetSchemaDifference(
@@ -419,6 +476,56 @@ void TileGroup::Sync() {
   }
 }
 
+//===--------------------------------------------------------------------===//
+// Anti-Caching
+//===--------------------------------------------------------------------===//
+
+size_t TileGroup::GetResidentSize() const {
+  if (evicted == true) return 0;
+
+  size_t resident_size = 0;
+  for (auto tile : tiles) {
+    resident_size += tile->GetInlinedSize();
+    resident_size += tile->GetPool()->GetTotalAllocatedSpace();
+  }
+
+  return resident_size;
+}
+
+void TileGroup::SerializeTilesTo(SerializeOutput &output) {
+  oid_t num_tuples = tile_group_header->GetCurrentNextTupleSlot();
+
+  for (auto tile : tiles) {
+    tile->SerializeDataTo(output, num_tuples);
+  }
+}
+
+bool TileGroup::IsTileReferenced() const {
+  for (auto &tile : tiles) {
+    if (tile->GetPinCount() > 0) return true;
+  }
+  return false;
+}
+
+std::shared_ptr<TileGroup> TileGroup::GetPinnedReference(
+    const std::shared_ptr<TileGroup> &tile_group) {
+  tile_group->Pin();
+  return std::shared_ptr<TileGroup>(
+      tile_group.get(), [tile_group](TileGroup *) { tile_group->Unpin(); });
+}
+
+void TileGroup::ReleaseTiles() {
+  for (auto tile : tiles) {
+    tile->ReleaseData();
+  }
+}
+
+void TileGroup::DeserializeTilesFrom(SerializeInput &input) {
+  for (auto tile : tiles) {
+    tile->DeserializeDataFrom(input);
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -27,14 +27,16 @@ namespace storage {
 TileGroup *TileGroupFactory::GetTileGroup(
     oid_t database_id, oid_t table_id, oid_t tile_group_id,
     AbstractTable *table, const std::vector<catalog::Schema> &schemas,
-    const column_map_type &column_map, int tuple_count) {
+    const column_map_type &column_map, int tuple_count,
+    VarlenPoolType pool_type) {
   // Allocate the data on appropriate backend
   BackendType backend_type =
       logging::LoggingUtil::GetBackendType(peloton_logging_mode);
 
   TileGroupHeader *tile_header = new TileGroupHeader(backend_type, tuple_count);
   TileGroup *tile_group = new TileGroup(backend_type, tile_header, table,
-                                        schemas, column_map, tuple_count);
+                                        schemas, column_map, tuple_count,
+                                        pool_type);
 
   tile_header->SetTileGroup(tile_group);
 
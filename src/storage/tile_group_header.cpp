@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -35,7 +36,11 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
-      tile_header_lock() {
+      tile_header_lock(),
+      modified(false),
+      visible_tuple_count(0),
+      visible_commit_id(INVALID_CID),
+      visibility_lock() {
   header_size = num_tuple_slots * header_entry_size;
 
   // allocate storage space for header
@@ -179,6 +184,49 @@ void TileGroupHeader::PrintVisibility(txn_id_t txn_id, cid_t at_cid) {
   LOG_TRACE("%s", os.str().c_str());
 }
 
+/**
+ * @brief Cheap visibility check for index-only scans.
+ * Only committed inserts that were never touched again are all-visible: the
+ * tuple is the only version of its version chain, so the index entries that
+ * lead to it hold its current values. The prefix of such slots is extended
+ * lazily by whoever asks about a slot beyond it. Readers that find the
+ * prefix being extended just go to the table.
+ */
+bool TileGroupHeader::IsAllVisible(const oid_t &tuple_slot_id,
+                                   const cid_t &read_cid) {
+  if (modified.load() == true) {
+    return false;
+  }
+
+  if (tuple_slot_id >= visible_tuple_count.load()) {
+    if (visibility_lock.TryLock() == false) {
+      return false;
+    }
+
+    oid_t tuple_count = visible_tuple_count.load();
+    cid_t commit_id = visible_commit_id.load();
+    oid_t active_tuple_slots = GetCurrentNextTupleSlot();
+    while (tuple_count < active_tuple_slots &&
+           GetTransactionId(tuple_count) == INITIAL_TXN_ID &&
+           GetEndCommitId(tuple_count) == MAX_CID) {
+      commit_id = std::max(commit_id, GetBeginCommitId(tuple_count));
+      tuple_count++;
+    }
+
+    // The commit id has to be in place before the slots it covers
+    visible_commit_id = commit_id;
+    visible_tuple_count = tuple_count;
+
+    visibility_lock.Unlock();
+
+    if (tuple_slot_id >= tuple_count) {
+      return false;
+    }
+  }
+
+  return visible_commit_id.load() <= read_cid;
+}
+
 // this function is called only when building tile groups for aggregation
 // operations.
 oid_t TileGroupHeader::GetActiveTupleCount() {
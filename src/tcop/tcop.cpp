@@ -24,6 +24,7 @@
 #include "expression/aggregate_expression.h"
 #include "expression/expression_util.h"
 
+#include "parser/explain_statement.h"
 #include "parser/parser.h"
 #include "parser/select_statement.h"
 
@@ -92,8 +93,20 @@ Result TrafficCop::ExecuteStatement(
             statement->GetStatementName().c_str());
   try {
     bridge::PlanExecutor::PrintPlan(statement->GetPlanTree().get(), "Plan");
+
+    // EXPLAIN only returns the plan, without running it
+    if (statement->GetExplainType() == EXPLAIN_TYPE_PLAN) {
+      result.clear();
+      bridge::PlanExecutor::ExplainPlan(statement->GetPlanTree().get(),
+                                        result);
+      rows_changed = 0;
+      return Result::RESULT_SUCCESS;
+    }
+
+    bool analyze = (statement->GetExplainType() == EXPLAIN_TYPE_ANALYZE);
     bridge::peloton_status status = bridge::PlanExecutor::ExecutePlan(
-        statement->GetPlanTree().get(), params, result, result_format);
+        statement->GetPlanTree().get(), params, result, result_format,
+        analyze);
     LOG_TRACE("Statement executed. Result: %d", status.m_result);
     rows_changed = status.m_processed;
     return status.m_result;
@@ -118,14 +131,35 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
     if (sql_stmt->is_valid == false) {
       throw ParserException("Error parsing SQL statement");
     }
+
+    // EXPLAIN [ANALYZE] plans the statement it explains, which replaces it
+    if (sql_stmt->GetNumStatements() > 0 &&
+        sql_stmt->GetStatement(0)->GetType() == STATEMENT_TYPE_EXPLAIN) {
+      auto explain_stmt =
+          (parser::ExplainStatement *)sql_stmt->GetStatement(0);
+      statement->SetExplainType(explain_stmt->analyze ? EXPLAIN_TYPE_ANALYZE
+                                                      : EXPLAIN_TYPE_PLAN);
+      sql_stmt->statements[0] = explain_stmt->statement;
+      explain_stmt->statement = nullptr;
+      delete explain_stmt;
+    }
+
     statement->SetPlanTree(optimizer_->BuildPelotonPlanTree(sql_stmt));
 
-    for (auto stmt : sql_stmt->GetStatements()) {
-      if (stmt->GetType() == STATEMENT_TYPE_SELECT) {
-        auto tuple_descriptor = GenerateTupleDescriptor(stmt);
-        statement->SetTupleDescriptor(tuple_descriptor);
+    if (statement->GetExplainType() != EXPLAIN_TYPE_INVALID) {
+      // A line of text per plan node or executor
+      std::vector<FieldInfoType> tuple_descriptor = {
+          std::make_tuple(bridge::PlanExecutor::explain_column_name,
+                          POSTGRES_VALUE_TYPE_TEXT, 255)};
+      statement->SetTupleDescriptor(tuple_descriptor);
+    } else {
+      for (auto stmt : sql_stmt->GetStatements()) {
+        if (stmt->GetType() == STATEMENT_TYPE_SELECT) {
+          auto tuple_descriptor = GenerateTupleDescriptor(stmt);
+          statement->SetTupleDescriptor(tuple_descriptor);
+        }
+        break;
       }
-      break;
     }
 
     bridge::PlanExecutor::PrintPlan(statement->GetPlanTree().get(), "Plan");
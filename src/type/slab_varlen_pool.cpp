@@ -0,0 +1,352 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// slab_varlen_pool.cpp
+//
+// Identification: src/type/slab_varlen_pool.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "type/slab_varlen_pool.h"
+
+#include "concurrency/epoch_manager_factory.h"
+
+namespace peloton {
+namespace type {
+
+const size_t SlabVarlenPool::SLAB_SIZE;
+const size_t SlabVarlenPool::SLAB_MIN_BLOCK_SIZE;
+const size_t SlabVarlenPool::SLAB_SIZE_CLASS_NUM;
+const size_t SlabVarlenPool::SLAB_MAX_BLOCK_SIZE;
+const size_t SlabVarlenPool::SLAB_LARGE_SIZE_CLASS;
+const size_t SlabVarlenPool::SLAB_FREE_LIST_NUM;
+
+// Free list used by the calling thread
+static size_t GetFreeListId() {
+  static std::atomic<size_t> next_free_list_id(0);
+  static thread_local size_t free_list_id =
+      next_free_list_id++ % SlabVarlenPool::SLAB_FREE_LIST_NUM;
+  return free_list_id;
+}
+
+SlabVarlenPool::SlabVarlenPool(BackendType backend_type)
+    : VarlenPool(backend_type),
+      deferred_free_(true),
+      allocated_size_(0),
+      reserved_size_(0),
+      retired_count_(0) {
+  for (size_t size_class = 0; size_class < SLAB_SIZE_CLASS_NUM; size_class++) {
+    for (size_t list_id = 0; list_id < SLAB_FREE_LIST_NUM; list_id++) {
+      free_lists_[size_class][list_id] = {nullptr, 0};
+    }
+    reclaimed_epoch_[size_class] = 0;
+    slab_offset_[size_class] = SLAB_SIZE;
+  }
+}
+
+// Destroy this pool, and all memory it owns.
+SlabVarlenPool::~SlabVarlenPool() {
+  for (size_t size_class = 0; size_class < SLAB_SIZE_CLASS_NUM; size_class++) {
+    for (auto slab : slabs_[size_class]) {
+      delete[] slab;
+    }
+  }
+
+  for (auto large_block : large_blocks_) {
+    delete[] large_block;
+  }
+}
+
+size_t SlabVarlenPool::GetSizeClass(size_t block_size) {
+  size_t size_class = 0;
+  while (GetBlockSize(size_class) < block_size) {
+    size_class++;
+  }
+  return size_class;
+}
+
+//===--------------------------------------------------------------------===//
+// Lock-free lists
+//===--------------------------------------------------------------------===//
+
+static inline bool CompareAndSwapHead(void *head, const void *expected,
+                                      const void *desired) {
+  unsigned __int128 expected_value, desired_value;
+  PL_MEMCPY(&expected_value, expected, sizeof(expected_value));
+  PL_MEMCPY(&desired_value, desired, sizeof(desired_value));
+  return __sync_bool_compare_and_swap(
+      reinterpret_cast<unsigned __int128 *>(head), expected_value,
+      desired_value);
+}
+
+void SlabVarlenPool::PushBlocks(FreeListHead *head, FreeBlock *first,
+                                FreeBlock *last) {
+  FreeListHead expected, desired;
+  do {
+    // A torn read only makes the swap fail
+    expected.tag = __atomic_load_n(&head->tag, __ATOMIC_ACQUIRE);
+    expected.top = __atomic_load_n(&head->top, __ATOMIC_ACQUIRE);
+    last->next = expected.top;
+    desired = {first, expected.tag + 1};
+  } while (CompareAndSwapHead(head, &expected, &desired) == false);
+}
+
+SlabVarlenPool::FreeBlock *SlabVarlenPool::PopBlock(FreeListHead *head) {
+  FreeListHead expected, desired;
+  do {
+    expected.tag = __atomic_load_n(&head->tag, __ATOMIC_ACQUIRE);
+    expected.top = __atomic_load_n(&head->top, __ATOMIC_ACQUIRE);
+    if (expected.top == nullptr) return nullptr;
+
+    // The top block may be handed out concurrently, but slabs stay mapped
+    // until the pool goes away and the tag tells us to retry
+    desired = {expected.top->next, expected.tag + 1};
+  } while (CompareAndSwapHead(head, &expected, &desired) == false);
+
+  return expected.top;
+}
+
+//===--------------------------------------------------------------------===//
+// Allocation
+//===--------------------------------------------------------------------===//
+
+void *SlabVarlenPool::Allocate(size_t size) {
+  size_t block_size = size + sizeof(BlockHeader);
+  if (block_size > SLAB_MAX_BLOCK_SIZE) {
+    return AllocateLarge(size);
+  }
+
+  auto size_class = GetSizeClass(block_size);
+  auto free_list_id = GetFreeListId();
+  auto free_lists = free_lists_[size_class];
+
+  // Own free list first, then the ones of the other threads
+  FreeBlock *block = PopBlock(&free_lists[free_list_id]);
+  for (size_t list_itr = 1; block == nullptr && list_itr < SLAB_FREE_LIST_NUM;
+       list_itr++) {
+    block = PopBlock(&free_lists[(free_list_id + list_itr) % SLAB_FREE_LIST_NUM]);
+  }
+
+  if (block == nullptr && retired_count_ != 0) {
+    ReclaimRetiredBlocks(size_class, free_list_id);
+    block = PopBlock(&free_lists[free_list_id]);
+  }
+
+  if (block == nullptr) {
+    block = CarveBlock(size_class);
+    if (block == nullptr) return nullptr;
+  }
+
+  auto header = reinterpret_cast<BlockHeader *>(block);
+  new (&header->ref_count) std::atomic<int32_t>(1);
+  header->size_class = size_class;
+
+  allocated_size_ += GetBlockSize(size_class);
+
+  return reinterpret_cast<char *>(header) + sizeof(BlockHeader);
+}
+
+void SlabVarlenPool::ReclaimRetiredBlocks(size_t size_class,
+                                          size_t free_list_id) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto reclaimable_epoch = epoch_manager.GetReclaimableEpoch();
+
+  // Nothing new can be reclaimed until the epoch moves on
+  auto reclaimed_epoch = reclaimed_epoch_[size_class].load();
+  if (reclaimed_epoch == reclaimable_epoch ||
+      reclaimed_epoch_[size_class].compare_exchange_strong(
+          reclaimed_epoch, reclaimable_epoch) == false) {
+    return;
+  }
+
+  // Blocks retired by every thread, as the threads that free blocks (e.g.
+  // the GC) are not necessarily the ones that allocate them. Only now that
+  // nobody reads them anymore are they linked into a free list.
+  FreeBlock *reclaimed_first = nullptr, *reclaimed_last = nullptr;
+  size_t reclaimed_count = 0;
+
+  retired_lock_[size_class].Lock();
+  auto &retired_blocks = retired_blocks_[size_class];
+  size_t retired_itr = 0;
+  while (retired_itr < retired_blocks.size()) {
+    if (retired_blocks[retired_itr].second >= reclaimable_epoch) {
+      retired_itr++;
+      continue;
+    }
+
+    auto block = retired_blocks[retired_itr].first;
+    retired_blocks[retired_itr] = retired_blocks.back();
+    retired_blocks.pop_back();
+
+    block->next = reclaimed_first;
+    reclaimed_first = block;
+    if (reclaimed_last == nullptr) reclaimed_last = block;
+    reclaimed_count++;
+  }
+  retired_lock_[size_class].Unlock();
+
+  if (reclaimed_first != nullptr) {
+    retired_count_ -= reclaimed_count;
+    PushBlocks(&free_lists_[size_class][free_list_id], reclaimed_first,
+               reclaimed_last);
+  }
+}
+
+SlabVarlenPool::FreeBlock *SlabVarlenPool::CarveBlock(size_t size_class) {
+  auto block_size = GetBlockSize(size_class);
+
+  slab_lock_[size_class].Lock();
+
+  if (slab_offset_[size_class] + block_size > SLAB_SIZE) {
+    if (reserved_size_ + SLAB_SIZE > MAX_POOL_SIZE) {
+      slab_lock_[size_class].Unlock();
+      return nullptr;
+    }
+
+    slabs_[size_class].push_back(new char[SLAB_SIZE]);
+    slab_offset_[size_class] = 0;
+    reserved_size_ += SLAB_SIZE;
+  }
+
+  char *block = slabs_[size_class].back() + slab_offset_[size_class];
+  slab_offset_[size_class] += block_size;
+
+  slab_lock_[size_class].Unlock();
+
+  return reinterpret_cast<FreeBlock *>(block);
+}
+
+void *SlabVarlenPool::AllocateLarge(size_t size) {
+  size_t length = sizeof(LargeBlockHeader) + sizeof(BlockHeader) + size;
+  if (reserved_size_ + length > MAX_POOL_SIZE) {
+    return nullptr;
+  }
+
+  char *large_block = new char[length];
+  reinterpret_cast<LargeBlockHeader *>(large_block)->length = length;
+
+  auto header = reinterpret_cast<BlockHeader *>(large_block +
+                                                sizeof(LargeBlockHeader));
+  new (&header->ref_count) std::atomic<int32_t>(1);
+  header->size_class = SLAB_LARGE_SIZE_CLASS;
+
+  large_lock_.Lock();
+  large_blocks_.insert(large_block);
+  ReclaimLargeBlocks();
+  large_lock_.Unlock();
+
+  reserved_size_ += length;
+  allocated_size_ += length;
+
+  return reinterpret_cast<char *>(header) + sizeof(BlockHeader);
+}
+
+//===--------------------------------------------------------------------===//
+// Reference counting
+//===--------------------------------------------------------------------===//
+
+void SlabVarlenPool::AddRefCount(void *ptr) {
+  GetHeader(ptr)->ref_count.fetch_add(1);
+}
+
+int64_t SlabVarlenPool::GetRefCount(void *ptr) {
+  return GetHeader(ptr)->ref_count.load();
+}
+
+void SlabVarlenPool::Free(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto header = GetHeader(ptr);
+  int32_t ref_cnt = header->ref_count.fetch_sub(1);
+  PL_ASSERT(ref_cnt > 0);
+  if (ref_cnt != 1) {
+    return;
+  }
+
+  size_t size_class = header->size_class;
+  if (size_class == SLAB_LARGE_SIZE_CLASS) {
+    FreeLarge(header);
+    return;
+  }
+
+  PL_ASSERT(size_class < SLAB_SIZE_CLASS_NUM);
+  allocated_size_ -= GetBlockSize(size_class);
+
+  auto block = reinterpret_cast<FreeBlock *>(header);
+
+  if (deferred_free_ == false) {
+    PushBlocks(&free_lists_[size_class][GetFreeListId()], block, block);
+    return;
+  }
+
+  // Readers of older versions may still look at the block, so it is not
+  // written to until its epoch has passed
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto retire_epoch = epoch_manager.GetCurrentEpoch();
+
+  retired_lock_[size_class].Lock();
+  retired_blocks_[size_class].emplace_back(block, retire_epoch);
+  retired_lock_[size_class].Unlock();
+  retired_count_++;
+}
+
+void SlabVarlenPool::FreeLarge(BlockHeader *header) {
+  char *large_block =
+      reinterpret_cast<char *>(header) - sizeof(LargeBlockHeader);
+  auto large_block_header = reinterpret_cast<LargeBlockHeader *>(large_block);
+  allocated_size_ -= large_block_header->length;
+
+  large_lock_.Lock();
+
+  if (deferred_free_ == false) {
+    large_blocks_.erase(large_block);
+    reserved_size_ -= large_block_header->length;
+    delete[] large_block;
+  } else {
+    auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+    large_block_header->retire_epoch = epoch_manager.GetCurrentEpoch();
+    retired_large_blocks_.push_back(large_block);
+    retired_count_++;
+  }
+
+  ReclaimLargeBlocks();
+
+  large_lock_.Unlock();
+}
+
+void SlabVarlenPool::ReclaimLargeBlocks() {
+  if (retired_large_blocks_.empty() == true) return;
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto reclaimable_epoch = epoch_manager.GetReclaimableEpoch();
+
+  size_t retired_itr = 0;
+  while (retired_itr < retired_large_blocks_.size()) {
+    char *large_block = retired_large_blocks_[retired_itr];
+    auto large_block_header = reinterpret_cast<LargeBlockHeader *>(large_block);
+
+    if (large_block_header->retire_epoch >= reclaimable_epoch) {
+      retired_itr++;
+      continue;
+    }
+
+    retired_large_blocks_[retired_itr] = retired_large_blocks_.back();
+    retired_large_blocks_.pop_back();
+
+    large_blocks_.erase(large_block);
+    reserved_size_ -= large_block_header->length;
+    retired_count_--;
+    delete[] large_block;
+  }
+}
+
+// Get the total number of bytes handed out by this pool.
+uint64_t SlabVarlenPool::GetTotalAllocatedSpace() { return allocated_size_; }
+
+}  // namespace type
+}  // namespace peloton
@@ -32,6 +32,8 @@ FileHandle INVALID_FILE_HANDLE;
 int DEFAULT_TUPLES_PER_TILEGROUP = 1000;
 int TEST_TUPLES_PER_TILEGROUP = 5;
 
+VarlenPoolType DEFAULT_VARLEN_POOL_TYPE = VARLEN_POOL_TYPE_BUFFER;
+
 // For threads
 size_t QUERY_THREAD_COUNT = 1;
 size_t LOGGING_THREAD_COUNT = 1;
@@ -76,6 +78,31 @@ BackendType StringToBackendType(std::string str) {
   return BACKEND_TYPE_INVALID;
 }
 
+//===--------------------------------------------------------------------===//
+// VarlenPoolType <--> String Utilities
+//===--------------------------------------------------------------------===//
+
+std::string VarlenPoolTypeToString(VarlenPoolType type) {
+  switch (type) {
+    case (VARLEN_POOL_TYPE_BUFFER):
+      return "BUFFER";
+    case (VARLEN_POOL_TYPE_SLAB):
+      return "SLAB";
+    case (VARLEN_POOL_TYPE_INVALID):
+      return "INVALID";
+    default: { return "UNKNOWN " + std::to_string(type); }
+  }
+}
+
+VarlenPoolType StringToVarlenPoolType(const std::string &str) {
+  if (str == "BUFFER") {
+    return VARLEN_POOL_TYPE_BUFFER;
+  } else if (str == "SLAB") {
+    return VARLEN_POOL_TYPE_SLAB;
+  }
+  return VARLEN_POOL_TYPE_INVALID;
+}
+
 //===--------------------------------------------------------------------===//
 // Value <--> String Utilities
 //===--------------------------------------------------------------------===//
@@ -220,6 +247,9 @@ std::string StatementTypeToString(StatementType type) {
     case STATEMENT_TYPE_COPY: {
       return "COPY";
     }
+    case STATEMENT_TYPE_EXPLAIN: {
+      return "EXPLAIN";
+    }
     case STATEMENT_TYPE_INSERT: {
       return "INSERT";
     }
@@ -272,6 +302,8 @@ StatementType StringToStatementType(const std::string& str) {
     return STATEMENT_TYPE_TRANSACTION;
   } else if (str == "COPY") {
     return STATEMENT_TYPE_COPY;
+  } else if (str == "EXPLAIN") {
+    return STATEMENT_TYPE_EXPLAIN;
   } else {
     throw ConversionException("No conversion from string '" + str + "'");
   }
@@ -479,6 +511,9 @@ std::string ExpressionTypeToString(ExpressionType type) {
     case EXPRESSION_TYPE_FUNCTION_REF: {
       return ("FUNCTION_REF");
     }
+    case EXPRESSION_TYPE_COLUMN_FILTER: {
+      return ("COLUMN_FILTER");
+    }
     case EXPRESSION_TYPE_CAST: {
       return ("CAST");
     }
@@ -638,6 +673,8 @@ ExpressionType StringToExpressionType(const std::string& str) {
     return EXPRESSION_TYPE_COLUMN_REF;
   } else if (str == "FUNCTION_REF") {
     return EXPRESSION_TYPE_FUNCTION_REF;
+  } else if (str == "COLUMN_FILTER") {
+    return EXPRESSION_TYPE_COLUMN_FILTER;
   } else if (str == "CAST") {
     return EXPRESSION_TYPE_CAST;
   } else {
@@ -664,6 +701,9 @@ std::string IndexTypeToString(IndexType type) {
     case INDEX_TYPE_HASH: {
       return "HASH";
     }
+    case INDEX_TYPE_ART: {
+      return "ART";
+    }
   }
   return "INVALID";
 }
@@ -677,6 +717,8 @@ IndexType StringToIndexType(const std::string& str) {
     return INDEX_TYPE_BWTREE;
   } else if (str == "HASH") {
     return INDEX_TYPE_HASH;
+  } else if (str == "ART") {
+    return INDEX_TYPE_ART;
   } else {
     throw ConversionException("No conversion from string '" + str + "'");
   }
@@ -753,6 +795,9 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
     case PLAN_NODE_TYPE_HASHJOIN: {
       return ("HASHJOIN");
     }
+    case PLAN_NODE_TYPE_ADAPTIVEJOIN: {
+      return ("ADAPTIVEJOIN");
+    }
     case PLAN_NODE_TYPE_UPDATE: {
       return ("UPDATE");
     }
@@ -777,6 +822,9 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
     case PLAN_NODE_TYPE_PRINT: {
       return ("PRINT");
     }
+    case PLAN_NODE_TYPE_EXCHANGE: {
+      return ("EXCHANGE");
+    }
     case PLAN_NODE_TYPE_AGGREGATE: {
       return ("AGGREGATE");
     }
@@ -843,6 +891,8 @@ PlanNodeType StringToPlanNodeType(const std::string& str) {
     return PLAN_NODE_TYPE_MERGEJOIN;
   } else if (str == "HASHJOIN") {
     return PLAN_NODE_TYPE_HASHJOIN;
+  } else if (str == "ADAPTIVEJOIN") {
+    return PLAN_NODE_TYPE_ADAPTIVEJOIN;
   } else if (str == "UPDATE") {
     return PLAN_NODE_TYPE_UPDATE;
   } else if (str == "INSERT") {
@@ -859,6 +909,8 @@ PlanNodeType StringToPlanNodeType(const std::string& str) {
     return PLAN_NODE_TYPE_RECEIVE;
   } else if (str == "PRINT") {
     return PLAN_NODE_TYPE_PRINT;
+  } else if (str == "EXCHANGE") {
+    return PLAN_NODE_TYPE_EXCHANGE;
   } else if (str == "AGGREGATE") {
     return PLAN_NODE_TYPE_AGGREGATE;
   } else if (str == "UNION") {
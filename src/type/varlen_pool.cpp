@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "type/varlen_pool.h"
+#include "type/slab_varlen_pool.h"
 
 namespace peloton {
 namespace type {
@@ -40,6 +41,18 @@ VarlenPool::VarlenPool(BackendType backend_type UNUSED_ATTRIBUTE) { Init(); };
 
 VarlenPool::VarlenPool() { Init(); };
 
+// Create a pool of the given type
+VarlenPool *VarlenPool::CreatePool(VarlenPoolType pool_type,
+                                   BackendType backend_type) {
+  switch (pool_type) {
+    case VARLEN_POOL_TYPE_SLAB:
+      return new SlabVarlenPool(backend_type);
+    case VARLEN_POOL_TYPE_BUFFER:
+    default:
+      return new VarlenPool(backend_type);
+  }
+}
+
 // Destroy this pool, and all memory it owns.
 VarlenPool::~VarlenPool() {
   for (size_t i = 0; i < MAX_LIST_NUM; i++) {
@@ -40,8 +40,12 @@ const char *VarlenType::GetData(const Value& val) const {
   return val.value_.varlen.data;
 }
 
-// Access the raw varlen data stored from the tuple storage
+// Access the raw varlen data stored from the tuple storage. Values kept in
+// the slot or in a dictionary have no pool block, so return nullptr for them.
 char *VarlenType::GetData(char *storage) {
+  if (IsSlotInlined(storage) || IsSlotDictionaryEncoded(storage)) {
+    return nullptr;
+  }
   char *ptr = *reinterpret_cast<char **>(storage);
   return ptr;
 }
@@ -163,6 +167,19 @@ void VarlenType::SerializeTo(const Value& val, SerializeOutput &out) const {
 
 void VarlenType::SerializeTo(const Value& val, char *storage, bool inlined UNUSED_ATTRIBUTE,
     VarlenPool *pool) const {
+  if (val.IsNull()) {
+    *reinterpret_cast<const char **>(storage) = nullptr;
+    return;
+  }
+
+  // Short values go straight into the slot : [tagged length | payload]
+  if (val.GetLength() <= SLOT_INLINED_MAX_LEN) {
+    *reinterpret_cast<uintptr_t *>(storage) = 0;
+    storage[0] = static_cast<char>((val.GetLength() << 2) | SLOT_INLINED_TAG);
+    PL_MEMCPY(storage + 1, val.value_.varlen.data, val.GetLength());
+    return;
+  }
+
   uint32_t size = val.GetLength() + sizeof(uint32_t);
   char *data = (pool == nullptr ) ? new char[size] : (char *) pool->Allocate(size);
   *reinterpret_cast<const char **>(storage) = data;
@@ -173,6 +190,15 @@ void VarlenType::SerializeTo(const Value& val, char *storage, bool inlined UNUSE
 // Deserialize a value of the given type from the given storage space.
 Value VarlenType::DeserializeFrom(const char *storage ,
                               const bool inlined UNUSED_ATTRIBUTE, VarlenPool *pool UNUSED_ATTRIBUTE) const{
+  if (IsSlotInlined(storage)) {
+    uint32_t len = static_cast<unsigned char>(storage[0]) >> 2;
+    return Value(type_id_, storage + 1, len);
+  }
+  auto entry = GetSlotDictionaryEntry(storage);
+  if (entry != nullptr) {
+    return Value(type_id_, entry->GetData(), entry->length);
+  }
+
   const char *ptr = *reinterpret_cast<const char * const *>(storage);
   if (ptr == nullptr)
   return Value(type_id_, nullptr, 0);
@@ -194,7 +220,8 @@ void VarlenType::DoShallowCopy(char *dest, char *src, bool inlined UNUSED_ATTRIB
 
   // Construct a shallow copy of a varlen value
   *reinterpret_cast<char **>(dest) = ptr;
-  if (ptr != nullptr) {
+  if (ptr != nullptr && IsSlotInlined(src) == false &&
+      IsSlotDictionaryEncoded(src) == false) {
     src_pool->AddRefCount(ptr);
   }
 }
@@ -214,6 +241,10 @@ Value VarlenType::CastAs(const Value& val, const Type::TypeId type_id) const {
     return ValueFactory::CastAsSmallInt(val);
   case Type::INTEGER:
     return ValueFactory::CastAsInteger(val);
+  case Type::BIGINT:
+    return ValueFactory::CastAsBigInt(val);
+  case Type::DECIMAL:
+    return ValueFactory::CastAsDecimal(val);
   case Type::TIMESTAMP:
     return ValueFactory::CastAsTimestamp(val);
   case Type::VARCHAR:
@@ -0,0 +1,284 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_compiler_test.cpp
+//
+// Identification: test/codegen/query_compiler_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "codegen/query_compiler.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/aggregate_executor.h"
+#include "executor/compiled_pipeline_executor.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/aggregate_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Query Compiler Tests
+//===--------------------------------------------------------------------===//
+
+class QueryCompilerTests : public PelotonTest {};
+
+static const int tuple_count = 50;
+
+/*
+ * BuildScan() - SELECT a, c FROM table WHERE a + b > 200 AND c < 400.0,
+ * true for the tuples 10 to 39
+ */
+static std::unique_ptr<planner::SeqScanPlan> BuildScan(
+    storage::DataTable *table) {
+  auto sum = expression::ExpressionUtil::OperatorFactory(
+      EXPRESSION_TYPE_OPERATOR_PLUS, type::Type::INTEGER,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0,
+                                                    1));
+  auto predicate = expression::ExpressionUtil::ConjunctionFactory(
+      EXPRESSION_TYPE_CONJUNCTION_AND,
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHAN, sum,
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetIntegerValue(200))),
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_LESSTHAN,
+          expression::ExpressionUtil::TupleValueFactory(type::Type::DECIMAL, 0,
+                                                        2),
+          expression::ExpressionUtil::ConstantValueFactory(
+              type::ValueFactory::GetDoubleValue(400))));
+
+  return std::unique_ptr<planner::SeqScanPlan>(
+      new planner::SeqScanPlan(table, predicate, {0, 1, 2}));
+}
+
+/*
+ * BuildAggregate() - SELECT SUM(a), COUNT(*), MAX(c), AVG(b) over the scan
+ */
+static std::unique_ptr<planner::AggregatePlan> BuildAggregate(
+    storage::DataTable *table, std::vector<oid_t> group_by_columns = {}) {
+  DirectMapList direct_map_list = {
+      {0, {1, 0}}, {1, {1, 1}}, {2, {1, 2}}, {3, {1, 3}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {EXPRESSION_TYPE_AGGREGATE_SUM,
+       expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0,
+                                                     0)},
+      {EXPRESSION_TYPE_AGGREGATE_COUNT_STAR, nullptr},
+      {EXPRESSION_TYPE_AGGREGATE_MAX,
+       expression::ExpressionUtil::TupleValueFactory(type::Type::DECIMAL, 0,
+                                                     2)},
+      {EXPRESSION_TYPE_AGGREGATE_AVG,
+       expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0,
+                                                     1)}};
+
+  std::unique_ptr<const expression::AbstractExpression> predicate(nullptr);
+
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(
+          {ExecutorTestsUtil::GetColumnInfo(0),
+           catalog::Column(type::Type::BIGINT,
+                           type::Type::GetTypeSize(type::Type::BIGINT),
+                           "count", true),
+           ExecutorTestsUtil::GetColumnInfo(2),
+           catalog::Column(type::Type::DECIMAL,
+                           type::Type::GetTypeSize(type::Type::DECIMAL),
+                           "avg", true)}));
+
+  auto aggregate_strategy =
+      group_by_columns.empty() ? AGGREGATE_TYPE_PLAIN : AGGREGATE_TYPE_HASH;
+  std::unique_ptr<planner::AggregatePlan> plan(new planner::AggregatePlan(
+      std::move(proj_info), std::move(predicate), std::move(agg_terms),
+      std::move(group_by_columns), output_table_schema, aggregate_strategy));
+  plan->AddChild(BuildScan(table));
+  return plan;
+}
+
+TEST_F(QueryCompilerTests, ScanTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(ExecutorTestsUtil::CreateTable());
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto scan = BuildScan(table.get());
+  auto &query_compiler = codegen::QueryCompiler::GetInstance();
+  auto pipeline = query_compiler.Compile(scan.get());
+
+#ifdef PELOTON_USE_LLVM
+  ASSERT_TRUE(pipeline != nullptr);
+  EXPECT_FALSE(pipeline->IsAggregation());
+
+  // Another instance of the same query is not compiled again
+  auto other_scan = BuildScan(table.get());
+  EXPECT_EQ(pipeline, query_compiler.Compile(other_scan.get()));
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::CompiledPipelineExecutor executor(scan.get(), context.get(),
+                                              pipeline);
+  EXPECT_TRUE(executor.Init());
+
+  std::set<int> result;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_EQ(3, result_tile->GetColumnCount());
+    for (oid_t tuple_id : *result_tile) {
+      result.insert(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(30, result.size());
+  for (int tuple_itr = 10; tuple_itr < 40; tuple_itr++) {
+    EXPECT_EQ(1, result.count(ExecutorTestsUtil::PopulatedValue(tuple_itr, 0)));
+  }
+#else
+  EXPECT_TRUE(pipeline == nullptr);
+#endif
+}
+
+TEST_F(QueryCompilerTests, CacheTest) {
+  std::unique_ptr<storage::DataTable> table(ExecutorTestsUtil::CreateTable());
+  auto &query_compiler = codegen::QueryCompiler::GetInstance();
+  query_compiler.ClearCache();
+
+  // SELECT a FROM table WHERE a > constant, one pipeline per constant
+  auto build_scan = [&table](int constant) {
+    auto predicate = expression::ExpressionUtil::ComparisonFactory(
+        EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+        expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0,
+                                                      0),
+        expression::ExpressionUtil::ConstantValueFactory(
+            type::ValueFactory::GetIntegerValue(constant)));
+    return std::unique_ptr<planner::SeqScanPlan>(
+        new planner::SeqScanPlan(table.get(), predicate, {0}));
+  };
+
+  std::vector<std::shared_ptr<const codegen::CompiledPipeline>> pipelines;
+  for (int constant = 0; constant <= DEFAULT_CACHE_SIZE; constant++) {
+    auto scan = build_scan(constant);
+    pipelines.push_back(query_compiler.Compile(scan.get()));
+  }
+
+#ifdef PELOTON_USE_LLVM
+  // The least recently used pipeline is gone
+  EXPECT_EQ(DEFAULT_CACHE_SIZE, query_compiler.GetCacheSize());
+  auto last_scan = build_scan(DEFAULT_CACHE_SIZE);
+  EXPECT_EQ(pipelines.back(), query_compiler.Compile(last_scan.get()));
+  auto first_scan = build_scan(0);
+  auto first_pipeline = query_compiler.Compile(first_scan.get());
+  ASSERT_TRUE(first_pipeline != nullptr);
+  EXPECT_NE(pipelines.front(), first_pipeline);
+  EXPECT_EQ(DEFAULT_CACHE_SIZE, query_compiler.GetCacheSize());
+#else
+  EXPECT_EQ(0, query_compiler.GetCacheSize());
+#endif
+
+  query_compiler.ClearCache();
+}
+
+TEST_F(QueryCompilerTests, AggregateTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(ExecutorTestsUtil::CreateTable());
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto aggregate = BuildAggregate(table.get());
+  auto pipeline = codegen::QueryCompiler::GetInstance().Compile(aggregate.get());
+
+#ifdef PELOTON_USE_LLVM
+  ASSERT_TRUE(pipeline != nullptr);
+  EXPECT_TRUE(pipeline->IsAggregation());
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // The interpreted executors go below, in case the compiled code gives up
+  auto scan = aggregate->GetChildren()[0].get();
+  executor::CompiledPipelineExecutor executor(aggregate.get(), context.get(),
+                                              pipeline);
+  executor::AggregateExecutor aggregate_executor(aggregate.get(),
+                                                 context.get());
+  executor::SeqScanExecutor scan_executor(scan, context.get());
+  executor.AddChild(&aggregate_executor);
+  aggregate_executor.AddChild(&scan_executor);
+
+  EXPECT_TRUE(executor.Init());
+  EXPECT_TRUE(executor.Execute());
+  std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+  EXPECT_FALSE(executor.Execute());
+  txn_manager.CommitTransaction(txn);
+
+  // Tuples 10 to 39 match
+  ASSERT_TRUE(result_tile != nullptr);
+  EXPECT_EQ(1, result_tile->GetTupleCount());
+  EXPECT_TRUE(result_tile->GetValue(0, 0)
+                  .CompareEquals(type::ValueFactory::GetIntegerValue(7350))
+                  .IsTrue());
+  EXPECT_TRUE(result_tile->GetValue(0, 1)
+                  .CompareEquals(type::ValueFactory::GetBigIntValue(30))
+                  .IsTrue());
+  EXPECT_TRUE(result_tile->GetValue(0, 2)
+                  .CompareEquals(type::ValueFactory::GetDoubleValue(392))
+                  .IsTrue());
+  EXPECT_TRUE(result_tile->GetValue(0, 3)
+                  .CompareEquals(type::ValueFactory::GetDoubleValue(246))
+                  .IsTrue());
+#else
+  EXPECT_TRUE(pipeline == nullptr);
+#endif
+}
+
+TEST_F(QueryCompilerTests, UnsupportedPlanTest) {
+  std::unique_ptr<storage::DataTable> table(ExecutorTestsUtil::CreateTable());
+  auto &query_compiler = codegen::QueryCompiler::GetInstance();
+
+  // Strings are left to the interpreter
+  planner::SeqScanPlan varchar_scan(
+      table.get(), expression::ExpressionUtil::ComparisonFactory(
+                       EXPRESSION_TYPE_COMPARE_EQUAL,
+                       expression::ExpressionUtil::TupleValueFactory(
+                           type::Type::VARCHAR, 0, 3),
+                       expression::ExpressionUtil::ConstantValueFactory(
+                           type::ValueFactory::GetVarcharValue("3"))),
+      {0, 3});
+  EXPECT_TRUE(query_compiler.Compile(&varchar_scan) == nullptr);
+
+  // So are scans without a predicate, and grouped aggregations
+  planner::SeqScanPlan full_scan(table.get(), nullptr, {0, 1});
+  EXPECT_TRUE(query_compiler.Compile(&full_scan) == nullptr);
+
+  auto grouped_aggregate = BuildAggregate(table.get(), {1});
+  EXPECT_TRUE(query_compiler.Compile(grouped_aggregate.get()) == nullptr);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,176 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// slab_varlen_pool_test.cpp
+//
+// Identification: test/common/slab_varlen_pool_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "common/harness.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "type/slab_varlen_pool.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Slab Varlen Pool Tests
+//===--------------------------------------------------------------------===//
+
+class SlabVarlenPoolTests : public PelotonTest {};
+
+// Block size handed out for a request of the given size
+static size_t GetSlabBlockSize(size_t size) {
+  auto block_size = size + type::VarlenPool::GetRefCountSize();
+  return type::SlabVarlenPool::GetBlockSize(
+      type::SlabVarlenPool::GetSizeClass(block_size));
+}
+
+TEST_F(SlabVarlenPoolTests, AllocateFreeTest) {
+  std::unique_ptr<type::VarlenPool> pool(type::VarlenPool::CreatePool(
+      VARLEN_POOL_TYPE_SLAB, peloton::BACKEND_TYPE_MM));
+
+  std::vector<size_t> sizes = {1, 8, 40, 1000, 60000, 100000};
+  std::vector<char *> ptrs;
+  size_t total_size = 0;
+
+  for (auto size : sizes) {
+    char *ptr = reinterpret_cast<char *>(pool->Allocate(size));
+    EXPECT_TRUE(ptr != nullptr);
+    memset(ptr, 'a' + (size % 26), size);
+    ptrs.push_back(ptr);
+
+    if (size + type::VarlenPool::GetRefCountSize() <=
+        type::SlabVarlenPool::SLAB_MAX_BLOCK_SIZE) {
+      total_size += GetSlabBlockSize(size);
+      EXPECT_EQ(total_size, pool->GetTotalAllocatedSpace());
+    }
+    EXPECT_EQ(1, pool->GetRefCount(ptr));
+  }
+
+  // Shared values stay around until the last reference is gone
+  pool->AddRefCount(ptrs[2]);
+  EXPECT_EQ(2, pool->GetRefCount(ptrs[2]));
+  pool->Free(ptrs[2]);
+  EXPECT_EQ(1, pool->GetRefCount(ptrs[2]));
+
+  for (size_t ptr_itr = 0; ptr_itr < ptrs.size(); ptr_itr++) {
+    for (size_t byte_itr = 0; byte_itr < sizes[ptr_itr]; byte_itr++) {
+      EXPECT_EQ('a' + (sizes[ptr_itr] % 26), ptrs[ptr_itr][byte_itr]);
+    }
+    pool->Free(ptrs[ptr_itr]);
+  }
+
+  EXPECT_EQ(0, pool->GetTotalAllocatedSpace());
+}
+
+TEST_F(SlabVarlenPoolTests, DeferredFreeTest) {
+  type::SlabVarlenPool pool(peloton::BACKEND_TYPE_MM);
+  EXPECT_TRUE(pool.IsDeferredFree());
+
+  // The epoch does not move here, so a freed block must not come back
+  void *ptr = pool.Allocate(40);
+  pool.Free(ptr);
+  EXPECT_EQ(1, pool.GetRetiredCount());
+  EXPECT_EQ(0, pool.GetTotalAllocatedSpace());
+
+  void *other_ptr = pool.Allocate(40);
+  EXPECT_NE(ptr, other_ptr);
+  pool.Free(other_ptr);
+  EXPECT_EQ(2, pool.GetRetiredCount());
+
+  // Without deferral the block is reused right away
+  pool.SetDeferredFree(false);
+  ptr = pool.Allocate(40);
+  pool.Free(ptr);
+  EXPECT_EQ(ptr, pool.Allocate(40));
+  EXPECT_EQ(2, pool.GetRetiredCount());
+  pool.Free(ptr);
+}
+
+TEST_F(SlabVarlenPoolTests, RetiredBlockContentTest) {
+  type::SlabVarlenPool pool(peloton::BACKEND_TYPE_MM);
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+
+  // A reader of an older version holds the epoch the value is freed in
+  auto epoch = epoch_manager.EnterEpoch(0);
+
+  const size_t size = 40;
+  char *ptr = reinterpret_cast<char *>(pool.Allocate(size));
+  for (size_t byte_itr = 0; byte_itr < size; byte_itr++) {
+    ptr[byte_itr] = static_cast<char>(byte_itr + 1);
+  }
+  pool.Free(ptr);
+
+  // Allocations of the same size class look for blocks to reclaim
+  std::vector<void *> other_ptrs;
+  for (size_t ptr_itr = 0; ptr_itr < 8; ptr_itr++) {
+    other_ptrs.push_back(pool.Allocate(size));
+    EXPECT_NE(ptr, other_ptrs.back());
+  }
+
+  // The reader still sees the whole value, length included
+  for (size_t byte_itr = 0; byte_itr < size; byte_itr++) {
+    EXPECT_EQ(static_cast<char>(byte_itr + 1), ptr[byte_itr]);
+  }
+  EXPECT_EQ(1, pool.GetRetiredCount());
+
+  epoch_manager.ExitEpoch(epoch);
+  for (auto other_ptr : other_ptrs) {
+    pool.Free(other_ptr);
+  }
+}
+
+TEST_F(SlabVarlenPoolTests, MultithreadTest) {
+  type::SlabVarlenPool pool(peloton::BACKEND_TYPE_MM);
+  pool.SetDeferredFree(false);
+
+  const size_t thread_count = 4;
+  const size_t round_count = 1000;
+  const size_t ptr_count = 32;
+
+  auto worker = [&](size_t thread_id) {
+    std::vector<char *> ptrs(ptr_count, nullptr);
+    for (size_t round_itr = 0; round_itr < round_count; round_itr++) {
+      auto ptr_itr = round_itr % ptr_count;
+      size_t size = (round_itr * 37 + thread_id) % 300 + 1;
+
+      if (ptrs[ptr_itr] != nullptr) {
+        // Nobody else may have touched our block
+        EXPECT_EQ(static_cast<char>(thread_id), ptrs[ptr_itr][0]);
+        pool.Free(ptrs[ptr_itr]);
+      }
+
+      ptrs[ptr_itr] = reinterpret_cast<char *>(pool.Allocate(size));
+      EXPECT_TRUE(ptrs[ptr_itr] != nullptr);
+      memset(ptrs[ptr_itr], static_cast<char>(thread_id), size);
+    }
+
+    for (auto ptr : ptrs) {
+      pool.Free(ptr);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    threads.push_back(std::thread(worker, thread_itr));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // All the pointers have been freed
+  EXPECT_EQ(0, pool.GetTotalAllocatedSpace());
+  EXPECT_EQ(0, pool.GetRetiredCount());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,192 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// task_scheduler_test.cpp
+//
+// Identification: test/common/task_scheduler_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <thread>
+
+#include "common/task_scheduler.h"
+#include "common/harness.h"
+#include "container/work_stealing_deque.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Task Scheduler Test
+//===--------------------------------------------------------------------===//
+
+class TaskSchedulerTests : public PelotonTest {};
+
+TEST_F(TaskSchedulerTests, BasicTest) {
+  TaskScheduler task_scheduler(4);
+  EXPECT_EQ(4, task_scheduler.GetWorkerCount());
+
+  const int task_count = 1000;
+  std::vector<int> results(task_count, 0);
+
+  TaskGroup task_group;
+  for (int task_itr = 0; task_itr < task_count; task_itr++) {
+    task_scheduler.Submit(task_group, [&results, task_itr] {
+      results[task_itr] = task_itr * task_itr;
+    });
+  }
+  task_scheduler.Wait(task_group);
+
+  EXPECT_TRUE(task_group.IsDone());
+  for (int task_itr = 0; task_itr < task_count; task_itr++) {
+    EXPECT_EQ(task_itr * task_itr, results[task_itr]);
+  }
+}
+
+TEST_F(TaskSchedulerTests, NestedTest) {
+  // Tasks that wait for tasks of their own must not starve a small pool
+  TaskScheduler task_scheduler(2);
+
+  const int outer_task_count = 8;
+  const int inner_task_count = 100;
+  std::atomic<int> counter(0);
+
+  TaskGroup task_group;
+  for (int task_itr = 0; task_itr < outer_task_count; task_itr++) {
+    task_scheduler.Submit(task_group, [&task_scheduler, &counter] {
+      TaskGroup inner_task_group;
+      for (int inner_itr = 0; inner_itr < inner_task_count; inner_itr++) {
+        task_scheduler.Submit(inner_task_group, [&counter] { counter++; });
+      }
+      task_scheduler.Wait(inner_task_group);
+    });
+  }
+  task_scheduler.Wait(task_group);
+
+  EXPECT_EQ(outer_task_count * inner_task_count, counter.load());
+}
+
+TEST_F(TaskSchedulerTests, CancelTest) {
+  TaskScheduler task_scheduler(2);
+
+  // Both workers block until the group is cancelled, so the remaining tasks
+  // are still queued by then
+  const int task_count = 100;
+  std::atomic<int> started_count(0);
+  std::atomic<bool> cancelled(false);
+
+  TaskGroup task_group;
+  for (int task_itr = 0; task_itr < task_count; task_itr++) {
+    task_scheduler.Submit(task_group, [&started_count, &cancelled] {
+      started_count++;
+      while (cancelled == false) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  while (started_count < 2) {
+    std::this_thread::yield();
+  }
+  task_group.Cancel();
+  cancelled = true;
+  task_scheduler.Wait(task_group);
+
+  EXPECT_TRUE(task_group.IsCancelled());
+  EXPECT_EQ(2, started_count.load());
+
+  uint64_t executed_count = 0;
+  uint64_t skipped_count = 0;
+  for (size_t worker_id = 0; worker_id < task_scheduler.GetWorkerCount();
+       worker_id++) {
+    auto stats = task_scheduler.GetWorkerStats(worker_id);
+    executed_count += stats.executed_task_count;
+    skipped_count += stats.cancelled_task_count;
+  }
+  // The waiting thread may have skipped some of the tasks itself
+  EXPECT_EQ(2, executed_count);
+  EXPECT_GE(task_count - 2, skipped_count);
+}
+
+TEST_F(TaskSchedulerTests, StealTest) {
+  TaskScheduler task_scheduler(4);
+
+  // A single task spawns all the others on its own deque, the idle workers
+  // have to steal them
+  const int task_count = 1000;
+  std::atomic<int> counter(0);
+
+  TaskGroup task_group;
+  task_scheduler.Submit(task_group, [&task_scheduler, &counter] {
+    TaskGroup inner_task_group;
+    for (int task_itr = 0; task_itr < task_count; task_itr++) {
+      task_scheduler.Submit(inner_task_group, [&counter] {
+        counter++;
+        std::this_thread::sleep_for(std::chrono::microseconds(10));
+      });
+    }
+    task_scheduler.Wait(inner_task_group);
+  });
+  task_scheduler.Wait(task_group);
+
+  EXPECT_EQ(task_count, counter.load());
+
+  uint64_t executed_count = 0;
+  for (size_t worker_id = 0; worker_id < task_scheduler.GetWorkerCount();
+       worker_id++) {
+    auto stats = task_scheduler.GetWorkerStats(worker_id);
+    EXPECT_EQ(0, stats.cancelled_task_count);
+    executed_count += stats.executed_task_count;
+  }
+  // The test thread may have run some of them while it waited
+  EXPECT_GE(task_count + 1, executed_count);
+}
+
+TEST_F(TaskSchedulerTests, WorkStealingDequeTest) {
+  // Starts small, to make it grow
+  WorkStealingDeque<int *> deque(4);
+  std::vector<int> values(100, 0);
+
+  for (auto &value : values) {
+    deque.Push(&value);
+  }
+  EXPECT_EQ(values.size(), deque.GetSize());
+
+  // The owner pops from the bottom, thieves steal from the top
+  int *item = nullptr;
+  EXPECT_TRUE(deque.Pop(item));
+  EXPECT_EQ(&values.back(), item);
+  EXPECT_TRUE(deque.Steal(item));
+  EXPECT_EQ(&values.front(), item);
+
+  // Thieves race the owner for the rest
+  const int thief_count = 3;
+  std::vector<std::thread> thieves;
+  for (int thief_itr = 0; thief_itr < thief_count; thief_itr++) {
+    thieves.push_back(std::thread([&deque] {
+      int *stolen_item = nullptr;
+      while (deque.IsEmpty() == false) {
+        if (deque.Steal(stolen_item)) {
+          (*stolen_item)++;
+        }
+      }
+    }));
+  }
+  while (deque.Pop(item)) {
+    (*item)++;
+  }
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+
+  // Every other item was taken exactly once
+  EXPECT_TRUE(deque.IsEmpty());
+  for (size_t value_itr = 1; value_itr + 1 < values.size(); value_itr++) {
+    EXPECT_EQ(1, values[value_itr]);
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
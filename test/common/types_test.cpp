@@ -49,7 +49,8 @@ TEST_F(TypesTests, TypeIdTest) {
 
 TEST_F(TypesTests, IndexTypeTest) {
   std::vector<IndexType> list = {INDEX_TYPE_INVALID, INDEX_TYPE_BTREE,
-                                 INDEX_TYPE_BWTREE, INDEX_TYPE_HASH};
+                                 INDEX_TYPE_BWTREE, INDEX_TYPE_HASH,
+                                 INDEX_TYPE_ART};
 
   // Make sure that ToString and FromString work
   for (auto val : list) {
@@ -95,10 +96,12 @@ TEST_F(TypesTests, PlanNodeTypeTest) {
       PLAN_NODE_TYPE_SEQSCAN,     PLAN_NODE_TYPE_INDEXSCAN,
       PLAN_NODE_TYPE_NESTLOOP,    PLAN_NODE_TYPE_NESTLOOPINDEX,
       PLAN_NODE_TYPE_MERGEJOIN,   PLAN_NODE_TYPE_HASHJOIN,
+      PLAN_NODE_TYPE_ADAPTIVEJOIN,
       PLAN_NODE_TYPE_UPDATE,      PLAN_NODE_TYPE_INSERT,
       PLAN_NODE_TYPE_DELETE,      PLAN_NODE_TYPE_DROP,
       PLAN_NODE_TYPE_CREATE,      PLAN_NODE_TYPE_SEND,
       PLAN_NODE_TYPE_RECEIVE,     PLAN_NODE_TYPE_PRINT,
+      PLAN_NODE_TYPE_EXCHANGE,
       PLAN_NODE_TYPE_AGGREGATE,   PLAN_NODE_TYPE_UNION,
       PLAN_NODE_TYPE_ORDERBY,     PLAN_NODE_TYPE_PROJECTION,
       PLAN_NODE_TYPE_MATERIALIZE, PLAN_NODE_TYPE_LIMIT,
@@ -0,0 +1,226 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// adaptive_join_test.cpp
+//
+// Identification: test/executor/adaptive_join_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/adaptive_join_executor.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "planner/adaptive_join_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Adaptive Join Tests
+//===--------------------------------------------------------------------===//
+
+class AdaptiveJoinTests : public PelotonTest {};
+
+// Same as the populated tables, except that the third column (DECIMAL) holds
+// the value of the first column for even tuples, and half past it for odd
+// ones
+static storage::DataTable *CreateDecimalKeyTable(int tuple_count) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto table = ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP);
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  for (int rowid = 0; rowid < tuple_count; rowid++) {
+    double key = ExecutorTestsUtil::PopulatedValue(rowid, 0);
+    if (rowid % 2 == 1) {
+      key += 0.5;
+    }
+
+    storage::Tuple tuple(table->GetSchema(), true);
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(
+                          ExecutorTestsUtil::PopulatedValue(rowid, 0)),
+                   testing_pool);
+    tuple.SetValue(1, type::ValueFactory::GetIntegerValue(
+                          ExecutorTestsUtil::PopulatedValue(rowid, 1)),
+                   testing_pool);
+    tuple.SetValue(2, type::ValueFactory::GetDoubleValue(key), testing_pool);
+    tuple.SetValue(3, type::ValueFactory::GetVarcharValue(std::to_string(
+                          ExecutorTestsUtil::PopulatedValue(rowid, 3))),
+                   testing_pool);
+
+    ItemPointer *index_entry_ptr = nullptr;
+    auto location = table->InsertTuple(&tuple, txn, &index_entry_ptr);
+    txn_manager.PerformInsert(txn, location, index_entry_ptr);
+  }
+  txn_manager.CommitTransaction(txn);
+  return table;
+}
+
+// Joins the first column of the left table with the given column of the
+// right table and returns the number of result tuples, the strategy the join
+// picked and its partition count
+static int ExecuteAdaptiveJoin(storage::DataTable *left_table,
+                               storage::DataTable *right_table,
+                               PelotonJoinType join_type,
+                               size_t in_memory_row_limit,
+                               JoinStrategyType &join_strategy,
+                               size_t &partition_count,
+                               oid_t right_key_column_id = 0) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  planner::SeqScanPlan left_scan_node(left_table, nullptr, {0, 1});
+  // A sequential scan ignores the key it is passed, it is looked up with a
+  // scan of the whole table
+  planner::SeqScanPlan right_lookup_node(right_table, nullptr,
+                                         {right_key_column_id, 1});
+  planner::SeqScanPlan right_scan_node(right_table, nullptr,
+                                       {right_key_column_id, 1});
+
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> projection(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(
+      {ExecutorTestsUtil::GetColumnInfo(0),
+       ExecutorTestsUtil::GetColumnInfo(0)}));
+  planner::AdaptiveJoinPlan adaptive_join_node(
+      join_type, nullptr, std::move(projection), schema, {0}, {0}, {0},
+      planner::AdaptiveJoinPlan::default_nested_loop_row_limit,
+      in_memory_row_limit);
+
+  executor::SeqScanExecutor left_scan_executor(&left_scan_node, context.get());
+  executor::SeqScanExecutor right_lookup_executor(&right_lookup_node,
+                                                  context.get());
+  executor::SeqScanExecutor right_scan_executor(&right_scan_node,
+                                                context.get());
+  executor::AdaptiveJoinExecutor adaptive_join_executor(&adaptive_join_node,
+                                                        context.get());
+  adaptive_join_executor.AddChild(&left_scan_executor);
+  adaptive_join_executor.AddChild(&right_lookup_executor);
+  adaptive_join_executor.AddChild(&right_scan_executor);
+
+  int result_tuple_count = 0;
+  EXPECT_TRUE(adaptive_join_executor.Init());
+  while (adaptive_join_executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(
+        adaptive_join_executor.GetOutput());
+    if (result_tile == nullptr) {
+      continue;
+    }
+    for (oid_t tuple_id : *result_tile) {
+      auto right_value = result_tile->GetValue(tuple_id, 1);
+      if (right_value.IsNull() == false) {
+        EXPECT_TRUE(result_tile->GetValue(tuple_id, 0)
+                        .CompareEquals(right_value)
+                        .IsTrue());
+      }
+      result_tuple_count++;
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  join_strategy = adaptive_join_executor.GetJoinStrategy();
+  partition_count = adaptive_join_executor.GetPartitionCount();
+  return result_tuple_count;
+}
+
+TEST_F(AdaptiveJoinTests, NestedLoopTest) {
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(10));
+  std::unique_ptr<storage::DataTable> right_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(50));
+
+  JoinStrategyType join_strategy;
+  size_t partition_count;
+  EXPECT_EQ(10, ExecuteAdaptiveJoin(
+                    left_table.get(), right_table.get(), JOIN_TYPE_INNER,
+                    planner::AdaptiveJoinPlan::default_in_memory_row_limit,
+                    join_strategy, partition_count));
+  EXPECT_EQ(JOIN_STRATEGY_TYPE_NESTED_LOOP, join_strategy);
+  EXPECT_EQ(1, partition_count);
+}
+
+TEST_F(AdaptiveJoinTests, HashTest) {
+  // Only the first fifty tuples of the left table find a match
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(200));
+  std::unique_ptr<storage::DataTable> right_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(50));
+
+  JoinStrategyType join_strategy;
+  size_t partition_count;
+  EXPECT_EQ(50, ExecuteAdaptiveJoin(
+                    left_table.get(), right_table.get(), JOIN_TYPE_INNER,
+                    planner::AdaptiveJoinPlan::default_in_memory_row_limit,
+                    join_strategy, partition_count));
+  EXPECT_EQ(JOIN_STRATEGY_TYPE_HASH, join_strategy);
+  EXPECT_EQ(1, partition_count);
+
+  // The left rows without a match come last
+  EXPECT_EQ(200, ExecuteAdaptiveJoin(
+                     left_table.get(), right_table.get(), JOIN_TYPE_LEFT,
+                     planner::AdaptiveJoinPlan::default_in_memory_row_limit,
+                     join_strategy, partition_count));
+  EXPECT_EQ(JOIN_STRATEGY_TYPE_HASH, join_strategy);
+}
+
+TEST_F(AdaptiveJoinTests, GraceHashTest) {
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(200));
+  std::unique_ptr<storage::DataTable> right_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(50));
+
+  // At most 64 left rows fit in memory
+  JoinStrategyType join_strategy;
+  size_t partition_count;
+  EXPECT_EQ(50, ExecuteAdaptiveJoin(left_table.get(), right_table.get(),
+                                    JOIN_TYPE_INNER, 64, join_strategy,
+                                    partition_count));
+  EXPECT_EQ(JOIN_STRATEGY_TYPE_GRACE_HASH, join_strategy);
+  EXPECT_EQ(4, partition_count);
+
+  EXPECT_EQ(200, ExecuteAdaptiveJoin(left_table.get(), right_table.get(),
+                                     JOIN_TYPE_LEFT, 64, join_strategy,
+                                     partition_count));
+}
+
+TEST_F(AdaptiveJoinTests, MixedTypeKeyTest) {
+  // INTEGER keys on the left, DECIMAL keys on the right, only the integral
+  // ones of the fifty find a match
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(200));
+  std::unique_ptr<storage::DataTable> right_table(CreateDecimalKeyTable(50));
+
+  JoinStrategyType join_strategy;
+  size_t partition_count;
+  EXPECT_EQ(25, ExecuteAdaptiveJoin(
+                    left_table.get(), right_table.get(), JOIN_TYPE_INNER,
+                    planner::AdaptiveJoinPlan::default_in_memory_row_limit,
+                    join_strategy, partition_count, 2));
+  EXPECT_EQ(JOIN_STRATEGY_TYPE_HASH, join_strategy);
+
+  EXPECT_EQ(25, ExecuteAdaptiveJoin(left_table.get(), right_table.get(),
+                                    JOIN_TYPE_INNER, 64, join_strategy,
+                                    partition_count, 2));
+  EXPECT_EQ(JOIN_STRATEGY_TYPE_GRACE_HASH, join_strategy);
+}
+
+}  // namespace test
+}  // namespace peloton
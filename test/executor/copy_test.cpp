@@ -133,5 +133,78 @@ TEST_F(CopyTests, Copying) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(CopyTests, CopyFrom) {
+  auto catalog = catalog::Catalog::GetInstance();
+  catalog->CreateDatabase("emp_db", nullptr);
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  optimizer::SimpleOptimizer optimizer;
+
+  // Create a table with primary key
+  StatsTestsUtil::CreateTable(true);
+
+  // Write the input file, with an escaped delimiter and no final new line
+  int num_tuples = 100;
+  std::string file_path = "./copy_input.csv";
+  FILE* file = fopen(file_path.c_str(), "w");
+  ASSERT_TRUE(file != nullptr);
+  for (int i = 0; i < num_tuples; i++) {
+    fprintf(file, "%d,dept\\,%d%s", i, i, i == num_tuples - 1 ? "" : "\n");
+  }
+  fclose(file);
+
+  std::string copy_sql =
+      "COPY emp_db.department_table FROM '" + file_path + "' DELIMITER ',';";
+  auto txn = txn_manager.BeginTransaction();
+  LOG_INFO("Query: %s", copy_sql.c_str());
+
+  auto& peloton_parser = parser::Parser::GetInstance();
+  auto copy_stmt = peloton_parser.BuildParseTree(copy_sql);
+  auto copy_plan = optimizer.BuildPelotonPlanTree(copy_stmt);
+  EXPECT_EQ(0, copy_plan->GetChildren().size());
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  std::unique_ptr<executor::AbstractExecutor> copy_executor(
+      new executor::CopyExecutor(copy_plan.get(), context.get()));
+
+  EXPECT_TRUE(copy_executor->Init());
+  EXPECT_TRUE(copy_executor->Execute());
+  EXPECT_FALSE(copy_executor->Execute());
+  EXPECT_EQ(num_tuples, context->num_processed);
+  txn_manager.CommitTransaction(txn);
+
+  // Check the loaded values
+  auto table =
+      catalog->GetTableWithName("emp_db", "department_table");
+  EXPECT_EQ(num_tuples, table->GetTupleCount());
+  auto tile_group = table->GetTileGroup(1);
+  EXPECT_EQ(0, tile_group->GetValue(0, 0).GetAs<int32_t>());
+  EXPECT_EQ("dept,0", tile_group->GetValue(0, 1).ToString());
+
+  // Loading the same keys again violates the primary key
+  txn = txn_manager.BeginTransaction();
+  context.reset(new executor::ExecutorContext(txn));
+  copy_executor.reset(
+      new executor::CopyExecutor(copy_plan.get(), context.get()));
+  EXPECT_TRUE(copy_executor->Init());
+  EXPECT_FALSE(copy_executor->Execute());
+  EXPECT_EQ(RESULT_FAILURE, txn->GetResult());
+  txn_manager.AbortTransaction(txn);
+  EXPECT_EQ(num_tuples, table->GetTupleCount());
+
+  // A table that does not exist is reported instead of planned
+  auto missing_stmt = peloton_parser.BuildParseTree(
+      "COPY emp_db.missing_table FROM '" + file_path + "' DELIMITER ',';");
+  EXPECT_THROW(optimizer.BuildPelotonPlanTree(missing_stmt), CatalogException);
+
+  remove(file_path.c_str());
+
+  // free the database just created
+  txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithName("emp_db", txn);
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -152,6 +152,13 @@ TEST_F(CreateIndexTests, CreatingIndex) {
   // Expected 2 , Primary key index + created index
   EXPECT_EQ(target_table_->GetIndexCount(), 2);
 
+  // The tuple inserted before is in the new index
+  auto created_index = target_table_->GetIndex(1);
+  EXPECT_TRUE(created_index->IsReady());
+  std::vector<ItemPointer *> index_entries;
+  created_index->ScanAllKeys(index_entries);
+  EXPECT_EQ(1, index_entries.size());
+
   // free the database just created
   txn = txn_manager.BeginTransaction();
   catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
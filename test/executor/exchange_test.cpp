@@ -0,0 +1,295 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// exchange_test.cpp
+//
+// Identification: test/executor/exchange_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <set>
+#include <thread>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "common/task_scheduler.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/exchange_executor.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "planner/aggregate_plan.h"
+#include "planner/exchange_plan.h"
+#include "planner/limit_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Exchange Tests
+//===--------------------------------------------------------------------===//
+
+class ExchangeTests : public PelotonTest {};
+
+static const int tuples_per_tile_group = 10;
+
+TEST_F(ExchangeTests, RangePartitionTest) {
+  // SELECT a, b FROM table, over 10 tile groups in 4 partitions
+  const int tuple_count = 95;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(tuple_count,
+                                                tuples_per_tile_group, false,
+                                                false));
+
+  planner::ExchangePlan exchange_node(PARTITION_TYPE_TILE_GROUP_RANGE, 4);
+  exchange_node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0, 1})));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::ExchangeExecutor executor(&exchange_node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::multiset<int> result;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_EQ(2, result_tile->GetColumnCount());
+    for (oid_t tuple_id : *result_tile) {
+      result.insert(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  // Every tuple shows up once
+  EXPECT_EQ(tuple_count, result.size());
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_EQ(1, result.count(ExecutorTestsUtil::PopulatedValue(tuple_itr, 0)));
+  }
+}
+
+TEST_F(ExchangeTests, HashPartitionAggregateTest) {
+  // SELECT a, COUNT(*) FROM table GROUP BY a, in 3 hash partitions of a
+  const int tuple_count = 100;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(tuple_count,
+                                                tuples_per_tile_group, false,
+                                                true));
+
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {EXPRESSION_TYPE_AGGREGATE_COUNT_STAR, nullptr}};
+
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema(
+          {ExecutorTestsUtil::GetColumnInfo(0),
+           catalog::Column(type::Type::BIGINT,
+                           type::Type::GetTypeSize(type::Type::BIGINT),
+                           "count", true)}));
+
+  std::unique_ptr<planner::AggregatePlan> aggregate_node(
+      new planner::AggregatePlan(std::move(proj_info), nullptr,
+                                 std::move(agg_terms), {0},
+                                 output_table_schema, AGGREGATE_TYPE_HASH));
+  aggregate_node->AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0, 1})));
+
+  planner::ExchangePlan exchange_node(PARTITION_TYPE_HASH, 3, {0});
+  exchange_node.AddChild(std::move(aggregate_node));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::ExchangeExecutor executor(&exchange_node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::map<int, int64_t> result;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      int group = result_tile->GetValue(tuple_id, 0).GetAs<int32_t>();
+      // Every group is aggregated by one partition only
+      EXPECT_EQ(0, result.count(group));
+      result[group] = result_tile->GetValue(tuple_id, 1).GetAs<int64_t>();
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  // The first column has two distinct values, half of the tuples each
+  EXPECT_EQ(2, result.size());
+  EXPECT_EQ(tuple_count / 2, result[ExecutorTestsUtil::PopulatedValue(0, 0)]);
+  EXPECT_EQ(tuple_count / 2, result[ExecutorTestsUtil::PopulatedValue(1, 0)]);
+}
+
+TEST_F(ExchangeTests, GrowingTableTest) {
+  // SELECT a FROM table, over 10 tile groups in 4 partitions, while another
+  // transaction adds 10 more tile groups
+  const int tuple_count = 95;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(tuple_count,
+                                                tuples_per_tile_group, false,
+                                                false));
+
+  planner::ExchangePlan exchange_node(PARTITION_TYPE_TILE_GROUP_RANGE, 4);
+  exchange_node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0})));
+
+  // Keep every worker busy, so that the instances only run one after the
+  // other on this thread while it waits for output
+  auto &task_scheduler = TaskScheduler::GetInstance();
+  TaskGroup busy_workers;
+  std::atomic<size_t> busy_worker_count(0);
+  std::atomic<bool> release_workers(false);
+  for (size_t worker_itr = 0; worker_itr < task_scheduler.GetWorkerCount();
+       worker_itr++) {
+    task_scheduler.Submit(busy_workers, [&] {
+      busy_worker_count++;
+      while (release_workers == false) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  while (busy_worker_count < task_scheduler.GetWorkerCount()) {
+    std::this_thread::yield();
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::ExchangeExecutor executor(&exchange_node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::multiset<int> result;
+  bool grown = false;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      result.insert(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    }
+
+    // One instance ran, the others start after the table grew. The new
+    // tuples are not visible to the scan, but the new tile groups must not
+    // move the ranges of the instances.
+    if (grown == false) {
+      auto insert_txn = txn_manager.BeginTransaction();
+      ExecutorTestsUtil::PopulateTable(table.get(), 100, false, false, false,
+                                       insert_txn);
+      txn_manager.CommitTransaction(insert_txn);
+      grown = true;
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  release_workers = true;
+  task_scheduler.Wait(busy_workers);
+
+  // Every tuple shows up once
+  EXPECT_EQ(tuple_count, result.size());
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_EQ(1, result.count(ExecutorTestsUtil::PopulatedValue(tuple_itr, 0)));
+  }
+}
+
+TEST_F(ExchangeTests, UnpartitionableTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(20, tuples_per_tile_group,
+                                                false, false));
+
+  // Each instance would return up to the limit
+  std::unique_ptr<planner::LimitPlan> limit_node(new planner::LimitPlan(5, 0));
+  limit_node->AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0})));
+
+  planner::ExchangePlan exchange_node(PARTITION_TYPE_TILE_GROUP_RANGE, 2);
+  exchange_node.AddChild(std::move(limit_node));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::ExchangeExecutor executor(&exchange_node, context.get());
+  EXPECT_FALSE(executor.Init());
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(ExchangeTests, TupleBudgetTest) {
+  // SELECT a FROM table LIMIT 10, over 10 tile groups in 4 partitions
+  const int tuple_count = 95;
+  const size_t tuple_budget = 10;
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(tuple_count,
+                                                tuples_per_tile_group, false,
+                                                false));
+
+  planner::ExchangePlan exchange_node(PARTITION_TYPE_TILE_GROUP_RANGE, 4);
+  exchange_node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      new planner::SeqScanPlan(table.get(), nullptr, {0})));
+
+  // Keep every worker busy, so that the instances only run one after the
+  // other on this thread while it waits for output
+  auto &task_scheduler = TaskScheduler::GetInstance();
+  TaskGroup busy_workers;
+  std::atomic<size_t> busy_worker_count(0);
+  std::atomic<bool> release_workers(false);
+  for (size_t worker_itr = 0; worker_itr < task_scheduler.GetWorkerCount();
+       worker_itr++) {
+    task_scheduler.Submit(busy_workers, [&] {
+      busy_worker_count++;
+      while (release_workers == false) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  while (busy_worker_count < task_scheduler.GetWorkerCount()) {
+    std::this_thread::yield();
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::ExchangeExecutor executor(&exchange_node, context.get());
+  EXPECT_TRUE(executor.Init());
+  executor.SetTupleBudget(tuple_budget);
+
+  std::set<int> result;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      result.insert(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  release_workers = true;
+  task_scheduler.Wait(busy_workers);
+
+  // The first instance to run returns the budget from its first tile group.
+  // Every instance would return as many, but the ones that run after it
+  // are cancelled before they read anything.
+  EXPECT_EQ(tuple_budget, result.size());
+}
+
+}  // namespace test
+}  // namespace peloton
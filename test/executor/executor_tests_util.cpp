@@ -424,6 +424,20 @@ storage::DataTable *ExecutorTestsUtil::CreateAndPopulateTable() {
   return table;
 }
 
+storage::DataTable *ExecutorTestsUtil::CreateAndPopulateTable(
+    int tuple_count, int tuples_per_tilegroup_count, bool indexes,
+    bool group_by) {
+  storage::DataTable *table =
+      ExecutorTestsUtil::CreateTable(tuples_per_tilegroup_count, indexes);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false, group_by,
+                                   txn);
+  txn_manager.CommitTransaction(txn);
+
+  return table;
+}
+
 std::unique_ptr<storage::Tuple> ExecutorTestsUtil::GetTuple(
     storage::DataTable *table, oid_t tuple_id, type::VarlenPool *pool) {
   std::unique_ptr<storage::Tuple> tuple(
@@ -0,0 +1,171 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// explain_analyze_test.cpp
+//
+// Identification: test/executor/explain_analyze_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+
+#include "common/harness.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/aggregate_executor.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/plan_executor.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/aggregate_plan.h"
+#include "planner/order_by_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Explain Analyze Tests
+//===--------------------------------------------------------------------===//
+
+class ExplainAnalyzeTests : public PelotonTest {};
+
+// Matches the first half of the rows of the table
+static expression::AbstractExpression *CreatePredicate(int tuple_count) {
+  return expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(tuple_count / 2, 0))));
+}
+
+TEST_F(ExplainAnalyzeTests, InstrumentationTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(100));
+  planner::SeqScanPlan scan_node(table.get(), CreatePredicate(100), {0, 1});
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor scan_executor(&scan_node, context.get());
+
+  // Disabled by default
+  EXPECT_TRUE(scan_executor.GetOperatorStats() == nullptr);
+  scan_executor.EnableInstrumentation(0);
+
+  EXPECT_TRUE(scan_executor.Init());
+  size_t tile_count = 0;
+  while (scan_executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(
+        scan_executor.GetOutput());
+    tile_count++;
+  }
+  txn_manager.CommitTransaction(txn);
+
+  auto operator_stats = scan_executor.GetOperatorStats();
+  ASSERT_TRUE(operator_stats != nullptr);
+  EXPECT_EQ(PLAN_NODE_TYPE_SEQSCAN, operator_stats->plan_node_type);
+  EXPECT_EQ(tile_count, operator_stats->tile_count);
+  EXPECT_EQ(50, operator_stats->tuple_count);
+  EXPECT_EQ(50, operator_stats->filtered_tuple_count);
+  EXPECT_LE(0, operator_stats->time_ms);
+}
+
+TEST_F(ExplainAnalyzeTests, HashAggregateTest) {
+  // SELECT a, SUM(b) FROM table WHERE a < 500 GROUP BY a
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(100));
+  planner::SeqScanPlan scan_node(table.get(), CreatePredicate(100), {0, 1});
+
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> proj_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  agg_terms.emplace_back(
+      EXPRESSION_TYPE_AGGREGATE_SUM,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::INTEGER, 0, 1));
+  std::shared_ptr<const catalog::Schema> output_table_schema(
+      new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0),
+                           ExecutorTestsUtil::GetColumnInfo(1)}));
+  planner::AggregatePlan aggregate_node(
+      std::move(proj_info), nullptr, std::move(agg_terms), {0},
+      output_table_schema, AGGREGATE_TYPE_HASH);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor scan_executor(&scan_node, context.get());
+  executor::AggregateExecutor aggregate_executor(&aggregate_node,
+                                                 context.get());
+  aggregate_executor.AddChild(&scan_executor);
+  aggregate_executor.EnableInstrumentation(0);
+
+  EXPECT_TRUE(aggregate_executor.Init());
+  while (aggregate_executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(
+        aggregate_executor.GetOutput());
+  }
+  txn_manager.CommitTransaction(txn);
+
+  // The groups were charged to the aggregate executor, and released with
+  // the hash table
+  auto operator_stats = aggregate_executor.GetOperatorStats();
+  ASSERT_TRUE(operator_stats != nullptr);
+  EXPECT_EQ(PLAN_NODE_TYPE_AGGREGATE_V2, operator_stats->plan_node_type);
+  EXPECT_EQ(50, operator_stats->tuple_count);
+  EXPECT_LT(0, operator_stats->peak_memory);
+  EXPECT_EQ(0, aggregate_executor.GetChargedMemory());
+}
+
+TEST_F(ExplainAnalyzeTests, ExecutePlanTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(100));
+  std::unique_ptr<planner::AbstractPlan> scan_node(
+      new planner::SeqScanPlan(table.get(), CreatePredicate(100), {0, 1}));
+  planner::OrderByPlan order_by_node({0}, {false}, {0, 1});
+  order_by_node.AddChild(std::move(scan_node));
+
+  // EXPLAIN, a line per plan node
+  std::vector<ResultType> result;
+  bridge::PlanExecutor::ExplainPlan(&order_by_node, result);
+  ASSERT_EQ(2, result.size());
+  EXPECT_EQ("-> ORDERBY",
+            std::string(result[0].second.begin(), result[0].second.end()));
+  EXPECT_EQ("  -> SEQSCAN",
+            std::string(result[1].second.begin(), result[1].second.end()));
+
+  // EXPLAIN ANALYZE, a line per executor instead of the tuples
+  result.clear();
+  std::vector<type::Value> params;
+  std::vector<int> result_format(2, 0);
+  auto status = bridge::PlanExecutor::ExecutePlan(&order_by_node, params,
+                                                  result, result_format, true);
+  EXPECT_EQ(RESULT_SUCCESS, status.m_result);
+  ASSERT_EQ(2, result.size());
+
+  std::string column_name(result[0].first.begin(), result[0].first.end());
+  EXPECT_EQ(bridge::PlanExecutor::explain_column_name, column_name);
+
+  std::string order_by_line(result[0].second.begin(), result[0].second.end());
+  EXPECT_EQ(0, order_by_line.find("-> ORDERBY"));
+  EXPECT_NE(std::string::npos, order_by_line.find(" rows=50 filtered=0 "));
+
+  std::string scan_line(result[1].second.begin(), result[1].second.end());
+  EXPECT_EQ(0, scan_line.find("  -> SEQSCAN"));
+  EXPECT_NE(std::string::npos, scan_line.find(" rows=50 filtered=50 "));
+}
+
+}  // namespace test
+}  // namespace peloton
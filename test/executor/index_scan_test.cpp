@@ -34,6 +34,7 @@
 #include "planner/index_scan_plan.h"
 #include "planner/insert_plan.h"
 #include "storage/data_table.h"
+#include "storage/tile.h"
 #include "tcop/tcop.h"
 
 #include "executor/executor_tests_util.h"
@@ -173,5 +174,76 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Index scan that only reads columns of the index key
+TEST_F(IndexScanTests, IndexOnlyScanTest) {
+  // First, generate the table with index
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // Both columns are in the key of the (ATTR 0, ATTR 1) index
+  std::vector<oid_t> column_ids({1, 0});
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 1 > 50 & ATTR 0 < 70
+  //===--------------------------------------------------------------------===//
+
+  auto index = data_table->GetIndex(1);
+  std::vector<oid_t> key_column_ids({1, 0});
+  std::vector<ExpressionType> expr_types(
+      {ExpressionType::EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+       ExpressionType::EXPRESSION_TYPE_COMPARE_LESSTHAN});
+  std::vector<type::Value> values(
+      {type::ValueFactory::GetIntegerValue(50).Copy(),
+       type::ValueFactory::GetIntegerValue(70).Copy()});
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+
+  expression::AbstractExpression *predicate = nullptr;
+
+  planner::IndexScanPlan node(data_table.get(), predicate, column_ids,
+                              index_scan_desc);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  for (bool modified : {false, true}) {
+    // Once a tile group has seen an update or a delete, its tuples are read
+    // from the table again
+    if (modified == true) {
+      for (oid_t tile_group_itr = 0;
+           tile_group_itr < data_table->GetTileGroupCount(); tile_group_itr++) {
+        data_table->GetTileGroup(tile_group_itr)->GetHeader()->SetModified();
+      }
+    }
+
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+
+    executor::IndexScanExecutor executor(&node, context.get());
+    EXPECT_TRUE(executor.Init());
+
+    EXPECT_TRUE(executor.Execute());
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_THAT(result_tile, NotNull());
+    EXPECT_FALSE(executor.Execute());
+
+    // Values read from the index end up in a tile of their own
+    EXPECT_EQ(modified == false,
+              result_tile->GetBaseTile(0)->GetTileGroup() == nullptr);
+
+    EXPECT_EQ(2, result_tile->GetTupleCount());
+    for (oid_t tuple_id : *result_tile) {
+      int attr1 = result_tile->GetValue(tuple_id, 0).GetAs<int32_t>();
+      int attr0 = result_tile->GetValue(tuple_id, 1).GetAs<int32_t>();
+      EXPECT_EQ(attr0 + 1, attr1);
+      EXPECT_LT(attr0, 70);
+    }
+
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -20,6 +20,7 @@
 
 #include "executor/hash_executor.h"
 #include "executor/hash_join_executor.h"
+#include "executor/index_nested_loop_join_executor.h"
 #include "executor/index_scan_executor.h"
 #include "executor/merge_join_executor.h"
 #include "executor/nested_loop_join_executor.h"
@@ -30,6 +31,7 @@
 
 #include "planner/hash_join_plan.h"
 #include "planner/hash_plan.h"
+#include "planner/index_nested_loop_join_plan.h"
 #include "planner/merge_join_plan.h"
 #include "planner/nested_loop_join_plan.h"
 
@@ -211,6 +213,97 @@ TEST_F(JoinTests, BasicNestedLoopTest) {
   ExecuteNestedLoopJoinTest(JOIN_TYPE_INNER);
 }
 
+TEST_F(JoinTests, IndexNestedLoopJoinTest) {
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+  size_t outer_table_tile_group_count = 3;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  // Outer table has ATTR 0 = 0, 50, 100, ...
+  std::unique_ptr<storage::DataTable> outer_table(
+      ExecutorTestsUtil::CreateTable(tile_group_size));
+  PopulateTable(outer_table.get(),
+                tile_group_size * outer_table_tile_group_count, false, txn);
+
+  // Inner table has ATTR 0 = 0, 10, ..., 190 and a primary key on it
+  std::unique_ptr<storage::DataTable> inner_table(
+      ExecutorTestsUtil::CreateTable(tile_group_size));
+  ExecutorTestsUtil::PopulateTable(inner_table.get(), tile_group_size * 4,
+                                   false, false, false, txn);
+
+  txn_manager.CommitTransaction(txn);
+
+  for (auto join_type : {JOIN_TYPE_INNER, JOIN_TYPE_LEFT}) {
+    txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+
+    MockExecutor outer_table_scan_executor;
+    EXPECT_CALL(outer_table_scan_executor, DInit()).WillOnce(Return(true));
+    std::vector<std::unique_ptr<executor::LogicalTile>>
+        outer_table_logical_tile_ptrs;
+    for (size_t tile_group_itr = 0;
+         tile_group_itr < outer_table_tile_group_count; tile_group_itr++) {
+      outer_table_logical_tile_ptrs.emplace_back(
+          executor::LogicalTileFactory::WrapTileGroup(
+              outer_table->GetTileGroup(tile_group_itr)));
+    }
+    ExpectNormalTileResults(outer_table_tile_group_count,
+                            &outer_table_scan_executor,
+                            outer_table_logical_tile_ptrs);
+
+    // Outer ATTR 0 = inner ATTR 0, the output has all the outer columns
+    // followed by inner ATTR 0 and ATTR 1
+    std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(
+        {ExecutorTestsUtil::GetColumnInfo(0),
+         ExecutorTestsUtil::GetColumnInfo(1),
+         ExecutorTestsUtil::GetColumnInfo(2),
+         ExecutorTestsUtil::GetColumnInfo(3),
+         ExecutorTestsUtil::GetColumnInfo(0),
+         ExecutorTestsUtil::GetColumnInfo(1)}));
+    planner::IndexNestedLoopJoinPlan index_nested_loop_join_node(
+        join_type, nullptr, nullptr, schema, inner_table.get(),
+        inner_table->GetIndex(0), {0}, {0, 1});
+
+    executor::IndexNestedLoopJoinExecutor index_nested_loop_join_executor(
+        &index_nested_loop_join_node, context.get());
+    index_nested_loop_join_executor.AddChild(&outer_table_scan_executor);
+
+    EXPECT_TRUE(index_nested_loop_join_executor.Init());
+
+    oid_t result_tuple_count = 0;
+    oid_t tuples_with_null = 0;
+    while (index_nested_loop_join_executor.Execute() == true) {
+      std::unique_ptr<executor::LogicalTile> result_logical_tile(
+          index_nested_loop_join_executor.GetOutput());
+      result_tuple_count += result_logical_tile->GetTupleCount();
+      tuples_with_null += CountTuplesWithNullFields(result_logical_tile.get());
+
+      for (auto tuple_id : *result_logical_tile) {
+        auto inner_value = result_logical_tile->GetValue(tuple_id, 4);
+        if (inner_value.IsNull() == false) {
+          EXPECT_TRUE(result_logical_tile->GetValue(tuple_id, 0)
+                          .CompareEquals(inner_value)
+                          .IsTrue());
+        }
+      }
+    }
+
+    // Outer ATTR 0 = 0, 50, 100 and 150 have a match
+    if (join_type == JOIN_TYPE_INNER) {
+      EXPECT_EQ(4, result_tuple_count);
+      EXPECT_EQ(0, tuples_with_null);
+    } else {
+      EXPECT_EQ(tile_group_size * outer_table_tile_group_count,
+                result_tuple_count);
+      EXPECT_EQ(result_tuple_count - 4, tuples_with_null);
+    }
+
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
 void PopulateTable(storage::DataTable *table, int num_rows, bool random,
                    concurrency::Transaction *current_txn) {
   // Random values
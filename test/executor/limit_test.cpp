@@ -22,10 +22,17 @@
 
 #include "type/types.h"
 #include "type/value.h"
+#include "type/value_factory.h"
 #include "executor/logical_tile.h"
+#include "executor/executor_context.h"
+#include "executor/index_scan_executor.h"
 #include "executor/limit_executor.h"
 #include "executor/logical_tile_factory.h"
+#include "executor/seq_scan_executor.h"
+#include "planner/index_scan_plan.h"
+#include "planner/seq_scan_plan.h"
 #include "storage/data_table.h"
+#include "storage/tuple.h"
 #include "concurrency/transaction_manager_factory.h"
 
 #include "executor/executor_tests_util.h"
@@ -62,6 +69,50 @@ void RunTest(executor::LimitExecutor &executor, size_t expected_num_tiles,
   EXPECT_EQ(expected_num_tuples_returned, actual_num_tuples_returned);
 }
 
+// Runs LIMIT over a scan of every entry of the index of the table, returns
+// the first column of the result and the tuples the scan produced
+void RunIndexScanTest(storage::DataTable *data_table, oid_t index_offset,
+                      bool ordered, size_t limit, size_t offset,
+                      std::vector<int> &result, size_t &scan_tuple_count) {
+  std::vector<oid_t> key_column_ids({0});
+  std::vector<ExpressionType> expr_types(
+      {ExpressionType::EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO});
+  std::vector<type::Value> values(
+      {type::ValueFactory::GetIntegerValue(0).Copy()});
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      data_table->GetIndex(index_offset), key_column_ids, expr_types, values,
+      runtime_keys);
+  planner::IndexScanPlan scan_node(data_table, nullptr, {0, 1},
+                                   index_scan_desc);
+  if (ordered == true) {
+    scan_node.SetOrderedScan(SCAN_DIRECTION_TYPE_BACKWARD, 0);
+  }
+  planner::LimitPlan node(limit, offset);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::LimitExecutor executor(&node, context.get());
+  executor::IndexScanExecutor scan_executor(&scan_node, context.get());
+  executor.AddChild(&scan_executor);
+  scan_executor.EnableInstrumentation(1);
+
+  EXPECT_TRUE(executor.Init());
+
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      result.push_back(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  scan_tuple_count = scan_executor.GetOperatorStats()->tuple_count;
+}
+
 TEST_F(LimitTests, NonLeafLimitOffsetTest) {
   size_t tile_size = 50;
   size_t offset = tile_size / 2, limit = tile_size;
@@ -225,6 +276,161 @@ TEST_F(LimitTests, NonLeafHugeLimitTest) {
 
   RunTest(executor, 2, offset, tile_size * 2 - offset);
 }
+
+TEST_F(LimitTests, NonLeafZeroLimitTest) {
+  size_t offset = 0, limit = 0;
+
+  // Create the plan node
+  planner::LimitPlan node(limit, offset);
+
+  // Create and set up executor
+  executor::LimitExecutor executor(&node, nullptr);
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  // The child is initialized but never executed
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+  EXPECT_CALL(child_executor, DExecute()).Times(0);
+
+  RunTest(executor, 0, INVALID_OID, 0);
+}
+
+TEST_F(LimitTests, SeqScanTupleBudgetTest) {
+  size_t tile_size = 10;
+  size_t offset = 3, limit = 5;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tile_size * 5, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  planner::LimitPlan node(limit, offset);
+  planner::SeqScanPlan scan_node(data_table.get(), nullptr, {0, 1});
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::LimitExecutor executor(&node, context.get());
+  executor::SeqScanExecutor scan_executor(&scan_node, context.get());
+  executor.AddChild(&scan_executor);
+  scan_executor.EnableInstrumentation(1);
+
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<int> result;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      result.push_back(result_tile->GetValue(tuple_id, 0).GetAs<int32_t>());
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  ASSERT_EQ(limit, result.size());
+  for (size_t tuple_itr = 0; tuple_itr < limit; tuple_itr++) {
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(offset + tuple_itr, 0),
+              result[tuple_itr]);
+  }
+
+  // The scan stops at the tuples the limit skips and returns
+  EXPECT_EQ(offset + limit, scan_executor.GetOperatorStats()->tuple_count);
+  EXPECT_EQ(1, scan_executor.GetOperatorStats()->tile_count);
+}
+
+TEST_F(LimitTests, IndexScanTupleBudgetTest) {
+  size_t tile_size = 10;
+  size_t offset = 3, limit = 5;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tile_size * 5, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Primary and secondary index lookups stop at the tuples the limit skips
+  // and returns
+  for (oid_t index_offset = 0; index_offset < data_table->GetIndexCount();
+       index_offset++) {
+    std::vector<int> result;
+    size_t scan_tuple_count = 0;
+    RunIndexScanTest(data_table.get(), index_offset, false, limit, offset,
+                     result, scan_tuple_count);
+
+    ASSERT_EQ(limit, result.size());
+    for (size_t tuple_itr = 0; tuple_itr < limit; tuple_itr++) {
+      EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(offset + tuple_itr, 0),
+                result[tuple_itr]);
+    }
+    EXPECT_EQ(offset + limit, scan_tuple_count);
+  }
+
+  // An ordered scan asks the index for the entries within the budget only
+  std::vector<int> result;
+  size_t scan_tuple_count = 0;
+  RunIndexScanTest(data_table.get(), 0, true, limit, offset, result,
+                   scan_tuple_count);
+
+  ASSERT_EQ(limit, result.size());
+  for (size_t tuple_itr = 0; tuple_itr < limit; tuple_itr++) {
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(
+                  tile_size * 5 - 1 - offset - tuple_itr, 0),
+              result[tuple_itr]);
+  }
+  EXPECT_EQ(offset + limit, scan_tuple_count);
+}
+
+TEST_F(LimitTests, OrderedIndexScanStaleEntryTest) {
+  size_t tile_size = 10;
+  size_t tuple_count = tile_size * 5;
+  size_t limit = 3;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Updating the key of a tuple leaves the entry of the old key behind, and
+  // both entries lead to the same version chain. Give the tuple in the
+  // middle an old key that sorts after all the others.
+  auto index = data_table->GetIndex(1);
+  size_t middle = tuple_count / 2;
+  storage::Tuple key(index->GetKeySchema(), true);
+  key.SetValue(0, type::ValueFactory::GetIntegerValue(
+                      ExecutorTestsUtil::PopulatedValue(middle, 0)),
+               nullptr);
+  key.SetValue(1, type::ValueFactory::GetIntegerValue(
+                      ExecutorTestsUtil::PopulatedValue(middle, 1)),
+               nullptr);
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(&key, location_ptrs);
+  ASSERT_EQ(1, location_ptrs.size());
+
+  key.SetValue(0, type::ValueFactory::GetIntegerValue(
+                      ExecutorTestsUtil::PopulatedValue(tuple_count, 0)),
+               nullptr);
+  EXPECT_TRUE(index->InsertEntry(&key, location_ptrs[0]));
+
+  // The stale entry comes first, but it does not count toward the limit and
+  // the tuple is not returned out of order
+  std::vector<int> result;
+  size_t scan_tuple_count = 0;
+  RunIndexScanTest(data_table.get(), 1, true, limit, 0, result,
+                   scan_tuple_count);
+
+  ASSERT_EQ(limit, result.size());
+  for (size_t tuple_itr = 0; tuple_itr < limit; tuple_itr++) {
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_count - 1 - tuple_itr, 0),
+              result[tuple_itr]);
+  }
+}
 }
 
 }  // namespace test
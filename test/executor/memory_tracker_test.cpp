@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// memory_tracker_test.cpp
+//
+// Identification: test/executor/memory_tracker_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "common/exception.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/memory_tracker.h"
+#include "executor/order_by_executor.h"
+#include "executor/seq_scan_executor.h"
+#include "planner/order_by_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Memory Tracker Tests
+//===--------------------------------------------------------------------===//
+
+class MemoryTrackerTests : public PelotonTest {};
+
+TEST_F(MemoryTrackerTests, LimitTest) {
+  executor::MemoryTracker memory_tracker(1000);
+  auto global_usage = executor::MemoryTracker::GetGlobalUsage();
+
+  memory_tracker.Charge(600);
+  EXPECT_EQ(600, memory_tracker.GetUsage());
+  EXPECT_EQ(global_usage + 600, executor::MemoryTracker::GetGlobalUsage());
+
+  // Over the limit, nothing is charged
+  EXPECT_FALSE(memory_tracker.TryCharge(600));
+  EXPECT_THROW(memory_tracker.Charge(600), OutOfMemoryException);
+  EXPECT_EQ(600, memory_tracker.GetUsage());
+
+  memory_tracker.Release(600);
+  EXPECT_TRUE(memory_tracker.TryCharge(1000));
+  memory_tracker.Release(1000);
+
+  EXPECT_EQ(0, memory_tracker.GetUsage());
+  EXPECT_EQ(1000, memory_tracker.GetPeakUsage());
+  EXPECT_EQ(global_usage, executor::MemoryTracker::GetGlobalUsage());
+}
+
+TEST_F(MemoryTrackerTests, GlobalLimitTest) {
+  // Each query fits in its own limit, but not both of them in the global one
+  executor::MemoryTracker first_memory_tracker(1000);
+  executor::MemoryTracker second_memory_tracker(1000);
+  FLAGS_total_query_memory_limit =
+      executor::MemoryTracker::GetGlobalUsage() + 1500;
+
+  first_memory_tracker.Charge(1000);
+  EXPECT_FALSE(second_memory_tracker.TryCharge(1000));
+  EXPECT_TRUE(second_memory_tracker.TryCharge(500));
+
+  // What the first query did not release goes with its tracker
+  second_memory_tracker.Release(500);
+  FLAGS_total_query_memory_limit = 0;
+}
+
+// Sorts the table on its varchar column and returns the peak memory usage
+// of the query, or 0 if it ran out of memory
+static size_t ExecuteOrderBy(storage::DataTable *table,
+                             size_t query_memory_limit) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  std::shared_ptr<executor::MemoryTracker> memory_tracker(
+      new executor::MemoryTracker(query_memory_limit));
+  context->SetMemoryTracker(memory_tracker);
+
+  bool out_of_memory = false;
+  try {
+    planner::SeqScanPlan scan_node(table, nullptr, {0, 1, 3});
+    planner::OrderByPlan order_by_node({2, 0}, {true, false}, {0, 1, 2});
+    executor::SeqScanExecutor scan_executor(&scan_node, context.get());
+    executor::OrderByExecutor order_by_executor(&order_by_node,
+                                                context.get());
+    order_by_executor.AddChild(&scan_executor);
+
+    EXPECT_TRUE(order_by_executor.Init());
+    size_t result_tuple_count = 0;
+    while (order_by_executor.Execute()) {
+      std::unique_ptr<executor::LogicalTile> result_tile(
+          order_by_executor.GetOutput());
+      result_tuple_count += result_tile->GetTupleCount();
+    }
+    EXPECT_EQ(100, result_tuple_count);
+    EXPECT_LT(0, order_by_executor.GetChargedMemory());
+  } catch (OutOfMemoryException &e) {
+    out_of_memory = true;
+  }
+  txn_manager.CommitTransaction(txn);
+
+  if (out_of_memory) {
+    return 0;
+  }
+
+  // The executors released what they charged, only the pool is left
+  EXPECT_EQ(context->GetExecutorContextPool()->GetPoolSize(),
+            memory_tracker->GetUsage());
+  return memory_tracker->GetPeakUsage();
+}
+
+TEST_F(MemoryTrackerTests, ExecutorTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP));
+  ExecutorTestsUtil::PopulateTable(table.get(), 100, false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto peak_usage = ExecuteOrderBy(table.get(), 0);
+  EXPECT_LT(0, peak_usage);
+
+  // The pool and the sort buffer do not fit in half of that
+  EXPECT_EQ(0, ExecuteOrderBy(table.get(), peak_usage / 2));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,193 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// runtime_join_filter_test.cpp
+//
+// Identification: test/executor/runtime_join_filter_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "catalog/schema.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/hash_executor.h"
+#include "executor/hash_join_executor.h"
+#include "executor/logical_tile.h"
+#include "executor/runtime_join_filter.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/hash_join_plan.h"
+#include "planner/hash_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "type/value_factory.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Runtime Join Filter Tests
+//===--------------------------------------------------------------------===//
+
+class RuntimeJoinFilterTests : public PelotonTest {};
+
+static size_t HashKey(const type::Value &value) {
+  size_t hash = 0;
+  value.HashCombine(hash);
+  return hash;
+}
+
+TEST_F(RuntimeJoinFilterTests, FilterTest) {
+  const int key_count = 1000;
+  executor::RuntimeJoinFilter join_filter(key_count);
+
+  // Even keys only
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    auto key = type::ValueFactory::GetIntegerValue(2 * key_itr);
+    join_filter.Insert(HashKey(key), {key});
+  }
+  EXPECT_EQ(key_count, join_filter.GetKeyCount());
+  EXPECT_TRUE(join_filter.HasRange());
+
+  // No false negatives
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    auto key = type::ValueFactory::GetIntegerValue(2 * key_itr);
+    EXPECT_TRUE(join_filter.MayContain(HashKey(key)));
+    EXPECT_TRUE(join_filter.InRange(key));
+  }
+
+  // Few false positives
+  int false_positive_count = 0;
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    auto key = type::ValueFactory::GetIntegerValue(2 * key_itr + 1);
+    if (join_filter.MayContain(HashKey(key))) {
+      false_positive_count++;
+    }
+  }
+  EXPECT_GT(key_count / 20, false_positive_count);
+
+  EXPECT_FALSE(join_filter.InRange(type::ValueFactory::GetIntegerValue(-1)));
+  EXPECT_FALSE(
+      join_filter.InRange(type::ValueFactory::GetIntegerValue(2 * key_count)));
+}
+
+TEST_F(RuntimeJoinFilterTests, SeqScanTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateAndPopulateTable(100));
+
+  // Keys of the first five tuples
+  executor::RuntimeJoinFilter join_filter(5);
+  for (int tuple_itr = 0; tuple_itr < 5; tuple_itr++) {
+    auto key = type::ValueFactory::GetIntegerValue(
+        ExecutorTestsUtil::PopulatedValue(tuple_itr, 0));
+    join_filter.Insert(HashKey(key), {key});
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  planner::SeqScanPlan scan_node(table.get(), nullptr, {1, 0});
+  executor::SeqScanExecutor executor(&scan_node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  // Keys of another type hash differently, the scan must refuse them
+  executor::RuntimeJoinFilter bigint_filter(1);
+  auto bigint_key = type::ValueFactory::GetBigIntValue(0);
+  bigint_filter.Insert(HashKey(bigint_key), {bigint_key});
+  EXPECT_FALSE(executor.SetJoinFilter(&bigint_filter, {1}));
+
+  // The key is the second column of the output
+  EXPECT_TRUE(executor.SetJoinFilter(&join_filter, {1}));
+
+  // The range of the keys alone drops every other tuple
+  int result_tuple_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      EXPECT_GT(ExecutorTestsUtil::PopulatedValue(5, 0),
+                result_tile->GetValue(tuple_id, 1).GetAs<int32_t>());
+      result_tuple_count++;
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(5, result_tuple_count);
+}
+
+static int ExecuteHashJoin(storage::DataTable *left_table,
+                           storage::DataTable *right_table,
+                           PelotonJoinType join_type) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  planner::SeqScanPlan left_scan_node(left_table, nullptr, {0, 1});
+  planner::SeqScanPlan right_scan_node(right_table, nullptr, {0, 1});
+
+  // Join on the first column
+  std::vector<std::unique_ptr<const expression::AbstractExpression>> hash_keys;
+  hash_keys.emplace_back(
+      new expression::TupleValueExpression(type::Type::INTEGER, 1, 0));
+  planner::HashPlan hash_node(hash_keys);
+
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 1}}};
+  std::unique_ptr<const planner::ProjectInfo> projection(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+  std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(
+      {ExecutorTestsUtil::GetColumnInfo(0),
+       ExecutorTestsUtil::GetColumnInfo(1)}));
+  planner::HashJoinPlan hash_join_node(join_type, nullptr,
+                                       std::move(projection), schema);
+
+  executor::SeqScanExecutor left_scan_executor(&left_scan_node, context.get());
+  executor::SeqScanExecutor right_scan_executor(&right_scan_node,
+                                                context.get());
+  executor::HashExecutor hash_executor(&hash_node, context.get());
+  executor::HashJoinExecutor hash_join_executor(&hash_join_node,
+                                                context.get());
+  hash_join_executor.AddChild(&left_scan_executor);
+  hash_join_executor.AddChild(&hash_executor);
+  hash_executor.AddChild(&right_scan_executor);
+
+  int result_tuple_count = 0;
+  EXPECT_TRUE(hash_join_executor.Init());
+  while (hash_join_executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(
+        hash_join_executor.GetOutput());
+    if (result_tile != nullptr) {
+      result_tuple_count += result_tile->GetTupleCount();
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  return result_tuple_count;
+}
+
+TEST_F(RuntimeJoinFilterTests, HashJoinTest) {
+  // Only the first ten tuples of the left table find a match
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(100));
+  std::unique_ptr<storage::DataTable> right_table(
+      ExecutorTestsUtil::CreateAndPopulateTable(10));
+
+  // The inner join pushes the filter down, the left join must not
+  EXPECT_EQ(10, ExecuteHashJoin(left_table.get(), right_table.get(),
+                                JOIN_TYPE_INNER));
+  EXPECT_EQ(100, ExecuteHashJoin(left_table.get(), right_table.get(),
+                                 JOIN_TYPE_LEFT));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -32,7 +32,10 @@
 #include "expression/expression_util.h"
 #include "planner/seq_scan_plan.h"
 #include "storage/data_table.h"
+#include "storage/string_dictionary.h"
+#include "storage/table_factory.h"
 #include "storage/tile_group_factory.h"
+#include "storage/tuple.h"
 
 #include "common/harness.h"
 #include "executor/executor_tests_util.h"
@@ -319,6 +322,76 @@ TEST_F(SeqScanTests, NonLeafNodePredicateTest) {
 
   txn_manager.CommitTransaction(txn);
 }
+
+// Sequential scan with an equality predicate on a dictionary encoded column.
+TEST_F(SeqScanTests, DictionaryPredicateTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  const int row_count = 12;
+  std::vector<std::string> statuses({"open", "closed", "pending review"});
+
+  catalog::Column status_column(type::Type::VARCHAR, 32, "status", false);
+  status_column.SetDictionaryEncoded(true);
+  catalog::Schema *schema =
+      new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0), status_column});
+  std::unique_ptr<storage::DataTable> table(storage::TableFactory::GetDataTable(
+      INVALID_OID, INVALID_OID, schema, "dictionary_table", tuple_count, true,
+      false));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  for (int rowid = 0; rowid < row_count; rowid++) {
+    storage::Tuple tuple(schema, true);
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(rowid), testing_pool);
+    tuple.SetValue(1, type::ValueFactory::GetVarcharValue(
+                          statuses[rowid % statuses.size()]),
+                   testing_pool);
+
+    ItemPointer *index_entry_ptr = nullptr;
+    ItemPointer tuple_slot_id =
+        table->InsertTuple(&tuple, txn, &index_entry_ptr);
+    txn_manager.PerformInsert(txn, tuple_slot_id, index_entry_ptr);
+  }
+  txn_manager.CommitTransaction(txn);
+
+  // Every tile group keeps its own dictionary
+  for (oid_t tile_group_itr = 0; tile_group_itr < table->GetTileGroupCount();
+       tile_group_itr++) {
+    auto dictionary = table->GetTileGroup(tile_group_itr)->GetDictionary(1);
+    EXPECT_TRUE(dictionary != nullptr);
+    EXPECT_GE(statuses.size(), dictionary->GetSize());
+  }
+
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_EQUAL,
+      expression::ExpressionUtil::TupleValueFactory(type::Type::VARCHAR, 0, 1),
+      expression::ExpressionUtil::ConstantValueFactory(
+          type::ValueFactory::GetVarcharValue(statuses[2])));
+  planner::SeqScanPlan node(table.get(), predicate, {0, 1});
+
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::set<int> expected_rows;
+  for (int rowid = 2; rowid < row_count; rowid += statuses.size()) {
+    expected_rows.insert(rowid);
+  }
+
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      int rowid = result_tile->GetValue(tuple_id, 0).GetAs<int32_t>();
+      EXPECT_EQ(1, expected_rows.erase(rowid));
+      EXPECT_EQ(statuses[2], result_tile->GetValue(tuple_id, 1).ToString());
+    }
+  }
+  EXPECT_EQ(0, expected_rows.size());
+
+  txn_manager.CommitTransaction(txn);
+}
 }
 
 }  // namespace test
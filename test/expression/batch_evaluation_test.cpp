@@ -0,0 +1,404 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// batch_evaluation_test.cpp
+//
+// Identification: test/expression/batch_evaluation_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/container_tuple.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/column_filter_expression.h"
+#include "expression/column_vector.h"
+#include "expression/comparison_expression.h"
+#include "expression/conjunction_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/operator_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/project_info.h"
+#include "storage/tile.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Batch Evaluation Tests
+//===--------------------------------------------------------------------===//
+
+class BatchEvaluationTests : public PelotonTest {};
+
+typedef std::unique_ptr<expression::AbstractExpression> ExpPtr;
+
+static expression::AbstractExpression *Column(type::Type::TypeId type_id,
+                                              int column_id) {
+  return new expression::TupleValueExpression(type_id, 0, column_id);
+}
+
+static expression::AbstractExpression *Constant(const type::Value &value) {
+  return new expression::ConstantValueExpression(value);
+}
+
+static expression::AbstractExpression *Compare(
+    ExpressionType type, expression::AbstractExpression *left,
+    expression::AbstractExpression *right) {
+  return new expression::ComparisonExpression(type, left, right);
+}
+
+/*
+ * BuildSchema() - a: INTEGER with nulls, b: DECIMAL, c: VARCHAR,
+ *                 d: TINYINT
+ */
+static catalog::Schema *BuildSchema() {
+  return new catalog::Schema(
+      {catalog::Column(type::Type::INTEGER,
+                       type::Type::GetTypeSize(type::Type::INTEGER), "a", true),
+       catalog::Column(type::Type::DECIMAL,
+                       type::Type::GetTypeSize(type::Type::DECIMAL), "b", true),
+       catalog::Column(type::Type::VARCHAR, 32, "c", false),
+       catalog::Column(type::Type::TINYINT,
+                       type::Type::GetTypeSize(type::Type::TINYINT), "d",
+                       true)});
+}
+
+/*
+ * BuildTile() - Wraps a tile of tuple_count tuples, every fifth of which is
+ *               invisible
+ */
+static executor::LogicalTile *BuildTile(catalog::Schema *schema,
+                                        const int tuple_count) {
+  std::shared_ptr<storage::Tile> tile(
+      storage::TileFactory::GetTempTile(*schema, tuple_count));
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    storage::Tuple tuple(schema, true);
+    tuple.SetValue(
+        0, (tuple_itr % 7 == 0)
+               ? type::ValueFactory::GetNullValueByType(type::Type::INTEGER)
+               : type::ValueFactory::GetIntegerValue(tuple_itr * 1000000),
+        nullptr);
+    tuple.SetValue(1, type::ValueFactory::GetDoubleValue(tuple_itr / 3.0),
+                   nullptr);
+    tuple.SetValue(2, type::ValueFactory::GetVarcharValue(
+                          std::to_string(tuple_itr % 10)),
+                   nullptr);
+    tuple.SetValue(3, type::ValueFactory::GetTinyIntValue(tuple_itr % 100),
+                   nullptr);
+    tile->InsertTuple(tuple_itr, &tuple);
+  }
+
+  executor::LogicalTile *logical_tile =
+      executor::LogicalTileFactory::WrapTiles({tile});
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr += 5) {
+    logical_tile->RemoveVisibility(tuple_itr);
+  }
+  return logical_tile;
+}
+
+TEST_F(BatchEvaluationTests, PredicateTest) {
+  std::unique_ptr<catalog::Schema> schema(BuildSchema());
+  std::unique_ptr<executor::LogicalTile> tile(BuildTile(schema.get(), 1000));
+
+  std::vector<ExpPtr> predicates;
+  // a < 300000000
+  predicates.emplace_back(
+      Compare(EXPRESSION_TYPE_COMPARE_LESSTHAN, Column(type::Type::INTEGER, 0),
+              Constant(type::ValueFactory::GetIntegerValue(300000000))));
+  // b >= d
+  predicates.emplace_back(Compare(EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+                                  Column(type::Type::DECIMAL, 1),
+                                  Column(type::Type::TINYINT, 3)));
+  // c = '3' OR (d <> 4 AND a > 5e8)
+  predicates.emplace_back(new expression::ConjunctionExpression(
+      EXPRESSION_TYPE_CONJUNCTION_OR,
+      Compare(EXPRESSION_TYPE_COMPARE_EQUAL, Column(type::Type::VARCHAR, 2),
+              Constant(type::ValueFactory::GetVarcharValue("3"))),
+      new expression::ConjunctionExpression(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          Compare(EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+                  Column(type::Type::TINYINT, 3),
+                  Constant(type::ValueFactory::GetIntegerValue(4))),
+          Compare(EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+                  Column(type::Type::INTEGER, 0),
+                  Constant(type::ValueFactory::GetDoubleValue(5e8))))));
+  // NOT (a < 300000000) has no kernel
+  predicates.emplace_back(new expression::OperatorExpression(
+      EXPRESSION_TYPE_OPERATOR_NOT, type::Type::BOOLEAN,
+      Compare(EXPRESSION_TYPE_COMPARE_LESSTHAN, Column(type::Type::INTEGER, 0),
+              Constant(type::ValueFactory::GetIntegerValue(300000000))),
+      nullptr));
+
+  expression::SelectionVector tuple_ids;
+  for (oid_t tuple_id : *tile) {
+    tuple_ids.push_back(tuple_id);
+  }
+
+  for (auto &predicate : predicates) {
+    expression::SelectionVector expected;
+    for (auto tuple_id : tuple_ids) {
+      expression::ContainerTuple<executor::LogicalTile> tuple(tile.get(),
+                                                              tuple_id);
+      if (predicate->Evaluate(&tuple, nullptr, nullptr).IsTrue()) {
+        expected.push_back(tuple_id);
+      }
+    }
+
+    expression::SelectionVector selection(tuple_ids);
+    predicate->EvaluateBatch(*tile, selection, nullptr);
+    EXPECT_EQ(expected, selection);
+  }
+}
+
+TEST_F(BatchEvaluationTests, ArithmeticTest) {
+  std::unique_ptr<catalog::Schema> schema(BuildSchema());
+  std::unique_ptr<executor::LogicalTile> tile(BuildTile(schema.get(), 1000));
+
+  std::vector<ExpPtr> expressions;
+  // a * 2
+  expressions.emplace_back(new expression::OperatorExpression(
+      EXPRESSION_TYPE_OPERATOR_MULTIPLY, type::Type::INTEGER,
+      Column(type::Type::INTEGER, 0),
+      Constant(type::ValueFactory::GetIntegerValue(2))));
+  // b - a
+  expressions.emplace_back(new expression::OperatorExpression(
+      EXPRESSION_TYPE_OPERATOR_MINUS, type::Type::DECIMAL,
+      Column(type::Type::DECIMAL, 1), Column(type::Type::INTEGER, 0)));
+  // d + 2^40
+  expressions.emplace_back(new expression::OperatorExpression(
+      EXPRESSION_TYPE_OPERATOR_PLUS, type::Type::BIGINT,
+      Column(type::Type::TINYINT, 3),
+      Constant(type::ValueFactory::GetBigIntValue(1LL << 40))));
+  // b / 2 has no kernel
+  expressions.emplace_back(new expression::OperatorExpression(
+      EXPRESSION_TYPE_OPERATOR_DIVIDE, type::Type::DECIMAL,
+      Column(type::Type::DECIMAL, 1),
+      Constant(type::ValueFactory::GetIntegerValue(2))));
+
+  expression::SelectionVector selection;
+  for (oid_t tuple_id : *tile) {
+    selection.push_back(tuple_id);
+  }
+
+  for (auto &expr : expressions) {
+    expression::ColumnVector result;
+    expr->EvaluateColumn(*tile, selection, result, nullptr);
+
+    for (auto tuple_id : selection) {
+      expression::ContainerTuple<executor::LogicalTile> tuple(tile.get(),
+                                                              tuple_id);
+      auto expected = expr->Evaluate(&tuple, nullptr, nullptr);
+      auto value = result.GetValue(tuple_id);
+      ASSERT_EQ(expected.IsNull(), value.IsNull());
+      if (expected.IsNull() == false) {
+        EXPECT_EQ(expected.GetTypeId(), value.GetTypeId());
+        EXPECT_TRUE(expected.CompareEquals(value).IsTrue());
+      }
+    }
+  }
+
+  // Overflows fail the same way as tuple at a time
+  ExpPtr overflow(new expression::OperatorExpression(
+      EXPRESSION_TYPE_OPERATOR_MULTIPLY, type::Type::INTEGER,
+      Column(type::Type::INTEGER, 0),
+      Constant(type::ValueFactory::GetIntegerValue(1000))));
+  expression::ColumnVector result;
+  EXPECT_THROW(overflow->EvaluateColumn(*tile, selection, result, nullptr),
+               peloton::Exception);
+}
+
+TEST_F(BatchEvaluationTests, ProjectionTest) {
+  std::unique_ptr<catalog::Schema> schema(BuildSchema());
+  std::unique_ptr<executor::LogicalTile> tile(BuildTile(schema.get(), 1000));
+
+  // a + 1 into both a and the DECIMAL b, c and d as they are
+  TargetList target_list;
+  DirectMapList direct_map_list;
+  for (oid_t column_id = 0; column_id < 2; column_id++) {
+    target_list.emplace_back(
+        column_id,
+        new expression::OperatorExpression(
+            EXPRESSION_TYPE_OPERATOR_PLUS, type::Type::INTEGER,
+            Column(type::Type::INTEGER, 0),
+            Constant(type::ValueFactory::GetIntegerValue(1))));
+  }
+  for (oid_t column_id = 2; column_id < 4; column_id++) {
+    direct_map_list.emplace_back(column_id, std::make_pair(0, column_id));
+  }
+  planner::ProjectInfo project_info(std::move(target_list),
+                                    std::move(direct_map_list));
+
+  auto tuple_count = tile->GetTupleCount();
+  std::unique_ptr<storage::Tile> dest(
+      storage::TileFactory::GetTempTile(*schema, tuple_count));
+  project_info.Evaluate(dest.get(), tile.get(), nullptr);
+
+  oid_t dest_tuple_id = 0;
+  for (oid_t tuple_id : *tile) {
+    storage::Tuple expected(schema.get(), true);
+    expression::ContainerTuple<executor::LogicalTile> tuple(tile.get(),
+                                                            tuple_id);
+    project_info.Evaluate(&expected, &tuple, nullptr, nullptr);
+
+    for (oid_t column_id = 0; column_id < 4; column_id++) {
+      auto expected_value = expected.GetValue(column_id);
+      auto value = dest->GetValue(dest_tuple_id, column_id);
+      ASSERT_EQ(expected_value.IsNull(), value.IsNull());
+      if (expected_value.IsNull() == false) {
+        EXPECT_TRUE(expected_value.CompareEquals(value).IsTrue());
+      }
+    }
+    dest_tuple_id++;
+  }
+  EXPECT_EQ(tuple_count, dest_tuple_id);
+}
+
+TEST_F(BatchEvaluationTests, ColumnFilterTest) {
+  std::vector<type::Type::TypeId> column_types = {
+      type::Type::INTEGER, type::Type::BIGINT, type::Type::DECIMAL,
+      type::Type::TIMESTAMP};
+  std::vector<catalog::Column> columns;
+  for (auto column_type : column_types) {
+    columns.emplace_back(column_type, type::Type::GetTypeSize(column_type),
+                         type::Type::GetInstance(column_type)->ToString(),
+                         true);
+  }
+  std::unique_ptr<catalog::Schema> schema(new catalog::Schema(columns));
+
+  // Every seventh INTEGER, BIGINT and DECIMAL is NULL. TIMESTAMP <> is true
+  // for a NULL, so that column has none.
+  const int tuple_count = 1000;
+  std::shared_ptr<storage::Tile> base_tile(
+      storage::TileFactory::GetTempTile(*schema, tuple_count));
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    storage::Tuple tuple(schema.get(), true);
+    bool is_null = (tuple_itr % 7 == 0);
+    for (oid_t column_id = 0; column_id < 3; column_id++) {
+      tuple.SetValue(column_id, type::ValueFactory::GetNullValueByType(
+                                    column_types[column_id]),
+                     nullptr);
+    }
+    if (is_null == false) {
+      tuple.SetValue(0, type::ValueFactory::GetIntegerValue(
+                            (tuple_itr * 37) % 1000 - 500),
+                     nullptr);
+      tuple.SetValue(1, type::ValueFactory::GetBigIntValue(
+                            (tuple_itr - 500) * 10000000000LL),
+                     nullptr);
+      tuple.SetValue(2, type::ValueFactory::GetDoubleValue(tuple_itr / 4.0),
+                     nullptr);
+    }
+    tuple.SetValue(3, type::ValueFactory::GetTimestampValue(
+                          1000000000000000ULL + tuple_itr),
+                   nullptr);
+    base_tile->InsertTuple(tuple_itr, &tuple);
+  }
+  std::unique_ptr<executor::LogicalTile> tile(
+      executor::LogicalTileFactory::WrapTiles({base_tile}));
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr += 5) {
+    tile->RemoveVisibility(tuple_itr);
+  }
+
+  expression::SelectionVector tuple_ids;
+  for (oid_t tuple_id : *tile) {
+    tuple_ids.push_back(tuple_id);
+  }
+
+  // The filter has to select what the predicate it replaces does
+  auto check_filter = [&](const expression::AbstractExpression *predicate,
+                          const expression::AbstractExpression *filter) {
+    expression::SelectionVector expected;
+    for (auto tuple_id : tuple_ids) {
+      expression::ContainerTuple<executor::LogicalTile> tuple(tile.get(),
+                                                              tuple_id);
+      if (predicate->Evaluate(&tuple, nullptr, nullptr).IsTrue()) {
+        expected.push_back(tuple_id);
+      }
+    }
+
+    expression::SelectionVector selection(tuple_ids);
+    filter->EvaluateBatch(*tile, selection, nullptr);
+    EXPECT_EQ(expected, selection);
+  };
+
+  std::vector<std::vector<type::Value>> constants = {
+      {type::ValueFactory::GetIntegerValue(-20),
+       type::ValueFactory::GetDoubleValue(-20.5),
+       type::ValueFactory::GetBigIntValue(300)},
+      {type::ValueFactory::GetBigIntValue(-20000000000LL),
+       type::ValueFactory::GetDoubleValue(3e12),
+       type::ValueFactory::GetIntegerValue(0)},
+      {type::ValueFactory::GetIntegerValue(50),
+       type::ValueFactory::GetDoubleValue(100.25),
+       type::ValueFactory::GetDoubleValue(170.5)},
+      {type::ValueFactory::GetTimestampValue(1000000000000100ULL),
+       type::ValueFactory::GetTimestampValue(1000000000000500ULL)}};
+  std::vector<ExpressionType> compare_types = {
+      EXPRESSION_TYPE_COMPARE_EQUAL,
+      EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+      EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO};
+
+  for (oid_t column_id = 0; column_id < column_types.size(); column_id++) {
+    auto column_type = column_types[column_id];
+    auto &column_constants = constants[column_id];
+    EXPECT_FALSE(expression::ColumnFilterExpression::IsSupported(
+        column_type, type::ValueFactory::GetVarcharValue("1")));
+
+    for (auto &constant : column_constants) {
+      ASSERT_TRUE(expression::ColumnFilterExpression::IsSupported(
+          column_type, constant));
+      for (auto compare_type : compare_types) {
+        ExpPtr predicate(Compare(compare_type, Column(column_type, column_id),
+                                 Constant(constant)));
+        ExpPtr filter(new expression::ColumnFilterExpression(
+            predicate->Copy(), column_id, column_type, compare_type,
+            constant));
+        check_filter(predicate.get(), filter.get());
+      }
+    }
+
+    // Ranges between the smallest and the largest constant
+    auto &lower = column_constants.front();
+    auto &upper = column_constants.back();
+    if (expression::ColumnFilterExpression::IsSupported(column_type, lower,
+                                                        upper) == false) {
+      continue;
+    }
+    for (auto lower_type : {EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+                            EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO}) {
+      for (auto upper_type : {EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                              EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO}) {
+        ExpPtr predicate(new expression::ConjunctionExpression(
+            EXPRESSION_TYPE_CONJUNCTION_AND,
+            Compare(lower_type, Column(column_type, column_id),
+                    Constant(lower)),
+            Compare(upper_type, Column(column_type, column_id),
+                    Constant(upper))));
+        ExpPtr filter(new expression::ColumnFilterExpression(
+            predicate->Copy(), column_id, column_type, lower_type, lower,
+            upper_type, upper));
+        check_filter(predicate.get(), filter.get());
+
+        // A copy of the filter keeps its kernel
+        ExpPtr filter_copy(filter->Copy());
+        check_filter(predicate.get(), filter_copy.get());
+      }
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -78,6 +78,12 @@ class ExecutorTestsUtil {
   /** @brief Creates a basic table with allocated and populated tuples */
   static storage::DataTable *CreateAndPopulateTable();
 
+  /** @brief Creates a basic table and commits tuple_count populated rows */
+  static storage::DataTable *CreateAndPopulateTable(
+      int tuple_count,
+      int tuples_per_tilegroup_count = TESTS_TUPLES_PER_TILEGROUP,
+      bool indexes = true, bool group_by = false);
+
   static void PopulateTable(storage::DataTable *table, int num_rows,
                             bool mutate, bool random, bool group_by,
                             concurrency::Transaction *current_txn);
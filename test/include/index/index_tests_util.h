@@ -0,0 +1,68 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_tests_util.h
+//
+// Identification: test/include/index/index_tests_util.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "type/types.h"
+
+namespace peloton {
+
+namespace catalog {
+class Schema;
+}
+
+namespace index {
+class Index;
+}
+
+namespace storage {
+class Tuple;
+}
+
+namespace type {
+class VarlenPool;
+}
+
+namespace test {
+
+class IndexTestsUtil {
+ public:
+  /*
+   * BuildIndex() - Builds an index of the given type on all the columns of a
+   * table with the given column types, named "A", "B", ... VARCHAR columns
+   * are 1024 bytes long and not inlined.
+   *
+   * The index owns key_schema, tuple_schema has to outlive the index.
+   */
+  static index::Index *BuildIndex(
+      IndexType index_type,
+      const std::vector<type::Type::TypeId> &column_types,
+      const bool unique_keys, catalog::Schema *&key_schema,
+      std::unique_ptr<catalog::Schema> &tuple_schema);
+
+  // Key of an index on one INTEGER column
+  static std::unique_ptr<storage::Tuple> GetKey(catalog::Schema *key_schema,
+                                                int32_t a);
+
+  // Key of an index on an INTEGER and a VARCHAR column
+  static std::unique_ptr<storage::Tuple> GetKey(catalog::Schema *key_schema,
+                                                int32_t a,
+                                                const std::string &b,
+                                                type::VarlenPool *pool);
+};
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,295 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// art_index_test.cpp
+//
+// Identification: test/index/art_index_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <tuple>
+
+#include "common/harness.h"
+
+#include "index/art_key.h"
+#include "index/index_factory.h"
+#include "index/index_tests_util.h"
+#include "index/scan_optimizer.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// ART Index Tests
+//===--------------------------------------------------------------------===//
+
+class ArtIndexTests : public PelotonTest {};
+
+TEST_F(ArtIndexTests, KeyEncodingTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  catalog::Column column1(type::Type::BIGINT,
+                          type::Type::GetTypeSize(type::Type::BIGINT), "A",
+                          true);
+  catalog::Column column2(type::Type::VARCHAR, 1024, "B", false);
+  catalog::Column column3(type::Type::DECIMAL,
+                          type::Type::GetTypeSize(type::Type::DECIMAL), "C",
+                          true);
+  std::unique_ptr<catalog::Schema> key_schema(
+      new catalog::Schema({column1, column2, column3}));
+
+  // Keys in ascending order, a prefix of a string sorts before the string
+  // and a \0 inside a string before any other byte
+  std::vector<std::tuple<int64_t, std::string, double>> keys = {
+      std::make_tuple(-100, "b", 0.5), std::make_tuple(-1, "", -2.5),
+      std::make_tuple(0, "a", 1.0), std::make_tuple(0, "a", 1e10),
+      std::make_tuple(0, std::string("a\0b", 3), -1e10),
+      std::make_tuple(0, "aa", -1.5), std::make_tuple(0, "ab", -3.0),
+      std::make_tuple(7, "a", 0.0)};
+
+  std::vector<std::string> encoded_keys;
+  for (auto &key : keys) {
+    storage::Tuple tuple(key_schema.get(), true);
+    tuple.SetValue(0, type::ValueFactory::GetBigIntValue(std::get<0>(key)),
+                   pool);
+    tuple.SetValue(1, type::ValueFactory::GetVarcharValue(std::get<1>(key)),
+                   pool);
+    tuple.SetValue(2, type::ValueFactory::GetDoubleValue(std::get<2>(key)),
+                   pool);
+
+    index::ArtKey art_key;
+    art_key.SetFromKey(&tuple);
+    encoded_keys.push_back(art_key.GetData());
+
+    // The encoded key decodes to the same values
+    storage::Tuple decoded_tuple(key_schema.get(), true);
+    index::ArtKey::GetTuple(art_key.GetData(), decoded_tuple, pool);
+    for (oid_t column_itr = 0; column_itr < 3; column_itr++) {
+      EXPECT_TRUE(tuple.GetValue(column_itr)
+                      .CompareEquals(decoded_tuple.GetValue(column_itr))
+                      .IsTrue());
+    }
+  }
+
+  for (size_t key_itr = 0; key_itr + 1 < encoded_keys.size(); key_itr++) {
+    EXPECT_LT(encoded_keys[key_itr], encoded_keys[key_itr + 1]);
+  }
+}
+
+TEST_F(ArtIndexTests, NegativeZeroTest) {
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(IndexTestsUtil::BuildIndex(
+      INDEX_TYPE_ART, {type::Type::DECIMAL}, false, key_schema, tuple_schema));
+
+  storage::Tuple negative_zero(key_schema, true);
+  negative_zero.SetValue(0, type::ValueFactory::GetDoubleValue(-0.0), nullptr);
+  storage::Tuple positive_zero(key_schema, true);
+  positive_zero.SetValue(0, type::ValueFactory::GetDoubleValue(0.0), nullptr);
+
+  // -0.0 == 0.0, so they have to end up under the same key
+  index::ArtKey negative_key;
+  negative_key.SetFromKey(&negative_zero);
+  index::ArtKey positive_key;
+  positive_key.SetFromKey(&positive_zero);
+  EXPECT_EQ(positive_key.GetData(), negative_key.GetData());
+
+  ItemPointer item(1, 1);
+  EXPECT_TRUE(index->InsertEntry(&negative_zero, &item));
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(&positive_zero, location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+}
+
+TEST_F(ArtIndexTests, BasicTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(
+      IndexTestsUtil::BuildIndex(
+          INDEX_TYPE_ART, {type::Type::INTEGER, type::Type::VARCHAR}, false,
+          key_schema, tuple_schema));
+  EXPECT_EQ("ART", index->GetTypeName());
+
+  // Long strings with a shared beginning give nodes with long prefixes
+  const std::string prefix(40, 'p');
+  const int key_count = 300;
+  std::vector<ItemPointer> items;
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    items.push_back(ItemPointer(key_itr, key_itr));
+  }
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    auto key = IndexTestsUtil::GetKey(key_schema, key_itr % 3,
+                                      prefix + std::to_string(key_itr), pool);
+    EXPECT_TRUE(index->InsertEntry(key.get(), &items[key_itr]));
+  }
+
+  // Non-unique keys keep all of their values, but each only once
+  ItemPointer extra_item(key_count, 0);
+  auto key0 = IndexTestsUtil::GetKey(key_schema, 0, prefix + "0", pool);
+  EXPECT_TRUE(index->InsertEntry(key0.get(), &extra_item));
+  EXPECT_FALSE(index->InsertEntry(key0.get(), &extra_item));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_count + 1, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Point query on the full key
+  std::vector<type::Value> values = {
+      type::ValueFactory::GetIntegerValue(1),
+      type::ValueFactory::GetVarcharValue(prefix + "100")};
+  std::vector<oid_t> key_column_ids = {0, 1};
+  std::vector<ExpressionType> expr_types = {EXPRESSION_TYPE_COMPARE_EQUAL,
+                                            EXPRESSION_TYPE_COMPARE_EQUAL};
+  index->ScanTest(values, key_column_ids, expr_types,
+                  SCAN_DIRECTION_TYPE_FORWARD, location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(100, location_ptrs[0]->block);
+  location_ptrs.clear();
+
+  // a = 2 and b >= prefix + "2", the numbers compare as strings
+  values = {type::ValueFactory::GetIntegerValue(2),
+            type::ValueFactory::GetVarcharValue(prefix + "2")};
+  expr_types = {EXPRESSION_TYPE_COMPARE_EQUAL,
+                EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO};
+  index->ScanTest(values, key_column_ids, expr_types,
+                  SCAN_DIRECTION_TYPE_FORWARD, location_ptrs);
+  size_t expected_count = 0;
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    if (key_itr % 3 == 2 && std::to_string(key_itr) >= "2") {
+      expected_count++;
+    }
+  }
+  EXPECT_EQ(expected_count, location_ptrs.size());
+  for (auto location_ptr : location_ptrs) {
+    EXPECT_EQ(2, location_ptr->block % 3);
+  }
+  location_ptrs.clear();
+
+  // 1 <= a < 2 leaves the string open
+  values = {type::ValueFactory::GetIntegerValue(1),
+            type::ValueFactory::GetIntegerValue(2)};
+  key_column_ids = {0, 0};
+  expr_types = {EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+                EXPRESSION_TYPE_COMPARE_LESSTHAN};
+  index->ScanTest(values, key_column_ids, expr_types,
+                  SCAN_DIRECTION_TYPE_FORWARD, location_ptrs);
+  EXPECT_EQ(key_count / 3, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Deleting the last value of a key removes the key
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    auto key = IndexTestsUtil::GetKey(key_schema, key_itr % 3,
+                                      prefix + std::to_string(key_itr), pool);
+    EXPECT_TRUE(index->DeleteEntry(key.get(), &items[key_itr]));
+  }
+  EXPECT_FALSE(index->DeleteEntry(key0.get(), &items[0]));
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(key_count, location_ptrs[0]->block);
+  location_ptrs.clear();
+
+  EXPECT_TRUE(index->DeleteEntry(key0.get(), &extra_item));
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+}
+
+TEST_F(ArtIndexTests, UniqueKeyTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(
+      IndexTestsUtil::BuildIndex(
+          INDEX_TYPE_ART, {type::Type::INTEGER, type::Type::VARCHAR}, true,
+          key_schema, tuple_schema));
+
+  ItemPointer item0(120, 5);
+  ItemPointer item1(120, 7);
+  auto key0 = IndexTestsUtil::GetKey(key_schema, 100, "a", pool);
+
+  // Only the first visible version of the key gets in
+  auto occupied = [](UNUSED_ATTRIBUTE const void *value) { return true; };
+  auto not_occupied = [](UNUSED_ATTRIBUTE const void *value) { return false; };
+  EXPECT_TRUE(index->CondInsertEntry(key0.get(), &item0, occupied));
+  EXPECT_FALSE(index->CondInsertEntry(key0.get(), &item1, occupied));
+  EXPECT_TRUE(index->CondInsertEntry(key0.get(), &item1, not_occupied));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+}
+
+TEST_F(ArtIndexTests, MultiThreadedTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(
+      IndexTestsUtil::BuildIndex(
+          INDEX_TYPE_ART, {type::Type::INTEGER, type::Type::VARCHAR}, false,
+          key_schema, tuple_schema));
+
+  const size_t num_threads = 4;
+  const size_t key_count = 256;
+  const size_t round_count = 20;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (size_t key_itr = 0; key_itr < key_count; key_itr++) {
+    keys.push_back(IndexTestsUtil::GetKey(key_schema, key_itr % 7,
+                                          "key" + std::to_string(key_itr),
+                                          pool));
+  }
+
+  // The index keeps pointers to the items, so they must outlive the threads
+  std::vector<ItemPointer> items;
+  for (size_t thread_itr = 0; thread_itr < num_threads; thread_itr++) {
+    items.push_back(ItemPointer(thread_itr, thread_itr));
+  }
+
+  // Every thread keeps inserting and deleting its own value of all the keys,
+  // which grows, splits and collapses the nodes all the time
+  auto worker = [&](uint64_t thread_itr) {
+    ItemPointer &item = items[thread_itr];
+    std::vector<ItemPointer *> location_ptrs;
+    for (size_t round_itr = 0; round_itr < round_count; round_itr++) {
+      for (auto &key : keys) {
+        EXPECT_TRUE(index->InsertEntry(key.get(), &item));
+      }
+      index->ScanAllKeys(location_ptrs);
+      location_ptrs.clear();
+      for (auto &key : keys) {
+        EXPECT_TRUE(index->DeleteEntry(key.get(), &item));
+      }
+    }
+    for (auto &key : keys) {
+      EXPECT_TRUE(index->InsertEntry(key.get(), &item));
+    }
+  };
+  LaunchParallelTest(num_threads, worker);
+
+  std::vector<ItemPointer *> location_ptrs;
+  for (auto &key : keys) {
+    index->ScanKey(key.get(), location_ptrs);
+    EXPECT_EQ(num_threads, location_ptrs.size());
+    location_ptrs.clear();
+  }
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(num_threads * key_count, location_ptrs.size());
+
+  // Nothing is in the tree any more, so everything retired can go
+  index->PerformGC();
+  index->PerformGC();
+  EXPECT_FALSE(index->NeedGC());
+}
+
+}  // End test namespace
+}  // End peloton namespace
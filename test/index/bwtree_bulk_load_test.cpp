@@ -0,0 +1,139 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bwtree_bulk_load_test.cpp
+//
+// Identification: test/index/bwtree_bulk_load_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <random>
+
+#include "common/harness.h"
+
+#include "index/index_factory.h"
+#include "index/index_tests_util.h"
+#include "index/scan_optimizer.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// BwTree Bulk Load Tests
+//===--------------------------------------------------------------------===//
+
+class BwTreeBulkLoadTests : public PelotonTest {};
+
+TEST_F(BwTreeBulkLoadTests, BulkLoadTest) {
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(IndexTestsUtil::BuildIndex(
+      INDEX_TYPE_BWTREE, {type::Type::INTEGER}, false, key_schema,
+      tuple_schema));
+
+  // Every key has two values, enough for a few levels of inner nodes
+  const int key_count = 20000;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<ItemPointer> items;
+  items.reserve(2 * key_count);
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entries;
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    keys.push_back(IndexTestsUtil::GetKey(key_schema, key_itr));
+    for (int value_itr = 0; value_itr < 2; value_itr++) {
+      items.push_back(ItemPointer(key_itr, value_itr));
+      entries.emplace_back(keys.back().get(), &items.back());
+    }
+  }
+
+  // The same entry twice only gets in once
+  entries.push_back(entries.front());
+  std::shuffle(entries.begin(), entries.end(), std::default_random_engine(0));
+
+  EXPECT_EQ(2 * key_count, index->BulkInsertEntries(entries, true));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(2 * key_count, location_ptrs.size());
+  for (size_t location_itr = 0; location_itr + 1 < location_ptrs.size();
+       location_itr++) {
+    EXPECT_LE(location_ptrs[location_itr]->block,
+              location_ptrs[location_itr + 1]->block);
+  }
+  location_ptrs.clear();
+
+  for (int key_itr : {0, 1, key_count / 2, key_count - 1}) {
+    index->ScanKey(keys[key_itr].get(), location_ptrs);
+    EXPECT_EQ(2, location_ptrs.size());
+    location_ptrs.clear();
+  }
+
+  // 100 <= a < 300
+  std::vector<type::Value> values = {type::ValueFactory::GetIntegerValue(100),
+                                     type::ValueFactory::GetIntegerValue(300)};
+  std::vector<oid_t> key_column_ids = {0, 0};
+  std::vector<ExpressionType> expr_types = {
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      EXPRESSION_TYPE_COMPARE_LESSTHAN};
+  index->ScanTest(values, key_column_ids, expr_types,
+                  SCAN_DIRECTION_TYPE_FORWARD, location_ptrs);
+  EXPECT_EQ(400, location_ptrs.size());
+  location_ptrs.clear();
+
+  // The tree keeps working as usual afterwards, splits included
+  ItemPointer new_item(key_count, 2);
+  for (int key_itr = 0; key_itr < key_count; key_itr += 10) {
+    EXPECT_TRUE(index->InsertEntry(keys[key_itr].get(), &new_item));
+  }
+  EXPECT_FALSE(index->InsertEntry(keys[0].get(), &new_item));
+  EXPECT_TRUE(index->DeleteEntry(keys[1].get(), &items[2]));
+
+  index->ScanKey(keys[0].get(), location_ptrs);
+  EXPECT_EQ(3, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanKey(keys[1].get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(2 * key_count + key_count / 10 - 1, location_ptrs.size());
+}
+
+TEST_F(BwTreeBulkLoadTests, SharedIndexTest) {
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(IndexTestsUtil::BuildIndex(
+      INDEX_TYPE_BWTREE, {type::Type::INTEGER}, false, key_schema,
+      tuple_schema));
+
+  const int key_count = 1000;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<ItemPointer> items;
+  items.reserve(key_count);
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entries;
+  for (int key_itr = key_count - 1; key_itr >= 0; key_itr--) {
+    keys.push_back(IndexTestsUtil::GetKey(key_schema, key_itr));
+    items.push_back(ItemPointer(key_itr, 0));
+    entries.emplace_back(keys.back().get(), &items.back());
+  }
+
+  // Without exclusive access the entries are inserted one by one, and
+  // those already in the index are not inserted again
+  EXPECT_TRUE(index->InsertEntry(entries[0].first, entries[0].second));
+  EXPECT_EQ(key_count - 1, index->BulkInsertEntries(entries, false));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_count, location_ptrs.size());
+  EXPECT_EQ(0, location_ptrs.front()->block);
+  EXPECT_EQ(key_count - 1, location_ptrs.back()->block);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,220 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bwtree_scan_test.cpp
+//
+// Identification: test/index/bwtree_scan_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include "common/harness.h"
+
+#include "index/bwtree.h"
+#include "index/index_factory.h"
+#include "index/index_tests_util.h"
+#include "index/scan_optimizer.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// BwTree Scan Tests
+//===--------------------------------------------------------------------===//
+
+class BwTreeScanTests : public PelotonTest {};
+
+using TestBwTree = index::BwTree<int64_t, int64_t>;
+
+TEST_F(BwTreeScanTests, ReverseIteratorTest) {
+  std::unique_ptr<TestBwTree> tree(new TestBwTree{true});
+
+  // An empty tree has nothing to go back to
+  EXPECT_TRUE(tree->RBegin().IsEnd());
+
+  // Enough keys for a few levels, with every third one deleted again so
+  // that nodes get merged as well
+  std::set<int64_t> keys;
+  std::default_random_engine generator(0);
+  for (int key_itr = 0; key_itr < 50000; key_itr++) {
+    int64_t key = (generator() % 100000) * 2;
+    keys.insert(key);
+    tree->Insert(key, key);
+  }
+  int key_itr = 0;
+  for (auto key : std::set<int64_t>(keys)) {
+    if (key_itr++ % 3 == 0) {
+      EXPECT_TRUE(tree->Delete(key, key));
+      keys.erase(key);
+    }
+  }
+
+  auto key_rit = keys.rbegin();
+  for (auto scan_itr = tree->RBegin(); scan_itr.IsEnd() == false;
+       --scan_itr) {
+    ASSERT_TRUE(key_rit != keys.rend());
+    EXPECT_EQ(*key_rit, scan_itr->first);
+    key_rit++;
+  }
+  EXPECT_TRUE(key_rit == keys.rend());
+
+  for (int query_itr = 0; query_itr < 1000; query_itr++) {
+    int64_t query_key = generator() % 200010 - 5;
+
+    // RBegin() stops on the last key <= the query key
+    auto scan_itr = tree->RBegin(query_key);
+    auto key_it = keys.upper_bound(query_key);
+    if (key_it == keys.begin()) {
+      EXPECT_TRUE(scan_itr.IsEnd());
+      continue;
+    }
+    key_it--;
+    ASSERT_FALSE(scan_itr.IsEnd());
+    EXPECT_EQ(*key_it, scan_itr->first);
+
+    // The iterator goes both ways
+    if (key_it != keys.begin()) {
+      --scan_itr;
+      ++scan_itr;
+      EXPECT_EQ(*key_it, scan_itr->first);
+    }
+
+    // Going back from Begin() ends up on the last key < the query key
+    auto forward_itr = tree->Begin(query_key);
+    --forward_itr;
+    key_it = keys.lower_bound(query_key);
+    if (key_it == keys.begin()) {
+      EXPECT_TRUE(forward_itr.IsEnd());
+    } else {
+      key_it--;
+      ASSERT_FALSE(forward_itr.IsEnd());
+      EXPECT_EQ(*key_it, forward_itr->first);
+    }
+  }
+}
+
+TEST_F(BwTreeScanTests, ScanLimitTest) {
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(IndexTestsUtil::BuildIndex(
+      INDEX_TYPE_BWTREE, {type::Type::INTEGER}, false, key_schema,
+      tuple_schema));
+
+  const int key_count = 10000;
+  std::vector<ItemPointer> items;
+  items.reserve(key_count);
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    auto key = IndexTestsUtil::GetKey(key_schema, key_itr);
+    items.push_back(ItemPointer(key_itr, 0));
+    index->InsertEntry(key.get(), &items.back());
+  }
+
+  // 100 <= a < 300
+  std::vector<type::Value> values = {type::ValueFactory::GetIntegerValue(100),
+                                     type::ValueFactory::GetIntegerValue(300)};
+  std::vector<oid_t> key_column_ids = {0, 0};
+  std::vector<ExpressionType> expr_types = {
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      EXPRESSION_TYPE_COMPARE_LESSTHAN};
+  index::ConjunctionScanPredicate csp(index.get(), values, key_column_ids,
+                                      expr_types);
+
+  std::vector<ItemPointer *> location_ptrs;
+  EXPECT_TRUE(index->ScanLimit(values, key_column_ids, expr_types,
+                               SCAN_DIRECTION_TYPE_BACKWARD, location_ptrs,
+                               &csp, 20, nullptr));
+  ASSERT_EQ(20, location_ptrs.size());
+  for (int location_itr = 0; location_itr < 20; location_itr++) {
+    EXPECT_EQ(299 - location_itr, location_ptrs[location_itr]->block);
+  }
+  location_ptrs.clear();
+
+  // The keys of the entries can come along
+  std::vector<type::Value> key_values;
+  EXPECT_TRUE(index->ScanLimit(values, key_column_ids, expr_types,
+                               SCAN_DIRECTION_TYPE_FORWARD, location_ptrs,
+                               &csp, 20, &key_values));
+  ASSERT_EQ(20, location_ptrs.size());
+  EXPECT_EQ(100, location_ptrs.front()->block);
+  EXPECT_EQ(119, location_ptrs.back()->block);
+  ASSERT_EQ(20, key_values.size());
+  for (int location_itr = 0; location_itr < 20; location_itr++) {
+    EXPECT_EQ(location_ptrs[location_itr]->block,
+              key_values[location_itr].GetAs<int32_t>());
+  }
+  location_ptrs.clear();
+
+  // Without a limit the whole range comes back in order
+  EXPECT_TRUE(index->ScanLimit(values, key_column_ids, expr_types,
+                               SCAN_DIRECTION_TYPE_BACKWARD, location_ptrs,
+                               &csp, 0, nullptr));
+  ASSERT_EQ(200, location_ptrs.size());
+  EXPECT_EQ(299, location_ptrs.front()->block);
+  EXPECT_EQ(100, location_ptrs.back()->block);
+  location_ptrs.clear();
+
+  // Without a predicate every entry is scanned
+  EXPECT_TRUE(index->ScanLimit({}, {}, {}, SCAN_DIRECTION_TYPE_BACKWARD,
+                               location_ptrs, nullptr, 3, nullptr));
+  ASSERT_EQ(3, location_ptrs.size());
+  EXPECT_EQ(key_count - 1, location_ptrs[0]->block);
+  EXPECT_EQ(key_count - 3, location_ptrs[2]->block);
+}
+
+TEST_F(BwTreeScanTests, StructureStatsTest) {
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(IndexTestsUtil::BuildIndex(
+      INDEX_TYPE_BWTREE, {type::Type::INTEGER}, false, key_schema,
+      tuple_schema));
+
+  // Too small to split a node into two that are not merged right away
+  EXPECT_FALSE(index->SetSplitThreshold(10, 10));
+  EXPECT_FALSE(index->SetConsolidationThreshold(0, 8));
+
+  // Long delta chains and small nodes
+  EXPECT_TRUE(index->SetConsolidationThreshold(64, 64));
+  EXPECT_TRUE(index->SetSplitThreshold(256, 256));
+
+  // Keys in random order, so that deltas pile up on every leaf and not only
+  // on the rightmost one
+  const int key_count = 20000;
+  std::vector<int> keys;
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    keys.push_back(key_itr);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::default_random_engine(0));
+
+  std::vector<ItemPointer> items;
+  items.reserve(key_count);
+  for (auto key_value : keys) {
+    auto key = IndexTestsUtil::GetKey(key_schema, key_value);
+    items.push_back(ItemPointer(key_value, 0));
+    index->InsertEntry(key.get(), &items.back());
+  }
+
+  index::IndexStructureStats stats;
+  EXPECT_TRUE(index->GetStructureStats(stats));
+  EXPECT_GT(stats.split_count, key_count / 256);
+  EXPECT_GT(stats.node_count, stats.split_count);
+  EXPECT_GT(stats.consolidation_count, 0);
+  EXPECT_GT(stats.avg_delta_chain_length, 8.0);
+  EXPECT_GT(stats.garbage_byte_count, 0);
+
+  // Everything unlinked so far can go once no thread is in the epoch
+  index->PerformGC();
+  index->PerformGC();
+  EXPECT_TRUE(index->GetStructureStats(stats));
+  EXPECT_EQ(0, stats.garbage_byte_count);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,173 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index_test.cpp
+//
+// Identification: test/index/hash_index_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "index/index_factory.h"
+#include "index/index_tests_util.h"
+#include "index/scan_optimizer.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Index Tests
+//===--------------------------------------------------------------------===//
+
+class HashIndexTests : public PelotonTest {};
+
+TEST_F(HashIndexTests, BasicTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(
+      IndexTestsUtil::BuildIndex(
+          INDEX_TYPE_HASH, {type::Type::INTEGER, type::Type::VARCHAR}, false,
+          key_schema, tuple_schema));
+  EXPECT_EQ("Hash", index->GetTypeName());
+
+  ItemPointer item0(120, 5);
+  ItemPointer item1(120, 7);
+  ItemPointer item2(123, 19);
+  auto key0 = IndexTestsUtil::GetKey(key_schema, 100, "a", pool);
+  auto key1 = IndexTestsUtil::GetKey(key_schema, 100, "b", pool);
+
+  // Non-unique keys keep all of their values, but each only once
+  EXPECT_TRUE(index->InsertEntry(key0.get(), &item0));
+  EXPECT_TRUE(index->InsertEntry(key1.get(), &item1));
+  EXPECT_TRUE(index->InsertEntry(key1.get(), &item2));
+  EXPECT_FALSE(index->InsertEntry(key1.get(), &item1));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(key1.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(3, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Point query on the full key
+  std::vector<type::Value> values = {type::ValueFactory::GetIntegerValue(100),
+                                     type::ValueFactory::GetVarcharValue("a")};
+  std::vector<oid_t> key_column_ids = {0, 1};
+  std::vector<ExpressionType> expr_types = {EXPRESSION_TYPE_COMPARE_EQUAL,
+                                            EXPRESSION_TYPE_COMPARE_EQUAL};
+  index::ConjunctionScanPredicate point_predicate(index.get(), values,
+                                                  key_column_ids, expr_types);
+  EXPECT_TRUE(point_predicate.IsPointQuery());
+  index->Scan(values, key_column_ids, expr_types, SCAN_DIRECTION_TYPE_FORWARD,
+              location_ptrs, &point_predicate);
+  EXPECT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(item0.offset, location_ptrs[0]->offset);
+  location_ptrs.clear();
+
+  // Anything else looks at every key
+  values = {type::ValueFactory::GetIntegerValue(100)};
+  key_column_ids = {0};
+  expr_types = {EXPRESSION_TYPE_COMPARE_EQUAL};
+  index::ConjunctionScanPredicate partial_predicate(index.get(), values,
+                                                    key_column_ids, expr_types);
+  index->Scan(values, key_column_ids, expr_types, SCAN_DIRECTION_TYPE_FORWARD,
+              location_ptrs, &partial_predicate);
+  EXPECT_EQ(3, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Deleting the last value of a key removes the key
+  EXPECT_TRUE(index->DeleteEntry(key0.get(), &item0));
+  EXPECT_FALSE(index->DeleteEntry(key0.get(), &item0));
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+
+  EXPECT_TRUE(index->InsertEntry(key0.get(), &item2));
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(1, location_ptrs.size());
+}
+
+TEST_F(HashIndexTests, UniqueKeyTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(
+      IndexTestsUtil::BuildIndex(
+          INDEX_TYPE_HASH, {type::Type::INTEGER, type::Type::VARCHAR}, true,
+          key_schema, tuple_schema));
+
+  ItemPointer item0(120, 5);
+  ItemPointer item1(120, 7);
+  auto key0 = IndexTestsUtil::GetKey(key_schema, 100, "a", pool);
+
+  // Only the first visible version of the key gets in
+  auto occupied = [](UNUSED_ATTRIBUTE const void *value) { return true; };
+  auto not_occupied = [](UNUSED_ATTRIBUTE const void *value) { return false; };
+  EXPECT_TRUE(index->CondInsertEntry(key0.get(), &item0, occupied));
+  EXPECT_FALSE(index->CondInsertEntry(key0.get(), &item1, occupied));
+  EXPECT_TRUE(index->CondInsertEntry(key0.get(), &item1, not_occupied));
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+}
+
+TEST_F(HashIndexTests, MultiThreadedTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  catalog::Schema *key_schema = nullptr;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(
+      IndexTestsUtil::BuildIndex(
+          INDEX_TYPE_HASH, {type::Type::INTEGER, type::Type::VARCHAR}, false,
+          key_schema, tuple_schema));
+
+  const size_t num_threads = 4;
+  const size_t key_count = 64;
+  const size_t round_count = 50;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (size_t key_itr = 0; key_itr < key_count; key_itr++) {
+    keys.push_back(IndexTestsUtil::GetKey(key_schema, key_itr, "key", pool));
+  }
+
+  // The index keeps pointers to the items, so they must outlive the threads
+  std::vector<ItemPointer> items;
+  for (size_t thread_itr = 0; thread_itr < num_threads; thread_itr++) {
+    items.push_back(ItemPointer(thread_itr, thread_itr));
+  }
+
+  // Every thread keeps inserting and deleting its own value of all the keys,
+  // which empties and erases them all the time
+  auto worker = [&](uint64_t thread_itr) {
+    ItemPointer &item = items[thread_itr];
+    for (size_t round_itr = 0; round_itr < round_count; round_itr++) {
+      for (auto &key : keys) {
+        EXPECT_TRUE(index->InsertEntry(key.get(), &item));
+      }
+      for (auto &key : keys) {
+        EXPECT_TRUE(index->DeleteEntry(key.get(), &item));
+      }
+    }
+    for (auto &key : keys) {
+      EXPECT_TRUE(index->InsertEntry(key.get(), &item));
+    }
+  };
+  LaunchParallelTest(num_threads, worker);
+
+  std::vector<ItemPointer *> location_ptrs;
+  for (auto &key : keys) {
+    index->ScanKey(key.get(), location_ptrs);
+    EXPECT_EQ(num_threads, location_ptrs.size());
+    location_ptrs.clear();
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -341,6 +341,50 @@ TEST_F(IndexTests, MultiMapInsertTest) {
   delete tuple_schema;
 }
 
+TEST_F(IndexTests, ScanBatchTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false));
+
+  size_t scale_factor = 10;
+  LaunchParallelTest(1, InsertTest, index.get(), pool, scale_factor);
+
+  // Keys out of order, some of them twice and some of them missing
+  std::vector<std::pair<int, std::string>> key_values = {
+      {500, "b"}, {100, "b"}, {1000, "f"}, {300, "a"},
+      {100, "b"}, {800, "c"}, {400, "d"},  {100, "a"}};
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  std::vector<const storage::Tuple *> key_ptrs;
+  for (auto &key_value : key_values) {
+    keys.emplace_back(new storage::Tuple(key_schema, true));
+    keys.back()->SetValue(
+        0, type::ValueFactory::GetIntegerValue(key_value.first), pool);
+    keys.back()->SetValue(
+        1, type::ValueFactory::GetVarcharValue(key_value.second), pool);
+    key_ptrs.push_back(keys.back().get());
+  }
+
+  std::vector<std::vector<ItemPointer *>> results;
+  index->ScanBatch(key_ptrs, results);
+  EXPECT_EQ(keys.size(), results.size());
+
+  // Every key finds what it finds on its own
+  for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+    index->ScanKey(keys[key_itr].get(), location_ptrs);
+    EXPECT_EQ(location_ptrs.size(), results[key_itr].size());
+    location_ptrs.clear();
+  }
+
+  EXPECT_EQ(0, results[2].size());
+  EXPECT_EQ(results[1].size(), results[4].size());
+  EXPECT_EQ(1, results[7].size());
+  EXPECT_EQ(item0->block, results[7][0]->block);
+
+  delete tuple_schema;
+}
+
 #ifdef ALLOW_UNIQUE_KEY
 TEST_F(IndexTests, UniqueKeyDeleteTest) {
   auto pool = TestingHarness::GetInstance().GetTestingPool();
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_tests_util.cpp
+//
+// Identification: test/index/index_tests_util.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/index_tests_util.h"
+
+#include "catalog/schema.h"
+#include "index/index_factory.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+index::Index *IndexTestsUtil::BuildIndex(
+    IndexType index_type,
+    const std::vector<type::Type::TypeId> &column_types,
+    const bool unique_keys, catalog::Schema *&key_schema,
+    std::unique_ptr<catalog::Schema> &tuple_schema) {
+  std::vector<catalog::Column> columns;
+  std::vector<oid_t> key_attrs;
+  for (oid_t column_itr = 0; column_itr < column_types.size(); column_itr++) {
+    auto column_type = column_types[column_itr];
+    std::string column_name(1, static_cast<char>('A' + column_itr));
+    if (column_type == type::Type::VARCHAR) {
+      columns.push_back(
+          catalog::Column(column_type, 1024, column_name, false));
+    } else {
+      columns.push_back(catalog::Column(column_type,
+                                        type::Type::GetTypeSize(column_type),
+                                        column_name, true));
+    }
+    key_attrs.push_back(column_itr);
+  }
+
+  key_schema = new catalog::Schema(columns);
+  key_schema->SetIndexedColumns(key_attrs);
+  tuple_schema.reset(new catalog::Schema(columns));
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "test_index", 125, INVALID_OID, INVALID_OID, index_type,
+      INDEX_CONSTRAINT_TYPE_DEFAULT, tuple_schema.get(), key_schema, key_attrs,
+      unique_keys);
+
+  return index::IndexFactory::GetInstance(index_metadata);
+}
+
+std::unique_ptr<storage::Tuple> IndexTestsUtil::GetKey(
+    catalog::Schema *key_schema, int32_t a) {
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  key->SetValue(0, type::ValueFactory::GetIntegerValue(a), nullptr);
+  return key;
+}
+
+std::unique_ptr<storage::Tuple> IndexTestsUtil::GetKey(
+    catalog::Schema *key_schema, int32_t a, const std::string &b,
+    type::VarlenPool *pool) {
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  key->SetValue(0, type::ValueFactory::GetIntegerValue(a), pool);
+  key->SetValue(1, type::ValueFactory::GetVarcharValue(b), pool);
+  return key;
+}
+
+}  // namespace test
+}  // namespace peloton
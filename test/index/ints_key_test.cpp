@@ -0,0 +1,153 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// ints_key_test.cpp
+//
+// Identification: test/index/ints_key_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "index/index_factory.h"
+#include "index/index_key.h"
+#include "index/scan_optimizer.h"
+#include "storage/tuple.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Ints Key Tests
+//===--------------------------------------------------------------------===//
+
+class IntsKeyTests : public PelotonTest {};
+
+static catalog::Schema *BuildIntsKeySchema() {
+  catalog::Column column1(type::Type::INTEGER,
+                          type::Type::GetTypeSize(type::Type::INTEGER), "A",
+                          true);
+  catalog::Column column2(type::Type::BIGINT,
+                          type::Type::GetTypeSize(type::Type::BIGINT), "B",
+                          true);
+  auto key_schema = new catalog::Schema({column1, column2});
+  key_schema->SetIndexedColumns({0, 1});
+  return key_schema;
+}
+
+static std::unique_ptr<storage::Tuple> GetKey(catalog::Schema *key_schema,
+                                              int32_t a, int64_t b) {
+  std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+  key->SetValue(0, type::ValueFactory::GetIntegerValue(a), nullptr);
+  key->SetValue(1, type::ValueFactory::GetBigIntValue(b), nullptr);
+  return key;
+}
+
+TEST_F(IntsKeyTests, CompareTest) {
+  std::unique_ptr<catalog::Schema> key_schema(BuildIntsKeySchema());
+
+  // (a, b) pairs in ascending order
+  std::vector<std::pair<int32_t, int64_t>> pairs = {
+      {-5, 100}, {-1, INT64_MAX}, {0, -3}, {0, 7}, {42, -100}};
+
+  index::IntsComparator<2> comparator;
+  index::IntsEqualityChecker<2> equals;
+  std::vector<index::IntsKey<2>> ints_keys;
+  std::vector<char> key_data(key_schema->GetLength());
+  for (auto &pair : pairs) {
+    auto key = GetKey(key_schema.get(), pair.first, pair.second);
+    index::IntsKey<2> ints_key;
+    ints_key.SetFromKey(key.get());
+    ints_keys.push_back(ints_key);
+
+    // The packed key unpacks to the same values
+    auto tuple =
+        ints_key.GetTupleForComparison(key_schema.get(), key_data.data());
+    EXPECT_EQ(pair.first, type::ValuePeeker::PeekInteger(tuple.GetValue(0)));
+    EXPECT_EQ(pair.second, type::ValuePeeker::PeekBigInt(tuple.GetValue(1)));
+  }
+
+  for (size_t key_itr = 0; key_itr + 1 < ints_keys.size(); key_itr++) {
+    EXPECT_TRUE(comparator(ints_keys[key_itr], ints_keys[key_itr + 1]));
+    EXPECT_FALSE(comparator(ints_keys[key_itr + 1], ints_keys[key_itr]));
+    EXPECT_FALSE(equals(ints_keys[key_itr], ints_keys[key_itr + 1]));
+    EXPECT_TRUE(equals(ints_keys[key_itr], ints_keys[key_itr]));
+  }
+}
+
+TEST_F(IntsKeyTests, UnpackBufferTest) {
+  std::unique_ptr<catalog::Schema> key_schema(BuildIntsKeySchema());
+
+  index::IntsKey<2> first_key;
+  index::IntsKey<2> second_key;
+  auto first = GetKey(key_schema.get(), 1, 10);
+  auto second = GetKey(key_schema.get(), 2, 20);
+  first_key.SetFromKey(first.get());
+  second_key.SetFromKey(second.get());
+
+  // Each unpacked tuple lives in its own buffer, so both stay valid
+  std::vector<char> first_data(key_schema->GetLength());
+  std::vector<char> second_data(key_schema->GetLength());
+  auto first_tuple =
+      first_key.GetTupleForComparison(key_schema.get(), first_data.data());
+  auto second_tuple =
+      second_key.GetTupleForComparison(key_schema.get(), second_data.data());
+
+  EXPECT_EQ(1, type::ValuePeeker::PeekInteger(first_tuple.GetValue(0)));
+  EXPECT_EQ(10, type::ValuePeeker::PeekBigInt(first_tuple.GetValue(1)));
+  EXPECT_EQ(2, type::ValuePeeker::PeekInteger(second_tuple.GetValue(0)));
+  EXPECT_EQ(20, type::ValuePeeker::PeekBigInt(second_tuple.GetValue(1)));
+}
+
+TEST_F(IntsKeyTests, IndexScanTest) {
+  for (auto index_type : {INDEX_TYPE_BWTREE, INDEX_TYPE_BTREE}) {
+    auto key_schema = BuildIntsKeySchema();
+    std::unique_ptr<catalog::Schema> tuple_schema(
+        new catalog::Schema(key_schema->GetColumns()));
+    std::vector<oid_t> key_attrs = {0, 1};
+
+    index::IndexMetadata *index_metadata = new index::IndexMetadata(
+        "ints_key_index", 125, INVALID_OID, INVALID_OID, index_type,
+        INDEX_CONSTRAINT_TYPE_DEFAULT, tuple_schema.get(), key_schema,
+        key_attrs, false);
+    std::unique_ptr<index::Index> index(
+        index::IndexFactory::GetInstance(index_metadata));
+
+    const int key_count = 20;
+    std::vector<ItemPointer> items;
+    for (int key_itr = 0; key_itr < key_count; key_itr++) {
+      items.push_back(ItemPointer(key_itr, key_itr));
+    }
+    for (int key_itr = 0; key_itr < key_count; key_itr++) {
+      auto key = GetKey(key_schema, key_itr - key_count / 2, key_itr * 10);
+      EXPECT_TRUE(index->InsertEntry(key.get(), &items[key_itr]));
+    }
+
+    std::vector<ItemPointer *> location_ptrs;
+    auto key = GetKey(key_schema, -3, 70);
+    index->ScanKey(key.get(), location_ptrs);
+    EXPECT_EQ(1, location_ptrs.size());
+    EXPECT_EQ(7, location_ptrs[0]->offset);
+    location_ptrs.clear();
+
+    // -2 <= a < 3 unpacks every key on the way
+    std::vector<type::Value> values = {type::ValueFactory::GetIntegerValue(-2),
+                                       type::ValueFactory::GetIntegerValue(3)};
+    std::vector<oid_t> key_column_ids = {0, 0};
+    std::vector<ExpressionType> expr_types = {
+        EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+        EXPRESSION_TYPE_COMPARE_LESSTHAN};
+    index::ConjunctionScanPredicate predicate(index.get(), values,
+                                              key_column_ids, expr_types);
+    index->Scan(values, key_column_ids, expr_types, SCAN_DIRECTION_TYPE_FORWARD,
+                location_ptrs, &predicate);
+    EXPECT_EQ(5, location_ptrs.size());
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
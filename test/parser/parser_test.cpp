@@ -407,5 +407,32 @@ TEST_F(ParserTest, CopyTest) {
   }
 }
 
+TEST_F(ParserTest, ExplainTest) {
+  std::vector<std::pair<std::string, bool>> queries = {
+      {"EXPLAIN SELECT * FROM foo WHERE id = 1;", false},
+      {"EXPLAIN ANALYZE SELECT * FROM foo WHERE id = 1;", true}};
+
+  // Parsing
+  for (auto &query : queries) {
+    parser::SQLStatementList* result =
+        parser::Parser::ParseSQLString(query.first.c_str());
+
+    if (result->is_valid == false) {
+      LOG_ERROR("Message: %s, line: %d, col: %d", result->parser_msg,
+                result->error_line, result->error_col);
+    }
+    EXPECT_EQ(result->is_valid, true);
+    EXPECT_EQ(STATEMENT_TYPE_EXPLAIN, result->GetStatement(0)->GetType());
+
+    parser::ExplainStatement* explain_stmt =
+        static_cast<parser::ExplainStatement*>(result->GetStatement(0));
+
+    EXPECT_EQ(query.second, explain_stmt->analyze);
+    EXPECT_EQ(STATEMENT_TYPE_SELECT, explain_stmt->statement->GetType());
+
+    delete result;
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -15,7 +15,9 @@
 #include "catalog/catalog.h"
 #include "common/harness.h"
 #include "executor/create_executor.h"
+#include "optimizer/simple_optimizer.h"
 #include "planner/create_plan.h"
+#include "planner/index_scan_plan.h"
 
 #include "sql/sql_tests_util.h"
 
@@ -100,5 +102,196 @@ TEST_F(IndexScanSQLTests, SQLTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+TEST_F(IndexScanSQLTests, OrderByLimitTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  SQLTestsUtil::ExecuteSQLQuery("CREATE TABLE test(a INT PRIMARY KEY, b INT);");
+  for (int key_itr = 1; key_itr <= 9; key_itr++) {
+    SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (" +
+                                  std::to_string(key_itr) + ", " +
+                                  std::to_string(10 - key_itr) + ");");
+  }
+
+  std::unique_ptr<optimizer::AbstractOptimizer> optimizer(
+      new optimizer::SimpleOptimizer());
+
+  // The primary key index returns the tuples in order, so there is no sort
+  auto select_plan = SQLTestsUtil::GeneratePlanWithOptimizer(
+      optimizer, "SELECT a, b FROM test ORDER BY a DESC LIMIT 3;");
+  EXPECT_EQ(PLAN_NODE_TYPE_LIMIT, select_plan->GetPlanNodeType());
+  auto scan_plan = select_plan->GetChildren()[0].get();
+  ASSERT_EQ(PLAN_NODE_TYPE_INDEXSCAN, scan_plan->GetPlanNodeType());
+  auto index_scan_plan = static_cast<planner::IndexScanPlan *>(scan_plan);
+  EXPECT_TRUE(index_scan_plan->IsOrdered());
+  EXPECT_EQ(SCAN_DIRECTION_TYPE_BACKWARD, index_scan_plan->GetScanDirection());
+  EXPECT_EQ(3, index_scan_plan->GetLimit());
+
+  // b has no index, so it is still sorted
+  select_plan = SQLTestsUtil::GeneratePlanWithOptimizer(
+      optimizer, "SELECT a, b FROM test ORDER BY b LIMIT 3;");
+  EXPECT_EQ(PLAN_NODE_TYPE_ORDERBY,
+            select_plan->GetChildren()[0]->GetPlanNodeType());
+
+  std::vector<ResultType> result;
+  std::vector<FieldInfoType> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  SQLTestsUtil::ExecuteSQLQuery("SELECT a, b FROM test ORDER BY a DESC LIMIT 3;",
+                                result, tuple_descriptor, rows_affected,
+                                error_message);
+  ASSERT_EQ(6, result.size());
+  EXPECT_EQ('9', result[0].second[0]);
+  EXPECT_EQ('1', result[1].second[0]);
+  EXPECT_EQ('8', result[2].second[0]);
+  EXPECT_EQ('7', result[4].second[0]);
+
+  SQLTestsUtil::ExecuteSQLQuery(
+      "SELECT a FROM test WHERE a < 5 ORDER BY a LIMIT 2 OFFSET 1;", result,
+      tuple_descriptor, rows_affected, error_message);
+  ASSERT_EQ(2, result.size());
+  EXPECT_EQ('2', result[0].second[0]);
+  EXPECT_EQ('3', result[1].second[0]);
+
+  // The entries of deleted tuples are skipped and the scan goes on for more
+  SQLTestsUtil::ExecuteSQLQuery("DELETE FROM test WHERE a > 6;");
+  SQLTestsUtil::ExecuteSQLQuery("SELECT a FROM test ORDER BY a DESC LIMIT 3;",
+                                result, tuple_descriptor, rows_affected,
+                                error_message);
+  ASSERT_EQ(3, result.size());
+  EXPECT_EQ('6', result[0].second[0]);
+  EXPECT_EQ('5', result[1].second[0]);
+  EXPECT_EQ('4', result[2].second[0]);
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(IndexScanSQLTests, OrderByUpdatedKeyTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  SQLTestsUtil::ExecuteSQLQuery("CREATE TABLE test(a INT PRIMARY KEY, b INT);");
+  for (int key_itr = 1; key_itr <= 9; key_itr++) {
+    SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (" +
+                                  std::to_string(key_itr) + ", " +
+                                  std::to_string(key_itr * 10) + ");");
+  }
+  SQLTestsUtil::ExecuteSQLQuery("CREATE INDEX b_idx ON test (b);");
+
+  // The entry of the old b stays in the index until GC gets to it
+  SQLTestsUtil::ExecuteSQLQuery("UPDATE test SET b = 5 WHERE a = 9;");
+
+  std::vector<ResultType> result;
+  std::vector<FieldInfoType> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  SQLTestsUtil::ExecuteSQLQuery("SELECT a, b FROM test ORDER BY b DESC LIMIT 3;",
+                                result, tuple_descriptor, rows_affected,
+                                error_message);
+  ASSERT_EQ(6, result.size());
+  EXPECT_EQ('8', result[0].second[0]);
+  EXPECT_EQ('7', result[2].second[0]);
+  EXPECT_EQ('6', result[4].second[0]);
+
+  SQLTestsUtil::ExecuteSQLQuery("SELECT a, b FROM test ORDER BY b LIMIT 2;",
+                                result, tuple_descriptor, rows_affected,
+                                error_message);
+  ASSERT_EQ(4, result.size());
+  EXPECT_EQ('9', result[0].second[0]);
+  EXPECT_EQ('1', result[2].second[0]);
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(IndexScanSQLTests, PartialIndexTest) {
+  catalog::Catalog::GetInstance()->CreateDatabase(DEFAULT_DB_NAME, nullptr);
+
+  SQLTestsUtil::ExecuteSQLQuery(
+      "CREATE TABLE test(a INT PRIMARY KEY, b INT, c INT);");
+  for (int key_itr = 1; key_itr <= 9; key_itr++) {
+    SQLTestsUtil::ExecuteSQLQuery(
+        "INSERT INTO test VALUES (" + std::to_string(key_itr) + ", " +
+        std::to_string(key_itr * 10) + ", " + std::to_string(key_itr % 2) +
+        ");");
+  }
+
+  // Only the tuples with an odd a get an entry
+  SQLTestsUtil::ExecuteSQLQuery("CREATE INDEX b_idx ON test (b) WHERE c = 1;");
+  auto table = catalog::Catalog::GetInstance()->GetTableWithName(
+      DEFAULT_DB_NAME, "test");
+  auto index = table->GetIndex(1);
+  EXPECT_TRUE(index->GetMetadata()->IsPartial());
+  std::vector<ItemPointer *> index_entries;
+  index->ScanAllKeys(index_entries);
+  EXPECT_EQ(5, index_entries.size());
+
+  SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (10, 100, 1);");
+  SQLTestsUtil::ExecuteSQLQuery("INSERT INTO test VALUES (11, 110, 0);");
+  index_entries.clear();
+  index->ScanAllKeys(index_entries);
+  EXPECT_EQ(6, index_entries.size());
+
+  // A version moving into the predicate gets an entry, even with the same key
+  SQLTestsUtil::ExecuteSQLQuery("UPDATE test SET c = 1 WHERE a = 2;");
+  index_entries.clear();
+  index->ScanAllKeys(index_entries);
+  EXPECT_EQ(7, index_entries.size());
+
+  std::unique_ptr<optimizer::AbstractOptimizer> optimizer(
+      new optimizer::SimpleOptimizer());
+
+  // The query predicate implies the index predicate
+  auto select_plan = SQLTestsUtil::GeneratePlanWithOptimizer(
+      optimizer, "SELECT a FROM test WHERE b > 20 AND c = 1;");
+  ASSERT_EQ(PLAN_NODE_TYPE_INDEXSCAN, select_plan->GetPlanNodeType());
+  EXPECT_EQ("b_idx", static_cast<planner::IndexScanPlan *>(select_plan.get())
+                         ->GetIndex()
+                         ->GetName());
+
+  // The index misses some of the tuples with c = 0
+  select_plan = SQLTestsUtil::GeneratePlanWithOptimizer(
+      optimizer, "SELECT a FROM test WHERE b > 20;");
+  EXPECT_EQ(PLAN_NODE_TYPE_SEQSCAN, select_plan->GetPlanNodeType());
+
+  std::vector<ResultType> result;
+  std::vector<FieldInfoType> tuple_descriptor;
+  std::string error_message;
+  int rows_affected;
+
+  SQLTestsUtil::ExecuteSQLQuery("SELECT a FROM test WHERE b = 20 AND c = 1;",
+                                result, tuple_descriptor, rows_affected,
+                                error_message);
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ('2', result[0].second[0]);
+
+  // The entry of a version that left the predicate is filtered out
+  SQLTestsUtil::ExecuteSQLQuery("UPDATE test SET c = 0 WHERE a = 3;");
+  SQLTestsUtil::ExecuteSQLQuery("SELECT a FROM test WHERE b = 30 AND c = 1;",
+                                result, tuple_descriptor, rows_affected,
+                                error_message);
+  EXPECT_EQ(0, result.size());
+
+  SQLTestsUtil::ExecuteSQLQuery(
+      "SELECT a FROM test WHERE b < 60 AND c = 1 ORDER BY b DESC LIMIT 2;",
+      result, tuple_descriptor, rows_affected, error_message);
+  ASSERT_EQ(2, result.size());
+  EXPECT_EQ('5', result[0].second[0]);
+  EXPECT_EQ('2', result[1].second[0]);
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// anti_cache_test.cpp
+//
+// Identification: test/storage/anti_cache_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/manager.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_tests_util.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "storage/anti_cache_manager.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "type/value_peeker.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Anti-Cache Tests
+//===--------------------------------------------------------------------===//
+
+class AntiCacheTests : public PelotonTest {};
+
+TEST_F(AntiCacheTests, EvictAndFetchTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  const int tile_group_count = 5;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(),
+                                   tuple_count * tile_group_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  auto resident_size = anti_cache_manager.GetResidentSize();
+  EXPECT_GT(resident_size, 0);
+
+  // Squeeze the memory limit so that every cold tile group has to go
+  anti_cache_manager.SetMemoryLimit(1);
+  auto evicted_count = anti_cache_manager.EvictColdTileGroups();
+  EXPECT_GT(evicted_count, 0);
+  EXPECT_EQ(evicted_count, anti_cache_manager.GetEvictedTileGroupCount());
+  EXPECT_LT(anti_cache_manager.GetResidentSize(), resident_size);
+
+  // Stop evicting so that the fetched tile groups stay resident
+  anti_cache_manager.SetMemoryLimit(0);
+
+  // Every tuple must come back unchanged
+  auto fetch_count = anti_cache_manager.GetFetchCount();
+  oid_t row_itr = 0;
+  for (size_t tile_group_itr = 0;
+       tile_group_itr < data_table->GetTileGroupCount(); tile_group_itr++) {
+    auto tile_group = data_table->GetTileGroup(tile_group_itr);
+    EXPECT_FALSE(tile_group->IsEvicted());
+
+    auto active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_itr = 0; tuple_itr < active_tuple_count; tuple_itr++) {
+      auto int_value = tile_group->GetValue(tuple_itr, 0);
+      EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(row_itr, 0),
+                type::ValuePeeker::PeekInteger(int_value));
+
+      auto string_value = tile_group->GetValue(tuple_itr, 3);
+      EXPECT_EQ(std::to_string(ExecutorTestsUtil::PopulatedValue(row_itr, 3)),
+                string_value.ToString());
+      row_itr++;
+    }
+  }
+
+  EXPECT_EQ(tuple_count * tile_group_count, row_itr);
+  EXPECT_EQ(fetch_count + evicted_count, anti_cache_manager.GetFetchCount());
+  EXPECT_EQ(0, anti_cache_manager.GetEvictedTileGroupCount());
+}
+
+TEST_F(AntiCacheTests, ActiveTileGroupTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   false, txn);
+
+  // Tuples owned by an in-flight transaction pin their tile group
+  auto tile_group_id = data_table->GetTileGroup(0)->GetTileGroupId();
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  EXPECT_FALSE(anti_cache_manager.EvictTileGroup(tile_group_id));
+
+  txn_manager.CommitTransaction(txn);
+
+  // So does a reader holding a reference to it
+  auto tile_group = data_table->GetTileGroup(0);
+  EXPECT_FALSE(anti_cache_manager.EvictTileGroup(tile_group_id));
+  EXPECT_FALSE(tile_group->IsEvicted());
+}
+
+TEST_F(AntiCacheTests, PinnedTileGroupTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Every lookup pins the tile group once, copies share the pin
+  auto tile_group = data_table->GetTileGroup(0);
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto other_tile_group = catalog::Manager::GetInstance().GetTileGroup(
+      tile_group_id);
+  auto tile_group_copy = tile_group;
+  EXPECT_EQ(2, tile_group->GetPinCount());
+
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  other_tile_group.reset();
+  EXPECT_FALSE(anti_cache_manager.EvictTileGroup(tile_group_id));
+
+  tile_group.reset();
+  EXPECT_EQ(1, tile_group_copy->GetPinCount());
+  EXPECT_FALSE(anti_cache_manager.EvictTileGroup(tile_group_id));
+
+  // Once the last reference is gone the tile group can go
+  auto tile_group_ptr = tile_group_copy.get();
+  tile_group_copy.reset();
+  EXPECT_EQ(0, tile_group_ptr->GetPinCount());
+  EXPECT_TRUE(anti_cache_manager.EvictTileGroup(tile_group_id));
+
+  tile_group = data_table->GetTileGroup(0);
+  EXPECT_FALSE(tile_group->IsEvicted());
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(0, 0),
+            type::ValuePeeker::PeekInteger(tile_group->GetValue(0, 0)));
+}
+
+TEST_F(AntiCacheTests, LogicalTileReaderTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // A logical tile keeps reading the tiles after the scan let go of the tile
+  // group itself
+  auto tile_group_id = data_table->GetTileGroup(0)->GetTileGroupId();
+  std::unique_ptr<executor::LogicalTile> logical_tile(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  auto &anti_cache_manager = storage::AntiCacheManager::GetInstance();
+  EXPECT_FALSE(anti_cache_manager.EvictTileGroup(tile_group_id));
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(0, 0),
+            type::ValuePeeker::PeekInteger(logical_tile->GetValue(0, 0)));
+
+  // Once the reader is done the tile group can go
+  logical_tile.reset();
+  EXPECT_TRUE(anti_cache_manager.EvictTileGroup(tile_group_id));
+
+  auto tile_group = data_table->GetTileGroup(0);
+  EXPECT_FALSE(tile_group->IsEvicted());
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(0, 0),
+            type::ValuePeeker::PeekInteger(tile_group->GetValue(0, 0)));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -10,11 +10,22 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <atomic>
+#include <map>
+#include <thread>
+
 #include "common/harness.h"
 
 #include "storage/data_table.h"
+#include "storage/table_factory.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tuple.h"
+#include "index/index.h"
+#include "index/index_factory.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "type/value_peeker.h"
 #include "executor/executor_tests_util.h"
 
 namespace peloton {
@@ -69,8 +80,349 @@ TEST_F(DataTableTests, TransformTileGroupTest) {
   data_table->TransformTileGroup(0, theta);
 }
 
+TEST_F(DataTableTests, BulkLoadTest) {
+  const int tuple_count = 3 * TESTS_TUPLES_PER_TILEGROUP - 1;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true));
+  std::unique_ptr<type::VarlenPool> pool(
+      new type::VarlenPool(BACKEND_TYPE_MM));
+
+  // Load the tuples in reverse key order
+  std::vector<std::unique_ptr<storage::Tuple>> tuples;
+  std::vector<const storage::Tuple *> batch;
+  for (int tuple_itr = tuple_count - 1; tuple_itr >= 0; tuple_itr--) {
+    tuples.push_back(
+        ExecutorTestsUtil::GetTuple(data_table.get(), tuple_itr, pool.get()));
+    batch.push_back(tuples.back().get());
+  }
+
+  auto txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(data_table->BulkLoad(batch, txn));
+
+  // The default tile group is left alone
+  EXPECT_EQ(4, data_table->GetTileGroupCount());
+  EXPECT_EQ(tuple_count, data_table->GetTupleCount());
+  EXPECT_EQ(0, data_table->GetTileGroup(0)->GetNextTupleSlot());
+
+  // Only the loading transaction sees the tuples before the commit
+  auto other_txn = txn_manager.BeginTransaction();
+  auto tile_group_header = data_table->GetTileGroup(1)->GetHeader();
+  EXPECT_EQ(VISIBILITY_OK, txn_manager.IsVisible(txn, tile_group_header, 0));
+  EXPECT_EQ(VISIBILITY_INVISIBLE,
+            txn_manager.IsVisible(other_txn, tile_group_header, 0));
+  txn_manager.CommitTransaction(other_txn);
+
+  auto commit_id = txn->GetBeginCommitId();
+  txn_manager.CommitTransaction(txn);
+
+  // All the tuples share the commit id of the transaction
+  size_t loaded_count = 0;
+  for (oid_t tile_group_itr = 1; tile_group_itr < 4; tile_group_itr++) {
+    auto tile_group = data_table->GetTileGroup(tile_group_itr);
+    tile_group_header = tile_group->GetHeader();
+    for (oid_t tuple_itr = 0; tuple_itr < tile_group->GetNextTupleSlot();
+         tuple_itr++) {
+      EXPECT_EQ(INITIAL_TXN_ID, tile_group_header->GetTransactionId(tuple_itr));
+      EXPECT_EQ(commit_id, tile_group_header->GetBeginCommitId(tuple_itr));
+      EXPECT_EQ(MAX_CID, tile_group_header->GetEndCommitId(tuple_itr));
+      loaded_count++;
+    }
+  }
+  EXPECT_EQ(tuple_count, loaded_count);
+
+  // Every index got all the keys
+  for (oid_t index_itr = 0; index_itr < data_table->GetIndexCount();
+       index_itr++) {
+    std::vector<ItemPointer *> index_entries;
+    data_table->GetIndex(index_itr)->ScanAllKeys(index_entries);
+    EXPECT_EQ(tuple_count, index_entries.size());
+  }
+
+  // A duplicate primary key fails the load, aborting hides the new tuples
+  tuples.clear();
+  batch.clear();
+  tuples.push_back(ExecutorTestsUtil::GetTuple(data_table.get(), tuple_count,
+                                               pool.get()));
+  tuples.push_back(
+      ExecutorTestsUtil::GetTuple(data_table.get(), 0, pool.get()));
+  batch.push_back(tuples[0].get());
+  batch.push_back(tuples[1].get());
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_FALSE(data_table->BulkLoad(batch, txn));
+  txn_manager.AbortTransaction(txn);
+
+  tile_group_header = data_table->GetTileGroup(4)->GetHeader();
+  for (oid_t tuple_itr = 0; tuple_itr < batch.size(); tuple_itr++) {
+    EXPECT_EQ(INVALID_TXN_ID, tile_group_header->GetTransactionId(tuple_itr));
+    EXPECT_EQ(MAX_CID, tile_group_header->GetBeginCommitId(tuple_itr));
+  }
+
+  // So does a key that is new to the table but twice in the batch
+  tuples.clear();
+  batch.clear();
+  for (int tuple_itr = 0; tuple_itr < 2; tuple_itr++) {
+    tuples.push_back(ExecutorTestsUtil::GetTuple(data_table.get(),
+                                                 tuple_count + 1, pool.get()));
+    batch.push_back(tuples.back().get());
+  }
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_FALSE(data_table->BulkLoad(batch, txn));
+  txn_manager.AbortTransaction(txn);
+}
+
+TEST_F(DataTableTests, PopulateIndexTest) {
+  const int tuple_count = 3 * TESTS_TUPLES_PER_TILEGROUP;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // Index on column 0, not added to the table yet
+  auto tuple_schema = data_table->GetSchema();
+  std::vector<oid_t> key_attrs = {0};
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "populated_index", 124, INVALID_OID, INVALID_OID, INDEX_TYPE_BWTREE,
+      INDEX_CONSTRAINT_TYPE_DEFAULT, tuple_schema, key_schema, key_attrs,
+      false);
+  std::shared_ptr<index::Index> index(
+      index::IndexFactory::GetInstance(index_metadata));
+
+  auto tile_group_count = data_table->GetTileGroupCount();
+  EXPECT_EQ(tuple_count, data_table->PopulateIndex(index.get(), 0,
+                                                   tile_group_count, true));
+
+  // The tuples of the index-less table got their head pointers on the way
+  std::vector<ItemPointer *> index_entries;
+  index->ScanAllKeys(index_entries);
+  EXPECT_EQ(tuple_count, index_entries.size());
+  for (auto index_entry : index_entries) {
+    auto tile_group = data_table->GetTileGroupById(index_entry->block);
+    EXPECT_EQ(index_entry, tile_group->GetHeader()->GetIndirection(
+                               index_entry->offset));
+  }
+
+  // Once the index is in use, tuples already in it are skipped
+  data_table->AddIndex(index);
+  EXPECT_EQ(0, data_table->PopulateIndex(index.get(), 0, tile_group_count,
+                                         false));
+}
+
+TEST_F(DataTableTests, BuildIndexTest) {
+  const int tuple_count = 3 * TESTS_TUPLES_PER_TILEGROUP;
+
+  for (auto group_by : {false, true}) {
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<storage::DataTable> data_table(
+        ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+    ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, group_by, txn);
+    txn_manager.CommitTransaction(txn);
+
+    // Unique index on column 0, which only has two values with group by
+    auto tuple_schema = data_table->GetSchema();
+    std::vector<oid_t> key_attrs = {0};
+    auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+    key_schema->SetIndexedColumns(key_attrs);
+    index::IndexMetadata *index_metadata = new index::IndexMetadata(
+        "unique_index", 125, INVALID_OID, INVALID_OID, INDEX_TYPE_BWTREE,
+        INDEX_CONSTRAINT_TYPE_UNIQUE, tuple_schema, key_schema, key_attrs,
+        true);
+    std::shared_ptr<index::Index> index(
+        index::IndexFactory::GetInstance(index_metadata));
+
+    if (group_by == true) {
+      EXPECT_FALSE(data_table->BuildIndex(index));
+      EXPECT_EQ(0, data_table->GetIndexCount());
+      continue;
+    }
+
+    EXPECT_TRUE(data_table->BuildIndex(index));
+    EXPECT_EQ(1, data_table->GetIndexCount());
+    EXPECT_TRUE(index->IsReady());
+    EXPECT_EQ(data_table->GetTileGroupCount(),
+              index->GetIndexedTileGroupOff());
+
+    std::vector<ItemPointer *> index_entries;
+    index->ScanAllKeys(index_entries);
+    EXPECT_EQ(tuple_count, index_entries.size());
+  }
+}
+
 std::unique_ptr<storage::DataTable> data_table_test_table;
 
+TEST_F(DataTableTests, ConcurrentBuildIndexTest) {
+  const int tuple_count = 20 * TESTS_TUPLES_PER_TILEGROUP;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // Even rounds insert fresh keys while the index is built, odd rounds
+  // insert keys that are already there
+  for (int round = 0; round < 6; round++) {
+    bool duplicate_keys = (round % 2 == 1);
+
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<storage::DataTable> data_table(
+        ExecutorTestsUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, false));
+    ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                     false, false, txn);
+    txn_manager.CommitTransaction(txn);
+
+    std::atomic<bool> index_built(false);
+    auto insert_tuples = [&] {
+      int rowid = tuple_count;
+      while (index_built == false) {
+        int populate_value = (duplicate_keys == true) ? rowid % tuple_count
+                                                      : rowid;
+        rowid++;
+
+        storage::Tuple tuple(data_table->GetSchema(), true);
+        tuple.SetValue(0, type::ValueFactory::GetIntegerValue(
+                              ExecutorTestsUtil::PopulatedValue(
+                                  populate_value, 0)),
+                       testing_pool);
+        tuple.SetValue(1, type::ValueFactory::GetIntegerValue(
+                              ExecutorTestsUtil::PopulatedValue(
+                                  populate_value, 1)),
+                       testing_pool);
+        tuple.SetValue(2, type::ValueFactory::GetDoubleValue(
+                              ExecutorTestsUtil::PopulatedValue(
+                                  populate_value, 2)),
+                       testing_pool);
+        tuple.SetValue(3, type::ValueFactory::GetVarcharValue(std::to_string(
+                              ExecutorTestsUtil::PopulatedValue(
+                                  populate_value, 3))),
+                       testing_pool);
+
+        auto txn = txn_manager.BeginTransaction();
+        ItemPointer *index_entry_ptr = nullptr;
+        ItemPointer location =
+            data_table->InsertTuple(&tuple, txn, &index_entry_ptr);
+        if (location.block == INVALID_OID) {
+          txn_manager.AbortTransaction(txn);
+          continue;
+        }
+        txn_manager.PerformInsert(txn, location, index_entry_ptr);
+        txn_manager.CommitTransaction(txn);
+      }
+    };
+    std::thread insert_thread(insert_tuples);
+
+    auto tuple_schema = data_table->GetSchema();
+    std::vector<oid_t> key_attrs = {0};
+    auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+    key_schema->SetIndexedColumns(key_attrs);
+    index::IndexMetadata *index_metadata = new index::IndexMetadata(
+        "unique_index", 126, INVALID_OID, INVALID_OID, INDEX_TYPE_BWTREE,
+        INDEX_CONSTRAINT_TYPE_UNIQUE, tuple_schema, key_schema, key_attrs,
+        true);
+    std::shared_ptr<index::Index> index(
+        index::IndexFactory::GetInstance(index_metadata));
+
+    bool built = data_table->BuildIndex(index);
+    // let a few more inserts run into the index
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    index_built = true;
+    insert_thread.join();
+
+    // count the committed versions of each key
+    std::map<int32_t, size_t> key_counts;
+    size_t live_count = 0;
+    for (oid_t tile_group_itr = 0;
+         tile_group_itr < data_table->GetTileGroupCount(); tile_group_itr++) {
+      auto tile_group = data_table->GetTileGroup(tile_group_itr);
+      auto tile_group_header = tile_group->GetHeader();
+      for (oid_t tuple_slot = 0;
+           tuple_slot < tile_group_header->GetCurrentNextTupleSlot();
+           tuple_slot++) {
+        if (tile_group_header->GetBeginCommitId(tuple_slot) == MAX_CID ||
+            tile_group_header->GetEndCommitId(tuple_slot) != MAX_CID) {
+          continue;
+        }
+        auto key = type::ValuePeeker::PeekInteger(
+            tile_group->GetValue(tuple_slot, 0));
+        key_counts[key]++;
+        live_count++;
+      }
+    }
+
+    if (built == false) {
+      // only a duplicate may fail the build
+      EXPECT_TRUE(duplicate_keys);
+      EXPECT_EQ(0, data_table->GetIndexCount());
+      continue;
+    }
+
+    EXPECT_EQ(1, data_table->GetIndexCount());
+    for (auto &key_count : key_counts) {
+      EXPECT_EQ(1, key_count.second) << "key " << key_count.first;
+    }
+
+    if (duplicate_keys == false) {
+      std::vector<ItemPointer *> index_entries;
+      index->ScanAllKeys(index_entries);
+      EXPECT_EQ(live_count, index_entries.size());
+    }
+  }
+}
+
+TEST_F(DataTableTests, VarlenPoolTypeTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  // Only the table that asks for it gets slab pools
+  std::unique_ptr<storage::DataTable> slab_table(
+      storage::TableFactory::GetDataTable(
+          INVALID_OID, INVALID_OID,
+          new catalog::Schema({ExecutorTestsUtil::GetColumnInfo(0),
+                               ExecutorTestsUtil::GetColumnInfo(1),
+                               ExecutorTestsUtil::GetColumnInfo(2),
+                               ExecutorTestsUtil::GetColumnInfo(3)}),
+          "slab_table", tuple_count, true, false, VARLEN_POOL_TYPE_SLAB));
+  std::unique_ptr<storage::DataTable> default_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+
+  EXPECT_EQ(VARLEN_POOL_TYPE_SLAB, slab_table->GetVarlenPoolType());
+  EXPECT_EQ(DEFAULT_VARLEN_POOL_TYPE, default_table->GetVarlenPoolType());
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(slab_table.get(), tuple_count * 2, false,
+                                   false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  oid_t row_itr = 0;
+  for (size_t tile_group_itr = 0;
+       tile_group_itr < slab_table->GetTileGroupCount(); tile_group_itr++) {
+    auto tile_group = slab_table->GetTileGroup(tile_group_itr);
+    EXPECT_EQ(VARLEN_POOL_TYPE_SLAB, tile_group->GetVarlenPoolType());
+    for (oid_t tile_itr = 0; tile_itr < tile_group->NumTiles(); tile_itr++) {
+      EXPECT_EQ(VARLEN_POOL_TYPE_SLAB,
+                tile_group->GetTile(tile_itr)->GetPoolType());
+    }
+
+    auto active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_itr = 0; tuple_itr < active_tuple_count; tuple_itr++) {
+      EXPECT_EQ(std::to_string(ExecutorTestsUtil::PopulatedValue(row_itr, 3)),
+                tile_group->GetValue(tuple_itr, 3).ToString());
+      row_itr++;
+    }
+  }
+  EXPECT_EQ(tuple_count * 2, row_itr);
+
+  auto tile_group = default_table->GetTileGroup(0);
+  EXPECT_EQ(DEFAULT_VARLEN_POOL_TYPE, tile_group->GetTile(0)->GetPoolType());
+}
+
 TEST_F(DataTableTests, GlobalTableTest) {
   const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
 
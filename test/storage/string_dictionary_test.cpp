@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// string_dictionary_test.cpp
+//
+// Identification: test/storage/string_dictionary_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "storage/string_dictionary.h"
+#include "storage/tile.h"
+#include "type/value_factory.h"
+#include "type/varlen_type.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// String Dictionary Tests
+//===--------------------------------------------------------------------===//
+
+class StringDictionaryTests : public PelotonTest {};
+
+TEST_F(StringDictionaryTests, BasicTest) {
+  storage::StringDictionary dictionary(2);
+
+  auto open_entry = dictionary.GetOrInsert("open", 5);
+  auto closed_entry = dictionary.GetOrInsert("closed", 7);
+  EXPECT_TRUE(open_entry != nullptr);
+  EXPECT_TRUE(closed_entry != nullptr);
+  EXPECT_NE(open_entry->code, closed_entry->code);
+
+  // Known values map to the same entry
+  EXPECT_EQ(open_entry, dictionary.GetOrInsert("open", 5));
+  EXPECT_EQ(closed_entry, dictionary.Lookup("closed", 7));
+  EXPECT_EQ(closed_entry, dictionary.GetEntry(closed_entry->code));
+  EXPECT_EQ(std::string("open", 5),
+            std::string(open_entry->GetData(), open_entry->length));
+
+  // A full dictionary only serves the values it has
+  EXPECT_TRUE(dictionary.GetOrInsert("pending", 8) == nullptr);
+  EXPECT_TRUE(dictionary.Lookup("pending", 8) == nullptr);
+  EXPECT_EQ(2, dictionary.GetSize());
+}
+
+TEST_F(StringDictionaryTests, TileTest) {
+  catalog::Column plain_column(type::Type::VARCHAR, 25, "A", false);
+  catalog::Column encoded_column(type::Type::VARCHAR, 25, "B", false);
+  encoded_column.SetDictionaryEncoded(true);
+  catalog::Schema schema({plain_column, encoded_column});
+
+  const int tuple_count = 4;
+  std::unique_ptr<storage::Tile> tile(storage::TileFactory::GetTile(
+      BACKEND_TYPE_MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      nullptr, schema, nullptr, tuple_count));
+  EXPECT_TRUE(tile->GetDictionary(0) == nullptr);
+  EXPECT_TRUE(tile->GetDictionary(1) != nullptr);
+
+  std::vector<std::string> short_values({"a", "abc", "", "abcdef"});
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    tile->SetValue(type::ValueFactory::GetVarcharValue(short_values[tuple_itr]),
+                   tuple_itr, 0);
+    tile->SetValue(type::ValueFactory::GetVarcharValue(
+                       tuple_itr % 2 == 0 ? "category one" : "category two"),
+                   tuple_itr, 1);
+  }
+
+  // Short values stay in the slot
+  EXPECT_EQ(0, tile->GetPool()->GetTotalAllocatedSpace());
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_TRUE(type::VarlenType::IsSlotInlined(tile->GetTupleLocation(tuple_itr)));
+    EXPECT_EQ(short_values[tuple_itr], tile->GetValue(tuple_itr, 0).ToString());
+  }
+
+  // Long values of the plain column still go to the pool
+  tile->SetValue(type::ValueFactory::GetVarcharValue("not that short"), 0, 0);
+  EXPECT_LT(0, tile->GetPool()->GetTotalAllocatedSpace());
+  EXPECT_EQ("not that short", tile->GetValue(0, 0).ToString());
+
+  // Equal values of the encoded column share their entry
+  auto accessor = tile->GetColumnAccessor(1);
+  EXPECT_EQ(2, tile->GetDictionary(1)->GetSize());
+  EXPECT_EQ(accessor.GetDictionaryEntry(0), accessor.GetDictionaryEntry(2));
+  EXPECT_NE(accessor.GetDictionaryEntry(0), accessor.GetDictionaryEntry(1));
+  EXPECT_EQ("category two", tile->GetValue(3, 1).ToString());
+
+  // Nulls are stored the regular way
+  tile->SetValue(type::ValueFactory::GetNullValueByType(type::Type::VARCHAR), 3,
+                 1);
+  EXPECT_TRUE(accessor.GetDictionaryEntry(3) == nullptr);
+  EXPECT_TRUE(tile->GetValue(3, 1).IsNull());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -22,6 +22,8 @@
 #include "storage/tuple.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_header.h"
+#include "common/container_tuple.h"
+#include "executor/executor_tests_util.h"
 
 namespace peloton {
 namespace test {
@@ -543,5 +545,39 @@ TEST_F(TileGroupTests, TileCopyTest) {
   delete schema;
 }
 
+TEST_F(TileGroupTests, ColumnAccessorTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  // Two tiles, so that columns map to different tiles and offsets
+  auto tile_group = ExecutorTestsUtil::CreateTileGroup(tuple_count);
+  ExecutorTestsUtil::PopulateTiles(tile_group, tuple_count);
+
+  auto accessors = tile_group->GetColumnAccessors();
+  EXPECT_EQ(4, accessors.size());
+
+  std::vector<oid_t> column_ids = {3, 0};
+  auto projected_accessors = tile_group->GetColumnAccessors(column_ids);
+  EXPECT_EQ(2, projected_accessors.size());
+
+  for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+       tuple_id++) {
+    expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                         tuple_id, &accessors);
+
+    for (oid_t column_id = 0; column_id < accessors.size(); column_id++) {
+      auto expected = tile_group->GetValue(tuple_id, column_id);
+      EXPECT_TRUE(expected.CompareEquals(
+          accessors[column_id].GetValue(tuple_id)).IsTrue());
+      EXPECT_TRUE(expected.CompareEquals(tuple.GetValue(column_id)).IsTrue());
+    }
+
+    for (oid_t column_itr = 0; column_itr < column_ids.size(); column_itr++) {
+      auto expected = tile_group->GetValue(tuple_id, column_ids[column_itr]);
+      EXPECT_TRUE(expected.CompareEquals(
+          projected_accessors[column_itr].GetValue(tuple_id)).IsTrue());
+    }
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace